@@ -0,0 +1,71 @@
+/*
+ * Copyright (C) 2023 Dominik Drexler and Simon Stahlberg
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "mimir/search/algorithms/hda.hpp"
+
+#include "mimir/formalism/repositories.hpp"
+#include "mimir/search/delete_relaxed_problem_explorator.hpp"
+#include "mimir/search/heuristics.hpp"
+#include "mimir/search/search_context.hpp"
+
+#include <benchmark/benchmark.h>
+#include <thread>
+
+using namespace mimir::search;
+using namespace mimir::formalism;
+
+namespace mimir::benchmarks
+{
+
+/// @brief Measure the thread scaling of the hash distributed A* with FF heuristics.
+static void BM_HDAStarGroundedFF(benchmark::State& state)
+{
+    const auto num_workers = static_cast<size_t>(state.range(0));
+
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        auto problem = ProblemImpl::create(fs::path(std::string(DATA_DIR) + "barman/domain.pddl"), fs::path(std::string(DATA_DIR) + "barman/test_problem.pddl"));
+        auto search_contexts = SearchContextList {};
+        auto heuristics = HeuristicList {};
+        for (size_t i = 0; i < num_workers; ++i)
+        {
+            search_contexts.push_back(SearchContextImpl::create(problem, SearchContextImpl::Options(SearchContextImpl::SearchMode::GROUNDED)));
+            heuristics.push_back(FFHeuristicImpl::create(DeleteRelaxedProblemExplorator(problem)));
+        }
+        auto statistics = hda::StatisticsList {};
+        state.ResumeTiming();
+
+        const auto result = hda::find_solution_astar(search_contexts, heuristics, hda::Options(), &statistics);
+        benchmark::DoNotOptimize(result);
+
+        state.PauseTiming();
+        auto num_expanded = uint64_t(0);
+        for (const auto& worker_statistics : statistics)
+        {
+            num_expanded += worker_statistics.num_expanded;
+        }
+        state.counters["expanded"] = num_expanded;
+        state.ResumeTiming();
+    }
+}
+
+BENCHMARK(BM_HDAStarGroundedFF)->RangeMultiplier(2)->Range(1, std::max(1u, std::thread::hardware_concurrency()))->Unit(benchmark::kMillisecond)->UseRealTime();
+
+}
+
+BENCHMARK_MAIN();
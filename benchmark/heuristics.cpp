@@ -0,0 +1,189 @@
+/*
+ * Copyright (C) 2023 Dominik Drexler and Simon Stahlberg
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#include "mimir/formalism/problem.hpp"
+#include "mimir/search/algorithms/astar_eager.hpp"
+#include "mimir/search/algorithms/astar_eager/event_handlers.hpp"
+#include "mimir/search/algorithms/strategies/goal_strategy.hpp"
+#include "mimir/search/applicable_action_generators/interface.hpp"
+#include "mimir/search/delete_relaxed_problem_explorator.hpp"
+#include "mimir/search/heuristics.hpp"
+#include "mimir/search/search_context.hpp"
+#include "mimir/search/state_repository.hpp"
+#include "utils/random_walk.hpp"
+
+#include <benchmark/benchmark.h>
+
+using namespace mimir::search;
+using namespace mimir::formalism;
+
+namespace mimir::benchmarks
+{
+
+enum class HeuristicType
+{
+    MAX = 0,
+    ADD = 1,
+    FF = 2,
+    LIFTED_MAX = 3,
+    LIFTED_ADD = 4,
+    LIFTED_FF = 5,
+    INCREMENTAL_MAX = 6,
+    INCREMENTAL_ADD = 7,
+    INCREMENTAL_FF = 8,
+    LM_CUT = 9,
+    PDB = 10,
+    CANONICAL_PDBS = 11,
+};
+
+static Heuristic create_heuristic(const Problem& problem, HeuristicType type)
+{
+    switch (type)
+    {
+        case HeuristicType::MAX:
+            return MaxHeuristicImpl::create(DeleteRelaxedProblemExplorator(problem));
+        case HeuristicType::ADD:
+            return AddHeuristicImpl::create(DeleteRelaxedProblemExplorator(problem));
+        case HeuristicType::FF:
+            return FFHeuristicImpl::create(DeleteRelaxedProblemExplorator(problem));
+        case HeuristicType::LIFTED_MAX:
+            return LiftedMaxHeuristicImpl::create(problem);
+        case HeuristicType::LIFTED_ADD:
+            return LiftedAddHeuristicImpl::create(problem);
+        case HeuristicType::LIFTED_FF:
+            return LiftedFFHeuristicImpl::create(problem);
+        case HeuristicType::INCREMENTAL_MAX:
+            return MaxHeuristicImpl::create(DeleteRelaxedProblemExplorator(problem), true);
+        case HeuristicType::INCREMENTAL_ADD:
+            return AddHeuristicImpl::create(DeleteRelaxedProblemExplorator(problem), true);
+        case HeuristicType::INCREMENTAL_FF:
+            return FFHeuristicImpl::create(DeleteRelaxedProblemExplorator(problem), true);
+        case HeuristicType::LM_CUT:
+            return LMCutHeuristicImpl::create(DeleteRelaxedProblemExplorator(problem));
+        case HeuristicType::PDB:
+            return PDBHeuristicImpl::create(DeleteRelaxedProblemExplorator(problem));
+        case HeuristicType::CANONICAL_PDBS:
+            return CanonicalPDBsHeuristicImpl::create(DeleteRelaxedProblemExplorator(problem));
+        default:
+            throw std::runtime_error("Missing implementation for heuristic type");
+    }
+}
+
+/// @brief Evaluate a grounded, incremental, or lifted delete-relaxation heuristic, LM-cut, or a pattern database heuristic in the states along a random walk.
+/// The construction of the heuristic, which includes the grounding of the delete-relaxed task for grounded heuristics
+/// and the computation of the pattern databases, is not measured.
+static void BM_Heuristic(benchmark::State& state, const std::string& name, HeuristicType type)
+{
+    const auto problem = ProblemImpl::create(fs::path(std::string(DATA_DIR) + name + "/domain.pddl"),
+                                             fs::path(std::string(DATA_DIR) + name + "/test_problem.pddl"));
+    const auto search_context = SearchContextImpl::create(problem, SearchContextImpl::Options(SearchContextImpl::SearchMode::GROUNDED));
+    const auto goal_strategy = ProblemGoalStrategyImpl::create(problem);
+    const auto walk = tests::collect_random_walk(*search_context->get_applicable_action_generator(), *search_context->get_state_repository(), 1000);
+
+    const auto heuristic = create_heuristic(problem, type);
+
+    auto sum_h_values = ContinuousCost(0);
+    for (auto _ : state)
+    {
+        for (const auto& [search_state, search_state_metric_value] : walk)
+        {
+            const auto h_value = heuristic->compute_heuristic(search_state, goal_strategy->test_dynamic_goal(search_state));
+            benchmark::DoNotOptimize(h_value);
+            sum_h_values += h_value;
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * walk.size());
+    state.counters["h_value"] = benchmark::Counter(sum_h_values / walk.size(), benchmark::Counter::kAvgIterations);
+}
+
+/// @brief Solve the problem with eager A* and report the number of expanded and generated states.
+static void BM_AStar(benchmark::State& state, const std::string& name, HeuristicType type)
+{
+    const auto problem = ProblemImpl::create(fs::path(std::string(DATA_DIR) + name + "/domain.pddl"),
+                                             fs::path(std::string(DATA_DIR) + name + "/test_problem.pddl"));
+    const auto heuristic = create_heuristic(problem, type);
+
+    auto num_expanded = uint64_t(0);
+    auto num_generated = uint64_t(0);
+    for (auto _ : state)
+    {
+        const auto search_context = SearchContextImpl::create(problem, SearchContextImpl::Options(SearchContextImpl::SearchMode::GROUNDED));
+        const auto event_handler = astar_eager::DefaultEventHandlerImpl::create(problem);
+        auto options = astar_eager::Options();
+        options.event_handler = event_handler;
+
+        const auto result = astar_eager::find_solution(search_context, heuristic, options);
+        benchmark::DoNotOptimize(result);
+
+        num_expanded += event_handler->get_statistics().get_num_expanded();
+        num_generated += event_handler->get_statistics().get_num_generated();
+    }
+    state.counters["expanded"] = benchmark::Counter(num_expanded, benchmark::Counter::kAvgIterations);
+    state.counters["generated"] = benchmark::Counter(num_generated, benchmark::Counter::kAvgIterations);
+}
+
+BENCHMARK_CAPTURE(BM_Heuristic, gripper_max, std::string("gripper"), HeuristicType::MAX);
+BENCHMARK_CAPTURE(BM_Heuristic, gripper_incremental_max, std::string("gripper"), HeuristicType::INCREMENTAL_MAX);
+BENCHMARK_CAPTURE(BM_Heuristic, gripper_lifted_max, std::string("gripper"), HeuristicType::LIFTED_MAX);
+BENCHMARK_CAPTURE(BM_Heuristic, gripper_add, std::string("gripper"), HeuristicType::ADD);
+BENCHMARK_CAPTURE(BM_Heuristic, gripper_incremental_add, std::string("gripper"), HeuristicType::INCREMENTAL_ADD);
+BENCHMARK_CAPTURE(BM_Heuristic, gripper_lifted_add, std::string("gripper"), HeuristicType::LIFTED_ADD);
+BENCHMARK_CAPTURE(BM_Heuristic, gripper_lm_cut, std::string("gripper"), HeuristicType::LM_CUT);
+BENCHMARK_CAPTURE(BM_Heuristic, gripper_pdb, std::string("gripper"), HeuristicType::PDB);
+BENCHMARK_CAPTURE(BM_Heuristic, gripper_canonical_pdbs, std::string("gripper"), HeuristicType::CANONICAL_PDBS);
+BENCHMARK_CAPTURE(BM_Heuristic, gripper_ff, std::string("gripper"), HeuristicType::FF);
+BENCHMARK_CAPTURE(BM_Heuristic, gripper_incremental_ff, std::string("gripper"), HeuristicType::INCREMENTAL_FF);
+BENCHMARK_CAPTURE(BM_Heuristic, gripper_lifted_ff, std::string("gripper"), HeuristicType::LIFTED_FF);
+BENCHMARK_CAPTURE(BM_Heuristic, logistics_max, std::string("logistics"), HeuristicType::MAX);
+BENCHMARK_CAPTURE(BM_Heuristic, logistics_incremental_max, std::string("logistics"), HeuristicType::INCREMENTAL_MAX);
+BENCHMARK_CAPTURE(BM_Heuristic, logistics_lifted_max, std::string("logistics"), HeuristicType::LIFTED_MAX);
+BENCHMARK_CAPTURE(BM_Heuristic, logistics_add, std::string("logistics"), HeuristicType::ADD);
+BENCHMARK_CAPTURE(BM_Heuristic, logistics_incremental_add, std::string("logistics"), HeuristicType::INCREMENTAL_ADD);
+BENCHMARK_CAPTURE(BM_Heuristic, logistics_lifted_add, std::string("logistics"), HeuristicType::LIFTED_ADD);
+BENCHMARK_CAPTURE(BM_Heuristic, logistics_lm_cut, std::string("logistics"), HeuristicType::LM_CUT);
+BENCHMARK_CAPTURE(BM_Heuristic, logistics_pdb, std::string("logistics"), HeuristicType::PDB);
+BENCHMARK_CAPTURE(BM_Heuristic, logistics_canonical_pdbs, std::string("logistics"), HeuristicType::CANONICAL_PDBS);
+BENCHMARK_CAPTURE(BM_Heuristic, logistics_ff, std::string("logistics"), HeuristicType::FF);
+BENCHMARK_CAPTURE(BM_Heuristic, logistics_incremental_ff, std::string("logistics"), HeuristicType::INCREMENTAL_FF);
+BENCHMARK_CAPTURE(BM_Heuristic, logistics_lifted_ff, std::string("logistics"), HeuristicType::LIFTED_FF);
+BENCHMARK_CAPTURE(BM_Heuristic, satellite_max, std::string("satellite"), HeuristicType::MAX);
+BENCHMARK_CAPTURE(BM_Heuristic, satellite_incremental_max, std::string("satellite"), HeuristicType::INCREMENTAL_MAX);
+BENCHMARK_CAPTURE(BM_Heuristic, satellite_lifted_max, std::string("satellite"), HeuristicType::LIFTED_MAX);
+BENCHMARK_CAPTURE(BM_Heuristic, satellite_add, std::string("satellite"), HeuristicType::ADD);
+BENCHMARK_CAPTURE(BM_Heuristic, satellite_incremental_add, std::string("satellite"), HeuristicType::INCREMENTAL_ADD);
+BENCHMARK_CAPTURE(BM_Heuristic, satellite_lifted_add, std::string("satellite"), HeuristicType::LIFTED_ADD);
+BENCHMARK_CAPTURE(BM_Heuristic, satellite_lm_cut, std::string("satellite"), HeuristicType::LM_CUT);
+BENCHMARK_CAPTURE(BM_Heuristic, satellite_pdb, std::string("satellite"), HeuristicType::PDB);
+BENCHMARK_CAPTURE(BM_Heuristic, satellite_canonical_pdbs, std::string("satellite"), HeuristicType::CANONICAL_PDBS);
+BENCHMARK_CAPTURE(BM_Heuristic, satellite_ff, std::string("satellite"), HeuristicType::FF);
+BENCHMARK_CAPTURE(BM_Heuristic, satellite_incremental_ff, std::string("satellite"), HeuristicType::INCREMENTAL_FF);
+BENCHMARK_CAPTURE(BM_Heuristic, satellite_lifted_ff, std::string("satellite"), HeuristicType::LIFTED_FF);
+
+BENCHMARK_CAPTURE(BM_AStar, gripper_max, std::string("gripper"), HeuristicType::MAX);
+BENCHMARK_CAPTURE(BM_AStar, gripper_lm_cut, std::string("gripper"), HeuristicType::LM_CUT);
+BENCHMARK_CAPTURE(BM_AStar, gripper_canonical_pdbs, std::string("gripper"), HeuristicType::CANONICAL_PDBS);
+BENCHMARK_CAPTURE(BM_AStar, logistics_max, std::string("logistics"), HeuristicType::MAX);
+BENCHMARK_CAPTURE(BM_AStar, logistics_lm_cut, std::string("logistics"), HeuristicType::LM_CUT);
+BENCHMARK_CAPTURE(BM_AStar, logistics_canonical_pdbs, std::string("logistics"), HeuristicType::CANONICAL_PDBS);
+BENCHMARK_CAPTURE(BM_AStar, satellite_max, std::string("satellite"), HeuristicType::MAX);
+BENCHMARK_CAPTURE(BM_AStar, satellite_lm_cut, std::string("satellite"), HeuristicType::LM_CUT);
+BENCHMARK_CAPTURE(BM_AStar, satellite_canonical_pdbs, std::string("satellite"), HeuristicType::CANONICAL_PDBS);
+
+}
+
+BENCHMARK_MAIN();
@@ -0,0 +1,231 @@
+/*
+ * Copyright (C) 2023 Dominik Drexler and Simon Stahlberg
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "mimir/datasets/knowledge_base.hpp"
+
+#include "mimir/datasets/generalized_state_space.hpp"
+#include "mimir/datasets/state_space.hpp"
+#include "mimir/datasets/tuple_graph.hpp"
+#include "mimir/search/generalized_search_context.hpp"
+#include "mimir/search/search_context.hpp"
+
+#include <benchmark/benchmark.h>
+#include <chrono>
+#include <fstream>
+#include <thread>
+
+using namespace mimir::search;
+using namespace mimir::datasets;
+
+namespace mimir::benchmarks
+{
+
+/// @brief Write gripper problems with 1 to `max_num_balls` balls, whose state spaces grow exponentially in the number of balls.
+/// @return the paths of the problem files.
+static std::vector<fs::path> write_gripper_problems(size_t max_num_balls)
+{
+    const auto directory = fs::temp_directory_path() / "mimir-benchmark-knowledge-base";
+    fs::create_directories(directory);
+
+    auto problem_files = std::vector<fs::path> {};
+    for (size_t num_balls = 1; num_balls <= max_num_balls; ++num_balls)
+    {
+        auto objects = std::string("left right");
+        auto init = std::string("(room rooma) (room roomb) (gripper left) (gripper right) (free left) (free right) (at-robby rooma)");
+        auto goal = std::string();
+        for (size_t i = 1; i <= num_balls; ++i)
+        {
+            const auto ball = "ball" + std::to_string(i);
+            objects += " " + ball;
+            init += " (ball " + ball + ") (at " + ball + " rooma)";
+            goal += " (at " + ball + " roomb)";
+        }
+
+        const auto problem_file = directory / ("gripper-" + std::to_string(num_balls) + ".pddl");
+        auto out = std::ofstream(problem_file);
+        out << "(define (problem gripper-" << num_balls << ")\n"
+            << "(:domain gripper-strips)\n"
+            << "(:objects " << objects << ")\n"
+            << "(:init " << init << ")\n"
+            << "(:goal (and" << goal << "))\n"
+            << ")\n";
+        problem_files.push_back(problem_file);
+    }
+
+    return problem_files;
+}
+
+/// @brief Create the search contexts of gripper problems with up to 8 balls, the largest of which has about 12000 states.
+static GeneralizedSearchContext create_gripper_contexts()
+{
+    static const auto problem_files = write_gripper_problems(8);
+
+    return GeneralizedSearchContextImpl::create(fs::path(std::string(DATA_DIR) + "gripper/domain.pddl"), problem_files);
+}
+
+/// @brief Run the construction for each iteration on fresh search contexts and report the wall time and the speedup over one thread.
+/// The ranges run in ascending order, such that the single-threaded run provides the baseline.
+template<typename Create, typename Construct>
+static void run_with_speedup(benchmark::State& state, double& ref_baseline_ms, Create&& create_contexts, Construct&& construct)
+{
+    const auto num_threads = static_cast<uint32_t>(state.range(0));
+
+    auto total_ms = 0.;
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        auto contexts = create_contexts();
+        state.ResumeTiming();
+
+        const auto start = std::chrono::steady_clock::now();
+        benchmark::DoNotOptimize(construct(contexts, num_threads));
+        total_ms += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    const auto mean_ms = total_ms / state.iterations();
+    if (num_threads == 1)
+    {
+        ref_baseline_ms = mean_ms;
+    }
+    state.counters["wall_ms"] = mean_ms;
+    if (ref_baseline_ms > 0.)
+    {
+        state.counters["speedup"] = ref_baseline_ms / mean_ms;
+    }
+}
+
+/// @brief Measure the thread scaling of the knowledge base construction when constructing the state spaces of different problems concurrently.
+static void BM_KnowledgeBaseProblemThreads(benchmark::State& state)
+{
+    static auto baseline_ms = 0.;
+
+    run_with_speedup(state,
+                     baseline_ms,
+                     create_gripper_contexts,
+                     [](const GeneralizedSearchContext& contexts, uint32_t num_threads)
+                     {
+                         auto options = KnowledgeBaseImpl::Options();
+                         options.state_space_options.num_threads = num_threads;
+                         options.generalized_state_space_options = GeneralizedStateSpaceImpl::Options();
+                         return KnowledgeBaseImpl::create(contexts, options);
+                     });
+}
+
+/// @brief Create the knowledge base in the configuration of the `kb` executable: symmetry-reduced state spaces and tuple graphs of width 1.
+static KnowledgeBase create_knowledge_base_with_tuple_graphs(const GeneralizedSearchContext& contexts, uint32_t num_threads, uint32_t num_layer_threads)
+{
+    auto options = KnowledgeBaseImpl::Options();
+    options.state_space_options.symmetry_pruning = true;
+    options.state_space_options.num_threads = num_threads;
+    options.state_space_options.num_layer_threads = num_layer_threads;
+    options.generalized_state_space_options = GeneralizedStateSpaceImpl::Options();
+    options.tuple_graph_options = TupleGraphImpl::Options(1, true, num_threads);
+    return KnowledgeBaseImpl::create(contexts, options);
+}
+
+/// @brief Measure the thread scaling of the `kb` executable when constructing the state spaces and tuple graphs of different problems concurrently.
+static void BM_KnowledgeBaseTupleGraphsProblemThreads(benchmark::State& state)
+{
+    static auto baseline_ms = 0.;
+
+    run_with_speedup(state,
+                     baseline_ms,
+                     create_gripper_contexts,
+                     [](const GeneralizedSearchContext& contexts, uint32_t num_threads)
+                     { return create_knowledge_base_with_tuple_graphs(contexts, num_threads, 1); });
+}
+
+/// @brief Measure the thread scaling of the `kb` executable when expanding the states of a breadth-first layer concurrently.
+static void BM_KnowledgeBaseTupleGraphsLayerThreads(benchmark::State& state)
+{
+    static auto baseline_ms = 0.;
+
+    run_with_speedup(state,
+                     baseline_ms,
+                     create_gripper_contexts,
+                     [](const GeneralizedSearchContext& contexts, uint32_t num_layer_threads)
+                     { return create_knowledge_base_with_tuple_graphs(contexts, 1, num_layer_threads); });
+}
+
+/// @brief Measure the thread scaling of the state space construction when expanding the states of a breadth-first layer concurrently.
+static void BM_StateSpaceLayerThreads(benchmark::State& state)
+{
+    static auto baseline_ms = 0.;
+
+    run_with_speedup(state,
+                     baseline_ms,
+                     []
+                     {
+                         return SearchContextImpl::create(fs::path(std::string(DATA_DIR) + "gripper/domain.pddl"),
+                                                          fs::path(std::string(DATA_DIR) + "gripper/test_problem2.pddl"));
+                     },
+                     [](const SearchContext& context, uint32_t num_threads)
+                     {
+                         auto options = StateSpaceImpl::Options();
+                         options.num_layer_threads = num_threads;
+                         return StateSpaceImpl::create(context, options);
+                     });
+}
+
+/// @brief Measure the thread scaling of the symmetry-reduced state space construction, which computes the certificates of a layer concurrently.
+static void BM_StateSpaceSymmetryLayerThreads(benchmark::State& state)
+{
+    static auto baseline_ms = 0.;
+
+    run_with_speedup(state,
+                     baseline_ms,
+                     []
+                     {
+                         return SearchContextImpl::create(fs::path(std::string(DATA_DIR) + "gripper/domain.pddl"),
+                                                          fs::path(std::string(DATA_DIR) + "gripper/test_problem2.pddl"));
+                     },
+                     [](const SearchContext& context, uint32_t num_threads)
+                     {
+                         auto options = StateSpaceImpl::Options();
+                         options.symmetry_pruning = true;
+                         options.num_layer_threads = num_threads;
+                         return StateSpaceImpl::create(context, options);
+                     });
+}
+
+/// @brief Measure the thread scaling of the tuple graph creation of width 2 when creating the tuple graphs of different vertices concurrently.
+static void BM_TupleGraphThreads(benchmark::State& state)
+{
+    static auto baseline_ms = 0.;
+
+    run_with_speedup(state,
+                     baseline_ms,
+                     []
+                     {
+                         return StateSpaceImpl::create(SearchContextImpl::create(fs::path(std::string(DATA_DIR) + "gripper/domain.pddl"),
+                                                                                 fs::path(std::string(DATA_DIR) + "gripper/test_problem2.pddl")))
+                             .value();
+                     },
+                     [](std::pair<StateSpace, std::optional<CertificateMaps>>& state_space, uint32_t num_threads)
+                     { return TupleGraphImpl::create(state_space.first, state_space.second, TupleGraphImpl::Options(2, true, num_threads)); });
+}
+
+BENCHMARK(BM_KnowledgeBaseProblemThreads)->RangeMultiplier(2)->Range(1, std::max(1u, std::thread::hardware_concurrency()))->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK(BM_KnowledgeBaseTupleGraphsProblemThreads)->RangeMultiplier(2)->Range(1, std::max(1u, std::thread::hardware_concurrency()))->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK(BM_KnowledgeBaseTupleGraphsLayerThreads)->RangeMultiplier(2)->Range(1, std::max(1u, std::thread::hardware_concurrency()))->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK(BM_StateSpaceLayerThreads)->RangeMultiplier(2)->Range(1, std::max(1u, std::thread::hardware_concurrency()))->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK(BM_StateSpaceSymmetryLayerThreads)->RangeMultiplier(2)->Range(1, std::max(1u, std::thread::hardware_concurrency()))->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK(BM_TupleGraphThreads)->RangeMultiplier(2)->Range(1, std::max(1u, std::thread::hardware_concurrency()))->Unit(benchmark::kMillisecond)->UseRealTime();
+
+}
+
+BENCHMARK_MAIN();
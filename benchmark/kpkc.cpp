@@ -0,0 +1,146 @@
+/*
+ * Copyright (C) 2023 Dominik Drexler and Simon Stahlberg
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "mimir/algorithms/kpkc.hpp"
+
+#include "mimir/formalism/action.hpp"
+#include "mimir/formalism/conjunctive_condition.hpp"
+#include "mimir/formalism/domain.hpp"
+#include "mimir/formalism/problem.hpp"
+#include "mimir/formalism/repositories.hpp"
+#include "mimir/search/applicability.hpp"
+#include "mimir/search/applicable_action_generators/interface.hpp"
+#include "mimir/search/satisficing_binding_generators/action.hpp"
+#include "mimir/search/search_context.hpp"
+#include "mimir/search/state_repository.hpp"
+#include "utils/random_walk.hpp"
+
+#include <benchmark/benchmark.h>
+
+using namespace mimir::search;
+using namespace mimir::formalism;
+
+namespace mimir::benchmarks
+{
+
+/// @brief A consistency graph that was constructed during lifted successor generation in a real problem.
+struct RecordedConsistencyGraph
+{
+    BitMatrix adjacency_matrix;
+    std::vector<std::vector<uint32_t>> partitions;
+};
+
+/// @brief Record the consistency graphs of all action schemas with at least two parameters in the states along a random walk.
+static std::vector<RecordedConsistencyGraph> record_consistency_graphs(const std::string& name, size_t num_states)
+{
+    const auto problem = ProblemImpl::create(fs::path(std::string(DATA_DIR) + name + "/domain.pddl"),
+                                             fs::path(std::string(DATA_DIR) + name + "/test_problem.pddl"));
+    const auto search_context = SearchContextImpl::create(problem, SearchContextImpl::Options(SearchContextImpl::SearchMode::LIFTED));
+    const auto& repositories = problem->get_repositories();
+    const auto num_objects = problem->get_problem_and_domain_objects().size();
+
+    auto binding_generators = ActionSatisficingBindingGeneratorList {};
+    for (const auto& action : problem->get_domain()->get_actions())
+    {
+        binding_generators.push_back(ActionSatisficingBindingGenerator(action, problem));
+    }
+
+    auto fluent_assignment_set = AssignmentSet<FluentTag>(num_objects, problem->get_domain()->get_predicates<FluentTag>());
+    auto derived_assignment_set = AssignmentSet<DerivedTag>(num_objects, problem->get_problem_and_domain_derived_predicates());
+    auto numeric_assignment_set = NumericAssignmentSet<FluentTag>(num_objects, problem->get_domain()->get_function_skeletons<FluentTag>());
+    auto fluent_functions = GroundFunctionList<FluentTag> {};
+
+    auto graphs = std::vector<RecordedConsistencyGraph> {};
+    for (const auto& [state, state_metric_value] :
+         tests::collect_random_walk(*search_context->get_applicable_action_generator(), *search_context->get_state_repository(), num_states))
+    {
+        fluent_assignment_set.update_ground_atoms(state.get_atoms<FluentTag>(), repositories);
+        derived_assignment_set.update_ground_atoms(state.get_atoms<DerivedTag>(), repositories);
+        numeric_assignment_set.reset();
+        repositories.get_ground_functions(state.get_numeric_variables().size(), fluent_functions);
+        numeric_assignment_set.insert_ground_function_values(fluent_functions, state.get_numeric_variables());
+
+        for (auto& binding_generator : binding_generators)
+        {
+            const auto& condition = binding_generator.get_conjunctive_condition();
+            if (condition->get_arity() < 2 || binding_generator.get_static_consistency_graph().get_edges().empty()
+                || !nullary_conditions_hold(condition, state.get_unpacked_state()))
+            {
+                continue;  ///< No consistency graph is constructed.
+            }
+
+            for (auto&& binding : binding_generator.create_binding_generator(state,
+                                                                             fluent_assignment_set,
+                                                                             derived_assignment_set,
+                                                                             problem->get_static_initial_numeric_assignment_set(),
+                                                                             numeric_assignment_set))
+            {
+                benchmark::DoNotOptimize(binding);
+            }
+
+            graphs.push_back(RecordedConsistencyGraph { binding_generator.get_full_consistency_graph(),
+                                                        binding_generator.get_static_consistency_graph().get_vertices_by_parameter_index() });
+        }
+    }
+
+    return graphs;
+}
+
+/// @brief Replay the recorded consistency graphs of a problem with the given kernel.
+static void BM_KPKC(benchmark::State& state, const std::string& name, KPKCKernel kernel)
+{
+    if (!is_supported(kernel))
+    {
+        state.SkipWithError("The kernel is not supported by the processor.");
+        return;
+    }
+
+    const auto graphs = record_consistency_graphs(name, 100);
+
+    auto num_cliques = size_t(0);
+    for (auto _ : state)
+    {
+        for (const auto& graph : graphs)
+        {
+            for (const auto& clique : create_k_clique_in_k_partite_graph_generator(graph.adjacency_matrix, graph.partitions, kernel))
+            {
+                benchmark::DoNotOptimize(clique);
+                ++num_cliques;
+            }
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * graphs.size());
+    state.counters["graphs"] = graphs.size();
+    state.counters["cliques"] = benchmark::Counter(num_cliques, benchmark::Counter::kAvgIterations);
+}
+
+BENCHMARK_CAPTURE(BM_KPKC, barman_scalar, std::string("barman"), KPKCKernel::SCALAR);
+BENCHMARK_CAPTURE(BM_KPKC, barman_avx2, std::string("barman"), KPKCKernel::AVX2);
+BENCHMARK_CAPTURE(BM_KPKC, barman_avx512, std::string("barman"), KPKCKernel::AVX512);
+BENCHMARK_CAPTURE(BM_KPKC, childsnack_scalar, std::string("childsnack"), KPKCKernel::SCALAR);
+BENCHMARK_CAPTURE(BM_KPKC, childsnack_avx2, std::string("childsnack"), KPKCKernel::AVX2);
+BENCHMARK_CAPTURE(BM_KPKC, childsnack_avx512, std::string("childsnack"), KPKCKernel::AVX512);
+BENCHMARK_CAPTURE(BM_KPKC, logistics_scalar, std::string("logistics"), KPKCKernel::SCALAR);
+BENCHMARK_CAPTURE(BM_KPKC, logistics_avx2, std::string("logistics"), KPKCKernel::AVX2);
+BENCHMARK_CAPTURE(BM_KPKC, logistics_avx512, std::string("logistics"), KPKCKernel::AVX512);
+BENCHMARK_CAPTURE(BM_KPKC, satellite_scalar, std::string("satellite"), KPKCKernel::SCALAR);
+BENCHMARK_CAPTURE(BM_KPKC, satellite_avx2, std::string("satellite"), KPKCKernel::AVX2);
+BENCHMARK_CAPTURE(BM_KPKC, satellite_avx512, std::string("satellite"), KPKCKernel::AVX512);
+
+}
+
+BENCHMARK_MAIN();
@@ -0,0 +1,78 @@
+/*
+ * Copyright (C) 2023 Dominik Drexler and Simon Stahlberg
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "mimir/search/match_tree/match_tree.hpp"
+
+#include "mimir/formalism/problem.hpp"
+#include "mimir/formalism/repositories.hpp"
+#include "mimir/search/applicable_action_generators/interface.hpp"
+#include "mimir/search/delete_relaxed_problem_explorator.hpp"
+#include "mimir/search/search_context.hpp"
+#include "mimir/search/state_repository.hpp"
+#include "utils/random_walk.hpp"
+
+#include <benchmark/benchmark.h>
+
+using namespace mimir::search;
+using namespace mimir::formalism;
+
+namespace mimir::benchmarks
+{
+
+/// @brief Generate the applicable ground actions in the states along a random walk with a compiled or uncompiled match tree.
+static void BM_MatchTree(benchmark::State& state, const std::string& name, bool enable_compilation)
+{
+    const auto problem = ProblemImpl::create(fs::path(std::string(DATA_DIR) + name + "/domain.pddl"),
+                                             fs::path(std::string(DATA_DIR) + name + "/test_problem.pddl"));
+    const auto search_context = SearchContextImpl::create(problem, SearchContextImpl::Options(SearchContextImpl::SearchMode::GROUNDED));
+    const auto walk = tests::collect_random_walk(*search_context->get_applicable_action_generator(), *search_context->get_state_repository(), 1000);
+
+    auto options = match_tree::Options();
+    options.enable_compilation = enable_compilation;
+    const auto ground_actions = DeleteRelaxedProblemExplorator(problem).create_ground_actions();
+    const auto action_match_tree = match_tree::MatchTreeImpl<GroundActionImpl>::create(problem->get_repositories(), ground_actions, options);
+
+    auto applicable_actions = GroundActionList {};
+    auto num_applicable_actions = size_t(0);
+    for (auto _ : state)
+    {
+        for (const auto& [search_state, search_state_metric_value] : walk)
+        {
+            action_match_tree->generate_applicable_elements_iteratively(search_state.get_unpacked_state(), applicable_actions);
+            benchmark::DoNotOptimize(applicable_actions.data());
+            num_applicable_actions += applicable_actions.size();
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * walk.size());
+    state.counters["nodes"] = action_match_tree->get_statistics().num_nodes;
+    state.counters["node_throughput"] =
+        benchmark::Counter(static_cast<double>(action_match_tree->get_statistics().num_nodes * walk.size()), benchmark::Counter::kIsIterationInvariantRate);
+    state.counters["actions"] = benchmark::Counter(num_applicable_actions, benchmark::Counter::kAvgIterations);
+}
+
+BENCHMARK_CAPTURE(BM_MatchTree, barman_virtual, std::string("barman"), false);
+BENCHMARK_CAPTURE(BM_MatchTree, barman_compiled, std::string("barman"), true);
+BENCHMARK_CAPTURE(BM_MatchTree, childsnack_virtual, std::string("childsnack"), false);
+BENCHMARK_CAPTURE(BM_MatchTree, childsnack_compiled, std::string("childsnack"), true);
+BENCHMARK_CAPTURE(BM_MatchTree, logistics_virtual, std::string("logistics"), false);
+BENCHMARK_CAPTURE(BM_MatchTree, logistics_compiled, std::string("logistics"), true);
+BENCHMARK_CAPTURE(BM_MatchTree, satellite_virtual, std::string("satellite"), false);
+BENCHMARK_CAPTURE(BM_MatchTree, satellite_compiled, std::string("satellite"), true);
+
+}
+
+BENCHMARK_MAIN();
@@ -0,0 +1,144 @@
+/*
+ * Copyright (C) 2023 Dominik Drexler and Simon Stahlberg
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "mimir/datasets/object_graph.hpp"
+
+#include "mimir/datasets/state_space.hpp"
+#include "mimir/formalism/problem.hpp"
+#include "mimir/search/search_context.hpp"
+#include "mimir/search/state.hpp"
+
+#include <benchmark/benchmark.h>
+
+using namespace mimir::search;
+using namespace mimir::datasets;
+
+namespace mimir::benchmarks
+{
+
+/// @brief The state space of a gripper problem, whose edges provide pairs of parent and successor states.
+static const StateSpace& get_gripper_state_space()
+{
+    static const auto state_space = []
+    {
+        auto options = StateSpaceImpl::Options();
+        options.symmetry_pruning = false;
+        const auto context = SearchContextImpl::create(fs::path(std::string(DATA_DIR) + "gripper/domain.pddl"),
+                                                       fs::path(std::string(DATA_DIR) + "gripper/test_problem2.pddl"));
+        return StateSpaceImpl::create(context, options)->first;
+    }();
+    return state_space;
+}
+
+static StateList get_states(const StateSpace& state_space)
+{
+    auto states = StateList {};
+    for (const auto& vertex : state_space->get_graph().get_vertices())
+    {
+        states.push_back(graphs::get_state(vertex));
+    }
+    return states;
+}
+
+/// @brief Create the object graph of each state from scratch.
+static void BM_CreateObjectGraph(benchmark::State& state)
+{
+    const auto& state_space = get_gripper_state_space();
+    const auto states = get_states(state_space);
+    const auto& problem = *state_space->get_search_context()->get_problem();
+
+    auto graph = graphs::StaticVertexColoredGraph();
+    for (auto _ : state)
+    {
+        for (const auto& s : states)
+        {
+            create_object_graph(s, problem, graph);
+            benchmark::DoNotOptimize(graph);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * states.size());
+}
+
+/// @brief Create the object graph of each state with a builder.
+static void BM_ObjectGraphBuilder(benchmark::State& state)
+{
+    const auto& state_space = get_gripper_state_space();
+    const auto states = get_states(state_space);
+
+    auto builder = ObjectGraphBuilder(*state_space->get_search_context()->get_problem());
+    auto graph = FlatObjectGraph();
+    for (auto _ : state)
+    {
+        for (const auto& s : states)
+        {
+            builder.create(s, graph);
+            benchmark::DoNotOptimize(graph);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * states.size());
+}
+
+/// @brief Create the object graph of the target state of each transition from the graph of its source state.
+static void BM_ObjectGraphBuilderFromParent(benchmark::State& state)
+{
+    const auto& state_space = get_gripper_state_space();
+    const auto& graph = state_space->get_graph();
+    const auto states = get_states(state_space);
+
+    auto builder = ObjectGraphBuilder(*state_space->get_search_context()->get_problem());
+    auto parent_graphs = std::vector<FlatObjectGraph>(states.size());
+    for (size_t i = 0; i < states.size(); ++i)
+    {
+        builder.create(states[i], parent_graphs[i]);
+    }
+
+    auto successor_graph = FlatObjectGraph();
+    for (auto _ : state)
+    {
+        for (const auto& edge : graph.get_edges())
+        {
+            builder.create(states[edge.get_target()], states[edge.get_source()], parent_graphs[edge.get_source()], successor_graph);
+            benchmark::DoNotOptimize(successor_graph);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * graph.get_num_edges());
+}
+
+/// @brief Create the object graphs of all states into one batch.
+static void BM_ObjectGraphBuilderBatch(benchmark::State& state)
+{
+    const auto& state_space = get_gripper_state_space();
+    const auto states = get_states(state_space);
+
+    auto builder = ObjectGraphBuilder(*state_space->get_search_context()->get_problem());
+    auto batch = ObjectGraphBatch();
+    for (auto _ : state)
+    {
+        builder.create(states, batch);
+        benchmark::DoNotOptimize(batch);
+    }
+    state.SetItemsProcessed(state.iterations() * states.size());
+}
+
+BENCHMARK(BM_CreateObjectGraph);
+BENCHMARK(BM_ObjectGraphBuilder);
+BENCHMARK(BM_ObjectGraphBuilderFromParent);
+BENCHMARK(BM_ObjectGraphBuilderBatch);
+
+}
+
+BENCHMARK_MAIN();
@@ -0,0 +1,119 @@
+/*
+ * Copyright (C) 2023 Dominik Drexler and Simon Stahlberg
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "mimir/search/openlists.hpp"
+
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+namespace mimir::benchmarks
+{
+
+/// @brief Mirrors the layout of the eager A* queue entry: f-value, packed state, state index, and status.
+struct QueueEntry
+{
+    using KeyType = std::pair<double, uint8_t>;
+    using ItemType = const void*;
+    using SecondaryKeyType = uint8_t;
+
+    double f_value;
+    const void* packed_state;
+    uint32_t state_index;
+    uint8_t status;
+
+    KeyType get_key() const { return std::make_pair(f_value, status); }
+    ItemType get_item() const { return packed_state; }
+    double get_primary_key() const { return f_value; }
+    SecondaryKeyType get_secondary_key() const { return status; }
+};
+
+/// @brief Simulates a search with unit costs: each pop inserts successors with f-values that increase by at most `max_f_increase`.
+template<typename Queue>
+static void BM_OpenList(benchmark::State& state)
+{
+    const auto num_entries = static_cast<size_t>(state.range(0));
+    const auto max_f_increase = static_cast<uint32_t>(state.range(1));
+
+    for (auto _ : state)
+    {
+        auto rng = std::mt19937(42);
+        auto queue = Queue();
+        auto num_inserted = size_t(0);
+        auto num_popped = size_t(0);
+
+        queue.insert(QueueEntry { 0., nullptr, 0, 3 });
+        ++num_inserted;
+
+        while (!queue.empty())
+        {
+            const auto entry = queue.top_entry();
+            queue.pop();
+            ++num_popped;
+
+            for (int i = 0; i < 3 && num_inserted < num_entries; ++i)
+            {
+                const auto f_value = entry.f_value + rng() % (max_f_increase + 1);
+                const auto status = uint8_t((rng() % 2) ? 3 : 0);
+                queue.insert(QueueEntry { f_value, nullptr, static_cast<uint32_t>(num_inserted), status });
+                ++num_inserted;
+            }
+        }
+        benchmark::DoNotOptimize(num_popped);
+    }
+
+    state.SetItemsProcessed(state.iterations() * num_entries);
+}
+
+/// @brief Inserts all entries with random low-cardinality keys and then pops them all.
+template<typename Queue>
+static void BM_OpenListBulk(benchmark::State& state)
+{
+    const auto num_entries = static_cast<size_t>(state.range(0));
+    const auto num_distinct_keys = static_cast<uint32_t>(state.range(1));
+
+    for (auto _ : state)
+    {
+        auto rng = std::mt19937(42);
+        auto queue = Queue();
+
+        for (size_t i = 0; i < num_entries; ++i)
+        {
+            queue.insert(QueueEntry { static_cast<double>(rng() % num_distinct_keys), nullptr, static_cast<uint32_t>(i), 3 });
+        }
+        while (!queue.empty())
+        {
+            benchmark::DoNotOptimize(queue.top());
+            queue.pop();
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * num_entries);
+}
+
+using Heap = search::PriorityQueue<QueueEntry>;
+using Buckets = search::BucketQueue<QueueEntry>;
+
+BENCHMARK_TEMPLATE(BM_OpenList, Heap)->Args({ 10'000'000, 1 })->Args({ 10'000'000, 10 })->Unit(benchmark::kMillisecond)->Iterations(1);
+BENCHMARK_TEMPLATE(BM_OpenList, Buckets)->Args({ 10'000'000, 1 })->Args({ 10'000'000, 10 })->Unit(benchmark::kMillisecond)->Iterations(1);
+BENCHMARK_TEMPLATE(BM_OpenListBulk, Heap)->Args({ 10'000'000, 100 })->Unit(benchmark::kMillisecond)->Iterations(1);
+BENCHMARK_TEMPLATE(BM_OpenListBulk, Buckets)->Args({ 10'000'000, 100 })->Unit(benchmark::kMillisecond)->Iterations(1);
+
+}
+
+BENCHMARK_MAIN();
@@ -0,0 +1,178 @@
+/*
+ * Copyright (C) 2023 Dominik Drexler and Simon Stahlberg
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <random>
+#include <valla/plain/swiss.hpp>
+
+namespace mimir::benchmarks
+{
+
+using Index = uint32_t;
+using IndexTreeTable = valla::ConcurrentIndexedHashSet<valla::Slot<Index>, Index>;
+
+/// @brief A sequence of successor states that each add one atom and delete another, as in typical planning actions.
+/// If `local` is true, then the added atom is a neighbor of the deleted atom in the sorted order, such that no other positions shift.
+struct SuccessorSequence
+{
+    std::vector<Index> parent;
+    std::vector<std::vector<Index>> successors;
+    std::vector<std::vector<Index>> added;
+    std::vector<std::vector<Index>> deleted;
+
+    SuccessorSequence(size_t num_atoms, size_t num_successors, bool local)
+    {
+        auto rng = std::mt19937(42);
+        auto dist = std::uniform_int_distribution<Index>(0, 4 * num_atoms);
+
+        while (parent.size() < num_atoms)
+        {
+            parent.push_back(dist(rng));
+            std::sort(parent.begin(), parent.end());
+            parent.erase(std::unique(parent.begin(), parent.end()), parent.end());
+        }
+
+        for (size_t i = 0; i < num_successors; ++i)
+        {
+            auto successor = parent;
+            auto position = dist(rng) % successor.size();
+            auto deleted_atom = successor[position];
+            auto added_atom = dist(rng);
+            if (local)
+            {
+                // Find a position with a free value before the next atom.
+                while (position + 1 < successor.size() && successor[position] + 1 == successor[position + 1])
+                    ++position;
+                deleted_atom = successor[position];
+                added_atom = deleted_atom + 1;
+            }
+            while (std::binary_search(parent.begin(), parent.end(), added_atom))
+                added_atom = dist(rng);
+
+            successor.erase(std::find(successor.begin(), successor.end(), deleted_atom));
+            successor.insert(std::upper_bound(successor.begin(), successor.end(), added_atom), added_atom);
+
+            successors.push_back(std::move(successor));
+            added.push_back({ added_atom });
+            deleted.push_back({ deleted_atom });
+        }
+    }
+};
+
+struct UnchangedPositions
+{
+    const std::vector<Index>& atoms;
+    const std::vector<Index>& added_atoms;
+    const std::vector<Index>& deleted_atoms;
+
+    bool operator()(Index first, Index last) const
+    {
+        const auto added_it = std::lower_bound(added_atoms.begin(), added_atoms.end(), atoms[first]);
+        const auto deleted_it = std::lower_bound(deleted_atoms.begin(), deleted_atoms.end(), atoms[first]);
+
+        return (std::distance(added_atoms.begin(), added_it) == std::distance(deleted_atoms.begin(), deleted_it))
+               && (added_it == added_atoms.end() || *added_it > atoms[last - 1]) && (deleted_it == deleted_atoms.end() || *deleted_it > atoms[last - 1]);
+    }
+};
+
+/// @brief Baseline: insert every successor from scratch.
+static void BM_SuccessorConstructionFull(benchmark::State& state)
+{
+    const auto sequence = SuccessorSequence(state.range(0), 100, state.range(1));
+    auto table = IndexTreeTable();
+    valla::plain::swiss::insert(sequence.parent, table);
+
+    for (auto _ : state)
+    {
+        for (const auto& successor : sequence.successors)
+        {
+            benchmark::DoNotOptimize(valla::plain::swiss::insert(successor, table));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * sequence.successors.size());
+}
+
+/// @brief Reuse the unchanged subtrees of the parent.
+static void BM_SuccessorConstructionDelta(benchmark::State& state)
+{
+    const auto sequence = SuccessorSequence(state.range(0), 100, state.range(1));
+    auto table = IndexTreeTable();
+    const auto parent_root = valla::plain::swiss::insert(sequence.parent, table);
+
+    for (auto _ : state)
+    {
+        for (size_t i = 0; i < sequence.successors.size(); ++i)
+        {
+            benchmark::DoNotOptimize(valla::plain::swiss::insert_with_parent(sequence.successors[i],
+                                                                             parent_root,
+                                                                             table,
+                                                                             UnchangedPositions { sequence.successors[i], sequence.added[i], sequence.deleted[i] }));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * sequence.successors.size());
+}
+
+/// @brief Derive the changed positions from the parent tree and the added and deleted atoms, without materializing the successor.
+static void BM_SuccessorConstructionEffects(benchmark::State& state)
+{
+    const auto sequence = SuccessorSequence(state.range(0), 100, state.range(1));
+    auto table = IndexTreeTable();
+    auto workspace = valla::plain::swiss::DeltaWorkspace<Index>();
+    const auto parent_root = valla::plain::swiss::insert(sequence.parent, table);
+
+    for (auto _ : state)
+    {
+        for (size_t i = 0; i < sequence.successors.size(); ++i)
+        {
+            benchmark::DoNotOptimize(valla::plain::swiss::insert_with_delta(parent_root, sequence.added[i], sequence.deleted[i], table, workspace));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * sequence.successors.size());
+}
+
+/// @brief Cost of the concurrent mode of the tree table for a single thread, where most insertions find existing nodes.
+static void BM_SuccessorConstructionTableMode(benchmark::State& state)
+{
+    const auto sequence = SuccessorSequence(state.range(0), 100, false);
+    auto table = IndexTreeTable();
+    if (state.range(1))
+    {
+        table.enable_concurrency();
+    }
+    valla::plain::swiss::insert(sequence.parent, table);
+
+    for (auto _ : state)
+    {
+        for (const auto& successor : sequence.successors)
+        {
+            benchmark::DoNotOptimize(valla::plain::swiss::insert(successor, table));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * sequence.successors.size());
+    state.SetLabel(state.range(1) ? "concurrent" : "sequential");
+}
+
+BENCHMARK(BM_SuccessorConstructionFull)->ArgsProduct({ { 100, 1000, 10000 }, { 0, 1 } })->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_SuccessorConstructionDelta)->ArgsProduct({ { 100, 1000, 10000 }, { 0, 1 } })->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_SuccessorConstructionEffects)->ArgsProduct({ { 100, 1000, 10000 }, { 0, 1 } })->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_SuccessorConstructionTableMode)->ArgsProduct({ { 100, 1000, 10000 }, { 0, 1 } })->Unit(benchmark::kMicrosecond);
+
+}
+
+BENCHMARK_MAIN();
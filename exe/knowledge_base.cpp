@@ -15,6 +15,7 @@
  * along with this program. If not, see <https://www.gnu.org/licenses/>.
  */
 
+#include <argparse/argparse.hpp>
 #include <fstream>
 #include <iostream>
 #include <mimir/mimir.hpp>
@@ -24,25 +25,55 @@ using namespace mimir::search;
 
 int main(int argc, char** argv)
 {
-    if (argc != 3)
+    auto program = argparse::ArgumentParser("Knowledge base construction.");
+    program.add_argument("domain_filepath").help("The path to the PDDL domain file.");
+    program.add_argument("problems_directory").help("The path to the directory with the PDDL problem files.");
+    program.add_argument("archive_filepath").nargs(argparse::nargs_pattern::optional).help("The path to the output knowledge base archive.");
+    program.add_argument("-T", "--num-threads")
+        .default_value(uint32_t(1))
+        .scan<'u', uint32_t>()
+        .help("The number of threads that construct the state spaces of different problems, and the tuple graphs of different vertices, concurrently.");
+    program.add_argument("-L", "--num-layer-threads")
+        .default_value(uint32_t(1))
+        .scan<'u', uint32_t>()
+        .help("The number of threads that expand the states of a breadth-first layer concurrently.");
+
+    try
+    {
+        program.parse_args(argc, argv);
+    }
+    catch (const std::runtime_error& err)
     {
-        std::cout << "Usage: pcg <domain_filepath:str> <problems_directory:str>" << std::endl;
-        return 1;
+        std::cerr << err.what() << "\n";
+        std::cerr << program;
+        std::exit(1);
     }
 
-    const auto domain_file_path = fs::path { argv[1] };
-    const auto problems_directory = fs::path { argv[2] };
+    const auto domain_file_path = fs::path { program.get<std::string>("domain_filepath") };
+    const auto problems_directory = fs::path { program.get<std::string>("problems_directory") };
+    const auto num_threads = program.get<uint32_t>("--num-threads");
+    const auto num_layer_threads = program.get<uint32_t>("--num-layer-threads");
 
     auto kb_options = KnowledgeBaseImpl::Options();
     auto& state_space_options = kb_options.state_space_options;
     state_space_options.symmetry_pruning = true;
+    state_space_options.num_threads = num_threads;
+    state_space_options.num_layer_threads = num_layer_threads;
     auto& generalized_state_space_options = kb_options.generalized_state_space_options;
     generalized_state_space_options = GeneralizedStateSpaceImpl::Options();
     auto& tuple_graph_options = kb_options.tuple_graph_options;
     tuple_graph_options = TupleGraphImpl::Options();
     tuple_graph_options->width = 1;
+    tuple_graph_options->num_threads = num_threads;
     auto kb = KnowledgeBaseImpl::create(GeneralizedSearchContextImpl::create(domain_file_path, problems_directory), kb_options);
 
+    if (program.present("archive_filepath"))
+    {
+        const auto archive_file_path = fs::path { program.get<std::string>("archive_filepath") };
+        KnowledgeBaseArchiveImpl::write(*kb, archive_file_path);
+        std::cout << "Wrote knowledge base archive to " << archive_file_path << std::endl;
+    }
+
     if (kb->get_generalized_state_space().has_value())
     {
         const auto& generalized_state_space = kb->get_generalized_state_space().value();
@@ -63,13 +94,21 @@ int main(int argc, char** argv)
     if (kb->get_tuple_graphs().has_value())
     {
         auto class_v_idx = size_t(0);
-        for (const auto& tuple_graphs : kb->get_tuple_graphs().value())
+        for (size_t i = 0; i < kb->get_tuple_graphs().value().size(); ++i)
         {
+            const auto& tuple_graphs = kb->get_tuple_graphs().value()[i];
+
+            auto num_bytes = size_t(0);
             for (const auto& tuple_graph : tuple_graphs)
             {
+                num_bytes += tuple_graph->get_estimated_memory_usage_in_bytes();
                 // std::cout << "Class vertex index: " << class_v_idx++ << std::endl;
                 // std::cout << *tuple_graph << std::endl;
             }
+            // The workspaces that created the tuple graphs are released afterwards, but they determine the peak memory usage.
+            const auto workspace_num_bytes = kb->get_tuple_graph_workspace_memory_usage_in_bytes().value().at(i);
+            std::cout << i << ". has " << tuple_graphs.size() << " tuple graphs with estimated memory usage in bytes: " << num_bytes + workspace_num_bytes
+                      << " (of which " << workspace_num_bytes << " by the workspaces)" << std::endl;
         }
     }
 
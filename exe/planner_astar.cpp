@@ -45,7 +45,10 @@ int main(int argc, char** argv)
         .default_value(size_t(1))
         .scan<'u', size_t>()
         .help("Weight of the standard queue. Ignored in eager search.");
-    program.add_argument("-H", "--heuristic-type").default_value("ff").choices("blind", "perfect", "max", "add", "setadd", "ff");
+    program.add_argument("-H", "--heuristic-type").default_value("ff").choices("blind", "perfect", "max", "add", "setadd", "ff", "lmcut", "pdb", "ipdb");
+    program.add_argument("-C", "--pdb-cache-directory")
+        .default_value(std::string(""))
+        .help("The directory that pattern databases are loaded from and written to. Empty values disable caching.");
     program.add_argument("-G", "--enable-grounding")
         .default_value(size_t(0))
         .scan<'u', size_t>()
@@ -74,6 +77,7 @@ int main(int argc, char** argv)
     auto weight_queue_preferred = program.get<size_t>("--weight-queue-preferred");
     auto weight_queue_standard = program.get<size_t>("--weight-queue-standard");
     auto heuristic_type = get_heuristic_type(program.get<std::string>("--heuristic-type"));
+    auto pdb_cache_directory = program.get<std::string>("--pdb-cache-directory");
     auto grounded = static_cast<bool>(program.get<size_t>("--enable-grounding"));
     auto verbosity = program.get<size_t>("--verbosity");
 
@@ -130,6 +134,22 @@ int main(int argc, char** argv)
             heuristic = SetAddHeuristicImpl::create(delete_relaxed_problem_explorator);
         else if (heuristic_type == HeuristicType::FF)
             heuristic = FFHeuristicImpl::create(delete_relaxed_problem_explorator);
+        else if (heuristic_type == HeuristicType::LMCUT)
+            heuristic = LMCutHeuristicImpl::create(delete_relaxed_problem_explorator);
+        else if (heuristic_type == HeuristicType::PDB)
+        {
+            auto pdb_options = PDBHeuristicImpl::Options();
+            if (!pdb_cache_directory.empty())
+                pdb_options.cache_directory = pdb_cache_directory;
+            heuristic = PDBHeuristicImpl::create(delete_relaxed_problem_explorator, pdb_options);
+        }
+        else if (heuristic_type == HeuristicType::IPDB)
+        {
+            auto ipdb_options = CanonicalPDBsHeuristicImpl::Options();
+            if (!pdb_cache_directory.empty())
+                ipdb_options.cache_directory = pdb_cache_directory;
+            heuristic = CanonicalPDBsHeuristicImpl::create(delete_relaxed_problem_explorator, ipdb_options);
+        }
     }
     else
     {
@@ -139,13 +159,17 @@ int main(int argc, char** argv)
         state_repository = StateRepositoryImpl::create(axiom_evaluator);
 
         if (heuristic_type == HeuristicType::MAX)
-            throw std::runtime_error("Lifted h_max is not supported");
+            heuristic = LiftedMaxHeuristicImpl::create(problem);
         else if (heuristic_type == HeuristicType::ADD)
-            throw std::runtime_error("Lifted h_add is not supported");
+            heuristic = LiftedAddHeuristicImpl::create(problem);
         else if (heuristic_type == HeuristicType::SETADD)
             throw std::runtime_error("Lifted h_setadd is not supported");
         else if (heuristic_type == HeuristicType::FF)
-            throw std::runtime_error("Lifted h_ff is not supported");
+            heuristic = LiftedFFHeuristicImpl::create(problem);
+        else if (heuristic_type == HeuristicType::LMCUT)
+            throw std::runtime_error("Lifted h_lmcut is not supported");
+        else if (heuristic_type == HeuristicType::PDB || heuristic_type == HeuristicType::IPDB)
+            throw std::runtime_error("Lifted pattern database heuristics are not supported");
     }
 
     auto search_context = SearchContextImpl::create(problem, applicable_action_generator, state_repository);
@@ -189,7 +213,7 @@ int main(int argc, char** argv)
     uint64_t num_fluent_state_variables = 0;
     uint64_t num_derived_state_variables = 0;
     uint64_t num_numeric_state_variables = 0;
-    for (const auto& [packed_state, index] : state_repository->get_states())
+    for (const auto& [packed_state, index] : state_repository->get_states().range())
     {
         auto state = state_repository->get_state(packed_state);
         num_fluent_state_variables += state.get_atoms<formalism::FluentTag>().count();
@@ -30,7 +30,10 @@ enum class HeuristicType
     MAX,
     ADD,
     SETADD,
-    FF
+    FF,
+    LMCUT,
+    PDB,
+    IPDB
 };
 
 inline HeuristicType get_heuristic_type(const std::string& name)
@@ -47,6 +50,12 @@ inline HeuristicType get_heuristic_type(const std::string& name)
         return HeuristicType::SETADD;
     else if (name == "ff")
         return HeuristicType::FF;
+    else if (name == "lmcut")
+        return HeuristicType::LMCUT;
+    else if (name == "pdb")
+        return HeuristicType::PDB;
+    else if (name == "ipdb")
+        return HeuristicType::IPDB;
     else
         throw std::runtime_error("Undefined mapping from name to heuristic type.");
 }
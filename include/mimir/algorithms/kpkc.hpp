@@ -18,21 +18,108 @@
 #ifndef MIMIR_INCLUDE_ALGORITHMS_KPKC_HPP_
 #define MIMIR_INCLUDE_ALGORITHMS_KPKC_HPP_
 
+#include "cista/aligned_allocator.h"
 #include "mimir/algorithms/generator.hpp"
 
-#include <boost/dynamic_bitset.hpp>
-#include <optional>
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <span>
 #include <vector>
 
 namespace mimir
 {
 
+/// @brief A square bit matrix whose rows are contiguous and 64-byte aligned.
+///
+/// Every row is padded with zero bits to a multiple of 512 bits
+/// such that SIMD kernels can process full rows without a remainder loop.
+class BitMatrix
+{
+public:
+    using Block = uint64_t;
+
+    static constexpr size_t BITS_PER_BLOCK = 64;
+    static constexpr size_t BLOCKS_PER_CACHE_LINE = 8;
+
+    BitMatrix() : BitMatrix(0) {}
+
+    explicit BitMatrix(size_t num_vertices) :
+        m_num_vertices(num_vertices),
+        m_num_blocks_per_row(compute_num_blocks_per_row(num_vertices)),
+        m_blocks(m_num_vertices * m_num_blocks_per_row, 0)
+    {
+    }
+
+    /// @brief Compute the number of blocks that hold `num_bits` bits, rounded up to full cache lines.
+    static size_t compute_num_blocks_per_row(size_t num_bits)
+    {
+        const auto num_blocks = (num_bits + BITS_PER_BLOCK - 1) / BITS_PER_BLOCK;
+        return (num_blocks + BLOCKS_PER_CACHE_LINE - 1) / BLOCKS_PER_CACHE_LINE * BLOCKS_PER_CACHE_LINE;
+    }
+
+    void set(size_t row, size_t column, bool value = true)
+    {
+        assert(row < m_num_vertices && column < m_num_vertices);
+        auto& block = m_blocks[row * m_num_blocks_per_row + column / BITS_PER_BLOCK];
+        const auto mask = Block(1) << (column % BITS_PER_BLOCK);
+        block = value ? (block | mask) : (block & ~mask);
+    }
+
+    bool test(size_t row, size_t column) const
+    {
+        assert(row < m_num_vertices && column < m_num_vertices);
+        return (m_blocks[row * m_num_blocks_per_row + column / BITS_PER_BLOCK] >> (column % BITS_PER_BLOCK)) & 1;
+    }
+
+    /// @brief Unset all bits.
+    void reset() { std::fill(m_blocks.begin(), m_blocks.end(), 0); }
+
+    size_t get_num_vertices() const { return m_num_vertices; }
+    size_t get_num_blocks_per_row() const { return m_num_blocks_per_row; }
+    const Block* get_row(size_t row) const { return m_blocks.data() + row * m_num_blocks_per_row; }
+
+private:
+    size_t m_num_vertices;
+    size_t m_num_blocks_per_row;
+    std::vector<Block, cista::aligned_allocator<Block, 64>> m_blocks;
+};
+
+/// @brief The instruction set used to intersect the candidate vertices with the neighbors of a vertex.
+enum class KPKCKernel
+{
+    SCALAR = 0,
+    AVX2 = 1,
+    AVX512 = 2,
+};
+
+/// @brief Return true iff the kernel was compiled in and the processor supports it.
+extern bool is_supported(KPKCKernel kernel);
+
+/// @brief Return the fastest kernel that the processor supports.
+extern KPKCKernel get_default_kpkc_kernel();
+
 /// @brief Thread-safe k-clique in k-partite graph enumerator.
+///
+/// Column `offset + i` of the adjacency matrix must correspond to vertex `partitions[p][i]`,
+/// where `offset` is the total size of the partitions before `p`, i.e., the partitions must be laid out contiguously.
 /// @param adjacency_matrix is the adjacency matrix.
 /// @param partitions is the vertex partitioning.
+/// @param kernel is the instruction set used for the intersections, which must be supported.
 /// @return a generator to enumerate all k-cliques.
-mimir::generator<const std::vector<uint32_t>&> create_k_clique_in_k_partite_graph_generator(const std::vector<boost::dynamic_bitset<>>& adjacency_matrix,
-                                                                                            const std::vector<std::vector<uint32_t>>& partitions);
+mimir::generator<const std::vector<uint32_t>&> create_k_clique_in_k_partite_graph_generator(const BitMatrix& adjacency_matrix,
+                                                                                            const std::vector<std::vector<uint32_t>>& partitions,
+                                                                                            KPKCKernel kernel = get_default_kpkc_kernel());
+
+/// @brief Thread-safe k-clique in k-partite graph enumerator that only enumerates the k-cliques whose vertices are candidates.
+///
+/// Restricting the candidates of a partition to a single vertex enumerates the k-cliques that contain the vertex.
+/// @param candidates has `adjacency_matrix.get_num_blocks_per_row()` blocks, where bit i is set iff vertex i is a candidate.
+mimir::generator<const std::vector<uint32_t>&> create_k_clique_in_k_partite_graph_generator(const BitMatrix& adjacency_matrix,
+                                                                                            const std::vector<std::vector<uint32_t>>& partitions,
+                                                                                            std::span<const BitMatrix::Block> candidates,
+                                                                                            KPKCKernel kernel = get_default_kpkc_kernel());
 
 }
 
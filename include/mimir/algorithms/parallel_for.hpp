@@ -0,0 +1,65 @@
+/*
+ * Copyright (C) 2023 Dominik Drexler and Simon Stahlberg
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef MIMIR_INCLUDE_ALGORITHMS_PARALLEL_FOR_HPP_
+#define MIMIR_INCLUDE_ALGORITHMS_PARALLEL_FOR_HPP_
+
+#include "mimir/algorithms/BS_thread_pool.hpp"
+
+#include <cstddef>
+#include <exception>
+#include <mutex>
+
+namespace mimir
+{
+
+/// @brief Run `body(i)` for all i in [0, num_iterations) on the `pool` and wait for all iterations to finish.
+/// The first exception thrown by an iteration is rethrown after the loop. The remaining iterations still run.
+template<typename F>
+void parallel_for(BS::thread_pool& pool, size_t num_iterations, F&& body)
+{
+    auto exception = std::exception_ptr();
+    auto exception_mutex = std::mutex();
+
+    pool.detach_loop(size_t(0),
+                     num_iterations,
+                     [&](size_t i)
+                     {
+                         try
+                         {
+                             body(i);
+                         }
+                         catch (...)
+                         {
+                             std::lock_guard<std::mutex> lock(exception_mutex);
+                             if (!exception)
+                             {
+                                 exception = std::current_exception();
+                             }
+                         }
+                     });
+    pool.wait();
+
+    if (exception)
+    {
+        std::rethrow_exception(exception);
+    }
+}
+
+}
+
+#endif
@@ -20,6 +20,7 @@
 
 #include <filesystem>
 #include <fstream>
+#include <functional>
 #include <iostream>
 #include <string>
 
@@ -28,6 +29,15 @@ namespace fs = std::filesystem;
 namespace mimir
 {
 extern void write_to_file(const fs::path& filePath, const std::string& content);
+
+/// @brief Write a binary file such that no other process or thread ever observes it partially written.
+///
+/// The content is written to a uniquely named temporary file in the same directory, which then replaces the file by a rename.
+/// Concurrent writers of the same file hence never interfere, and the last rename wins.
+/// Throws std::runtime_error if the file could not be written, in which case the temporary file is removed.
+/// @param file is the file.
+/// @param write writes the content into the given stream.
+extern void write_to_file_atomically(const fs::path& file, const std::function<void(std::ostream&)>& write);
 }
 
 #endif
@@ -0,0 +1,216 @@
+/*
+ * Copyright (C) 2023 Dominik Drexler and Simon Stahlberg
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef MIMIR_DATASETS_ARCHIVE_HPP_
+#define MIMIR_DATASETS_ARCHIVE_HPP_
+
+#include "cista/containers/string.h"
+#include "cista/containers/vector.h"
+#include "cista/mmap.h"
+#include "mimir/common/filesystem.hpp"
+#include "mimir/common/types.hpp"
+#include "mimir/datasets/declarations.hpp"
+
+#include <cstdint>
+#include <span>
+
+namespace mimir::datasets
+{
+
+/**
+ * Archive format
+ *
+ * The archive is a single cista offset-mode buffer that can be mapped into memory and used in place.
+ * All variable-length per-vertex data is stored in compressed sparse row format, i.e., the values of element i
+ * are the values in the half-open range [offsets[i], offsets[i + 1]). The offsets always start with 0, also if there are no elements.
+ */
+
+namespace archive
+{
+template<typename T>
+using Vector = cista::offset::vector<T>;
+using String = cista::offset::string;
+
+constexpr uint64_t FILE_MAGIC = 0x5344524d494d494dULL;  // "MIMIRMDS" in little endian
+constexpr uint64_t FILE_VERSION = 2;
+
+/// @brief `VertexFlag` are the bits of the vertex flags.
+enum VertexFlag : uint8_t
+{
+    INITIAL = 1,
+    GOAL = 2,
+    UNSOLVABLE = 4,
+    ALIVE = 8,
+};
+
+/// @brief `GroundTable` stores ground atoms, functions, or actions as the index of their predicate, function skeleton, or action schema
+/// together with the indices of their objects, which only depend on the domain and problem files.
+struct GroundTable
+{
+    Vector<Index> symbols;
+    Vector<uint64_t> object_offsets;
+    Vector<Index> objects;
+};
+
+/// @brief `ProblemGraph` stores the `graphs::ProblemGraph` of a `StateSpace`.
+///
+/// Ground atom and ground action indices depend on the order of grounding, which differs between processes.
+/// Hence, states, edges, and atom tuples refer to positions in the ground tables of the problem graph instead.
+/// States are stored as their sorted fluent and derived atom positions and their numeric variables,
+/// where numeric variable i is the value of the ground function at position i of `numeric_variable_table`.
+struct ProblemGraph
+{
+    String problem_filepath;  ///< Empty if the problem was not parsed from a file.
+    bool is_symmetry_reduced;
+    Index initial_vertex;
+
+    /* Ground tables */
+    GroundTable fluent_atom_table;
+    GroundTable derived_atom_table;
+    GroundTable numeric_variable_table;
+    GroundTable action_table;
+
+    /* Vertices */
+    Vector<DiscreteCost> unit_goal_distances;
+    Vector<ContinuousCost> action_goal_distances;
+    Vector<uint8_t> vertex_flags;
+    Vector<uint64_t> fluent_atom_offsets;
+    Vector<Index> fluent_atoms;
+    Vector<uint64_t> derived_atom_offsets;
+    Vector<Index> derived_atoms;
+    Vector<uint64_t> numeric_variable_offsets;
+    Vector<double> numeric_variables;
+
+    /* Edges */
+    Vector<Index> edge_sources;
+    Vector<Index> edge_targets;
+    Vector<Index> edge_actions;  ///< Positions in `action_table`.
+    Vector<ContinuousCost> edge_action_costs;
+};
+
+/// @brief `ClassGraph` stores the `graphs::ClassGraph` of a `GeneralizedStateSpace`.
+/// Problem indices refer to `KnowledgeBase::state_spaces`.
+struct ClassGraph
+{
+    /* Vertices */
+    Vector<Index> vertex_problem_indices;
+    Vector<Index> vertex_problem_vertex_indices;
+    Vector<uint8_t> vertex_flags;
+
+    /* Edges */
+    Vector<Index> edge_sources;
+    Vector<Index> edge_targets;
+    Vector<Index> edge_problem_indices;
+    Vector<Index> edge_problem_edge_indices;
+};
+
+/// @brief `TupleGraph` stores the `graphs::InternalTupleGraph` of a `TupleGraph` together with its vertices grouped by distance.
+/// Atom tuples refer to positions in the `fluent_atom_table` of the problem graph.
+struct TupleGraph
+{
+    /* Vertices */
+    Vector<uint64_t> atom_tuple_offsets;
+    Vector<Index> atom_tuples;
+    Vector<uint64_t> problem_vertex_offsets;
+    Vector<Index> problem_vertices;
+
+    /* Edges */
+    Vector<Index> edge_sources;
+    Vector<Index> edge_targets;
+
+    /* Grouped by distance */
+    Vector<uint64_t> vertices_by_distance_offsets;
+    Vector<Index> vertices_by_distance;
+    Vector<uint64_t> problem_vertices_by_distance_offsets;
+    Vector<Index> problem_vertices_by_distance;
+};
+
+/// @brief `KnowledgeBase` is the root of the archive.
+struct KnowledgeBase
+{
+    uint64_t magic;
+    uint64_t version;
+    String domain_filepath;  ///< Empty if the domain was not parsed from a file.
+    Vector<ProblemGraph> state_spaces;
+    bool has_generalized_state_space;
+    ClassGraph class_graph;  ///< Empty if there is no generalized state space.
+    bool has_tuple_graphs;
+    Vector<Vector<TupleGraph>> tuple_graphs;  ///< The tuple graphs of each state space, empty if there are no tuple graphs.
+};
+
+/// @brief Get the values of element `pos` of a compressed sparse row format without copying.
+template<typename T>
+std::span<const T> get_range(const Vector<uint64_t>& offsets, const Vector<T>& values, size_t pos)
+{
+    return std::span<const T>(values.data() + offsets[pos], values.data() + offsets[pos + 1]);
+}
+
+inline bool has_flag(uint8_t flags, VertexFlag flag) { return (flags & flag) != 0; }
+}
+
+/// @brief `KnowledgeBaseArchiveImpl` is a read-only view of a `KnowledgeBase` that was written to disk.
+///
+/// Opening an archive maps the file into memory and checks its header, i.e., its size, format version, and type hash, without
+/// reading, copying, or parsing the data. The checksum and the offsets, which require reading the whole file, are checked by `verify`.
+/// The mapping is shared read-only between all processes that open the same file.
+class KnowledgeBaseArchiveImpl
+{
+private:
+    cista::mmap m_mapping;
+    const archive::KnowledgeBase* m_data;
+
+public:
+    /// @brief Map the archive at the given file.
+    /// Throws an exception if the file is not an archive of the current format version, or if it is too small to hold one.
+    /// @param filepath is the file.
+    explicit KnowledgeBaseArchiveImpl(const fs::path& filepath);
+
+    KnowledgeBaseArchiveImpl(const KnowledgeBaseArchiveImpl& other) = delete;
+    KnowledgeBaseArchiveImpl& operator=(const KnowledgeBaseArchiveImpl& other) = delete;
+    KnowledgeBaseArchiveImpl(KnowledgeBaseArchiveImpl&& other) = delete;
+    KnowledgeBaseArchiveImpl& operator=(KnowledgeBaseArchiveImpl&& other) = delete;
+
+    /**
+     * Constructors
+     */
+
+    static KnowledgeBaseArchive open(const fs::path& filepath);
+
+    /// @brief Verify the checksum of the archive and validate all offsets, e.g., for files that were not written by this process.
+    /// Throws an exception if the archive is truncated or corrupted.
+    void verify() const;
+
+    /// @brief Write the `KnowledgeBase` to the given file.
+    /// The archive is written with `write_to_file_atomically`, such that concurrent readers never map a partially written file.
+    /// @param knowledge_base is the `KnowledgeBase`.
+    /// @param filepath is the file.
+    static void write(const KnowledgeBaseImpl& knowledge_base, const fs::path& filepath);
+
+    /**
+     * Getters
+     */
+
+    const archive::KnowledgeBase& get_data() const;
+    const archive::ProblemGraph& get_state_space(size_t pos) const;
+    size_t get_num_state_spaces() const;
+    /// @brief Get the size of the mapped file in bytes.
+    size_t get_num_bytes() const;
+};
+
+}
+
+#endif
@@ -32,6 +32,9 @@ namespace mimir::datasets
 class KnowledgeBaseImpl;
 using KnowledgeBase = std::shared_ptr<KnowledgeBaseImpl>;
 
+class KnowledgeBaseArchiveImpl;
+using KnowledgeBaseArchive = std::shared_ptr<const KnowledgeBaseArchiveImpl>;
+
 class StateSpaceImpl;
 using StateSpace = std::shared_ptr<StateSpaceImpl>;
 using StateSpaceList = std::vector<StateSpace>;
@@ -39,13 +39,17 @@ private:
 
     std::optional<std::vector<TupleGraphList>> m_tuple_graphs;  ///< Optional tuple graphs for each `StateSpace`.
 
+    std::optional<std::vector<size_t>>
+        m_tuple_graph_workspace_memory_usage_in_bytes;  ///< Optional estimated bytes of the workspaces that created the tuple graphs of each `StateSpace`.
+
 public:
     using Options = knowledge_base::Options;
 
     KnowledgeBaseImpl(formalism::Domain domain,
                       StateSpaceList state_spaces,
                       std::optional<GeneralizedStateSpace> generalized_state_space,
-                      std::optional<std::vector<TupleGraphList>> tuple_graphs);
+                      std::optional<std::vector<TupleGraphList>> tuple_graphs,
+                      std::optional<std::vector<size_t>> tuple_graph_workspace_memory_usage_in_bytes = std::nullopt);
 
     /**
      * Constructors
@@ -61,6 +65,7 @@ public:
     const StateSpaceList& get_state_spaces() const;
     const std::optional<GeneralizedStateSpace>& get_generalized_state_space() const;
     const std::optional<std::vector<TupleGraphList>>& get_tuple_graphs() const;
+    const std::optional<std::vector<size_t>>& get_tuple_graph_workspace_memory_usage_in_bytes() const;
 };
 }
 
@@ -18,21 +18,220 @@
 #ifndef MIMIR_DATASETS_OBJECT_GRAPH_HPP_
 #define MIMIR_DATASETS_OBJECT_GRAPH_HPP_
 
+#include "mimir/common/types.hpp"
 #include "mimir/datasets/declarations.hpp"
 #include "mimir/formalism/declarations.hpp"
 #include "mimir/graphs/concrete/vertex_colored_graph.hpp"
 #include "mimir/search/declarations.hpp"
 
+#include <limits>
+#include <optional>
 #include <ostream>
+#include <span>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
 
 namespace mimir::datasets
 {
 
+/// @brief `FlatObjectGraph` is an object graph in compressed sparse row format whose vertex colors index the colors of an `ObjectGraphBuilder`.
+///
+/// The first vertices are the objects in increasing order of their index, followed by the vertices of the static atoms and the goal literals,
+/// and the vertices of the atoms of the state. Each undirected edge is stored in both directions.
+struct FlatObjectGraph
+{
+    IndexList vertex_colors;
+    IndexList edge_offsets;  ///< The neighbors of vertex v are edge_targets[edge_offsets[v]] to edge_targets[edge_offsets[v + 1] - 1].
+    IndexList edge_targets;
+    IndexList objects;           ///< The object index of each object vertex.
+    IndexList object_num_atoms;  ///< The number of fluent and derived atoms of the state that contain each object vertex.
+    IndexList atoms;             ///< The key of each atom of the state with vertices in the order of its vertices, see `ObjectGraphBuilder`.
+
+    size_t get_num_vertices() const { return vertex_colors.size(); }
+    size_t get_num_edges() const { return edge_targets.size(); }
+};
+
+/// @brief `ObjectGraphBatch` stores the object graphs of several states in flat index arrays, e.g., for the hand-off to tensors.
+struct ObjectGraphBatch
+{
+    IndexList vertex_offsets;  ///< The vertices of graph i are vertex_offsets[i] to vertex_offsets[i + 1] - 1.
+    IndexList vertex_colors;
+    IndexList edge_offsets;  ///< The edges of graph i are edge_offsets[i] to edge_offsets[i + 1] - 1.
+    IndexList edge_sources;  ///< The vertex indices of the edges refer to the vertices of the batch.
+    IndexList edge_targets;
+
+    size_t get_num_graphs() const { return vertex_offsets.empty() ? 0 : vertex_offsets.size() - 1; }
+};
+
+/// @brief `ObjectGraphBuilder` creates the object graphs of the states of a problem.
+///
+/// The vertices of the static atoms and the goal literals, and the colors of the objects that they induce, are computed once per problem.
+/// The atoms of states are decoded once, such that creating a graph allocates no memory once the buffers have grown to their final size.
+/// The builder is not thread-safe, i.e., each thread needs its own builder.
+class ObjectGraphBuilder
+{
+public:
+    explicit ObjectGraphBuilder(const formalism::ProblemImpl& problem);
+
+    /// @brief Create the object graph of a state.
+    /// @param state is the state.
+    /// @param out_graph is the graph, whose memory is reused.
+    void create(const search::State& state, FlatObjectGraph& out_graph);
+
+    /// @brief Create the object graph of a state from the graph of its parent state by applying the difference of their atoms.
+    ///
+    /// The vertices of the deleted atoms are removed and the vertices of the added atoms are appended, such that only the
+    /// adjacency of the objects of these atoms changes, and only the objects of added or deleted unary atoms are recolored.
+    /// The result is isomorphic to the graph created from scratch, but its atom vertices may be ordered differently.
+    /// If an object enters or leaves the graph, then the vertices of all objects shift, and the graph is created from scratch.
+    /// @param state is the state.
+    /// @param parent_state is the parent state.
+    /// @param parent_graph is the object graph of the parent state that was created by this builder.
+    /// @param out_graph is the graph, whose memory is reused, and which must not be the parent graph.
+    void create(const search::State& state, const search::State& parent_state, const FlatObjectGraph& parent_graph, FlatObjectGraph& out_graph);
+
+    /// @brief Create the object graphs of states into flat index arrays.
+    /// @param states are the states.
+    /// @param out_batch is the batch, whose memory is reused.
+    void create(std::span<const search::State> states, ObjectGraphBatch& out_batch);
+
+    /// @brief Create the object graph of a state as vertex-colored graph.
+    /// @param state is the state.
+    /// @param out_graph is the graph, which is cleared first.
+    void create(const search::State& state, graphs::StaticVertexColoredGraph& out_graph);
+
+    /// @brief Translate an object graph created by this builder into a vertex-colored graph.
+    /// @param graph is the object graph.
+    /// @param out_graph is the graph, which is cleared first.
+    void translate(const FlatObjectGraph& graph, graphs::StaticVertexColoredGraph& out_graph) const;
+
+    /**
+     * Getters
+     */
+
+    const formalism::ProblemImpl& get_problem() const;
+    const graphs::Color& get_color(Index color) const;
+    size_t get_num_colors() const;
+
+private:
+    static constexpr Index NO_OBJECT = std::numeric_limits<Index>::max();
+
+    /// @brief A vertex of an atom or a literal, which is connected to the vertex of its object and, if chained, to the previous vertex.
+    struct AtomVertex
+    {
+        Index color;
+        Index object;  ///< The object slot, or NO_OBJECT.
+        bool chained;
+    };
+
+    /// @brief The decoded atom of a state.
+    struct AtomInfo
+    {
+        Index begin = 0;  ///< The vertices of the atom are m_atom_vertices[begin] to m_atom_vertices[end - 1].
+        Index end = 0;
+        Index unary_object = NO_OBJECT;  ///< The object slot of a unary atom, or NO_OBJECT.
+        Index unary_predicate = 0;
+        bool is_decoded = false;
+    };
+
+    template<formalism::IsStaticOrFluentOrDerivedTag P>
+    Index get_or_create_predicate_key(formalism::Predicate<P> predicate);
+
+    /// @brief Add the color whose key is in `m_color_key`.
+    Index add_color(graphs::Color color);
+
+    template<formalism::IsStaticOrFluentOrDerivedTag P>
+    Index get_or_create_atom_color(formalism::Predicate<P> predicate, std::optional<size_t> pos, std::optional<bool> polarity);
+
+    Index get_or_create_object_color(std::span<const Index> unary_predicates, std::span<const Index> unary_literals);
+
+    template<formalism::IsStaticOrFluentOrDerivedTag P>
+    void add_atom_vertices(formalism::Predicate<P> predicate,
+                           const formalism::ObjectList& objects,
+                           std::optional<bool> polarity,
+                           std::vector<AtomVertex>& out_vertices);
+
+    template<formalism::IsFluentOrDerivedTag P>
+    const AtomInfo& get_or_create_atom_info(Index atom_index);
+
+    /// @brief Get the key of an atom, which is unique among the fluent and derived atoms.
+    template<formalism::IsFluentOrDerivedTag P>
+    static Index get_atom_key(Index atom_index);
+
+    /// @brief Get the decoded atom of a key.
+    const AtomInfo& get_atom_info(Index atom_key) const;
+
+    template<formalism::IsFluentOrDerivedTag P>
+    void collect_atoms(const search::State& state);
+
+    /// @brief Collect the changes of the objects by the atoms of the state that are not in the other state, and the keys of the added atoms.
+    template<formalism::IsFluentOrDerivedTag P>
+    void collect_atom_difference(const search::State& state, const search::State& other_state, const FlatObjectGraph& parent_graph, bool is_added);
+
+    /// @brief Mark the object as changed by the difference of atoms, starting from its count of atoms in the parent graph.
+    void touch_object(Index slot, const FlatObjectGraph& parent_graph);
+
+    /// @brief Append the vertices of an atom to the graph and their edges to `m_edge_sources` and `m_edge_targets`.
+    void append_atom_vertices(std::span<const AtomVertex> vertices, FlatObjectGraph& out_graph);
+
+    void create_from_collected_atoms(FlatObjectGraph& out_graph);
+
+    const formalism::ProblemImpl& m_problem;
+
+    /* Colors */
+    std::vector<graphs::Color> m_colors;
+    UnorderedMap<IndexList, Index> m_color_indices;
+    std::vector<IndexList> m_color_unary_predicates;  ///< The sorted keys of the unary atoms of each object color.
+    std::unordered_map<Index, formalism::PredicateVariant> m_predicates;  ///< Maps the key of each predicate to the predicate.
+
+    /* Objects */
+    formalism::ObjectList m_objects;  ///< The objects in increasing order of their index, whose positions are their slots.
+    IndexList m_object_to_slot;
+    std::vector<bool> m_is_skeleton_object;  ///< Whether the object occurs in a static atom or a goal literal.
+    IndexList m_static_unary_offsets;        ///< The sorted keys of the unary static atoms of each object slot.
+    IndexList m_static_unary_predicates;
+    IndexList m_goal_unary_offsets;  ///< The sorted keys of the unary goal literals of each object slot.
+    IndexList m_goal_unary_literals;
+    IndexList m_skeleton_object_colors;
+
+    /* Atoms */
+    std::vector<AtomVertex> m_skeleton_vertices;  ///< The vertices of the static atoms and the goal literals.
+    std::vector<AtomVertex> m_atom_vertices;
+    std::vector<AtomInfo> m_fluent_atom_infos;
+    std::vector<AtomInfo> m_derived_atom_infos;
+
+    /* Memory for reuse */
+    std::vector<AtomInfo> m_state_atoms;
+    IndexList m_state_atom_keys;
+    IndexList m_added_atom_keys;
+    std::vector<bool> m_is_touched;
+    IndexList m_touched_slots;
+    IndexList m_slot_num_atoms;
+    std::vector<std::tuple<Index, Index, bool>> m_unary_changes;  ///< Triples of object slot, predicate key, and whether the atom is added.
+    IndexList m_vertex_map;
+    std::vector<bool> m_is_present;
+    std::vector<std::pair<Index, Index>> m_unary_atoms;
+    IndexList m_unary_predicates;
+    IndexList m_slot_to_vertex;
+    IndexList m_color_key;
+    IndexList m_edge_sources;
+    IndexList m_edge_targets;
+    IndexList m_edge_positions;
+    FlatObjectGraph m_graph;
+};
+
 /// @brief Create an `ObjectGraph` for a given `search::State` from a given `formalism::ProblemImpl`.
 /// @param state is the state.
 /// @param problem is the Problem.
 extern graphs::StaticVertexColoredGraph create_object_graph(const search::State& state, const formalism::ProblemImpl& problem);
 
+/// @brief Create an `ObjectGraph` for a given `search::State` from a given `formalism::ProblemImpl` into a graph whose memory is reused.
+/// @param state is the state.
+/// @param problem is the Problem.
+/// @param out_graph is the graph, which is cleared first.
+extern void create_object_graph(const search::State& state, const formalism::ProblemImpl& problem, graphs::StaticVertexColoredGraph& out_graph);
+
 }
 
 #endif
@@ -70,6 +70,12 @@ public:
     /// reduction is enabled.
     static std::optional<std::pair<StateSpace, std::optional<CertificateMaps>>> create(search::SearchContext context, const Options& options = Options());
 
+    /// @brief Create the `StateSpace`s of the given `search::GeneralizedSearchContext` and the given `Options`.
+    /// The state spaces of different problems are constructed concurrently with `Options::num_threads` threads.
+    /// The result does not depend on the number of threads: the state spaces are in the order of the problems, stably sorted if requested.
+    /// @param contexts is the `search::GeneralizedSearchContext`.
+    /// @param options are the `Options`.
+    /// @return the successfully expanded state spaces paired with optional canonical state representations.
     static std::vector<std::pair<StateSpace, std::optional<CertificateMaps>>> create(search::GeneralizedSearchContext contexts,
                                                                                      const Options& options = Options());
 
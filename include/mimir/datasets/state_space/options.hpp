@@ -30,13 +30,17 @@ struct Options
     bool remove_if_unsolvable;
     uint32_t max_num_states;
     uint32_t timeout_ms;
+    uint32_t num_threads;        ///< The number of threads that construct the state spaces of different problems concurrently.
+    uint32_t num_layer_threads;  ///< The number of threads that expand the states of a breadth-first layer, and compute their certificates, concurrently.
 
     Options() :
         sort_ascending_by_num_states(true),
         symmetry_pruning(false),
         remove_if_unsolvable(true),
         max_num_states(std::numeric_limits<uint32_t>::max()),
-        timeout_ms(std::numeric_limits<uint32_t>::max())
+        timeout_ms(std::numeric_limits<uint32_t>::max()),
+        num_threads(1),
+        num_layer_threads(1)
     {
     }
 };
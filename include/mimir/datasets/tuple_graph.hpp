@@ -57,14 +57,28 @@ public:
                    IndexGroupedVector<const Index> problem_vertices_grouped_by_distance);
 
     /// @brief Create the `TupleGraph` for each vertex in the given `StateSpace`.
+    ///
+    /// The tuple graphs of different vertices are created concurrently by `options.num_threads` threads,
+    /// each of which reuses its memory across the vertices that it processes.
     /// @param state_space is the `StateSpace`
+    /// @param certificate_maps are the certificate maps of the `StateSpace` if it was created with symmetry pruning, which are only read.
     /// @return are the `TupleGraph` for each vertex in the given `StateSpace`.
     static TupleGraphList create(StateSpace state_space, std::optional<CertificateMaps>& certificate_maps, const Options& options = Options());
 
+    /// @brief Create the `TupleGraph` for each vertex in the given `StateSpace` and report the memory of the workspaces of the threads.
+    /// @param out_workspace_memory_usage_in_bytes is the estimated number of bytes of the workspaces once all tuple graphs are created.
+    static TupleGraphList create(StateSpace state_space,
+                                 std::optional<CertificateMaps>& certificate_maps,
+                                 const Options& options,
+                                 size_t& out_workspace_memory_usage_in_bytes);
+
     const StateSpace& get_state_space() const;
     const graphs::InternalTupleGraph& get_graph() const;
     const IndexGroupedVector<const Index>& get_tuple_vertex_indices_grouped_by_distance() const;
     const IndexGroupedVector<const Index>& get_problem_vertex_indices_grouped_by_distance() const;
+
+    /// @brief Get the estimated number of bytes of the vertices, edges, and distance groups.
+    size_t get_estimated_memory_usage_in_bytes() const;
 };
 
 using TupleGraphList = std::vector<TupleGraph>;
@@ -27,9 +27,15 @@ struct Options
 {
     size_t width;
     bool enable_dominance_pruning;
+    uint32_t num_threads;  ///< The number of threads that create the tuple graphs of different vertices concurrently.
 
-    Options() : width(0), enable_dominance_pruning(true) {}
-    Options(size_t width, bool enable_dominance_pruning) : width(width), enable_dominance_pruning(enable_dominance_pruning) {}
+    Options() : width(0), enable_dominance_pruning(true), num_threads(1) {}
+    Options(size_t width, bool enable_dominance_pruning, uint32_t num_threads = 1) :
+        width(width),
+        enable_dominance_pruning(enable_dominance_pruning),
+        num_threads(num_threads)
+    {
+    }
 };
 }
 
@@ -25,6 +25,7 @@
 #include "mimir/formalism/declarations.hpp"
 
 #include <cassert>
+#include <cstdint>
 #include <limits>
 #include <tuple>
 #include <vector>
@@ -32,6 +33,27 @@
 namespace mimir::formalism
 {
 
+/// @brief `PredicateAssignmentSet` is a view on the assignments of a single predicate in an `AssignmentSet`.
+class PredicateAssignmentSet
+{
+private:
+    const uint64_t* m_words;
+    size_t m_offset;
+    size_t m_size;
+
+public:
+    PredicateAssignmentSet(const uint64_t* words, size_t offset, size_t size) : m_words(words), m_offset(offset), m_size(size) {}
+
+    bool operator[](size_t rank) const
+    {
+        assert(rank < m_size);
+        const auto position = m_offset + rank;
+        return (m_words[position / 64] >> (position % 64)) & 1;
+    }
+
+    size_t size() const { return m_size; }
+};
+
 /// @brief `AssignmentSet` is a helper class representing a set of functions
 /// f : Predicates x Params(A) x Object x Params(A) x Object -> {true, false} where
 ///   1. f(p,i,o,j,o') = true iff there exists an atom p(...,o_i,...,o'_j,...)
@@ -40,6 +62,10 @@ namespace mimir::formalism
 ///   1. the assignment [i/o], [j/o'] is consistent
 ///   2. the assignment [i/o] is consistent
 ///
+/// The functions of all predicates are packed into a single array of words.
+/// Each true assignment counts its supporting atoms such that atoms can be erased again,
+/// which allows updating the set by the difference between two states instead of rebuilding it.
+///
 /// We say that an assignment set is static if all atoms it considers are static.
 template<IsStaticOrFluentOrDerivedTag P>
 class AssignmentSet
@@ -48,7 +74,22 @@ private:
     size_t m_num_objects;
 
     // The underlying function
-    std::vector<std::vector<bool>> m_per_predicate_assignment_set;
+    std::vector<size_t> m_per_predicate_offset;  ///< The position of the first assignment of a predicate in `m_words`.
+    std::vector<size_t> m_per_predicate_size;    ///< The number of assignments of a predicate.
+    std::vector<uint64_t> m_words;
+
+    std::vector<uint32_t> m_counts;  ///< The number of atoms that support an assignment, indexed by its position in `m_words`.
+    FlatBitset m_atoms;              ///< The indices of the atoms in the set.
+
+    /* Memory for reuse */
+    std::vector<std::tuple<size_t, uint64_t, uint64_t>> m_changed_blocks;  ///< The block index, erased bits, and inserted bits.
+
+    template<typename F>
+    void for_each_position(GroundAtom<P> ground_atom, F&& callback) const;
+
+    void insert_position(size_t position);
+
+    void erase_position(size_t position);
 
 public:
     AssignmentSet();
@@ -62,15 +103,32 @@ public:
     /// @brief Insert ground atoms into the assignment set.
     void insert_ground_atoms(const GroundAtomList<P>& ground_atoms);
 
-    /// @brief Insert a ground atom into the assignment set.
+    /// @brief Insert a ground atom into the assignment set. Inserting an atom that is already contained has no effect.
     void insert_ground_atom(GroundAtom<P> ground_atom);
 
+    /// @brief Erase ground atoms from the assignment set.
+    void erase_ground_atoms(const GroundAtomList<P>& ground_atoms);
+
+    /// @brief Erase a ground atom from the assignment set. Erasing an atom that is not contained has no effect.
+    void erase_ground_atom(GroundAtom<P> ground_atom);
+
+    /// @brief Update the assignment set to contain exactly the ground atoms with the given indices.
+    /// Only the atoms that differ from the current content are inserted or erased,
+    /// unless the difference is larger than the given atoms, in which case the set is rebuilt.
+    void update_ground_atoms(const FlatBitset& atom_indices, const Repositories& repositories);
+
     /**
      * Getters
      */
 
     size_t get_num_objects() const { return m_num_objects; }
-    const std::vector<std::vector<bool>>& get_per_predicate_assignment_set() const { return m_per_predicate_assignment_set; }
+    PredicateAssignmentSet get_predicate_assignment_set(Index predicate_index) const
+    {
+        assert(predicate_index < m_per_predicate_offset.size());
+        return PredicateAssignmentSet(m_words.data(), m_per_predicate_offset[predicate_index], m_per_predicate_size[predicate_index]);
+    }
+    size_t get_num_predicates() const { return m_per_predicate_offset.size(); }
+    const FlatBitset& get_atoms() const { return m_atoms; }
 };
 
 /// @brief `NumericAssignmentSet` is a helper class representing a set of functions
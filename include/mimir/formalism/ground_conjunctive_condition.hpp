@@ -21,6 +21,7 @@
 #include "mimir/common/printers.hpp"
 #include "mimir/common/types_cista.hpp"
 #include "mimir/formalism/declarations.hpp"
+#include "mimir/formalism/numeric_bytecode.hpp"
 
 #include <loki/details/utils/equal_to.hpp>
 #include <loki/details/utils/hash.hpp>
@@ -34,6 +35,8 @@ private:
     HanaContainer<HanaContainer<const FlatIndexList*, StaticTag, FluentTag, DerivedTag>, PositiveTag, NegativeTag> m_preconditions;
     GroundNumericConstraintList m_numeric_constraints;
 
+    NumericBytecode m_numeric_constraint_bytecode;
+
     GroundConjunctiveConditionImpl(Index index,
                                    HanaContainer<HanaContainer<const FlatIndexList*, StaticTag, FluentTag, DerivedTag>, PositiveTag, NegativeTag> preconditions,
                                    GroundNumericConstraintList numeric_constraints);
@@ -74,6 +77,8 @@ public:
     size_t get_num_preconditions() const;
 
     const GroundNumericConstraintList& get_numeric_constraints() const;
+    /// @brief Get the bytecode with one program for each numeric constraint, which evaluates all of them against the same numeric variables.
+    const NumericBytecode& get_numeric_constraint_bytecode() const;
 
     auto identifying_members() const
     {
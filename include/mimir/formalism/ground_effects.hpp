@@ -22,6 +22,7 @@
 #include "mimir/common/types_cista.hpp"
 #include "mimir/formalism/declarations.hpp"
 #include "mimir/formalism/ground_conjunctive_condition.hpp"
+#include "mimir/formalism/numeric_bytecode.hpp"
 
 #include <loki/details/utils/equal_to.hpp>
 #include <loki/details/utils/hash.hpp>
@@ -40,6 +41,8 @@ private:
 
     // Below: add additional members if needed and initialize them in the constructor
 
+    NumericBytecode m_bytecode;
+
     GroundNumericEffectImpl(Index index, loki::AssignOperatorEnum assign_operator, GroundFunction<F> function, GroundFunctionExpression function_expression);
 
     // Give access to the constructor.
@@ -57,6 +60,8 @@ public:
     loki::AssignOperatorEnum get_assign_operator() const;
     GroundFunction<F> get_function() const;
     GroundFunctionExpression get_function_expression() const;
+    /// @brief Get the bytecode of the function expression.
+    const NumericBytecode& get_bytecode() const;
 
     /// @brief Return a tuple of const references to the members that uniquely identify an object.
     /// This enables the automatic generation of `loki::Hash` and `loki::EqualTo` specializations.
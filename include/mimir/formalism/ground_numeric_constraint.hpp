@@ -20,6 +20,7 @@
 
 #include "mimir/common/types_cista.hpp"
 #include "mimir/formalism/declarations.hpp"
+#include "mimir/formalism/numeric_bytecode.hpp"
 
 namespace mimir::formalism
 {
@@ -33,6 +34,8 @@ private:
 
     // Below: add additional members if needed and initialize them in the constructor
 
+    NumericBytecode m_bytecode;
+
     GroundNumericConstraintImpl(Index index,
                                 loki::BinaryComparatorEnum binary_comparator,
                                 GroundFunctionExpression left_function_expression,
@@ -55,6 +58,8 @@ public:
     loki::BinaryComparatorEnum get_binary_comparator() const;
     GroundFunctionExpression get_left_function_expression() const;
     GroundFunctionExpression get_right_function_expression() const;
+    /// @brief Get the bytecode of the numeric constraint that evaluates to 1 if it holds and to 0 otherwise.
+    const NumericBytecode& get_bytecode() const;
 
     /// @brief Return a tuple of const references to the members that uniquely identify an object.
     /// This enables the automatic generation of `loki::Hash` and `loki::EqualTo` specializations.
@@ -18,7 +18,9 @@
 #ifndef MIMIR_FORMALISM_METRIC_HPP_
 #define MIMIR_FORMALISM_METRIC_HPP_
 
+#include "mimir/common/types_cista.hpp"
 #include "mimir/formalism/declarations.hpp"
+#include "mimir/formalism/numeric_bytecode.hpp"
 
 namespace mimir::formalism
 {
@@ -31,6 +33,8 @@ private:
 
     // Below: add additional members if needed and initialize them in the constructor
 
+    NumericBytecode m_bytecode;
+
     OptimizationMetricImpl(Index index, loki::OptimizationMetricEnum optimization_metric, GroundFunctionExpression function_expression);
 
     // Give access to the constructor.
@@ -49,6 +53,8 @@ public:
     Index get_index() const;
     loki::OptimizationMetricEnum get_optimization_metric() const;
     GroundFunctionExpression get_function_expression() const;
+    /// @brief Get the bytecode of the function expression.
+    const NumericBytecode& get_bytecode() const;
 
     /// @brief Return a tuple of const references to the members that uniquely identify an object.
     /// This enables the automatic generation of `loki::Hash` and `loki::EqualTo` specializations.
@@ -56,6 +62,12 @@ public:
     auto identifying_members() const { return std::tuple(get_optimization_metric(), get_function_expression()); }
 };
 
+/**
+ * Utils
+ */
+
+extern ContinuousCost evaluate(OptimizationMetric metric, const FlatDoubleList& static_numeric_variables, const FlatDoubleList& fluent_numeric_variables);
+
 extern std::ostream& operator<<(std::ostream& out, const OptimizationMetricImpl& element);
 
 extern std::ostream& operator<<(std::ostream& out, OptimizationMetric element);
@@ -0,0 +1,108 @@
+/*
+ * Copyright (C) 2023 Dominik Drexler and Simon Stahlberg
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef MIMIR_FORMALISM_NUMERIC_BYTECODE_HPP_
+#define MIMIR_FORMALISM_NUMERIC_BYTECODE_HPP_
+
+#include "mimir/common/types.hpp"
+#include "mimir/common/types_cista.hpp"
+#include "mimir/formalism/declarations.hpp"
+
+#include <cstdint>
+#include <vector>
+
+namespace mimir::formalism
+{
+
+enum class NumericOpcode : uint8_t
+{
+    PUSH_NUMBER = 0,
+    PUSH_STATIC_FUNCTION = 1,
+    PUSH_FLUENT_FUNCTION = 2,
+    PUSH_AUXILIARY_FUNCTION = 3,  ///< Auxiliary functions have no value in a state, evaluating them throws.
+    ADD = 4,
+    SUB = 5,
+    MUL = 6,
+    DIV = 7,
+    NEG = 8,
+    EQUAL = 9,
+    GREATER = 10,
+    GREATER_EQUAL = 11,
+    LESS = 12,
+    LESS_EQUAL = 13,
+    RETURN = 14,  ///< Pops the value of the program.
+};
+
+struct NumericInstruction
+{
+    NumericOpcode opcode;
+    Index index;            ///< The index of the ground function of a push function instruction.
+    ContinuousCost number;  ///< The number of a push number instruction.
+};
+
+/// @brief `NumericBytecode` is a sequence of programs in postfix bytecode that evaluate ground function expressions and numeric constraints.
+///
+/// The programs are compiled once from the expression trees and then evaluated by a stack machine in a single loop
+/// without recursion or variant dispatch. The evaluation has the same semantics as `evaluate` on a `GroundFunctionExpression`,
+/// i.e., undefined values propagate, a division by zero is undefined, and a numeric constraint with an undefined side evaluates to 0.
+class NumericBytecode
+{
+public:
+    NumericBytecode();
+
+    /// @brief Append a program that evaluates the function expression.
+    void append(GroundFunctionExpression function_expression);
+
+    /// @brief Append a program that evaluates to 1 if the numeric constraint holds and to 0 otherwise.
+    void append(loki::BinaryComparatorEnum binary_comparator,
+                GroundFunctionExpression left_function_expression,
+                GroundFunctionExpression right_function_expression);
+
+    /// @brief Append the programs of the other bytecode.
+    void append(const NumericBytecode& other);
+
+    /// @brief Evaluate the bytecode consisting of a single program.
+    ContinuousCost evaluate(const FlatDoubleList& static_numeric_variables, const FlatDoubleList& fluent_numeric_variables) const;
+
+    /// @brief Evaluate all programs in order against the same numeric variables.
+    void evaluate(const FlatDoubleList& static_numeric_variables,
+                  const FlatDoubleList& fluent_numeric_variables,
+                  std::vector<ContinuousCost>& out_values) const;
+
+    /// @brief Return true iff all programs evaluate to a nonzero value, e.g., all numeric constraints hold.
+    /// The evaluation stops at the first program that evaluates to 0.
+    bool holds(const FlatDoubleList& static_numeric_variables, const FlatDoubleList& fluent_numeric_variables) const;
+
+    /**
+     * Getters
+     */
+
+    const std::vector<NumericInstruction>& get_instructions() const;
+    size_t get_num_programs() const;
+    /// @brief Get the maximum number of values on the stack during the evaluation of a program.
+    size_t get_max_stack_size() const;
+
+private:
+    std::vector<NumericInstruction> m_instructions;
+    size_t m_num_programs;
+    size_t m_max_stack_size;
+};
+
+}
+
+#endif
@@ -24,7 +24,7 @@
 #include "mimir/formalism/problem_details.hpp"
 #include "mimir/formalism/repositories.hpp"
 
-#include <valla/indexed_hash_set.hpp>
+#include <valla/concurrent_indexed_hash_set.hpp>
 
 namespace mimir::formalism
 {
@@ -60,8 +60,8 @@ private:
     FlatDoubleListMap m_flat_double_list_map;  ///< Stores all created numeric variable lists.
     std::vector<const FlatDoubleList*> m_flat_double_lists;
 
-    valla::IndexedHashSet<valla::Slot<Index>, Index> m_index_tree_table;
-    valla::IndexedHashSet<double, Index> m_double_leaf_table;
+    valla::ConcurrentIndexedHashSet<valla::Slot<Index>, Index> m_index_tree_table;  ///< Shared by all state repositories, thread-safe on demand.
+    valla::ConcurrentIndexedHashSet<double, Index> m_double_leaf_table;             ///< Shared by all state repositories, thread-safe on demand.
 
     SharedObjectPool<FlatBitset> m_bitset_pool;
     SharedObjectPool<FlatIndexList> m_index_list_pool;
@@ -131,10 +131,13 @@ public:
      * Additional members
      */
 
-    valla::IndexedHashSet<valla::Slot<Index>, Index>& get_index_tree_table();
-    const valla::IndexedHashSet<valla::Slot<Index>, Index>& get_index_tree_table() const;
-    valla::IndexedHashSet<double, Index>& get_double_leaf_table();
-    const valla::IndexedHashSet<double, Index>& get_double_leaf_table() const;
+    /// @brief Make insertions into the tree tables thread-safe. Must not be called while states are created concurrently.
+    void enable_concurrent_tree_tables();
+
+    valla::ConcurrentIndexedHashSet<valla::Slot<Index>, Index>& get_index_tree_table();
+    const valla::ConcurrentIndexedHashSet<valla::Slot<Index>, Index>& get_index_tree_table() const;
+    valla::ConcurrentIndexedHashSet<double, Index>& get_double_leaf_table();
+    const valla::ConcurrentIndexedHashSet<double, Index>& get_double_leaf_table() const;
 
     std::pair<const FlatIndexList*, Index> get_or_create_index_list(const FlatIndexList& list);
     const FlatIndexList* get_index_list(size_t pos) const;
@@ -37,6 +37,12 @@ extern void filter_ground_atoms(const GroundLiteralList<P>& literals, bool polar
 template<IsStaticOrFluentOrDerivedTag P>
 extern GroundAtomList<P> filter_ground_atoms(const GroundLiteralList<P>& literals, bool polarity);
 
+/// @brief Bind the parameters of the literal such that its atom is the given ground atom.
+/// @param ref_partial_binding has one entry per parameter and receives the object index of each bound parameter or `MAX_INDEX`.
+/// @return false iff no binding maps the atom of the literal to the ground atom.
+template<IsFluentOrDerivedTag P>
+extern bool unify(Literal<P> literal, GroundAtom<P> ground_atom, IndexList& ref_partial_binding);
+
 }
 
 #endif
@@ -94,6 +94,7 @@
  * DataSet
  */
 
+#include "mimir/datasets/archive.hpp"
 #include "mimir/datasets/generalized_state_space.hpp"
 #include "mimir/datasets/generalized_state_space/class_graph.hpp"
 #include "mimir/datasets/generalized_state_space/options.hpp"
@@ -32,6 +32,7 @@
 #include "mimir/search/algorithms/gbfs_eager/event_handlers.hpp"
 #include "mimir/search/algorithms/gbfs_lazy.hpp"
 #include "mimir/search/algorithms/gbfs_lazy/event_handlers.hpp"
+#include "mimir/search/algorithms/hda.hpp"
 #include "mimir/search/algorithms/iw.hpp"
 #include "mimir/search/algorithms/iw/event_handlers.hpp"
 #include "mimir/search/algorithms/siw.hpp"
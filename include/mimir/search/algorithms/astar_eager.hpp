@@ -20,6 +20,7 @@
 
 #include "mimir/common/types_cista.hpp"
 #include "mimir/formalism/declarations.hpp"
+#include "mimir/search/algorithms/external_memory.hpp"
 #include "mimir/search/algorithms/utils.hpp"
 #include "mimir/search/declarations.hpp"
 #include "mimir/search/state.hpp"
@@ -38,6 +39,8 @@ struct Options
     PruningStrategy pruning_strategy = nullptr;
     uint32_t max_num_states = std::numeric_limits<uint32_t>::max();
     uint32_t max_time_in_ms = std::numeric_limits<uint32_t>::max();
+    uint32_t unpacked_state_cache_size = 1024;  ///< The number of recently generated states kept unpacked for expansion.
+    std::optional<ExternalMemoryOptions> external_memory = std::nullopt;  ///< Enables the external memory mode if set.
 
     Options() = default;
 };
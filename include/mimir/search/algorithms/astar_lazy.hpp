@@ -39,6 +39,7 @@ struct Options
     PruningStrategy pruning_strategy = nullptr;
     uint32_t max_num_states = std::numeric_limits<uint32_t>::max();
     uint32_t max_time_in_ms = std::numeric_limits<uint32_t>::max();
+    uint32_t unpacked_state_cache_size = 1024;  ///< The number of recently generated states kept unpacked for expansion.
     std::array<size_t, 2> openlist_weights = { 1, 1 };
 
     Options() = default;
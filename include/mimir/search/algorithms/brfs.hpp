@@ -19,6 +19,7 @@
 #define MIMIR_SEARCH_ALGORITHMS_BRFS_HPP_
 
 #include "mimir/formalism/declarations.hpp"
+#include "mimir/search/algorithms/external_memory.hpp"
 #include "mimir/search/algorithms/utils.hpp"
 #include "mimir/search/declarations.hpp"
 #include "mimir/search/state.hpp"
@@ -38,6 +39,7 @@ struct Options
     bool stop_if_goal = true;
     uint32_t max_num_states = std::numeric_limits<uint32_t>::max();
     uint32_t max_time_in_ms = std::numeric_limits<uint32_t>::max();
+    std::optional<ExternalMemoryOptions> external_memory = std::nullopt;  ///< Enables the external memory mode if set.
 
     Options() = default;
 };
@@ -0,0 +1,51 @@
+/*
+ * Copyright (C) 2023 Dominik Drexler and Simon Stahlberg
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef MIMIR_SEARCH_ALGORITHMS_EXTERNAL_MEMORY_HPP_
+#define MIMIR_SEARCH_ALGORITHMS_EXTERNAL_MEMORY_HPP_
+
+#include "mimir/common/filesystem.hpp"
+
+#include <cstddef>
+
+namespace mimir::search
+{
+
+/// @brief `ExternalMemoryOptions` enable the external memory mode of BrFS and AStar.
+///
+/// In external memory mode, states are stored on disk in buckets of equal g- and h-value
+/// and duplicates are detected in a delayed fashion by merging sorted files.
+/// Generated states are buffered in memory up to the memory limit and then spilled to disk as sorted runs.
+/// All file accesses, except for the extraction of the plan, are large sequential reads and writes.
+///
+/// The mode does not support pruning strategies other than duplicate pruning.
+/// AStar expands buckets in order of increasing f-value and then g-value and never reopens states,
+/// which yields optimal plans for consistent heuristics.
+/// The tree tables that the problem uses to compress states still grow with the number of generated states.
+struct ExternalMemoryOptions
+{
+    /// @brief The directory in which a temporary working directory is created and removed after the search.
+    fs::path directory = fs::temp_directory_path();
+    /// @brief The memory budget for buffered states, search states, and I/O buffers.
+    size_t memory_limit_in_bytes = size_t(1) << 30;
+
+    ExternalMemoryOptions() = default;
+};
+
+}
+
+#endif
@@ -38,12 +38,29 @@ struct Options
     PruningStrategy pruning_strategy = nullptr;
     uint32_t max_num_states = std::numeric_limits<uint32_t>::max();
     uint32_t max_time_in_ms = std::numeric_limits<uint32_t>::max();
+    uint32_t unpacked_state_cache_size = 1024;  ///< The number of recently generated states kept unpacked for expansion.
+    bool use_preferred_actions = false;  ///< Whether to add a queue per heuristic for the successor states reached by a preferred action.
+    uint32_t preferred_actions_boost = 1000;  ///< The priority boost of the preferred queues whenever a heuristic reaches a new best value.
 
     Options() = default;
 };
 
 extern SearchResult find_solution(const SearchContext& context, const Heuristic& heuristic, const Options& options = Options());
 
+/// @brief Find a solution with greedy best-first search that alternates between a queue for each heuristic (Röger and Helmert, 2010).
+///
+/// A state is a dead end if some heuristic reports it as one. If preferred actions are used, each heuristic has a second queue
+/// with the successor states that are reached by an action that some heuristic prefers in the expanded state, and these queues
+/// are boosted whenever some heuristic reaches a new best value (Richter and Helmert, 2009). The preferred actions are obtained
+/// by evaluating the expanded state again. Decorating the heuristics with a `CachingHeuristicImpl` turns this evaluation into a
+/// cache hit, because the batch evaluation of the successor states caches their preferred actions.
+/// The event handler reports the values of the first heuristic.
+/// @param context is the search context.
+/// @param heuristics are the heuristics, where at least one is required.
+/// @param options are the options.
+/// @return the search result.
+extern SearchResult find_solution(const SearchContext& context, const HeuristicList& heuristics, const Options& options = Options());
+
 }
 
 #endif
@@ -40,7 +40,9 @@ struct Options
     ExplorationStategy exploration_strategy = nullptr;
     uint32_t max_num_states = std::numeric_limits<uint32_t>::max();
     uint32_t max_time_in_ms = std::numeric_limits<uint32_t>::max();
+    uint32_t unpacked_state_cache_size = 1024;  ///< The number of recently generated states kept unpacked for expansion.
     std::array<size_t, 6> openlist_weights = { 1, 1, 1, 1, 64, 1 };
+    size_t batch_size = 1;  ///< The number of open states evaluated in a single batch. Batches of more than one state have no preferred actions.
 
     Options() = default;
 };
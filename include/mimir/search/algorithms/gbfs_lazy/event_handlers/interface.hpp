@@ -53,6 +53,9 @@ public:
     /// @brief React on pruning a state.
     virtual void on_prune_state(const State& state) = 0;
 
+    /// @brief React on retrieving a popped state where `hit` is true if it was taken from the unpacked state cache.
+    virtual void on_lookup_unpacked_state(bool hit) = 0;
+
     /// @brief React on starting a search.
     virtual void on_start_search(const State& start_state, ContinuousCost g_value, ContinuousCost h_value) = 0;
 
@@ -141,6 +144,18 @@ public:
         }
     }
 
+    void on_lookup_unpacked_state(bool hit) override
+    {
+        if (hit)
+        {
+            m_statistics.increment_num_unpacked_state_cache_hits();
+        }
+        else
+        {
+            m_statistics.increment_num_unpacked_state_cache_misses();
+        }
+    }
+
     void on_start_search(const State& start_state, ContinuousCost g_value, ContinuousCost h_value) override
     {
         m_statistics = Statistics();
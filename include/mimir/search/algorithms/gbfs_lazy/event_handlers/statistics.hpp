@@ -36,6 +36,8 @@ private:
     uint64_t m_num_expanded;
     uint64_t m_num_deadends;
     uint64_t m_num_pruned;
+    uint64_t m_num_unpacked_state_cache_hits;
+    uint64_t m_num_unpacked_state_cache_misses;
     std::chrono::time_point<std::chrono::high_resolution_clock> m_search_start_time_point;
     std::chrono::time_point<std::chrono::high_resolution_clock> m_search_end_time_point;
 
@@ -53,6 +55,8 @@ public:
         m_num_expanded(0),
         m_num_deadends(0),
         m_num_pruned(0),
+        m_num_unpacked_state_cache_hits(0),
+        m_num_unpacked_state_cache_misses(0),
         m_num_reached_fluent_atoms(0),
         m_num_reached_derived_atoms(0),
         m_num_states(0),
@@ -70,6 +74,8 @@ public:
     void increment_num_expanded() { ++m_num_expanded; }
     void increment_num_deadends() { ++m_num_deadends; }
     void increment_num_pruned() { ++m_num_pruned; }
+    void increment_num_unpacked_state_cache_hits() { ++m_num_unpacked_state_cache_hits; }
+    void increment_num_unpacked_state_cache_misses() { ++m_num_unpacked_state_cache_misses; }
     void set_search_start_time_point(std::chrono::time_point<std::chrono::high_resolution_clock> time_point) { m_search_start_time_point = time_point; }
     void set_search_end_time_point(std::chrono::time_point<std::chrono::high_resolution_clock> time_point) { m_search_end_time_point = time_point; }
 
@@ -89,6 +95,15 @@ public:
     uint64_t get_num_expanded() const { return m_num_expanded; }
     uint64_t get_num_deadends() const { return m_num_deadends; }
     uint64_t get_num_pruned() const { return m_num_pruned; }
+    uint64_t get_num_unpacked_state_cache_hits() const { return m_num_unpacked_state_cache_hits; }
+    uint64_t get_num_unpacked_state_cache_misses() const { return m_num_unpacked_state_cache_misses; }
+
+    /// @brief Return the fraction of expanded states that were taken from the unpacked state cache.
+    double get_unpacked_state_cache_hit_rate() const
+    {
+        const auto num_lookups = m_num_unpacked_state_cache_hits + m_num_unpacked_state_cache_misses;
+        return (num_lookups == 0) ? 0. : static_cast<double>(m_num_unpacked_state_cache_hits) / num_lookups;
+    }
 
     std::chrono::milliseconds get_search_time_ms() const
     {
@@ -126,7 +141,9 @@ inline std::ostream& operator<<(std::ostream& os, const Statistics& statistics)
        << "[GBFS] Number of reached fluent atoms: " << statistics.get_num_reached_fluent_atoms() << "\n"
        << "[GBFS] Number of reached derived atoms: " << statistics.get_num_reached_derived_atoms() << "\n"
        << "[GBFS] Number of states: " << statistics.get_num_states() << "\n"
-       << "[GBFS] Number of nodes: " << statistics.get_num_nodes();
+       << "[GBFS] Number of nodes: " << statistics.get_num_nodes() << "\n"
+       << "[GBFS] Unpacked state cache hit rate: " << statistics.get_unpacked_state_cache_hit_rate() << " ("
+       << statistics.get_num_unpacked_state_cache_hits() << " hits, " << statistics.get_num_unpacked_state_cache_misses() << " misses)";
 
     return os;
 }
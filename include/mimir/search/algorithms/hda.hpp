@@ -0,0 +1,89 @@
+/*
+ * Copyright (C) 2023 Dominik Drexler and Simon Stahlberg
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef MIMIR_SEARCH_ALGORITHMS_HDA_HPP_
+#define MIMIR_SEARCH_ALGORITHMS_HDA_HPP_
+
+#include "mimir/common/types_cista.hpp"
+#include "mimir/formalism/declarations.hpp"
+#include "mimir/search/algorithms/utils.hpp"
+#include "mimir/search/declarations.hpp"
+#include "mimir/search/state.hpp"
+
+#include <cstdint>
+#include <limits>
+
+/// @brief Hash distributed search (HDA*, Kishimoto, Fukunaga, and Botea, ICAPS 2009).
+///
+/// Each worker thread owns the states whose packed representation hashes to it.
+/// A worker has its own open list, search nodes, state repository, applicable action generator, and heuristic.
+/// Successors owned by another worker are sent to the owner's inbox, which performs duplicate detection and heuristic evaluation.
+/// The search terminates when all workers are idle and no message is in flight.
+namespace mimir::search::hda
+{
+struct Options
+{
+    uint32_t max_num_states = std::numeric_limits<uint32_t>::max();
+    uint32_t max_time_in_ms = std::numeric_limits<uint32_t>::max();
+
+    Options() = default;
+};
+
+struct Statistics
+{
+    uint64_t num_expanded = 0;
+    uint64_t num_generated = 0;
+    uint64_t num_sent = 0;       ///< Number of successors sent to another worker.
+    uint64_t num_received = 0;  ///< Number of successors received from another worker.
+    uint64_t num_reopened = 0;
+};
+
+using StatisticsList = std::vector<Statistics>;
+
+/// @brief Find an optimal solution with hash distributed A* with reopening.
+///
+/// The number of workers equals the number of search contexts. All contexts and heuristics must be defined over the same problem,
+/// and the i-th heuristic is only evaluated by the i-th worker. Only the generation of applicable actions, which may ground actions
+/// in the problem, is serialized; with axioms, successor construction is serialized as well because axiom evaluation may ground atoms.
+/// Optimality is preserved for admissible heuristics: the search stops only when no worker holds a node with f-value smaller
+/// than the incumbent solution cost and no message is in flight.
+/// @param contexts are the search contexts, one per worker.
+/// @param heuristics are the heuristics, one per worker.
+/// @param options are the search options.
+/// @param out_statistics are optional per-worker statistics.
+/// @return the search result, where the plan refers to the first search context.
+extern SearchResult find_solution_astar(const SearchContextList& contexts,
+                                        const HeuristicList& heuristics,
+                                        const Options& options = Options(),
+                                        StatisticsList* out_statistics = nullptr);
+
+/// @brief Find a solution with hash distributed eager greedy best-first search.
+///
+/// The search stops as soon as any worker generates a goal state.
+/// @param contexts are the search contexts, one per worker.
+/// @param heuristics are the heuristics, one per worker.
+/// @param options are the search options.
+/// @param out_statistics are optional per-worker statistics.
+/// @return the search result, where the plan refers to the first search context.
+extern SearchResult find_solution_gbfs(const SearchContextList& contexts,
+                                       const HeuristicList& heuristics,
+                                       const Options& options = Options(),
+                                       StatisticsList* out_statistics = nullptr);
+
+}
+
+#endif
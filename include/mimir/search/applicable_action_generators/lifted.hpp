@@ -74,8 +74,6 @@ private:
     ActionSatisficingBindingGeneratorList m_action_grounding_data;
 
     /* Memory for reuse */
-    formalism::GroundAtomList<formalism::FluentTag> m_fluent_atoms;
-    formalism::GroundAtomList<formalism::DerivedTag> m_derived_atoms;
     formalism::GroundFunctionList<formalism::FluentTag> m_fluent_functions;
     formalism::AssignmentSet<formalism::FluentTag> m_fluent_assignment_set;
     formalism::AssignmentSet<formalism::DerivedTag> m_derived_assignment_set;
@@ -24,6 +24,8 @@
 #include "mimir/search/match_tree/declarations.hpp"
 #include "mimir/search/match_tree/match_tree.hpp"
 
+#include <unordered_map>
+
 namespace mimir::search
 {
 
@@ -59,6 +61,11 @@ public:
 
     void generate_and_apply_axioms(UnpackedStateImpl& unpacked_state) override;
 
+    void update_and_apply_axioms(const UnpackedStateImpl& parent_unpacked_state,
+                                 const IndexList& added_fluent_atoms,
+                                 const IndexList& deleted_fluent_atoms,
+                                 UnpackedStateImpl& unpacked_state) override;
+
     void on_finish_search_layer() override;
     void on_end_search() override;
 
@@ -70,9 +77,40 @@ public:
     const EventHandler& get_event_handler() const;
 
 private:
+    using AtomToGroundAxioms = std::unordered_map<Index, formalism::GroundAxiomList>;
+
+    /// @brief The ground axioms of a partition indexed by the atoms of their body literals and of their heads.
+    struct Occurrences
+    {
+        AtomToGroundAxioms positive_fluent;
+        AtomToGroundAxioms negative_fluent;
+        AtomToGroundAxioms positive_derived;
+        AtomToGroundAxioms negative_derived;
+        AtomToGroundAxioms head;
+    };
+
+    /// @brief Delete the head atoms of the ground axioms of the atom that are applicable in the parent state from the successor state.
+    void overdelete_atoms(const AtomToGroundAxioms& atom_to_axioms,
+                          Index atom_index,
+                          const UnpackedStateImpl& parent_unpacked_state,
+                          UnpackedStateImpl& unpacked_state);
+
+    /// @brief Insert the head atoms of the ground axioms of the atom that are applicable in the successor state.
+    void insert_atoms(const AtomToGroundAxioms& atom_to_axioms, Index atom_index, UnpackedStateImpl& unpacked_state);
+
     formalism::Problem m_problem;
     match_tree::MatchTreeList<formalism::GroundAxiomImpl> m_match_tree_partitioning;
     EventHandler m_event_handler;
+
+    /* Incremental evaluation */
+    std::vector<Occurrences> m_occurrences;  ///< The occurrences of each partition.
+    bool m_has_numeric_constraints;
+
+    /* Memory for reuse */
+    IndexList m_overdeleted_atoms;
+    IndexList m_inserted_atoms;
+    IndexList m_added_derived_atoms;
+    IndexList m_deleted_derived_atoms;
 };
 
 }
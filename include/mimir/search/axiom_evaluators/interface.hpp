@@ -18,6 +18,7 @@
 #ifndef MIMIR_SEARCH_AXIOM_EVALUATORS_INTERFACE_HPP_
 #define MIMIR_SEARCH_AXIOM_EVALUATORS_INTERFACE_HPP_
 
+#include "mimir/common/types.hpp"
 #include "mimir/common/types_cista.hpp"
 #include "mimir/formalism/declarations.hpp"
 #include "mimir/search/declarations.hpp"
@@ -36,6 +37,20 @@ public:
     /// @brief Generate all applicable axioms for a given set of ground atoms by running fixed point computation.
     virtual void generate_and_apply_axioms(UnpackedStateImpl& unpacked_state) = 0;
 
+    /// @brief Update the derived atoms of the parent state to the fixed point of the successor state with delete-rederive (DRed) view maintenance.
+    ///
+    /// In each partition, the atoms of the parent that have a derivation in the parent that depends on a changed atom are deleted,
+    /// the deleted atoms that still have a derivation are rederived, and the atoms with a new derivation are inserted.
+    /// Partitions whose axiom bodies are not affected by the changed atoms keep the atoms of the parent.
+    /// @param parent_unpacked_state is the parent state with its derived atoms.
+    /// @param added_fluent_atoms are the fluent atoms of the successor state that are not true in the parent state.
+    /// @param deleted_fluent_atoms are the fluent atoms of the parent state that are not true in the successor state.
+    /// @param unpacked_state is the successor state, whose derived atoms are overwritten.
+    virtual void update_and_apply_axioms(const UnpackedStateImpl& parent_unpacked_state,
+                                         const IndexList& added_fluent_atoms,
+                                         const IndexList& deleted_fluent_atoms,
+                                         UnpackedStateImpl& unpacked_state) = 0;
+
     /// @brief Accumulate event handler statistics during search.
     virtual void on_finish_search_layer() = 0;
     virtual void on_end_search() = 0;
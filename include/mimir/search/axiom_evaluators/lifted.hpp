@@ -24,9 +24,19 @@
 #include "mimir/search/declarations.hpp"
 #include "mimir/search/satisficing_binding_generators/axiom.hpp"
 
+#include <unordered_map>
+
 namespace mimir::search
 {
 
+/// @brief `LiftedAxiomEvaluatorImpl` evaluates the axioms of each partition with semi-naive (delta-driven) Datalog evaluation.
+///
+/// The first round enumerates the bindings of the axioms without derived body literals of the partition.
+/// Every later round only enumerates the bindings in which a positive derived body literal is satisfied by an atom derived in the previous round.
+/// The atoms of derived predicates whose axioms only depend on static atoms are derived in the first evaluation and reused afterwards.
+///
+/// The update of the derived atoms of a parent state enumerates the bindings of the axioms whose body literal is bound to a changed atom,
+/// in the parent state to delete the atoms whose derivation is lost and in the successor state to rederive and insert atoms.
 class LiftedAxiomEvaluatorImpl : public IAxiomEvaluator
 {
 public:
@@ -54,6 +64,11 @@ public:
 
     void generate_and_apply_axioms(UnpackedStateImpl& unpacked_state) override;
 
+    void update_and_apply_axioms(const UnpackedStateImpl& parent_unpacked_state,
+                                 const IndexList& added_fluent_atoms,
+                                 const IndexList& deleted_fluent_atoms,
+                                 UnpackedStateImpl& unpacked_state) override;
+
     void on_finish_search_layer() override;
     void on_end_search() override;
 
@@ -65,18 +80,88 @@ public:
     const EventHandler& get_event_handler() const;
 
 private:
+    /// @brief A literal in the body of an axiom.
+    template<formalism::IsFluentOrDerivedTag P>
+    struct Occurrence
+    {
+        formalism::Axiom axiom;
+        formalism::Literal<P> literal;
+    };
+    template<formalism::IsFluentOrDerivedTag P>
+    using OccurrenceMap = std::unordered_map<formalism::Predicate<P>, std::vector<Occurrence<P>>>;
+
+    /// @brief A positive derived literal in the body of an axiom through which new atoms of its predicate can trigger the axiom.
+    using Trigger = Occurrence<formalism::DerivedTag>;
+    using TriggerMap = OccurrenceMap<formalism::DerivedTag>;
+
+    /// @brief The literals in the bodies of the non-static axioms of a partition, and the non-static axioms by head predicate.
+    struct Occurrences
+    {
+        OccurrenceMap<formalism::FluentTag> fluent;
+        OccurrenceMap<formalism::DerivedTag> derived;
+        std::unordered_map<formalism::Predicate<formalism::DerivedTag>, formalism::AxiomList> head;
+    };
+
+    /// @brief Return true iff the axiom only depends on static atoms and its atoms were derived in the first evaluation.
+    bool is_compiled_away(formalism::Axiom axiom) const;
+
+    /// @brief Ground the axiom with the binding and collect the ground axiom unless it was collected in the current round.
+    void collect_applicable_axiom(formalism::Axiom axiom, formalism::ObjectList binding);
+
+    /// @brief Apply the collected ground axioms and append their new atoms to `m_delta_atoms`.
+    void apply_applicable_axioms(size_t partition_index, UnpackedStateImpl& unpacked_state);
+
+    /// @brief Apply the axioms of the partition that are triggered by the atoms in `m_delta_atoms` until a fixed point is reached.
+    void apply_triggered_axioms(size_t partition_index, UnpackedStateImpl& unpacked_state);
+
+    /// @brief Delete the head atoms of the bindings in the parent state in which a literal with the polarity is bound to the atom from the successor state.
+    template<formalism::IsFluentOrDerivedTag P>
+    void overdelete_atoms(const OccurrenceMap<P>& occurrences,
+                          formalism::GroundAtom<P> ground_atom,
+                          bool polarity,
+                          const UnpackedStateImpl& parent_unpacked_state,
+                          UnpackedStateImpl& unpacked_state);
+
+    /// @brief Collect the ground axioms of the bindings in the successor state in which a literal with the polarity is bound to the atom.
+    template<formalism::IsFluentOrDerivedTag P>
+    void collect_inserted_axioms(const OccurrenceMap<P>& occurrences, formalism::GroundAtom<P> ground_atom, bool polarity, UnpackedStateImpl& unpacked_state);
+
+    /// @brief Collect a ground axiom that derives the atom in the successor state, if any.
+    void collect_rederiving_axiom(const Occurrences& occurrences, formalism::GroundAtom<formalism::DerivedTag> ground_atom, UnpackedStateImpl& unpacked_state);
+
     formalism::Problem m_problem;
     EventHandler m_event_handler;
 
     AxiomSatisficingBindingGeneratorList m_condition_grounders;
 
+    /* Semi-naive evaluation */
+    std::vector<TriggerMap> m_triggers;  ///< The triggers of the axioms of each partition.
+    std::vector<bool> m_is_static_axiom;
+    bool m_has_static_atoms;
+    std::vector<formalism::GroundAtomList<formalism::DerivedTag>> m_static_atoms;  ///< The atoms derived by static axioms in each partition.
+
+    /* Incremental evaluation */
+    std::vector<Occurrences> m_occurrences;  ///< The occurrences of each partition.
+    formalism::PredicateSet<formalism::FluentTag> m_body_fluent_predicates;
+    bool m_has_numeric_constraints;
+
     /* Memory for reuse */
-    formalism::GroundAtomList<formalism::FluentTag> m_fluent_atoms;
-    formalism::GroundAtomList<formalism::DerivedTag> m_derived_atoms;
     formalism::GroundFunctionList<formalism::FluentTag> m_fluent_functions;
     formalism::AssignmentSet<formalism::FluentTag> m_fluent_assignment_set;
     formalism::AssignmentSet<formalism::DerivedTag> m_derived_assignment_set;
     formalism::NumericAssignmentSet<formalism::FluentTag> m_numeric_assignment_set;
+    formalism::GroundAxiomList m_applicable_axioms;
+    formalism::GroundAxiomSet m_applicable_axiom_set;
+    formalism::GroundAtomList<formalism::DerivedTag> m_delta_atoms;  ///< The atoms derived in the current partition.
+    IndexList m_partial_binding;
+    formalism::AssignmentSet<formalism::FluentTag> m_parent_fluent_assignment_set;
+    formalism::AssignmentSet<formalism::DerivedTag> m_parent_derived_assignment_set;
+    bool m_has_parent_assignment_sets;
+    formalism::GroundAtomList<formalism::FluentTag> m_added_fluent_atoms;
+    formalism::GroundAtomList<formalism::FluentTag> m_deleted_fluent_atoms;
+    formalism::GroundAtomList<formalism::DerivedTag> m_added_derived_atoms;
+    formalism::GroundAtomList<formalism::DerivedTag> m_deleted_derived_atoms;
+    formalism::GroundAtomList<formalism::DerivedTag> m_overdeleted_atoms;
 };
 
 }  // namespace mimir
@@ -132,6 +132,7 @@ using DefaultEventHandler = std::shared_ptr<DefaultEventHandlerImpl>;
 /* Heuristics */
 class IHeuristic;
 using Heuristic = std::shared_ptr<IHeuristic>;
+using HeuristicList = std::vector<Heuristic>;
 class PerfectHeuristicImpl;
 using PerfectHeuristic = std::shared_ptr<PerfectHeuristicImpl>;
 class BlindHeuristicImpl;
@@ -144,6 +145,20 @@ class SetAddHeuristicImpl;
 using SetAddHeuristic = std::shared_ptr<SetAddHeuristicImpl>;
 class FFHeuristicImpl;
 using FFHeuristic = std::shared_ptr<FFHeuristicImpl>;
+class LMCutHeuristicImpl;
+using LMCutHeuristic = std::shared_ptr<LMCutHeuristicImpl>;
+class PDBHeuristicImpl;
+using PDBHeuristic = std::shared_ptr<PDBHeuristicImpl>;
+class CanonicalPDBsHeuristicImpl;
+using CanonicalPDBsHeuristic = std::shared_ptr<CanonicalPDBsHeuristicImpl>;
+class LiftedMaxHeuristicImpl;
+using LiftedMaxHeuristic = std::shared_ptr<LiftedMaxHeuristicImpl>;
+class LiftedAddHeuristicImpl;
+using LiftedAddHeuristic = std::shared_ptr<LiftedAddHeuristicImpl>;
+class LiftedFFHeuristicImpl;
+using LiftedFFHeuristic = std::shared_ptr<LiftedFFHeuristicImpl>;
+class CachingHeuristicImpl;
+using CachingHeuristic = std::shared_ptr<CachingHeuristicImpl>;
 
 /* Algorithms */
 class IPruningStrategy;
@@ -20,8 +20,15 @@
 
 #include "mimir/search/heuristics/add.hpp"
 #include "mimir/search/heuristics/blind.hpp"
+#include "mimir/search/heuristics/caching.hpp"
+#include "mimir/search/heuristics/canonical_pdbs.hpp"
 #include "mimir/search/heuristics/ff.hpp"
+#include "mimir/search/heuristics/lifted_add.hpp"
+#include "mimir/search/heuristics/lifted_ff.hpp"
+#include "mimir/search/heuristics/lifted_max.hpp"
+#include "mimir/search/heuristics/lm_cut.hpp"
 #include "mimir/search/heuristics/max.hpp"
+#include "mimir/search/heuristics/pdb.hpp"
 #include "mimir/search/heuristics/perfect.hpp"
 #include "mimir/search/heuristics/set_add.hpp"
 
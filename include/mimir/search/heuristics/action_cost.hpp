@@ -0,0 +1,39 @@
+/*
+ * Copyright (C) 2023 Dominik Drexler and Simon Stahlberg
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef MIMIR_SEARCH_HEURISTICS_ACTION_COST_HPP_
+#define MIMIR_SEARCH_HEURISTICS_ACTION_COST_HPP_
+
+#include "mimir/common/types.hpp"
+#include "mimir/formalism/declarations.hpp"
+
+namespace mimir::search
+{
+
+/// @brief Compute the cost of the ground action as a non-negative integer for heuristics that require constant action costs.
+///
+/// The cost is the increase of the total cost by the unconditional effects of the action, evaluated in the initial state,
+/// or 1 if the problem has no metric. Costs of conditional effects are ignored, which underestimates the true cost.
+/// Throws an exception if the metric is over fluent functions or if the cost is not a non-negative integer.
+/// @param action is the ground action.
+/// @param problem is the problem.
+/// @return the cost of the ground action.
+extern DiscreteCost compute_discrete_action_cost(formalism::GroundAction action, const formalism::ProblemImpl& problem);
+
+}
+
+#endif
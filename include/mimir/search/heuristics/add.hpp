@@ -26,9 +26,10 @@ namespace mimir::search
 class AddHeuristicImpl : public rpg::RelaxedPlanningGraph<AddHeuristicImpl>
 {
 public:
-    explicit AddHeuristicImpl(const DeleteRelaxedProblemExplorator& delete_relaxation);
+    /// @param enable_incremental_evaluation repairs the annotations of the previously evaluated state instead of recomputing them.
+    explicit AddHeuristicImpl(const DeleteRelaxedProblemExplorator& delete_relaxation, bool enable_incremental_evaluation = false);
 
-    static AddHeuristic create(const DeleteRelaxedProblemExplorator& delete_relaxation);
+    static AddHeuristic create(const DeleteRelaxedProblemExplorator& delete_relaxation, bool enable_incremental_evaluation = false);
 
 private:
     /// @brief Initialize "And"-structure node annotations.
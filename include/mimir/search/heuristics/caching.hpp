@@ -0,0 +1,152 @@
+/*
+ * Copyright (C) 2023 Dominik Drexler and Simon Stahlberg
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef MIMIR_SEARCH_HEURISTICS_CACHING_HPP_
+#define MIMIR_SEARCH_HEURISTICS_CACHING_HPP_
+
+#include "mimir/formalism/declarations.hpp"
+#include "mimir/search/declarations.hpp"
+#include "mimir/search/heuristics/interface.hpp"
+
+#include <list>
+#include <memory>
+#include <ostream>
+#include <unordered_map>
+#include <vector>
+
+namespace mimir::search
+{
+
+/// @brief `CachingHeuristicImpl` decorates a heuristic with a cache of its values and preferred actions keyed by the state index.
+///
+/// The cache pays off if the same state is evaluated repeatedly, e.g., by lazy searches, by restarts, or by repeated searches
+/// on the same search context, and if the heuristic is expensive, e.g., a heuristic implemented in Python.
+/// The cache holds the entries of the states of a single state repository and is cleared when a state of another repository is evaluated.
+/// If the cache is full, the least recently used entries are evicted. The cache is not thread-safe.
+///
+/// The memory of an entry grows with its preferred actions, so the cache bounds both the number of entries and
+/// the total number of preferred actions over all entries. A state with more preferred actions than the total bound
+/// is cached without them, and hence its preferred actions are recomputed on every request.
+class CachingHeuristicImpl : public IHeuristic
+{
+public:
+    struct Options
+    {
+        size_t max_num_entries;            ///< The limit on the number of cached states, where each entry stores a value and the preferred actions.
+        size_t max_num_preferred_actions;  ///< The limit on the total number of preferred actions stored in the entries.
+
+        Options() : max_num_entries(1'000'000), max_num_preferred_actions(10'000'000) {}
+    };
+
+    struct Statistics
+    {
+        size_t num_hits = 0;
+        size_t num_misses = 0;
+        size_t num_evictions = 0;      ///< Entries that were evicted because the cache was full or held too many preferred actions.
+        size_t num_invalidations = 0;  ///< Clears of the cache because a state of another state repository was evaluated.
+
+        double get_hit_rate() const { return (num_hits + num_misses > 0) ? static_cast<double>(num_hits) / (num_hits + num_misses) : 0.; }
+    };
+
+    CachingHeuristicImpl(Heuristic heuristic, const Options& options = Options());
+
+    static CachingHeuristic create(Heuristic heuristic, const Options& options = Options());
+
+    ContinuousCost compute_heuristic(const State& state, bool is_goal_state) override;
+
+    /// @brief Compute the heuristic values of the cached states from the cache and forward the other states in a single batch.
+    /// Entries created by this batch evaluation have no preferred actions and do not count as hits of
+    /// `compute_heuristic` and `compute_heuristics_and_preferred_actions`, which recompute them.
+    void compute_heuristics(const StateList& states, const std::vector<bool>& are_goal_states, ContinuousCostList& out_values) override;
+
+    /// @brief Compute the heuristic values and preferred actions of the cached states from the cache and forward the other states in a single batch.
+    void compute_heuristics_and_preferred_actions(const StateList& states,
+                                                  const std::vector<bool>& are_goal_states,
+                                                  ContinuousCostList& out_values,
+                                                  std::vector<formalism::GroundActionSet>& out_preferred_actions) override;
+
+    /// @brief Remove all entries from the cache.
+    void clear();
+
+    /**
+     * Getters
+     */
+
+    const Heuristic& get_heuristic() const;
+    const Options& get_options() const;
+    const Statistics& get_statistics() const;
+    size_t get_num_entries() const;
+    size_t get_num_preferred_actions() const;
+
+private:
+    struct Entry
+    {
+        Index state_index;
+        bool is_goal_state;
+        ContinuousCost value;
+        formalism::GroundActionSet preferred_actions;
+        bool has_preferred_actions;
+    };
+
+    using EntryList = std::list<Entry>;
+
+    /// @brief Clear the cache if the state belongs to another state repository than the cached states.
+    void update_state_repository(const State& state);
+
+    /// @brief Look up the states in the cache and collect the missing states, where entries without preferred actions miss if they are required.
+    void lookup_entries(const StateList& states,
+                        const std::vector<bool>& are_goal_states,
+                        ContinuousCostList& out_values,
+                        std::vector<formalism::GroundActionSet>* out_preferred_actions);
+
+    /// @brief Insert or overwrite the entry of a state as the most recently used entry,
+    /// and evict the least recently used entries while the preferred actions exceed their limit.
+    void insert_entry(Index state_index, bool is_goal_state, ContinuousCost value, const formalism::GroundActionSet* preferred_actions);
+
+    Heuristic m_heuristic;
+    Options m_options;
+
+    std::weak_ptr<StateRepositoryImpl> m_state_repository;  ///< The repository of the cached states, which is not kept alive by the cache.
+    EntryList m_entries;                                     ///< The entries from the most to the least recently used.
+    std::unordered_map<Index, EntryList::iterator> m_state_index_to_entry;
+    size_t m_num_preferred_actions;  ///< The total number of preferred actions stored in the entries.
+
+    Statistics m_statistics;
+
+    /* Memory for reuse */
+    StateList m_miss_states;
+    std::vector<bool> m_miss_are_goal_states;
+    IndexList m_miss_positions;
+    ContinuousCostList m_miss_values;
+    std::vector<formalism::GroundActionSet> m_miss_preferred_actions;
+};
+
+inline std::ostream& operator<<(std::ostream& os, const CachingHeuristicImpl::Statistics& statistics)
+{
+    os << "[CachingHeuristic] Number of hits: " << statistics.num_hits << "\n"
+       << "[CachingHeuristic] Number of misses: " << statistics.num_misses << "\n"
+       << "[CachingHeuristic] Number of evictions: " << statistics.num_evictions << "\n"
+       << "[CachingHeuristic] Number of invalidations: " << statistics.num_invalidations << "\n"
+       << "[CachingHeuristic] Hit rate: " << statistics.get_hit_rate();
+
+    return os;
+}
+
+}
+
+#endif
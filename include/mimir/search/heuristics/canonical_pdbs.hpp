@@ -0,0 +1,75 @@
+/*
+ * Copyright (C) 2023 Dominik Drexler and Simon Stahlberg
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef MIMIR_SEARCH_HEURISTICS_CANONICAL_PDBS_HPP_
+#define MIMIR_SEARCH_HEURISTICS_CANONICAL_PDBS_HPP_
+
+#include "mimir/common/filesystem.hpp"
+#include "mimir/formalism/declarations.hpp"
+#include "mimir/search/declarations.hpp"
+#include "mimir/search/heuristics/interface.hpp"
+#include "mimir/search/heuristics/pdb/declarations.hpp"
+#include "mimir/search/heuristics/pdb/pattern_collection.hpp"
+#include "mimir/search/heuristics/pdb/pattern_generation.hpp"
+
+#include <optional>
+
+namespace mimir::search
+{
+
+/**
+ * CanonicalPDBs
+ */
+
+/// @brief `CanonicalPDBsHeuristicImpl` implements the admissible canonical heuristic of a collection of pattern databases,
+/// i.e., the maximum over all maximal sets of pairwise additive patterns of the sum of their distances, see `pdb::CanonicalPatternCollection`.
+///
+/// If no patterns are given, the collection is computed with the iPDB hill-climbing search, see `pdb::compute_patterns_by_hill_climbing`.
+/// Evaluating a state maps its fluent atoms to variable values once and then looks up the distance in each pattern database.
+class CanonicalPDBsHeuristicImpl : public IHeuristic
+{
+public:
+    struct Options
+    {
+        std::optional<pdb::PatternList> patterns;  ///< The patterns, or std::nullopt to compute them with hill climbing.
+        pdb::HillClimbingOptions hill_climbing_options;
+        std::optional<fs::path> cache_directory;  ///< The directory that the pattern databases are loaded from and written to.
+
+        Options() : patterns(std::nullopt), hill_climbing_options(), cache_directory(std::nullopt) {}
+    };
+
+    CanonicalPDBsHeuristicImpl(const DeleteRelaxedProblemExplorator& delete_relaxation, const Options& options = Options());
+
+    static CanonicalPDBsHeuristic create(const DeleteRelaxedProblemExplorator& delete_relaxation, const Options& options = Options());
+
+    ContinuousCost compute_heuristic(const State& state, bool is_goal_state) override;
+
+    const pdb::Task& get_task() const;
+    const pdb::CanonicalPatternCollection& get_pattern_collection() const;
+
+private:
+    pdb::Task m_task;
+    pdb::CanonicalPatternCollection m_pattern_collection;
+
+    /* Memory for reuse */
+    IndexList m_values;
+    std::vector<DiscreteCost> m_distances;
+};
+
+}
+
+#endif
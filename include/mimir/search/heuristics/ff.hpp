@@ -34,9 +34,10 @@ inline auto& get(FFStructuresAnnotations& annotations)
 class FFHeuristicImpl : public rpg::RelaxedPlanningGraph<FFHeuristicImpl>
 {
 public:
-    explicit FFHeuristicImpl(const DeleteRelaxedProblemExplorator& delete_relaxation);
+    /// @param enable_incremental_evaluation repairs the annotations of the previously evaluated state instead of recomputing them.
+    explicit FFHeuristicImpl(const DeleteRelaxedProblemExplorator& delete_relaxation, bool enable_incremental_evaluation = false);
 
-    static FFHeuristic create(const DeleteRelaxedProblemExplorator& delete_relaxation);
+    static FFHeuristic create(const DeleteRelaxedProblemExplorator& delete_relaxation, bool enable_incremental_evaluation = false);
 
 private:
     /**
@@ -20,6 +20,9 @@
 
 #include "mimir/formalism/declarations.hpp"
 #include "mimir/search/declarations.hpp"
+#include "mimir/search/state.hpp"
+
+#include <vector>
 
 namespace mimir::search
 {
@@ -40,6 +43,25 @@ public:
 
     virtual ContinuousCost compute_heuristic(const State& state, bool is_goal_state) = 0;
 
+    /// @brief Compute the heuristic values of a batch of states, e.g., the new successor states of an expansion.
+    /// The default implementation calls `compute_heuristic` for each state. Heuristics that benefit from batching,
+    /// e.g., neural network heuristics, override it. A batch evaluation does not compute preferred actions.
+    /// @param states are the states.
+    /// @param are_goal_states are the flags whether the states are goal states.
+    /// @param out_values are the heuristic values of the states.
+    virtual void compute_heuristics(const StateList& states, const std::vector<bool>& are_goal_states, ContinuousCostList& out_values);
+
+    /// @brief Compute the heuristic values and the preferred actions of a batch of states.
+    /// The default implementation calls `compute_heuristic` for each state and copies its preferred actions.
+    /// @param states are the states.
+    /// @param are_goal_states are the flags whether the states are goal states.
+    /// @param out_values are the heuristic values of the states.
+    /// @param out_preferred_actions are the preferred actions of the states.
+    virtual void compute_heuristics_and_preferred_actions(const StateList& states,
+                                                          const std::vector<bool>& are_goal_states,
+                                                          ContinuousCostList& out_values,
+                                                          std::vector<formalism::GroundActionSet>& out_preferred_actions);
+
     virtual const PreferredActions& get_preferred_actions() const { return m_preferred_actions; }
 
 protected:
@@ -0,0 +1,54 @@
+/*
+ * Copyright (C) 2023 Dominik Drexler and Simon Stahlberg
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef MIMIR_SEARCH_HEURISTICS_LIFTED_ADD_HPP_
+#define MIMIR_SEARCH_HEURISTICS_LIFTED_ADD_HPP_
+
+#include "mimir/search/heuristics/lifted_rpg_base.hpp"
+
+namespace mimir::search
+{
+
+/**
+ * Lifted HAdd
+ */
+
+class LiftedAddHeuristicImpl : public rpg::LiftedRelaxedPlanningGraph<LiftedAddHeuristicImpl>
+{
+public:
+    explicit LiftedAddHeuristicImpl(formalism::Problem problem);
+
+    static LiftedAddHeuristic create(formalism::Problem problem);
+
+private:
+    /// @brief Accumulate the action cost and the precondition cost.
+    /// @param cost is the cost accumulated so far.
+    /// @param precondition_cost is the cost of the precondition.
+    /// @return the accumulated cost.
+    DiscreteCost accumulate_action_cost_impl(DiscreteCost cost, DiscreteCost precondition_cost) const;
+
+    /// @brief Extract h_add heuristic estimate from the goal atoms.
+    /// @return the h_add heuristic estimate.
+    DiscreteCost extract_impl(const State& state);
+
+    friend class rpg::LiftedRelaxedPlanningGraph<LiftedAddHeuristicImpl>;
+};
+
+}
+
+#endif
@@ -0,0 +1,68 @@
+/*
+ * Copyright (C) 2023 Dominik Drexler and Simon Stahlberg
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef MIMIR_SEARCH_HEURISTICS_LIFTED_FF_HPP_
+#define MIMIR_SEARCH_HEURISTICS_LIFTED_FF_HPP_
+
+#include "mimir/search/heuristics/lifted_rpg_base.hpp"
+
+namespace mimir::search
+{
+
+/**
+ * Lifted FF
+ */
+
+class LiftedFFHeuristicImpl : public rpg::LiftedRelaxedPlanningGraph<LiftedFFHeuristicImpl>
+{
+public:
+    explicit LiftedFFHeuristicImpl(formalism::Problem problem);
+
+    static LiftedFFHeuristic create(formalism::Problem problem);
+
+private:
+    /// @brief Choose the maximal cost among the action cost and the precondition cost, which closely follows the `FFHeuristic`.
+    /// @param cost is the cost accumulated so far.
+    /// @param precondition_cost is the cost of the precondition.
+    /// @return the accumulated cost.
+    DiscreteCost accumulate_action_cost_impl(DiscreteCost cost, DiscreteCost precondition_cost) const;
+
+    template<formalism::IsFluentOrDerivedTag P>
+    void extract_relaxed_plan_and_preferred_operators_recursively(const State& state, formalism::GroundConjunctiveCondition conjunctive_condition);
+    template<formalism::IsFluentOrDerivedTag P>
+    void extract_relaxed_plan_and_preferred_operators_recursively(const State& state, Index atom_index);
+
+    /// @brief Insert the unrelaxed ground actions of the delete-free ground action that are applicable in the state into the preferred actions.
+    void insert_preferred_actions(const State& state, formalism::GroundAction delete_free_action);
+
+    /// @brief Extract the size of the relaxed plan from the best achievers of the goal atoms.
+    /// @return the FF heuristic estimate.
+    DiscreteCost extract_impl(const State& state);
+
+    friend class rpg::LiftedRelaxedPlanningGraph<LiftedFFHeuristicImpl>;
+
+private:
+    FlatBitset m_marked_fluent_atoms;
+    FlatBitset m_marked_derived_atoms;
+
+    formalism::GroundActionSet m_relaxed_plan;  ///< The ground actions of the delete-free problem.
+};
+
+}
+
+#endif
@@ -0,0 +1,215 @@
+/*
+ * Copyright (C) 2023 Dominik Drexler and Simon Stahlberg
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef MIMIR_SEARCH_HEURISTICS_LIFTED_RPG_BASE_HPP_
+#define MIMIR_SEARCH_HEURISTICS_LIFTED_RPG_BASE_HPP_
+
+#include "mimir/common/types.hpp"
+#include "mimir/common/types_cista.hpp"
+#include "mimir/formalism/assignment_set.hpp"
+#include "mimir/formalism/declarations.hpp"
+#include "mimir/formalism/translator/delete_relax.hpp"
+#include "mimir/search/declarations.hpp"
+#include "mimir/search/heuristics/interface.hpp"
+#include "mimir/search/openlists/priority_queue.hpp"
+#include "mimir/search/satisficing_binding_generators/action.hpp"
+#include "mimir/search/satisficing_binding_generators/axiom.hpp"
+#include "mimir/search/state_unpacked.hpp"
+
+#include <unordered_map>
+#include <vector>
+
+namespace mimir::search::rpg
+{
+
+/// @brief `LiftedAchiever` is the best achiever of a fluent atom in the delete-free problem,
+/// i.e., the ground action together with the conditional effect that adds the atom.
+struct LiftedAchiever
+{
+    formalism::GroundAction action = nullptr;
+    formalism::GroundConditionalEffect conditional_effect = nullptr;
+};
+
+/// @brief `LiftedRelaxedPlanningGraph` implements a common base class for heuristics based on the relaxed planning graph
+/// that do not require grounding the delete-relaxed task upfront.
+///
+/// The delete-free problem is evaluated as a Datalog-style fixpoint over its action and axiom schemas,
+/// following the generalized Dijkstra algorithm by Knuth (1977): in each iteration, all fluent atoms with minimal tentative cost are finalized,
+/// the axioms are applied until fixpoint, and the satisficing binding generators enumerate the ground actions whose preconditions are finalized.
+/// Since actions have unit cost, their effects are never finalized in the same iteration.
+/// The actions are evaluated semi-naively: after the first iteration, only the bindings that satisfy a positive precondition
+/// with an atom finalized in the current iteration are enumerated, and the conditional effects of the ground actions reached so far
+/// are kept until their conditions hold.
+/// Axioms are free and take the maximum cost of their preconditions, as in `RelaxedPlanningGraph`.
+///
+/// Notes: in contrast to `RelaxedPlanningGraph`, negative preconditions and negative goals are ignored because the delete-free problem drops them.
+/// The ground actions and axioms of the delete-free problem are cached in its repositories, meaning that
+/// only those reachable from an evaluated state are ever grounded.
+/// @tparam Derived is the derived class.
+template<typename Derived>
+class LiftedRelaxedPlanningGraph : public IHeuristic
+{
+private:
+    /// @brief Helper to cast to Derived.
+    constexpr const auto& self() const { return static_cast<const Derived&>(*this); }
+    constexpr auto& self() { return static_cast<Derived&>(*this); }
+
+    friend Derived;
+
+public:
+    ContinuousCost compute_heuristic(const State& state, bool is_goal_state) override;
+
+private:
+    explicit LiftedRelaxedPlanningGraph(formalism::Problem problem);
+
+    /// @brief Map the atom with the given index in the input problem to the corresponding atom in the delete-free problem.
+    template<formalism::IsFluentOrDerivedTag P>
+    Index translate_atom(Index atom_index);
+
+    void initialize(const State& state);
+
+    /// @brief Set the tentative cost of the fluent atom if the cost improves and enqueue it.
+    void update_cost(Index atom_index, DiscreteCost cost, const LiftedAchiever& achiever);
+
+    template<formalism::IsFluentOrDerivedTag P>
+    void finalize(Index atom_index, DiscreteCost cost);
+
+    /// @brief Finalize all enqueued fluent atoms with minimal cost.
+    /// @return the cost of the finalized atoms, or `MAX_DISCRETE_COST` if the queue is exhausted.
+    DiscreteCost finalize_next_layer();
+
+    void update_assignment_sets();
+
+    /// @brief Apply the axioms until fixpoint and finalize the derived atoms.
+    void apply_axioms();
+
+    /// @brief Apply the actions and update the tentative costs of their effects.
+    void apply_actions();
+
+    /// @brief Apply the actions whose bindings satisfy a positive precondition with an atom in `delta_atoms`.
+    template<formalism::IsFluentOrDerivedTag P>
+    void apply_triggered_actions(const IndexList& delta_atoms);
+
+    /// @brief Apply the ground action unless it was reached before and keep its conditional effects whose conditions do not hold yet.
+    void apply_action(formalism::Action action, formalism::ObjectList binding);
+
+    /// @brief Fire the pending conditional effects whose conditions hold.
+    void apply_pending_effects();
+
+    /// @brief Update the tentative costs of the positive effects of the conditional effect.
+    void fire(const LiftedAchiever& achiever);
+
+    template<formalism::IsFluentOrDerivedTag P>
+    DiscreteCost accumulate_action_cost(formalism::GroundConjunctiveCondition conjunctive_condition, DiscreteCost cost) const;
+
+    template<formalism::IsFluentOrDerivedTag P>
+    DiscreteCost accumulate_axiom_cost(formalism::GroundConjunctiveCondition conjunctive_condition, DiscreteCost cost) const;
+
+    formalism::Problem m_problem;
+
+    /* The delete-free problem */
+    formalism::DeleteRelaxTranslator m_delete_relax_translator;
+    formalism::Problem m_delete_free_problem;
+    formalism::ToObjectMap<formalism::Object> m_unrelaxed_object_to_delete_free_object;
+    formalism::ToObjectMap<formalism::Object> m_delete_free_object_to_unrelaxed_object;
+    IndexList m_fluent_atom_mapping;   ///< The delete-free atom index of each fluent atom index, or MAX_INDEX if not translated yet.
+    IndexList m_derived_atom_mapping;  ///< The delete-free atom index of each derived atom index, or MAX_INDEX if not translated yet.
+    IndexList m_fluent_goal_atoms;
+    IndexList m_derived_goal_atoms;
+    FlatBitset m_fluent_goal_atoms_bitset;
+    FlatBitset m_derived_goal_atoms_bitset;
+
+    ActionSatisficingBindingGeneratorList m_action_binding_generators;
+    AxiomSatisficingBindingGeneratorList m_axiom_binding_generators;
+
+    /// @brief A positive literal in the precondition of an action through which newly finalized atoms of its predicate can trigger the action.
+    template<formalism::IsFluentOrDerivedTag P>
+    struct Trigger
+    {
+        size_t binding_generator_index;
+        formalism::Literal<P> literal;
+    };
+    template<formalism::IsFluentOrDerivedTag P>
+    using TriggerMap = std::unordered_map<formalism::Predicate<P>, std::vector<Trigger<P>>>;
+
+    TriggerMap<formalism::FluentTag> m_fluent_triggers;
+    TriggerMap<formalism::DerivedTag> m_derived_triggers;
+
+    template<formalism::IsFluentOrDerivedTag P>
+    const TriggerMap<P>& get_triggers() const
+    {
+        if constexpr (std::is_same_v<P, formalism::FluentTag>)
+            return m_fluent_triggers;
+        else
+            return m_derived_triggers;
+    }
+
+    /* Memory for reuse */
+    UnpackedStateImpl m_relaxed_state;  ///< The finalized atoms of the delete-free problem.
+    formalism::AssignmentSet<formalism::FluentTag> m_fluent_assignment_set;
+    formalism::AssignmentSet<formalism::DerivedTag> m_derived_assignment_set;
+    formalism::NumericAssignmentSet<formalism::FluentTag> m_numeric_assignment_set;  ///< Always empty since the delete-free problem has no numeric constraints.
+    IndexList m_derived_atoms_buffer;
+    IndexList m_fluent_delta_atoms;   ///< The fluent atoms finalized since the actions were last applied.
+    IndexList m_derived_delta_atoms;  ///< The derived atoms finalized since the actions were last applied.
+    IndexList m_partial_binding;
+    FlatBitset m_reached_actions;                   ///< The indices of the ground actions reached in the current evaluation.
+    std::vector<LiftedAchiever> m_pending_effects;  ///< The conditional effects of reached ground actions whose conditions do not hold yet.
+
+    /* Annotations */
+    std::vector<DiscreteCost> m_fluent_costs;
+    std::vector<DiscreteCost> m_derived_costs;
+    std::vector<LiftedAchiever> m_fluent_achievers;
+    std::vector<formalism::GroundAxiom> m_derived_achievers;
+    size_t m_num_unsat_goals;
+    DiscreteCost m_layer;
+
+    struct QueueEntry
+    {
+        using KeyType = DiscreteCost;
+        using ItemType = Index;
+
+        KeyType cost;
+        ItemType atom_index;
+
+        KeyType get_key() const { return cost; }
+        ItemType get_item() const { return atom_index; }
+    };
+
+    PriorityQueue<QueueEntry> m_queue;
+
+    /**
+     * Accessors for the derived heuristics
+     */
+
+    const formalism::Problem& get_problem() const { return m_problem; }
+    const formalism::Problem& get_delete_free_problem() const { return m_delete_free_problem; }
+    const formalism::DeleteRelaxTranslator& get_delete_relax_translator() const { return m_delete_relax_translator; }
+    const formalism::ToObjectMap<formalism::Object>& get_delete_free_object_to_unrelaxed_object() const { return m_delete_free_object_to_unrelaxed_object; }
+    const IndexList& get_fluent_goal_atoms() const { return m_fluent_goal_atoms; }
+    const IndexList& get_derived_goal_atoms() const { return m_derived_goal_atoms; }
+
+    template<formalism::IsFluentOrDerivedTag P>
+    DiscreteCost get_cost(Index atom_index) const;
+
+    const LiftedAchiever& get_fluent_achiever(Index atom_index) const { return m_fluent_achievers[atom_index]; }
+    formalism::GroundAxiom get_derived_achiever(Index atom_index) const { return m_derived_achievers[atom_index]; }
+};
+
+}
+
+#endif
@@ -0,0 +1,578 @@
+/*
+ * Copyright (C) 2023 Dominik Drexler and Simon Stahlberg
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef MIMIR_SEARCH_HEURISTICS_LIFTED_RPG_BASE_IMPL_HPP_
+#define MIMIR_SEARCH_HEURISTICS_LIFTED_RPG_BASE_IMPL_HPP_
+
+#include "mimir/formalism/action.hpp"
+#include "mimir/formalism/axiom.hpp"
+#include "mimir/formalism/domain.hpp"
+#include "mimir/formalism/domain_builder.hpp"
+#include "mimir/formalism/ground_action.hpp"
+#include "mimir/formalism/ground_atom.hpp"
+#include "mimir/formalism/ground_axiom.hpp"
+#include "mimir/formalism/ground_conjunctive_condition.hpp"
+#include "mimir/formalism/ground_effects.hpp"
+#include "mimir/formalism/ground_literal.hpp"
+#include "mimir/formalism/literal.hpp"
+#include "mimir/formalism/object.hpp"
+#include "mimir/formalism/predicate.hpp"
+#include "mimir/formalism/problem.hpp"
+#include "mimir/formalism/problem_builder.hpp"
+#include "mimir/formalism/repositories.hpp"
+#include "mimir/formalism/utils.hpp"
+#include "mimir/search/applicability.hpp"
+#include "mimir/search/heuristics/lifted_rpg_base.hpp"
+#include "mimir/search/state.hpp"
+
+namespace mimir::search::rpg
+{
+
+inline formalism::Problem create_delete_free_problem(const formalism::Problem& problem, formalism::DeleteRelaxTranslator& delete_relax_translator)
+{
+    auto domain_builder = formalism::DomainBuilder();
+    auto delete_free_domain = delete_relax_translator.translate_level_0(problem->get_domain(), domain_builder);
+
+    auto problem_builder = formalism::ProblemBuilder(delete_free_domain);
+    return delete_relax_translator.translate_level_0(problem, problem_builder);
+}
+
+template<typename Derived>
+LiftedRelaxedPlanningGraph<Derived>::LiftedRelaxedPlanningGraph(formalism::Problem problem) :
+    m_problem(std::move(problem)),
+    m_delete_relax_translator(),
+    m_delete_free_problem(create_delete_free_problem(m_problem, m_delete_relax_translator)),
+    m_unrelaxed_object_to_delete_free_object(),
+    m_delete_free_object_to_unrelaxed_object(),
+    m_fluent_atom_mapping(),
+    m_derived_atom_mapping(),
+    m_fluent_goal_atoms(),
+    m_derived_goal_atoms(),
+    m_fluent_goal_atoms_bitset(),
+    m_derived_goal_atoms_bitset(),
+    m_action_binding_generators(),
+    m_axiom_binding_generators(),
+    m_fluent_triggers(),
+    m_derived_triggers(),
+    m_relaxed_state(*m_delete_free_problem),
+    m_fluent_assignment_set(m_delete_free_problem->get_problem_and_domain_objects().size(),
+                            m_delete_free_problem->get_domain()->get_predicates<formalism::FluentTag>()),
+    m_derived_assignment_set(m_delete_free_problem->get_problem_and_domain_objects().size(),
+                             m_delete_free_problem->get_problem_and_domain_derived_predicates()),
+    m_numeric_assignment_set(m_delete_free_problem->get_problem_and_domain_objects().size(),
+                             m_delete_free_problem->get_domain()->get_function_skeletons<formalism::FluentTag>()),
+    m_derived_atoms_buffer(),
+    m_fluent_delta_atoms(),
+    m_derived_delta_atoms(),
+    m_partial_binding(),
+    m_reached_actions(),
+    m_pending_effects(),
+    m_fluent_costs(),
+    m_derived_costs(),
+    m_fluent_achievers(),
+    m_derived_achievers(),
+    m_num_unsat_goals(0),
+    m_layer(0),
+    m_queue()
+{
+    auto delete_free_objects_by_name = std::unordered_map<std::string, formalism::Object> {};
+    for (const auto& object : m_delete_free_problem->get_problem_and_domain_objects())
+    {
+        delete_free_objects_by_name.emplace(object->get_name(), object);
+    }
+    for (const auto& object : m_problem->get_problem_and_domain_objects())
+    {
+        const auto delete_free_object = delete_free_objects_by_name.at(object->get_name());
+        m_unrelaxed_object_to_delete_free_object.emplace(object, delete_free_object);
+        m_delete_free_object_to_unrelaxed_object.emplace(delete_free_object, object);
+    }
+
+    for (const auto& literal : m_delete_free_problem->get_goal_condition<formalism::FluentTag>())
+    {
+        const auto atom_index = literal->get_atom()->get_index();
+        if (literal->get_polarity() && !m_fluent_goal_atoms_bitset.get(atom_index))
+        {
+            m_fluent_goal_atoms_bitset.set(atom_index);
+            m_fluent_goal_atoms.push_back(atom_index);
+        }
+    }
+    for (const auto& literal : m_delete_free_problem->get_goal_condition<formalism::DerivedTag>())
+    {
+        const auto atom_index = literal->get_atom()->get_index();
+        if (literal->get_polarity() && !m_derived_goal_atoms_bitset.get(atom_index))
+        {
+            m_derived_goal_atoms_bitset.set(atom_index);
+            m_derived_goal_atoms.push_back(atom_index);
+        }
+    }
+
+    for (const auto& action : m_delete_free_problem->get_domain()->get_actions())
+    {
+        const auto binding_generator_index = m_action_binding_generators.size();
+        m_action_binding_generators.push_back(ActionSatisficingBindingGenerator(action, m_delete_free_problem));
+
+        for (const auto& literal : action->get_conjunctive_condition()->get_literals<formalism::FluentTag>())
+        {
+            if (literal->get_polarity())
+                m_fluent_triggers[literal->get_atom()->get_predicate()].push_back(Trigger<formalism::FluentTag> { binding_generator_index, literal });
+        }
+        for (const auto& literal : action->get_conjunctive_condition()->get_literals<formalism::DerivedTag>())
+        {
+            if (literal->get_polarity())
+                m_derived_triggers[literal->get_atom()->get_predicate()].push_back(Trigger<formalism::DerivedTag> { binding_generator_index, literal });
+        }
+    }
+    for (const auto& axiom : m_delete_free_problem->get_problem_and_domain_axioms())
+    {
+        m_axiom_binding_generators.push_back(AxiomSatisficingBindingGenerator(axiom, m_delete_free_problem));
+    }
+}
+
+template<typename Derived>
+ContinuousCost LiftedRelaxedPlanningGraph<Derived>::compute_heuristic(const State& state, bool is_goal_state)
+{
+    if (is_goal_state)
+        return 0.;
+
+    initialize(state);
+
+    while (true)
+    {
+        apply_axioms();
+
+        if (m_num_unsat_goals == 0)
+        {
+            return self().extract_impl(state);
+        }
+
+        apply_actions();
+
+        m_layer = finalize_next_layer();
+
+        if (m_layer == MAX_DISCRETE_COST)
+        {
+            return INFINITY_CONTINUOUS_COST;
+        }
+    }
+}
+
+template<typename Derived>
+template<formalism::IsFluentOrDerivedTag P>
+Index LiftedRelaxedPlanningGraph<Derived>::translate_atom(Index atom_index)
+{
+    auto& mapping = std::is_same_v<P, formalism::FluentTag> ? m_fluent_atom_mapping : m_derived_atom_mapping;
+
+    if (atom_index >= mapping.size())
+    {
+        mapping.resize(atom_index + 1, MAX_INDEX);
+    }
+
+    if (mapping[atom_index] == MAX_INDEX)
+    {
+        const auto atom = m_problem->get_repositories().template get_ground_atom<P>(atom_index);
+
+        auto objects = formalism::ObjectList {};
+        objects.reserve(atom->get_objects().size());
+        for (const auto& object : atom->get_objects())
+        {
+            objects.push_back(m_unrelaxed_object_to_delete_free_object.at(object));
+        }
+
+        if constexpr (std::is_same_v<P, formalism::FluentTag>)
+        {
+            const auto& predicate = m_delete_free_problem->get_domain()->template get_predicate<P>(atom->get_predicate()->get_name());
+            mapping[atom_index] = m_delete_free_problem->get_or_create_ground_atom(predicate, objects)->get_index();
+        }
+        else
+        {
+            const auto& predicate = m_delete_free_problem->get_problem_or_domain_derived_predicate(atom->get_predicate()->get_name());
+            mapping[atom_index] = m_delete_free_problem->get_or_create_ground_atom(predicate, objects)->get_index();
+        }
+    }
+
+    return mapping[atom_index];
+}
+
+template<typename Derived>
+void LiftedRelaxedPlanningGraph<Derived>::initialize(const State& state)
+{
+    m_fluent_costs.assign(m_fluent_costs.size(), MAX_DISCRETE_COST);
+    m_derived_costs.assign(m_derived_costs.size(), MAX_DISCRETE_COST);
+    m_fluent_achievers.assign(m_fluent_achievers.size(), LiftedAchiever());
+    m_derived_achievers.assign(m_derived_achievers.size(), nullptr);
+    m_relaxed_state.get_atoms<formalism::FluentTag>().unset_all();
+    m_relaxed_state.get_atoms<formalism::DerivedTag>().unset_all();
+    m_queue.clear();
+    m_num_unsat_goals = m_fluent_goal_atoms.size() + m_derived_goal_atoms.size();
+    m_layer = 0;
+
+    m_fluent_delta_atoms.clear();
+    m_derived_delta_atoms.clear();
+    m_reached_actions.unset_all();
+    m_pending_effects.clear();
+
+    for (const auto atom_index : state.get_atoms<formalism::FluentTag>())
+    {
+        finalize<formalism::FluentTag>(translate_atom<formalism::FluentTag>(atom_index), 0);
+    }
+    for (const auto atom_index : state.get_atoms<formalism::DerivedTag>())
+    {
+        finalize<formalism::DerivedTag>(translate_atom<formalism::DerivedTag>(atom_index), 0);
+    }
+}
+
+template<typename Derived>
+void LiftedRelaxedPlanningGraph<Derived>::update_cost(Index atom_index, DiscreteCost cost, const LiftedAchiever& achiever)
+{
+    if (atom_index >= m_fluent_costs.size())
+    {
+        m_fluent_costs.resize(atom_index + 1, MAX_DISCRETE_COST);
+        m_fluent_achievers.resize(atom_index + 1);
+    }
+
+    if (cost < m_fluent_costs[atom_index])
+    {
+        assert(!m_relaxed_state.get_atoms<formalism::FluentTag>().get(atom_index));
+
+        m_fluent_costs[atom_index] = cost;
+        m_fluent_achievers[atom_index] = achiever;
+        m_queue.insert(QueueEntry { cost, atom_index });
+    }
+}
+
+template<typename Derived>
+template<formalism::IsFluentOrDerivedTag P>
+void LiftedRelaxedPlanningGraph<Derived>::finalize(Index atom_index, DiscreteCost cost)
+{
+    auto& costs = std::is_same_v<P, formalism::FluentTag> ? m_fluent_costs : m_derived_costs;
+    const auto& goal_atoms_bitset = std::is_same_v<P, formalism::FluentTag> ? m_fluent_goal_atoms_bitset : m_derived_goal_atoms_bitset;
+    auto& atoms = m_relaxed_state.get_atoms<P>();
+
+    if (atom_index >= costs.size())
+    {
+        costs.resize(atom_index + 1, MAX_DISCRETE_COST);
+        if constexpr (std::is_same_v<P, formalism::FluentTag>)
+            m_fluent_achievers.resize(atom_index + 1);
+        else
+            m_derived_achievers.resize(atom_index + 1, nullptr);
+    }
+
+    if (atoms.get(atom_index))
+    {
+        return;
+    }
+
+    costs[atom_index] = cost;
+    atoms.set(atom_index);
+
+    auto& delta_atoms = std::is_same_v<P, formalism::FluentTag> ? m_fluent_delta_atoms : m_derived_delta_atoms;
+    delta_atoms.push_back(atom_index);
+
+    if (goal_atoms_bitset.get(atom_index))
+    {
+        --m_num_unsat_goals;
+    }
+}
+
+template<typename Derived>
+DiscreteCost LiftedRelaxedPlanningGraph<Derived>::finalize_next_layer()
+{
+    const auto& atoms = m_relaxed_state.get_atoms<formalism::FluentTag>();
+
+    // Skip entries that were finalized or improved after they were enqueued.
+    while (!m_queue.empty() && (atoms.get(m_queue.top_entry().atom_index) || m_queue.top_entry().cost > m_fluent_costs[m_queue.top_entry().atom_index]))
+    {
+        m_queue.pop();
+    }
+
+    if (m_queue.empty())
+    {
+        return MAX_DISCRETE_COST;
+    }
+
+    const auto layer = m_queue.top_entry().cost;
+
+    while (!m_queue.empty() && m_queue.top_entry().cost == layer)
+    {
+        const auto entry = m_queue.top_entry();
+        m_queue.pop();
+
+        if (entry.cost == m_fluent_costs[entry.atom_index])
+        {
+            finalize<formalism::FluentTag>(entry.atom_index, layer);
+        }
+    }
+
+    return layer;
+}
+
+template<typename Derived>
+void LiftedRelaxedPlanningGraph<Derived>::update_assignment_sets()
+{
+    const auto& repositories = m_delete_free_problem->get_repositories();
+
+    m_fluent_assignment_set.update_ground_atoms(m_relaxed_state.get_atoms<formalism::FluentTag>(), repositories);
+    m_derived_assignment_set.update_ground_atoms(m_relaxed_state.get_atoms<formalism::DerivedTag>(), repositories);
+}
+
+template<typename Derived>
+template<formalism::IsFluentOrDerivedTag P>
+DiscreteCost LiftedRelaxedPlanningGraph<Derived>::accumulate_action_cost(formalism::GroundConjunctiveCondition conjunctive_condition,
+                                                                         DiscreteCost cost) const
+{
+    for (const auto atom_index : conjunctive_condition->get_precondition<formalism::PositiveTag, P>())
+    {
+        cost = self().accumulate_action_cost_impl(cost, get_cost<P>(atom_index));
+    }
+    return cost;
+}
+
+template<typename Derived>
+template<formalism::IsFluentOrDerivedTag P>
+DiscreteCost LiftedRelaxedPlanningGraph<Derived>::accumulate_axiom_cost(formalism::GroundConjunctiveCondition conjunctive_condition,
+                                                                        DiscreteCost cost) const
+{
+    for (const auto atom_index : conjunctive_condition->get_precondition<formalism::PositiveTag, P>())
+    {
+        cost = std::max(cost, get_cost<P>(atom_index));
+    }
+    return cost;
+}
+
+template<typename Derived>
+void LiftedRelaxedPlanningGraph<Derived>::apply_axioms()
+{
+    const auto& static_numeric_assignment_set = m_delete_free_problem->get_static_initial_numeric_assignment_set();
+
+    auto reached_fixpoint = false;
+
+    while (!reached_fixpoint)
+    {
+        reached_fixpoint = true;
+
+        for (auto& binding_generator : m_axiom_binding_generators)
+        {
+            if (!nullary_conditions_hold(binding_generator.get_conjunctive_condition(), m_relaxed_state))
+            {
+                continue;
+            }
+
+            update_assignment_sets();
+
+            // The derived atoms are finalized after the enumeration because the binding generator refers to the relaxed state.
+            m_derived_atoms_buffer.clear();
+
+            for (auto&& binding : binding_generator.create_binding_generator(m_relaxed_state,
+                                                                             m_fluent_assignment_set,
+                                                                             m_derived_assignment_set,
+                                                                             static_numeric_assignment_set,
+                                                                             m_numeric_assignment_set))
+            {
+                const auto ground_axiom = m_delete_free_problem->ground(binding_generator.get_axiom(), std::move(binding));
+                const auto atom_index = ground_axiom->get_literal()->get_atom()->get_index();
+
+                if (get_cost<formalism::DerivedTag>(atom_index) != MAX_DISCRETE_COST)
+                {
+                    continue;
+                }
+
+                // The cost equals the current layer because the axioms were applied until fixpoint in the previous layers.
+                const auto cost = accumulate_axiom_cost<formalism::DerivedTag>(
+                    ground_axiom->get_conjunctive_condition(),
+                    accumulate_axiom_cost<formalism::FluentTag>(ground_axiom->get_conjunctive_condition(), DiscreteCost(0)));
+                assert(cost == m_layer);
+
+                if (atom_index >= m_derived_costs.size())
+                {
+                    m_derived_costs.resize(atom_index + 1, MAX_DISCRETE_COST);
+                    m_derived_achievers.resize(atom_index + 1, nullptr);
+                }
+                m_derived_costs[atom_index] = cost;
+                m_derived_achievers[atom_index] = ground_axiom;
+                m_derived_atoms_buffer.push_back(atom_index);
+            }
+
+            for (const auto atom_index : m_derived_atoms_buffer)
+            {
+                finalize<formalism::DerivedTag>(atom_index, m_layer);
+                reached_fixpoint = false;
+            }
+        }
+    }
+}
+
+template<typename Derived>
+void LiftedRelaxedPlanningGraph<Derived>::apply_actions()
+{
+    const auto& static_numeric_assignment_set = m_delete_free_problem->get_static_initial_numeric_assignment_set();
+
+    update_assignment_sets();
+
+    // The costs of the preconditions are final, so the ground actions reached in previous layers only need to fire their pending conditional effects.
+    apply_pending_effects();
+
+    if (m_layer == 0)
+    {
+        for (auto& binding_generator : m_action_binding_generators)
+        {
+            if (!nullary_conditions_hold(binding_generator.get_conjunctive_condition(), m_relaxed_state))
+            {
+                continue;
+            }
+
+            for (auto&& binding : binding_generator.create_binding_generator(m_relaxed_state,
+                                                                             m_fluent_assignment_set,
+                                                                             m_derived_assignment_set,
+                                                                             static_numeric_assignment_set,
+                                                                             m_numeric_assignment_set))
+            {
+                apply_action(binding_generator.get_action(), std::move(binding));
+            }
+        }
+    }
+    else
+    {
+        // Semi-naive evaluation, i.e., every ground action that becomes applicable in this layer must satisfy a positive precondition
+        // with an atom finalized in this layer, so we only enumerate the bindings that map such a literal to a new atom.
+        apply_triggered_actions<formalism::FluentTag>(m_fluent_delta_atoms);
+        apply_triggered_actions<formalism::DerivedTag>(m_derived_delta_atoms);
+    }
+
+    m_fluent_delta_atoms.clear();
+    m_derived_delta_atoms.clear();
+}
+
+template<typename Derived>
+template<formalism::IsFluentOrDerivedTag P>
+void LiftedRelaxedPlanningGraph<Derived>::apply_triggered_actions(const IndexList& delta_atoms)
+{
+    const auto& static_numeric_assignment_set = m_delete_free_problem->get_static_initial_numeric_assignment_set();
+    const auto& repositories = m_delete_free_problem->get_repositories();
+    const auto& triggers = get_triggers<P>();
+
+    for (const auto atom_index : delta_atoms)
+    {
+        const auto ground_atom = repositories.template get_ground_atom<P>(atom_index);
+
+        const auto it = triggers.find(ground_atom->get_predicate());
+        if (it == triggers.end())
+        {
+            continue;
+        }
+
+        for (const auto& [binding_generator_index, literal] : it->second)
+        {
+            auto& binding_generator = m_action_binding_generators[binding_generator_index];
+
+            if (!nullary_conditions_hold(binding_generator.get_conjunctive_condition(), m_relaxed_state))
+            {
+                continue;
+            }
+
+            m_partial_binding.resize(binding_generator.get_conjunctive_condition()->get_arity());
+            if (!formalism::unify(literal, ground_atom, m_partial_binding))
+            {
+                continue;
+            }
+
+            for (auto&& binding : binding_generator.create_binding_generator(m_relaxed_state,
+                                                                             m_fluent_assignment_set,
+                                                                             m_derived_assignment_set,
+                                                                             static_numeric_assignment_set,
+                                                                             m_numeric_assignment_set,
+                                                                             m_partial_binding))
+            {
+                apply_action(binding_generator.get_action(), std::move(binding));
+            }
+        }
+    }
+}
+
+template<typename Derived>
+void LiftedRelaxedPlanningGraph<Derived>::apply_action(formalism::Action action, formalism::ObjectList binding)
+{
+    // The grounding table of the delete-free problem memoizes the ground action of each binding across evaluations.
+    const auto ground_action = m_delete_free_problem->ground(action, std::move(binding));
+
+    if (m_reached_actions.get(ground_action->get_index()))
+    {
+        return;  ///< Several new atoms can satisfy the preconditions of the same ground action.
+    }
+    m_reached_actions.set(ground_action->get_index());
+
+    for (const auto& conditional_effect : ground_action->get_conditional_effects())
+    {
+        const auto achiever = LiftedAchiever { ground_action, conditional_effect };
+
+        if (is_applicable(conditional_effect->get_conjunctive_condition(), m_relaxed_state))
+        {
+            fire(achiever);
+        }
+        else
+        {
+            m_pending_effects.push_back(achiever);
+        }
+    }
+}
+
+template<typename Derived>
+void LiftedRelaxedPlanningGraph<Derived>::apply_pending_effects()
+{
+    for (size_t i = 0; i < m_pending_effects.size();)
+    {
+        if (is_applicable(m_pending_effects[i].conditional_effect->get_conjunctive_condition(), m_relaxed_state))
+        {
+            fire(m_pending_effects[i]);
+            m_pending_effects[i] = m_pending_effects.back();
+            m_pending_effects.pop_back();
+        }
+        else
+        {
+            ++i;
+        }
+    }
+}
+
+template<typename Derived>
+void LiftedRelaxedPlanningGraph<Derived>::fire(const LiftedAchiever& achiever)
+{
+    const auto action_condition = achiever.action->get_conjunctive_condition();
+    const auto action_cost = accumulate_action_cost<formalism::DerivedTag>(action_condition,
+                                                                           accumulate_action_cost<formalism::FluentTag>(action_condition, DiscreteCost(0)));
+
+    const auto effect_condition = achiever.conditional_effect->get_conjunctive_condition();
+    const auto firing_cost =
+        accumulate_action_cost<formalism::DerivedTag>(effect_condition, accumulate_action_cost<formalism::FluentTag>(effect_condition, action_cost)) + 1;
+
+    for (const auto atom_index : achiever.conditional_effect->get_conjunctive_effect()->get_propositional_effects<formalism::PositiveTag>())
+    {
+        update_cost(atom_index, firing_cost, achiever);
+    }
+}
+
+template<typename Derived>
+template<formalism::IsFluentOrDerivedTag P>
+DiscreteCost LiftedRelaxedPlanningGraph<Derived>::get_cost(Index atom_index) const
+{
+    const auto& costs = std::is_same_v<P, formalism::FluentTag> ? m_fluent_costs : m_derived_costs;
+
+    return (atom_index < costs.size()) ? costs[atom_index] : MAX_DISCRETE_COST;
+}
+
+}
+
+#endif
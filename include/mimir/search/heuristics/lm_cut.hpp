@@ -0,0 +1,139 @@
+/*
+ * Copyright (C) 2023 Dominik Drexler and Simon Stahlberg
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef MIMIR_SEARCH_HEURISTICS_LM_CUT_HPP_
+#define MIMIR_SEARCH_HEURISTICS_LM_CUT_HPP_
+
+#include "mimir/common/types.hpp"
+#include "mimir/formalism/declarations.hpp"
+#include "mimir/search/declarations.hpp"
+#include "mimir/search/heuristics/interface.hpp"
+#include "mimir/search/heuristics/rpg/proposition.hpp"
+
+#include <cstdint>
+#include <vector>
+
+namespace mimir::search
+{
+
+/**
+ * LMCut
+ */
+
+/// @brief `LMCutHeuristicImpl` implements the admissible landmark-cut heuristic by Helmert and Domshlak (2009).
+///
+/// The heuristic is computed over the unary actions and axioms of the relaxed planning graph, see `rpg::RelaxedPlanningGraph`.
+/// Each round computes h_max, marks the goal zone, i.e., the propositions from which the goal is reached by free unary actions along h_max supporters,
+/// collects the unary actions that enter the goal zone from the propositions reachable before it, and reduces their cost by the minimal cost among them.
+/// All unary actions of a ground action share its cost, which is reduced at most once per cut.
+/// Hence, each cut is a disjunctive action landmark over ground actions, which keeps the heuristic admissible in the presence of conditional effects.
+/// Axioms are free and therefore never part of a cut.
+///
+/// The cost of a ground action is the increase of the total cost by its unconditional effects, evaluated in the initial state,
+/// or 1 if the problem has no metric. Costs of conditional effects are ignored, which underestimates the true cost.
+/// Action costs must be non-negative integers.
+///
+/// The unary actions and propositions are stored in compressed sparse row format, and all memory for the evaluation is allocated upfront.
+class LMCutHeuristicImpl : public IHeuristic
+{
+public:
+    explicit LMCutHeuristicImpl(const DeleteRelaxedProblemExplorator& delete_relaxation);
+
+    static LMCutHeuristic create(const DeleteRelaxedProblemExplorator& delete_relaxation);
+
+    ContinuousCost compute_heuristic(const State& state, bool is_goal_state) override;
+
+private:
+    /// @brief The dummy proposition is true in every state and the precondition of unary actions and axioms without preconditions.
+    static constexpr Index DUMMY_PROPOSITION_INDEX = 0;
+    /// @brief The cost index of free operators, i.e., axioms and the goal operator.
+    static constexpr Index FREE_COST_INDEX = 0;
+
+    enum class PropositionStatus : uint8_t
+    {
+        DEFAULT = 0,
+        BEFORE_GOAL_ZONE = 1,
+        GOAL_ZONE = 2,
+    };
+
+    template<formalism::IsFluentOrDerivedTag P>
+    void initialize_propositions(const State& state);
+
+    DiscreteCost get_operator_cost(Index operator_index) const { return m_remaining_costs[m_operator_cost_indices[operator_index]]; }
+
+    /// @brief Set the h_max cost of the proposition if the cost improves and enqueue it.
+    void enqueue(Index proposition_index, DiscreteCost cost);
+
+    /// @brief Compute h_max and the h_max supporter of each operator from scratch.
+    void compute_h_max();
+
+    /// @brief Update h_max and the h_max supporters after the costs of the operators with the reduced cost indices decreased.
+    void update_h_max();
+
+    /// @brief Mark the propositions from which the goal is reached by free operators along h_max supporters.
+    void mark_goal_zone();
+
+    /// @brief Collect the operators that are triggered by their h_max supporter before the goal zone and reach the goal zone.
+    void find_cut();
+
+    /* Operators in compressed sparse row format, where the unary actions are followed by the unary axioms and the goal operator. */
+    IndexList m_operator_precondition_offsets;
+    IndexList m_operator_preconditions;
+    IndexList m_operator_effects;
+    IndexList m_operator_cost_indices;
+
+    /* Propositions in compressed sparse row format, where the goal proposition is last. */
+    IndexList m_precondition_of_offsets;
+    IndexList m_precondition_of;
+    IndexList m_achiever_offsets;
+    IndexList m_achievers;
+    rpg::PropositionOffsets m_offsets;
+    Index m_goal_proposition;
+
+    /* Costs */
+    std::vector<DiscreteCost> m_costs;  ///< The cost of each cost index, where the first one is free and the others are ground actions.
+    IndexList m_cost_index_operator_offsets;
+    IndexList m_cost_index_operators;
+
+    /* Memory for reuse */
+    std::vector<DiscreteCost> m_remaining_costs;
+    std::vector<DiscreteCost> m_proposition_costs;
+    std::vector<PropositionStatus> m_proposition_statuses;
+    IndexList m_num_unsatisfied_preconditions;
+    IndexList m_supporters;
+    std::vector<DiscreteCost> m_supporter_costs;
+    IndexList m_initial_propositions;
+    IndexList m_stack;
+    IndexList m_cut;
+    IndexList m_reduced_cost_indices;
+
+    struct QueueEntry
+    {
+        DiscreteCost cost;
+        Index proposition_index;
+
+        bool operator>(const QueueEntry& other) const { return cost > other.cost; }
+    };
+
+    /// @brief Binary min-heap whose capacity is retained across evaluations, in contrast to `PriorityQueue`.
+    std::vector<QueueEntry> m_queue;
+};
+
+}
+
+#endif
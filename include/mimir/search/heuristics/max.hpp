@@ -30,9 +30,10 @@ namespace mimir::search
 class MaxHeuristicImpl : public rpg::RelaxedPlanningGraph<MaxHeuristicImpl>
 {
 public:
-    explicit MaxHeuristicImpl(const DeleteRelaxedProblemExplorator& delete_relaxation);
+    /// @param enable_incremental_evaluation repairs the annotations of the previously evaluated state instead of recomputing them.
+    explicit MaxHeuristicImpl(const DeleteRelaxedProblemExplorator& delete_relaxation, bool enable_incremental_evaluation = false);
 
-    static MaxHeuristic create(const DeleteRelaxedProblemExplorator& delete_relaxation);
+    static MaxHeuristic create(const DeleteRelaxedProblemExplorator& delete_relaxation, bool enable_incremental_evaluation = false);
 
 private:
     /// @brief Initialize "And"-structure node annotations.
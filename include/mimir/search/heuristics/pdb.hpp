@@ -0,0 +1,71 @@
+/*
+ * Copyright (C) 2023 Dominik Drexler and Simon Stahlberg
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef MIMIR_SEARCH_HEURISTICS_PDB_HPP_
+#define MIMIR_SEARCH_HEURISTICS_PDB_HPP_
+
+#include "mimir/common/filesystem.hpp"
+#include "mimir/formalism/declarations.hpp"
+#include "mimir/search/declarations.hpp"
+#include "mimir/search/heuristics/interface.hpp"
+#include "mimir/search/heuristics/pdb/declarations.hpp"
+
+#include <optional>
+
+namespace mimir::search
+{
+
+/**
+ * PDB
+ */
+
+/// @brief `PDBHeuristicImpl` implements the admissible heuristic of a single pattern database, see `pdb::PatternDatabaseImpl`.
+///
+/// The pattern database is built on the finite-domain representation of the delete-relaxed-reachable ground actions, see `pdb::TaskImpl`.
+/// Evaluating a state only maps its fluent atoms to variable values and looks up the distance of the abstract state.
+class PDBHeuristicImpl : public IHeuristic
+{
+public:
+    struct Options
+    {
+        std::optional<pdb::Pattern> pattern;  ///< The pattern, or std::nullopt to compute a greedy pattern, see `pdb::compute_greedy_pattern`.
+        size_t max_num_abstract_states;       ///< The limit on the number of abstract states of the greedy pattern.
+        std::optional<fs::path> cache_directory;  ///< The directory that the pattern database is loaded from and written to.
+
+        Options() : pattern(std::nullopt), max_num_abstract_states(1'000'000), cache_directory(std::nullopt) {}
+    };
+
+    PDBHeuristicImpl(const DeleteRelaxedProblemExplorator& delete_relaxation, const Options& options = Options());
+
+    static PDBHeuristic create(const DeleteRelaxedProblemExplorator& delete_relaxation, const Options& options = Options());
+
+    ContinuousCost compute_heuristic(const State& state, bool is_goal_state) override;
+
+    const pdb::Task& get_task() const;
+    const pdb::PatternDatabase& get_pattern_database() const;
+
+private:
+    pdb::Task m_task;
+    pdb::PatternDatabase m_pattern_database;
+
+    /* Memory for reuse */
+    IndexList m_values;
+};
+
+}
+
+#endif
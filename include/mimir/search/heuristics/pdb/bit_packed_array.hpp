@@ -0,0 +1,124 @@
+/*
+ * Copyright (C) 2023 Dominik Drexler and Simon Stahlberg
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef MIMIR_SEARCH_HEURISTICS_PDB_BIT_PACKED_ARRAY_HPP_
+#define MIMIR_SEARCH_HEURISTICS_PDB_BIT_PACKED_ARRAY_HPP_
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+namespace mimir::search::pdb
+{
+
+/// @brief `BitPackedArray` stores unsigned integers of a fixed bit width back to back in 64-bit words,
+/// where an element may straddle two words.
+///
+/// The words are either owned by the array or a view into memory that is kept alive by an owner, e.g., a memory-mapped file.
+/// Only arrays that own their words can be modified. Copies share the words.
+class BitPackedArray
+{
+public:
+    BitPackedArray() = default;
+
+    /// @brief Create an array that owns its words and whose elements are zero.
+    BitPackedArray(size_t size, size_t bit_width) :
+        m_size(size),
+        m_bit_width(bit_width),
+        m_mask(compute_mask(bit_width)),
+        m_words(nullptr),
+        m_owner(nullptr),
+        m_is_mutable(true)
+    {
+        auto storage = std::make_shared<std::vector<uint64_t>>(compute_num_words(size, bit_width), 0);
+        m_words = storage->data();
+        m_owner = std::move(storage);
+    }
+
+    /// @brief Create an array that views the given words.
+    /// @param owner keeps the memory of the words alive.
+    BitPackedArray(size_t size, size_t bit_width, const uint64_t* words, std::shared_ptr<const void> owner) :
+        m_size(size),
+        m_bit_width(bit_width),
+        m_mask(compute_mask(bit_width)),
+        m_words(const_cast<uint64_t*>(words)),
+        m_owner(std::move(owner)),
+        m_is_mutable(false)
+    {
+    }
+
+    static size_t compute_num_words(size_t size, size_t bit_width)
+    {
+        if (bit_width == 0 || bit_width > 64)
+            throw std::runtime_error("BitPackedArray::compute_num_words: Bit width must be between 1 and 64.");
+
+        return (size * bit_width + 63) / 64;
+    }
+
+    uint64_t get(size_t pos) const
+    {
+        assert(pos < m_size);
+        const auto bit = pos * m_bit_width;
+        const auto word = bit / 64;
+        const auto offset = bit % 64;
+        auto value = m_words[word] >> offset;
+        if (offset + m_bit_width > 64)
+        {
+            value |= m_words[word + 1] << (64 - offset);
+        }
+        return value & m_mask;
+    }
+
+    /// @brief Set the element, which requires that the array owns its words.
+    void set(size_t pos, uint64_t value)
+    {
+        assert(m_is_mutable && pos < m_size && value <= m_mask);
+        const auto bit = pos * m_bit_width;
+        const auto word = bit / 64;
+        const auto offset = bit % 64;
+        m_words[word] = (m_words[word] & ~(m_mask << offset)) | (value << offset);
+        if (offset + m_bit_width > 64)
+        {
+            const auto shift = 64 - offset;
+            m_words[word + 1] = (m_words[word + 1] & ~(m_mask >> shift)) | (value >> shift);
+        }
+    }
+
+    size_t size() const { return m_size; }
+    size_t get_bit_width() const { return m_bit_width; }
+    /// @brief Get the largest element that fits into the bit width.
+    uint64_t get_max_value() const { return m_mask; }
+    std::span<const uint64_t> get_words() const { return { m_words, compute_num_words(m_size, m_bit_width) }; }
+
+private:
+    static uint64_t compute_mask(size_t bit_width) { return bit_width >= 64 ? ~uint64_t(0) : (uint64_t(1) << bit_width) - 1; }
+
+    size_t m_size = 0;
+    size_t m_bit_width = 1;
+    uint64_t m_mask = 1;
+    uint64_t* m_words = nullptr;
+    std::shared_ptr<const void> m_owner = nullptr;
+    bool m_is_mutable = false;
+};
+
+}
+
+#endif
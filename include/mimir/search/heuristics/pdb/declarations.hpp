@@ -0,0 +1,46 @@
+/*
+ * Copyright (C) 2023 Dominik Drexler and Simon Stahlberg
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef MIMIR_SEARCH_HEURISTICS_PDB_DECLARATIONS_HPP_
+#define MIMIR_SEARCH_HEURISTICS_PDB_DECLARATIONS_HPP_
+
+#include "mimir/common/types.hpp"
+
+#include <memory>
+#include <vector>
+
+namespace mimir::search::pdb
+{
+
+/**
+ * Forward declarations
+ */
+
+class TaskImpl;
+using Task = std::shared_ptr<const TaskImpl>;
+
+/// @brief `Pattern` is a sorted list of variable indices.
+using Pattern = IndexList;
+using PatternList = std::vector<Pattern>;
+
+class PatternDatabaseImpl;
+using PatternDatabase = std::shared_ptr<const PatternDatabaseImpl>;
+using PatternDatabaseList = std::vector<PatternDatabase>;
+
+}
+
+#endif
@@ -0,0 +1,75 @@
+/*
+ * Copyright (C) 2023 Dominik Drexler and Simon Stahlberg
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef MIMIR_SEARCH_HEURISTICS_PDB_PATTERN_COLLECTION_HPP_
+#define MIMIR_SEARCH_HEURISTICS_PDB_PATTERN_COLLECTION_HPP_
+
+#include "mimir/common/types.hpp"
+#include "mimir/search/heuristics/pdb/declarations.hpp"
+
+#include <vector>
+
+namespace mimir::search::pdb
+{
+
+/// @brief Compute the operators that affect a variable of the pattern.
+/// @return the sorted operator indices.
+extern IndexList compute_affecting_operators(const TaskImpl& task, const Pattern& pattern);
+
+/// @brief Test whether two patterns are additive, i.e., whether no operator affects both, given their affecting operators.
+extern bool are_additive(const IndexList& lhs_affecting_operators, const IndexList& rhs_affecting_operators);
+
+/// @brief Compute the maximal cliques of an undirected graph with the Bron-Kerbosch algorithm with pivoting.
+/// @param adjacency_matrix is the symmetric adjacency matrix without self-loops.
+/// @return the maximal cliques as sorted lists of vertices.
+extern std::vector<IndexList> compute_maximal_cliques(const std::vector<std::vector<bool>>& adjacency_matrix);
+
+/// @brief `CanonicalPatternCollection` combines pattern databases with the canonical heuristic by Haslum et al. (2007),
+/// i.e., the maximum over all maximal sets of pairwise additive patterns of the sum of their distances.
+class CanonicalPatternCollection
+{
+public:
+    CanonicalPatternCollection(const TaskImpl& task, PatternDatabaseList pattern_databases);
+
+    /// @brief Compute the distances of the pattern databases for the variable values of a state, see `TaskImpl::compute_values`.
+    void compute_distances(const IndexList& values, std::vector<DiscreteCost>& out_distances) const;
+
+    /// @brief Combine the distances of the pattern databases.
+    /// @return the canonical heuristic value, or `MAX_DISCRETE_COST` if some distance is infinite.
+    DiscreteCost combine_distances(const std::vector<DiscreteCost>& distances) const;
+
+    /**
+     * Getters
+     */
+
+    const PatternDatabaseList& get_pattern_databases() const;
+    /// @brief Get the sorted operators that affect a variable in the pattern of each pattern database.
+    const std::vector<IndexList>& get_affecting_operators() const;
+    /// @brief Get the maximal sets of pairwise additive pattern databases.
+    const std::vector<IndexList>& get_maximal_additive_sets() const;
+    /// @brief Get the total number of abstract states of the pattern databases.
+    size_t get_num_abstract_states() const;
+
+private:
+    PatternDatabaseList m_pattern_databases;
+    std::vector<IndexList> m_affecting_operators;
+    std::vector<IndexList> m_maximal_additive_sets;
+};
+
+}
+
+#endif
@@ -0,0 +1,97 @@
+/*
+ * Copyright (C) 2023 Dominik Drexler and Simon Stahlberg
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef MIMIR_SEARCH_HEURISTICS_PDB_PATTERN_DATABASE_HPP_
+#define MIMIR_SEARCH_HEURISTICS_PDB_PATTERN_DATABASE_HPP_
+
+#include "mimir/common/filesystem.hpp"
+#include "mimir/common/types.hpp"
+#include "mimir/search/heuristics/pdb/bit_packed_array.hpp"
+#include "mimir/search/heuristics/pdb/declarations.hpp"
+
+namespace mimir::search::pdb
+{
+
+/// @brief `PatternDatabaseImpl` stores the goal distances in the projection of the task onto the variables of a pattern.
+///
+/// The abstract states are ranked by a mixed-radix encoding of the values of the pattern variables.
+/// The abstract transition system is generated explicitly, where an effect whose condition mentions variables outside of the pattern,
+/// derived atoms, or numeric constraints may or may not fire, and the goal distances are computed by a backward Dijkstra search.
+/// The distances are stored with the smallest bit width that fits the largest finite distance, where the largest value represents infinity.
+///
+/// A pattern database can be written to a file and loaded by memory-mapping it, in which case the distances are read from the mapped file.
+/// The file records a fingerprint of the task and the pattern, and loading fails if they do not match.
+class PatternDatabaseImpl
+{
+public:
+    /// @brief Build the pattern database.
+    /// @param task is the task.
+    /// @param pattern is the sorted list of variables.
+    PatternDatabaseImpl(const TaskImpl& task, Pattern pattern);
+
+    PatternDatabaseImpl(Pattern pattern, IndexList multipliers, BitPackedArray distances);
+
+    static PatternDatabase create(const TaskImpl& task, Pattern pattern);
+
+    /// @brief Load the pattern database from the cache directory if it was written for the same task and pattern,
+    /// and otherwise build it and write it to the cache directory.
+    static PatternDatabase create(const TaskImpl& task, Pattern pattern, const fs::path& cache_directory);
+
+    /// @brief Memory-map a pattern database file.
+    /// @return the pattern database, or nullptr if the file does not exist or was not written for the task and pattern.
+    static PatternDatabase load(const TaskImpl& task, const Pattern& pattern, const fs::path& file);
+
+    /// @brief Write the pattern database to a file. The file is replaced atomically.
+    void save(const TaskImpl& task, const fs::path& file) const;
+
+    /// @brief Get the file in the cache directory whose name identifies the task and pattern.
+    static fs::path get_cache_file(const TaskImpl& task, const Pattern& pattern, const fs::path& cache_directory);
+
+    /// @brief Compute the number of abstract states of the pattern.
+    /// @return the number of abstract states, or the maximum value of `size_t` if it overflows.
+    static size_t compute_num_abstract_states(const TaskImpl& task, const Pattern& pattern);
+
+    /// @brief Get the goal distance of the abstract state of the variable values of a state, see `TaskImpl::compute_values`.
+    /// @return the goal distance, or `MAX_DISCRETE_COST` if the abstract goal is unreachable.
+    DiscreteCost get_distance(const IndexList& values) const
+    {
+        auto rank = size_t(0);
+        for (size_t i = 0; i < m_pattern.size(); ++i)
+        {
+            rank += m_multipliers[i] * values[m_pattern[i]];
+        }
+        const auto distance = m_distances.get(rank);
+        return (distance == m_distances.get_max_value()) ? MAX_DISCRETE_COST : static_cast<DiscreteCost>(distance);
+    }
+
+    /**
+     * Getters
+     */
+
+    const Pattern& get_pattern() const;
+    size_t get_num_abstract_states() const;
+    const BitPackedArray& get_distances() const;
+
+private:
+    Pattern m_pattern;
+    IndexList m_multipliers;
+    BitPackedArray m_distances;
+};
+
+}
+
+#endif
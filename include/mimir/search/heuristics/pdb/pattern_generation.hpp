@@ -0,0 +1,66 @@
+/*
+ * Copyright (C) 2023 Dominik Drexler and Simon Stahlberg
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef MIMIR_SEARCH_HEURISTICS_PDB_PATTERN_GENERATION_HPP_
+#define MIMIR_SEARCH_HEURISTICS_PDB_PATTERN_GENERATION_HPP_
+
+#include "mimir/common/filesystem.hpp"
+#include "mimir/common/types.hpp"
+#include "mimir/search/declarations.hpp"
+#include "mimir/search/heuristics/pdb/declarations.hpp"
+
+#include <cstdint>
+#include <optional>
+
+namespace mimir::search::pdb
+{
+
+/// @brief Compute a single pattern by adding the goal variables and then their predecessors in the causal graph in breadth-first order
+/// as long as the number of abstract states does not exceed the limit.
+extern Pattern compute_greedy_pattern(const TaskImpl& task, size_t max_num_abstract_states);
+
+struct HillClimbingOptions
+{
+    size_t max_num_abstract_states_per_pattern = 2'000'000;
+    size_t max_num_abstract_states = 20'000'000;  ///< The limit on the total number of abstract states of the collection.
+    size_t num_samples = 1000;
+    size_t min_improvement = 10;  ///< Stop if the best candidate improves the heuristic value of fewer samples.
+    uint32_t max_time_ms = 60'000;
+    uint32_t random_seed = 0;
+};
+
+/// @brief Compute a pattern collection with the hill-climbing search by Haslum et al. (2007), also known as iPDB.
+///
+/// The search starts with one pattern for each goal variable. In each iteration, the candidates extend a pattern of the collection
+/// with a predecessor of its variables in the causal graph. States are sampled with random walks from the initial state whose length
+/// is about twice the estimated solution length, and the candidate that improves the canonical heuristic value of most samples is added.
+/// @param task is the task.
+/// @param delete_relaxation is the delete-relaxed problem explorator from which the task was created, which is used to sample states.
+/// @param options are the options.
+/// @param cache_directory is the directory that pattern databases are loaded from and written to, or std::nullopt to disable caching.
+/// @return the pattern databases of the collection.
+extern PatternDatabaseList compute_patterns_by_hill_climbing(const TaskImpl& task,
+                                                             const DeleteRelaxedProblemExplorator& delete_relaxation,
+                                                             const HillClimbingOptions& options = HillClimbingOptions(),
+                                                             const std::optional<fs::path>& cache_directory = std::nullopt);
+
+/// @brief Create the pattern database, using the cache directory if given.
+extern PatternDatabase create_pattern_database(const TaskImpl& task, Pattern pattern, const std::optional<fs::path>& cache_directory);
+
+}
+
+#endif
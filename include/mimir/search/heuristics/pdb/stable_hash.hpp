@@ -0,0 +1,63 @@
+/*
+ * Copyright (C) 2023 Dominik Drexler and Simon Stahlberg
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef MIMIR_SEARCH_HEURISTICS_PDB_STABLE_HASH_HPP_
+#define MIMIR_SEARCH_HEURISTICS_PDB_STABLE_HASH_HPP_
+
+#include <cstdint>
+#include <string_view>
+
+namespace mimir::search::pdb
+{
+
+/// @brief `StableHasher` implements the 64-bit FNV-1a hash, which in contrast to `std::hash` is the same across runs, platforms, and compilers.
+/// It identifies tasks and patterns in the names and headers of cached pattern databases.
+class StableHasher
+{
+public:
+    void add(uint64_t value)
+    {
+        for (int i = 0; i < 8; ++i)
+        {
+            add_byte(static_cast<uint8_t>(value >> (8 * i)));
+        }
+    }
+
+    void add(std::string_view value)
+    {
+        add(static_cast<uint64_t>(value.size()));
+        for (const auto c : value)
+        {
+            add_byte(static_cast<uint8_t>(c));
+        }
+    }
+
+    uint64_t get() const { return m_hash; }
+
+private:
+    void add_byte(uint8_t byte)
+    {
+        m_hash ^= byte;
+        m_hash *= 0x100000001b3ULL;
+    }
+
+    uint64_t m_hash = 0xcbf29ce484222325ULL;
+};
+
+}
+
+#endif
@@ -0,0 +1,151 @@
+/*
+ * Copyright (C) 2023 Dominik Drexler and Simon Stahlberg
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef MIMIR_SEARCH_HEURISTICS_PDB_TASK_HPP_
+#define MIMIR_SEARCH_HEURISTICS_PDB_TASK_HPP_
+
+#include "mimir/common/types.hpp"
+#include "mimir/formalism/declarations.hpp"
+#include "mimir/search/declarations.hpp"
+#include "mimir/search/heuristics/pdb/declarations.hpp"
+
+#include <cstdint>
+#include <vector>
+
+namespace mimir::search::pdb
+{
+
+/// @brief `Fact` is the assignment of a value to a variable.
+struct Fact
+{
+    Index variable;
+    Index value;
+};
+
+using FactList = std::vector<Fact>;
+
+/// @brief `Variable` is a finite-domain variable whose values are the fluent atoms of a mutex group followed by the value none,
+/// which represents that no atom of the group is true.
+struct Variable
+{
+    IndexList atoms;  ///< The fluent atom index of each value except the last one.
+
+    size_t get_domain_size() const { return atoms.size() + 1; }
+    Index get_none_value() const { return atoms.size(); }
+};
+
+using VariableList = std::vector<Variable>;
+
+/// @brief `Effect` is a conditional effect of an `Operator`.
+///
+/// The condition is only partially represented: derived atoms and numeric constraints are dropped,
+/// which is indicated by `has_unknown_condition`, meaning that the effect may or may not fire when the represented condition holds.
+struct Effect
+{
+    FactList positive_conditions;  ///< The variable must have the value.
+    FactList negative_conditions;  ///< The variable must not have the value.
+    bool has_unknown_condition;
+    FactList add_facts;     ///< The variable is set to the value.
+    FactList delete_facts;  ///< The variable is set to none if it has the value. Deletes are applied before adds.
+};
+
+using EffectList = std::vector<Effect>;
+
+/// @brief `Operator` is a ground action in the finite-domain representation.
+///
+/// Derived and numeric preconditions are dropped, which relaxes the operator.
+struct Operator
+{
+    formalism::GroundAction action;
+    DiscreteCost cost;
+    FactList positive_preconditions;
+    FactList negative_preconditions;
+    EffectList effects;
+};
+
+using OperatorList = std::vector<Operator>;
+
+/// @brief Compute mutex groups over the fluent atoms, i.e., sets of atoms of which at most one is true in every reachable state.
+///
+/// The candidates are seeded with the atoms of a predicate that agree on all but one argument.
+/// A candidate is an invariant if the initial state contains at most one of its atoms and each action that adds an atom of the candidate
+/// adds no other atom of the candidate and requires an atom of the candidate that it deletes, or the added atom itself.
+/// A violating action is repaired by extending the candidate with a deleted precondition, which yields groups over several predicates,
+/// e.g., the locations of an object together with the grippers holding it.
+/// The repairs are explored in depth-first order with a bounded number of steps per seed.
+/// Only ground actions are considered, and hence the groups are specific to the problem.
+/// @param problem is the problem.
+/// @param actions are the ground actions, e.g., all delete-relaxed-reachable ground actions.
+/// @param atoms are the fluent atom indices that can be true, i.e., the initial atoms and all atoms added by an action.
+/// @return the mutex groups as sorted lists of fluent atom indices.
+extern std::vector<IndexList> compute_mutex_groups(const formalism::ProblemImpl& problem, const formalism::GroundActionList& actions, const IndexList& atoms);
+
+/// @brief `TaskImpl` is a finite-domain representation of the problem that abstractions are built on.
+///
+/// The variables are obtained from a disjoint selection of the mutex groups, where the largest groups are preferred,
+/// and each remaining fluent atom becomes a binary variable. Derived atoms and numeric variables are not represented.
+/// Goals on derived atoms and numeric goals are dropped, which keeps heuristics built on the task admissible.
+class TaskImpl
+{
+public:
+    explicit TaskImpl(const DeleteRelaxedProblemExplorator& delete_relaxation);
+
+    static Task create(const DeleteRelaxedProblemExplorator& delete_relaxation);
+
+    /// @brief Write the value of each variable in the state into `out_values`.
+    void compute_values(const State& state, IndexList& out_values) const;
+
+    /// @brief Compute the variables that are preconditions, conditions, or co-effects of operators that affect the variable.
+    /// @return the predecessors of each variable in the causal graph as sorted lists.
+    std::vector<IndexList> compute_causal_graph_predecessors() const;
+
+    /**
+     * Getters
+     */
+
+    const formalism::Problem& get_problem() const;
+    const VariableList& get_variables() const;
+    const OperatorList& get_operators() const;
+    const FactList& get_positive_goals() const;
+    const FactList& get_negative_goals() const;
+    /// @brief Get the variables whose value is changed by the operator.
+    const std::vector<IndexList>& get_affected_variables() const;
+    /// @brief Get the variable of each fluent atom, or MAX_INDEX if the atom is never true.
+    const IndexList& get_atom_to_variable() const;
+    const IndexList& get_atom_to_value() const;
+    /// @brief Return true iff some fluent goal atom is never true.
+    bool is_unsolvable() const;
+    /// @brief Get a hash of the variables, operators, and goals that is stable across runs on the same problem.
+    uint64_t get_fingerprint() const;
+
+private:
+    formalism::Problem m_problem;
+
+    VariableList m_variables;
+    OperatorList m_operators;
+    FactList m_positive_goals;
+    FactList m_negative_goals;
+    std::vector<IndexList> m_affected_variables;
+    IndexList m_atom_to_variable;
+    IndexList m_atom_to_value;
+    bool m_is_unsolvable;
+    uint64_t m_fingerprint;
+};
+
+}
+
+#endif
@@ -0,0 +1,50 @@
+/*
+ * Copyright (C) 2023 Dominik Drexler and Simon Stahlberg
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef MIMIR_SEARCH_HEURISTICS_RPG_STATISTICS_HPP_
+#define MIMIR_SEARCH_HEURISTICS_RPG_STATISTICS_HPP_
+
+#include <cstddef>
+#include <ostream>
+
+namespace mimir::search::rpg
+{
+struct Statistics
+{
+    size_t num_evaluations = 0;              ///< Evaluations of non-goal states.
+    size_t num_full_evaluations = 0;         ///< Evaluations that recomputed all annotations.
+    size_t num_incremental_evaluations = 0;  ///< Evaluations that repaired the annotations of the previously evaluated state.
+    size_t num_fallbacks = 0;                ///< Repairs that were aborted because the change was too large.
+    size_t num_touched_propositions = 0;     ///< Propositions that were invalidated or dequeued, summed over all evaluations.
+};
+
+inline std::ostream& operator<<(std::ostream& os, const Statistics& statistics)
+{
+    os << "[RPG] Number of evaluations: " << statistics.num_evaluations << "\n"
+       << "[RPG] Number of full evaluations: " << statistics.num_full_evaluations << "\n"
+       << "[RPG] Number of incremental evaluations: " << statistics.num_incremental_evaluations << "\n"
+       << "[RPG] Number of fallbacks to full evaluations: " << statistics.num_fallbacks << "\n"
+       << "[RPG] Number of touched propositions: " << statistics.num_touched_propositions << "\n"
+       << "[RPG] Average number of touched propositions per evaluation: "
+       << ((statistics.num_evaluations > 0) ? static_cast<double>(statistics.num_touched_propositions) / statistics.num_evaluations : 0.);
+
+    return os;
+}
+}
+
+#endif
@@ -80,6 +80,7 @@ class Axiom
 public:
     Axiom(Index index, ConditionsContainer preconditions, size_t num_preconditions, Index derived_effect, bool polarity) :
         m_index(index),
+        m_preconditions(preconditions),
         m_num_preconditions(num_preconditions),
         m_derived_effect(derived_effect),
         m_polarity(polarity)
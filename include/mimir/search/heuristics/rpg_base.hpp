@@ -28,6 +28,7 @@
 #include "mimir/search/heuristics/rpg/annotations.hpp"
 #include "mimir/search/heuristics/rpg/construction_helpers.hpp"
 #include "mimir/search/heuristics/rpg/proposition.hpp"
+#include "mimir/search/heuristics/rpg/statistics.hpp"
 #include "mimir/search/heuristics/rpg/structures.hpp"
 #include "mimir/search/openlists/priority_queue.hpp"
 
@@ -45,6 +46,14 @@ namespace mimir::search::rpg
 /// Under this assumption, we could remove all negated derived propositions from the graph, but we keep them for extendability.
 /// Furthermore, an experiment has shown that pruning irrelevant unary actions and axioms is too expensive
 /// where an action or axiom is considered irrelevant if one with a smaller index has the same effect but with less or equal constrained preconditions.
+///
+/// With incremental evaluation enabled, the annotations of the previously evaluated state are repaired instead of recomputed,
+/// which pays off in eager search where consecutively evaluated states are siblings that differ in a few atoms.
+/// The repair invalidates all propositions whose chain of best supporters depends on a proposition that is no longer true,
+/// reinitializes them from their remaining supporters, and then propagates cost decreases in the style of DynamicSWSF-FP (Ramalingam and Reps 1996).
+/// Ties among best supporters are broken by the smallest depth, i.e., the number of consecutive axioms that derive a proposition without increasing its cost,
+/// and then by the smallest supporter index. This makes the best supporters independent of the order in which the structures are processed.
+/// Hence, the best supporters and the relaxed plans extracted from them are identical to a full evaluation with incremental evaluation enabled.
 /// @tparam Derived is the derived class.
 template<typename Derived>
 class RelaxedPlanningGraph : public IHeuristic
@@ -58,21 +67,45 @@ private:
 
     static constexpr Index DUMMY_PROPOSITION_INDEX = 0;
 
+    /// @brief Fall back to a full evaluation if more than this fraction of the atoms in the state changed.
+    static constexpr double MAX_CHANGED_ATOMS_FRACTION = 0.5;
+    /// @brief Abort the repair if more than this fraction of the propositions is invalidated.
+    static constexpr double MAX_INVALIDATED_PROPOSITIONS_FRACTION = 0.5;
+
 public:
     ContinuousCost compute_heuristic(const State& state, bool is_goal_state) override
     {
         if (is_goal_state)
             return 0.;
 
-        self().initialize_and_annotations();
-        self().initialize_or_annotations();
-        self().initialize_or_annotations_and_queue(state);
-        dijksta();
+        ++m_statistics.num_evaluations;
+
+        if (m_enable_incremental_evaluation && m_has_previous_state && repair_annotations(state))
+        {
+            ++m_statistics.num_incremental_evaluations;
+        }
+        else
+        {
+            self().initialize_and_annotations();
+            self().initialize_or_annotations();
+            self().initialize_or_annotations_and_queue(state);
+            dijksta();
+            ++m_statistics.num_full_evaluations;
+        }
+
+        if (m_enable_incremental_evaluation)
+        {
+            store_previous_state(state);
+            count_unsatisfied_goals();
+        }
+
         return (m_num_unsat_goals > 0) ? INFINITY_CONTINUOUS_COST : self().extract_impl(state);
     }
 
+    const Statistics& get_statistics() const { return m_statistics; }
+
 private:
-    explicit RelaxedPlanningGraph(const DeleteRelaxedProblemExplorator& delete_relaxation) :
+    explicit RelaxedPlanningGraph(const DeleteRelaxedProblemExplorator& delete_relaxation, bool enable_incremental_evaluation) :
         m_problem(delete_relaxation.get_problem()),
         m_offsets(),
         m_atom_indices(),
@@ -82,7 +115,20 @@ private:
         m_proposition_annotations(),
         m_goal_propositions(),
         m_num_unsat_goals(0),
-        m_queue()
+        m_queue(),
+        m_enable_incremental_evaluation(enable_incremental_evaluation),
+        m_supporters(),
+        m_depths(),
+        m_is_effect_of(),
+        m_has_previous_state(false),
+        m_previous_atoms(),
+        m_added_propositions(),
+        m_removed_propositions(),
+        m_invalidated_propositions(),
+        m_is_invalidated(),
+        m_is_visited(),
+        m_visit_stack(),
+        m_statistics()
     {
         /**
          * Instantiate actions.
@@ -127,6 +173,30 @@ private:
         get<Action>(get_structures_annotations()).resize(get<Action>(get_structures()).size());
         get<Axiom>(get_structures_annotations()).resize(get<Axiom>(get_structures()).size());
         get_proposition_annotations().resize(get_propositions().size());
+
+        /**
+         * Instantiate the supporters for incremental evaluation.
+         */
+
+        m_supporters.resize(get_propositions().size(), MAX_INDEX);
+        m_depths.resize(get_propositions().size(), 0);
+
+        if (m_enable_incremental_evaluation)
+        {
+            boost::hana::for_each(m_structures,
+                                  [this](auto&& pair)
+                                  {
+                                      using KeyType = typename decltype(+boost::hana::first(pair))::type;
+                                      const auto& structures = boost::hana::second(pair);
+                                      auto& is_effect_of = boost::hana::at_key(m_is_effect_of, boost::hana::type<KeyType> {});
+                                      is_effect_of.resize(get_propositions().size());
+
+                                      for (const auto& structure : structures)
+                                      {
+                                          is_effect_of[get_effect_proposition_index(structure)].push_back(structure.get_index());
+                                      }
+                                  });
+        }
     }
 
     void initialize_and_annotations()
@@ -148,6 +218,8 @@ private:
         {
             self().initialize_or_annotations_impl(proposition);
         }
+        std::fill(m_supporters.begin(), m_supporters.end(), MAX_INDEX);
+        std::fill(m_depths.begin(), m_depths.end(), 0);
     }
 
     template<formalism::IsFluentOrDerivedTag P>
@@ -240,13 +312,101 @@ private:
         {
             // std::cout << "Process satisfied structure: " << structure.get_index() << std::endl;
 
-            const auto effect_proposition_index = structure.get_polarity() ?
-                                                      get<formalism::PositiveTag, formalism::FluentTag>(get_offsets())[structure.get_effect()] :
-                                                      get<formalism::NegativeTag, formalism::FluentTag>(get_offsets())[structure.get_effect()];
+            update_or_annotation(structure, get_propositions()[get_effect_proposition_index(structure)]);
+        }
+    }
+
+    /// @brief Get the index of the proposition that is the effect of the structure.
+    template<IsStructure S>
+    Index get_effect_proposition_index(const S& structure)
+    {
+        using P = std::conditional_t<std::is_same_v<S, Action>, formalism::FluentTag, formalism::DerivedTag>;
+
+        return structure.get_polarity() ? get<formalism::PositiveTag, P>(get_offsets())[structure.get_effect()] :
+                                          get<formalism::NegativeTag, P>(get_offsets())[structure.get_effect()];
+    }
+
+    /// @brief Encode the structure as supporter, where axioms follow the actions.
+    template<IsStructure S>
+    Index get_supporter_index(const S& structure)
+    {
+        return std::is_same_v<S, Action> ? structure.get_index() : get<Action>(get_structures()).size() + structure.get_index();
+    }
+
+    /// @brief Get the cost of the effect of the satisfied structure.
+    template<IsStructure S>
+    DiscreteCost get_firing_cost(const S& structure)
+    {
+        return get_cost(get<S>(get_structures_annotations())[structure.get_index()]) + (std::is_same_v<S, Action> ? 1 : 0);
+    }
+
+    /// @brief Get the depth of the effect of the satisfied structure, which is larger than the depth of its preconditions with equal cost.
+    template<IsStructure S>
+    size_t get_firing_depth(const S& structure, DiscreteCost firing_cost)
+    {
+        if constexpr (std::is_same_v<S, Action>)
+        {
+            return 0;
+        }
+        else
+        {
+            auto depth = size_t(0);
+
+            for_each_precondition_proposition(structure,
+                                              [this, firing_cost, &depth](const Proposition& proposition)
+                                              {
+                                                  if (get_cost(get_proposition_annotations()[proposition.get_index()]) == firing_cost)
+                                                      depth = std::max(depth, m_depths[proposition.get_index()]);
+                                              });
+
+            return depth + 1;
+        }
+    }
+
+    /// @brief Get the key of the proposition in the queue.
+    std::pair<DiscreteCost, size_t> get_queue_key(Index proposition_index)
+    {
+        return { get_cost(get_proposition_annotations()[proposition_index]), m_depths[proposition_index] };
+    }
+
+    /// @brief Update the "Or"-proposition node and remember the structure as its best supporter if the cost decreased.
+    /// With incremental evaluation enabled, ties in cost are broken by the smallest depth and then by the smallest supporter index.
+    template<IsStructure S>
+    void update_or_annotation(const S& structure, const Proposition& proposition)
+    {
+        const auto proposition_index = proposition.get_index();
+        const auto cost = get_cost(get_proposition_annotations()[proposition_index]);
+
+        self().update_or_annotation_impl(structure, proposition);
+
+        if (!m_enable_incremental_evaluation)
+        {
+            if (get_cost(get_proposition_annotations()[proposition_index]) < cost)
+            {
+                m_supporters[proposition_index] = get_supporter_index(structure);
+                m_queue.insert(QueueEntry { get_cost(get_proposition_annotations()[proposition_index]), 0, proposition_index });
+            }
+            return;
+        }
+
+        const auto firing_cost = get_firing_cost(structure);
+        const auto depth = get_firing_depth(structure, firing_cost);
+        const auto supporter_index = get_supporter_index(structure);
+
+        assert(firing_cost >= cost || get_cost(get_proposition_annotations()[proposition_index]) == firing_cost);
+
+        if (std::tie(firing_cost, depth, supporter_index) < std::tie(cost, m_depths[proposition_index], m_supporters[proposition_index]))
+        {
+            // A smaller supporter index alone does not change the key of the proposition.
+            const auto is_key_decreased = std::tie(firing_cost, depth) < std::tie(cost, m_depths[proposition_index]);
 
-            const auto& effect_proposition = get_propositions()[effect_proposition_index];
+            m_supporters[proposition_index] = supporter_index;
+            m_depths[proposition_index] = depth;
 
-            self().update_or_annotation_impl(structure, effect_proposition);
+            if (is_key_decreased)
+            {
+                m_queue.insert(QueueEntry { firing_cost, depth, proposition_index });
+            }
         }
     }
 
@@ -260,16 +420,18 @@ private:
             m_queue.pop();
 
             const auto& proposition = get_propositions()[entry.proposition_index];
-            const auto& annotation = get_proposition_annotations()[entry.proposition_index];
 
             // std::cout << "Queue pop: " << entry.proposition_index << " " << entry.cost << std::endl;
 
-            if (get_cost(annotation) < entry.cost)
+            if (get_queue_key(entry.proposition_index) < entry.get_key())
             {
                 continue;
             }
 
-            if (proposition.is_goal() && --m_num_unsat_goals == 0)
+            ++m_statistics.num_touched_propositions;
+
+            // The incremental evaluation requires the annotations of all reachable propositions.
+            if (proposition.is_goal() && --m_num_unsat_goals == 0 && !m_enable_incremental_evaluation)
             {
                 return;
             }
@@ -293,6 +455,324 @@ private:
         // std::cout << "Num unsat goals: " << num_unsat_goals << std::endl;
     }
 
+    /**
+     * Incremental evaluation
+     */
+
+    template<formalism::IsPolarity R, formalism::IsFluentOrDerivedTag P, IsStructure S, typename Callback>
+    void for_each_precondition_proposition_helper(const S& structure, Callback& callback)
+    {
+        const auto& offsets = get<R, P>(get_offsets());
+
+        for (const auto atom_index : structure.template get_preconditions<R, P>()->compressed_range())
+        {
+            callback(get_propositions()[offsets[atom_index]]);
+        }
+        if constexpr (std::is_same_v<S, Action>)
+        {
+            for (const auto atom_index : structure.template get_conditional_preconditions<R, P>()->compressed_range())
+            {
+                callback(get_propositions()[offsets[atom_index]]);
+            }
+        }
+    }
+
+    template<IsStructure S, typename Callback>
+    void for_each_precondition_proposition(const S& structure, Callback&& callback)
+    {
+        for_each_precondition_proposition_helper<formalism::PositiveTag, formalism::FluentTag>(structure, callback);
+        for_each_precondition_proposition_helper<formalism::NegativeTag, formalism::FluentTag>(structure, callback);
+        for_each_precondition_proposition_helper<formalism::PositiveTag, formalism::DerivedTag>(structure, callback);
+        for_each_precondition_proposition_helper<formalism::NegativeTag, formalism::DerivedTag>(structure, callback);
+    }
+
+    /// @brief Recompute the "And"-structure node from the current annotations of its preconditions and update its effect.
+    template<IsStructure S>
+    void recompute_structure(const S& structure)
+    {
+        auto& structure_annotation = get<S>(get_structures_annotations())[structure.get_index()];
+
+        self().initialize_and_annotations_impl(structure);
+
+        for_each_precondition_proposition(structure,
+                                          [this, &structure, &structure_annotation](const Proposition& proposition)
+                                          {
+                                              if (get_cost(get_proposition_annotations()[proposition.get_index()]) == MAX_DISCRETE_COST)
+                                                  return;
+
+                                              self().update_and_annotation_impl(proposition, structure);
+                                              --get_num_unsatisfied_preconditions(structure_annotation);
+                                          });
+
+        if (get_num_unsatisfied_preconditions(structure_annotation) == 0)
+        {
+            update_or_annotation(structure, get_propositions()[get_effect_proposition_index(structure)]);
+        }
+    }
+
+    /// @brief Collect the propositions that became true or false in the first layer since the previously evaluated state.
+    template<formalism::IsFluentOrDerivedTag P>
+    size_t collect_changed_propositions(const State& state)
+    {
+        const auto& positive_offsets = get<formalism::PositiveTag, P>(get_offsets());
+        const auto& negative_offsets = get<formalism::NegativeTag, P>(get_offsets());
+        const auto& previous_atoms = get<P>(m_previous_atoms);
+        const auto& state_atoms = state.get_atoms<P>();
+
+        auto num_changed_atoms = size_t(0);
+
+        const auto on_added_atom = [&](Index atom_index)
+        {
+            m_added_propositions.push_back(positive_offsets[atom_index]);
+            // Negative derived propositions are always true in the first layer.
+            if constexpr (std::is_same_v<P, formalism::FluentTag>)
+                m_removed_propositions.push_back(negative_offsets[atom_index]);
+            ++num_changed_atoms;
+        };
+        const auto on_removed_atom = [&](Index atom_index)
+        {
+            m_removed_propositions.push_back(positive_offsets[atom_index]);
+            if constexpr (std::is_same_v<P, formalism::FluentTag>)
+                m_added_propositions.push_back(negative_offsets[atom_index]);
+            ++num_changed_atoms;
+        };
+
+        auto it = state_atoms.begin();
+        auto it2 = previous_atoms.begin();
+        const auto end = state_atoms.end();
+        const auto end2 = previous_atoms.end();
+
+        while (it != end && it2 != end2)
+        {
+            if (*it == *it2)
+            {
+                ++it;
+                ++it2;
+            }
+            else if (*it < *it2)
+            {
+                on_added_atom(*it);
+                ++it;
+            }
+            else
+            {
+                on_removed_atom(*it2);
+                ++it2;
+            }
+        }
+        for (; it != end; ++it)
+        {
+            on_added_atom(*it);
+        }
+        for (; it2 != end2; ++it2)
+        {
+            on_removed_atom(*it2);
+        }
+
+        return num_changed_atoms;
+    }
+
+    void invalidate(Index proposition_index)
+    {
+        m_is_invalidated.set(proposition_index);
+        m_invalidated_propositions.push_back(proposition_index);
+        m_supporters[proposition_index] = MAX_INDEX;
+        m_depths[proposition_index] = 0;
+        self().initialize_or_annotations_impl(get_propositions()[proposition_index]);
+    }
+
+    /// @brief Repair the annotations of the previously evaluated state.
+    /// @return false if the repair was aborted because the change is too large, meaning that all annotations must be recomputed.
+    bool repair_annotations(const State& state)
+    {
+        m_added_propositions.clear();
+        m_removed_propositions.clear();
+
+        const auto num_changed_atoms = collect_changed_propositions<formalism::FluentTag>(state) + collect_changed_propositions<formalism::DerivedTag>(state);
+        const auto num_atoms = state.get_atoms<formalism::FluentTag>().count() + state.get_atoms<formalism::DerivedTag>().count();
+
+        if (num_changed_atoms > MAX_CHANGED_ATOMS_FRACTION * num_atoms)
+        {
+            ++m_statistics.num_fallbacks;
+            return false;
+        }
+
+        /* Invalidate all propositions whose best supporters transitively depend on a removed proposition. */
+
+        m_invalidated_propositions.clear();
+        m_is_invalidated.unset_all();
+
+        for (const auto proposition_index : m_removed_propositions)
+        {
+            invalidate(proposition_index);
+        }
+
+        const auto max_num_invalidated_propositions = MAX_INVALIDATED_PROPOSITIONS_FRACTION * get_propositions().size();
+
+        for (size_t i = 0; i < m_invalidated_propositions.size(); ++i)
+        {
+            if (m_invalidated_propositions.size() > max_num_invalidated_propositions)
+            {
+                m_statistics.num_touched_propositions += m_invalidated_propositions.size();
+                ++m_statistics.num_fallbacks;
+                return false;
+            }
+
+            const auto& proposition = get_propositions()[m_invalidated_propositions[i]];
+
+            boost::hana::for_each(proposition.is_precondition_of(),
+                                  [this](auto&& pair)
+                                  {
+                                      using KeyType = typename decltype(+boost::hana::first(pair))::type;
+                                      const auto& structures = get<KeyType>(get_structures());
+
+                                      for (const auto structure_index : boost::hana::second(pair))
+                                      {
+                                          const auto& structure = structures[structure_index];
+                                          const auto effect_proposition_index = get_effect_proposition_index(structure);
+
+                                          if (!m_is_invalidated.get(effect_proposition_index)
+                                              && m_supporters[effect_proposition_index] == get_supporter_index(structure))
+                                          {
+                                              invalidate(effect_proposition_index);
+                                          }
+                                      }
+                                  });
+        }
+
+        m_statistics.num_touched_propositions += m_invalidated_propositions.size();
+
+        /* Initialize the queue with the added propositions and the invalidated propositions that remain supported. */
+
+        m_queue.clear();
+
+        for (const auto proposition_index : m_added_propositions)
+        {
+            const auto& proposition = get_propositions()[proposition_index];
+
+            self().initialize_or_annotations_impl(proposition);
+            self().initialize_or_annotations_and_queue_impl(proposition);
+            m_supporters[proposition_index] = MAX_INDEX;
+            m_depths[proposition_index] = 0;
+        }
+
+        for (const auto proposition_index : m_invalidated_propositions)
+        {
+            if (get_cost(get_proposition_annotations()[proposition_index]) == 0)
+                continue;
+
+            boost::hana::for_each(m_is_effect_of,
+                                  [this, proposition_index](auto&& pair)
+                                  {
+                                      using KeyType = typename decltype(+boost::hana::first(pair))::type;
+                                      const auto& structures = get<KeyType>(get_structures());
+
+                                      for (const auto structure_index : boost::hana::second(pair)[proposition_index])
+                                      {
+                                          recompute_structure(structures[structure_index]);
+                                      }
+                                  });
+        }
+
+        /* Propagate the decreased costs. */
+
+        while (!m_queue.empty())
+        {
+            const auto entry = m_queue.top_entry();
+            m_queue.pop();
+
+            const auto& proposition = get_propositions()[entry.proposition_index];
+
+            if (get_queue_key(entry.proposition_index) < entry.get_key())
+            {
+                continue;
+            }
+
+            ++m_statistics.num_touched_propositions;
+
+            boost::hana::for_each(proposition.is_precondition_of(),
+                                  [this](auto&& pair)
+                                  {
+                                      using KeyType = typename decltype(+boost::hana::first(pair))::type;
+                                      const auto& structures = get<KeyType>(get_structures());
+
+                                      for (const auto structure_index : boost::hana::second(pair))
+                                      {
+                                          recompute_structure(structures[structure_index]);
+                                      }
+                                  });
+        }
+
+        return true;
+    }
+
+    /// @brief Call the callback on each action in the graph of best supporters of the goal propositions.
+    /// The graph is acyclic because the key of a proposition is larger than the keys of the preconditions of its best supporter.
+    template<typename Callback>
+    void for_each_best_supporter_action(Callback&& callback)
+    {
+        m_is_visited.unset_all();
+        m_visit_stack.clear();
+
+        const auto on_proposition = [this](const Proposition& proposition)
+        {
+            if (!m_is_visited.get(proposition.get_index()))
+            {
+                m_is_visited.set(proposition.get_index());
+                m_visit_stack.push_back(proposition.get_index());
+            }
+        };
+
+        for (const auto proposition_index : get_goal_propositions())
+        {
+            on_proposition(get_propositions()[proposition_index]);
+        }
+
+        const auto num_actions = get<Action>(get_structures()).size();
+
+        while (!m_visit_stack.empty())
+        {
+            const auto supporter_index = m_supporters[m_visit_stack.back()];
+            m_visit_stack.pop_back();
+
+            if (supporter_index == MAX_INDEX)
+                continue;
+
+            if (supporter_index < num_actions)
+            {
+                const auto& action = get<Action>(get_structures())[supporter_index];
+                for_each_precondition_proposition(action, on_proposition);
+                callback(action);
+            }
+            else
+            {
+                for_each_precondition_proposition(get<Axiom>(get_structures())[supporter_index - num_actions], on_proposition);
+            }
+        }
+    }
+
+    void store_previous_state(const State& state)
+    {
+        auto& previous_fluent_atoms = get<formalism::FluentTag>(m_previous_atoms);
+        auto& previous_derived_atoms = get<formalism::DerivedTag>(m_previous_atoms);
+
+        previous_fluent_atoms.assign(state.get_atoms<formalism::FluentTag>().begin(), state.get_atoms<formalism::FluentTag>().end());
+        previous_derived_atoms.assign(state.get_atoms<formalism::DerivedTag>().begin(), state.get_atoms<formalism::DerivedTag>().end());
+        m_has_previous_state = true;
+    }
+
+    void count_unsatisfied_goals()
+    {
+        m_num_unsat_goals = 0;
+        for (const auto proposition_index : m_goal_propositions)
+        {
+            if (get_cost(get_proposition_annotations()[proposition_index]) == MAX_DISCRETE_COST)
+            {
+                ++m_num_unsat_goals;
+            }
+        }
+    }
+
     formalism::Problem m_problem;
 
     const formalism::ProblemImpl& get_problem() const { return *m_problem; }
@@ -337,17 +817,41 @@ private:
 
     struct QueueEntry
     {
-        using KeyType = DiscreteCost;
+        using KeyType = std::pair<DiscreteCost, size_t>;
         using ItemType = Index;
 
-        KeyType cost;
+        DiscreteCost cost;
+        size_t depth;
         ItemType proposition_index;
 
-        KeyType get_key() const { return cost; }
+        KeyType get_key() const { return { cost, depth }; }
         ItemType get_item() const { return proposition_index; }
     };
 
     PriorityQueue<QueueEntry> m_queue;
+
+    /* Incremental evaluation */
+
+    bool m_enable_incremental_evaluation;
+
+    IndexList m_supporters;        ///< The best supporter of each proposition, or MAX_INDEX if it is true in the first layer or unreachable.
+    std::vector<size_t> m_depths;  ///< The depth of each proposition, which breaks ties in cost.
+
+    HanaContainer<std::vector<IndexList>, Action, Axiom> m_is_effect_of;
+
+    bool m_has_previous_state;
+    AtomIndicesContainer m_previous_atoms;  ///< The atoms of the previously evaluated state.
+
+    IndexList m_added_propositions;
+    IndexList m_removed_propositions;
+    IndexList m_invalidated_propositions;
+    FlatBitset m_is_invalidated;
+
+    /* Memory for reuse */
+    FlatBitset m_is_visited;
+    IndexList m_visit_stack;
+
+    Statistics m_statistics;
 };
 
 }
@@ -26,9 +26,10 @@ namespace mimir::search
 class SetAddHeuristicImpl : public rpg::RelaxedPlanningGraph<SetAddHeuristicImpl>
 {
 public:
-    explicit SetAddHeuristicImpl(const DeleteRelaxedProblemExplorator& delete_relaxation);
+    /// @param enable_incremental_evaluation repairs the annotations of the previously evaluated state instead of recomputing them.
+    explicit SetAddHeuristicImpl(const DeleteRelaxedProblemExplorator& delete_relaxation, bool enable_incremental_evaluation = false);
 
-    static SetAddHeuristic create(const DeleteRelaxedProblemExplorator& delete_relaxation);
+    static SetAddHeuristic create(const DeleteRelaxedProblemExplorator& delete_relaxation, bool enable_incremental_evaluation = false);
 
 private:
     /// @brief Initialize "And"-structure node annotations.
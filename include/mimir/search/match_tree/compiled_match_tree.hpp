@@ -0,0 +1,86 @@
+/*
+ * Copyright (C) 2023 Dominik Drexler and Simon Stahlberg
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef MIMIR_SEARCH_MATCH_TREE_COMPILED_MATCH_TREE_HPP_
+#define MIMIR_SEARCH_MATCH_TREE_COMPILED_MATCH_TREE_HPP_
+
+#include "mimir/common/types.hpp"
+#include "mimir/formalism/declarations.hpp"
+#include "mimir/search/declarations.hpp"
+#include "mimir/search/match_tree/declarations.hpp"
+
+#include <cstdint>
+#include <type_traits>
+
+namespace mimir::search::match_tree
+{
+
+enum class CompiledNodeKind : uint8_t
+{
+    FLUENT_ATOM = 0,
+    DERIVED_ATOM = 1,
+    NUMERIC_CONSTRAINT = 2,
+    PERFECT_GENERATOR = 3,
+    IMPERFECT_GENERATOR = 4,
+};
+
+/// @brief `CompiledNode` is a plain node of a `CompiledMatchTree`.
+///
+/// Selector nodes store the index of the atom, or the position of the numeric constraint, and the positions of their children.
+/// Missing children are set to `MAX_INDEX`. Generator nodes store the range [first, last) of their elements.
+struct CompiledNode
+{
+    CompiledNodeKind kind;
+    Index selector;  ///< The atom index, the constraint position, or the first element position.
+    Index true_child;
+    Index false_child;
+    Index dontcare_child;
+
+    Index get_first_element() const { return selector; }
+    Index get_last_element() const { return true_child; }
+};
+
+static_assert(std::is_trivially_copyable_v<CompiledNode>);
+
+/// @brief `CompiledMatchTree` lowers a match tree into a contiguous breadth-first array of `CompiledNode`
+/// such that the elements of each generator node are stored contiguously.
+///
+/// The evaluation is a non-virtual loop that visits the nodes in the same order as the original tree,
+/// meaning that both representations generate the same sequence of applicable elements.
+template<formalism::HasConjunctiveCondition E>
+class CompiledMatchTree
+{
+private:
+    std::vector<CompiledNode> m_nodes;
+    std::vector<const E*> m_elements;
+    formalism::GroundNumericConstraintList m_constraints;
+
+    std::vector<Index> m_evaluate_stack;  ///< temporary during evaluation.
+
+public:
+    explicit CompiledMatchTree(const Node<E>& root);
+
+    void generate_applicable_elements_iteratively(const UnpackedStateImpl& state, std::vector<const E*>& out_applicable_elements);
+
+    const std::vector<CompiledNode>& get_nodes() const;
+    const std::vector<const E*>& get_elements() const;
+    const formalism::GroundNumericConstraintList& get_constraints() const;
+};
+
+}
+
+#endif
@@ -80,6 +80,10 @@ class ElementGeneratorNode_Perfect;
 template<formalism::HasConjunctiveCondition E>
 class ElementGeneratorNode_Imperfect;
 
+struct CompiledNode;
+template<formalism::HasConjunctiveCondition E>
+class CompiledMatchTree;
+
 template<formalism::HasConjunctiveCondition E>
 class INodeScoreFunction;
 
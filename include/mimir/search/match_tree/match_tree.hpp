@@ -20,12 +20,15 @@
 
 #include "mimir/formalism/ground_action.hpp"
 #include "mimir/formalism/ground_axiom.hpp"
+#include "mimir/search/match_tree/compiled_match_tree.hpp"
 #include "mimir/search/match_tree/declarations.hpp"
 #include "mimir/search/match_tree/node_splitters/interface.hpp"
 #include "mimir/search/match_tree/nodes/interface.hpp"
 #include "mimir/search/match_tree/options.hpp"
 #include "mimir/search/match_tree/statistics.hpp"
 
+#include <optional>
+
 namespace mimir::search::match_tree
 {
 /* MatchTree */
@@ -36,7 +39,8 @@ private:
     std::vector<const E*> m_elements;  ///< ATTENTION: must remain persistent. Swapping elements is allowed.
     Options m_options;
 
-    Node<E> m_root;
+    Node<E> m_root;  ///< Released after compilation.
+    std::optional<CompiledMatchTree<E>> m_compiled_tree;
     Statistics m_statistics;
 
     std::vector<const INode<E>*> m_evaluate_stack;  ///< temporary during evaluation.
@@ -45,6 +49,8 @@ private:
 
     MatchTreeImpl(const formalism::Repositories& pddl_repositories, std::vector<const E*> elements, const Options& options = Options());
 
+    void compile();
+
 public:
     static std::unique_ptr<MatchTreeImpl<E>>
     create(const formalism::Repositories& pddl_repositories, std::vector<const E*> elements, const Options& options = Options());
@@ -57,7 +63,11 @@ public:
 
     void generate_applicable_elements_iteratively(const UnpackedStateImpl& state, std::vector<const E*>& out_applicable_elements);
 
+    /// @brief Get the elements of the match tree.
+    const std::vector<const E*>& get_elements() const;
     const Statistics& get_statistics() const;
+    /// @brief Get the compiled tree, or nullptr if compilation is disabled.
+    const CompiledMatchTree<E>* get_compiled_tree() const;
 };
 
 }
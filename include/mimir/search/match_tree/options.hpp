@@ -31,6 +31,7 @@ struct Options
     SplitStrategyEnum split_strategy = SplitStrategyEnum::DYNAMIC;
     SplitMetricEnum split_metric = SplitMetricEnum::FREQUENCY;
     OptimizationDirectionEnum optimization_direction = OptimizationDirectionEnum::MAXIMIZE;
+    bool enable_compilation = true;  ///< Lower the match tree into a flat array of nodes that is evaluated without virtual calls.
 };
 
 }
@@ -19,6 +19,7 @@
 #define MIMIR_SEARCH_OPENLISTS_HPP_
 
 #include "mimir/search/openlists/alternating.hpp"
+#include "mimir/search/openlists/bucket_queue.hpp"
 #include "mimir/search/openlists/priority_queue.hpp"
 
 #endif
@@ -22,10 +22,13 @@
 #include "mimir/search/openlists/interface.hpp"
 #include "mimir/search/openlists/priority_queue.hpp"
 
+#include <algorithm>
 #include <array>
 #include <cassert>
 #include <iostream>
 #include <queue>
+#include <stdexcept>
+#include <vector>
 
 namespace mimir::search
 {
@@ -137,6 +140,113 @@ private:
     size_t m_count;
 };
 
+/// @brief `DynamicAlternatingOpenList` alternates between a number of open lists of the same type that is chosen at runtime,
+/// e.g., one open list per heuristic and one for the successors reached by preferred actions.
+///
+/// The open lists take turns: `top` selects the nonempty open list with the lowest priority, where ties are broken by the index,
+/// and `pop` increases its priority by one. Decreasing the priority of an open list with `boost` makes it take the next turns,
+/// e.g., the open lists of preferred successors after the search made progress (Richter and Helmert, 2009).
+template<IsOpenList O>
+class DynamicAlternatingOpenList
+{
+public:
+    using EntryType = typename O::EntryType;
+    using ItemType = typename O::ItemType;
+
+private:
+    void select_nonempty_queue()
+    {
+        m_pos = m_queues.size();
+        for (size_t i = 0; i < m_queues.size(); ++i)
+        {
+            if (!m_queues[i].empty() && (m_pos == m_queues.size() || m_priorities[i] < m_priorities[m_pos]))
+            {
+                m_pos = i;
+            }
+        }
+    }
+
+public:
+    explicit DynamicAlternatingOpenList(size_t num_queues) : m_queues(num_queues), m_priorities(num_queues, 0), m_pos(num_queues)
+    {
+        if (num_queues == 0)
+        {
+            throw std::invalid_argument("DynamicAlternatingOpenList::DynamicAlternatingOpenList: Expected at least one open list.");
+        }
+    }
+
+    void insert(size_t index, EntryType entry)
+    {
+        assert(index < m_queues.size());
+
+        m_queues[index].insert(std::move(entry));
+    }
+
+    ItemType top()
+    {
+        assert(!empty());
+
+        select_nonempty_queue();
+
+        return m_queues[m_pos].top();
+    }
+
+    /// @brief Pop the item of the open list that was selected by the last call to `top`.
+    void pop()
+    {
+        assert(m_pos < m_queues.size() && !m_queues[m_pos].empty());
+
+        m_queues[m_pos].pop();
+        ++m_priorities[m_pos];
+    }
+
+    /// @brief Decrease the priority of an open list such that it takes the next turns.
+    void boost(size_t index, size_t amount)
+    {
+        assert(index < m_queues.size());
+
+        m_priorities[index] -= static_cast<int64_t>(amount);
+    }
+
+    void clear()
+    {
+        for (auto& queue : m_queues)
+        {
+            queue.clear();
+        }
+        std::fill(m_priorities.begin(), m_priorities.end(), 0);
+        m_pos = m_queues.size();
+    }
+
+    bool empty() const
+    {
+        return std::all_of(m_queues.begin(), m_queues.end(), [](auto&& queue) { return queue.empty(); });
+    }
+
+    std::size_t size() const
+    {
+        auto result = size_t(0);
+        for (const auto& queue : m_queues)
+        {
+            result += queue.size();
+        }
+        return result;
+    }
+
+    /**
+     * Getters
+     */
+
+    size_t get_num_queues() const { return m_queues.size(); }
+    const O& get_queue(size_t index) const { return m_queues.at(index); }
+
+private:
+    std::vector<O> m_queues;
+    std::vector<int64_t> m_priorities;
+
+    size_t m_pos;
+};
+
 }
 
 #endif
@@ -0,0 +1,248 @@
+/*
+ * Copyright (C) 2023 Dominik Drexler and Simon Stahlberg
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef MIMIR_SEARCH_OPENLISTS_BUCKET_QUEUE_HPP_
+#define MIMIR_SEARCH_OPENLISTS_BUCKET_QUEUE_HPP_
+
+#include "mimir/search/openlists/interface.hpp"
+#include "mimir/search/openlists/priority_queue.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <vector>
+
+namespace mimir::search
+{
+
+/// @brief An entry of a `BucketQueue` splits its key into a primary key that selects the bucket
+/// and a secondary key that orders the entries within a bucket.
+/// Ordering by the primary key, then the secondary key, and then the tie-breaking of the queue must refine the order by `get_key()`.
+template<typename T>
+concept IsBucketQueueEntry = IsPriorityQueueEntry<T> && requires(const T a) {
+    typename T::SecondaryKeyType;
+    { a.get_primary_key() } -> std::convertible_to<double>;
+    { a.get_secondary_key() } -> std::same_as<typename T::SecondaryKeyType>;
+    requires std::totally_ordered<typename T::SecondaryKeyType>;
+};
+
+enum class BucketTieBreaking
+{
+    FIFO = 0,
+    LIFO = 1,
+};
+
+/// @brief `BucketQueue` is a priority queue for entries with small non-negative integral primary keys.
+///
+/// Entries are stored in an array of buckets indexed by the primary key. Within a bucket, entries are grouped by their secondary key,
+/// which is expected to take few distinct values, and equal keys are ordered by FIFO or LIFO tie-breaking.
+/// Insert and pop take amortized constant time when the number of distinct secondary keys per bucket is small,
+/// but take time linear in the number of sub buckets otherwise. Hence, orders with a high-cardinality secondary key,
+/// such as GBFS breaking ties by g-value, should use `PriorityQueue` instead.
+///
+/// When an entry with a non-integral, negative, or too large primary key is inserted,
+/// the queue falls back to a binary heap ordered by `get_key()` until it is cleared.
+template<IsBucketQueueEntry E, BucketTieBreaking TieBreaking = BucketTieBreaking::FIFO>
+class BucketQueue
+{
+public:
+    using EntryType = E;
+    using KeyType = typename E::KeyType;
+    using ItemType = typename E::ItemType;
+    using SecondaryKeyType = typename E::SecondaryKeyType;
+
+    /// @brief Primary keys at or above this bound trigger the fallback to the heap.
+    static constexpr size_t MAX_NUM_BUCKETS = size_t(1) << 20;
+
+private:
+    /// @brief The entries of a bucket with equal secondary keys in insertion order.
+    /// FIFO tie-breaking pops at `head` and compacts the entries once most of them were popped.
+    struct SubBucket
+    {
+        SecondaryKeyType secondary_key;
+        size_t head;
+        std::vector<E> entries;
+    };
+
+    /// @brief Sub buckets sorted by their secondary key. Empty sub buckets are removed and their storage is reused.
+    using Bucket = std::vector<SubBucket>;
+
+    std::vector<Bucket> m_buckets;
+    size_t m_min_bucket;
+    size_t m_size;
+
+    bool m_use_heap;
+    PriorityQueue<E> m_heap;
+
+    /* Memory for reuse */
+    std::vector<std::vector<E>> m_free_entries;  ///< The storage of removed sub buckets.
+
+    static bool is_bucketable(double primary_key) { return primary_key >= 0. && primary_key < MAX_NUM_BUCKETS && std::floor(primary_key) == primary_key; }
+
+    void insert_into_bucket(E entry, size_t index)
+    {
+        if (index >= m_buckets.size())
+        {
+            m_buckets.resize(index + 1);
+        }
+
+        auto& bucket = m_buckets[index];
+        const auto secondary_key = entry.get_secondary_key();
+        auto it = std::lower_bound(bucket.begin(),
+                                   bucket.end(),
+                                   secondary_key,
+                                   [](const SubBucket& sub_bucket, const SecondaryKeyType& key) { return sub_bucket.secondary_key < key; });
+        if (it == bucket.end() || it->secondary_key != secondary_key)
+        {
+            auto entries = std::vector<E> {};
+            if (!m_free_entries.empty())
+            {
+                entries = std::move(m_free_entries.back());
+                m_free_entries.pop_back();
+            }
+            it = bucket.insert(it, SubBucket { secondary_key, 0, std::move(entries) });
+        }
+        it->entries.push_back(std::move(entry));
+
+        // The size was already incremented.
+        m_min_bucket = (m_size == 1) ? index : std::min(m_min_bucket, index);
+    }
+
+    void fall_back_to_heap()
+    {
+        for (auto& bucket : m_buckets)
+        {
+            for (auto& sub_bucket : bucket)
+            {
+                for (auto it = sub_bucket.entries.begin() + sub_bucket.head; it != sub_bucket.entries.end(); ++it)
+                {
+                    m_heap.insert(std::move(*it));
+                }
+            }
+        }
+        m_buckets.clear();
+        m_min_bucket = 0;
+        m_use_heap = true;
+    }
+
+    const E& front() const
+    {
+        assert(m_min_bucket < m_buckets.size() && !m_buckets[m_min_bucket].empty());
+
+        const auto& sub_bucket = m_buckets[m_min_bucket].front();
+        return (TieBreaking == BucketTieBreaking::FIFO) ? sub_bucket.entries[sub_bucket.head] : sub_bucket.entries.back();
+    }
+
+public:
+    BucketQueue() : m_buckets(), m_min_bucket(0), m_size(0), m_use_heap(false), m_heap(), m_free_entries() {}
+
+    void insert(E entry)
+    {
+        ++m_size;
+
+        if (!m_use_heap)
+        {
+            const auto primary_key = static_cast<double>(entry.get_primary_key());
+            if (is_bucketable(primary_key))
+            {
+                insert_into_bucket(std::move(entry), static_cast<size_t>(primary_key));
+                return;
+            }
+            fall_back_to_heap();
+        }
+        m_heap.insert(std::move(entry));
+    }
+
+    decltype(auto) top() const
+    {
+        assert(!empty());
+        return top_entry().get_item();
+    }
+
+    const E& top_entry() const
+    {
+        assert(!empty());
+        return (m_use_heap) ? m_heap.top_entry() : front();
+    }
+
+    void pop()
+    {
+        assert(!empty());
+
+        --m_size;
+
+        if (m_use_heap)
+        {
+            m_heap.pop();
+            return;
+        }
+
+        auto& bucket = m_buckets[m_min_bucket];
+        auto& sub_bucket = bucket.front();
+        if constexpr (TieBreaking == BucketTieBreaking::FIFO)
+        {
+            ++sub_bucket.head;
+        }
+        else
+        {
+            sub_bucket.entries.pop_back();
+        }
+
+        if (sub_bucket.head == sub_bucket.entries.size())
+        {
+            sub_bucket.entries.clear();
+            m_free_entries.push_back(std::move(sub_bucket.entries));
+            bucket.erase(bucket.begin());
+        }
+        else if (sub_bucket.head > sub_bucket.entries.size() / 2)
+        {
+            // Compacting after more than half of the entries were popped takes amortized constant time per pop.
+            sub_bucket.entries.erase(sub_bucket.entries.begin(), sub_bucket.entries.begin() + sub_bucket.head);
+            sub_bucket.head = 0;
+        }
+
+        // Advance to the next nonempty bucket. Empty trailing buckets are kept for reuse.
+        while (m_min_bucket < m_buckets.size() && m_buckets[m_min_bucket].empty())
+        {
+            ++m_min_bucket;
+        }
+        if (m_size == 0)
+        {
+            m_min_bucket = 0;
+        }
+    }
+
+    void clear()
+    {
+        m_buckets.clear();
+        m_min_bucket = 0;
+        m_size = 0;
+        m_use_heap = false;
+        m_heap.clear();
+    }
+
+    bool empty() const { return m_size == 0; }
+
+    std::size_t size() const { return m_size; }
+
+    /// @brief Return true if the queue fell back to the binary heap.
+    bool uses_heap() const { return m_use_heap; }
+};
+
+}
+
+#endif
@@ -56,6 +56,7 @@ public:
     using SatisficingBindingGenerator<ActionSatisficingBindingGenerator>::create_ground_conjunction_generator;
     using SatisficingBindingGenerator<ActionSatisficingBindingGenerator>::get_event_handler;
     using SatisficingBindingGenerator<ActionSatisficingBindingGenerator>::get_static_consistency_graph;
+    using SatisficingBindingGenerator<ActionSatisficingBindingGenerator>::get_full_consistency_graph;
 
     ActionSatisficingBindingGenerator(formalism::Action action, formalism::Problem problem, EventHandler event_handler = nullptr);
 
@@ -39,6 +39,7 @@ public:
     using SatisficingBindingGenerator<AxiomSatisficingBindingGenerator>::create_ground_conjunction_generator;
     using SatisficingBindingGenerator<AxiomSatisficingBindingGenerator>::get_event_handler;
     using SatisficingBindingGenerator<AxiomSatisficingBindingGenerator>::get_static_consistency_graph;
+    using SatisficingBindingGenerator<AxiomSatisficingBindingGenerator>::get_full_consistency_graph;
 
     AxiomSatisficingBindingGenerator(formalism::Axiom axiom, formalism::Problem problem, EventHandler event_handler = nullptr);
 };
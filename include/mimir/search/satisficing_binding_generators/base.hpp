@@ -61,6 +61,19 @@ public:
                              const formalism::NumericAssignmentSet<formalism::StaticTag>& static_numeric_assignment_set,
                              const formalism::NumericAssignmentSet<formalism::FluentTag>& fluent_numeric_assignment_set);
 
+    /// @brief Generate the bindings that map each parameter whose entry in `partial_binding` is not `MAX_INDEX` to the object with that index.
+    ///
+    /// Only the cliques of the consistency graph that contain the vertices of the bound parameters are enumerated,
+    /// e.g., to generate the bindings for which a literal is satisfied by a given atom.
+    /// @param partial_binding maps each parameter index to an object index or `MAX_INDEX`, and must outlive the generator.
+    mimir::generator<formalism::ObjectList>
+    create_binding_generator(const UnpackedStateImpl& unpacked_state,
+                             const formalism::AssignmentSet<formalism::FluentTag>& fluent_assignment_set,
+                             const formalism::AssignmentSet<formalism::DerivedTag>& derived_assignment_set,
+                             const formalism::NumericAssignmentSet<formalism::StaticTag>& static_numeric_assignment_set,
+                             const formalism::NumericAssignmentSet<formalism::FluentTag>& fluent_numeric_assignment_set,
+                             const IndexList& partial_binding);
+
     mimir::generator<std::pair<formalism::ObjectList,
                                std::tuple<formalism::GroundLiteralList<formalism::StaticTag>,
                                           formalism::GroundLiteralList<formalism::FluentTag>,
@@ -81,6 +94,8 @@ public:
     const formalism::Problem& get_problem() const;
     const EventHandler& get_event_handler() const;
     const formalism::StaticConsistencyGraph& get_static_consistency_graph() const;
+    /// @brief Get the adjacency matrix of the consistency graph of the most recent state for which bindings of arity at least two were generated.
+    const BitMatrix& get_full_consistency_graph() const;
 
 protected:
     formalism::ConjunctiveCondition m_conjunctive_condition;
@@ -90,15 +105,35 @@ protected:
     formalism::StaticConsistencyGraph m_static_consistency_graph;
 
     /* Memory for reuse */
-    formalism::GroundAtomList<formalism::FluentTag> m_fluent_atoms;
-    formalism::GroundAtomList<formalism::DerivedTag> m_derived_atoms;
     formalism::GroundFunctionList<formalism::FluentTag> m_fluent_functions;
     formalism::AssignmentSet<formalism::FluentTag> m_fluent_assignment_set;
     formalism::AssignmentSet<formalism::DerivedTag> m_derived_assignment_set;
     formalism::NumericAssignmentSet<formalism::FluentTag> m_numeric_assignment_set;
-    std::vector<boost::dynamic_bitset<>> m_full_consistency_graph;
+    BitMatrix m_full_consistency_graph;
     boost::dynamic_bitset<> m_consistent_vertices;
 
+    /* Incremental consistency graph construction */
+    std::vector<IndexList> m_fluent_predicate_to_vertices;   ///< The vertices whose fluent literals mention the predicate.
+    std::vector<IndexList> m_fluent_predicate_to_edges;      ///< The edges whose fluent literals mention the predicate.
+    std::vector<IndexList> m_derived_predicate_to_vertices;  ///< The vertices whose derived literals mention the predicate.
+    std::vector<IndexList> m_derived_predicate_to_edges;     ///< The edges whose derived literals mention the predicate.
+    std::vector<IndexList> m_vertex_to_edges;                ///< The edges incident to the vertex.
+    bool m_has_numeric_constraints;                          ///< True iff some numeric constraint must be tested on vertices or edges.
+    bool m_has_full_consistency_graph;                       ///< True iff the consistency graph corresponds to the previous atoms.
+    FlatBitset m_previous_fluent_atoms;
+    FlatBitset m_previous_derived_atoms;
+    FlatDoubleList m_previous_numeric_variables;
+    boost::dynamic_bitset<> m_consistent_edges;  ///< The result of testing the edge, which is only meaningful if the edge is tested.
+    boost::dynamic_bitset<> m_tested_edges;      ///< True iff the edge was tested since the last change of its predicates.
+    boost::dynamic_bitset<> m_dirty_vertices;
+    boost::dynamic_bitset<> m_touched_edges;
+    IndexList m_changed_fluent_predicates;
+    IndexList m_changed_derived_predicates;
+
+    /* Partial bindings */
+    std::vector<IndexList> m_parameter_object_to_vertex;  ///< The vertex of the parameter and object, or MAX_INDEX if there is none.
+    std::vector<BitMatrix::Block> m_candidate_vertices;
+
     /// @brief Helper to cast to Derived_.
     constexpr const auto& self() const { return static_cast<const Derived_&>(*this); }
     constexpr auto& self() { return static_cast<Derived_&>(*this); }
@@ -115,6 +150,27 @@ protected:
 
     bool is_valid_binding(const UnpackedStateImpl& unpacked_state, const formalism::ObjectList& binding);
 
+    template<formalism::IsFluentOrDerivedTag P>
+    void initialize_predicate_to_elements(std::vector<IndexList>& out_predicate_to_vertices, std::vector<IndexList>& out_predicate_to_edges);
+
+    void mark_changed_predicates(const IndexList& changed_predicates,
+                                 const std::vector<IndexList>& predicate_to_vertices,
+                                 const std::vector<IndexList>& predicate_to_edges);
+
+    /// @brief Test all vertices and edges from scratch.
+    void build_full_consistency_graph(const formalism::AssignmentSet<formalism::FluentTag>& fluent_assignment_sets,
+                                      const formalism::AssignmentSet<formalism::DerivedTag>& derived_assignment_sets,
+                                      const formalism::NumericAssignmentSet<formalism::StaticTag>& static_numeric_assignment_set,
+                                      const formalism::NumericAssignmentSet<formalism::FluentTag>& fluent_numeric_assignment_set);
+
+    /// @brief Retest only the vertices and edges whose literals mention a predicate of an atom that changed since the previous call.
+    /// Falls back to `build_full_consistency_graph` if there is no previous graph, the numeric variables changed, or the difference is large.
+    void update_full_consistency_graph(const UnpackedStateImpl& unpacked_state,
+                                       const formalism::AssignmentSet<formalism::FluentTag>& fluent_assignment_sets,
+                                       const formalism::AssignmentSet<formalism::DerivedTag>& derived_assignment_sets,
+                                       const formalism::NumericAssignmentSet<formalism::StaticTag>& static_numeric_assignment_set,
+                                       const formalism::NumericAssignmentSet<formalism::FluentTag>& fluent_numeric_assignment_set);
+
     mimir::generator<formalism::ObjectList> nullary_case(const UnpackedStateImpl& unpacked_state);
 
     mimir::generator<formalism::ObjectList> unary_case(const UnpackedStateImpl& unpacked_state,
@@ -128,6 +184,13 @@ protected:
                                                          const formalism::AssignmentSet<formalism::DerivedTag>& derived_assignment_sets,
                                                          const formalism::NumericAssignmentSet<formalism::StaticTag>& static_numeric_assignment_set,
                                                          const formalism::NumericAssignmentSet<formalism::FluentTag>& fluent_numeric_assignment_set);
+
+    mimir::generator<formalism::ObjectList> partial_case(const UnpackedStateImpl& unpacked_state,
+                                                         const formalism::AssignmentSet<formalism::FluentTag>& fluent_assignment_sets,
+                                                         const formalism::AssignmentSet<formalism::DerivedTag>& derived_assignment_sets,
+                                                         const formalism::NumericAssignmentSet<formalism::StaticTag>& static_numeric_assignment_set,
+                                                         const formalism::NumericAssignmentSet<formalism::FluentTag>& fluent_numeric_assignment_set,
+                                                         const IndexList& partial_binding);
 };
 
 }
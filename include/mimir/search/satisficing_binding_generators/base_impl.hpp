@@ -18,15 +18,21 @@
 #ifndef MIMIR_SEARCH_SATISFICING_BINDING_GENERATOR_BASE_IMPL_HPP_
 #define MIMIR_SEARCH_SATISFICING_BINDING_GENERATOR_BASE_IMPL_HPP_
 
+#include "mimir/formalism/atom.hpp"
+#include "mimir/formalism/conjunctive_condition.hpp"
 #include "mimir/formalism/consistency_graph.hpp"
 #include "mimir/formalism/declarations.hpp"
 #include "mimir/formalism/domain.hpp"
 #include "mimir/formalism/effects.hpp"
+#include "mimir/formalism/ground_atom.hpp"
 #include "mimir/formalism/literal.hpp"
+#include "mimir/formalism/numeric_constraint.hpp"
 #include "mimir/formalism/object.hpp"
+#include "mimir/formalism/predicate.hpp"
 #include "mimir/formalism/problem.hpp"
 #include "mimir/formalism/repositories.hpp"
 #include "mimir/formalism/tags.hpp"
+#include "mimir/formalism/term.hpp"
 #include "mimir/formalism/variable.hpp"
 #include "mimir/search/applicability.hpp"
 #include "mimir/search/declarations.hpp"
@@ -35,6 +41,8 @@
 #include "mimir/search/satisficing_binding_generators/event_handlers/interface.hpp"
 #include "mimir/search/state.hpp"
 
+#include <algorithm>
+#include <bit>
 #include <boost/dynamic_bitset/dynamic_bitset.hpp>
 
 namespace mimir::search
@@ -48,12 +56,58 @@ namespace mimir::search
  * Helpers
  */
 
-inline void clear_full_consistency_graph(std::vector<boost::dynamic_bitset<>>& full_consistency_graph)
+/// @brief Return true iff the vertex or edge is consistent with the fluent, derived, and numeric conditions under the given assignment sets.
+template<typename Element>
+inline bool is_dynamically_consistent(const Element& element,
+                                      formalism::ConjunctiveCondition conjunctive_condition,
+                                      const formalism::AssignmentSet<formalism::FluentTag>& fluent_assignment_sets,
+                                      const formalism::AssignmentSet<formalism::DerivedTag>& derived_assignment_sets,
+                                      const formalism::NumericAssignmentSet<formalism::StaticTag>& static_numeric_assignment_set,
+                                      const formalism::NumericAssignmentSet<formalism::FluentTag>& fluent_numeric_assignment_set)
 {
-    for (auto& row : full_consistency_graph)
+    return element.consistent_literals(conjunctive_condition->get_literals<formalism::FluentTag>(), fluent_assignment_sets)
+           && element.consistent_literals(conjunctive_condition->get_literals<formalism::DerivedTag>(), derived_assignment_sets)
+           && element.consistent_literals(conjunctive_condition->get_numeric_constraints(), static_numeric_assignment_set, fluent_numeric_assignment_set);
+}
+
+/// @brief Collect the sorted predicate indices of the atoms in the symmetric difference of `atoms` and `previous_atoms`.
+/// @return the size of the symmetric difference.
+template<formalism::IsFluentOrDerivedTag P>
+inline size_t collect_changed_predicates(const FlatBitset& atoms,
+                                         const FlatBitset& previous_atoms,
+                                         const formalism::Repositories& repositories,
+                                         IndexList& out_changed_predicates)
+{
+    const auto& blocks = atoms.blocks();
+    const auto& previous_blocks = previous_atoms.blocks();
+    const auto num_blocks = std::max(blocks.size(), previous_blocks.size());
+    const auto get_block = [](const auto& bitset_blocks, size_t i) { return (i < bitset_blocks.size()) ? bitset_blocks[i] : uint64_t(0); };
+
+    out_changed_predicates.clear();
+    auto num_changes = size_t(0);
+    for (size_t i = 0; i < num_blocks; ++i)
     {
-        row.reset();
+        for (auto bits = get_block(blocks, i) ^ get_block(previous_blocks, i); bits; bits &= bits - 1)
+        {
+            const auto atom_index = i * 64 + std::countr_zero(bits);
+            out_changed_predicates.push_back(repositories.get_ground_atom<P>(atom_index)->get_predicate()->get_index());
+            ++num_changes;
+        }
     }
+    std::sort(out_changed_predicates.begin(), out_changed_predicates.end());
+    out_changed_predicates.erase(std::unique(out_changed_predicates.begin(), out_changed_predicates.end()), out_changed_predicates.end());
+
+    return num_changes;
+}
+
+/// @brief Return true iff the two lists of numeric variables are identical, where undefined values compare equal.
+inline bool are_identical(const FlatDoubleList& lhs, const FlatDoubleList& rhs)
+{
+    return std::equal(lhs.begin(),
+                      lhs.end(),
+                      rhs.begin(),
+                      rhs.end(),
+                      [](double left, double right) { return std::bit_cast<uint64_t>(left) == std::bit_cast<uint64_t>(right); });
 }
 
 /**
@@ -177,19 +231,111 @@ SatisficingBindingGenerator<Derived_>::unary_case(const UnpackedStateImpl& unpac
 }
 
 template<typename Derived_>
-mimir::generator<formalism::ObjectList>
-SatisficingBindingGenerator<Derived_>::general_case(const UnpackedStateImpl& unpacked_state,
-                                                    const formalism::AssignmentSet<formalism::FluentTag>& fluent_assignment_sets,
-                                                    const formalism::AssignmentSet<formalism::DerivedTag>& derived_assignment_sets,
-                                                    const formalism::NumericAssignmentSet<formalism::StaticTag>& static_numeric_assignment_set,
-                                                    const formalism::NumericAssignmentSet<formalism::FluentTag>& fluent_numeric_assignment_set)
+template<formalism::IsFluentOrDerivedTag P>
+void SatisficingBindingGenerator<Derived_>::initialize_predicate_to_elements(std::vector<IndexList>& out_predicate_to_vertices,
+                                                                             std::vector<IndexList>& out_predicate_to_edges)
 {
-    if (m_static_consistency_graph.get_edges().size() == 0)
+    const auto& vertices = m_static_consistency_graph.get_vertices();
+    const auto& edges = m_static_consistency_graph.get_edges();
+
+    for (const auto& literal : m_conjunctive_condition->get_literals<P>())
     {
-        co_return;
+        const auto predicate = literal->get_atom()->get_predicate();
+        const auto arity = predicate->get_arity();
+        const auto predicate_index = predicate->get_index();
+
+        /* Over-approximate the vertices and edges for which `consistent_literals` reads the assignment set of the literal:
+           a term mentions them if it is a constant or a variable whose parameter index is the one of an endpoint. */
+        auto has_object = false;
+        auto parameter_indices = IndexList {};
+        for (const auto& term : literal->get_atom()->get_terms())
+        {
+            if (const auto variable = std::get_if<formalism::Variable>(&term->get_variant()))
+            {
+                parameter_indices.push_back((*variable)->get_parameter_index());
+            }
+            else
+            {
+                has_object = true;
+            }
+        }
+        const auto mentions = [&](const formalism::StaticConsistencyGraph::Vertex& vertex)
+        { return has_object || std::find(parameter_indices.begin(), parameter_indices.end(), vertex.get_parameter_index()) != parameter_indices.end(); };
+
+        if (predicate_index >= out_predicate_to_vertices.size())
+        {
+            out_predicate_to_vertices.resize(predicate_index + 1);
+            out_predicate_to_edges.resize(predicate_index + 1);
+        }
+
+        if (arity >= 1 && (literal->get_polarity() || arity == 1))
+        {
+            for (const auto& vertex : vertices)
+            {
+                if (mentions(vertex))
+                {
+                    out_predicate_to_vertices[predicate_index].push_back(vertex.get_index());
+                }
+            }
+        }
+
+        if (arity >= 2 && (literal->get_polarity() || arity == 2))
+        {
+            for (Index edge_index = 0; edge_index < edges.size(); ++edge_index)
+            {
+                if (mentions(edges[edge_index].get_src()) || mentions(edges[edge_index].get_dst()))
+                {
+                    out_predicate_to_edges[predicate_index].push_back(edge_index);
+                }
+            }
+        }
+    }
+
+    /* Several literals can share the predicate. */
+    for (auto& indices : out_predicate_to_vertices)
+    {
+        std::sort(indices.begin(), indices.end());
+        indices.erase(std::unique(indices.begin(), indices.end()), indices.end());
+    }
+    for (auto& indices : out_predicate_to_edges)
+    {
+        std::sort(indices.begin(), indices.end());
+        indices.erase(std::unique(indices.begin(), indices.end()), indices.end());
+    }
+}
+
+template<typename Derived_>
+void SatisficingBindingGenerator<Derived_>::mark_changed_predicates(const IndexList& changed_predicates,
+                                                                    const std::vector<IndexList>& predicate_to_vertices,
+                                                                    const std::vector<IndexList>& predicate_to_edges)
+{
+    for (const auto predicate_index : changed_predicates)
+    {
+        if (predicate_index >= predicate_to_vertices.size())
+        {
+            continue;  ///< The condition does not mention the predicate.
+        }
+
+        for (const auto vertex_index : predicate_to_vertices[predicate_index])
+        {
+            m_dirty_vertices.set(vertex_index);
+        }
+        for (const auto edge_index : predicate_to_edges[predicate_index])
+        {
+            m_tested_edges.reset(edge_index);
+            m_touched_edges.set(edge_index);
+        }
     }
+}
 
-    clear_full_consistency_graph(m_full_consistency_graph);
+template<typename Derived_>
+void SatisficingBindingGenerator<Derived_>::build_full_consistency_graph(
+    const formalism::AssignmentSet<formalism::FluentTag>& fluent_assignment_sets,
+    const formalism::AssignmentSet<formalism::DerivedTag>& derived_assignment_sets,
+    const formalism::NumericAssignmentSet<formalism::StaticTag>& static_numeric_assignment_set,
+    const formalism::NumericAssignmentSet<formalism::FluentTag>& fluent_numeric_assignment_set)
+{
+    m_full_consistency_graph.reset();
 
     /* Build the full consistency graph.
        Restricts statically consistent assignments based on the assignments in the current state and builds the consistency graph as an adjacency matrix
@@ -201,30 +347,159 @@ SatisficingBindingGenerator<Derived_>::general_case(const UnpackedStateImpl& unp
     m_consistent_vertices.reset();
     for (const auto& vertex : m_static_consistency_graph.get_vertices())
     {
-        if (vertex.consistent_literals(m_conjunctive_condition->get_literals<formalism::FluentTag>(), fluent_assignment_sets)
-            && vertex.consistent_literals(m_conjunctive_condition->get_literals<formalism::DerivedTag>(), derived_assignment_sets)
-            && vertex.consistent_literals(m_conjunctive_condition->get_numeric_constraints(), static_numeric_assignment_set, fluent_numeric_assignment_set))
+        if (is_dynamically_consistent(vertex,
+                                      m_conjunctive_condition,
+                                      fluent_assignment_sets,
+                                      derived_assignment_sets,
+                                      static_numeric_assignment_set,
+                                      fluent_numeric_assignment_set))
         {
             m_consistent_vertices.set(vertex.get_index());
         }
     }
 
-    for (const auto& edge : m_static_consistency_graph.get_edges())
+    // Edges with an inconsistent vertex remain untested until the vertex becomes consistent in an incremental update.
+    m_tested_edges.reset();
+    const auto& edges = m_static_consistency_graph.get_edges();
+    for (Index edge_index = 0; edge_index < edges.size(); ++edge_index)
+    {
+        const auto& edge = edges[edge_index];
+        const auto first_index = edge.get_src().get_index();
+        const auto second_index = edge.get_dst().get_index();
+
+        if (m_consistent_vertices.test(first_index) && m_consistent_vertices.test(second_index))
+        {
+            const auto consistent = is_dynamically_consistent(edge,
+                                                              m_conjunctive_condition,
+                                                              fluent_assignment_sets,
+                                                              derived_assignment_sets,
+                                                              static_numeric_assignment_set,
+                                                              fluent_numeric_assignment_set);
+            m_tested_edges.set(edge_index);
+            m_consistent_edges[edge_index] = consistent;
+            m_full_consistency_graph.set(first_index, second_index, consistent);
+            m_full_consistency_graph.set(second_index, first_index, consistent);
+        }
+    }
+}
+
+template<typename Derived_>
+void SatisficingBindingGenerator<Derived_>::update_full_consistency_graph(
+    const UnpackedStateImpl& unpacked_state,
+    const formalism::AssignmentSet<formalism::FluentTag>& fluent_assignment_sets,
+    const formalism::AssignmentSet<formalism::DerivedTag>& derived_assignment_sets,
+    const formalism::NumericAssignmentSet<formalism::StaticTag>& static_numeric_assignment_set,
+    const formalism::NumericAssignmentSet<formalism::FluentTag>& fluent_numeric_assignment_set)
+{
+    const auto& repositories = m_problem->get_repositories();
+    const auto& fluent_atoms = unpacked_state.get_atoms<formalism::FluentTag>();
+    const auto& derived_atoms = unpacked_state.get_atoms<formalism::DerivedTag>();
+    const auto& numeric_variables = unpacked_state.get_numeric_variables();
+
+    const auto num_fluent_changes =
+        collect_changed_predicates<formalism::FluentTag>(fluent_atoms, m_previous_fluent_atoms, repositories, m_changed_fluent_predicates);
+    const auto num_derived_changes =
+        collect_changed_predicates<formalism::DerivedTag>(derived_atoms, m_previous_derived_atoms, repositories, m_changed_derived_predicates);
+    const auto num_changes = num_fluent_changes + num_derived_changes;
+    const auto numeric_changed = m_has_numeric_constraints && !are_identical(numeric_variables, m_previous_numeric_variables);
+
+    m_previous_fluent_atoms = fluent_atoms;
+    m_previous_derived_atoms = derived_atoms;
+    if (m_has_numeric_constraints)
+    {
+        m_previous_numeric_variables = numeric_variables;
+    }
+
+    /* Rebuild if there is no previous graph, if we cannot attribute the difference to predicates, or if the difference is larger than the state. */
+
+    if (!m_has_full_consistency_graph || numeric_changed || num_changes > fluent_atoms.count() + derived_atoms.count())
+    {
+        build_full_consistency_graph(fluent_assignment_sets, derived_assignment_sets, static_numeric_assignment_set, fluent_numeric_assignment_set);
+        m_has_full_consistency_graph = true;
+        return;
+    }
+
+    if (num_changes == 0)
+    {
+        return;
+    }
+
+    /* Retest the vertices that mention a changed predicate. Edges of vertices whose consistency flips must be updated in the adjacency matrix. */
+
+    m_dirty_vertices.reset();
+    m_touched_edges.reset();
+    mark_changed_predicates(m_changed_fluent_predicates, m_fluent_predicate_to_vertices, m_fluent_predicate_to_edges);
+    mark_changed_predicates(m_changed_derived_predicates, m_derived_predicate_to_vertices, m_derived_predicate_to_edges);
+
+    const auto& vertices = m_static_consistency_graph.get_vertices();
+    for (auto vertex_index = m_dirty_vertices.find_first(); vertex_index != boost::dynamic_bitset<>::npos;
+         vertex_index = m_dirty_vertices.find_next(vertex_index))
+    {
+        const auto consistent = is_dynamically_consistent(vertices[vertex_index],
+                                                          m_conjunctive_condition,
+                                                          fluent_assignment_sets,
+                                                          derived_assignment_sets,
+                                                          static_numeric_assignment_set,
+                                                          fluent_numeric_assignment_set);
+
+        if (consistent != m_consistent_vertices.test(vertex_index))
+        {
+            m_consistent_vertices[vertex_index] = consistent;
+            for (const auto edge_index : m_vertex_to_edges[vertex_index])
+            {
+                m_touched_edges.set(edge_index);
+            }
+        }
+    }
+
+    /* Retest the touched edges with consistent vertices that were not tested since the last change of their predicates. */
+
+    const auto& edges = m_static_consistency_graph.get_edges();
+    for (auto edge_index = m_touched_edges.find_first(); edge_index != boost::dynamic_bitset<>::npos; edge_index = m_touched_edges.find_next(edge_index))
     {
-        if (m_consistent_vertices.test(edge.get_src().get_index()) && m_consistent_vertices.test(edge.get_dst().get_index())
-            && edge.consistent_literals(m_conjunctive_condition->get_literals<formalism::FluentTag>(), fluent_assignment_sets)
-            && edge.consistent_literals(m_conjunctive_condition->get_literals<formalism::DerivedTag>(), derived_assignment_sets)
-            && edge.consistent_literals(m_conjunctive_condition->get_numeric_constraints(), static_numeric_assignment_set, fluent_numeric_assignment_set))
+        const auto& edge = edges[edge_index];
+        const auto first_index = edge.get_src().get_index();
+        const auto second_index = edge.get_dst().get_index();
+
+        auto consistent = false;
+        if (m_consistent_vertices.test(first_index) && m_consistent_vertices.test(second_index))
         {
-            const auto first_index = edge.get_src().get_index();
-            const auto second_index = edge.get_dst().get_index();
-            auto& first_row = m_full_consistency_graph[first_index];
-            auto& second_row = m_full_consistency_graph[second_index];
-            first_row[second_index] = 1;
-            second_row[first_index] = 1;
+            if (!m_tested_edges.test(edge_index))
+            {
+                m_consistent_edges[edge_index] = is_dynamically_consistent(edge,
+                                                                           m_conjunctive_condition,
+                                                                           fluent_assignment_sets,
+                                                                           derived_assignment_sets,
+                                                                           static_numeric_assignment_set,
+                                                                           fluent_numeric_assignment_set);
+                m_tested_edges.set(edge_index);
+            }
+            consistent = m_consistent_edges.test(edge_index);
         }
+        m_full_consistency_graph.set(first_index, second_index, consistent);
+        m_full_consistency_graph.set(second_index, first_index, consistent);
+    }
+}
+
+template<typename Derived_>
+mimir::generator<formalism::ObjectList>
+SatisficingBindingGenerator<Derived_>::general_case(const UnpackedStateImpl& unpacked_state,
+                                                    const formalism::AssignmentSet<formalism::FluentTag>& fluent_assignment_sets,
+                                                    const formalism::AssignmentSet<formalism::DerivedTag>& derived_assignment_sets,
+                                                    const formalism::NumericAssignmentSet<formalism::StaticTag>& static_numeric_assignment_set,
+                                                    const formalism::NumericAssignmentSet<formalism::FluentTag>& fluent_numeric_assignment_set)
+{
+    if (m_static_consistency_graph.get_edges().size() == 0)
+    {
+        co_return;
     }
 
+    update_full_consistency_graph(unpacked_state,
+                                  fluent_assignment_sets,
+                                  derived_assignment_sets,
+                                  static_numeric_assignment_set,
+                                  fluent_numeric_assignment_set);
+
     // Find all cliques of size num_parameters whose labels denote complete assignments that might yield an applicable precondition. The relatively few
     // atoms in the state (compared to the number of possible atoms) lead to very sparse graphs, so the number of maximal cliques of maximum size (#
     // parameters) tends to be very small.
@@ -256,6 +531,108 @@ SatisficingBindingGenerator<Derived_>::general_case(const UnpackedStateImpl& unp
     }
 }
 
+template<typename Derived_>
+mimir::generator<formalism::ObjectList>
+SatisficingBindingGenerator<Derived_>::partial_case(const UnpackedStateImpl& unpacked_state,
+                                                    const formalism::AssignmentSet<formalism::FluentTag>& fluent_assignment_sets,
+                                                    const formalism::AssignmentSet<formalism::DerivedTag>& derived_assignment_sets,
+                                                    const formalism::NumericAssignmentSet<formalism::StaticTag>& static_numeric_assignment_set,
+                                                    const formalism::NumericAssignmentSet<formalism::FluentTag>& fluent_numeric_assignment_set,
+                                                    const IndexList& partial_binding)
+{
+    const auto& problem = *m_problem;
+    const auto& pddl_repositories = problem.get_repositories();
+
+    const auto& vertices = m_static_consistency_graph.get_vertices();
+    const auto& partitions = m_static_consistency_graph.get_vertices_by_parameter_index();
+
+    /* Restrict the candidates of each bound parameter to the vertex of its object. */
+
+    const auto set_candidate = [this](Index vertex_index)
+    { m_candidate_vertices[vertex_index / BitMatrix::BITS_PER_BLOCK] |= BitMatrix::Block(1) << (vertex_index % BitMatrix::BITS_PER_BLOCK); };
+
+    std::fill(m_candidate_vertices.begin(), m_candidate_vertices.end(), BitMatrix::Block(0));
+    for (Index parameter_index = 0; parameter_index < partial_binding.size(); ++parameter_index)
+    {
+        const auto object_index = partial_binding[parameter_index];
+        if (object_index == MAX_INDEX)
+        {
+            for (const auto vertex_index : partitions[parameter_index])
+            {
+                set_candidate(vertex_index);
+            }
+        }
+        else
+        {
+            const auto vertex_index = m_parameter_object_to_vertex[parameter_index][object_index];
+            if (vertex_index == MAX_INDEX)
+            {
+                co_return;  ///< The object violates a static literal.
+            }
+            set_candidate(vertex_index);
+        }
+    }
+
+    /* The single parameter is bound. */
+
+    if (partial_binding.size() == 1)
+    {
+        const auto& vertex = vertices[m_parameter_object_to_vertex[0][partial_binding[0]]];
+        if (is_dynamically_consistent(vertex,
+                                      m_conjunctive_condition,
+                                      fluent_assignment_sets,
+                                      derived_assignment_sets,
+                                      static_numeric_assignment_set,
+                                      fluent_numeric_assignment_set))
+        {
+            auto binding = formalism::ObjectList { pddl_repositories.get_object(vertex.get_object_index()) };
+
+            if (is_valid_binding(unpacked_state, binding))
+            {
+                co_yield std::move(binding);
+            }
+            else
+            {
+                m_event_handler->on_invalid_binding(binding, problem);
+            }
+        }
+        co_return;
+    }
+
+    /* Enumerate the cliques among the candidates. */
+
+    if (m_static_consistency_graph.get_edges().size() == 0)
+    {
+        co_return;
+    }
+
+    update_full_consistency_graph(unpacked_state,
+                                  fluent_assignment_sets,
+                                  derived_assignment_sets,
+                                  static_numeric_assignment_set,
+                                  fluent_numeric_assignment_set);
+
+    for (const auto& clique : create_k_clique_in_k_partite_graph_generator(m_full_consistency_graph, partitions, m_candidate_vertices))
+    {
+        auto binding = formalism::ObjectList(clique.size());
+
+        for (std::size_t index = 0; index < clique.size(); ++index)
+        {
+            const auto& vertex = vertices[clique[index]];
+            binding[vertex.get_parameter_index()] = problem.get_problem_and_domain_objects()[vertex.get_object_index()];
+        }
+
+        if (is_valid_binding(unpacked_state, binding))
+        {
+            co_yield std::move(binding);
+        }
+        else
+        {
+            m_event_handler->on_invalid_binding(binding, problem);
+        }
+    }
+}
+
 template<typename Derived_>
 SatisficingBindingGenerator<Derived_>::SatisficingBindingGenerator(formalism::ConjunctiveCondition conjunctive_condition,
                                                                    formalism::Problem problem,
@@ -264,15 +641,47 @@ SatisficingBindingGenerator<Derived_>::SatisficingBindingGenerator(formalism::Co
     m_problem(std::move(problem)),
     m_event_handler(event_handler ? event_handler : std::make_shared<DefaultEventHandlerImpl>()),
     m_static_consistency_graph(*m_problem, 0, m_conjunctive_condition->get_parameters().size(), m_conjunctive_condition->get_literals<formalism::StaticTag>()),
-    m_fluent_atoms(),
-    m_derived_atoms(),
     m_fluent_functions(),
     m_fluent_assignment_set(m_problem->get_problem_and_domain_objects().size(), m_problem->get_domain()->get_predicates<formalism::FluentTag>()),
     m_derived_assignment_set(m_problem->get_problem_and_domain_objects().size(), m_problem->get_problem_and_domain_derived_predicates()),
     m_numeric_assignment_set(m_problem->get_problem_and_domain_objects().size(), m_problem->get_domain()->get_function_skeletons<formalism::FluentTag>()),
-    m_full_consistency_graph(m_static_consistency_graph.get_vertices().size(), boost::dynamic_bitset<>(m_static_consistency_graph.get_vertices().size())),
-    m_consistent_vertices(m_static_consistency_graph.get_vertices().size())
+    m_full_consistency_graph(m_static_consistency_graph.get_vertices().size()),
+    m_consistent_vertices(m_static_consistency_graph.get_vertices().size()),
+    m_fluent_predicate_to_vertices(),
+    m_fluent_predicate_to_edges(),
+    m_derived_predicate_to_vertices(),
+    m_derived_predicate_to_edges(),
+    m_vertex_to_edges(m_static_consistency_graph.get_vertices().size()),
+    m_has_numeric_constraints(std::any_of(m_conjunctive_condition->get_numeric_constraints().begin(),
+                                          m_conjunctive_condition->get_numeric_constraints().end(),
+                                          [](auto&& constraint) { return constraint->get_terms().size() > 0; })),
+    m_has_full_consistency_graph(false),
+    m_previous_fluent_atoms(),
+    m_previous_derived_atoms(),
+    m_previous_numeric_variables(),
+    m_consistent_edges(m_static_consistency_graph.get_edges().size()),
+    m_tested_edges(m_static_consistency_graph.get_edges().size()),
+    m_dirty_vertices(m_static_consistency_graph.get_vertices().size()),
+    m_touched_edges(m_static_consistency_graph.get_edges().size()),
+    m_changed_fluent_predicates(),
+    m_changed_derived_predicates(),
+    m_parameter_object_to_vertex(m_conjunctive_condition->get_arity(), IndexList(m_problem->get_problem_and_domain_objects().size(), MAX_INDEX)),
+    m_candidate_vertices(m_full_consistency_graph.get_num_blocks_per_row(), BitMatrix::Block(0))
 {
+    initialize_predicate_to_elements<formalism::FluentTag>(m_fluent_predicate_to_vertices, m_fluent_predicate_to_edges);
+    initialize_predicate_to_elements<formalism::DerivedTag>(m_derived_predicate_to_vertices, m_derived_predicate_to_edges);
+
+    const auto& edges = m_static_consistency_graph.get_edges();
+    for (Index edge_index = 0; edge_index < edges.size(); ++edge_index)
+    {
+        m_vertex_to_edges[edges[edge_index].get_src().get_index()].push_back(edge_index);
+        m_vertex_to_edges[edges[edge_index].get_dst().get_index()].push_back(edge_index);
+    }
+
+    for (const auto& vertex : m_static_consistency_graph.get_vertices())
+    {
+        m_parameter_object_to_vertex[vertex.get_parameter_index()][vertex.get_object_index()] = vertex.get_index();
+    }
 }
 
 template<typename Derived_>
@@ -317,6 +726,35 @@ SatisficingBindingGenerator<Derived_>::create_binding_generator(const UnpackedSt
     }
 }
 
+template<typename Derived_>
+mimir::generator<formalism::ObjectList>
+SatisficingBindingGenerator<Derived_>::create_binding_generator(const UnpackedStateImpl& unpacked_state,
+                                                                const formalism::AssignmentSet<formalism::FluentTag>& fluent_assignment_set,
+                                                                const formalism::AssignmentSet<formalism::DerivedTag>& derived_assignment_set,
+                                                                const formalism::NumericAssignmentSet<formalism::StaticTag>& static_numeric_assignment_set,
+                                                                const formalism::NumericAssignmentSet<formalism::FluentTag>& fluent_numeric_assignment_set,
+                                                                const IndexList& partial_binding)
+{
+    assert(nullary_conditions_hold(m_conjunctive_condition, unpacked_state));
+    assert(partial_binding.size() == m_conjunctive_condition->get_arity());
+
+    if (std::all_of(partial_binding.begin(), partial_binding.end(), [](auto&& object_index) { return object_index == MAX_INDEX; }))
+    {
+        return create_binding_generator(unpacked_state,
+                                        fluent_assignment_set,
+                                        derived_assignment_set,
+                                        static_numeric_assignment_set,
+                                        fluent_numeric_assignment_set);
+    }
+
+    return partial_case(unpacked_state,
+                        fluent_assignment_set,
+                        derived_assignment_set,
+                        static_numeric_assignment_set,
+                        fluent_numeric_assignment_set,
+                        partial_binding);
+}
+
 template<typename Derived_>
 mimir::generator<std::pair<formalism::ObjectList,
                            std::tuple<formalism::GroundLiteralList<formalism::StaticTag>,
@@ -347,13 +785,8 @@ SatisficingBindingGenerator<Derived_>::create_ground_conjunction_generator(const
         co_return;
     }
 
-    pddl_repositories.get_ground_atoms_from_indices(dense_fluent_atoms, m_fluent_atoms);
-    m_fluent_assignment_set.reset();
-    m_fluent_assignment_set.insert_ground_atoms(m_fluent_atoms);
-
-    pddl_repositories.get_ground_atoms_from_indices(dense_derived_atoms, m_derived_atoms);
-    m_derived_assignment_set.reset();
-    m_derived_assignment_set.insert_ground_atoms(m_derived_atoms);
+    m_fluent_assignment_set.update_ground_atoms(dense_fluent_atoms, pddl_repositories);
+    m_derived_assignment_set.update_ground_atoms(dense_derived_atoms, pddl_repositories);
 
     m_numeric_assignment_set.reset();
     pddl_repositories.get_ground_functions(dense_numeric_variables.size(), m_fluent_functions);
@@ -409,6 +842,12 @@ const formalism::StaticConsistencyGraph& SatisficingBindingGenerator<Derived_>::
 {
     return m_static_consistency_graph;
 }
+
+template<typename Derived_>
+const BitMatrix& SatisficingBindingGenerator<Derived_>::get_full_consistency_graph() const
+{
+    return m_full_consistency_graph;
+}
 }
 
 #endif
@@ -37,6 +37,7 @@ public:
     using SatisficingBindingGenerator<ConjunctiveConditionSatisficingBindingGenerator>::create_ground_conjunction_generator;
     using SatisficingBindingGenerator<ConjunctiveConditionSatisficingBindingGenerator>::get_event_handler;
     using SatisficingBindingGenerator<ConjunctiveConditionSatisficingBindingGenerator>::get_static_consistency_graph;
+    using SatisficingBindingGenerator<ConjunctiveConditionSatisficingBindingGenerator>::get_full_consistency_graph;
 
     ConjunctiveConditionSatisficingBindingGenerator(formalism::ConjunctiveCondition conjunctive_condition,
                                                     formalism::Problem problem,
@@ -43,9 +43,10 @@ public:
     struct Options
     {
         SearchMode mode;
+        bool concurrent;  ///< Make the state repository thread-safe, e.g., to share the problem between the workers of a parallel search.
 
-        Options() : mode(SearchMode::GROUNDED) {}
-        explicit Options(SearchMode mode) : mode(mode) {}
+        Options() : mode(SearchMode::GROUNDED), concurrent(false) {}
+        explicit Options(SearchMode mode, bool concurrent = false) : mode(mode), concurrent(concurrent) {}
     };
 
     /// @brief Construction from `ProblemImpl` construction API.
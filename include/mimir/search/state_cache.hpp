@@ -0,0 +1,99 @@
+/*
+ * Copyright (C) 2023 Dominik Drexler and Simon Stahlberg
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef MIMIR_SEARCH_STATE_CACHE_HPP_
+#define MIMIR_SEARCH_STATE_CACHE_HPP_
+
+#include "mimir/common/types.hpp"
+#include "mimir/search/declarations.hpp"
+#include "mimir/search/state.hpp"
+
+#include <absl/container/flat_hash_map.h>
+#include <cstdint>
+#include <optional>
+#include <utility>
+#include <vector>
+
+namespace mimir::search
+{
+
+/// @brief `IndexedPackedState` is a packed state together with its index in the `StateRepositoryImpl`.
+/// It allows to retrieve a state without a lookup in the state map.
+struct IndexedPackedState
+{
+    Index index = MAX_INDEX;
+    PackedState packed_state = nullptr;
+};
+
+/// @brief `UnpackedStateCache` keeps a bounded number of recently generated states together with their unpacked states.
+///
+/// A state that is expanded shortly after it was generated can be taken from the cache instead of being unpacked again.
+/// Eviction follows the CLOCK policy, an approximation of LRU that marks entries on access and evicts the first unmarked entry.
+/// Evicted unpacked states are returned to the `SharedObjectPool` of the repository once no other `State` refers to them.
+/// The cache is not thread-safe.
+class UnpackedStateCache
+{
+private:
+    struct Slot
+    {
+        std::optional<State> state;
+        bool referenced;
+    };
+
+    size_t m_capacity;
+    std::vector<Slot> m_slots;
+    std::vector<size_t> m_free_slots;
+    absl::flat_hash_map<Index, size_t> m_slot_by_state;
+    size_t m_hand;
+
+    size_t find_victim_slot();
+
+    static State unpack(const IndexedPackedState& state, StateRepositoryImpl& state_repository);
+
+public:
+    /// @brief Create a cache for at most `capacity` states. A capacity of 0 disables the cache.
+    explicit UnpackedStateCache(size_t capacity);
+
+    /// @brief Insert the `state`, possibly evicting another state.
+    /// If the state is already cached, then it is marked as recently used.
+    void insert(const State& state);
+
+    /// @brief Remove and return the state with the given `index` if it is cached.
+    std::optional<State> extract(Index index);
+
+    /// @brief Return the cached state if possible, and otherwise let the `state_repository` unpack it.
+    /// The lookup is reported to the `event_handler` as a hit or a miss.
+    template<typename EventHandler>
+    State extract_or_unpack(const IndexedPackedState& state, StateRepositoryImpl& state_repository, EventHandler& event_handler)
+    {
+        auto cached_state = extract(state.index);
+        event_handler.on_lookup_unpacked_state(cached_state.has_value());
+        return cached_state ? std::move(cached_state.value()) : unpack(state, state_repository);
+    }
+
+    /// @brief Return true if the state with the given `index` is cached.
+    bool contains(Index index) const;
+
+    void clear();
+
+    size_t size() const;
+    size_t capacity() const;
+};
+
+}
+
+#endif
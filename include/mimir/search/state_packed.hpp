@@ -26,9 +26,13 @@
 #include "mimir/search/state_unpacked.hpp"
 
 #include <absl/container/node_hash_map.h>
+#include <array>
+#include <atomic>
 #include <loki/details/utils/equal_to.hpp>
 #include <loki/details/utils/hash.hpp>
 #include <memory>
+#include <mutex>
+#include <ranges>
 #include <valla/indexed_hash_set.hpp>
 #include <valla/plain/swiss.hpp>
 
@@ -135,6 +139,74 @@ namespace mimir::search
 using PackedStateImplMap = absl::node_hash_map<PackedStateImpl, Index, loki::Hash<PackedStateImpl>, loki::EqualTo<PackedStateImpl>>;
 
 static_assert(sizeof(PackedStateImplMap::value_type) == 28);
+
+/// @brief `ConcurrentPackedStateImplMap` is a map from packed states to indices enumerated 0,1,2,... that can be switched to thread-safe insertion.
+///
+/// By default, the map is sequential: all entries are kept in a single shard and no lock is taken.
+/// After `enable_concurrency`, the map is lock-striped and indices are assigned only after a packed state was found to be missing in its shard,
+/// such that they remain dense.
+/// Entries are never erased and their addresses are stable, also when switching modes,
+/// such that pointers to entries remain valid without holding a lock.
+class ConcurrentPackedStateImplMap
+{
+public:
+    using value_type = PackedStateImplMap::value_type;
+
+    static constexpr size_t NUM_SHARDS = 64;
+
+private:
+    struct alignas(64) Shard
+    {
+        mutable std::mutex mutex;
+        PackedStateImplMap map;
+    };
+
+    std::array<Shard, NUM_SHARDS> m_shards;
+    std::atomic<Index> m_size;
+    bool m_concurrent;
+
+    static size_t get_shard_index(const PackedStateImpl& state);
+
+public:
+    ConcurrentPackedStateImplMap();
+    // Uncopieable and unmoveable to avoid dangling pointers to entries.
+    ConcurrentPackedStateImplMap(const ConcurrentPackedStateImplMap& other) = delete;
+    ConcurrentPackedStateImplMap& operator=(const ConcurrentPackedStateImplMap& other) = delete;
+    ConcurrentPackedStateImplMap(ConcurrentPackedStateImplMap&& other) = delete;
+    ConcurrentPackedStateImplMap& operator=(ConcurrentPackedStateImplMap&& other) = delete;
+
+    /// @brief Switch to thread-safe lookup and insertion by distributing the entries over all shards.
+    /// Must not be called concurrently with any other member function. Indices and addresses of entries remain unchanged.
+    void enable_concurrency();
+
+    bool is_concurrent() const;
+
+    /// @brief Find the entry of the given packed state. Thread-safe if `enable_concurrency` was called.
+    /// @param state is the packed state.
+    /// @return a pointer to the entry if it exists, and nullptr otherwise.
+    const value_type* find(const PackedStateImpl& state) const;
+
+    /// @brief Get the entry of the given packed state. Thread-safe if `enable_concurrency` was called.
+    /// Throws std::out_of_range if the packed state does not exist.
+    /// @param state is the packed state.
+    /// @return the entry.
+    const value_type& at(const PackedStateImpl& state) const;
+
+    /// @brief Insert the packed state with the next free index if it does not exist yet. Thread-safe if `enable_concurrency` was called.
+    /// @param state is the packed state.
+    /// @return a pointer to the entry and whether it was newly created.
+    std::pair<const value_type*, bool> emplace(const PackedStateImpl& state);
+
+    /// @brief Return a view over all entries.
+    /// Not thread-safe with concurrent calls to `emplace`.
+    auto range() const
+    {
+        return m_shards | std::views::transform([](const Shard& shard) -> const PackedStateImplMap& { return shard.map; }) | std::views::join;
+    }
+
+    size_t size() const;
+    size_t capacity() const;
+};
 }
 
 #endif
@@ -25,25 +25,65 @@
 #include "mimir/search/state.hpp"
 #include "mimir/search/state_unpacked.hpp"
 
+#include <absl/container/flat_hash_map.h>
+#include <mutex>
+#include <thread>
+#include <valla/plain/swiss.hpp>
+
 namespace mimir::search
 {
 
+/// @brief `StateRepositoryImpl` creates and stores states.
+///
+/// By default, the repository is sequential and takes no locks.
+/// After `enable_concurrency`, the state map is lock-striped, the tree tables of the problem are concurrent, and scratch buffers are thread-local.
+/// A `State` holds memory from a pool of the thread that created it and hence must only be copied and destroyed by that thread.
+/// Axiom evaluation is serialized within the repository, and the reached atoms are updated under a lock when a new state is created.
+///
+/// The repositories of the problem that store ground atoms, axioms, and actions are NOT thread-safe.
+/// Lifted axiom evaluation grounds derived atoms and axioms into them when a state is created, and so does lifted applicable action generation.
+/// Hence, if the problem has axioms, callers must serialize state creation with every other call that may ground into the problem,
+/// e.g., with a mutex that also guards `IApplicableActionGenerator::create_applicable_action_generator`.
+/// Without axioms, state creation does not ground, and only the calls that ground need to be serialized.
+/// Lookups of existing states with `get_state` never ground.
 class StateRepositoryImpl : public std::enable_shared_from_this<StateRepositoryImpl>
 {
 private:
     AxiomEvaluator m_axiom_evaluator;  ///< The axiom evaluator.
+    std::mutex m_axiom_evaluator_mutex;
 
-    PackedStateImplMap m_states;  ///< Stores all created extended states.
+    ConcurrentPackedStateImplMap m_states;  ///< Stores all created extended states.
 
     FlatBitset m_reached_fluent_atoms;   ///< Stores all encountered fluent atoms.
     FlatBitset m_reached_derived_atoms;  ///< Stores all encountered derived atoms.
+    std::mutex m_reached_atoms_mutex;
+
+    bool m_concurrent;
 
     /* Memory for reuse */
 
-    FlatBitset m_applied_positive_effect_atoms;
-    FlatBitset m_applied_negative_effect_atoms;
+    struct SuccessorBuffers
+    {
+        IndexList applied_negative_effect_atoms;
+        IndexList applied_positive_effect_atoms;
+        IndexList added_fluent_atoms;
+        IndexList deleted_fluent_atoms;
+        IndexList changed_numeric_variables;
+        valla::plain::swiss::DeltaWorkspace<Index> delta_workspace;
+    };
+
+    SuccessorBuffers m_successor_buffers;                        ///< Used in sequential mode.
+    SharedObjectPool<UnpackedStateImpl> m_unpacked_state_pool;  ///< Used in sequential mode.
+
+    uint64_t m_id;  ///< Identifies the repository in thread-local caches.
+    std::mutex m_unpacked_state_pools_mutex;
+    absl::flat_hash_map<std::thread::id, std::unique_ptr<SharedObjectPool<UnpackedStateImpl>>> m_unpacked_state_pools;  ///< Used in concurrent mode.
 
-    SharedObjectPool<UnpackedStateImpl> m_unpacked_state_pool;
+    SharedObjectPool<UnpackedStateImpl>& get_unpacked_state_pool();
+    SuccessorBuffers& get_successor_buffers();
+    std::unique_lock<std::mutex> lock_if_concurrent(std::mutex& mutex);
+
+    void update_reached_atoms(const UnpackedStateImpl& unpacked_state);
 
 public:
     explicit StateRepositoryImpl(AxiomEvaluator axiom_evaluator);
@@ -55,6 +95,11 @@ public:
     StateRepositoryImpl(StateRepositoryImpl&& other) = delete;
     StateRepositoryImpl& operator=(StateRepositoryImpl&& other) = delete;
 
+    /// @brief Make the creation and lookup of states thread-safe, including the tree tables of the problem.
+    /// Must be called before the repository is shared between threads. States created before remain valid.
+    /// The repositories of the problem remain sequential: see the class documentation for the calls that callers must serialize.
+    void enable_concurrency();
+
     /// @brief Get or create the initial state of the underlying problem.
     /// @return the initial state and its associated metric value, which is 0 in the case of :action-costs.
     std::pair<State, ContinuousCost> get_or_create_initial_state();
@@ -79,6 +124,20 @@ public:
     /// @return the state.
     State get_state(const PackedStateImpl& state);
 
+    /// @brief Get the state with the given index and packed state.
+    /// This operation unpacks the state but skips the lookup of the index.
+    /// @param index is the index of the state.
+    /// @param state is the packed state stored in this repository.
+    /// @return the state.
+    State get_state(Index index, PackedState state);
+
+    /// @brief Get or create the state for a packed state that may have been created by another repository over the same problem.
+    /// Packed states are comparable across repositories because the underlying tree tables are owned by the problem.
+    /// This operation unpacks the state.
+    /// @param state is the packed state.
+    /// @return the state.
+    State import_state(const PackedStateImpl& state);
+
     /// @brief Get the index of a given packed state.
     /// This operation has constant time.
     /// @param state is the packed state.
@@ -91,19 +150,23 @@ public:
 
     const formalism::Problem& get_problem() const;
 
+    bool is_concurrent() const;
+
     /// @brief Return the number of created states.
     /// @return the number of created states.
     size_t get_state_count() const;
 
     /// @brief Return the state map.
     /// @return the states map.
-    const PackedStateImplMap& get_states() const;
+    const ConcurrentPackedStateImplMap& get_states() const;
 
     /// @brief Return the reached fluent ground atoms.
+    /// Not thread-safe with concurrent creation of states.
     /// @return a bitset that stores the reached fluent ground atom indices.
     const FlatBitset& get_reached_fluent_ground_atoms_bitset() const;
 
     /// @brief Return the reached derived ground atoms.
+    /// Not thread-safe with concurrent creation of states.
     /// @return a bitset that stores the reached derived ground atom indices.
     const FlatBitset& get_reached_derived_ground_atoms_bitset() const;
 
@@ -0,0 +1,228 @@
+/*
+ * Copyright (C) 2025 Dominik Drexler
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef VALLA_INCLUDE_CONCURRENT_INDEXED_HASH_SET_HPP_
+#define VALLA_INCLUDE_CONCURRENT_INDEXED_HASH_SET_HPP_
+
+#include "valla/declarations.hpp"
+
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cassert>
+#include <limits>
+#include <mutex>
+#include <vector>
+
+namespace valla
+{
+/// @brief `ConcurrentIndexedHashSet` is a variant of `IndexedHashSet` that can be switched to thread-safe insertion.
+///
+/// By default, the set is sequential: all values are kept in a single shard and `insert` takes no lock.
+/// After `enable_concurrency`, the uniqueness check is lock-striped over `NumShards` shards that are selected by the hash of the value.
+/// Indices are assigned only after a value was found to be missing, such that they are enumerated 0,1,2,... without gaps,
+/// even if several threads insert concurrently.
+/// Values are stored in segments of doubling size that are never reallocated,
+/// such that reading the value of an index that was obtained from `insert` requires no lock in either mode.
+template<typename T, std::unsigned_integral I, size_t NumShards = 64>
+class ConcurrentIndexedHashSet
+{
+public:
+    using value_type = T;
+    using index_type = I;
+
+private:
+    static_assert(std::has_single_bit(NumShards), "ConcurrentIndexedHashSet: NumShards must be a power of two.");
+
+    static constexpr size_t FIRST_SEGMENT_BITS = 10;
+    static constexpr size_t FIRST_SEGMENT_SIZE = size_t(1) << FIRST_SEGMENT_BITS;
+    static constexpr size_t NUM_SEGMENTS = std::numeric_limits<I>::digits - FIRST_SEGMENT_BITS + 1;
+
+    struct ShardHash
+    {
+        using is_transparent = void;
+
+        const ConcurrentIndexedHashSet* set = nullptr;
+
+        size_t operator()(I el) const { return Hasher<T> {}(set->operator[](el)); }
+        size_t operator()(const T& el) const { return Hasher<T> {}(el); }
+    };
+
+    struct ShardEqualTo
+    {
+        using is_transparent = void;
+
+        const ConcurrentIndexedHashSet* set = nullptr;
+
+        bool operator()(I lhs, I rhs) const { return lhs == rhs; }
+        bool operator()(I lhs, const T& rhs) const { return set->operator[](lhs) == rhs; }
+        bool operator()(const T& lhs, I rhs) const { return lhs == set->operator[](rhs); }
+    };
+
+    struct alignas(64) Shard
+    {
+        std::mutex mutex;
+        absl::flat_hash_set<I, ShardHash, ShardEqualTo> uniqueness;
+    };
+
+    std::array<std::atomic<T*>, NUM_SEGMENTS> m_segments;
+    std::array<Shard, NumShards> m_shards;
+    std::atomic<size_t> m_size;
+    bool m_concurrent;
+
+    static std::pair<size_t, size_t> get_position(size_t index)
+    {
+        const auto shifted = index + FIRST_SEGMENT_SIZE;
+        const auto segment = std::bit_width(shifted) - 1 - FIRST_SEGMENT_BITS;
+        const auto offset = shifted - (FIRST_SEGMENT_SIZE << segment);
+        return { segment, offset };
+    }
+
+    static size_t get_shard_index(size_t hash) { return (hash ^ (hash >> 32)) & (NumShards - 1); }
+
+    T* get_or_allocate_segment(size_t segment)
+    {
+        auto data = m_segments[segment].load(std::memory_order_acquire);
+
+        if (!data)
+        {
+            auto allocated = new T[FIRST_SEGMENT_SIZE << segment]();
+            if (m_segments[segment].compare_exchange_strong(data, allocated, std::memory_order_acq_rel, std::memory_order_acquire))
+            {
+                data = allocated;
+            }
+            else
+            {
+                delete[] allocated;  ///< Another thread allocated the segment first.
+            }
+        }
+
+        return data;
+    }
+
+    size_t emplace_value(size_t index, const T& value)
+    {
+        assert(index < std::numeric_limits<I>::max() && "ConcurrentIndexedHashSet: Index overflow! The maximum number of slots reached.");
+
+        const auto [segment, offset] = get_position(index);
+        get_or_allocate_segment(segment)[offset] = value;
+
+        return index;
+    }
+
+public:
+    ConcurrentIndexedHashSet() : m_segments(), m_shards(), m_size(0), m_concurrent(false)
+    {
+        for (auto& shard : m_shards)
+        {
+            shard.uniqueness = absl::flat_hash_set<I, ShardHash, ShardEqualTo>(0, ShardHash { this }, ShardEqualTo { this });
+        }
+    }
+    ~ConcurrentIndexedHashSet()
+    {
+        for (auto& segment : m_segments)
+        {
+            delete[] segment.load();
+        }
+    }
+    // Uncopieable and unmoveable to avoid dangling references in hash and equal_to.
+    ConcurrentIndexedHashSet(const ConcurrentIndexedHashSet& other) = delete;
+    ConcurrentIndexedHashSet& operator=(const ConcurrentIndexedHashSet& other) = delete;
+    ConcurrentIndexedHashSet(ConcurrentIndexedHashSet&& other) = delete;
+    ConcurrentIndexedHashSet& operator=(ConcurrentIndexedHashSet&& other) = delete;
+
+    /// @brief Switch to thread-safe insertion by distributing the values over all shards.
+    /// Must not be called concurrently with any other member function. Indices remain unchanged.
+    void enable_concurrency()
+    {
+        if (m_concurrent)
+            return;
+
+        auto& first_shard = m_shards.front().uniqueness;
+        auto indices = std::vector<I>(first_shard.begin(), first_shard.end());
+        first_shard.clear();
+        for (const auto index : indices)
+        {
+            m_shards[get_shard_index(Hasher<T> {}(operator[](index)))].uniqueness.insert(index);
+        }
+
+        m_concurrent = true;
+    }
+
+    bool is_concurrent() const { return m_concurrent; }
+
+    /// @brief Insert the value if it does not exist yet.
+    /// Thread-safe if `enable_concurrency` was called.
+    /// @param value is the value.
+    /// @return the index of the value.
+    I insert(const T& value)
+    {
+        if (!m_concurrent)
+        {
+            const auto it = m_shards.front().uniqueness.lazy_emplace(value,
+                                                                     [&](const auto& ctor)
+                                                                     {
+                                                                         const auto index = m_size.load(std::memory_order_relaxed);
+                                                                         m_size.store(index + 1, std::memory_order_relaxed);
+                                                                         ctor(static_cast<I>(emplace_value(index, value)));
+                                                                     });
+            return *it;
+        }
+
+        auto& shard = m_shards[get_shard_index(Hasher<T> {}(value))];
+
+        std::lock_guard<std::mutex> lock(shard.mutex);
+
+        const auto it = shard.uniqueness.lazy_emplace(value,
+                                                      [&](const auto& ctor)
+                                                      { ctor(static_cast<I>(emplace_value(m_size.fetch_add(1, std::memory_order_relaxed), value))); });
+
+        return *it;
+    }
+
+    /// @brief Access the value of an index that was returned by `insert`. Thread-safe and lock-free.
+    /// @param index is the index.
+    /// @return the value.
+    const T& operator[](I index) const
+    {
+        assert(index < size() && "Index out of bounds");
+
+        const auto [segment, offset] = get_position(index);
+        return m_segments[segment].load(std::memory_order_acquire)[offset];
+    }
+
+    size_t size() const { return m_size.load(std::memory_order_relaxed); }
+
+    size_t mem_usage() const
+    {
+        size_t usage = 0;
+        for (size_t segment = 0; segment < NUM_SEGMENTS; ++segment)
+        {
+            if (m_segments[segment].load())
+                usage += (FIRST_SEGMENT_SIZE << segment) * sizeof(T);
+        }
+        for (const auto& shard : m_shards)
+        {
+            usage += shard.uniqueness.capacity() * (sizeof(I) + 1);
+        }
+        return usage;
+    }
+};
+
+}
+
+#endif
@@ -23,6 +23,7 @@
 #include <absl/container/node_hash_map.h>
 #include <absl/container/node_hash_set.h>
 #include <cassert>
+#include <concepts>
 #include <functional>
 #include <iostream>
 #include <memory>
@@ -72,6 +73,20 @@ constexpr inline Slot<I> get_empty_slot()
     return Slot<I>();
 }
 
+/**
+ * Tables
+ */
+
+/// @brief `IsIndexedTable` is satisfied by tables that map unique values of type `T` to indices of type `I` enumerated 0,1,2,...
+/// and provide the inverse mapping through `operator[]`, e.g., `IndexedHashSet` and `ConcurrentIndexedHashSet`.
+template<typename Table, typename T, typename I>
+concept IsIndexedTable = requires(Table& table, const Table& const_table, const T& value, I index) {
+    typename Table::value_type;
+    typename Table::index_type;
+    { table.insert(value) } -> std::same_as<I>;
+    { const_table[index] } -> std::convertible_to<const T&>;
+};
+
 /**
  * Iterator
  */
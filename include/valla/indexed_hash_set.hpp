@@ -34,6 +34,9 @@ template<typename T, std::unsigned_integral I>
 class IndexedHashSet
 {
 public:
+    using value_type = T;
+    using index_type = I;
+
     IndexedHashSet() : m_slots(), m_uniqueness(0, IndexReferencedHash<T, I>(m_slots), IndexReferencedEqualTo<T, I>(m_slots)) {}
     // Uncopieable and unmoveable to avoid dangling references of m_slots in hash and equal_to.
     IndexedHashSet(const IndexedHashSet& other) = delete;
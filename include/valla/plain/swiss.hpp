@@ -19,6 +19,7 @@
 #define VALLA_INCLUDE_PLAIN_SWISS_HPP_
 
 #include "valla/declarations.hpp"
+#include "valla/concurrent_indexed_hash_set.hpp"
 #include "valla/indexed_hash_set.hpp"
 #include "valla/unique_object_pool.hpp"
 
@@ -27,7 +28,10 @@
 #include <cmath>
 #include <concepts>
 #include <iostream>
+#include <iterator>
+#include <limits>
 #include <stack>
+#include <vector>
 
 namespace valla::plain::swiss
 {
@@ -40,9 +44,9 @@ namespace valla::plain::swiss
  * Insert recursively
  */
 
-template<std::input_iterator Iterator, typename T, std::unsigned_integral I>
-    requires std::same_as<std::iter_value_t<Iterator>, T>
-inline I insert_recursively(Iterator it, Iterator end, I size, IndexedHashSet<Slot<I>, I>& table, IndexedHashSet<T, I>& leaf_table)
+template<std::input_iterator Iterator, std::unsigned_integral I, IsIndexedTable<Slot<I>, I> Table, typename LeafTable>
+    requires IsIndexedTable<LeafTable, std::iter_value_t<Iterator>, I>
+inline I insert_recursively(Iterator it, Iterator end, I size, Table& table, LeafTable& leaf_table)
 {
     /* Base cases */
     if (size == 1)
@@ -66,9 +70,9 @@ inline I insert_recursively(Iterator it, Iterator end, I size, IndexedHashSet<Sl
     return table.insert(Slot<I>(i1, i2));
 }
 
-template<std::ranges::input_range Range, typename T, std::unsigned_integral I>
-    requires std::same_as<std::ranges::range_value_t<Range>, T>
-auto insert(const Range& state, IndexedHashSet<Slot<I>, I>& table, IndexedHashSet<T, I>& leaf_table)
+template<std::ranges::input_range Range, typename Table, typename LeafTable, std::unsigned_integral I = typename Table::index_type>
+    requires IsIndexedTable<Table, Slot<I>, I> && IsIndexedTable<LeafTable, std::ranges::range_value_t<Range>, I>
+auto insert(const Range& state, Table& table, LeafTable& leaf_table)
 {
     // Note: O(1) for random access iterators, and O(N) otherwise by repeatedly calling operator++.
     const auto size = static_cast<I>(std::distance(state.begin(), state.end()));
@@ -79,12 +83,70 @@ auto insert(const Range& state, IndexedHashSet<Slot<I>, I>& table, IndexedHashSe
     return Slot<I>(insert_recursively(state.begin(), state.end(), size, table, leaf_table), size);
 }
 
+/**
+ * Insert with parent
+ */
+
+template<std::random_access_iterator Iterator, std::unsigned_integral I, IsIndexedTable<Slot<I>, I> Table, typename LeafTable, typename Pred>
+    requires IsIndexedTable<LeafTable, std::iter_value_t<Iterator>, I> && std::predicate<Pred&, I, I>
+inline I insert_recursively_with_parent(Iterator it, I pos, I size, I parent_index, Table& table, LeafTable& leaf_table, Pred& is_unchanged)
+{
+    /* Reuse unchanged subtree */
+    if (is_unchanged(pos, pos + size))
+        return parent_index;
+
+    /* Base cases */
+    if (size == 1)
+        return leaf_table.insert(*(it + pos));
+
+    const auto parent_slot = table[parent_index];
+
+    if (size == 2)
+    {
+        const auto i1 = leaf_table.insert(*(it + pos));
+        const auto i2 = leaf_table.insert(*(it + pos + 1));
+        return (i1 == parent_slot.i1 && i2 == parent_slot.i2) ? parent_index : table.insert(Slot<I>(i1, i2));
+    }
+
+    /* Divide */
+    const auto mid = std::bit_floor(size - 1);
+
+    /* Conquer */
+    const auto i1 = insert_recursively_with_parent(it, pos, mid, parent_slot.i1, table, leaf_table, is_unchanged);
+    const auto i2 = insert_recursively_with_parent(it, I(pos + mid), I(size - mid), parent_slot.i2, table, leaf_table, is_unchanged);
+
+    return (i1 == parent_slot.i1 && i2 == parent_slot.i2) ? parent_index : table.insert(Slot<I>(i1, i2));
+}
+
+/// @brief Insert the `state` by reusing the subtrees of the tree of `parent_root` that remain unchanged.
+///
+/// The trees share their shape if and only if the states have equal size. In that case, only the nodes on paths to changed positions
+/// are inserted, where `is_unchanged(first, last)` must return true only if the positions [first, last) hold the same values in both states.
+/// Otherwise, the state is inserted from scratch.
+/// @param state is the state.
+/// @param parent_root is the root slot of the parent state.
+/// @param table is the tree table.
+/// @param leaf_table is the leaf table.
+/// @param is_unchanged is a conservative test for unchanged position ranges.
+/// @return the root slot of the state.
+template<std::ranges::random_access_range Range, typename Table, typename LeafTable, typename Pred, std::unsigned_integral I = typename Table::index_type>
+    requires IsIndexedTable<Table, Slot<I>, I> && IsIndexedTable<LeafTable, std::ranges::range_value_t<Range>, I> && std::predicate<Pred&, I, I>
+auto insert_with_parent(const Range& state, Slot<I> parent_root, Table& table, LeafTable& leaf_table, Pred is_unchanged)
+{
+    const auto size = static_cast<I>(std::ranges::size(state));
+
+    if (size == 0 || size != parent_root.i2)
+        return insert(state, table, leaf_table);
+
+    return Slot<I>(insert_recursively_with_parent(std::ranges::begin(state), I(0), size, parent_root.i1, table, leaf_table, is_unchanged), size);
+}
+
 /**
  * Read recursively
  */
 
-template<typename T, std::unsigned_integral I>
-inline void read_state_recursively(I index, I size, const IndexedHashSet<Slot<I>, I>& table, const IndexedHashSet<T, I>& leaf_table, std::vector<T>& ref_state)
+template<typename T, std::unsigned_integral I, IsIndexedTable<Slot<I>, I> Table, IsIndexedTable<T, I> LeafTable>
+inline void read_state_recursively(I index, I size, const Table& table, const LeafTable& leaf_table, std::vector<T>& ref_state)
 {
     /* Base case */
     if (size == 1)
@@ -111,8 +173,8 @@ inline void read_state_recursively(I index, I size, const IndexedHashSet<Slot<I>
     read_state_recursively(slot.i2, size - mid, table, leaf_table, ref_state);
 }
 
-template<typename T, std::unsigned_integral I>
-inline void read_state(I tree_index, I size, const IndexedHashSet<Slot<I>, I>& table, const IndexedHashSet<T, I>& leaf_table, std::vector<T>& out_state)
+template<typename T, std::unsigned_integral I, IsIndexedTable<Slot<I>, I> Table, IsIndexedTable<T, I> LeafTable>
+inline void read_state(I tree_index, I size, const Table& table, const LeafTable& leaf_table, std::vector<T>& out_state)
 {
     out_state.clear();
 
@@ -127,8 +189,8 @@ inline void read_state(I tree_index, I size, const IndexedHashSet<Slot<I>, I>& t
 /// @param table is the tree table.
 /// @param root_table is the root table.
 /// @param out_state is the output state.
-template<typename T, std::unsigned_integral I>
-inline void read_state(const Slot<I>& root_slot, const IndexedHashSet<Slot<I>, I>& table, const IndexedHashSet<T, I>& leaf_table, std::vector<T>& out_state)
+template<typename T, std::unsigned_integral I, IsIndexedTable<Slot<I>, I> Table, IsIndexedTable<T, I> LeafTable>
+inline void read_state(const Slot<I>& root_slot, const Table& table, const LeafTable& leaf_table, std::vector<T>& out_state)
 {
     /* Observe: a root slot wraps the root tree_index together with the length that defines the tree structure! */
     read_state(root_slot.i1, root_slot.i2, table, leaf_table, out_state);
@@ -138,23 +200,23 @@ inline void read_state(const Slot<I>& root_slot, const IndexedHashSet<Slot<I>, I
  * ConstIterator
  */
 
-template<typename T, std::unsigned_integral I>
+template<typename T, std::unsigned_integral I, typename Table, typename LeafTable>
 class const_iterator
 {
 private:
-    const IndexedHashSet<Slot<I>, I>* m_inner_table;
-    const IndexedHashSet<T, I>* m_leaf_table;
+    const Table* m_inner_table;
+    const LeafTable* m_leaf_table;
     UniqueObjectPoolPtr<std::vector<Entry<I>>> m_inner_stack;
     UniqueObjectPoolPtr<std::vector<T>> m_leaf_stack;
     std::optional<T> m_value;
 
-    const IndexedHashSet<Slot<I>, I>& inner_table() const
+    const Table& inner_table() const
     {
         assert(m_inner_table);
         return *m_inner_table;
     }
 
-    const IndexedHashSet<T, I>& leaf_table() const
+    const LeafTable& leaf_table() const
     {
         assert(m_leaf_table);
         return *m_leaf_table;
@@ -237,7 +299,7 @@ public:
     }
     const_iterator(const_iterator&& other) = default;
     const_iterator& operator=(const_iterator&& other) = default;
-    const_iterator(const IndexedHashSet<Slot<I>, I>& inner_table, const IndexedHashSet<T, I>& leaf_table, const Slot<I>& root_slot, bool begin) :
+    const_iterator(const Table& inner_table, const LeafTable& leaf_table, const Slot<I>& root_slot, bool begin) :
         m_inner_table(&inner_table),
         m_leaf_table(&leaf_table),
         m_inner_stack(),
@@ -287,22 +349,23 @@ public:
     bool operator!=(const const_iterator& other) const { return !(*this == other); }
 };
 
-template<typename T, std::unsigned_integral I>
-inline auto begin(Slot<I> root, const IndexedHashSet<Slot<I>, I>& table, const IndexedHashSet<T, I>& leaf_table)
+template<std::unsigned_integral I, IsIndexedTable<Slot<I>, I> Table, typename LeafTable>
+inline auto begin(Slot<I> root, const Table& table, const LeafTable& leaf_table)
 {
-    return const_iterator<T, I>(table, leaf_table, root, true);
+    return const_iterator<typename LeafTable::value_type, I, Table, LeafTable>(table, leaf_table, root, true);
 }
 
-template<typename T, std::unsigned_integral I>
-inline auto end(const IndexedHashSet<T, I>&)
+template<typename Table, typename LeafTable>
+    requires IsIndexedTable<Table, Slot<typename Table::index_type>, typename Table::index_type>
+inline auto end(const Table&, const LeafTable&)
 {
-    return const_iterator<T, I>();
+    return const_iterator<typename LeafTable::value_type, typename Table::index_type, Table, LeafTable>();
 }
 
-template<typename T, std::unsigned_integral I>
-inline auto range(Slot<I> root, const IndexedHashSet<Slot<I>, I>& table, const IndexedHashSet<T, I>& leaf_table)
+template<std::unsigned_integral I, IsIndexedTable<Slot<I>, I> Table, typename LeafTable>
+inline auto range(Slot<I> root, const Table& table, const LeafTable& leaf_table)
 {
-    return std::ranges::subrange(begin(root, table, leaf_table), end(leaf_table));
+    return std::ranges::subrange(begin(root, table, leaf_table), end(table, leaf_table));
 }
 
 ///////////////////////////////////////////
@@ -313,9 +376,9 @@ inline auto range(Slot<I> root, const IndexedHashSet<Slot<I>, I>& table, const I
  * Insert recursively
  */
 
-template<std::input_iterator Iterator, std::unsigned_integral I>
+template<std::input_iterator Iterator, std::unsigned_integral I, IsIndexedTable<Slot<I>, I> Table>
     requires std::same_as<std::iter_value_t<Iterator>, I>
-inline I insert_recursively(Iterator it, Iterator end, I size, IndexedHashSet<Slot<I>, I>& table)
+inline I insert_recursively(Iterator it, Iterator end, I size, Table& table)
 {
     /* Base cases */
     if (size == 1)
@@ -335,9 +398,9 @@ inline I insert_recursively(Iterator it, Iterator end, I size, IndexedHashSet<Sl
     return table.insert(Slot<I>(i1, i2));
 }
 
-template<std::ranges::input_range Range, std::unsigned_integral I>
-    requires std::same_as<std::ranges::range_value_t<Range>, I>
-auto insert(const Range& state, IndexedHashSet<Slot<I>, I>& table)
+template<std::ranges::input_range Range, typename Table, std::unsigned_integral I = typename Table::index_type>
+    requires IsIndexedTable<Table, Slot<I>, I> && std::same_as<std::ranges::range_value_t<Range>, I>
+auto insert(const Range& state, Table& table)
 {
     // Note: O(1) for random access iterators, and O(N) otherwise by repeatedly calling operator++.
     const auto size = static_cast<I>(std::distance(state.begin(), state.end()));
@@ -348,12 +411,69 @@ auto insert(const Range& state, IndexedHashSet<Slot<I>, I>& table)
     return Slot<I>(insert_recursively(state.begin(), state.end(), size, table), size);
 }
 
+/**
+ * Insert with parent
+ */
+
+template<std::random_access_iterator Iterator, std::unsigned_integral I, IsIndexedTable<Slot<I>, I> Table, typename Pred>
+    requires std::same_as<std::iter_value_t<Iterator>, I> && std::predicate<Pred&, I, I>
+inline I insert_recursively_with_parent(Iterator it, I pos, I size, I parent_index, Table& table, Pred& is_unchanged)
+{
+    /* Reuse unchanged subtree */
+    if (is_unchanged(pos, pos + size))
+        return parent_index;
+
+    /* Base cases */
+    if (size == 1)
+        return *(it + pos);  ///< Skip node creation
+
+    const auto parent_slot = table[parent_index];
+
+    if (size == 2)
+    {
+        const auto i1 = *(it + pos);
+        const auto i2 = *(it + pos + 1);
+        return (i1 == parent_slot.i1 && i2 == parent_slot.i2) ? parent_index : table.insert(Slot<I>(i1, i2));
+    }
+
+    /* Divide */
+    const auto mid = std::bit_floor(size - 1);
+
+    /* Conquer */
+    const auto i1 = insert_recursively_with_parent(it, pos, mid, parent_slot.i1, table, is_unchanged);
+    const auto i2 = insert_recursively_with_parent(it, I(pos + mid), I(size - mid), parent_slot.i2, table, is_unchanged);
+
+    return (i1 == parent_slot.i1 && i2 == parent_slot.i2) ? parent_index : table.insert(Slot<I>(i1, i2));
+}
+
+/// @brief Insert the `state` by reusing the subtrees of the tree of `parent_root` that remain unchanged.
+///
+/// The trees share their shape if and only if the states have equal size. In that case, only the nodes on paths to changed positions
+/// are inserted, where `is_unchanged(first, last)` must return true only if the positions [first, last) hold the same values in both states.
+/// Otherwise, the state is inserted from scratch.
+/// @param state is the state.
+/// @param parent_root is the root slot of the parent state.
+/// @param table is the tree table.
+/// @param is_unchanged is a conservative test for unchanged position ranges.
+/// @return the root slot of the state.
+template<std::ranges::random_access_range Range, typename Table, typename Pred, std::unsigned_integral I = typename Table::index_type>
+    requires IsIndexedTable<Table, Slot<I>, I> && std::same_as<std::ranges::range_value_t<Range>, I> && std::predicate<Pred&, I, I>
+auto insert_with_parent(const Range& state, Slot<I> parent_root, Table& table, Pred is_unchanged)
+{
+    const auto size = static_cast<I>(std::ranges::size(state));
+
+    if (size == 0 || size != parent_root.i2)
+        return insert(state, table);
+
+    return Slot<I>(insert_recursively_with_parent(std::ranges::begin(state), I(0), size, parent_root.i1, table, is_unchanged), size);
+}
+
 /**
  * Read recursively
  */
 
-template<std::unsigned_integral I>
-inline void read_state_recursively(I index, I size, const IndexedHashSet<Slot<I>, I>& table, std::vector<I>& ref_state)
+template<std::unsigned_integral I, IsIndexedTable<Slot<I>, I> Table>
+inline void read_state_recursively(I index, I size, const Table& table, std::vector<I>& ref_state)
 {
     /* Base case */
     if (size == 1)
@@ -380,8 +500,8 @@ inline void read_state_recursively(I index, I size, const IndexedHashSet<Slot<I>
     read_state_recursively(slot.i2, size - mid, table, ref_state);
 }
 
-template<std::unsigned_integral I>
-inline void read_state(I tree_index, I size, const IndexedHashSet<Slot<I>, I>& table, std::vector<I>& out_state)
+template<std::unsigned_integral I, IsIndexedTable<Slot<I>, I> Table>
+inline void read_state(I tree_index, I size, const Table& table, std::vector<I>& out_state)
 {
     out_state.clear();
 
@@ -391,28 +511,265 @@ inline void read_state(I tree_index, I size, const IndexedHashSet<Slot<I>, I>& t
     read_state_recursively(tree_index, size, table, out_state);
 }
 
-template<std::unsigned_integral I>
-inline void read_state(const Slot<I>& root_slot, const IndexedHashSet<Slot<I>, I>& table, std::vector<I>& out_state)
+template<std::unsigned_integral I, IsIndexedTable<Slot<I>, I> Table>
+inline void read_state(const Slot<I>& root_slot, const Table& table, std::vector<I>& out_state)
 {
     /* Observe: a root slot wraps the root tree_index together with the length that defines the tree structure! */
     read_state(root_slot.i1, root_slot.i2, table, out_state);
 }
 
 /**
- * ConstIterator
+ * Insert with delta
  */
 
+/// @brief Get the value at position `pos` of the tree with the given root `index` and `size` in O(log(size)).
+template<std::unsigned_integral I, IsIndexedTable<Slot<I>, I> Table>
+inline I get_value(I index, I size, I pos, const Table& table)
+{
+    assert(pos < size);
+
+    while (size > 2)
+    {
+        const auto slot = table[index];
+        const auto mid = std::bit_floor(size - 1);
+
+        if (pos < mid)
+        {
+            index = slot.i1;
+            size = mid;
+        }
+        else
+        {
+            index = slot.i2;
+            pos -= mid;
+            size -= mid;
+        }
+    }
+
+    if (size == 1)
+        return index;
+
+    const auto slot = table[index];
+    return (pos == 0) ? slot.i1 : slot.i2;
+}
+
+/// @brief Get the number of values smaller than `value` in the sorted tree with the given root `index` and `size` in O(log(size)^2).
+template<std::unsigned_integral I, IsIndexedTable<Slot<I>, I> Table>
+inline I get_rank(I index, I size, I value, const Table& table)
+{
+    auto rank = I(0);
+
+    while (size > 2)
+    {
+        const auto slot = table[index];
+        const auto mid = std::bit_floor(size - 1);
+
+        if (value < get_value(slot.i2, I(size - mid), I(0), table))
+        {
+            index = slot.i1;
+            size = mid;
+        }
+        else
+        {
+            rank += mid;
+            index = slot.i2;
+            size -= mid;
+        }
+    }
+
+    if (size == 1)
+        return rank + (index < value);
+
+    const auto slot = table[index];
+    return rank + (slot.i1 < value) + (slot.i2 < value);
+}
+
+/// @brief `DeltaSegment` describes the positions of a state, starting at `first`, that either hold the values of the parent state
+/// starting at `parent_first`, or the single added `value` if `parent_first` is `NO_PARENT`. The segment ends where the next segment starts.
+template<std::unsigned_integral I>
+struct DeltaSegment
+{
+    static constexpr I NO_PARENT = std::numeric_limits<I>::max();
+
+    I first;
+    I parent_first;
+    I value;
+};
+
+/// @brief `DeltaWorkspace` holds the memory for reuse of `insert_with_delta`.
 template<std::unsigned_integral I>
-class const_iterator<I, I>
+struct DeltaWorkspace
+{
+    std::vector<DeltaSegment<I>> segments;
+    std::vector<I> parent_state;
+    std::vector<I> state;
+};
+
+/// @brief Compute the segments of the state that results from removing the sorted `deleted` values from, and inserting the sorted `added`
+/// values into the sorted parent state. Only the positions of the changed values are located in the tree of the parent.
+/// @return the size of the state.
+template<std::unsigned_integral I, IsIndexedTable<Slot<I>, I> Table>
+inline I compute_delta_segments(Slot<I> parent_root,
+                                const std::vector<I>& added,
+                                const std::vector<I>& deleted,
+                                const Table& table,
+                                std::vector<DeltaSegment<I>>& out_segments)
+{
+    constexpr auto NO_PARENT = DeltaSegment<I>::NO_PARENT;
+
+    const auto parent_size = parent_root.i2;
+    const auto get_parent_rank = [&](I value) { return (parent_size == 0) ? I(0) : get_rank(parent_root.i1, parent_size, value, table); };
+
+    out_segments.clear();
+
+    auto pos = I(0);
+    auto parent_pos = I(0);
+    auto added_it = added.begin();
+    auto deleted_it = deleted.begin();
+    auto added_rank = (added_it != added.end()) ? get_parent_rank(*added_it) : NO_PARENT;
+    auto deleted_rank = (deleted_it != deleted.end()) ? get_parent_rank(*deleted_it) : NO_PARENT;
+
+    while (added_it != added.end() || deleted_it != deleted.end())
+    {
+        const auto next_parent_pos = std::min(added_rank, deleted_rank);
+        if (next_parent_pos > parent_pos)
+        {
+            out_segments.push_back(DeltaSegment<I> { pos, parent_pos, I(0) });
+            pos += next_parent_pos - parent_pos;
+            parent_pos = next_parent_pos;
+        }
+
+        // An added value at the rank of a deleted value is smaller than the deleted value.
+        if (added_rank <= deleted_rank)
+        {
+            out_segments.push_back(DeltaSegment<I> { pos, NO_PARENT, *added_it });
+            ++pos;
+            added_rank = (++added_it != added.end()) ? get_parent_rank(*added_it) : NO_PARENT;
+        }
+        else
+        {
+            assert(get_value(parent_root.i1, parent_size, deleted_rank, table) == *deleted_it);
+            ++parent_pos;
+            deleted_rank = (++deleted_it != deleted.end()) ? get_parent_rank(*deleted_it) : NO_PARENT;
+        }
+    }
+
+    if (parent_pos < parent_size)
+    {
+        out_segments.push_back(DeltaSegment<I> { pos, parent_pos, I(0) });
+        pos += parent_size - parent_pos;
+    }
+
+    return pos;
+}
+
+template<std::unsigned_integral I, IsIndexedTable<Slot<I>, I> Table>
+inline I insert_recursively_with_delta(I pos, I size, I parent_index, Slot<I> parent_root, const std::vector<DeltaSegment<I>>& segments, Table& table)
+{
+    const auto segment = std::prev(std::upper_bound(segments.begin(),
+                                                    segments.end(),
+                                                    pos,
+                                                    [](I value, const DeltaSegment<I>& segment) { return value < segment.first; }));
+    const auto segment_last = (std::next(segment) != segments.end()) ? std::next(segment)->first : parent_root.i2;
+
+    /* Reuse unchanged subtree: all positions are copied from the same positions of the parent. */
+    if (segment->parent_first == segment->first && pos + size <= segment_last)
+        return parent_index;
+
+    const auto get_value_at = [&](I value_pos)
+    {
+        const auto it = std::prev(std::upper_bound(segments.begin(),
+                                                   segments.end(),
+                                                   value_pos,
+                                                   [](I value, const DeltaSegment<I>& segment) { return value < segment.first; }));
+        return (it->parent_first == DeltaSegment<I>::NO_PARENT) ? it->value :
+                                                                  get_value(parent_root.i1, parent_root.i2, I(it->parent_first + value_pos - it->first), table);
+    };
+
+    /* Base cases */
+    if (size == 1)
+        return get_value_at(pos);  ///< Skip node creation
+
+    const auto parent_slot = table[parent_index];
+
+    if (size == 2)
+    {
+        const auto i1 = get_value_at(pos);
+        const auto i2 = get_value_at(I(pos + 1));
+        return (i1 == parent_slot.i1 && i2 == parent_slot.i2) ? parent_index : table.insert(Slot<I>(i1, i2));
+    }
+
+    /* Divide */
+    const auto mid = std::bit_floor(size - 1);
+
+    /* Conquer */
+    const auto i1 = insert_recursively_with_delta(pos, mid, parent_slot.i1, parent_root, segments, table);
+    const auto i2 = insert_recursively_with_delta(I(pos + mid), I(size - mid), parent_slot.i2, parent_root, segments, table);
+
+    return (i1 == parent_slot.i1 && i2 == parent_slot.i2) ? parent_index : table.insert(Slot<I>(i1, i2));
+}
+
+/// @brief Insert the state that results from removing the `deleted` values from, and inserting the `added` values into the parent state,
+/// without materializing the state.
+///
+/// The positions of the changed values are located in the tree of `parent_root`, and only the nodes on paths to changed positions are inserted.
+/// This takes O((|added| + |deleted|) * log(n)^2) time plus O(log(n)) time per changed position.
+/// If the size changes, the trees do not share their shape and the state is inserted from scratch in O(n) time.
+/// @param parent_root is the root slot of the sorted parent state.
+/// @param added are the sorted values that are not in the parent state.
+/// @param deleted are the sorted values that are in the parent state.
+/// @param table is the tree table.
+/// @param workspace is the memory for reuse.
+/// @return the root slot of the state.
+template<typename Table, std::unsigned_integral I = typename Table::index_type>
+    requires IsIndexedTable<Table, Slot<I>, I>
+auto insert_with_delta(Slot<I> parent_root, const std::vector<I>& added, const std::vector<I>& deleted, Table& table, DeltaWorkspace<I>& workspace)
+{
+    if (added.empty() && deleted.empty())
+        return parent_root;
+
+    const auto size = compute_delta_segments(parent_root, added, deleted, table, workspace.segments);
+
+    if (size == 0)
+        return get_empty_slot<I>();  ///< Special case for empty state.
+
+    if (size == parent_root.i2)
+        return Slot<I>(insert_recursively_with_delta(I(0), size, parent_root.i1, parent_root, workspace.segments, table), size);
+
+    read_state(parent_root, table, workspace.parent_state);
+    workspace.state.clear();
+    for (size_t i = 0; i < workspace.segments.size(); ++i)
+    {
+        const auto& segment = workspace.segments[i];
+        if (segment.parent_first == DeltaSegment<I>::NO_PARENT)
+        {
+            workspace.state.push_back(segment.value);
+            continue;
+        }
+        const auto last = (i + 1 < workspace.segments.size()) ? workspace.segments[i + 1].first : size;
+        workspace.state.insert(workspace.state.end(),
+                               workspace.parent_state.begin() + segment.parent_first,
+                               workspace.parent_state.begin() + segment.parent_first + (last - segment.first));
+    }
+
+    return insert(workspace.state, table);
+}
+
+/**
+ * ConstIterator
+ */
+
+template<std::unsigned_integral I, typename Table>
+class const_iterator<I, I, Table, void>
 {
 private:
-    const IndexedHashSet<Slot<I>, I>* m_table;
+    const Table* m_table;
     UniqueObjectPoolPtr<std::vector<Entry<I>>> m_stack;
     I m_value;
 
     static constexpr const I END_POS = std::numeric_limits<I>::max();
 
-    const IndexedHashSet<Slot<I>, I>& table() const
+    const Table& table() const
     {
         assert(m_table);
         return *m_table;
@@ -465,7 +822,7 @@ public:
     }
     const_iterator(const_iterator&& other) = default;
     const_iterator& operator=(const_iterator&& other) = default;
-    const_iterator(const IndexedHashSet<Slot<I>, I>& table, Slot<I> root, bool begin) : m_table(&table), m_stack(), m_value(END_POS)
+    const_iterator(const Table& table, Slot<I> root, bool begin) : m_table(&table), m_stack(), m_value(END_POS)
     {
         assert(m_table);
 
@@ -497,22 +854,23 @@ public:
     bool operator!=(const const_iterator& other) const { return !(*this == other); }
 };
 
-template<std::unsigned_integral I>
-inline auto begin(Slot<I> root, const IndexedHashSet<Slot<I>, I>& table)
+template<std::unsigned_integral I, IsIndexedTable<Slot<I>, I> Table>
+inline auto begin(Slot<I> root, const Table& table)
 {
-    return const_iterator<I, I>(table, root, true);
+    return const_iterator<I, I, Table, void>(table, root, true);
 }
 
-template<std::unsigned_integral I>
-inline auto end()
+template<typename Table>
+    requires IsIndexedTable<Table, Slot<typename Table::index_type>, typename Table::index_type>
+inline auto end(const Table&)
 {
-    return const_iterator<I, I>();
+    return const_iterator<typename Table::index_type, typename Table::index_type, Table, void>();
 }
 
-template<std::unsigned_integral I>
-inline auto range(Slot<I> root, const IndexedHashSet<Slot<I>, I>& table)
+template<std::unsigned_integral I, IsIndexedTable<Slot<I>, I> Table>
+inline auto range(Slot<I> root, const Table& table)
 {
-    return std::ranges::subrange(begin(root, table), end<I>());
+    return std::ranges::subrange(begin(root, table), end(table));
 }
 }
 
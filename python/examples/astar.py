@@ -48,6 +48,9 @@ class CustomEventHandler(search.IAStarEagerEventHandler):
     def on_prune_state(self, state : search.State):
         pass
 
+    def on_lookup_unpacked_state(self, hit : bool):
+        pass
+
     def on_start_search(self, start_state : search.State, g_value : float, h_value : float):
         pass
 
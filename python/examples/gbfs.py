@@ -43,6 +43,9 @@ class CustomGBFSEventHandler(search.IGBFSEagerEventHandler):
     def on_new_best_h_value(self, h_value : float):
         pass
 
+    def on_lookup_unpacked_state(self, hit : bool):
+        pass
+
     def on_end_search(self, num_reached_fluent_atoms : int, num_reached_derived_atoms: int, num_states: int, num_nodes: int, num_actions: int, num_axioms: int):
         pass
 
@@ -25,11 +25,15 @@ from .wrapper_search import (
     Heuristic,
     AddHeuristic,
     BlindHeuristic,
+    CachingHeuristic,
     MaxHeuristic,
     PerfectHeuristic,
     SetAddHeuristic,
     SearchResult,
     FFHeuristic,
+    LMCutHeuristic,
+    PDBHeuristic,
+    CanonicalPDBsHeuristic,
     astar_eager,
     iw
 )
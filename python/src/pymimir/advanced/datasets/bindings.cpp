@@ -3,6 +3,8 @@
 #include "../init_declarations.hpp"
 #include "mimir/datasets/state_space_sampler.hpp"
 
+#include <nanobind/ndarray.h>
+
 using namespace mimir;
 using namespace mimir::graphs;
 using namespace mimir::formalism;
@@ -10,6 +12,26 @@ using namespace mimir::formalism;
 namespace mimir::datasets
 {
 
+/// @brief Create the object graphs of the states as arrays (vertex_offsets, vertex_colors, edge_offsets, edge_sources, edge_targets),
+/// see `ObjectGraphBatch`. The arrays are filled without holding the GIL and share the memory of the batch.
+static auto create_object_graph_batch(ObjectGraphBuilder& builder, const search::StateList& states)
+{
+    auto batch = std::make_unique<ObjectGraphBatch>();
+    {
+        nb::gil_scoped_release release;
+        builder.create(std::span<const search::State>(states), *batch);
+    }
+
+    auto* batch_ptr = batch.release();
+    auto owner = nb::capsule(batch_ptr, [](void* p) noexcept { delete static_cast<ObjectGraphBatch*>(p); });
+    const auto to_array = [&](IndexList& values) { return nb::ndarray<nb::numpy, Index, nb::ndim<1>>(values.data(), { values.size() }, owner); };
+    return std::make_tuple(to_array(batch_ptr->vertex_offsets),
+                           to_array(batch_ptr->vertex_colors),
+                           to_array(batch_ptr->edge_offsets),
+                           to_array(batch_ptr->edge_sources),
+                           to_array(batch_ptr->edge_targets));
+}
+
 void bind_module_definitions(nb::module_& m)
 {
     /* ProblemGraph */
@@ -61,13 +83,16 @@ void bind_module_definitions(nb::module_& m)
         .def_rw("symmetry_pruning", &StateSpaceImpl::Options::symmetry_pruning)
         .def_rw("remove_if_unsolvable", &StateSpaceImpl::Options::remove_if_unsolvable)
         .def_rw("max_num_states", &StateSpaceImpl::Options::max_num_states)
-        .def_rw("timeout_ms", &StateSpaceImpl::Options::timeout_ms);
+        .def_rw("timeout_ms", &StateSpaceImpl::Options::timeout_ms)
+        .def_rw("num_threads", &StateSpaceImpl::Options::num_threads)
+        .def_rw("num_layer_threads", &StateSpaceImpl::Options::num_layer_threads);
 
     nb::class_<TupleGraphImpl::Options>(m, "TupleGraphOptions")
         .def(nb::init<>())
-        .def(nb::init<size_t, bool>(), "width"_a, "enable_dominance_pruning"_a)
+        .def(nb::init<size_t, bool, uint32_t>(), "width"_a, "enable_dominance_pruning"_a, "num_threads"_a = 1)
         .def_rw("width", &TupleGraphImpl::Options::width)
-        .def_rw("enable_dominance_pruning", &TupleGraphImpl::Options::enable_dominance_pruning);
+        .def_rw("enable_dominance_pruning", &TupleGraphImpl::Options::enable_dominance_pruning)
+        .def_rw("num_threads", &TupleGraphImpl::Options::num_threads);
 
     nb::class_<GeneralizedStateSpaceImpl::Options>(m, "GeneralizedStateSpaceOptions")  //
         .def(nb::init<>());
@@ -153,16 +178,34 @@ void bind_module_definitions(nb::module_& m)
                      result.push_back(graphs::VertexIndexList(group.begin(), group.end()));
                  }
                  return result;
-             });
+             })
+        .def("get_estimated_memory_usage_in_bytes", &TupleGraphImpl::get_estimated_memory_usage_in_bytes);
 
     nb::class_<KnowledgeBaseImpl>(m, "KnowledgeBase")
         .def_static("create", &KnowledgeBaseImpl::create, "contexts"_a, "options"_a)
         .def("get_domain", &KnowledgeBaseImpl::get_domain, nb::rv_policy::reference_internal)
         .def("get_state_spaces", &KnowledgeBaseImpl::get_state_spaces, nb::rv_policy::copy)
         .def("get_generalized_state_space", &KnowledgeBaseImpl::get_generalized_state_space, nb::rv_policy::reference_internal)
-        .def("get_tuple_graphs", &KnowledgeBaseImpl::get_tuple_graphs, nb::rv_policy::copy);
+        .def("get_tuple_graphs", &KnowledgeBaseImpl::get_tuple_graphs, nb::rv_policy::copy)
+        .def("get_tuple_graph_workspace_memory_usage_in_bytes", &KnowledgeBaseImpl::get_tuple_graph_workspace_memory_usage_in_bytes, nb::rv_policy::copy);
+
+    m.def("create_object_graph", nb::overload_cast<const search::State&, const ProblemImpl&>(&create_object_graph), "state"_a, "problem"_a);
 
-    m.def("create_object_graph", create_object_graph, "state"_a, "problem"_a);
+    /* ObjectGraphBuilder */
+    nb::class_<ObjectGraphBuilder>(m, "ObjectGraphBuilder")
+        .def(nb::init<const ProblemImpl&>(), "problem"_a, nb::keep_alive<1, 2>())
+        .def(
+            "create",
+            [](ObjectGraphBuilder& self, const search::State& state)
+            {
+                auto graph = StaticVertexColoredGraph();
+                self.create(state, graph);
+                return graph;
+            },
+            "state"_a)
+        .def("create_batch", &create_object_graph_batch, "states"_a)
+        .def("get_color", &ObjectGraphBuilder::get_color, "color"_a, nb::rv_policy::copy)
+        .def("get_num_colors", &ObjectGraphBuilder::get_num_colors);
 
     /* StateSpaceSampler */
     nb::class_<StateSpaceSamplerImpl>(m, "StateSpaceSampler")
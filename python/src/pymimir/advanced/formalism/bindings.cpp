@@ -728,7 +728,9 @@ void bind_module_definitions(nb::module_& m)
             .def(nb::init<size_t, const PredicateList<Tag>&>(), "num_objects"_a, "predicates"_a)
             .def("reset", &AssignmentSet<Tag>::reset)
             .def("insert_ground_atoms", &AssignmentSet<Tag>::insert_ground_atoms, "ground_atoms"_a)
-            .def("insert_ground_atom", &AssignmentSet<Tag>::insert_ground_atoms, "ground_atom"_a);
+            .def("insert_ground_atom", &AssignmentSet<Tag>::insert_ground_atom, "ground_atom"_a)
+            .def("erase_ground_atoms", &AssignmentSet<Tag>::erase_ground_atoms, "ground_atoms"_a)
+            .def("erase_ground_atom", &AssignmentSet<Tag>::erase_ground_atom, "ground_atom"_a);
     };
     bind_assignment_set("StaticAssignmentSet", StaticTag {});
     bind_assignment_set("FluentAssignmentSet", FluentTag {});
@@ -21,6 +21,10 @@ from pymimir.pymimir.advanced.search import (
     PackedState,
     State,
     StateList,
+    get_fluent_atom_matrix,
+    get_derived_atom_matrix,
+    get_fluent_atom_indices,
+    get_derived_atom_indices,
     StateRepository,
     compute_state_metric_value,
     SearchContext,
@@ -37,7 +41,15 @@ from pymimir.pymimir.advanced.search import (
     MaxHeuristic,
     AddHeuristic,
     SetAddHeuristic,
-    FFHeuristic
+    FFHeuristic,
+    LMCutHeuristic,
+    PDBHeuristic,
+    CanonicalPDBsHeuristic,
+    LiftedMaxHeuristic,
+    LiftedAddHeuristic,
+    LiftedFFHeuristic,
+    CachingHeuristic,
+    CachingHeuristicStatistics
 )
 
 # SatisficingBindingGenerator
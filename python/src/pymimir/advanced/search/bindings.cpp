@@ -1,7 +1,10 @@
 #include "../init_declarations.hpp"
 
+#include <memory>
 #include <nanobind/nanobind.h>
+#include <nanobind/ndarray.h>
 #include <nanobind/trampoline.h>
+#include <stdexcept>
 
 using namespace mimir::formalism;
 
@@ -48,11 +51,29 @@ public:
 class IPyHeuristic : public IHeuristic
 {
 public:
-    NB_TRAMPOLINE(IHeuristic, 2);
+    NB_TRAMPOLINE(IHeuristic, 3);
 
     /* Trampoline (need one for each virtual function) */
     ContinuousCost compute_heuristic(const State& state, bool is_goal_state) override { NB_OVERRIDE_PURE(compute_heuristic, state, is_goal_state); }
 
+    /// @brief The Python override returns the heuristic values as a sequence, e.g., a NumPy array, instead of writing them into `out_values`.
+    void compute_heuristics(const StateList& states, const std::vector<bool>& are_goal_states, ContinuousCostList& out_values) override
+    {
+        nb::detail::ticket nb_ticket(nb_trampoline, "compute_heuristics", false);
+        if (!nb_ticket.key.is_valid())
+        {
+            IHeuristic::compute_heuristics(states, are_goal_states, out_values);
+            return;
+        }
+
+        // The states are only referenced for the duration of the call.
+        out_values = nb::cast<ContinuousCostList>(nb_trampoline.base().attr(nb_ticket.key)(nb::cast(states, nb::rv_policy::reference), are_goal_states));
+        if (out_values.size() != states.size())
+        {
+            throw std::runtime_error("IHeuristic::compute_heuristics: Expected one heuristic value per state.");
+        }
+    }
+
     const PreferredActions& get_preferred_actions() const override { NB_OVERRIDE(get_preferred_actions); }
 };
 
@@ -81,6 +102,7 @@ public:
     void on_close_state(const State& state) override { NB_OVERRIDE_PURE(on_close_state, state); }
     void on_finish_f_layer(ContinuousCost f_value) override { NB_OVERRIDE_PURE(on_finish_f_layer, f_value); }
     void on_prune_state(const State& state) override { NB_OVERRIDE_PURE(on_prune_state, state); }
+    void on_lookup_unpacked_state(bool hit) override { NB_OVERRIDE_PURE(on_lookup_unpacked_state, hit); }
     void on_start_search(const State& start_state, ContinuousCost g_value, ContinuousCost h_value) override
     {
         NB_OVERRIDE_PURE(on_start_search, start_state, g_value, h_value);
@@ -125,6 +147,7 @@ public:
     void on_close_state(const State& state) override { NB_OVERRIDE_PURE(on_close_state, state); }
     void on_finish_f_layer(ContinuousCost f_value) override { NB_OVERRIDE_PURE(on_finish_f_layer, f_value); }
     void on_prune_state(const State& state) override { NB_OVERRIDE_PURE(on_prune_state, state); }
+    void on_lookup_unpacked_state(bool hit) override { NB_OVERRIDE_PURE(on_lookup_unpacked_state, hit); }
     void on_start_search(const State& start_state, ContinuousCost g_value, ContinuousCost h_value) override
     {
         NB_OVERRIDE_PURE(on_start_search, start_state, g_value, h_value);
@@ -199,6 +222,7 @@ public:
         NB_OVERRIDE_PURE(on_generate_state, state, action, action_cost, successor_state);
     }
     void on_prune_state(const State& state) override { NB_OVERRIDE_PURE(on_prune_state, state); }
+    void on_lookup_unpacked_state(bool hit) override { NB_OVERRIDE_PURE(on_lookup_unpacked_state, hit); }
     void on_start_search(const State& start_state, ContinuousCost g_value, ContinuousCost h_value) override
     {
         NB_OVERRIDE_PURE(on_start_search, start_state, g_value, h_value);
@@ -234,6 +258,7 @@ public:
         NB_OVERRIDE_PURE(on_generate_state, state, action, action_cost, successor_state);
     }
     void on_prune_state(const State& state) override { NB_OVERRIDE_PURE(on_prune_state, state); }
+    void on_lookup_unpacked_state(bool hit) override { NB_OVERRIDE_PURE(on_lookup_unpacked_state, hit); }
     void on_start_search(const State& start_state, ContinuousCost g_value, ContinuousCost h_value) override
     {
         NB_OVERRIDE_PURE(on_start_search, start_state, g_value, h_value);
@@ -254,6 +279,91 @@ public:
     const gbfs_lazy::Statistics& get_statistics() const override { NB_OVERRIDE_PURE(get_statistics); }
 };
 
+/**
+ * Batches of states as NumPy arrays
+ */
+
+/// @brief Compute the matrix whose rows are the atom bitsets of the states with one byte per atom.
+/// The matrix is filled without holding the GIL.
+template<IsFluentOrDerivedTag P>
+static nb::ndarray<nb::numpy, uint8_t, nb::ndim<2>> compute_atom_matrix(const StateList& states, std::optional<size_t> num_atoms)
+{
+    auto num_columns = size_t(0);
+    auto data = std::unique_ptr<uint8_t[]>();
+    {
+        nb::gil_scoped_release release;
+
+        if (num_atoms)
+        {
+            num_columns = num_atoms.value();
+        }
+        else
+        {
+            for (const auto& state : states)
+            {
+                for (const auto atom_index : state.get_atoms<P>())
+                {
+                    num_columns = std::max(num_columns, static_cast<size_t>(atom_index) + 1);
+                }
+            }
+        }
+
+        data = std::make_unique<uint8_t[]>(states.size() * num_columns);
+        for (size_t row = 0; row < states.size(); ++row)
+        {
+            for (const auto atom_index : states[row].get_atoms<P>())
+            {
+                if (atom_index >= num_columns)
+                {
+                    throw std::out_of_range("compute_atom_matrix: Expected num_atoms to exceed the atom indices of the states.");
+                }
+                data[row * num_columns + atom_index] = 1;
+            }
+        }
+    }
+
+    auto* ptr = data.release();
+    auto owner = nb::capsule(ptr, [](void* p) noexcept { delete[] static_cast<uint8_t*>(p); });
+    return nb::ndarray<nb::numpy, uint8_t, nb::ndim<2>>(ptr, { states.size(), num_columns }, owner);
+}
+
+/// @brief Compute the atom indices of the states in compressed sparse row format,
+/// i.e., the atom indices of the i-th state are indices[offsets[i]:offsets[i + 1]].
+/// The arrays are filled without holding the GIL.
+template<IsFluentOrDerivedTag P>
+static std::pair<nb::ndarray<nb::numpy, Index, nb::ndim<1>>, nb::ndarray<nb::numpy, int64_t, nb::ndim<1>>> compute_atom_indices(const StateList& states)
+{
+    auto indices = std::unique_ptr<Index[]>();
+    auto offsets = std::make_unique<int64_t[]>(states.size() + 1);
+    {
+        nb::gil_scoped_release release;
+
+        offsets[0] = 0;
+        for (size_t row = 0; row < states.size(); ++row)
+        {
+            offsets[row + 1] = offsets[row] + static_cast<int64_t>(states[row].get_atoms<P>().count());
+        }
+
+        indices = std::make_unique<Index[]>(offsets[states.size()]);
+        for (size_t row = 0; row < states.size(); ++row)
+        {
+            auto position = offsets[row];
+            for (const auto atom_index : states[row].get_atoms<P>())
+            {
+                indices[position++] = atom_index;
+            }
+        }
+    }
+
+    const auto num_indices = static_cast<size_t>(offsets[states.size()]);
+    auto* indices_ptr = indices.release();
+    auto* offsets_ptr = offsets.release();
+    auto indices_owner = nb::capsule(indices_ptr, [](void* p) noexcept { delete[] static_cast<Index*>(p); });
+    auto offsets_owner = nb::capsule(offsets_ptr, [](void* p) noexcept { delete[] static_cast<int64_t*>(p); });
+    return { nb::ndarray<nb::numpy, Index, nb::ndim<1>>(indices_ptr, { num_indices }, indices_owner),
+             nb::ndarray<nb::numpy, int64_t, nb::ndim<1>>(offsets_ptr, { states.size() + 1 }, offsets_owner) };
+}
+
 void bind_module_definitions(nb::module_& m)
 {
     /* Enums */
@@ -296,8 +406,9 @@ void bind_module_definitions(nb::module_& m)
 
     nb::class_<SearchContextImpl::Options>(m, "SearchContextOptions")
         .def(nb::init<>())
-        .def(nb::init<SearchContextImpl::SearchMode>(), "mode"_a)
-        .def_rw("mode", &SearchContextImpl::Options::mode);
+        .def(nb::init<SearchContextImpl::SearchMode, bool>(), "mode"_a, "concurrent"_a = false)
+        .def_rw("mode", &SearchContextImpl::Options::mode)
+        .def_rw("concurrent", &SearchContextImpl::Options::concurrent);
 
     nb::class_<SearchContextImpl>(m, "SearchContext")
         .def_static(
@@ -413,6 +524,11 @@ void bind_module_definitions(nb::module_& m)
         .def("get_index", &State::get_index);
     nb::bind_vector<StateList>(m, "StateList");
 
+    m.def("get_fluent_atom_matrix", &compute_atom_matrix<FluentTag>, "states"_a, "num_atoms"_a = nb::none());
+    m.def("get_derived_atom_matrix", &compute_atom_matrix<DerivedTag>, "states"_a, "num_atoms"_a = nb::none());
+    m.def("get_fluent_atom_indices", &compute_atom_indices<FluentTag>, "states"_a);
+    m.def("get_derived_atom_indices", &compute_atom_indices<DerivedTag>, "states"_a);
+
     /* Plan */
     nb::class_<Plan>(m, "Plan")  //
         .def(nb::init<SearchContext, StateList, GroundActionList, ContinuousCost>(), "search_context"_a, "states"_a, "actions"_a, "cost"_a)
@@ -610,7 +726,8 @@ void bind_module_definitions(nb::module_& m)
         .def_rw("max_num_nodes", &match_tree::Options::max_num_nodes)
         .def_rw("split_strategy", &match_tree::Options::split_strategy)
         .def_rw("split_metric", &match_tree::Options::split_metric)
-        .def_rw("optimization_direction", &match_tree::Options::optimization_direction);
+        .def_rw("optimization_direction", &match_tree::Options::optimization_direction)
+        .def_rw("enable_compilation", &match_tree::Options::enable_compilation);
 
     nb::class_<DeleteRelaxedProblemExplorator>(m, "DeleteRelaxedProblemExplorator")
         .def(nb::init<Problem>(), "problem"_a)
@@ -632,6 +749,27 @@ void bind_module_definitions(nb::module_& m)
     nb::class_<IHeuristic, IPyHeuristic>(m, "IHeuristic")  //
         .def(nb::init<>())
         .def("compute_heuristic", &IHeuristic::compute_heuristic, "state"_a, "is_goal_state"_a)
+        .def(
+            "compute_heuristics",
+            [](IHeuristic& self, const StateList& states, const std::vector<bool>& are_goal_states)
+            {
+                auto values = ContinuousCostList {};
+                self.compute_heuristics(states, are_goal_states, values);
+                return values;
+            },
+            "states"_a,
+            "are_goal_states"_a)
+        .def(
+            "compute_heuristics_and_preferred_actions",
+            [](IHeuristic& self, const StateList& states, const std::vector<bool>& are_goal_states)
+            {
+                auto values = ContinuousCostList {};
+                auto preferred_actions = std::vector<GroundActionSet> {};
+                self.compute_heuristics_and_preferred_actions(states, are_goal_states, values, preferred_actions);
+                return std::make_pair(values, preferred_actions);
+            },
+            "states"_a,
+            "are_goal_states"_a)
         .def("get_preferred_actions", &IHeuristic::get_preferred_actions, nb::rv_policy::reference_internal);
 
     nb::class_<BlindHeuristicImpl, IHeuristic>(m, "BlindHeuristic")  //
@@ -641,16 +779,94 @@ void bind_module_definitions(nb::module_& m)
         .def_static("create", &PerfectHeuristicImpl::create, "search_context"_a);
 
     nb::class_<MaxHeuristicImpl, IHeuristic>(m, "MaxHeuristic")  //
-        .def_static("create", &MaxHeuristicImpl::create, "delete_relaxed_problem_explorator"_a);
+        .def_static("create", &MaxHeuristicImpl::create, "delete_relaxed_problem_explorator"_a, "enable_incremental_evaluation"_a = false);
 
     nb::class_<AddHeuristicImpl, IHeuristic>(m, "AddHeuristic")  //
-        .def_static("create", &AddHeuristicImpl::create, "delete_relaxed_problem_explorator"_a);
+        .def_static("create", &AddHeuristicImpl::create, "delete_relaxed_problem_explorator"_a, "enable_incremental_evaluation"_a = false);
 
     nb::class_<SetAddHeuristicImpl, IHeuristic>(m, "SetAddHeuristic")  //
-        .def_static("create", &SetAddHeuristicImpl::create, "delete_relaxed_problem_explorator"_a);
+        .def_static("create", &SetAddHeuristicImpl::create, "delete_relaxed_problem_explorator"_a, "enable_incremental_evaluation"_a = false);
 
     nb::class_<FFHeuristicImpl, IHeuristic>(m, "FFHeuristic")  //
-        .def_static("create", &FFHeuristicImpl::create, "delete_relaxed_problem_explorator"_a);
+        .def_static("create", &FFHeuristicImpl::create, "delete_relaxed_problem_explorator"_a, "enable_incremental_evaluation"_a = false);
+
+    nb::class_<LMCutHeuristicImpl, IHeuristic>(m, "LMCutHeuristic")  //
+        .def_static("create", &LMCutHeuristicImpl::create, "delete_relaxed_problem_explorator"_a);
+
+    nb::class_<PDBHeuristicImpl, IHeuristic>(m, "PDBHeuristic")  //
+        .def_static(
+            "create",
+            [](const DeleteRelaxedProblemExplorator& delete_relaxation,
+               std::optional<pdb::Pattern> pattern,
+               size_t max_num_abstract_states,
+               std::optional<fs::path> cache_directory)
+            {
+                auto options = PDBHeuristicImpl::Options();
+                options.pattern = std::move(pattern);
+                options.max_num_abstract_states = max_num_abstract_states;
+                options.cache_directory = std::move(cache_directory);
+                return PDBHeuristicImpl::create(delete_relaxation, options);
+            },
+            "delete_relaxed_problem_explorator"_a,
+            "pattern"_a = nb::none(),
+            "max_num_abstract_states"_a = 1'000'000,
+            "cache_directory"_a = nb::none());
+
+    nb::class_<CanonicalPDBsHeuristicImpl, IHeuristic>(m, "CanonicalPDBsHeuristic")  //
+        .def_static(
+            "create",
+            [](const DeleteRelaxedProblemExplorator& delete_relaxation,
+               std::optional<pdb::PatternList> patterns,
+               uint32_t max_time_ms,
+               std::optional<fs::path> cache_directory)
+            {
+                auto options = CanonicalPDBsHeuristicImpl::Options();
+                options.patterns = std::move(patterns);
+                options.hill_climbing_options.max_time_ms = max_time_ms;
+                options.cache_directory = std::move(cache_directory);
+                return CanonicalPDBsHeuristicImpl::create(delete_relaxation, options);
+            },
+            "delete_relaxed_problem_explorator"_a,
+            "patterns"_a = nb::none(),
+            "max_time_ms"_a = 60'000,
+            "cache_directory"_a = nb::none());
+
+    nb::class_<LiftedMaxHeuristicImpl, IHeuristic>(m, "LiftedMaxHeuristic")  //
+        .def_static("create", &LiftedMaxHeuristicImpl::create, "problem"_a);
+
+    nb::class_<LiftedAddHeuristicImpl, IHeuristic>(m, "LiftedAddHeuristic")  //
+        .def_static("create", &LiftedAddHeuristicImpl::create, "problem"_a);
+
+    nb::class_<LiftedFFHeuristicImpl, IHeuristic>(m, "LiftedFFHeuristic")  //
+        .def_static("create", &LiftedFFHeuristicImpl::create, "problem"_a);
+
+    nb::class_<CachingHeuristicImpl::Statistics>(m, "CachingHeuristicStatistics")  //
+        .def(nb::init<>())
+        .def("__str__", [](const CachingHeuristicImpl::Statistics& self) { return to_string(self); })
+        .def_ro("num_hits", &CachingHeuristicImpl::Statistics::num_hits)
+        .def_ro("num_misses", &CachingHeuristicImpl::Statistics::num_misses)
+        .def_ro("num_evictions", &CachingHeuristicImpl::Statistics::num_evictions)
+        .def_ro("num_invalidations", &CachingHeuristicImpl::Statistics::num_invalidations)
+        .def("get_hit_rate", &CachingHeuristicImpl::Statistics::get_hit_rate);
+
+    nb::class_<CachingHeuristicImpl, IHeuristic>(m, "CachingHeuristic")  //
+        .def_static(
+            "create",
+            [](Heuristic heuristic, size_t max_num_entries, size_t max_num_preferred_actions)
+            {
+                auto options = CachingHeuristicImpl::Options();
+                options.max_num_entries = max_num_entries;
+                options.max_num_preferred_actions = max_num_preferred_actions;
+                return CachingHeuristicImpl::create(std::move(heuristic), options);
+            },
+            "heuristic"_a,
+            "max_num_entries"_a = 1'000'000,
+            "max_num_preferred_actions"_a = 10'000'000)
+        .def("clear", &CachingHeuristicImpl::clear)
+        .def("get_heuristic", &CachingHeuristicImpl::get_heuristic, nb::rv_policy::copy)
+        .def("get_statistics", &CachingHeuristicImpl::get_statistics, nb::rv_policy::copy)
+        .def("get_num_entries", &CachingHeuristicImpl::get_num_entries)
+        .def("get_num_preferred_actions", &CachingHeuristicImpl::get_num_preferred_actions);
 
     /* Algorithms */
 
@@ -705,6 +921,9 @@ void bind_module_definitions(nb::module_& m)
         .def("get_num_expanded", &astar_eager::Statistics::get_num_expanded)
         .def("get_num_deadends", &astar_eager::Statistics::get_num_deadends)
         .def("get_num_pruned", &astar_eager::Statistics::get_num_pruned)
+        .def("get_num_unpacked_state_cache_hits", &astar_eager::Statistics::get_num_unpacked_state_cache_hits)
+        .def("get_num_unpacked_state_cache_misses", &astar_eager::Statistics::get_num_unpacked_state_cache_misses)
+        .def("get_unpacked_state_cache_hit_rate", &astar_eager::Statistics::get_unpacked_state_cache_hit_rate)
         .def("get_num_generated_until_f_value", &astar_eager::Statistics::get_num_generated_until_f_value)
         .def("get_num_expanded_until_f_value", &astar_eager::Statistics::get_num_expanded_until_f_value)
         .def("get_num_deadends_until_f_value", &astar_eager::Statistics::get_num_deadends_until_f_value)
@@ -722,6 +941,7 @@ void bind_module_definitions(nb::module_& m)
         .def("on_close_state", &astar_eager::IEventHandler::on_close_state)
         .def("on_finish_f_layer", &astar_eager::IEventHandler::on_finish_f_layer)
         .def("on_prune_state", &astar_eager::IEventHandler::on_prune_state)
+        .def("on_lookup_unpacked_state", &astar_eager::IEventHandler::on_lookup_unpacked_state)
         .def("on_start_search", &astar_eager::IEventHandler::on_start_search)
         .def("on_end_search", &astar_eager::IEventHandler::on_end_search)
         .def("on_solved", &astar_eager::IEventHandler::on_solved)
@@ -736,6 +956,11 @@ void bind_module_definitions(nb::module_& m)
                                                                                "DebugAStarEagerEventHandler")  //
         .def(nb::init<Problem, bool>(), "problem"_a, "quiet"_a = true);
 
+    nb::class_<ExternalMemoryOptions>(m, "ExternalMemoryOptions")  //
+        .def(nb::init<>())
+        .def_rw("directory", &ExternalMemoryOptions::directory)
+        .def_rw("memory_limit_in_bytes", &ExternalMemoryOptions::memory_limit_in_bytes);
+
     nb::class_<astar_eager::Options>(m, "AStarEagerOptions")  //
         .def(nb::init<>())
         .def_rw("start_state", &astar_eager::Options::start_state)
@@ -743,7 +968,9 @@ void bind_module_definitions(nb::module_& m)
         .def_rw("goal_strategy", &astar_eager::Options::goal_strategy)
         .def_rw("pruning_strategy", &astar_eager::Options::pruning_strategy)
         .def_rw("max_num_states", &astar_eager::Options::max_num_states)
-        .def_rw("max_time_in_ms", &astar_eager::Options::max_time_in_ms);
+        .def_rw("max_time_in_ms", &astar_eager::Options::max_time_in_ms)
+        .def_rw("unpacked_state_cache_size", &astar_eager::Options::unpacked_state_cache_size)
+        .def_rw("external_memory", &astar_eager::Options::external_memory);
 
     m.def("find_solution_astar_eager", &astar_eager::find_solution, "search_context"_a, "heuristic"_a, "options"_a);
 
@@ -755,6 +982,9 @@ void bind_module_definitions(nb::module_& m)
         .def("get_num_expanded", &astar_lazy::Statistics::get_num_expanded)
         .def("get_num_deadends", &astar_lazy::Statistics::get_num_deadends)
         .def("get_num_pruned", &astar_lazy::Statistics::get_num_pruned)
+        .def("get_num_unpacked_state_cache_hits", &astar_lazy::Statistics::get_num_unpacked_state_cache_hits)
+        .def("get_num_unpacked_state_cache_misses", &astar_lazy::Statistics::get_num_unpacked_state_cache_misses)
+        .def("get_unpacked_state_cache_hit_rate", &astar_lazy::Statistics::get_unpacked_state_cache_hit_rate)
         .def("get_num_generated_until_f_value", &astar_lazy::Statistics::get_num_generated_until_f_value)
         .def("get_num_expanded_until_f_value", &astar_lazy::Statistics::get_num_expanded_until_f_value)
         .def("get_num_deadends_until_f_value", &astar_lazy::Statistics::get_num_deadends_until_f_value)
@@ -772,6 +1002,7 @@ void bind_module_definitions(nb::module_& m)
         .def("on_close_state", &astar_lazy::IEventHandler::on_close_state)
         .def("on_finish_f_layer", &astar_lazy::IEventHandler::on_finish_f_layer)
         .def("on_prune_state", &astar_lazy::IEventHandler::on_prune_state)
+        .def("on_lookup_unpacked_state", &astar_lazy::IEventHandler::on_lookup_unpacked_state)
         .def("on_start_search", &astar_lazy::IEventHandler::on_start_search)
         .def("on_end_search", &astar_lazy::IEventHandler::on_end_search)
         .def("on_solved", &astar_lazy::IEventHandler::on_solved)
@@ -794,6 +1025,7 @@ void bind_module_definitions(nb::module_& m)
         .def_rw("pruning_strategy", &astar_lazy::Options::pruning_strategy)
         .def_rw("max_num_states", &astar_lazy::Options::max_num_states)
         .def_rw("max_time_in_ms", &astar_lazy::Options::max_time_in_ms)
+        .def_rw("unpacked_state_cache_size", &astar_lazy::Options::unpacked_state_cache_size)
         .def_rw("openlist_weights", &astar_lazy::Options::openlist_weights);
 
     m.def("find_solution_astar_lazy", &astar_lazy::find_solution, "search_context"_a, "heuristic"_a, "options"_a);
@@ -842,7 +1074,8 @@ void bind_module_definitions(nb::module_& m)
         .def_rw("pruning_strategy", &brfs::Options::pruning_strategy)
         .def_rw("stop_if_goal", &brfs::Options::stop_if_goal)
         .def_rw("max_num_states", &brfs::Options::max_num_states)
-        .def_rw("max_time_in_ms", &brfs::Options::max_time_in_ms);
+        .def_rw("max_time_in_ms", &brfs::Options::max_time_in_ms)
+        .def_rw("external_memory", &brfs::Options::external_memory);
 
     m.def("find_solution_brfs", &brfs::find_solution, "search_context"_a, "options"_a);
 
@@ -854,6 +1087,9 @@ void bind_module_definitions(nb::module_& m)
         .def("get_num_expanded", &gbfs_eager::Statistics::get_num_expanded)
         .def("get_num_deadends", &gbfs_eager::Statistics::get_num_deadends)
         .def("get_num_pruned", &gbfs_eager::Statistics::get_num_pruned)
+        .def("get_num_unpacked_state_cache_hits", &gbfs_eager::Statistics::get_num_unpacked_state_cache_hits)
+        .def("get_num_unpacked_state_cache_misses", &gbfs_eager::Statistics::get_num_unpacked_state_cache_misses)
+        .def("get_unpacked_state_cache_hit_rate", &gbfs_eager::Statistics::get_unpacked_state_cache_hit_rate)
         .def("get_search_time_ms", &gbfs_eager::Statistics::get_search_time_ms);
 
     nb::class_<gbfs_eager::IEventHandler, IPyGBFSEagerEventHandler>(m, "IGBFSEagerEventHandler")  //
@@ -862,6 +1098,7 @@ void bind_module_definitions(nb::module_& m)
         .def("on_expand_goal_state", &gbfs_eager::IEventHandler::on_expand_goal_state)
         .def("on_generate_state", &gbfs_eager::IEventHandler::on_generate_state)
         .def("on_prune_state", &gbfs_eager::IEventHandler::on_prune_state)
+        .def("on_lookup_unpacked_state", &gbfs_eager::IEventHandler::on_lookup_unpacked_state)
         .def("on_start_search", &gbfs_eager::IEventHandler::on_start_search)
         .def("on_new_best_h_value", &gbfs_eager::IEventHandler::on_new_best_h_value)
         .def("on_end_search", &gbfs_eager::IEventHandler::on_end_search)
@@ -884,9 +1121,21 @@ void bind_module_definitions(nb::module_& m)
         .def_rw("goal_strategy", &gbfs_eager::Options::goal_strategy)
         .def_rw("pruning_strategy", &gbfs_eager::Options::pruning_strategy)
         .def_rw("max_num_states", &gbfs_eager::Options::max_num_states)
-        .def_rw("max_time_in_ms", &gbfs_eager::Options::max_time_in_ms);
-
-    m.def("find_solution_gbfs_eager", &gbfs_eager::find_solution, "search_context"_a, "heuristic"_a, "options"_a);
+        .def_rw("max_time_in_ms", &gbfs_eager::Options::max_time_in_ms)
+        .def_rw("unpacked_state_cache_size", &gbfs_eager::Options::unpacked_state_cache_size)
+        .def_rw("use_preferred_actions", &gbfs_eager::Options::use_preferred_actions)
+        .def_rw("preferred_actions_boost", &gbfs_eager::Options::preferred_actions_boost);
+
+    m.def("find_solution_gbfs_eager",
+          nb::overload_cast<const SearchContext&, const Heuristic&, const gbfs_eager::Options&>(&gbfs_eager::find_solution),
+          "search_context"_a,
+          "heuristic"_a,
+          "options"_a);
+    m.def("find_solution_gbfs_eager",
+          nb::overload_cast<const SearchContext&, const HeuristicList&, const gbfs_eager::Options&>(&gbfs_eager::find_solution),
+          "search_context"_a,
+          "heuristics"_a,
+          "options"_a);
 
     // GBFS_LAZY
     nb::class_<gbfs_lazy::Statistics>(m, "GBFSLazyStatistics")  //
@@ -896,6 +1145,9 @@ void bind_module_definitions(nb::module_& m)
         .def("get_num_expanded", &gbfs_lazy::Statistics::get_num_expanded)
         .def("get_num_deadends", &gbfs_lazy::Statistics::get_num_deadends)
         .def("get_num_pruned", &gbfs_lazy::Statistics::get_num_pruned)
+        .def("get_num_unpacked_state_cache_hits", &gbfs_lazy::Statistics::get_num_unpacked_state_cache_hits)
+        .def("get_num_unpacked_state_cache_misses", &gbfs_lazy::Statistics::get_num_unpacked_state_cache_misses)
+        .def("get_unpacked_state_cache_hit_rate", &gbfs_lazy::Statistics::get_unpacked_state_cache_hit_rate)
         .def("get_search_time_ms", &gbfs_lazy::Statistics::get_search_time_ms);
 
     nb::class_<gbfs_lazy::IEventHandler, IPyGBFSLazyEventHandler>(m, "IGBFSLazyEventHandler")  //
@@ -904,6 +1156,7 @@ void bind_module_definitions(nb::module_& m)
         .def("on_expand_goal_state", &gbfs_lazy::IEventHandler::on_expand_goal_state)
         .def("on_generate_state", &gbfs_lazy::IEventHandler::on_generate_state)
         .def("on_prune_state", &gbfs_lazy::IEventHandler::on_prune_state)
+        .def("on_lookup_unpacked_state", &gbfs_lazy::IEventHandler::on_lookup_unpacked_state)
         .def("on_start_search", &gbfs_lazy::IEventHandler::on_start_search)
         .def("on_new_best_h_value", &gbfs_lazy::IEventHandler::on_new_best_h_value)
         .def("on_end_search", &gbfs_lazy::IEventHandler::on_end_search)
@@ -928,7 +1181,9 @@ void bind_module_definitions(nb::module_& m)
         .def_rw("exploration_strategy", &gbfs_lazy::Options::exploration_strategy)
         .def_rw("max_num_states", &gbfs_lazy::Options::max_num_states)
         .def_rw("max_time_in_ms", &gbfs_lazy::Options::max_time_in_ms)
-        .def_rw("openlist_weights", &gbfs_lazy::Options::openlist_weights);
+        .def_rw("unpacked_state_cache_size", &gbfs_lazy::Options::unpacked_state_cache_size)
+        .def_rw("openlist_weights", &gbfs_lazy::Options::openlist_weights)
+        .def_rw("batch_size", &gbfs_lazy::Options::batch_size);
 
     m.def("find_solution_gbfs_lazy", &gbfs_lazy::find_solution, "search_context"_a, "heuristic"_a, "options"_a);
 
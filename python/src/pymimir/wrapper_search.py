@@ -3,10 +3,14 @@ from typing import Callable, Union
 from pymimir.advanced.formalism import GroundAction as AdvancedGroundAction
 from pymimir.advanced.search import AddHeuristic as AdvancedAddHeuristic
 from pymimir.advanced.search import BlindHeuristic as AdvancedBlindHeuristic
+from pymimir.advanced.search import CachingHeuristic as AdvancedCachingHeuristic
+from pymimir.advanced.search import CanonicalPDBsHeuristic as AdvancedCanonicalPDBsHeuristic
 from pymimir.advanced.search import DeleteRelaxedProblemExplorator as AdvancedDeleteRelaxedProblemExplorator
 from pymimir.advanced.search import FFHeuristic as AdvancedFFHeuristic
 from pymimir.advanced.search import IHeuristic as AdvancedHeuristicBase
+from pymimir.advanced.search import LMCutHeuristic as AdvancedLMCutHeuristic
 from pymimir.advanced.search import MaxHeuristic as AdvancedMaxHeuristic
+from pymimir.advanced.search import PDBHeuristic as AdvancedPDBHeuristic
 from pymimir.advanced.search import PerfectHeuristic as AdvancedPerfectHeuristic
 from pymimir.advanced.search import PreferredActions as AdvancedPreferredActions
 from pymimir.advanced.search import SetAddHeuristic as AdvancedSetAddHeuristic
@@ -195,6 +199,159 @@ class FFHeuristic(Heuristic):
         return { GroundAction(advanced_ground_action, self._problem) for advanced_ground_action in self._advanced_heuristic.get_preferred_actions().data }
 
 
+class LMCutHeuristic(Heuristic):
+    def __init__(self, problem: 'Problem') -> None:
+        super().__init__()
+        assert isinstance(problem, Problem), "Problem must be an instance of Problem."
+        self._problem = problem
+        delete_relaxed = AdvancedDeleteRelaxedProblemExplorator(problem._advanced_problem)
+        self._advanced_heuristic = AdvancedLMCutHeuristic.create(delete_relaxed)
+
+    def get_problem(self) -> 'Problem':
+        """
+        Get the problem instance associated with this heuristic.
+
+        :return: The problem instance.
+        :rtype: Problem
+        """
+        return self._problem
+
+    def compute_value(self, state: 'State', is_goal_state: bool) -> float:
+        return self._advanced_heuristic.compute_heuristic(state._advanced_state, is_goal_state)
+
+    def get_preferred_actions(self) -> 'set[GroundAction]':
+        return { GroundAction(advanced_ground_action, self._problem) for advanced_ground_action in self._advanced_heuristic.get_preferred_actions().data }
+
+
+class PDBHeuristic(Heuristic):
+    def __init__(self, problem: 'Problem', pattern: 'list[int] | None' = None, cache_directory: 'str | None' = None) -> None:
+        """
+        Initialize the admissible heuristic of a single pattern database.
+
+        :param problem: The problem instance.
+        :type problem: Problem
+        :param pattern: The variable indices of the pattern, or None to compute a greedy pattern.
+        :type pattern: list[int] | None
+        :param cache_directory: The directory that the pattern database is loaded from and written to, or None to disable caching.
+        :type cache_directory: str | None
+        """
+        super().__init__()
+        assert isinstance(problem, Problem), "Problem must be an instance of Problem."
+        self._problem = problem
+        delete_relaxed = AdvancedDeleteRelaxedProblemExplorator(problem._advanced_problem)
+        self._advanced_heuristic = AdvancedPDBHeuristic.create(delete_relaxed, pattern=pattern, cache_directory=cache_directory)
+
+    def get_problem(self) -> 'Problem':
+        """
+        Get the problem instance associated with this heuristic.
+
+        :return: The problem instance.
+        :rtype: Problem
+        """
+        return self._problem
+
+    def compute_value(self, state: 'State', is_goal_state: bool) -> float:
+        return self._advanced_heuristic.compute_heuristic(state._advanced_state, is_goal_state)
+
+    def get_preferred_actions(self) -> 'set[GroundAction]':
+        return { GroundAction(advanced_ground_action, self._problem) for advanced_ground_action in self._advanced_heuristic.get_preferred_actions().data }
+
+
+class CanonicalPDBsHeuristic(Heuristic):
+    def __init__(self, problem: 'Problem', patterns: 'list[list[int]] | None' = None, cache_directory: 'str | None' = None) -> None:
+        """
+        Initialize the canonical heuristic of a pattern collection.
+
+        :param problem: The problem instance.
+        :type problem: Problem
+        :param patterns: The variable indices of the patterns, or None to compute them with hill climbing.
+        :type patterns: list[list[int]] | None
+        :param cache_directory: The directory that the pattern databases are loaded from and written to, or None to disable caching.
+        :type cache_directory: str | None
+        """
+        super().__init__()
+        assert isinstance(problem, Problem), "Problem must be an instance of Problem."
+        self._problem = problem
+        delete_relaxed = AdvancedDeleteRelaxedProblemExplorator(problem._advanced_problem)
+        self._advanced_heuristic = AdvancedCanonicalPDBsHeuristic.create(delete_relaxed, patterns=patterns, cache_directory=cache_directory)
+
+    def get_problem(self) -> 'Problem':
+        """
+        Get the problem instance associated with this heuristic.
+
+        :return: The problem instance.
+        :rtype: Problem
+        """
+        return self._problem
+
+    def compute_value(self, state: 'State', is_goal_state: bool) -> float:
+        return self._advanced_heuristic.compute_heuristic(state._advanced_state, is_goal_state)
+
+    def get_preferred_actions(self) -> 'set[GroundAction]':
+        return { GroundAction(advanced_ground_action, self._problem) for advanced_ground_action in self._advanced_heuristic.get_preferred_actions().data }
+
+
+class CachingHeuristic(Heuristic):
+    def __init__(self, problem: 'Problem', heuristic: 'Heuristic', max_num_entries: int = 1_000_000, max_num_preferred_actions: int = 10_000_000) -> None:
+        """
+        Initialize a cache of the values and preferred actions of another heuristic, which pays off for expensive heuristics
+        that are evaluated repeatedly on the same states, e.g., heuristics implemented in Python.
+
+        :param problem: The problem instance.
+        :type problem: Problem
+        :param heuristic: The heuristic to cache.
+        :type heuristic: Heuristic
+        :param max_num_entries: The maximum number of cached states, beyond which the least recently used state is evicted.
+        :type max_num_entries: int
+        :param max_num_preferred_actions: The maximum total number of preferred actions over all cached states, beyond which the least recently used states are evicted.
+        :type max_num_preferred_actions: int
+        """
+        super().__init__()
+        assert isinstance(problem, Problem), "Problem must be an instance of Problem."
+        assert isinstance(heuristic, Heuristic), "Heuristic must be an instance of Heuristic."
+        assert isinstance(max_num_entries, int), "max_num_entries must be an int."
+        assert isinstance(max_num_preferred_actions, int), "max_num_preferred_actions must be an int."
+        self._problem = problem
+        self._heuristic = heuristic
+        if hasattr(heuristic, '_advanced_heuristic') and isinstance(heuristic._advanced_heuristic, AdvancedHeuristicBase):  # type: ignore
+            advanced_heuristic = heuristic._advanced_heuristic  # type: ignore
+        else:
+            advanced_heuristic = AdvancedHeuristicAdapter(heuristic, problem)
+        self._advanced_heuristic = AdvancedCachingHeuristic.create(advanced_heuristic,
+                                                                   max_num_entries=max_num_entries,
+                                                                   max_num_preferred_actions=max_num_preferred_actions)
+
+    def get_problem(self) -> 'Problem':
+        """
+        Get the problem instance associated with this heuristic.
+
+        :return: The problem instance.
+        :rtype: Problem
+        """
+        return self._problem
+
+    def compute_value(self, state: 'State', is_goal_state: bool) -> float:
+        return self._advanced_heuristic.compute_heuristic(state._advanced_state, is_goal_state)
+
+    def get_preferred_actions(self) -> 'set[GroundAction]':
+        return { GroundAction(advanced_ground_action, self._problem) for advanced_ground_action in self._advanced_heuristic.get_preferred_actions().data }
+
+    def get_hit_rate(self) -> float:
+        """
+        Get the fraction of evaluations that were answered from the cache.
+
+        :return: The hit rate.
+        :rtype: float
+        """
+        return self._advanced_heuristic.get_statistics().get_hit_rate()
+
+    def clear(self) -> None:
+        """
+        Remove all states from the cache.
+        """
+        self._advanced_heuristic.clear()
+
+
 # -----------------
 # Search algorithms
 # -----------------
@@ -327,6 +484,7 @@ def astar_eager(problem: 'Problem',
 
         # The following events are ignored in this interface.
         def on_close_state(self, arg0): pass
+        def on_lookup_unpacked_state(self, arg0): pass
         def on_end_search(self, arg0, arg1, arg2, arg3, arg4, arg5): pass
         def on_exhausted(self): pass
         def on_generate_state_not_relaxed(self, arg0, arg1, arg2, arg3): pass
@@ -18,220 +18,356 @@
 #include "mimir/algorithms/kpkc.hpp"
 
 #include "mimir/algorithms/unique_object_pool.hpp"
-#include "mimir/common/collections.hpp"
 
-#include <functional>
-#include <iostream>
+#include <bit>
 #include <limits>
+#include <stdexcept>
 #include <vector>
 
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define MIMIR_KPKC_X86_KERNELS
+#include <immintrin.h>
+#endif
+
 namespace mimir
 {
 
+using Block = BitMatrix::Block;
+using BlockList = std::vector<Block, cista::aligned_allocator<Block, 64>>;
+
 /**
- * Heap-managed coroutine variables.
+ * Kernels
+ *
+ * Each kernel writes the intersection of two 64-byte aligned rows of `num_blocks` blocks into `out_blocks`
+ * and returns the number of bits in the intersection. `num_blocks` is a multiple of `BitMatrix::BLOCKS_PER_CACHE_LINE`.
  */
 
-static thread_local UniqueObjectPool<std::vector<uint32_t>> s_solution_pool;
-using SolutionPtr = UniqueObjectPoolPtr<std::vector<uint32_t>>;
+using IntersectKernel = size_t (*)(const Block* lhs, const Block* rhs, Block* out_blocks, size_t num_blocks);
 
-static thread_local UniqueObjectPool<boost::dynamic_bitset<>> s_bitset_pool;
-using BitsetUniquePtr = UniqueObjectPoolPtr<boost::dynamic_bitset<>>;
+static size_t intersect_and_count_scalar(const Block* lhs, const Block* rhs, Block* out_blocks, size_t num_blocks)
+{
+    auto count = size_t(0);
+    for (size_t i = 0; i < num_blocks; ++i)
+    {
+        out_blocks[i] = lhs[i] & rhs[i];
+        count += std::popcount(out_blocks[i]);
+    }
+    return count;
+}
 
-static thread_local UniqueObjectPool<std::vector<BitsetUniquePtr>> s_bitset_list_pool;
-using BitsetListUniquePtr = UniqueObjectPoolPtr<std::vector<BitsetUniquePtr>>;
+#ifdef MIMIR_KPKC_X86_KERNELS
 
-static thread_local UniqueObjectPool<std::vector<BitsetListUniquePtr>> s_bitset_list_list_pool;
-using BitsetMatrixUniquePtr = UniqueObjectPoolPtr<std::vector<BitsetListUniquePtr>>;
+/// @brief AVX2 has no popcount instruction, so we count the bits of each nibble with a lookup table in a shuffle.
+__attribute__((target("avx2"))) static size_t intersect_and_count_avx2(const Block* lhs, const Block* rhs, Block* out_blocks, size_t num_blocks)
+{
+    const auto lookup = _mm256_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4, 0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+    const auto low_mask = _mm256_set1_epi8(0x0f);
+    const auto zero = _mm256_setzero_si256();
+    auto accumulator = _mm256_setzero_si256();
 
-/**
- * Recursive call
- */
+    for (size_t i = 0; i < num_blocks; i += 4)
+    {
+        const auto intersection = _mm256_and_si256(_mm256_load_si256(reinterpret_cast<const __m256i*>(lhs + i)),
+                                                   _mm256_load_si256(reinterpret_cast<const __m256i*>(rhs + i)));
+        _mm256_store_si256(reinterpret_cast<__m256i*>(out_blocks + i), intersection);
 
-mimir::generator<const std::vector<uint32_t>&> find_all_k_cliques_in_k_partite_graph_helper(const std::vector<boost::dynamic_bitset<>>& adjacency_matrix,
-                                                                                            const std::vector<std::vector<uint32_t>>& partitions,
-                                                                                            std::vector<uint32_t>& partial_solution,
-                                                                                            boost::dynamic_bitset<>& partition_bits,
-                                                                                            std::vector<BitsetListUniquePtr>& k_compatible_vertices,
-                                                                                            uint32_t depth)
-{
-    assert(depth < partitions.size());
+        const auto low_counts = _mm256_shuffle_epi8(lookup, _mm256_and_si256(intersection, low_mask));
+        const auto high_counts = _mm256_shuffle_epi8(lookup, _mm256_and_si256(_mm256_srli_epi16(intersection, 4), low_mask));
+        accumulator = _mm256_add_epi64(accumulator, _mm256_sad_epu8(_mm256_add_epi8(low_counts, high_counts), zero));
+    }
 
-    uint32_t k = partitions.size();
-    uint32_t best_set_bits = std::numeric_limits<uint32_t>::max();
-    uint32_t best_partition = std::numeric_limits<uint32_t>::max();
+    return _mm256_extract_epi64(accumulator, 0) + _mm256_extract_epi64(accumulator, 1) + _mm256_extract_epi64(accumulator, 2)
+           + _mm256_extract_epi64(accumulator, 3);
+}
 
-    assert(is_within_bounds(k_compatible_vertices, depth));
-    auto& compatible_vertices = *k_compatible_vertices[depth];
+__attribute__((target("avx512f,avx512vpopcntdq"))) static size_t
+intersect_and_count_avx512(const Block* lhs, const Block* rhs, Block* out_blocks, size_t num_blocks)
+{
+    auto accumulator = _mm512_set1_epi64(0);
 
-    // Find the best partition to work with
-    for (uint32_t partition = 0; partition < k; ++partition)
+    for (size_t i = 0; i < num_blocks; i += 8)
     {
-        assert(is_within_bounds(compatible_vertices, partition));
-        auto num_set_bits = compatible_vertices[partition]->count();
-        if (!partition_bits[partition] && (num_set_bits < best_set_bits))
-        {
-            best_set_bits = num_set_bits;
-            best_partition = partition;
-        }
+        const auto intersection = _mm512_and_si512(_mm512_load_si512(lhs + i), _mm512_load_si512(rhs + i));
+        _mm512_store_si512(out_blocks + i, intersection);
+        accumulator = _mm512_add_epi64(accumulator, _mm512_popcnt_epi64(intersection));
     }
 
-    // Iterate through compatible vertices in the best partition
-    assert(is_within_bounds(compatible_vertices, best_partition));
-    auto& best_partition_compatible_vertices = *compatible_vertices[best_partition];
-    uint32_t adjacent_index = best_partition_compatible_vertices.find_first();
-    while (adjacent_index < best_partition_compatible_vertices.size())
-    {
-        assert(is_within_bounds(partitions, best_partition) && is_within_bounds(partitions[best_partition], adjacent_index));
-        uint32_t vertex = partitions[best_partition][adjacent_index];
-        assert(is_within_bounds(compatible_vertices, best_partition) && is_within_bounds(best_partition_compatible_vertices, adjacent_index));
-        best_partition_compatible_vertices[adjacent_index] = 0;
+    alignas(64) uint64_t counts[8];
+    _mm512_store_si512(counts, accumulator);
+    return counts[0] + counts[1] + counts[2] + counts[3] + counts[4] + counts[5] + counts[6] + counts[7];
+}
 
-        partial_solution.push_back(vertex);
+#endif
 
-        if (partial_solution.size() == k)
-        {
-            co_yield partial_solution;
-        }
-        else
-        {
-            assert(partial_solution.size() - 1 == depth);
+bool is_supported(KPKCKernel kernel)
+{
+    switch (kernel)
+    {
+        case KPKCKernel::SCALAR:
+            return true;
+#ifdef MIMIR_KPKC_X86_KERNELS
+        case KPKCKernel::AVX2:
+            return __builtin_cpu_supports("avx2");
+        case KPKCKernel::AVX512:
+            return __builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512vpopcntdq");
+#endif
+        default:
+            return false;
+    }
+}
 
-            // Update compatible vertices for the next recursion
-            assert(is_within_bounds(k_compatible_vertices, depth + 1));
-            auto& compatible_vertices_next = *k_compatible_vertices[depth + 1];
-            for (uint32_t partition = 0; partition < k; ++partition)
-            {
-                assert(is_within_bounds(compatible_vertices_next, partition));
-                assert(is_within_bounds(compatible_vertices, partition));
-                auto& partition_compatible_vertices_next = *compatible_vertices_next[partition];
-                auto& partition_compatible_vertices = *compatible_vertices[partition];
-                assert(partition_compatible_vertices_next.size() == partition_compatible_vertices.size());
-                partition_compatible_vertices_next = partition_compatible_vertices;  // copy bitsets from current to next iteration
-            }
+KPKCKernel get_default_kpkc_kernel()
+{
+    static const auto kernel = is_supported(KPKCKernel::AVX512) ? KPKCKernel::AVX512 :
+                               is_supported(KPKCKernel::AVX2)   ? KPKCKernel::AVX2 :
+                                                                  KPKCKernel::SCALAR;
+    return kernel;
+}
 
-            uint32_t offset = 0;
-            for (uint32_t partition = 0; partition < k; ++partition)
-            {
-                assert(is_within_bounds(compatible_vertices_next, partition));
-                auto& partition_compatible_vertices_next = *compatible_vertices_next[partition];
-                auto partition_size = partition_compatible_vertices_next.size();
-                if (!partition_bits[partition])
-                {
-                    for (uint32_t index = 0; index < partition_size; ++index)
-                    {
-                        assert(is_within_bounds(compatible_vertices_next, partition));
-                        partition_compatible_vertices_next[index] &= adjacency_matrix[vertex][index + offset];
-                    }
-                }
-                offset += partition_size;
-            }
+static IntersectKernel get_intersect_kernel(KPKCKernel kernel)
+{
+    if (!is_supported(kernel))
+    {
+        throw std::runtime_error("get_intersect_kernel(kernel): the kernel is not supported by the processor.");
+    }
 
-            partition_bits[best_partition] = 1;
+    switch (kernel)
+    {
+#ifdef MIMIR_KPKC_X86_KERNELS
+        case KPKCKernel::AVX2:
+            return &intersect_and_count_avx2;
+        case KPKCKernel::AVX512:
+            return &intersect_and_count_avx512;
+#endif
+        default:
+            return &intersect_and_count_scalar;
+    }
+}
 
-            uint32_t possible_additions = 0;
-            for (uint32_t partition = 0; partition < k; ++partition)
-            {
-                assert(is_within_bounds(compatible_vertices, partition));
-                auto& partition_compatible_vertices = *compatible_vertices[partition];
-                if (!partition_bits[partition] && partition_compatible_vertices.any())
-                {
-                    ++possible_additions;
-                }
-            }
+/**
+ * Bit ranges
+ *
+ * Partitions occupy the bit range [offset, offset + size) of a row, which need not be aligned to blocks.
+ */
 
-            if ((partial_solution.size() + possible_additions) == k)
-            {
-                for (const auto& result : find_all_k_cliques_in_k_partite_graph_helper(adjacency_matrix,
-                                                                                       partitions,
-                                                                                       partial_solution,
-                                                                                       partition_bits,
-                                                                                       k_compatible_vertices,
-                                                                                       depth + 1))
-                {
-                    co_yield result;
-                }
-            }
+static Block get_range_mask(size_t block, size_t begin, size_t end)
+{
+    const auto first_bit = std::max(begin, block * BitMatrix::BITS_PER_BLOCK) - block * BitMatrix::BITS_PER_BLOCK;
+    const auto last_bit = std::min(end, (block + 1) * BitMatrix::BITS_PER_BLOCK) - block * BitMatrix::BITS_PER_BLOCK;
+    const auto upper = (last_bit == BitMatrix::BITS_PER_BLOCK) ? std::numeric_limits<Block>::max() : ((Block(1) << last_bit) - 1);
+    return upper & (std::numeric_limits<Block>::max() << first_bit);
+}
 
-            partition_bits[best_partition] = 0;
-        }
+static size_t count_range(const Block* blocks, size_t begin, size_t end)
+{
+    auto count = size_t(0);
+    for (size_t block = begin / BitMatrix::BITS_PER_BLOCK; block * BitMatrix::BITS_PER_BLOCK < end; ++block)
+    {
+        count += std::popcount(blocks[block] & get_range_mask(block, begin, end));
+    }
+    return count;
+}
 
-        partial_solution.pop_back();
+static void reset_range(Block* blocks, size_t begin, size_t end)
+{
+    for (size_t block = begin / BitMatrix::BITS_PER_BLOCK; block * BitMatrix::BITS_PER_BLOCK < end; ++block)
+    {
+        blocks[block] &= ~get_range_mask(block, begin, end);
+    }
+}
 
-        adjacent_index = best_partition_compatible_vertices.find_next(adjacent_index);
+/// @brief Return the position of the first bit in [begin, end), or `end` if there is none.
+static size_t find_first_in_range(const Block* blocks, size_t begin, size_t end)
+{
+    for (size_t block = begin / BitMatrix::BITS_PER_BLOCK; block * BitMatrix::BITS_PER_BLOCK < end; ++block)
+    {
+        const auto bits = blocks[block] & get_range_mask(block, begin, end);
+        if (bits)
+        {
+            return block * BitMatrix::BITS_PER_BLOCK + std::countr_zero(bits);
+        }
     }
+    return end;
 }
 
-bool verify_input_dimensions(const std::vector<boost::dynamic_bitset<>>& adjacency_matrix, const std::vector<std::vector<uint32_t>>& partitions)
+/**
+ * Heap-managed coroutine variables.
+ */
+
+/// @brief The memory of one enumeration, which is allocated once per thread and reused across enumerations.
+struct KPKCWorkspace
 {
-    size_t total_vertices = 0;
-    for (const auto& partition : partitions)
-        total_vertices += partition.size();
+    BlockList candidates;                 ///< The candidate vertices at each depth, each of `num_blocks` blocks.
+    std::vector<uint32_t> offsets;        ///< The first column of each partition, followed by the number of vertices.
+    std::vector<uint32_t> partition_at;   ///< The partition from which the vertex at each depth is chosen.
+    std::vector<uint32_t> next_position;  ///< The next column to try at each depth.
+    std::vector<bool> used_partitions;
+    std::vector<uint32_t> solution;
+};
+
+static thread_local UniqueObjectPool<KPKCWorkspace> s_workspace_pool;
+
+/// @brief Choose the partition with the fewest candidates among the unused partitions at the given depth.
+/// @return false iff an unused partition has no candidates, such that no clique extends the partial solution.
+static bool select_partition(KPKCWorkspace& workspace, const Block* candidates, uint32_t depth)
+{
+    const auto k = static_cast<uint32_t>(workspace.used_partitions.size());
 
-    if (adjacency_matrix.size() != total_vertices)
-        return false;
+    auto best_count = std::numeric_limits<size_t>::max();
+    auto best_partition = std::numeric_limits<uint32_t>::max();
 
-    for (const auto& row : adjacency_matrix)
+    for (uint32_t partition = 0; partition < k; ++partition)
     {
-        if (row.size() != total_vertices)
+        if (workspace.used_partitions[partition])
+        {
+            continue;
+        }
+
+        const auto count = count_range(candidates, workspace.offsets[partition], workspace.offsets[partition + 1]);
+        if (count == 0)
+        {
             return false;
+        }
+        if (count < best_count)
+        {
+            best_count = count;
+            best_partition = partition;
+        }
     }
 
+    workspace.partition_at[depth] = best_partition;
+    workspace.next_position[depth] = workspace.offsets[best_partition];
+    workspace.used_partitions[best_partition] = true;
+
     return true;
 }
 
-mimir::generator<const std::vector<uint32_t>&> create_k_clique_in_k_partite_graph_generator(const std::vector<boost::dynamic_bitset<>>& adjacency_matrix,
-                                                                                            const std::vector<std::vector<uint32_t>>& partitions)
+bool verify_input_dimensions(const BitMatrix& adjacency_matrix, const std::vector<std::vector<uint32_t>>& partitions)
 {
-    assert(verify_input_dimensions(adjacency_matrix, partitions));
-
-    const auto k = partitions.size();
+    size_t total_vertices = 0;
+    for (const auto& partition : partitions)
+        total_vertices += partition.size();
 
-    /* Allocate and initialize solution */
-    auto solution = s_solution_pool.get_or_allocate();
-    solution->clear();
+    return adjacency_matrix.get_num_vertices() == total_vertices;
+}
 
-    /* Allocate and initialize partition bits */
-    auto partition_bits = s_bitset_pool.get_or_allocate();
-    partition_bits->reset();
-    partition_bits->resize(k, false);
+/**
+ * Enumeration
+ *
+ * We descend with an explicit stack instead of recursive coroutines to avoid allocating coroutine frames in the inner loop.
+ * The candidates at depth d+1 are the candidates at depth d intersected with the neighbors of the vertex chosen at depth d,
+ * minus the remaining vertices in its partition. Hence, the candidates at depth d only contain vertices of unused partitions.
+ */
 
-    /* Allocate and initialize k_compatible_vertices */
-    auto k_compatible_vertices = s_bitset_list_list_pool.get_or_allocate();
+/// @brief Enumerate the k-cliques, where `initial_candidates` restricts the vertices if it is not nullptr.
+static mimir::generator<const std::vector<uint32_t>&> enumerate_k_cliques(const BitMatrix& adjacency_matrix,
+                                                                          const std::vector<std::vector<uint32_t>>& partitions,
+                                                                          const Block* initial_candidates,
+                                                                          KPKCKernel kernel)
+{
+    assert(verify_input_dimensions(adjacency_matrix, partitions));
 
-    k_compatible_vertices->clear();
-    k_compatible_vertices->resize(k);
+    const auto intersect_and_count = get_intersect_kernel(kernel);
+    const auto k = static_cast<uint32_t>(partitions.size());
+    const auto num_vertices = adjacency_matrix.get_num_vertices();
+    const auto num_blocks = adjacency_matrix.get_num_blocks_per_row();
 
-    for (uint32_t k1 = 0; k1 < k; ++k1)
+    if (k == 0)
     {
-        auto biset_vec = s_bitset_list_pool.get_or_allocate();
-
-        biset_vec->clear();
-        biset_vec->resize(k);
+        co_return;
+    }
 
-        (*k_compatible_vertices)[k1] = std::move(biset_vec);
+    /* Allocate and initialize the workspace */
+    auto workspace_ptr = s_workspace_pool.get_or_allocate();
+    auto& workspace = *workspace_ptr;
 
-        for (uint32_t k2 = 0; k2 < k; ++k2)
-        {
-            auto bitset = s_bitset_pool.get_or_allocate();
+    workspace.candidates.assign(k * num_blocks, 0);
+    workspace.offsets.assign(k + 1, 0);
+    for (uint32_t partition = 0; partition < k; ++partition)
+    {
+        workspace.offsets[partition + 1] = workspace.offsets[partition] + partitions[partition].size();
+    }
+    workspace.partition_at.assign(k, 0);
+    workspace.next_position.assign(k, 0);
+    workspace.used_partitions.assign(k, false);
+    workspace.solution.assign(k, 0);
 
-            bitset->reset();
-            bitset->resize(partitions[k2].size(), false);
+    const auto get_candidates = [&](uint32_t depth) { return workspace.candidates.data() + depth * num_blocks; };
 
-            (*(*k_compatible_vertices)[k1])[k2] = std::move(bitset);
-        }
+    for (size_t block = 0; block * BitMatrix::BITS_PER_BLOCK < num_vertices; ++block)
+    {
+        get_candidates(0)[block] = get_range_mask(block, 0, num_vertices) & (initial_candidates ? initial_candidates[block] : ~Block(0));
     }
 
-    for (uint32_t k1 = 0; k1 < k; ++k1)
+    if (!select_partition(workspace, get_candidates(0), 0))
     {
-        (*k_compatible_vertices->front())[k1]->set();
+        co_return;
     }
 
     /* Enumerate all k-cliques. */
-    for (const auto& result : find_all_k_cliques_in_k_partite_graph_helper(adjacency_matrix, partitions, *solution, *partition_bits, *k_compatible_vertices, 0))
+    auto depth = uint32_t(0);
+    while (true)
     {
-        co_yield result;
+        const auto partition = workspace.partition_at[depth];
+        const auto column = find_first_in_range(get_candidates(depth), workspace.next_position[depth], workspace.offsets[partition + 1]);
+
+        if (column == workspace.offsets[partition + 1])
+        {
+            // Backtrack
+            workspace.used_partitions[partition] = false;
+            if (depth == 0)
+            {
+                break;
+            }
+            --depth;
+            continue;
+        }
+
+        workspace.next_position[depth] = column + 1;
+
+        const auto vertex = partitions[partition][column - workspace.offsets[partition]];
+        workspace.solution[depth] = vertex;
+
+        if (depth + 1 == k)
+        {
+            co_yield workspace.solution;
+            continue;
+        }
+
+        // Update candidates for the next depth
+        auto next_candidates = get_candidates(depth + 1);
+        auto num_candidates = intersect_and_count(get_candidates(depth), adjacency_matrix.get_row(vertex), next_candidates, num_blocks);
+        num_candidates -= count_range(next_candidates, workspace.offsets[partition], workspace.offsets[partition + 1]);
+        reset_range(next_candidates, workspace.offsets[partition], workspace.offsets[partition + 1]);
+
+        // Every remaining partition needs at least one candidate
+        if (num_candidates < k - (depth + 1))
+        {
+            continue;
+        }
+
+        if (select_partition(workspace, next_candidates, depth + 1))
+        {
+            ++depth;
+        }
     }
 }
 
+mimir::generator<const std::vector<uint32_t>&> create_k_clique_in_k_partite_graph_generator(const BitMatrix& adjacency_matrix,
+                                                                                            const std::vector<std::vector<uint32_t>>& partitions,
+                                                                                            KPKCKernel kernel)
+{
+    return enumerate_k_cliques(adjacency_matrix, partitions, nullptr, kernel);
+}
+
+mimir::generator<const std::vector<uint32_t>&> create_k_clique_in_k_partite_graph_generator(const BitMatrix& adjacency_matrix,
+                                                                                            const std::vector<std::vector<uint32_t>>& partitions,
+                                                                                            std::span<const BitMatrix::Block> candidates,
+                                                                                            KPKCKernel kernel)
+{
+    assert(candidates.size() == adjacency_matrix.get_num_blocks_per_row());
+
+    return enumerate_k_cliques(adjacency_matrix, partitions, candidates.data(), kernel);
+}
+
 }
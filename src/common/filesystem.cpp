@@ -17,6 +17,13 @@
 
 #include "mimir/common/filesystem.hpp"
 
+#include <cstdint>
+#include <iomanip>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+
 namespace mimir
 {
 void write_to_file(const fs::path& filePath, const std::string& content)
@@ -48,4 +55,40 @@ void write_to_file(const fs::path& filePath, const std::string& content)
 
     // Close the file stream automatically when the function exits and fileStream goes out of scope.
 }
+
+static fs::path get_unique_temporary_file(const fs::path& file)
+{
+    // Random bits from the operating system together with the thread make collisions between processes and threads negligible.
+    auto device = std::random_device {};
+    const auto random = (uint64_t(device()) << 32) ^ uint64_t(device()) ^ std::hash<std::thread::id> {}(std::this_thread::get_id());
+
+    auto ss = std::stringstream {};
+    ss << file.filename().string() << ".tmp-" << std::hex << std::setfill('0') << std::setw(16) << random;
+
+    return file.parent_path() / ss.str();
+}
+
+void write_to_file_atomically(const fs::path& file, const std::function<void(std::ostream&)>& write)
+{
+    const auto temporary_file = get_unique_temporary_file(file);
+
+    try
+    {
+        {
+            auto out = std::ofstream(temporary_file, std::ios::binary | std::ios::trunc);
+            write(out);
+            out.flush();
+
+            if (!out)
+                throw std::runtime_error("write_to_file_atomically: Failed to write " + temporary_file.string() + ".");
+        }
+        fs::rename(temporary_file, file);
+    }
+    catch (...)
+    {
+        auto error = std::error_code {};
+        fs::remove(temporary_file, error);
+        throw;
+    }
+}
 }
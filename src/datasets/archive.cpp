@@ -0,0 +1,348 @@
+/*
+ * Copyright (C) 2023 Dominik Drexler and Simon Stahlberg
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "mimir/datasets/archive.hpp"
+
+#include "cista/serialization.h"
+#include "mimir/common/filesystem.hpp"
+#include "mimir/datasets/generalized_state_space.hpp"
+#include "mimir/datasets/knowledge_base.hpp"
+#include "mimir/datasets/state_space.hpp"
+#include "mimir/datasets/tuple_graph.hpp"
+#include "mimir/formalism/action.hpp"
+#include "mimir/formalism/domain.hpp"
+#include "mimir/formalism/function_skeleton.hpp"
+#include "mimir/formalism/ground_action.hpp"
+#include "mimir/formalism/ground_atom.hpp"
+#include "mimir/formalism/ground_function.hpp"
+#include "mimir/formalism/object.hpp"
+#include "mimir/formalism/predicate.hpp"
+#include "mimir/formalism/problem.hpp"
+#include "mimir/formalism/repositories.hpp"
+#include "mimir/search/search_context.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <initializer_list>
+#include <ranges>
+#include <stdexcept>
+
+using namespace mimir::formalism;
+
+namespace mimir::datasets
+{
+
+/// @brief The version of the cista mode includes a hash of the archive types, which detects layout changes that miss a version bump.
+/// The integrity checksum detects truncated or corrupted files.
+constexpr auto SERIALIZATION_MODE = cista::mode::WITH_VERSION | cista::mode::WITH_INTEGRITY;
+
+/// @brief Opening checks the header, i.e., the type hash, but skips the checksum, which requires reading the whole file.
+constexpr auto OPEN_MODE = cista::mode::WITH_VERSION | cista::mode::SKIP_INTEGRITY;
+
+/// @brief Verification additionally checks the checksum and validates all offsets.
+constexpr auto VERIFY_MODE = SERIALIZATION_MODE | cista::mode::DEEP_CHECK;
+
+/// @brief Every compressed sparse row starts with offset 0, such that `archive::get_range` is valid even if no element is appended.
+static void start_ranges(std::initializer_list<archive::Vector<uint64_t>*> offsets)
+{
+    for (auto* ref_offsets : offsets)
+    {
+        ref_offsets->push_back(0);
+    }
+}
+
+template<typename Range, typename T>
+static void append_range(const Range& range, archive::Vector<uint64_t>& ref_offsets, archive::Vector<T>& ref_values)
+{
+    assert(!ref_offsets.empty());
+
+    for (const auto& value : range)
+    {
+        ref_values.push_back(value);
+    }
+    ref_offsets.push_back(ref_values.size());
+}
+
+static void set_filepath(const std::optional<fs::path>& filepath, archive::String& out_string)
+{
+    if (filepath)
+    {
+        out_string.set_owning(filepath->string());
+    }
+}
+
+static uint8_t compute_vertex_flags(bool is_initial, bool is_goal, bool is_unsolvable, bool is_alive)
+{
+    return static_cast<uint8_t>((is_initial ? archive::INITIAL : 0) | (is_goal ? archive::GOAL : 0) | (is_unsolvable ? archive::UNSOLVABLE : 0)
+                                | (is_alive ? archive::ALIVE : 0));
+}
+
+static void append_ground_element(Index symbol, const ObjectList& objects, archive::GroundTable& out_table)
+{
+    out_table.symbols.push_back(symbol);
+    append_range(objects | std::views::transform([](Object object) { return object->get_index(); }), out_table.object_offsets, out_table.objects);
+}
+
+/// @brief `GroundAtomTableBuilder` assigns positions in a `GroundTable` to ground atoms in the order of their first occurrence.
+template<IsFluentOrDerivedTag P>
+class GroundAtomTableBuilder
+{
+private:
+    const ProblemImpl& m_problem;
+    archive::GroundTable& m_table;
+    IndexMap<Index> m_positions;
+
+public:
+    GroundAtomTableBuilder(const ProblemImpl& problem, archive::GroundTable& table) : m_problem(problem), m_table(table), m_positions()
+    {
+        start_ranges({ &m_table.object_offsets });
+    }
+
+    Index get_or_create_position(Index atom_index)
+    {
+        const auto [it, inserted] = m_positions.emplace(atom_index, m_positions.size());
+        if (inserted)
+        {
+            const auto atom = m_problem.get_repositories().get_ground_atom<P>(atom_index);
+            append_ground_element(atom->get_predicate()->get_index(), atom->get_objects(), m_table);
+        }
+        return it->second;
+    }
+
+    template<std::ranges::input_range Range>
+    void append_positions(const Range& atom_indices, IndexList& ref_buffer, archive::Vector<uint64_t>& ref_offsets, archive::Vector<Index>& ref_values)
+    {
+        ref_buffer.clear();
+        for (const auto atom_index : atom_indices)
+        {
+            ref_buffer.push_back(get_or_create_position(atom_index));
+        }
+        std::sort(ref_buffer.begin(), ref_buffer.end());
+        append_range(ref_buffer, ref_offsets, ref_values);
+    }
+};
+
+static void to_archive(const StateSpaceImpl& state_space, GroundAtomTableBuilder<FluentTag>& fluent_atom_table, archive::ProblemGraph& out_graph)
+{
+    const auto& graph = state_space.get_graph();
+    const auto& problem = *state_space.get_search_context()->get_problem();
+
+    set_filepath(problem.get_filepath(), out_graph.problem_filepath);
+    out_graph.is_symmetry_reduced = state_space.is_symmetry_reduced();
+    out_graph.initial_vertex = state_space.get_initial_vertex();
+
+    start_ranges({ &out_graph.fluent_atom_offsets,
+                   &out_graph.derived_atom_offsets,
+                   &out_graph.numeric_variable_offsets,
+                   &out_graph.numeric_variable_table.object_offsets,
+                   &out_graph.action_table.object_offsets });
+
+    auto derived_atom_table = GroundAtomTableBuilder<DerivedTag>(problem, out_graph.derived_atom_table);
+    auto buffer = IndexList {};
+
+    for (const auto& vertex : graph.get_vertices())
+    {
+        const auto state = graphs::get_state(vertex);
+
+        out_graph.unit_goal_distances.push_back(graphs::get_unit_goal_distance(vertex));
+        out_graph.action_goal_distances.push_back(graphs::get_action_goal_distance(vertex));
+        out_graph.vertex_flags.push_back(
+            compute_vertex_flags(graphs::is_initial(vertex), graphs::is_goal(vertex), graphs::is_unsolvable(vertex), graphs::is_alive(vertex)));
+        fluent_atom_table.append_positions(state.get_atoms<FluentTag>(), buffer, out_graph.fluent_atom_offsets, out_graph.fluent_atoms);
+        derived_atom_table.append_positions(state.get_atoms<DerivedTag>(), buffer, out_graph.derived_atom_offsets, out_graph.derived_atoms);
+        append_range(state.get_numeric_variables(), out_graph.numeric_variable_offsets, out_graph.numeric_variables);
+    }
+
+    // Numeric variables are dense, such that the table must list every fluent ground function at its position.
+    auto functions = GroundFunctionList<FluentTag> {};
+    problem.get_repositories().get_ground_functions(0, functions);
+    for (const auto& function : functions)
+    {
+        append_ground_element(function->get_function_skeleton()->get_index(), function->get_objects(), out_graph.numeric_variable_table);
+    }
+
+    auto action_positions = IndexMap<Index> {};
+    for (const auto& edge : graph.get_edges())
+    {
+        const auto action = graphs::get_action(edge);
+        const auto [it, inserted] = action_positions.emplace(action->get_index(), action_positions.size());
+        if (inserted)
+        {
+            append_ground_element(action->get_action()->get_index(), action->get_objects(), out_graph.action_table);
+        }
+
+        out_graph.edge_sources.push_back(edge.get_source());
+        out_graph.edge_targets.push_back(edge.get_target());
+        out_graph.edge_actions.push_back(it->second);
+        out_graph.edge_action_costs.push_back(graphs::get_action_cost(edge));
+    }
+}
+
+static void to_archive(const GeneralizedStateSpaceImpl& generalized_state_space, archive::ClassGraph& out_graph)
+{
+    const auto& graph = generalized_state_space.get_graph();
+
+    for (const auto& vertex : graph.get_vertices())
+    {
+        const auto is_initial = generalized_state_space.get_initial_vertices().contains(vertex.get_index());
+        const auto is_goal = generalized_state_space.get_goal_vertices().contains(vertex.get_index());
+        const auto is_unsolvable = generalized_state_space.get_unsolvable_vertices().contains(vertex.get_index());
+
+        out_graph.vertex_problem_indices.push_back(graphs::get_problem_index(vertex));
+        out_graph.vertex_problem_vertex_indices.push_back(graphs::get_problem_vertex_index(vertex));
+        out_graph.vertex_flags.push_back(compute_vertex_flags(is_initial, is_goal, is_unsolvable, !(is_goal || is_unsolvable)));
+    }
+
+    for (const auto& edge : graph.get_edges())
+    {
+        out_graph.edge_sources.push_back(edge.get_source());
+        out_graph.edge_targets.push_back(edge.get_target());
+        out_graph.edge_problem_indices.push_back(graphs::get_problem_index(edge));
+        out_graph.edge_problem_edge_indices.push_back(graphs::get_problem_edge_index(edge));
+    }
+}
+
+static void to_archive(const TupleGraphImpl& tuple_graph, GroundAtomTableBuilder<FluentTag>& fluent_atom_table, archive::TupleGraph& out_graph)
+{
+    const auto& graph = tuple_graph.get_graph();
+
+    start_ranges({ &out_graph.atom_tuple_offsets,
+                   &out_graph.problem_vertex_offsets,
+                   &out_graph.vertices_by_distance_offsets,
+                   &out_graph.problem_vertices_by_distance_offsets });
+
+    auto buffer = IndexList {};
+
+    for (const auto& vertex : graph.get_vertices())
+    {
+        fluent_atom_table.append_positions(graphs::get_atom_tuple(vertex), buffer, out_graph.atom_tuple_offsets, out_graph.atom_tuples);
+        append_range(graphs::get_problem_vertices(vertex), out_graph.problem_vertex_offsets, out_graph.problem_vertices);
+    }
+
+    for (const auto& edge : graph.get_edges())
+    {
+        out_graph.edge_sources.push_back(edge.get_source());
+        out_graph.edge_targets.push_back(edge.get_target());
+    }
+
+    for (const auto& group : tuple_graph.get_tuple_vertex_indices_grouped_by_distance())
+    {
+        append_range(group, out_graph.vertices_by_distance_offsets, out_graph.vertices_by_distance);
+    }
+    for (const auto& group : tuple_graph.get_problem_vertex_indices_grouped_by_distance())
+    {
+        append_range(group, out_graph.problem_vertices_by_distance_offsets, out_graph.problem_vertices_by_distance);
+    }
+}
+
+/**
+ * KnowledgeBaseArchiveImpl
+ */
+
+KnowledgeBaseArchiveImpl::KnowledgeBaseArchiveImpl(const fs::path& filepath) :
+    m_mapping(filepath.c_str(), cista::mmap::protection::READ),
+    m_data(nullptr)
+{
+    // The data is used in place, since the offsets of the offset mode do not depend on the address of the mapping.
+    const auto* from = m_mapping.data();
+    const auto* to = m_mapping.data() + m_mapping.size();
+    try
+    {
+        cista::check<archive::KnowledgeBase, OPEN_MODE>(from, to);
+        cista::verify(m_mapping.size() >= cista::data_start(OPEN_MODE) + sizeof(archive::KnowledgeBase), "invalid range");
+    }
+    catch (const std::exception& e)
+    {
+        throw std::runtime_error("KnowledgeBaseArchiveImpl::KnowledgeBaseArchiveImpl: Invalid archive " + filepath.string() + ": " + e.what());
+    }
+    m_data = reinterpret_cast<const archive::KnowledgeBase*>(from + cista::data_start(OPEN_MODE));
+
+    if (m_data->magic != archive::FILE_MAGIC || m_data->version != archive::FILE_VERSION)
+    {
+        throw std::runtime_error("KnowledgeBaseArchiveImpl::KnowledgeBaseArchiveImpl: Unsupported format version of archive " + filepath.string() + ".");
+    }
+}
+
+KnowledgeBaseArchive KnowledgeBaseArchiveImpl::open(const fs::path& filepath) { return std::make_shared<const KnowledgeBaseArchiveImpl>(filepath); }
+
+void KnowledgeBaseArchiveImpl::verify() const
+{
+    try
+    {
+        // The mapping is read-only, so the data is only checked and not converted.
+        const auto& mapping = m_mapping;
+        cista::deserialize<archive::KnowledgeBase, VERIFY_MODE>(mapping);
+    }
+    catch (const std::exception& e)
+    {
+        throw std::runtime_error(std::string("KnowledgeBaseArchiveImpl::verify: Corrupted archive: ") + e.what());
+    }
+}
+
+void KnowledgeBaseArchiveImpl::write(const KnowledgeBaseImpl& knowledge_base, const fs::path& filepath)
+{
+    auto data = archive::KnowledgeBase {};
+    data.magic = archive::FILE_MAGIC;
+    data.version = archive::FILE_VERSION;
+    set_filepath(knowledge_base.get_domain()->get_filepath(), data.domain_filepath);
+
+    /* The tuple graphs of a state space refer to the fluent atom table of its problem graph. */
+    const auto& state_spaces = knowledge_base.get_state_spaces();
+    auto fluent_atom_tables = std::vector<GroundAtomTableBuilder<FluentTag>> {};
+    data.state_spaces.resize(state_spaces.size());
+    for (size_t i = 0; i < state_spaces.size(); ++i)
+    {
+        fluent_atom_tables.emplace_back(*state_spaces[i]->get_search_context()->get_problem(), data.state_spaces[i].fluent_atom_table);
+        to_archive(*state_spaces[i], fluent_atom_tables[i], data.state_spaces[i]);
+    }
+
+    data.has_generalized_state_space = knowledge_base.get_generalized_state_space().has_value();
+    if (data.has_generalized_state_space)
+    {
+        to_archive(*knowledge_base.get_generalized_state_space().value(), data.class_graph);
+    }
+
+    data.has_tuple_graphs = knowledge_base.get_tuple_graphs().has_value();
+    if (data.has_tuple_graphs)
+    {
+        const auto& tuple_graphs = knowledge_base.get_tuple_graphs().value();
+        data.tuple_graphs.resize(tuple_graphs.size());
+        for (size_t i = 0; i < tuple_graphs.size(); ++i)
+        {
+            data.tuple_graphs[i].resize(tuple_graphs[i].size());
+            for (size_t j = 0; j < tuple_graphs[i].size(); ++j)
+            {
+                to_archive(*tuple_graphs[i][j], fluent_atom_tables[i], data.tuple_graphs[i][j]);
+            }
+        }
+    }
+
+    const auto buffer = cista::serialize<SERIALIZATION_MODE>(data);
+
+    // Concurrent runs never map a partially written file.
+    write_to_file_atomically(filepath, [&buffer](std::ostream& out) { out.write(reinterpret_cast<const char*>(buffer.data()), buffer.size()); });
+}
+
+const archive::KnowledgeBase& KnowledgeBaseArchiveImpl::get_data() const { return *m_data; }
+
+const archive::ProblemGraph& KnowledgeBaseArchiveImpl::get_state_space(size_t pos) const { return m_data->state_spaces.at(pos); }
+
+size_t KnowledgeBaseArchiveImpl::get_num_state_spaces() const { return m_data->state_spaces.size(); }
+
+size_t KnowledgeBaseArchiveImpl::get_num_bytes() const { return m_mapping.size(); }
+
+}
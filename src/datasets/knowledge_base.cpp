@@ -30,11 +30,13 @@ namespace mimir::datasets
 KnowledgeBaseImpl::KnowledgeBaseImpl(formalism::Domain domain,
                                      StateSpaceList state_spaces,
                                      std::optional<GeneralizedStateSpace> generalized_state_space,
-                                     std::optional<std::vector<TupleGraphList>> tuple_graphs) :
+                                     std::optional<std::vector<TupleGraphList>> tuple_graphs,
+                                     std::optional<std::vector<size_t>> tuple_graph_workspace_memory_usage_in_bytes) :
     m_domain(std::move(domain)),
     m_state_spaces(std::move(state_spaces)),
     m_generalized_state_space(std::move(generalized_state_space)),
-    m_tuple_graphs(std::move(tuple_graphs))
+    m_tuple_graphs(std::move(tuple_graphs)),
+    m_tuple_graph_workspace_memory_usage_in_bytes(std::move(tuple_graph_workspace_memory_usage_in_bytes))
 {
 }
 
@@ -61,14 +63,20 @@ KnowledgeBase KnowledgeBaseImpl::create(search::GeneralizedSearchContext context
     }
 
     auto tuple_graphs = std::optional<std::vector<TupleGraphList>> { std::nullopt };
+    auto tuple_graph_workspace_memory_usage_in_bytes = std::optional<std::vector<size_t>> { std::nullopt };
     if (options.tuple_graph_options)
     {
         auto tmp_tuple_graphs = std::vector<TupleGraphList> {};
+        auto tmp_workspace_memory_usage_in_bytes = std::vector<size_t> {};
         for (auto& [state_space, certificate_maps] : state_spaces_result)
         {
-            tmp_tuple_graphs.push_back(TupleGraphImpl::create(state_space, certificate_maps, options.tuple_graph_options.value()));
+            auto workspace_memory_usage_in_bytes = size_t(0);
+            tmp_tuple_graphs.push_back(
+                TupleGraphImpl::create(state_space, certificate_maps, options.tuple_graph_options.value(), workspace_memory_usage_in_bytes));
+            tmp_workspace_memory_usage_in_bytes.push_back(workspace_memory_usage_in_bytes);
         }
         tuple_graphs = std::move(tmp_tuple_graphs);
+        tuple_graph_workspace_memory_usage_in_bytes = std::move(tmp_workspace_memory_usage_in_bytes);
     }
 
     /* Create final results */
@@ -84,7 +92,11 @@ KnowledgeBase KnowledgeBaseImpl::create(search::GeneralizedSearchContext context
         generalized_state_space = generalized_state_space_result->first;
     }
 
-    return std::make_shared<KnowledgeBaseImpl>(contexts->get_domain(), std::move(state_spaces), std::move(generalized_state_space), std::move(tuple_graphs));
+    return std::make_shared<KnowledgeBaseImpl>(contexts->get_domain(),
+                                               std::move(state_spaces),
+                                               std::move(generalized_state_space),
+                                               std::move(tuple_graphs),
+                                               std::move(tuple_graph_workspace_memory_usage_in_bytes));
 }
 
 /**
@@ -95,5 +107,9 @@ const formalism::Domain& KnowledgeBaseImpl::get_domain() const { return m_domain
 const StateSpaceList& KnowledgeBaseImpl::get_state_spaces() const { return m_state_spaces; }
 const std::optional<GeneralizedStateSpace>& KnowledgeBaseImpl::get_generalized_state_space() const { return m_generalized_state_space; }
 const std::optional<std::vector<TupleGraphList>>& KnowledgeBaseImpl::get_tuple_graphs() const { return m_tuple_graphs; }
+const std::optional<std::vector<size_t>>& KnowledgeBaseImpl::get_tuple_graph_workspace_memory_usage_in_bytes() const
+{
+    return m_tuple_graph_workspace_memory_usage_in_bytes;
+}
 
 }
\ No newline at end of file
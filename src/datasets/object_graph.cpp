@@ -19,9 +19,13 @@
 
 #include "mimir/formalism/domain.hpp"
 #include "mimir/formalism/problem.hpp"
+#include "mimir/formalism/repositories.hpp"
 #include "mimir/search/state.hpp"
 
-#include <random>
+#include <algorithm>
+#include <cassert>
+#include <numeric>
+#include <stdexcept>
 
 using namespace mimir::formalism;
 using namespace mimir::search;
@@ -29,253 +33,714 @@ using namespace mimir::search;
 namespace mimir::datasets
 {
 
-static ObjectMap<graphs::VertexIndex>
-add_objects_graph_structures(const State& state, const ProblemImpl& problem, graphs::StaticVertexColoredGraph& out_digraph)
+/**
+ * ObjectGraphBuilder
+ */
+
+static std::span<const Index> get_range(const IndexList& offsets, const IndexList& values, Index pos)
 {
-    auto object_to_atom_color = ObjectMap<PredicateVariantList> {};
-    auto object_to_literal_color = ObjectMap<std::vector<std::pair<PredicateVariant, bool>>> {};
-    auto initialize_object_colors_func = [&](auto&& atom)
-    {
-        for (const auto& object : atom->get_objects())
-        {
-            object_to_atom_color[object] = PredicateVariantList();
-            object_to_literal_color[object] = std::vector<std::pair<PredicateVariant, bool>>();
-        }
-    };
-    for (const auto& atom : problem.get_static_initial_atoms())
+    return std::span<const Index>(values.data() + offsets[pos], values.data() + offsets[pos + 1]);
+}
+
+ObjectGraphBuilder::ObjectGraphBuilder(const ProblemImpl& problem) :
+    m_problem(problem),
+    m_colors(),
+    m_color_indices(),
+    m_color_unary_predicates(),
+    m_predicates(),
+    m_objects(problem.get_problem_and_domain_objects()),
+    m_object_to_slot(),
+    m_is_skeleton_object(),
+    m_static_unary_offsets(),
+    m_static_unary_predicates(),
+    m_goal_unary_offsets(),
+    m_goal_unary_literals(),
+    m_skeleton_object_colors(),
+    m_skeleton_vertices(),
+    m_atom_vertices(),
+    m_fluent_atom_infos(),
+    m_derived_atom_infos(),
+    m_state_atoms(),
+    m_state_atom_keys(),
+    m_added_atom_keys(),
+    m_is_touched(),
+    m_touched_slots(),
+    m_slot_num_atoms(),
+    m_unary_changes(),
+    m_vertex_map(),
+    m_is_present(),
+    m_unary_atoms(),
+    m_unary_predicates(),
+    m_slot_to_vertex(),
+    m_color_key(),
+    m_edge_sources(),
+    m_edge_targets(),
+    m_edge_positions(),
+    m_graph()
+{
+    if (!problem.get_derived_predicates().empty())
     {
-        initialize_object_colors_func(atom);
+        throw std::runtime_error("ObjectGraphBuilder::ObjectGraphBuilder: Cannot create object graphs for problems with additional derived predicates. If you "
+                                 "have quantified goals then you should define them as derived predicates in the domain file.");
     }
-    for (const auto& atom_index : state.get_atoms<FluentTag>())
+
+    /* Objects */
+
+    std::sort(m_objects.begin(), m_objects.end(), [](auto&& lhs, auto&& rhs) { return lhs->get_index() < rhs->get_index(); });
+    for (Index slot = 0; slot < m_objects.size(); ++slot)
     {
-        initialize_object_colors_func(problem.get_repositories().get_ground_atom<FluentTag>(atom_index));
+        const auto object_index = m_objects[slot]->get_index();
+        if (object_index >= m_object_to_slot.size())
+        {
+            m_object_to_slot.resize(object_index + 1, NO_OBJECT);
+        }
+        m_object_to_slot[object_index] = slot;
     }
-    for (const auto& atom_index : state.get_atoms<DerivedTag>())
+    m_is_skeleton_object.resize(m_objects.size(), false);
+
+    /* Static atoms and goal literals */
+
+    auto static_unary_atoms = std::vector<std::pair<Index, Index>> {};  ///< Pairs of object slot and predicate key.
+    for (const auto& atom : problem.get_static_initial_atoms())
     {
-        initialize_object_colors_func(problem.get_repositories().get_ground_atom<DerivedTag>(atom_index));
+        for (const auto& object : atom->get_objects())
+        {
+            m_is_skeleton_object[m_object_to_slot.at(object->get_index())] = true;
+        }
+
+        if (atom->get_arity() == 1)
+        {
+            static_unary_atoms.emplace_back(m_object_to_slot.at(atom->get_objects().front()->get_index()), get_or_create_predicate_key(atom->get_predicate()));
+        }
+        else
+        {
+            add_atom_vertices(atom->get_predicate(), atom->get_objects(), std::nullopt, m_skeleton_vertices);
+        }
     }
+
+    auto goal_unary_literals = std::vector<std::pair<Index, Index>> {};  ///< Pairs of object slot and literal key.
     boost::hana::for_each(problem.get_hana_goal_condition(),
                           [&](auto&& pair)
                           {
-                              const auto& second = boost::hana::second(pair);
-                              for (const auto& literal : second)
+                              for (const auto& literal : boost::hana::second(pair))
                               {
-                                  initialize_object_colors_func(literal->get_atom());
+                                  const auto atom = literal->get_atom();
+                                  for (const auto& object : atom->get_objects())
+                                  {
+                                      m_is_skeleton_object[m_object_to_slot.at(object->get_index())] = true;
+                                  }
+
+                                  if (atom->get_arity() == 1)
+                                  {
+                                      goal_unary_literals.emplace_back(m_object_to_slot.at(atom->get_objects().front()->get_index()),
+                                                                       2 * get_or_create_predicate_key(atom->get_predicate()) + literal->get_polarity());
+                                  }
+                                  else
+                                  {
+                                      add_atom_vertices(atom->get_predicate(), atom->get_objects(), literal->get_polarity(), m_skeleton_vertices);
+                                  }
                               }
                           });
 
-    auto add_unary_atom_graph_structures_func = [&](auto&& atom)
+    /* Colors of the objects, which only change with unary fluent and derived atoms. */
+
+    const auto to_offsets_and_values = [&](std::vector<std::pair<Index, Index>>& pairs, IndexList& out_offsets, IndexList& out_values)
     {
-        if (atom->get_arity() == 1)
+        std::sort(pairs.begin(), pairs.end());
+        out_offsets.assign(m_objects.size() + 1, 0);
+        for (const auto& [slot, value] : pairs)
         {
-            object_to_atom_color[atom->get_objects().front()].push_back(atom->get_predicate());
+            ++out_offsets[slot + 1];
+            out_values.push_back(value);
         }
+        std::partial_sum(out_offsets.begin(), out_offsets.end(), out_offsets.begin());
     };
-    for (const auto& atom : problem.get_static_initial_atoms())
+    to_offsets_and_values(static_unary_atoms, m_static_unary_offsets, m_static_unary_predicates);
+    to_offsets_and_values(goal_unary_literals, m_goal_unary_offsets, m_goal_unary_literals);
+
+    for (Index slot = 0; slot < m_objects.size(); ++slot)
     {
-        add_unary_atom_graph_structures_func(atom);
+        m_skeleton_object_colors.push_back(get_or_create_object_color(get_range(m_static_unary_offsets, m_static_unary_predicates, slot),
+                                                                      get_range(m_goal_unary_offsets, m_goal_unary_literals, slot)));
     }
-    for (const auto& atom_index : state.get_atoms<FluentTag>())
+}
+
+template<IsStaticOrFluentOrDerivedTag P>
+Index ObjectGraphBuilder::get_or_create_predicate_key(Predicate<P> predicate)
+{
+    auto tag = Index(0);
+    if constexpr (std::is_same_v<P, FluentTag>)
+        tag = 1;
+    else if constexpr (std::is_same_v<P, DerivedTag>)
+        tag = 2;
+
+    const auto key = 3 * predicate->get_index() + tag;
+    m_predicates.try_emplace(key, predicate);
+    return key;
+}
+
+Index ObjectGraphBuilder::add_color(graphs::Color color)
+{
+    const auto index = m_colors.size();
+    m_colors.push_back(std::move(color));
+    m_color_indices.emplace(m_color_key, index);
+    return index;
+}
+
+template<IsStaticOrFluentOrDerivedTag P>
+Index ObjectGraphBuilder::get_or_create_atom_color(Predicate<P> predicate, std::optional<size_t> pos, std::optional<bool> polarity)
+{
+    m_color_key.clear();
+    m_color_key.push_back(polarity.has_value() ? 2 : 1);
+    m_color_key.push_back(get_or_create_predicate_key(predicate));
+    m_color_key.push_back(pos.has_value() ? pos.value() + 1 : 0);
+    m_color_key.push_back(polarity.value_or(false));
+
+    const auto it = m_color_indices.find(m_color_key);
+    if (it != m_color_indices.end())
     {
-        add_unary_atom_graph_structures_func(problem.get_repositories().get_ground_atom<FluentTag>(atom_index));
+        return it->second;
     }
-    for (const auto& atom_index : state.get_atoms<DerivedTag>())
+
+    if (pos && polarity)
+        return add_color(graphs::Color(graphs::VariadicColor(predicate, pos.value(), polarity.value())));
+    else if (pos)
+        return add_color(graphs::Color(graphs::VariadicColor(predicate, pos.value())));
+    else if (polarity)
+        return add_color(graphs::Color(graphs::VariadicColor(predicate, polarity.value())));
+    return add_color(graphs::Color(graphs::VariadicColor(predicate)));
+}
+
+Index ObjectGraphBuilder::get_or_create_object_color(std::span<const Index> unary_predicates, std::span<const Index> unary_literals)
+{
+    m_color_key.clear();
+    m_color_key.push_back(0);
+    m_color_key.push_back(unary_predicates.size());
+    m_color_key.insert(m_color_key.end(), unary_predicates.begin(), unary_predicates.end());
+    m_color_key.insert(m_color_key.end(), unary_literals.begin(), unary_literals.end());
+
+    const auto it = m_color_indices.find(m_color_key);
+    if (it != m_color_indices.end())
     {
-        add_unary_atom_graph_structures_func(problem.get_repositories().get_ground_atom<DerivedTag>(atom_index));
+        return it->second;
     }
-    auto add_unary_literal_graph_structures_func = [&](auto&& literal)
+
+    auto predicates = PredicateVariantList {};
+    for (const auto key : unary_predicates)
     {
-        if (literal->get_atom()->get_arity() == 1)
-        {
-            object_to_literal_color[literal->get_atom()->get_objects().front()].emplace_back(literal->get_atom()->get_predicate(), literal->get_polarity());
-        }
-    };
-    boost::hana::for_each(problem.get_hana_goal_condition(),
-                          [&](auto&& pair)
-                          {
-                              const auto& second = boost::hana::second(pair);
-                              for (const auto& literal : second)
-                              {
-                                  add_unary_literal_graph_structures_func(literal);
-                              }
-                          });
+        predicates.push_back(m_predicates.at(key));
+    }
+    auto literals = std::vector<std::pair<PredicateVariant, bool>> {};
+    for (const auto key : unary_literals)
+    {
+        literals.emplace_back(m_predicates.at(key / 2), key % 2);
+    }
+    std::sort(predicates.begin(), predicates.end());
+    std::sort(literals.begin(), literals.end());
 
-    auto index_to_object = std::vector<std::pair<Index, Object>> {};
-    for (const auto& [object, color] : object_to_atom_color)
+    const auto color = add_color(graphs::Color(graphs::VariadicColor(std::move(predicates), std::move(literals))));
+    m_color_unary_predicates.resize(m_colors.size());
+    m_color_unary_predicates[color].assign(unary_predicates.begin(), unary_predicates.end());
+    return color;
+}
+
+template<IsStaticOrFluentOrDerivedTag P>
+void ObjectGraphBuilder::add_atom_vertices(Predicate<P> predicate,
+                                           const ObjectList& objects,
+                                           std::optional<bool> polarity,
+                                           std::vector<AtomVertex>& out_vertices)
+{
+    if (objects.empty())
     {
-        index_to_object.emplace_back(object->get_index(), object);
+        out_vertices.push_back(AtomVertex { get_or_create_atom_color(predicate, std::nullopt, polarity), NO_OBJECT, false });
     }
-    for (const auto& [object, color] : object_to_literal_color)
+    else if (objects.size() > 1)
+    {
+        for (size_t pos = 0; pos < objects.size(); ++pos)
+        {
+            out_vertices.push_back(AtomVertex { get_or_create_atom_color(predicate, pos, polarity), m_object_to_slot.at(objects[pos]->get_index()), pos > 0 });
+        }
+    }
+}
+
+template<IsFluentOrDerivedTag P>
+const ObjectGraphBuilder::AtomInfo& ObjectGraphBuilder::get_or_create_atom_info(Index atom_index)
+{
+    auto& atom_infos = std::is_same_v<P, FluentTag> ? m_fluent_atom_infos : m_derived_atom_infos;
+    if (atom_index >= atom_infos.size())
     {
-        index_to_object.emplace_back(object->get_index(), object);
+        atom_infos.resize(atom_index + 1);
     }
-    std::sort(index_to_object.begin(), index_to_object.end());
 
-    auto object_to_vertex_index = ObjectMap<graphs::VertexIndex> {};
-    for (const auto& [index, object] : index_to_object)
+    auto& atom_info = atom_infos[atom_index];
+    if (!atom_info.is_decoded)
     {
-        std::sort(object_to_atom_color[object].begin(), object_to_atom_color[object].end());
-        std::sort(object_to_literal_color[object].begin(), object_to_literal_color[object].end());
+        const auto atom = m_problem.get_repositories().get_ground_atom<P>(atom_index);
 
-        object_to_vertex_index.emplace(
-            object,
-            out_digraph.add_vertex(graphs::Color(graphs::VariadicColor(object_to_atom_color[object], object_to_literal_color[object]))));
+        atom_info.begin = m_atom_vertices.size();
+        if (atom->get_arity() == 1)
+        {
+            atom_info.unary_object = m_object_to_slot.at(atom->get_objects().front()->get_index());
+            atom_info.unary_predicate = get_or_create_predicate_key(atom->get_predicate());
+        }
+        else
+        {
+            add_atom_vertices(atom->get_predicate(), atom->get_objects(), std::nullopt, m_atom_vertices);
+        }
+        atom_info.end = m_atom_vertices.size();
+        atom_info.is_decoded = true;
     }
+    return atom_info;
+}
+
+template<IsFluentOrDerivedTag P>
+Index ObjectGraphBuilder::get_atom_key(Index atom_index)
+{
+    return 2 * atom_index + std::is_same_v<P, DerivedTag>;
+}
 
-    return object_to_vertex_index;
+const ObjectGraphBuilder::AtomInfo& ObjectGraphBuilder::get_atom_info(Index atom_key) const
+{
+    return (atom_key % 2) ? m_derived_atom_infos[atom_key / 2] : m_fluent_atom_infos[atom_key / 2];
 }
 
-template<IsStaticOrFluentOrDerivedTag P>
-static void add_ground_atom_graph_structures(const ProblemImpl& problem,
-                                             const ObjectMap<graphs::VertexIndex>& object_to_vertex_index,
-                                             GroundAtom<P> atom,
-                                             graphs::StaticVertexColoredGraph& out_digraph)
+template<IsFluentOrDerivedTag P>
+void ObjectGraphBuilder::collect_atoms(const State& state)
 {
-    if (atom->get_arity() == 0)
+    for (const auto atom_index : state.get_atoms<P>())
     {
-        out_digraph.add_vertex(graphs::Color(graphs::VariadicColor(atom->get_predicate())));
+        m_state_atoms.push_back(get_or_create_atom_info<P>(atom_index));
+        m_state_atom_keys.push_back(get_atom_key<P>(atom_index));
     }
-    else if (atom->get_arity() > 1)
+}
+
+void ObjectGraphBuilder::touch_object(Index slot, const FlatObjectGraph& parent_graph)
+{
+    if (!m_is_touched[slot])
     {
-        for (size_t pos = 0; pos < atom->get_arity(); ++pos)
-        {
-            const auto vertex_index = out_digraph.add_vertex(graphs::Color(graphs::VariadicColor(atom->get_predicate(), pos)));
+        m_is_touched[slot] = true;
+        m_touched_slots.push_back(slot);
+        m_slot_num_atoms[slot] = (m_slot_to_vertex[slot] != NO_OBJECT) ? parent_graph.object_num_atoms[m_slot_to_vertex[slot]] : 0;
+    }
+}
 
-            out_digraph.add_undirected_edge(vertex_index, object_to_vertex_index.at(atom->get_objects().at(pos)));
+template<IsFluentOrDerivedTag P>
+void ObjectGraphBuilder::collect_atom_difference(const State& state, const State& other_state, const FlatObjectGraph& parent_graph, bool is_added)
+{
+    const auto& other_atoms = other_state.get_atoms<P>();
+    for (const auto atom_index : state.get_atoms<P>())
+    {
+        if (other_atoms.get(atom_index))
+        {
+            continue;
+        }
 
-            if (pos > 0)
+        const auto& atom_info = get_or_create_atom_info<P>(atom_index);
+        const auto update_object = [&](Index slot)
+        {
+            touch_object(slot, parent_graph);
+            m_slot_num_atoms[slot] = is_added ? m_slot_num_atoms[slot] + 1 : m_slot_num_atoms[slot] - 1;
+        };
+        for (auto index = atom_info.begin; index < atom_info.end; ++index)
+        {
+            if (m_atom_vertices[index].object != NO_OBJECT)
             {
-                out_digraph.add_undirected_edge(vertex_index - 1, vertex_index);
+                update_object(m_atom_vertices[index].object);
             }
         }
+        if (atom_info.unary_object != NO_OBJECT)
+        {
+            update_object(atom_info.unary_object);
+            m_unary_changes.emplace_back(atom_info.unary_object, atom_info.unary_predicate, is_added);
+        }
+
+        if (is_added)
+        {
+            m_added_atom_keys.push_back(get_atom_key<P>(atom_index));
+        }
     }
 }
 
-template<IsStaticOrFluentOrDerivedTag P>
-static void add_ground_atoms_graph_structures(const ProblemImpl& problem,
-                                              const ObjectMap<graphs::VertexIndex>& object_to_vertex_index,
-                                              const GroundAtomList<P>& atoms,
-                                              graphs::StaticVertexColoredGraph& out_digraph)
+void ObjectGraphBuilder::append_atom_vertices(std::span<const AtomVertex> vertices, FlatObjectGraph& out_graph)
+{
+    for (const auto& atom_vertex : vertices)
+    {
+        const auto vertex = out_graph.vertex_colors.size();
+        out_graph.vertex_colors.push_back(atom_vertex.color);
+
+        if (atom_vertex.object != NO_OBJECT)
+        {
+            m_edge_sources.push_back(vertex);
+            m_edge_targets.push_back(m_slot_to_vertex[atom_vertex.object]);
+        }
+        if (atom_vertex.chained)
+        {
+            m_edge_sources.push_back(vertex - 1);
+            m_edge_targets.push_back(vertex);
+        }
+    }
+}
+
+void ObjectGraphBuilder::create_from_collected_atoms(FlatObjectGraph& out_graph)
 {
-    auto canonical_structure_to_atom = std::vector<std::tuple<Index, IndexList, GroundAtom<P>>> {};
+    const auto num_objects = m_objects.size();
 
-    for (const auto& atom : atoms)
+    /* Determine the objects and their unary atoms in the state. */
+
+    m_is_present.assign(m_is_skeleton_object.begin(), m_is_skeleton_object.end());
+    m_slot_num_atoms.assign(num_objects, 0);
+    m_unary_atoms.clear();
+    for (const auto& atom_info : m_state_atoms)
     {
-        auto object_indices = IndexList {};
-        for (const auto& object : atom->get_objects())
+        for (auto index = atom_info.begin; index < atom_info.end; ++index)
+        {
+            if (m_atom_vertices[index].object != NO_OBJECT)
+            {
+                m_is_present[m_atom_vertices[index].object] = true;
+                ++m_slot_num_atoms[m_atom_vertices[index].object];
+            }
+        }
+
+        if (atom_info.unary_object != NO_OBJECT)
         {
-            object_indices.push_back(object->get_index());
+            m_is_present[atom_info.unary_object] = true;
+            ++m_slot_num_atoms[atom_info.unary_object];
+            m_unary_atoms.emplace_back(atom_info.unary_object, atom_info.unary_predicate);
         }
-        canonical_structure_to_atom.emplace_back(atom->get_predicate()->get_index(), object_indices, atom);
     }
+    std::sort(m_unary_atoms.begin(), m_unary_atoms.end());
 
-    std::sort(canonical_structure_to_atom.begin(), canonical_structure_to_atom.end());
+    /* Object vertices */
+
+    out_graph.vertex_colors.clear();
+    out_graph.objects.clear();
+    out_graph.object_num_atoms.clear();
+    m_slot_to_vertex.assign(num_objects, NO_OBJECT);
+
+    auto unary_atom_it = m_unary_atoms.begin();
+    for (Index slot = 0; slot < num_objects; ++slot)
+    {
+        if (!m_is_present[slot])
+        {
+            continue;
+        }
+
+        const auto object_index = m_objects[slot]->get_index();
+
+        m_unary_predicates.clear();
+        for (; unary_atom_it != m_unary_atoms.end() && unary_atom_it->first == slot; ++unary_atom_it)
+        {
+            m_unary_predicates.push_back(unary_atom_it->second);
+        }
+
+        auto color = m_skeleton_object_colors[slot];
+        if (!m_unary_predicates.empty())
+        {
+            const auto static_unary_predicates = get_range(m_static_unary_offsets, m_static_unary_predicates, slot);
+            m_unary_predicates.insert(m_unary_predicates.end(), static_unary_predicates.begin(), static_unary_predicates.end());
+            std::sort(m_unary_predicates.begin(), m_unary_predicates.end());
+
+            color = get_or_create_object_color(m_unary_predicates, get_range(m_goal_unary_offsets, m_goal_unary_literals, slot));
+        }
+
+        m_slot_to_vertex[slot] = out_graph.vertex_colors.size();
+        out_graph.vertex_colors.push_back(color);
+        out_graph.objects.push_back(object_index);
+        out_graph.object_num_atoms.push_back(m_slot_num_atoms[slot]);
+    }
+
+    /* Atom vertices */
+
+    m_edge_sources.clear();
+    m_edge_targets.clear();
+    out_graph.atoms.clear();
+    append_atom_vertices(m_skeleton_vertices, out_graph);
+    for (size_t i = 0; i < m_state_atoms.size(); ++i)
+    {
+        const auto& atom_info = m_state_atoms[i];
+        if (atom_info.begin < atom_info.end)
+        {
+            append_atom_vertices(std::span<const AtomVertex>(m_atom_vertices.data() + atom_info.begin, atom_info.end - atom_info.begin), out_graph);
+            out_graph.atoms.push_back(m_state_atom_keys[i]);
+        }
+    }
+
+    /* Edges in compressed sparse row format */
+
+    const auto num_vertices = out_graph.vertex_colors.size();
+    out_graph.edge_offsets.assign(num_vertices + 1, 0);
+    for (size_t i = 0; i < m_edge_sources.size(); ++i)
+    {
+        ++out_graph.edge_offsets[m_edge_sources[i] + 1];
+        ++out_graph.edge_offsets[m_edge_targets[i] + 1];
+    }
+    std::partial_sum(out_graph.edge_offsets.begin(), out_graph.edge_offsets.end(), out_graph.edge_offsets.begin());
 
-    for (const auto& [predicate_index, object_indices, atom] : canonical_structure_to_atom)
+    m_edge_positions.assign(out_graph.edge_offsets.begin(), out_graph.edge_offsets.end() - 1);
+    out_graph.edge_targets.resize(out_graph.edge_offsets.back());
+    for (size_t i = 0; i < m_edge_sources.size(); ++i)
     {
-        add_ground_atom_graph_structures(problem, object_to_vertex_index, atom, out_digraph);
+        out_graph.edge_targets[m_edge_positions[m_edge_sources[i]]++] = m_edge_targets[i];
+        out_graph.edge_targets[m_edge_positions[m_edge_targets[i]]++] = m_edge_sources[i];
     }
 }
 
-static void add_ground_atoms_graph_structures(const State& state,
-                                              const ProblemImpl& problem,
-                                              const ObjectMap<graphs::VertexIndex>& object_to_vertex_index,
-                                              graphs::StaticVertexColoredGraph& out_digraph)
+void ObjectGraphBuilder::create(const State& state, FlatObjectGraph& out_graph)
 {
-    add_ground_atoms_graph_structures(problem, object_to_vertex_index, problem.get_static_initial_atoms(), out_digraph);
+    m_state_atoms.clear();
+    m_state_atom_keys.clear();
+    collect_atoms<FluentTag>(state);
+    collect_atoms<DerivedTag>(state);
 
-    add_ground_atoms_graph_structures(problem,
-                                      object_to_vertex_index,
-                                      problem.get_repositories().get_ground_atoms_from_indices<FluentTag>(state.get_atoms<FluentTag>()),
-                                      out_digraph);
-
-    add_ground_atoms_graph_structures(problem,
-                                      object_to_vertex_index,
-                                      problem.get_repositories().get_ground_atoms_from_indices<DerivedTag>(state.get_atoms<DerivedTag>()),
-                                      out_digraph);
+    create_from_collected_atoms(out_graph);
 }
 
-template<IsStaticOrFluentOrDerivedTag P>
-static void add_ground_literal_graph_structures(const ProblemImpl& problem,
-                                                const ObjectMap<graphs::VertexIndex>& object_to_vertex_index,
-                                                GroundLiteral<P> literal,
-                                                graphs::StaticVertexColoredGraph& out_digraph)
+void ObjectGraphBuilder::create(const State& state, const State& parent_state, const FlatObjectGraph& parent_graph, FlatObjectGraph& out_graph)
 {
-    if (literal->get_atom()->get_arity() == 0)
+    assert(&parent_graph != &out_graph);
+
+    const auto num_objects = m_objects.size();
+    const auto num_object_vertices = parent_graph.objects.size();
+
+    /* Collect the difference of the atoms and the objects whose atoms change. */
+
+    m_slot_to_vertex.assign(num_objects, NO_OBJECT);
+    for (Index vertex = 0; vertex < num_object_vertices; ++vertex)
     {
-        out_digraph.add_vertex(graphs::Color(graphs::VariadicColor(literal->get_atom()->get_predicate(), literal->get_polarity())));
+        m_slot_to_vertex[m_object_to_slot[parent_graph.objects[vertex]]] = vertex;
     }
-    else if (literal->get_atom()->get_arity() > 1)
+
+    m_is_touched.resize(num_objects, false);
+    m_slot_num_atoms.resize(num_objects, 0);
+    m_touched_slots.clear();
+    m_unary_changes.clear();
+    m_added_atom_keys.clear();
+    collect_atom_difference<FluentTag>(state, parent_state, parent_graph, true);
+    collect_atom_difference<DerivedTag>(state, parent_state, parent_graph, true);
+    collect_atom_difference<FluentTag>(parent_state, state, parent_graph, false);
+    collect_atom_difference<DerivedTag>(parent_state, state, parent_graph, false);
+
+    auto is_same_objects = true;
+    for (const auto slot : m_touched_slots)
     {
-        for (size_t pos = 0; pos < literal->get_atom()->get_arity(); ++pos)
-        {
-            const auto vertex_index =
-                out_digraph.add_vertex(graphs::Color(graphs::VariadicColor(literal->get_atom()->get_predicate(), pos, literal->get_polarity())));
+        m_is_touched[slot] = false;
+        const auto is_present = m_is_skeleton_object[slot] || m_slot_num_atoms[slot] > 0;
+        is_same_objects = is_same_objects && (is_present == (m_slot_to_vertex[slot] != NO_OBJECT));
+    }
+    if (!is_same_objects)
+    {
+        create(state, out_graph);
+        return;
+    }
 
-            out_digraph.add_undirected_edge(vertex_index, object_to_vertex_index.at(literal->get_atom()->get_objects().at(pos)));
+    /* Object vertices, where only the objects of added or deleted unary atoms are recolored. */
+
+    out_graph.objects.assign(parent_graph.objects.begin(), parent_graph.objects.end());
+    out_graph.object_num_atoms.assign(parent_graph.object_num_atoms.begin(), parent_graph.object_num_atoms.end());
+    for (const auto slot : m_touched_slots)
+    {
+        out_graph.object_num_atoms[m_slot_to_vertex[slot]] = m_slot_num_atoms[slot];
+    }
+    out_graph.vertex_colors.assign(parent_graph.vertex_colors.begin(), parent_graph.vertex_colors.begin() + num_object_vertices);
+
+    std::sort(m_unary_changes.begin(), m_unary_changes.end());
+    for (auto it = m_unary_changes.begin(); it != m_unary_changes.end();)
+    {
+        const auto slot = std::get<0>(*it);
+        const auto vertex = m_slot_to_vertex[slot];
 
-            if (pos > 0)
+        m_unary_predicates = m_color_unary_predicates[out_graph.vertex_colors[vertex]];
+        for (; it != m_unary_changes.end() && std::get<0>(*it) == slot; ++it)
+        {
+            if (std::get<2>(*it))
+            {
+                m_unary_predicates.push_back(std::get<1>(*it));
+            }
+            else
             {
-                out_digraph.add_undirected_edge(vertex_index - 1, vertex_index);
+                m_unary_predicates.erase(std::find(m_unary_predicates.begin(), m_unary_predicates.end(), std::get<1>(*it)));
             }
         }
+        std::sort(m_unary_predicates.begin(), m_unary_predicates.end());
+
+        out_graph.vertex_colors[vertex] = get_or_create_object_color(m_unary_predicates, get_range(m_goal_unary_offsets, m_goal_unary_literals, slot));
     }
-}
 
-template<IsStaticOrFluentOrDerivedTag P>
-static void add_ground_literals_graph_structures(const ProblemImpl& problem,
-                                                 const ObjectMap<graphs::VertexIndex>& object_to_vertex_index,
-                                                 GroundLiteralList<P> literals,
-                                                 graphs::StaticVertexColoredGraph& out_digraph)
-{
-    auto canonical_structure_to_literal = std::vector<std::tuple<Index, IndexList, bool, GroundLiteral<P>>> {};
+    /* Atom vertices, where the vertices of the deleted atoms are removed and the vertices of the added atoms are appended. */
 
-    for (const auto& literal : literals)
+    const auto num_parent_vertices = parent_graph.get_num_vertices();
+    const auto atom_vertices_begin = num_object_vertices + m_skeleton_vertices.size();
+    m_vertex_map.resize(num_parent_vertices);
+    std::iota(m_vertex_map.begin(), m_vertex_map.begin() + atom_vertices_begin, Index(0));
+    out_graph.vertex_colors.insert(out_graph.vertex_colors.end(),
+                                   parent_graph.vertex_colors.begin() + num_object_vertices,
+                                   parent_graph.vertex_colors.begin() + atom_vertices_begin);
+
+    out_graph.atoms.clear();
+    auto parent_vertex = Index(atom_vertices_begin);
+    for (const auto atom_key : parent_graph.atoms)
     {
-        auto object_indices = IndexList {};
-        for (const auto& object : literal->get_atom()->get_objects())
+        const auto& atom_info = get_atom_info(atom_key);
+        const auto is_deleted = (atom_key % 2) ? !state.get_atoms<DerivedTag>().get(atom_key / 2) : !state.get_atoms<FluentTag>().get(atom_key / 2);
+        for (auto index = atom_info.begin; index < atom_info.end; ++index, ++parent_vertex)
+        {
+            if (is_deleted)
+            {
+                m_vertex_map[parent_vertex] = NO_OBJECT;
+            }
+            else
+            {
+                m_vertex_map[parent_vertex] = out_graph.vertex_colors.size();
+                out_graph.vertex_colors.push_back(parent_graph.vertex_colors[parent_vertex]);
+            }
+        }
+        if (!is_deleted)
         {
-            object_indices.push_back(object->get_index());
+            out_graph.atoms.push_back(atom_key);
         }
-        canonical_structure_to_literal.emplace_back(literal->get_atom()->get_predicate()->get_index(), object_indices, literal->get_polarity(), literal);
     }
+    assert(parent_vertex == num_parent_vertices);
 
-    std::sort(canonical_structure_to_literal.begin(), canonical_structure_to_literal.end());
+    m_edge_sources.clear();
+    m_edge_targets.clear();
+    for (const auto atom_key : m_added_atom_keys)
+    {
+        const auto& atom_info = get_atom_info(atom_key);
+        if (atom_info.begin < atom_info.end)
+        {
+            append_atom_vertices(std::span<const AtomVertex>(m_atom_vertices.data() + atom_info.begin, atom_info.end - atom_info.begin), out_graph);
+            out_graph.atoms.push_back(atom_key);
+        }
+    }
 
-    for (const auto& [predicate_index, object_indices, polarity, literal] : canonical_structure_to_literal)
+    /* Edges in compressed sparse row format, where the kept edges are copied and the edges of the added atoms are inserted. */
+
+    const auto num_vertices = out_graph.vertex_colors.size();
+    out_graph.edge_offsets.assign(num_vertices + 1, 0);
+    for (Index vertex = 0; vertex < num_parent_vertices; ++vertex)
     {
-        add_ground_literal_graph_structures(problem, object_to_vertex_index, literal, out_digraph);
+        if (m_vertex_map[vertex] == NO_OBJECT)
+        {
+            continue;
+        }
+        for (auto pos = parent_graph.edge_offsets[vertex]; pos < parent_graph.edge_offsets[vertex + 1]; ++pos)
+        {
+            if (m_vertex_map[parent_graph.edge_targets[pos]] != NO_OBJECT)
+            {
+                ++out_graph.edge_offsets[m_vertex_map[vertex] + 1];
+            }
+        }
+    }
+    for (size_t i = 0; i < m_edge_sources.size(); ++i)
+    {
+        ++out_graph.edge_offsets[m_edge_sources[i] + 1];
+        ++out_graph.edge_offsets[m_edge_targets[i] + 1];
+    }
+    std::partial_sum(out_graph.edge_offsets.begin(), out_graph.edge_offsets.end(), out_graph.edge_offsets.begin());
+
+    m_edge_positions.assign(out_graph.edge_offsets.begin(), out_graph.edge_offsets.end() - 1);
+    out_graph.edge_targets.resize(out_graph.edge_offsets.back());
+    for (Index vertex = 0; vertex < num_parent_vertices; ++vertex)
+    {
+        if (m_vertex_map[vertex] == NO_OBJECT)
+        {
+            continue;
+        }
+        for (auto pos = parent_graph.edge_offsets[vertex]; pos < parent_graph.edge_offsets[vertex + 1]; ++pos)
+        {
+            const auto target = m_vertex_map[parent_graph.edge_targets[pos]];
+            if (target != NO_OBJECT)
+            {
+                out_graph.edge_targets[m_edge_positions[m_vertex_map[vertex]]++] = target;
+            }
+        }
+    }
+    for (size_t i = 0; i < m_edge_sources.size(); ++i)
+    {
+        out_graph.edge_targets[m_edge_positions[m_edge_sources[i]]++] = m_edge_targets[i];
+        out_graph.edge_targets[m_edge_positions[m_edge_targets[i]]++] = m_edge_sources[i];
     }
 }
 
-static void add_ground_goal_literals_graph_structures(const ProblemImpl& problem,
-                                                      const ObjectMap<graphs::VertexIndex>& object_to_vertex_index,
-                                                      graphs::StaticVertexColoredGraph& out_digraph)
+void ObjectGraphBuilder::create(std::span<const State> states, ObjectGraphBatch& out_batch)
 {
-    add_ground_literals_graph_structures(problem, object_to_vertex_index, problem.get_goal_condition<StaticTag>(), out_digraph);
+    out_batch.vertex_offsets.assign(1, 0);
+    out_batch.vertex_colors.clear();
+    out_batch.edge_offsets.assign(1, 0);
+    out_batch.edge_sources.clear();
+    out_batch.edge_targets.clear();
 
-    add_ground_literals_graph_structures(problem, object_to_vertex_index, problem.get_goal_condition<FluentTag>(), out_digraph);
+    for (const auto& state : states)
+    {
+        create(state, m_graph);
 
-    add_ground_literals_graph_structures(problem, object_to_vertex_index, problem.get_goal_condition<DerivedTag>(), out_digraph);
+        const auto vertex_offset = out_batch.vertex_colors.size();
+        out_batch.vertex_colors.insert(out_batch.vertex_colors.end(), m_graph.vertex_colors.begin(), m_graph.vertex_colors.end());
+        for (Index vertex = 0; vertex < m_graph.get_num_vertices(); ++vertex)
+        {
+            for (auto pos = m_graph.edge_offsets[vertex]; pos < m_graph.edge_offsets[vertex + 1]; ++pos)
+            {
+                out_batch.edge_sources.push_back(vertex_offset + vertex);
+                out_batch.edge_targets.push_back(vertex_offset + m_graph.edge_targets[pos]);
+            }
+        }
+
+        out_batch.vertex_offsets.push_back(out_batch.vertex_colors.size());
+        out_batch.edge_offsets.push_back(out_batch.edge_sources.size());
+    }
 }
 
-graphs::StaticVertexColoredGraph create_object_graph(const State& state, const ProblemImpl& problem)
+void ObjectGraphBuilder::create(const State& state, graphs::StaticVertexColoredGraph& out_graph)
 {
-    if (!problem.get_derived_predicates().empty())
+    create(state, m_graph);
+
+    translate(m_graph, out_graph);
+}
+
+void ObjectGraphBuilder::translate(const FlatObjectGraph& graph, graphs::StaticVertexColoredGraph& out_graph) const
+{
+    out_graph.clear();
+
+    for (const auto color : graph.vertex_colors)
     {
-        throw std::runtime_error("create_object_graph(state, problem): Cannot create object graphs for problems with additional derived predicates. If you "
-                                 "have quantified goals then you should define them as derived predicates in the domain file.");
+        out_graph.add_vertex(graphs::Color(m_colors.at(color)));
+    }
+    for (Index vertex = 0; vertex < graph.get_num_vertices(); ++vertex)
+    {
+        for (auto pos = graph.edge_offsets[vertex]; pos < graph.edge_offsets[vertex + 1]; ++pos)
+        {
+            if (vertex < graph.edge_targets[pos])
+            {
+                out_graph.add_undirected_edge(vertex, graph.edge_targets[pos]);
+            }
+        }
     }
+}
 
-    auto vertex_colored_digraph = graphs::StaticVertexColoredGraph();
+const ProblemImpl& ObjectGraphBuilder::get_problem() const { return m_problem; }
 
-    const auto object_to_vertex_index = add_objects_graph_structures(state, problem, vertex_colored_digraph);
+const graphs::Color& ObjectGraphBuilder::get_color(Index color) const { return m_colors.at(color); }
+
+size_t ObjectGraphBuilder::get_num_colors() const { return m_colors.size(); }
+
+/**
+ * create_object_graph
+ */
 
-    add_ground_atoms_graph_structures(state, problem, object_to_vertex_index, vertex_colored_digraph);
+graphs::StaticVertexColoredGraph create_object_graph(const State& state, const ProblemImpl& problem)
+{
+    auto vertex_colored_digraph = graphs::StaticVertexColoredGraph();
 
-    add_ground_goal_literals_graph_structures(problem, object_to_vertex_index, vertex_colored_digraph);
+    create_object_graph(state, problem, vertex_colored_digraph);
 
     return vertex_colored_digraph;
 }
 
+void create_object_graph(const State& state, const ProblemImpl& problem, graphs::StaticVertexColoredGraph& out_graph)
+{
+    auto builder = ObjectGraphBuilder(problem);
+
+    builder.create(state, out_graph);
+}
+
 }
@@ -17,6 +17,8 @@
 
 #include "mimir/datasets/state_space.hpp"
 
+#include "mimir/algorithms/BS_thread_pool.hpp"
+#include "mimir/algorithms/parallel_for.hpp"
 #include "mimir/common/timers.hpp"
 #include "mimir/datasets/object_graph.hpp"
 #include "mimir/formalism/generalized_problem.hpp"
@@ -46,7 +48,10 @@
 #include "mimir/search/state.hpp"
 #include "mimir/search/state_repository.hpp"
 
+#include <algorithm>
 #include <deque>
+#include <exception>
+#include <mutex>
 
 using namespace mimir::formalism;
 using namespace mimir::search;
@@ -97,6 +102,12 @@ struct SymmetriesData
     SymmetriesData() : certificate_maps(), prunable_states() {}
 };
 
+static nauty::SparseGraph compute_certificate(const State& state, ObjectGraphBuilder& ref_builder, graphs::StaticVertexColoredGraph& ref_object_graph)
+{
+    ref_builder.create(state, ref_object_graph);
+    return nauty::SparseGraph(ref_object_graph).canonize();
+}
+
 /// @brief `SymmetryStatePruning` extends the brfs pruning strategy by additionally pruning symmetric states.
 class SymmetryStatePruning : public IPruningStrategy
 {
@@ -122,13 +133,31 @@ private:
     IndexSet& m_goal_vertices;
     SymmetriesData& m_symm_data;
 
-    IndexMap<graphs::VertexIndex> m_state_to_vertex_index;
+    IndexMap<graphs::VertexIndex> m_state_to_vertex_index;  ///< Maps each generated state to the vertex of its symmetry class.
+
+    /* Memory for reuse */
+    ObjectGraphBuilder m_object_graph_builder;
+    graphs::StaticVertexColoredGraph m_object_graph;
+    FlatObjectGraph m_parent_flat_object_graph;
+    Index m_parent_flat_object_graph_state;  ///< The index of the state whose graph is m_parent_flat_object_graph.
+    FlatObjectGraph m_flat_object_graph;
+
+    /// @brief Compute the certificate of a successor state from the object graph of the expanded state, which is created once per expansion.
+    nauty::SparseGraph compute_successor_certificate(const State& state, const State& successor_state)
+    {
+        if (m_parent_flat_object_graph_state != state.get_index())
+        {
+            m_object_graph_builder.create(state, m_parent_flat_object_graph);
+            m_parent_flat_object_graph_state = state.get_index();
+        }
+        m_object_graph_builder.create(successor_state, state, m_parent_flat_object_graph, m_flat_object_graph);
+        m_object_graph_builder.translate(m_flat_object_graph, m_object_graph);
+        return nauty::SparseGraph(m_object_graph).canonize();
+    }
 
     /* Implement AlgorithmEventHandlerBase interface */
     friend class brfs::EventHandlerBase<SymmetryReducedProblemGraphEventHandler>;
 
-    auto compute_canonical_graph(const State& state) { return nauty::SparseGraph(create_object_graph(state, *m_problem)).canonize(); }
-
     void on_expand_state_impl(const State& state) {}
 
     void on_expand_goal_state_impl(const State& state) { m_goal_vertices.insert(m_state_to_vertex_index.at(state.get_index())); }
@@ -137,9 +166,22 @@ private:
     {
         const auto source_v_idx = m_state_to_vertex_index.at(state.get_index());
 
-        auto certificate = compute_canonical_graph(successor_state);
-        auto it = m_symm_data.certificate_maps.cert_to_v_idx.find(certificate);
-        const auto is_symmetric = (it != m_symm_data.certificate_maps.cert_to_v_idx.end());
+        /* States reached before map to their class without recomputing the certificate. */
+
+        auto state_it = m_state_to_vertex_index.find(successor_state.get_index());
+        auto is_symmetric = (state_it != m_state_to_vertex_index.end());
+        auto certificate = std::optional<nauty::SparseGraph> {};
+
+        if (!is_symmetric)
+        {
+            certificate = compute_successor_certificate(state, successor_state);
+            auto it = m_symm_data.certificate_maps.cert_to_v_idx.find(certificate.value());
+            if (it != m_symm_data.certificate_maps.cert_to_v_idx.end())
+            {
+                is_symmetric = true;
+                state_it = m_state_to_vertex_index.emplace(successor_state.get_index(), it->second).first;
+            }
+        }
 
         if (is_symmetric)
         {
@@ -147,7 +189,7 @@ private:
 
             /* Always add novel edges between symmetric states. */
 
-            const auto target_v_idx = it->second;
+            const auto target_v_idx = state_it->second;
             if (m_symm_data.m_edges.emplace(source_v_idx, target_v_idx).second)  ///< avoid adding parallel edges
             {
                 m_graph.add_directed_edge(source_v_idx, target_v_idx, action, m_problem, action_cost);
@@ -160,13 +202,11 @@ private:
         {
             /* New class determined: add vertex and edge! */
 
-            assert(m_graph.get_num_vertices() == m_state_to_vertex_index.size());
-
             const auto target_v_idx =
                 m_graph.add_vertex(successor_state.get_packed_state(), m_state_repository, DiscreteCost(0), ContinuousCost(0), false, false, false, false);
 
-            m_symm_data.certificate_maps.state_to_cert.emplace(successor_state, certificate);
-            m_symm_data.certificate_maps.cert_to_v_idx.emplace(certificate, target_v_idx);
+            m_symm_data.certificate_maps.state_to_cert.emplace(successor_state, certificate.value());
+            m_symm_data.certificate_maps.cert_to_v_idx.emplace(std::move(certificate.value()), target_v_idx);
 
             m_state_to_vertex_index.emplace(successor_state.get_index(), target_v_idx);
             m_graph.add_directed_edge(source_v_idx, target_v_idx, action, m_problem, action_cost);
@@ -185,7 +225,7 @@ private:
             m_graph.add_vertex(start_state.get_packed_state(), m_state_repository, DiscreteCost(0), ContinuousCost(0), false, false, false, false);
         m_state_to_vertex_index.emplace(start_state.get_index(), v_idx);
 
-        const auto certificate = compute_canonical_graph(start_state);
+        const auto certificate = compute_certificate(start_state, m_object_graph_builder, m_object_graph);
         m_symm_data.certificate_maps.state_to_cert.emplace(start_state, certificate);
         m_symm_data.certificate_maps.cert_to_v_idx.emplace(certificate, v_idx);
     }
@@ -217,7 +257,13 @@ public:
         m_options(options),
         m_graph(graph),
         m_goal_vertices(goal_vertices),
-        m_symm_data(symm_data)
+        m_symm_data(symm_data),
+        m_state_to_vertex_index(),
+        m_object_graph_builder(*state_repository->get_problem()),
+        m_object_graph(),
+        m_parent_flat_object_graph(),
+        m_parent_flat_object_graph_state(MAX_INDEX),
+        m_flat_object_graph()
     {
     }
 };
@@ -374,14 +420,246 @@ perform_reachability_analysis(SearchContext context, graphs::StaticProblemGraph
                                             std::move(unsolvable_vertices));
 }
 
-static std::optional<std::pair<StateSpace, CertificateMaps>> compute_problem_graph_with_symmetry_reduction(const SearchContext& context,
-                                                                                                           const StateSpaceImpl::Options& options)
+/// @brief `LayerState` is a state in the current layer of the breadth-first search together with its vertex in the problem graph.
+struct LayerState
+{
+    Index state_index;
+    PackedState packed_state;
+    graphs::VertexIndex vertex;
+};
+
+struct LayerSuccessor
+{
+    GroundAction action;
+    ContinuousCost action_cost;
+    Index state_index;
+    PackedState packed_state;
+};
+
+/// @brief `LayerExpansion` is the result of expanding a state of the current layer.
+struct LayerExpansion
+{
+    bool is_goal;
+    GroundActionList actions;
+    std::vector<LayerSuccessor> successors;
+};
+
+/// @brief Compute the problem graph with a breadth-first search that expands the states of each layer concurrently.
+///
+/// The workers share the state repository of the context, which is switched to concurrent mode.
+/// Calls that may ground new actions or atoms in the problem are serialized.
+/// Workers only pass packed states, and the successors are merged into the graph in the order of their parents and actions,
+/// which results in the same graph as the sequential breadth-first search.
+///
+/// With symmetry reduction, the certificates of the distinct successors that were not generated before are computed concurrently
+/// after the expansion of the layer, when no more atoms are grounded, and the successors are merged into their classes afterwards.
+/// @param symm_data is the data of the symmetry reduction, or nullptr to disable it.
+static std::optional<StateSpace>
+compute_problem_graph_with_parallel_layers(const SearchContext& context, const StateSpaceImpl::Options& options, SymmetriesData* symm_data)
 {
     auto graph = graphs::StaticProblemGraph();
     auto goal_vertices = IndexSet {};
+    auto state_to_vertex_index = IndexMap<graphs::VertexIndex> {};  ///< Maps each generated state to the vertex of its (symmetry) class.
+
+    const auto& problem = context->get_problem();
+    const auto state_repository = context->get_state_repository();
+    const auto applicable_action_generator = context->get_applicable_action_generator();
+    const auto goal_strategy = ProblemGoalStrategyImpl::create(problem);
+    const auto has_axioms = !problem->get_problem_and_domain_axioms().empty();
+
+    state_repository->enable_concurrency();
+
+    if (!goal_strategy->test_static_goal())
+    {
+        return std::nullopt;
+    }
 
+    const auto [initial_state, initial_metric_value] = state_repository->get_or_create_initial_state();
+    const auto initial_vertex =
+        graph.add_vertex(initial_state.get_packed_state(), state_repository, DiscreteCost(0), ContinuousCost(0), false, false, false, false);
+    state_to_vertex_index.emplace(initial_state.get_index(), initial_vertex);
+
+    /* Each thread of the pool creates object graphs with its own builder. */
+    auto object_graph_builders = std::vector<ObjectGraphBuilder> {};
+    auto object_graphs = std::vector<graphs::StaticVertexColoredGraph> {};
+
+    if (symm_data)
+    {
+        object_graph_builders.reserve(options.num_layer_threads);
+        for (uint32_t i = 0; i < options.num_layer_threads; ++i)
+        {
+            object_graph_builders.emplace_back(*problem);
+        }
+        object_graphs.resize(options.num_layer_threads);
+
+        auto certificate = compute_certificate(initial_state, object_graph_builders.front(), object_graphs.front());
+        symm_data->certificate_maps.state_to_cert.emplace(initial_state, certificate);
+        symm_data->certificate_maps.cert_to_v_idx.emplace(std::move(certificate), initial_vertex);
+    }
+
+    auto layer = std::vector<LayerState> { LayerState { initial_state.get_index(), initial_state.get_packed_state(), initial_vertex } };
+    auto next_layer = std::vector<LayerState> {};
+    auto expansions = std::vector<LayerExpansion> {};
+    auto new_states = std::vector<LayerSuccessor> {};
+    auto new_state_positions = IndexMap<Index> {};
+    auto certificates = std::vector<nauty::SparseGraph> {};
+    auto problem_mutex = std::mutex();  ///< Serializes calls that may ground new actions or atoms in the problem.
+
+    auto pool = BS::thread_pool(options.num_layer_threads);
+
+    for (auto g_value = DiscreteCost(0); !layer.empty(); ++g_value)
+    {
+        expansions.resize(std::max(expansions.size(), layer.size()));
+
+        parallel_for(pool,
+                     layer.size(),
+                     [&](size_t i)
+                     {
+                         auto& expansion = expansions[i];
+                         const auto state = state_repository->get_state(layer[i].state_index, layer[i].packed_state);
+
+                         expansion.is_goal = goal_strategy->test_dynamic_goal(state);
+
+                         auto lock = std::unique_lock<std::mutex>(problem_mutex);
+
+                         expansion.actions.clear();
+                         for (const auto& action : applicable_action_generator->create_applicable_action_generator(state))
+                         {
+                             expansion.actions.push_back(action);
+                         }
+
+                         if (!has_axioms)
+                         {
+                             lock.unlock();
+                         }
+
+                         expansion.successors.clear();
+                         for (const auto& action : expansion.actions)
+                         {
+                             const auto [successor_state, successor_state_metric_value] =
+                                 state_repository->get_or_create_successor_state(state, action, g_value);
+                             expansion.successors.push_back(LayerSuccessor { action,
+                                                                             successor_state_metric_value - g_value,
+                                                                             successor_state.get_index(),
+                                                                             successor_state.get_packed_state() });
+                         }
+                     });
+
+        /* Compute the certificates of the successors that were not generated before. */
+
+        if (symm_data)
+        {
+            new_states.clear();
+            new_state_positions.clear();
+            for (size_t i = 0; i < layer.size(); ++i)
+            {
+                for (const auto& successor : expansions[i].successors)
+                {
+                    if (!state_to_vertex_index.contains(successor.state_index) && new_state_positions.emplace(successor.state_index, new_states.size()).second)
+                    {
+                        new_states.push_back(successor);
+                    }
+                }
+            }
+
+            certificates.resize(new_states.size());
+            parallel_for(pool,
+                         new_states.size(),
+                         [&](size_t i)
+                         {
+                             const auto thread_index = BS::this_thread::get_index().value();
+
+                             const auto state = state_repository->get_state(new_states[i].state_index, new_states[i].packed_state);
+                             certificates[i] = compute_certificate(state, object_graph_builders[thread_index], object_graphs[thread_index]);
+                         });
+        }
+
+        /* Merge the successors in the order of the sequential breadth-first search. */
+
+        next_layer.clear();
+        const auto add_layer_vertex = [&](const LayerSuccessor& successor)
+        {
+            const auto vertex =
+                graph.add_vertex(successor.packed_state, state_repository, DiscreteCost(0), ContinuousCost(0), false, false, false, false);
+            next_layer.push_back(LayerState { successor.state_index, successor.packed_state, vertex });
+            return vertex;
+        };
+        for (size_t i = 0; i < layer.size(); ++i)
+        {
+            const auto& expansion = expansions[i];
+            const auto source_vertex = layer[i].vertex;
+
+            if (expansion.is_goal)
+            {
+                goal_vertices.insert(source_vertex);
+            }
+
+            for (const auto& successor : expansion.successors)
+            {
+                auto it = state_to_vertex_index.find(successor.state_index);
+                if (it == state_to_vertex_index.end())
+                {
+                    if (symm_data)
+                    {
+                        const auto& certificate = certificates[new_state_positions.at(successor.state_index)];
+                        auto& cert_to_v_idx = symm_data->certificate_maps.cert_to_v_idx;
+                        auto certificate_it = cert_to_v_idx.find(certificate);
+                        if (certificate_it == cert_to_v_idx.end())
+                        {
+                            const auto target_vertex = add_layer_vertex(successor);
+                            symm_data->certificate_maps.state_to_cert.emplace(state_repository->get_state(successor.state_index, successor.packed_state),
+                                                                              certificate);
+                            certificate_it = cert_to_v_idx.emplace(certificate, target_vertex).first;
+                        }
+                        it = state_to_vertex_index.emplace(successor.state_index, certificate_it->second).first;
+                    }
+                    else
+                    {
+                        it = state_to_vertex_index.emplace(successor.state_index, add_layer_vertex(successor)).first;
+                    }
+                }
+
+                if (!symm_data || symm_data->m_edges.emplace(source_vertex, it->second).second)  ///< avoid adding parallel edges between classes
+                {
+                    graph.add_directed_edge(source_vertex, it->second, successor.action, problem, successor.action_cost);
+                }
+            }
+
+            if (graph.get_num_vertices() >= options.max_num_states)
+            {
+                return std::nullopt;  ///< ran out of resources.
+            }
+        }
+
+        std::swap(layer, next_layer);
+
+        applicable_action_generator->on_finish_search_layer();
+        state_repository->get_axiom_evaluator()->on_finish_search_layer();
+    }
+
+    return perform_reachability_analysis(context, std::move(graph), std::move(goal_vertices), options);
+}
+
+static std::optional<std::pair<StateSpace, CertificateMaps>> compute_problem_graph_with_symmetry_reduction(const SearchContext& context,
+                                                                                                           const StateSpaceImpl::Options& options)
+{
     auto symm_data = SymmetriesData();
 
+    if (options.num_layer_threads > 1)
+    {
+        auto state_space = compute_problem_graph_with_parallel_layers(context, options, &symm_data);
+
+        if (!state_space)
+        {
+            return std::nullopt;
+        }
+
+        return std::make_pair(state_space.value(), std::move(symm_data.certificate_maps));
+    }
+
+    auto graph = graphs::StaticProblemGraph();
+    auto goal_vertices = IndexSet {};
+
     const auto event_handler =
         std::make_shared<SymmetryReducedProblemGraphEventHandler>(context->get_state_repository(), options, graph, goal_vertices, symm_data, false);
     const auto pruning_strategy = std::make_shared<SymmetryStatePruning>(symm_data);
@@ -413,6 +691,11 @@ static std::optional<std::pair<StateSpace, CertificateMaps>> compute_problem_gra
 
 static std::optional<StateSpace> compute_problem_graph_without_symmetry_reduction(const SearchContext& context, const StateSpaceImpl::Options& options)
 {
+    if (options.num_layer_threads > 1)
+    {
+        return compute_problem_graph_with_parallel_layers(context, options, nullptr);
+    }
+
     auto graph = graphs::StaticProblemGraph();
     auto goal_vertices = IndexSet {};
 
@@ -474,30 +757,70 @@ std::optional<std::pair<StateSpace, std::optional<CertificateMaps>>> StateSpaceI
 
 std::vector<std::pair<StateSpace, std::optional<CertificateMaps>>> StateSpaceImpl::create(search::GeneralizedSearchContext contexts, const Options& options)
 {
-    auto state_spaces = std::vector<std::pair<StateSpace, std::optional<CertificateMaps>>> {};
+    const auto& search_contexts = contexts->get_search_contexts();
+
+    /* Each problem has its own repositories, allowing to construct the state spaces concurrently. */
+
+    auto results = std::vector<std::optional<std::pair<StateSpace, std::optional<CertificateMaps>>>>(search_contexts.size());
+    auto exceptions = std::vector<std::exception_ptr>(search_contexts.size());
 
-    for (const auto& context : contexts->get_search_contexts())
+    const auto create_ith = [&](size_t i)
     {
+        const auto& context = search_contexts[i];
+
         if (options.remove_if_unsolvable && !context->get_problem()->static_goal_holds())
         {
-            continue;
+            return;
+        }
+
+        try
+        {
+            results[i] = create(context, options);
+        }
+        catch (...)
+        {
+            exceptions[i] = std::current_exception();
         }
+    };
 
-        auto result = create(context, options);
+    if (options.num_threads > 1 && search_contexts.size() > 1)
+    {
+        auto pool = BS::thread_pool(std::min(size_t(options.num_threads), search_contexts.size()));
+        pool.detach_sequence(size_t(0), search_contexts.size(), create_ith);
+        pool.wait();
+    }
+    else
+    {
+        for (size_t i = 0; i < search_contexts.size(); ++i)
+        {
+            create_ith(i);
+        }
+    }
+
+    /* Collect the results in the order of the problems. */
+
+    auto state_spaces = std::vector<std::pair<StateSpace, std::optional<CertificateMaps>>> {};
+
+    for (size_t i = 0; i < search_contexts.size(); ++i)
+    {
+        if (exceptions[i])
+        {
+            std::rethrow_exception(exceptions[i]);
+        }
 
-        if (!result)
+        if (!results[i])
         {
             continue;
         }
 
-        state_spaces.emplace_back(std::move(result.value()));
+        state_spaces.emplace_back(std::move(results[i].value()));
     }
 
     if (options.sort_ascending_by_num_states)
     {
-        std::sort(state_spaces.begin(),
-                  state_spaces.end(),
-                  [](auto&& lhs, auto&& rhs) { return lhs.first->get_graph().get_num_vertices() < rhs.first->get_graph().get_num_vertices(); });
+        std::stable_sort(state_spaces.begin(),
+                         state_spaces.end(),
+                         [](auto&& lhs, auto&& rhs) { return lhs.first->get_graph().get_num_vertices() < rhs.first->get_graph().get_num_vertices(); });
     }
 
     return state_spaces;
@@ -17,12 +17,20 @@
 
 #include "mimir/datasets/tuple_graph.hpp"
 
+#include "mimir/algorithms/BS_thread_pool.hpp"
+#include "mimir/algorithms/parallel_for.hpp"
 #include "mimir/datasets/state_space.hpp"
 #include "mimir/formalism/problem.hpp"
 #include "mimir/search/search_context.hpp"
 #include "mimir/search/state.hpp"
+#include "mimir/search/state_repository.hpp"
 #include "tuple_graph_factory.hpp"
 
+#include <algorithm>
+#include <functional>
+#include <memory>
+#include <mutex>
+
 using namespace mimir::formalism;
 using namespace mimir::search;
 
@@ -47,13 +55,79 @@ const IndexGroupedVector<const Index>& TupleGraphImpl::get_tuple_vertex_indices_
 
 const IndexGroupedVector<const Index>& TupleGraphImpl::get_problem_vertex_indices_grouped_by_distance() const { return m_problem_v_idxs_grouped_by_distance; }
 
+size_t TupleGraphImpl::get_estimated_memory_usage_in_bytes() const
+{
+    auto num_bytes = sizeof(TupleGraphImpl);
+
+    for (const auto& vertex : m_graph.get_vertices())
+    {
+        num_bytes += sizeof(vertex) + get_atom_tuple(vertex).capacity() * sizeof(iw::AtomIndex) + get_problem_vertices(vertex).capacity() * sizeof(Index);
+    }
+    // Each edge is additionally stored in the forward and backward adjacency of the bidirectional graph.
+    num_bytes += m_graph.get_num_edges() * (sizeof(graphs::InternalTupleGraph::EdgeType) + 2 * sizeof(Index));
+
+    for (const auto& grouped_vector : { std::cref(m_v_idxs_grouped_by_distance), std::cref(m_problem_v_idxs_grouped_by_distance) })
+    {
+        num_bytes += (grouped_vector.get().size() + 1) * sizeof(size_t);
+        for (const auto group : grouped_vector.get())
+        {
+            num_bytes += group.size() * sizeof(Index);
+        }
+    }
+
+    return num_bytes;
+}
+
 TupleGraphList TupleGraphImpl::create(StateSpace state_space, std::optional<CertificateMaps>& certificate_maps, const Options& options)
 {
-    auto tuple_graphs = TupleGraphList {};
+    auto workspace_memory_usage_in_bytes = size_t(0);
+    return create(std::move(state_space), certificate_maps, options, workspace_memory_usage_in_bytes);
+}
+
+TupleGraphList TupleGraphImpl::create(StateSpace state_space,
+                                      std::optional<CertificateMaps>& certificate_maps,
+                                      const Options& options,
+                                      size_t& out_workspace_memory_usage_in_bytes)
+{
+    const auto& graph = state_space->get_graph();
+    const auto num_vertices = graph.get_num_vertices();
+    const auto num_threads = std::max(size_t(1), std::min(size_t(options.num_threads), num_vertices));
+
+    /* Each thread creates the tuple graphs with its own workspace. */
+    auto problem_mutex = std::mutex();  ///< Serializes calls that may ground new actions or atoms in the problem.
+    auto workspaces = std::vector<std::unique_ptr<TupleGraphWorkspace>> {};
+    for (size_t i = 0; i < num_threads; ++i)
+    {
+        workspaces.push_back(std::make_unique<TupleGraphWorkspace>(state_space, certificate_maps, options, problem_mutex));
+    }
+
+    auto tuple_graphs = TupleGraphList(num_vertices);
+
+    if (num_threads == 1)
+    {
+        for (Index v_idx = 0; v_idx < num_vertices; ++v_idx)
+        {
+            tuple_graphs[v_idx] = create_tuple_graph(graph.get_vertex(v_idx), *workspaces.front());
+        }
+    }
+    else
+    {
+        state_space->get_search_context()->get_state_repository()->enable_concurrency();
+
+        auto pool = BS::thread_pool(num_threads);
+        parallel_for(pool,
+                     num_vertices,
+                     [&](size_t v_idx)
+                     {
+                         auto& workspace = *workspaces[BS::this_thread::get_index().value()];
+                         tuple_graphs[v_idx] = create_tuple_graph(graph.get_vertex(v_idx), workspace);
+                     });
+    }
 
-    for (const auto& v : state_space->get_graph().get_vertices())
+    out_workspace_memory_usage_in_bytes = 0;
+    for (const auto& workspace : workspaces)
     {
-        tuple_graphs.push_back(create_tuple_graph(v, state_space, certificate_maps, options));
+        out_workspace_memory_usage_in_bytes += workspace->get_estimated_memory_usage_in_bytes();
     }
 
     return tuple_graphs;
@@ -26,17 +26,306 @@
 #include "mimir/search/state.hpp"
 #include "mimir/search/state_repository.hpp"
 
+#include <algorithm>
+#include <cassert>
+#include <span>
+
 using namespace mimir::formalism;
 using namespace mimir::search;
 
 namespace mimir::datasets
 {
+
+static constexpr Index NO_INDEX = std::numeric_limits<Index>::max();
+
+TupleGraphWorkspace::TupleGraphWorkspace(const StateSpace& state_space,
+                                         const std::optional<CertificateMaps>& certificate_maps,
+                                         const TupleGraphImpl::Options& options,
+                                         std::mutex& problem_mutex) :
+    state_space(state_space),
+    certificate_maps(certificate_maps),
+    options(options),
+    problem_mutex(problem_mutex),
+    novelty_table(),
+    object_graph_builder(),
+    successor_begin(),
+    successor_end(),
+    successors(),
+    state_to_problem_v_idx(),
+    tuples(),
+    tuple_rank_to_index(),
+    tuple_to_index(),
+    root_stamp(0),
+    tuple_stamps(),
+    tuple_to_local_index(),
+    local_index_to_tuple_index(),
+    visited_problem_v_idx_stamps(state_space->get_graph().get_num_vertices(), 0),
+    visited_state_stamps(),
+    layer_stamp(0),
+    layer_problem_v_idx_stamps(state_space->get_graph().get_num_vertices(), 0),
+    layer_problem_v_idx_positions(state_space->get_graph().get_num_vertices(), NO_INDEX)
+{
+    if (options.width > 0)
+    {
+        novelty_table.emplace(options.width);
+    }
+    if (certificate_maps)
+    {
+        object_graph_builder.emplace(*state_space->get_search_context()->get_problem());
+    }
+}
+
+template<typename T>
+static size_t get_num_bytes(const std::vector<T>& vec)
+{
+    return vec.capacity() * sizeof(T);
+}
+
+template<typename T>
+static size_t get_num_bytes(const std::vector<std::vector<T>>& vecs)
+{
+    auto num_bytes = vecs.capacity() * sizeof(std::vector<T>);
+    for (const auto& vec : vecs)
+    {
+        num_bytes += get_num_bytes(vec);
+    }
+    return num_bytes;
+}
+
+size_t TupleGraphWorkspace::get_estimated_memory_usage_in_bytes() const
+{
+    auto num_bytes = sizeof(TupleGraphWorkspace);
+
+    num_bytes += get_num_bytes(successor_begin) + get_num_bytes(successor_end) + get_num_bytes(successors) + get_num_bytes(state_to_problem_v_idx);
+    num_bytes += get_num_bytes(tuples) + get_num_bytes(tuple_rank_to_index);
+    // Each hashed tuple is a node with a copy of the tuple, and each bucket is a pointer.
+    num_bytes += tuple_to_index.bucket_count() * sizeof(void*);
+    for (const auto& [tuple, t_idx] : tuple_to_index)
+    {
+        num_bytes += sizeof(std::pair<const iw::AtomIndexList, Index>) + sizeof(void*) + get_num_bytes(tuple);
+    }
+
+    num_bytes += get_num_bytes(tuple_stamps) + get_num_bytes(tuple_to_local_index) + get_num_bytes(local_index_to_tuple_index);
+    num_bytes += get_num_bytes(visited_problem_v_idx_stamps) + get_num_bytes(visited_state_stamps);
+    num_bytes += get_num_bytes(layer_problem_v_idx_stamps) + get_num_bytes(layer_problem_v_idx_positions);
+
+    num_bytes += get_num_bytes(prev_problem_v_idxs) + get_num_bytes(curr_problem_v_idxs) + get_num_bytes(prev_states) + get_num_bytes(curr_states);
+    num_bytes += get_num_bytes(prev_v_idxs) + get_num_bytes(curr_v_idxs) + get_num_bytes(novel_tuples);
+    num_bytes += get_num_bytes(novel_pairs) + get_num_bytes(novel_t_idxs) + get_num_bytes(novel_offsets) + get_num_bytes(novel_problem_v_idxs);
+    num_bytes += get_num_bytes(layer_pairs) + get_num_bytes(layer_offsets) + get_num_bytes(layer_novel_positions);
+    num_bytes += get_num_bytes(extension_counts) + get_num_bytes(extension_markers) + get_num_bytes(touched_novel_positions);
+    num_bytes += get_num_bytes(extended_pairs) + get_num_bytes(extended_positions) + get_num_bytes(extended_offsets) + get_num_bytes(extended_prev_v_idxs);
+    num_bytes += is_pruned.capacity() / 8;
+
+    return num_bytes;
+}
+
+/**
+ * Workspace helpers
+ */
+
+template<typename T>
+static void resize_to_fit(std::vector<T>& ref_vec, size_t pos, T value)
+{
+    if (pos >= ref_vec.size())
+    {
+        ref_vec.resize(std::max(pos + 1, 2 * ref_vec.size()), value);
+    }
+}
+
+static std::span<const Index> get_range(const IndexList& offsets, const IndexList& values, size_t pos)
+{
+    return std::span<const Index>(values.data() + offsets[pos], offsets[pos + 1] - offsets[pos]);
+}
+
+/// @brief Start the computation of a new root by invalidating the data of the previous root.
+static void start_root(TupleGraphWorkspace& ws)
+{
+    ++ws.root_stamp;
+    ws.local_index_to_tuple_index.clear();
+    if (ws.novelty_table)
+    {
+        ws.novelty_table->reset();
+    }
+    ws.prev_problem_v_idxs.clear();
+    ws.curr_problem_v_idxs.clear();
+    ws.prev_states.clear();
+    ws.curr_states.clear();
+    ws.prev_v_idxs.clear();
+    ws.curr_v_idxs.clear();
+}
+
+/// @brief Release the states of the root, which must be destroyed by the thread that created them.
+static void finish_root(TupleGraphWorkspace& ws)
+{
+    ws.prev_states.clear();
+    ws.curr_states.clear();
+}
+
+/// @brief Mark the problem vertex as visited from the current root.
+/// @return true iff the problem vertex was not visited before.
+static bool visit_problem_vertex(TupleGraphWorkspace& ws, Index problem_v_idx)
+{
+    if (ws.visited_problem_v_idx_stamps[problem_v_idx] == ws.root_stamp)
+    {
+        return false;
+    }
+    ws.visited_problem_v_idx_stamps[problem_v_idx] = ws.root_stamp;
+    return true;
+}
+
+/// @brief Mark the state as visited from the current root.
+/// @return true iff the state was not visited before.
+static bool visit_state(TupleGraphWorkspace& ws, Index state_index)
+{
+    resize_to_fit(ws.visited_state_stamps, state_index, uint64_t(0));
+    if (ws.visited_state_stamps[state_index] == ws.root_stamp)
+    {
+        return false;
+    }
+    ws.visited_state_stamps[state_index] = ws.root_stamp;
+    return true;
+}
+
+/// @brief Get the successors of the state, generating them on first use.
+static std::span<const std::pair<Index, PackedState>> get_or_create_successors(TupleGraphWorkspace& ws, const State& state)
+{
+    const auto state_index = state.get_index();
+    resize_to_fit(ws.successor_begin, state_index, NO_INDEX);
+    resize_to_fit(ws.successor_end, state_index, NO_INDEX);
+
+    if (ws.successor_begin[state_index] == NO_INDEX)
+    {
+        const auto& search_context = *ws.state_space->get_search_context();
+
+        auto lock = std::lock_guard<std::mutex>(ws.problem_mutex);
+
+        ws.successor_begin[state_index] = ws.successors.size();
+        for (const auto& action : search_context.get_applicable_action_generator()->create_applicable_action_generator(state))
+        {
+            const auto [successor_state, successor_state_metric_value] =
+                search_context.get_state_repository()->get_or_create_successor_state(state, action, ContinuousCost(0));
+            ws.successors.emplace_back(successor_state.get_index(), successor_state.get_packed_state());
+        }
+        ws.successor_end[state_index] = ws.successors.size();
+    }
+
+    const auto begin = ws.successor_begin[state_index];
+    return std::span<const std::pair<Index, PackedState>>(ws.successors.data() + begin, ws.successor_end[state_index] - begin);
+}
+
+/// @brief Get the vertex of the `StateSpace` that represents the symmetry class of the state, canonizing its object graph on first use.
+static Index get_or_create_problem_vertex(TupleGraphWorkspace& ws, const State& state)
+{
+    const auto state_index = state.get_index();
+    resize_to_fit(ws.state_to_problem_v_idx, state_index, NO_INDEX);
+
+    if (ws.state_to_problem_v_idx[state_index] == NO_INDEX)
+    {
+        const auto& certificate_maps = ws.certificate_maps.value();
+
+        const auto it = certificate_maps.state_to_cert.find(state);
+        if (it != certificate_maps.state_to_cert.end())
+        {
+            ws.state_to_problem_v_idx[state_index] = certificate_maps.cert_to_v_idx.at(it->second);
+        }
+        else
+        {
+            {
+                // The builder reads the ground atoms of the problem, which other threads may extend concurrently.
+                auto lock = std::lock_guard<std::mutex>(ws.problem_mutex);
+                ws.object_graph_builder->create(state, ws.flat_object_graph);
+            }
+            ws.object_graph_builder->translate(ws.flat_object_graph, ws.object_graph);
+            ws.state_to_problem_v_idx[state_index] = certificate_maps.cert_to_v_idx.at(graphs::nauty::SparseGraph(ws.object_graph).canonize());
+        }
+    }
+
+    return ws.state_to_problem_v_idx[state_index];
+}
+
+/// @brief Tuples of at most this many atoms are indexed by their rank instead of being hashed.
+static constexpr size_t MAX_RANKED_TUPLE_SIZE = 2;
+
+/// @brief The ranks index an array of at most this many entries, and tuples with a larger rank are hashed instead.
+static constexpr size_t MAX_NUM_TUPLE_RANKS = size_t(1) << 22;
+
+/// @brief Get the rank of a sorted tuple of at most `width` atoms.
+/// The empty tuple has rank 0. For width 1, a tuple (a) has rank 1 + a. For width 2, a tuple (a, b) with a <= b has rank
+/// 1 + b * (b + 1) / 2 + a, where a tuple (a) counts as (a, a). The ranks are dense and do not depend on the number of atoms,
+/// which grows while the tuple graphs are created.
+static size_t get_tuple_rank(const iw::AtomIndexList& tuple, size_t width)
+{
+    assert(width <= MAX_RANKED_TUPLE_SIZE && tuple.size() <= width);
+
+    if (tuple.empty())
+    {
+        return 0;
+    }
+    const auto a = size_t(tuple.front());
+    if (width == 1)
+    {
+        return 1 + a;
+    }
+    const auto b = size_t(tuple.back());
+    return 1 + b * (b + 1) / 2 + a;
+}
+
+/// @brief Get the index of the tuple that is global to the workspace.
+static Index get_or_create_tuple_index(TupleGraphWorkspace& ws, const iw::AtomIndexList& tuple)
+{
+    if (ws.options.width <= MAX_RANKED_TUPLE_SIZE)
+    {
+        const auto rank = get_tuple_rank(tuple, ws.options.width);
+        if (rank < MAX_NUM_TUPLE_RANKS)
+        {
+            if (rank >= ws.tuple_rank_to_index.size())
+            {
+                ws.tuple_rank_to_index.resize(std::min(std::max(rank + 1, 2 * ws.tuple_rank_to_index.size()), MAX_NUM_TUPLE_RANKS), NO_INDEX);
+            }
+            if (ws.tuple_rank_to_index[rank] == NO_INDEX)
+            {
+                ws.tuple_rank_to_index[rank] = ws.tuples.size();
+                ws.tuples.push_back(tuple);
+            }
+            return ws.tuple_rank_to_index[rank];
+        }
+    }
+
+    const auto [it, inserted] = ws.tuple_to_index.emplace(tuple, ws.tuples.size());
+    if (inserted)
+    {
+        ws.tuples.push_back(tuple);
+    }
+    return it->second;
+}
+
+/// @brief Get the index of the tuple that is local to the current root.
+static Index get_or_create_local_tuple_index(TupleGraphWorkspace& ws, const iw::AtomIndexList& tuple)
+{
+    const auto t_idx = get_or_create_tuple_index(ws, tuple);
+
+    resize_to_fit(ws.tuple_stamps, t_idx, uint64_t(0));
+    resize_to_fit(ws.tuple_to_local_index, t_idx, NO_INDEX);
+    if (ws.tuple_stamps[t_idx] != ws.root_stamp)
+    {
+        ws.tuple_stamps[t_idx] = ws.root_stamp;
+        ws.tuple_to_local_index[t_idx] = ws.local_index_to_tuple_index.size();
+        ws.local_index_to_tuple_index.push_back(t_idx);
+    }
+
+    return ws.tuple_to_local_index[t_idx];
+}
+
+/**
+ * Width zero
+ */
+
 class TupleGraphArityZeroComputation
 {
 private:
     const graphs::ProblemVertex& m_problem_vertex;
-    const StateSpace& m_state_space;
-    std::optional<CertificateMaps>& m_certificate_maps;
+    TupleGraphWorkspace& m_workspace;
 
     graphs::StaticTupleGraph m_internal_tuple_graph;
     IndexGroupedVectorBuilder<const Index> m_v_idxs_grouped_by_distance;
@@ -54,23 +343,29 @@ private:
         m_v_idxs_grouped_by_distance.add_group_element(m_root_v_idx);
     }
 
+    void add_distance_one_vertex(Index problem_v_idx)
+    {
+        const auto v_idx = m_internal_tuple_graph.add_vertex(search::iw::AtomIndexList {}, IndexList { problem_v_idx });
+        m_internal_tuple_graph.add_directed_edge(m_root_v_idx, v_idx);
+
+        m_v_idxs_grouped_by_distance.add_group_element(v_idx);
+        m_problem_v_idxs_grouped_by_distance.add_group_element(problem_v_idx);
+    }
+
     void compute_distance_one_vertices_without_symmetry_reduction()
     {
         m_v_idxs_grouped_by_distance.start_group();
         m_problem_v_idxs_grouped_by_distance.start_group();
 
-        for (const auto& adj_problem_vertex : m_state_space->get_graph().get_adjacent_vertices<graphs::ForwardTag>(m_problem_vertex.get_index()))
+        for (const auto& adj_problem_v_idx :
+             m_workspace.state_space->get_graph().get_adjacent_vertex_indices<graphs::ForwardTag>(m_problem_vertex.get_index()))
         {
-            if (adj_problem_vertex.get_index() == m_problem_vertex.get_index())
+            if (adj_problem_v_idx == m_problem_vertex.get_index())
             {
                 continue;  ///< self-looping edge
             }
 
-            const auto adj_v_idx = m_internal_tuple_graph.add_vertex(search::iw::AtomIndexList {}, IndexList { adj_problem_vertex.get_index() });
-            m_internal_tuple_graph.add_directed_edge(m_root_v_idx, adj_v_idx);
-
-            m_v_idxs_grouped_by_distance.add_group_element(adj_v_idx);
-            m_problem_v_idxs_grouped_by_distance.add_group_element(adj_problem_vertex.get_index());
+            add_distance_one_vertex(adj_problem_v_idx);
         }
     }
 
@@ -79,47 +374,27 @@ private:
         m_v_idxs_grouped_by_distance.start_group();
         m_problem_v_idxs_grouped_by_distance.start_group();
 
-        const auto root_state = graphs::get_state(m_problem_vertex);
-        auto& applicable_action_generator = *m_state_space->get_search_context()->get_applicable_action_generator();
-        auto& state_repository = *m_state_space->get_search_context()->get_state_repository();
-        const auto& problem = *m_state_space->get_search_context()->get_problem();
+        auto& ws = m_workspace;
+        auto& state_repository = *ws.state_space->get_search_context()->get_state_repository();
 
-        auto novel_problem_v_idxs = graphs::VertexIndexSet {};
-        novel_problem_v_idxs.insert(m_problem_vertex.get_index());
+        visit_problem_vertex(ws, m_problem_vertex.get_index());
 
-        for (const auto& action : applicable_action_generator.create_applicable_action_generator(root_state))
+        ws.curr_states.push_back(graphs::get_state(m_problem_vertex));
+        for (const auto& [successor_index, successor_packed_state] : get_or_create_successors(ws, ws.curr_states.front()))
         {
-            const auto [successor_state, successor_state_metric] =
-                state_repository.get_or_create_successor_state(root_state, action, compute_state_metric_value(root_state));
-
-            if (!m_certificate_maps->state_to_cert.contains(successor_state))
-            {
-                m_certificate_maps->state_to_cert.emplace(successor_state,
-                                                          graphs::nauty::SparseGraph(create_object_graph(successor_state, problem)).canonize());
-            }
+            const auto problem_v_idx = get_or_create_problem_vertex(ws, state_repository.get_state(successor_index, successor_packed_state));
 
-            const auto problem_v_idx = m_certificate_maps->cert_to_v_idx.at(m_certificate_maps->state_to_cert.at(successor_state));
-
-            if (!novel_problem_v_idxs.contains(problem_v_idx))
+            if (visit_problem_vertex(ws, problem_v_idx))
             {
-                novel_problem_v_idxs.insert(problem_v_idx);
-
-                const auto v_idx = m_internal_tuple_graph.add_vertex(search::iw::AtomIndexList {}, IndexList { problem_v_idx });
-                m_internal_tuple_graph.add_directed_edge(m_root_v_idx, v_idx);
-
-                m_v_idxs_grouped_by_distance.add_group_element(v_idx);
-                m_problem_v_idxs_grouped_by_distance.add_group_element(problem_v_idx);
+                add_distance_one_vertex(problem_v_idx);
             }
         }
     }
 
 public:
-    TupleGraphArityZeroComputation(const graphs::ProblemVertex& problem_vertex,
-                                   const StateSpace& state_space,
-                                   std::optional<CertificateMaps>& certificate_maps) :
+    TupleGraphArityZeroComputation(const graphs::ProblemVertex& problem_vertex, TupleGraphWorkspace& workspace) :
         m_problem_vertex(problem_vertex),
-        m_state_space(state_space),
-        m_certificate_maps(certificate_maps),
+        m_workspace(workspace),
         m_internal_tuple_graph(),
         m_v_idxs_grouped_by_distance(),
         m_problem_v_idxs_grouped_by_distance()
@@ -128,195 +403,158 @@ public:
 
     TupleGraph compute_and_get_result()
     {
+        start_root(m_workspace);
+
         compute_distance_zero_vertices();
 
-        (m_certificate_maps) ? compute_distance_one_vertices_with_symmetry_reduction() : compute_distance_one_vertices_without_symmetry_reduction();
+        (m_workspace.certificate_maps) ? compute_distance_one_vertices_with_symmetry_reduction() :
+                                         compute_distance_one_vertices_without_symmetry_reduction();
 
-        return std::make_shared<TupleGraphImpl>(m_state_space,
+        finish_root(m_workspace);
+
+        return std::make_shared<TupleGraphImpl>(m_workspace.state_space,
                                                 graphs::InternalTupleGraph(std::move(m_internal_tuple_graph)),
                                                 m_v_idxs_grouped_by_distance.get_result(),
                                                 m_problem_v_idxs_grouped_by_distance.get_result());
     }
 };
 
-static TupleGraph
-create_tuple_graph_width_zero(const graphs::ProblemVertex& problem_vertex, const StateSpace& state_space, std::optional<CertificateMaps>& certificate_maps)
-{
-    return TupleGraphArityZeroComputation(problem_vertex, state_space, certificate_maps).compute_and_get_result();
-}
+/**
+ * Width greater zero
+ */
 
 class TupleGraphArityGreaterZeroComputation
 {
 private:
     const graphs::ProblemVertex& m_problem_vertex;
-    const StateSpace& m_state_space;
-    std::optional<CertificateMaps>& m_certificate_maps;
-    const TupleGraphImpl::Options& m_options;
+    TupleGraphWorkspace& m_workspace;
 
     graphs::StaticTupleGraph m_internal_tuple_graph;
     IndexGroupedVectorBuilder<const Index> m_v_idxs_grouped_by_distance;
     IndexGroupedVectorBuilder<const Index> m_problem_v_idxs_grouped_by_distance;
 
-    // Common book-keeping
-    IndexList m_prev_problem_v_idxs;
-    IndexList m_curr_problem_v_idxs;
-    IndexSet m_visited_problem_v_idxs;
-    StateSet m_prev_states;
-    StateSet m_curr_states;
-    StateSet m_visited_states;
-    IndexList m_prev_v_idxs;
-    IndexList m_curr_v_idxs;
-    iw::DynamicNoveltyTable m_novelty_table;
-
-    // Map tuples to an index that avoids invalidation of tuple indices upon resizing of the DynamicNoveltyTable.
-    std::unordered_map<IndexList, Index, loki::Hash<IndexList>, loki::EqualTo<IndexList>> m_tuple_to_index;
-    IndexMap<IndexList> m_index_to_tuple;
-    std::vector<IndexList> m_novel_tuples_vec;
-    IndexSet m_novel_t_idxs_set;
-    IndexMap<IndexSet> m_novel_t_idx_to_problem_v_idxs;   ///< one-to-one mapping
-    IndexMap<IndexList> m_problem_v_idx_to_novel_t_idxs;  ///< one-to-many mapping
-
-    IndexMap<IndexSet> m_cur_novel_t_idx_to_extended_problem_v_idx;
-    IndexMap<IndexSet> m_cur_extended_novel_t_idx_to_prev_problem_v_idxs;
-    IndexSet m_cur_extended_novel_t_idxs_set;
-    IndexList m_cur_extended_novel_t_idxs_vec;
-
-    IndexMap<IndexSet> m_t_idx_to_dominating_t_idxs;
-
     void compute_distance_zero_vertices()
     {
+        auto& ws = m_workspace;
+
         m_v_idxs_grouped_by_distance.start_group();
         m_problem_v_idxs_grouped_by_distance.start_group();
 
         const auto root_state = get_state(m_problem_vertex);
         const auto root_problem_v_idx = m_problem_vertex.get_index();
 
-        m_novelty_table.compute_novel_tuples(root_state, m_novel_tuples_vec);
-        for (const auto& novel_tuple : m_novel_tuples_vec)
+        ws.novelty_table->compute_novel_tuples(root_state, ws.novel_tuples);
+        for (const auto& novel_tuple : ws.novel_tuples)
         {
-            const auto it = m_tuple_to_index.find(novel_tuple);
-            auto tuple_index = Index();
-            if (it != m_tuple_to_index.end())
-            {
-                tuple_index = it->second;
-            }
-            else
-            {
-                tuple_index = m_tuple_to_index.size();
-                m_tuple_to_index.emplace(novel_tuple, tuple_index);
-                m_index_to_tuple.emplace(tuple_index, novel_tuple);
-            }
-
             const auto v_idx = m_internal_tuple_graph.add_vertex(novel_tuple, IndexList { root_problem_v_idx });
 
-            m_curr_v_idxs.push_back(v_idx);
+            ws.curr_v_idxs.push_back(v_idx);
             m_v_idxs_grouped_by_distance.add_group_element(v_idx);
 
-            if (m_options.enable_dominance_pruning)
+            if (ws.options.enable_dominance_pruning)
             {
                 // Break after the first tuple
                 break;
             }
         }
-        m_novelty_table.test_novelty_and_update_table(root_state);
+        ws.novelty_table->test_novelty_and_update_table(root_state);
 
         m_problem_v_idxs_grouped_by_distance.add_group_element(root_problem_v_idx);
-        m_curr_states.insert(root_state);
-        m_visited_states.insert(root_state);
-        m_curr_problem_v_idxs.clear();
-        m_curr_problem_v_idxs.push_back(root_problem_v_idx);
-        m_visited_problem_v_idxs.insert(root_problem_v_idx);
+        ws.curr_states.push_back(root_state);
+        visit_state(ws, root_state.get_index());
+        ws.curr_problem_v_idxs.push_back(root_problem_v_idx);
+        visit_problem_vertex(ws, root_problem_v_idx);
     }
 
     bool compute_next_state_layer()
     {
-        bool success = false;
+        auto& ws = m_workspace;
+        const auto& graph = ws.state_space->get_graph();
 
-        for (const auto& prev_problem_v_idx : m_prev_problem_v_idxs)
+        for (const auto& prev_problem_v_idx : ws.prev_problem_v_idxs)
         {
-            for (const auto& curr_problem_v_idx : m_state_space->get_graph().get_adjacent_vertex_indices<graphs::ForwardTag>(prev_problem_v_idx))
+            for (const auto& curr_problem_v_idx : graph.get_adjacent_vertex_indices<graphs::ForwardTag>(prev_problem_v_idx))
             {
-                if (!m_visited_problem_v_idxs.contains(curr_problem_v_idx))
+                if (visit_problem_vertex(ws, curr_problem_v_idx))
                 {
-                    m_curr_problem_v_idxs.push_back(curr_problem_v_idx);
-                    m_visited_problem_v_idxs.insert(curr_problem_v_idx);
-                    success = true;
+                    ws.curr_problem_v_idxs.push_back(curr_problem_v_idx);
                 }
             }
         }
 
-        /* Compute all states in next layer, even those that are symmetric, to compute all tuple indices. */
-        for (const auto& prev_state : m_prev_states)
+        if (ws.curr_problem_v_idxs.empty())
+        {
+            return false;
+        }
+
+        if (ws.certificate_maps)
         {
-            for (const auto& action : m_state_space->get_search_context()->get_applicable_action_generator()->create_applicable_action_generator(prev_state))
+            /* Compute all states in next layer, even those that are symmetric, to compute all tuple indices. */
+            auto& state_repository = *ws.state_space->get_search_context()->get_state_repository();
+
+            for (const auto& prev_state : ws.prev_states)
             {
-                const auto [successor_state, successor_state_metric_value] =
-                    m_state_space->get_search_context()->get_state_repository()->get_or_create_successor_state(prev_state, action, 0);
-                if (!m_visited_states.contains(successor_state))
+                for (const auto& [successor_index, successor_packed_state] : get_or_create_successors(ws, prev_state))
                 {
-                    m_curr_states.insert(successor_state);
-                    m_visited_states.insert(successor_state);
+                    if (visit_state(ws, successor_index))
+                    {
+                        ws.curr_states.push_back(state_repository.get_state(successor_index, successor_packed_state));
+                    }
                 }
             }
         }
+        else
+        {
+            /* The problem graph contains all states, so the states of the next layer are those of its vertices. */
+            for (const auto& curr_problem_v_idx : ws.curr_problem_v_idxs)
+            {
+                ws.curr_states.push_back(get_state(graph.get_vertex(curr_problem_v_idx)));
+            }
+        }
 
-        return success;
+        return true;
     }
 
     bool compute_next_layer()
     {
-        // Swap prev and curr data structures.
-        std::swap(m_curr_problem_v_idxs, m_prev_problem_v_idxs);
-        std::swap(m_curr_states, m_prev_states);
-        std::swap(m_curr_v_idxs, m_prev_v_idxs);
-        m_curr_problem_v_idxs.clear();
-        m_curr_states.clear();
-        m_curr_v_idxs.clear();
+        auto& ws = m_workspace;
 
+        // Swap prev and curr data structures.
+        std::swap(ws.curr_problem_v_idxs, ws.prev_problem_v_idxs);
+        std::swap(ws.curr_states, ws.prev_states);
+        std::swap(ws.curr_v_idxs, ws.prev_v_idxs);
+        ws.curr_problem_v_idxs.clear();
+        ws.curr_states.clear();
+        ws.curr_v_idxs.clear();
+
+        if (!compute_next_state_layer())
         {
-            const auto success = compute_next_state_layer();
-
-            if (!success)
-            {
-                return false;
-            }
+            return false;
         }
 
+        if (!compute_next_novel_tuple_indices())
         {
-            (m_certificate_maps) ? compute_next_novel_tuple_indices_with_symmetry_reduction() : compute_next_novel_tuple_indices_without_symmetry_reduction();
-
-            if (m_novel_t_idxs_set.empty())
-            {
-                return false;
-            }
+            return false;
         }
 
+        if (!extend_optimal_plans_from_prev_layer())
         {
-            extend_optimal_plans_from_prev_layer();
-
-            if (m_cur_extended_novel_t_idxs_set.empty())
-            {
-                return false;
-            }
+            return false;
         }
 
+        if (!instantiate_next_layer())
         {
-            const auto success = instantiate_next_layer();
-
-            if (!success)
-            {
-                return false;
-            }
+            return false;
         }
 
         // Create nonempty group.
         m_problem_v_idxs_grouped_by_distance.start_group();
-        for (const auto& problem_v_idx : m_curr_problem_v_idxs)
+        for (const auto& problem_v_idx : ws.curr_problem_v_idxs)
         {
             m_problem_v_idxs_grouped_by_distance.add_group_element(problem_v_idx);
         }
         m_v_idxs_grouped_by_distance.start_group();
-        for (const auto& v_idx : m_curr_v_idxs)
+        for (const auto& v_idx : ws.curr_v_idxs)
         {
             m_v_idxs_grouped_by_distance.add_group_element(v_idx);
         }
@@ -324,119 +562,123 @@ private:
         return true;
     }
 
-    void compute_next_novel_tuple_indices_without_symmetry_reduction()
+    bool compute_next_novel_tuple_indices()
     {
-        // Clear data structures
-        m_novel_t_idxs_set.clear();
-        m_novel_t_idx_to_problem_v_idxs.clear();
-        m_problem_v_idx_to_novel_t_idxs.clear();
+        auto& ws = m_workspace;
 
-        for (const auto& problem_v_idx : m_curr_problem_v_idxs)
+        /* Collect the pairs of novel tuple and representative vertex of the states in the layer. */
+        ws.novel_pairs.clear();
+        for (size_t i = 0; i < ws.curr_states.size(); ++i)
         {
-            m_novelty_table.compute_novel_tuples(get_state(m_state_space->get_graph().get_vertex(problem_v_idx)), m_novel_tuples_vec);
+            const auto& state = ws.curr_states[i];
+            const auto problem_v_idx = (ws.certificate_maps) ? get_or_create_problem_vertex(ws, state) : ws.curr_problem_v_idxs[i];
 
-            for (const auto& novel_tuple : m_novel_tuples_vec)
+            ws.novelty_table->compute_novel_tuples(state, ws.novel_tuples);
+            for (const auto& novel_tuple : ws.novel_tuples)
             {
-                const auto it = m_tuple_to_index.find(novel_tuple);
-                auto novel_t_idx = Index();
-                if (it != m_tuple_to_index.end())
-                {
-                    novel_t_idx = it->second;
-                }
-                else
-                {
-                    novel_t_idx = m_tuple_to_index.size();
-                    m_tuple_to_index.emplace(novel_tuple, novel_t_idx);
-                    m_index_to_tuple.emplace(novel_t_idx, novel_tuple);
-                }
-
-                m_novel_t_idx_to_problem_v_idxs[novel_t_idx].insert(problem_v_idx);
-                m_problem_v_idx_to_novel_t_idxs[problem_v_idx].push_back(novel_t_idx);
-                m_novel_t_idxs_set.insert(novel_t_idx);
+                ws.novel_pairs.emplace_back(get_or_create_local_tuple_index(ws, novel_tuple), problem_v_idx);
             }
         }
 
         /* Ensure that tuples of all states in layer are marked as not novel! */
-        for (const auto& state : m_curr_states)
+        for (const auto& state : ws.curr_states)
         {
-            m_novelty_table.test_novelty_and_update_table(state);
+            ws.novelty_table->test_novelty_and_update_table(state);
         }
-    }
 
-    void compute_next_novel_tuple_indices_with_symmetry_reduction()
-    {
-        // Clear data structures
-        m_novel_t_idxs_set.clear();
-        m_novel_t_idx_to_problem_v_idxs.clear();
-        m_problem_v_idx_to_novel_t_idxs.clear();
+        if (ws.novel_pairs.empty())
+        {
+            return false;
+        }
 
-        const auto& problem = *m_state_space->get_search_context()->get_problem();
+        /* Group the problem vertices by novel tuple. */
+        std::sort(ws.novel_pairs.begin(), ws.novel_pairs.end());
+        ws.novel_pairs.erase(std::unique(ws.novel_pairs.begin(), ws.novel_pairs.end()), ws.novel_pairs.end());
 
-        for (const auto& state : m_curr_states)
+        ws.novel_t_idxs.clear();
+        ws.novel_offsets.clear();
+        ws.novel_problem_v_idxs.clear();
+        for (const auto& [t_idx, problem_v_idx] : ws.novel_pairs)
         {
-            m_novelty_table.compute_novel_tuples(state, m_novel_tuples_vec);
-
-            /* Map state to representative vertex. */
-            if (!m_certificate_maps->state_to_cert.contains(state))
+            if (ws.novel_t_idxs.empty() || ws.novel_t_idxs.back() != t_idx)
             {
-                m_certificate_maps->state_to_cert.emplace(state, graphs::nauty::SparseGraph(create_object_graph(state, problem)).canonize());
+                ws.novel_t_idxs.push_back(t_idx);
+                ws.novel_offsets.push_back(ws.novel_problem_v_idxs.size());
             }
+            ws.novel_problem_v_idxs.push_back(problem_v_idx);
+        }
+        ws.novel_offsets.push_back(ws.novel_problem_v_idxs.size());
 
-            const auto problem_v_idx = m_certificate_maps->cert_to_v_idx.at(m_certificate_maps->state_to_cert.at(state));
-
-            /* Map novel tuples between representative vertex. */
-            for (const auto& novel_tuple : m_novel_tuples_vec)
+        /* Group the novel tuples by problem vertex. */
+        ws.layer_pairs.clear();
+        for (Index novel_pos = 0; novel_pos < ws.novel_t_idxs.size(); ++novel_pos)
+        {
+            for (const auto problem_v_idx : get_range(ws.novel_offsets, ws.novel_problem_v_idxs, novel_pos))
             {
-                const auto it = m_tuple_to_index.find(novel_tuple);
-                auto novel_t_idx = Index();
-                if (it != m_tuple_to_index.end())
-                {
-                    novel_t_idx = it->second;
-                }
-                else
-                {
-                    novel_t_idx = m_tuple_to_index.size();
-                    m_tuple_to_index.emplace(novel_tuple, novel_t_idx);
-                    m_index_to_tuple.emplace(novel_t_idx, novel_tuple);
-                }
-
-                m_novel_t_idx_to_problem_v_idxs[novel_t_idx].insert(problem_v_idx);
-                m_problem_v_idx_to_novel_t_idxs[problem_v_idx].push_back(novel_t_idx);
-                m_novel_t_idxs_set.insert(novel_t_idx);
+                ws.layer_pairs.emplace_back(problem_v_idx, novel_pos);
             }
         }
+        std::sort(ws.layer_pairs.begin(), ws.layer_pairs.end());
 
-        /* Ensure that tuples of all states in layer are marked as not novel! */
-        for (const auto& state : m_curr_states)
+        ++ws.layer_stamp;
+        ws.layer_offsets.clear();
+        ws.layer_novel_positions.clear();
+        for (const auto& [problem_v_idx, novel_pos] : ws.layer_pairs)
         {
-            m_novelty_table.test_novelty_and_update_table(state);
+            if (ws.layer_problem_v_idx_stamps[problem_v_idx] != ws.layer_stamp)
+            {
+                ws.layer_problem_v_idx_stamps[problem_v_idx] = ws.layer_stamp;
+                ws.layer_problem_v_idx_positions[problem_v_idx] = ws.layer_offsets.size();
+                ws.layer_offsets.push_back(ws.layer_novel_positions.size());
+            }
+            ws.layer_novel_positions.push_back(novel_pos);
         }
+        ws.layer_offsets.push_back(ws.layer_novel_positions.size());
+
+        return true;
     }
 
-    void extend_optimal_plans_from_prev_layer()
+    bool extend_optimal_plans_from_prev_layer()
     {
-        // Clear data structures
-        m_cur_extended_novel_t_idxs_set.clear();
-        m_cur_extended_novel_t_idxs_vec.clear();
-        m_cur_extended_novel_t_idx_to_prev_problem_v_idxs.clear();
+        auto& ws = m_workspace;
+        const auto& graph = ws.state_space->get_graph();
+
+        ws.extension_counts.assign(ws.novel_t_idxs.size(), 0);
+        ws.extension_markers.assign(ws.novel_t_idxs.size(), 0);
+        ws.extended_pairs.clear();
+        auto marker = uint64_t(0);
 
         // Part 2 of definition of width: Check whether all optimal plans for tuple t_{i-1}
         // can be extended into an optimal plan for tuple t_i by means of a single action.
-        for (const auto& prev_v_idx : m_prev_v_idxs)
+        for (const auto& prev_v_idx : ws.prev_v_idxs)
         {
-            m_cur_novel_t_idx_to_extended_problem_v_idx.clear();
+            const auto& prev_problem_v_idxs = get_problem_vertices(m_internal_tuple_graph.get_vertex(prev_v_idx));
 
-            // Bookkeeping..
-            for (const auto prev_problem_v_idx : get_problem_vertices(m_internal_tuple_graph.get_vertex(prev_v_idx)))
+            // Count for each novel tuple the number of distinct problem vertices of the previous tuple that reach it.
+            ws.touched_novel_positions.clear();
+            for (const auto prev_problem_v_idx : prev_problem_v_idxs)
             {
+                ++marker;
+
                 // "[...] by means of a single action".
-                for (const auto& curr_problem_v_idx : m_state_space->get_graph().get_adjacent_vertex_indices<graphs::ForwardTag>(prev_problem_v_idx))
+                for (const auto& curr_problem_v_idx : graph.get_adjacent_vertex_indices<graphs::ForwardTag>(prev_problem_v_idx))
                 {
-                    if (m_problem_v_idx_to_novel_t_idxs.contains(curr_problem_v_idx))
+                    if (ws.layer_problem_v_idx_stamps[curr_problem_v_idx] != ws.layer_stamp)
+                    {
+                        continue;
+                    }
+
+                    for (const auto novel_pos : get_range(ws.layer_offsets, ws.layer_novel_positions, ws.layer_problem_v_idx_positions[curr_problem_v_idx]))
                     {
-                        for (const auto target_tuple_index : m_problem_v_idx_to_novel_t_idxs.at(curr_problem_v_idx))
+                        if (ws.extension_markers[novel_pos] == marker)
+                        {
+                            continue;
+                        }
+                        ws.extension_markers[novel_pos] = marker;
+
+                        if (ws.extension_counts[novel_pos]++ == 0)
                         {
-                            m_cur_novel_t_idx_to_extended_problem_v_idx[target_tuple_index].insert(prev_problem_v_idx);
+                            ws.touched_novel_positions.push_back(novel_pos);
                         }
                     }
                 }
@@ -444,127 +686,118 @@ private:
 
             // "Check whether all optimal plans for tuple t_{i-1}
             // can be extended into an optimal plan for tuple t_i [...]""
-            for (const auto& [cur_novel_t_idx, extended_states] : m_cur_novel_t_idx_to_extended_problem_v_idx)
+            for (const auto novel_pos : ws.touched_novel_positions)
             {
-                bool all_optimal_plans_extended = (extended_states.size() == get_problem_vertices(m_internal_tuple_graph.get_vertex(prev_v_idx)).size());
-
-                if (all_optimal_plans_extended)
+                if (ws.extension_counts[novel_pos] == prev_problem_v_idxs.size())
                 {
-                    m_cur_extended_novel_t_idxs_set.insert(cur_novel_t_idx);
-                    m_cur_extended_novel_t_idx_to_prev_problem_v_idxs[cur_novel_t_idx].insert(prev_v_idx);
+                    ws.extended_pairs.emplace_back(novel_pos, prev_v_idx);
                 }
+                ws.extension_counts[novel_pos] = 0;
             }
         }
-        m_cur_extended_novel_t_idxs_vec.insert(m_cur_extended_novel_t_idxs_vec.end(),
-                                               m_cur_extended_novel_t_idxs_set.begin(),
-                                               m_cur_extended_novel_t_idxs_set.end());
+
+        /* Group the previous tuple vertices by extended novel tuple. */
+        std::sort(ws.extended_pairs.begin(), ws.extended_pairs.end());
+
+        ws.extended_positions.clear();
+        ws.extended_offsets.clear();
+        ws.extended_prev_v_idxs.clear();
+        for (const auto& [novel_pos, prev_v_idx] : ws.extended_pairs)
+        {
+            if (ws.extended_positions.empty() || ws.extended_positions.back() != novel_pos)
+            {
+                ws.extended_positions.push_back(novel_pos);
+                ws.extended_offsets.push_back(ws.extended_prev_v_idxs.size());
+            }
+            ws.extended_prev_v_idxs.push_back(prev_v_idx);
+        }
+        ws.extended_offsets.push_back(ws.extended_prev_v_idxs.size());
+
+        return !ws.extended_positions.empty();
     }
 
     bool instantiate_next_layer()
-    {  // Clear data structures
-        m_t_idx_to_dominating_t_idxs.clear();
+    {
+        auto& ws = m_workspace;
+
+        const auto get_extended_problem_v_idxs = [&](size_t i) { return get_range(ws.novel_offsets, ws.novel_problem_v_idxs, ws.extended_positions[i]); };
 
-        if (m_options.enable_dominance_pruning)
+        ws.is_pruned.assign(ws.extended_positions.size(), false);
+
+        if (ws.options.enable_dominance_pruning)
         {
-            for (size_t i = 0; i < m_cur_extended_novel_t_idxs_vec.size(); ++i)
+            for (size_t i = 0; i < ws.extended_positions.size(); ++i)
             {
-                const auto tuple_index_1 = m_cur_extended_novel_t_idxs_vec.at(i);
+                if (ws.is_pruned[i])
+                {
+                    continue;  ///< an earlier tuple with the same problem vertices already pruned the later ones.
+                }
 
-                const auto& problem_v_idxs_1 = m_novel_t_idx_to_problem_v_idxs.at(tuple_index_1);
+                const auto problem_v_idxs_1 = get_extended_problem_v_idxs(i);
 
-                for (size_t j = 0; j < m_cur_extended_novel_t_idxs_vec.size(); ++j)
+                for (size_t j = 0; j < ws.extended_positions.size(); ++j)
                 {
-                    const auto tuple_index_2 = m_cur_extended_novel_t_idxs_vec.at(j);
-
-                    const auto& problem_v_idxs_2 = m_novel_t_idx_to_problem_v_idxs.at(tuple_index_2);
+                    const auto problem_v_idxs_2 = get_extended_problem_v_idxs(j);
 
-                    if (i < j && problem_v_idxs_1 == problem_v_idxs_2)
+                    if (i < j && std::ranges::equal(problem_v_idxs_1, problem_v_idxs_2))
                     {
                         // Keep smallest tuple_index with a specific set of underlying states.
-                        m_cur_extended_novel_t_idxs_set.erase(tuple_index_2);
+                        ws.is_pruned[j] = true;
                         continue;
                     }
 
-                    if (problem_v_idxs_1.size() == problem_v_idxs_2.size())
+                    if (problem_v_idxs_1.size() <= problem_v_idxs_2.size())
                     {
                         continue;  ///< not a strict subset!
                     }
 
-                    const auto is_subset = std::all_of(problem_v_idxs_2.begin(),
-                                                       problem_v_idxs_2.end(),
-                                                       [&problem_v_idxs_1](const auto& element) { return problem_v_idxs_1.count(element); });
-                    if (is_subset)
+                    if (std::includes(problem_v_idxs_1.begin(), problem_v_idxs_1.end(), problem_v_idxs_2.begin(), problem_v_idxs_2.end()))
                     {
                         // tuple_index_1 is dominated by tuple_index_2 because problem_v_idxs_2 < problem_v_idxs_1.
-                        m_t_idx_to_dominating_t_idxs[tuple_index_2].insert(tuple_index_1);
+                        ws.is_pruned[i] = true;
                     }
                 }
             }
-
-            // Keep only tuple indices whose underlying states is a smallest subset.
-            for (const auto& [dominating_tuple_index, dominated_tuple_indices] : m_t_idx_to_dominating_t_idxs)
-            {
-                for (const auto& dominated_tuple_index : dominated_tuple_indices)
-                {
-                    m_cur_extended_novel_t_idxs_set.erase(dominated_tuple_index);
-                }
-            }
         }
 
-        if (m_cur_extended_novel_t_idxs_set.size() == 0)
+        for (size_t i = 0; i < ws.extended_positions.size(); ++i)
         {
-            return false;
-        }
+            if (ws.is_pruned[i])
+            {
+                continue;
+            }
 
-        for (const auto& t_idx : m_cur_extended_novel_t_idxs_set)
-        {
-            const auto& cur_problem_v_idxs = m_novel_t_idx_to_problem_v_idxs.at(t_idx);
+            const auto novel_pos = ws.extended_positions[i];
+            const auto cur_problem_v_idxs = get_extended_problem_v_idxs(i);
 
-            const auto cur_v_idx =
-                m_internal_tuple_graph.add_vertex(m_index_to_tuple.at(t_idx), IndexList(cur_problem_v_idxs.begin(), cur_problem_v_idxs.end()));
+            const auto cur_v_idx = m_internal_tuple_graph.add_vertex(ws.tuples[ws.local_index_to_tuple_index[ws.novel_t_idxs[novel_pos]]],
+                                                                     IndexList(cur_problem_v_idxs.begin(), cur_problem_v_idxs.end()));
 
-            m_curr_v_idxs.push_back(cur_v_idx);
+            ws.curr_v_idxs.push_back(cur_v_idx);
 
-            for (const auto prev_v_idx : m_cur_extended_novel_t_idx_to_prev_problem_v_idxs.at(t_idx))  // .at?
+            for (const auto prev_v_idx : get_range(ws.extended_offsets, ws.extended_prev_v_idxs, i))
             {
                 m_internal_tuple_graph.add_directed_edge(prev_v_idx, cur_v_idx);
             }
         }
 
-        return true;
+        return !ws.curr_v_idxs.empty();
     }
 
 public:
-    TupleGraphArityGreaterZeroComputation(const graphs::ProblemVertex& problem_vertex,
-                                          const StateSpace& state_space,
-                                          std::optional<CertificateMaps>& certificate_maps,
-                                          const TupleGraphImpl::Options& options) :
+    TupleGraphArityGreaterZeroComputation(const graphs::ProblemVertex& problem_vertex, TupleGraphWorkspace& workspace) :
         m_problem_vertex(problem_vertex),
-        m_state_space(state_space),
-        m_certificate_maps(certificate_maps),
-        m_options(options),
+        m_workspace(workspace),
         m_internal_tuple_graph(),
         m_v_idxs_grouped_by_distance(),
-        m_problem_v_idxs_grouped_by_distance(),
-        m_prev_problem_v_idxs(),
-        m_curr_problem_v_idxs(),
-        m_visited_problem_v_idxs(),
-        m_prev_v_idxs(),
-        m_curr_v_idxs(),
-        m_novelty_table(options.width),
-        m_novel_t_idxs_set(),
-        m_novel_t_idx_to_problem_v_idxs(),
-        m_problem_v_idx_to_novel_t_idxs(),
-        m_cur_novel_t_idx_to_extended_problem_v_idx(),
-        m_cur_extended_novel_t_idx_to_prev_problem_v_idxs(),
-        m_cur_extended_novel_t_idxs_set(),
-        m_cur_extended_novel_t_idxs_vec(),
-        m_t_idx_to_dominating_t_idxs()
+        m_problem_v_idxs_grouped_by_distance()
     {
     }
 
     TupleGraph compute_and_get_result()
     {
+        start_root(m_workspace);
+
         compute_distance_zero_vertices();
 
         while (true)
@@ -577,27 +810,18 @@ public:
             }
         }
 
-        return std::make_shared<TupleGraphImpl>(m_state_space,
+        finish_root(m_workspace);
+
+        return std::make_shared<TupleGraphImpl>(m_workspace.state_space,
                                                 graphs::InternalTupleGraph(std::move(m_internal_tuple_graph)),
                                                 m_v_idxs_grouped_by_distance.get_result(),
                                                 m_problem_v_idxs_grouped_by_distance.get_result());
     }
 };
 
-static TupleGraph create_tuple_graph_width_greater_zero(const graphs::ProblemVertex& problem_vertex,
-                                                        const StateSpace& state_space,
-                                                        std::optional<CertificateMaps>& certificate_maps,
-                                                        const TupleGraphImpl::Options& options)
-{
-    return TupleGraphArityGreaterZeroComputation(problem_vertex, state_space, certificate_maps, options).compute_and_get_result();
-}
-
-TupleGraph create_tuple_graph(const graphs::ProblemVertex& problem_vertex,
-                              const StateSpace& state_space,
-                              std::optional<CertificateMaps>& certificate_maps,
-                              const TupleGraphImpl::Options& options)
+TupleGraph create_tuple_graph(const graphs::ProblemVertex& problem_vertex, TupleGraphWorkspace& workspace)
 {
-    return (options.width == 0) ? create_tuple_graph_width_zero(problem_vertex, state_space, certificate_maps) :
-                                  create_tuple_graph_width_greater_zero(problem_vertex, state_space, certificate_maps, options);
+    return (workspace.options.width == 0) ? TupleGraphArityZeroComputation(problem_vertex, workspace).compute_and_get_result() :
+                                            TupleGraphArityGreaterZeroComputation(problem_vertex, workspace).compute_and_get_result();
 }
 }
@@ -18,16 +18,108 @@
 #ifndef MIMIR_SRC_DATASETS_TUPLE_GRAPH_FACTORY_
 #define MIMIR_SRC_DATASETS_TUPLE_GRAPH_FACTORY_
 
+#include "mimir/datasets/object_graph.hpp"
 #include "mimir/datasets/state_space.hpp"
 #include "mimir/datasets/tuple_graph.hpp"
 #include "mimir/formalism/declarations.hpp"
+#include "mimir/graphs/concrete/vertex_colored_graph.hpp"
+#include "mimir/search/algorithms/iw/novelty_table.hpp"
+#include "mimir/search/state.hpp"
+
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
 namespace mimir::datasets
 {
-extern TupleGraph create_tuple_graph(const graphs::ProblemVertex& problem_vertex,
-                                     const StateSpace& state_space,
-                                     std::optional<CertificateMaps>& certificate_maps,
-                                     const TupleGraphImpl::Options& options);
+
+/// @brief `TupleGraphWorkspace` holds the memory of a thread that creates the tuple graphs of several vertices of a `StateSpace`.
+///
+/// The workspace is reused across roots: the novelty table is reset instead of reallocated, the data of a root or layer is invalidated
+/// by incrementing a stamp, and the per-layer mappings are flat sorted arrays. The successors and the representative vertices of states
+/// are memoized because neighboring roots explore mostly the same states. The state space and the certificate maps are only read.
+struct TupleGraphWorkspace
+{
+    TupleGraphWorkspace(const StateSpace& state_space,
+                        const std::optional<CertificateMaps>& certificate_maps,
+                        const TupleGraphImpl::Options& options,
+                        std::mutex& problem_mutex);
+
+    // Uncopieable and unmoveable because the novelty table refers to its own members.
+    TupleGraphWorkspace(const TupleGraphWorkspace& other) = delete;
+    TupleGraphWorkspace& operator=(const TupleGraphWorkspace& other) = delete;
+    TupleGraphWorkspace(TupleGraphWorkspace&& other) = delete;
+    TupleGraphWorkspace& operator=(TupleGraphWorkspace&& other) = delete;
+
+    /// @brief Get the estimated number of bytes of the memoization and the buffers, excluding the novelty table and the object graphs.
+    size_t get_estimated_memory_usage_in_bytes() const;
+
+    const StateSpace& state_space;
+    const std::optional<CertificateMaps>& certificate_maps;
+    const TupleGraphImpl::Options& options;
+    std::mutex& problem_mutex;  ///< Serializes calls that may ground new actions or atoms in the problem.
+
+    std::optional<search::iw::DynamicNoveltyTable> novelty_table;  ///< Only for width > 0.
+    std::optional<ObjectGraphBuilder> object_graph_builder;        ///< Only with symmetry reduction.
+
+    /* Memoization across roots, indexed by state index */
+    IndexList successor_begin;  ///< The successors of a state s are successors[successor_begin[s]] to successors[successor_end[s] - 1].
+    IndexList successor_end;
+    std::vector<std::pair<Index, search::PackedState>> successors;
+    IndexList state_to_problem_v_idx;
+    std::vector<search::iw::AtomIndexList> tuples;  ///< Indexed by global tuple index.
+    IndexList tuple_rank_to_index;                  ///< Maps the rank of a tuple to its global tuple index, for width at most 2 and bounded ranks.
+    std::unordered_map<search::iw::AtomIndexList, Index, loki::Hash<search::iw::AtomIndexList>, loki::EqualTo<search::iw::AtomIndexList>>
+        tuple_to_index;  ///< Maps a tuple to its global tuple index, for width larger than 2 or ranks beyond the bound.
+
+    /* Data of the current root */
+    uint64_t root_stamp;
+    std::vector<uint64_t> tuple_stamps;    ///< Indexed by global tuple index.
+    IndexList tuple_to_local_index;        ///< Indexed by global tuple index.
+    IndexList local_index_to_tuple_index;  ///< Local tuple indices follow the order of discovery.
+    std::vector<uint64_t> visited_problem_v_idx_stamps;
+    std::vector<uint64_t> visited_state_stamps;
+
+    /* Data of the current layer */
+    uint64_t layer_stamp;
+    std::vector<uint64_t> layer_problem_v_idx_stamps;
+    IndexList layer_problem_v_idx_positions;  ///< The position of a problem vertex of the current layer in layer_offsets.
+
+    /* Memory for reuse */
+    IndexList prev_problem_v_idxs;
+    IndexList curr_problem_v_idxs;
+    search::StateList prev_states;
+    search::StateList curr_states;
+    IndexList prev_v_idxs;
+    IndexList curr_v_idxs;
+    std::vector<search::iw::AtomIndexList> novel_tuples;
+    FlatObjectGraph flat_object_graph;
+    graphs::StaticVertexColoredGraph object_graph;
+
+    IndexPairList novel_pairs;        ///< Pairs of local tuple index and problem vertex index of the current layer.
+    IndexList novel_t_idxs;           ///< The sorted local indices of the novel tuples of the current layer.
+    IndexList novel_offsets;          ///< The problem vertices of novel tuple i are novel_problem_v_idxs[novel_offsets[i]] to [novel_offsets[i + 1] - 1].
+    IndexList novel_problem_v_idxs;   ///< Sorted per novel tuple.
+    IndexPairList layer_pairs;        ///< Pairs of problem vertex index of the current layer and novel tuple position.
+    IndexList layer_offsets;          ///< The novel tuple positions of problem vertex i are layer_novel_positions[layer_offsets[i]] to ...
+    IndexList layer_novel_positions;  ///< ... layer_novel_positions[layer_offsets[i + 1] - 1].
+
+    IndexList extension_counts;               ///< Indexed by novel tuple position.
+    std::vector<uint64_t> extension_markers;  ///< Indexed by novel tuple position.
+    IndexList touched_novel_positions;
+    IndexPairList extended_pairs;  ///< Pairs of novel tuple position and tuple vertex index of the previous layer.
+    IndexList extended_positions;  ///< The sorted novel tuple positions that extend all optimal plans of a tuple of the previous layer.
+    IndexList extended_offsets;    ///< The extended vertices of extended tuple i are extended_prev_v_idxs[extended_offsets[i]] to ...
+    IndexList extended_prev_v_idxs;  ///< ... extended_prev_v_idxs[extended_offsets[i + 1] - 1].
+    std::vector<bool> is_pruned;
+};
+
+/// @brief Create the tuple graph of a vertex of the state space of the workspace.
+/// The workspace must only be used by one thread at a time.
+extern TupleGraph create_tuple_graph(const graphs::ProblemVertex& problem_vertex, TupleGraphWorkspace& workspace);
 }
 
-#endif
\ No newline at end of file
+#endif
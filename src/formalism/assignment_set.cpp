@@ -23,9 +23,12 @@
 #include "mimir/formalism/ground_function.hpp"
 #include "mimir/formalism/object.hpp"
 #include "mimir/formalism/predicate.hpp"
+#include "mimir/formalism/repositories.hpp"
 #include "mimir/formalism/term.hpp"
 #include "mimir/formalism/variable.hpp"
 
+#include <bit>
+
 namespace mimir::formalism
 {
 
@@ -34,12 +37,26 @@ namespace mimir::formalism
  */
 
 template<IsStaticOrFluentOrDerivedTag P>
-AssignmentSet<P>::AssignmentSet() : m_num_objects(0), m_per_predicate_assignment_set()
+AssignmentSet<P>::AssignmentSet() :
+    m_num_objects(0),
+    m_per_predicate_offset(),
+    m_per_predicate_size(),
+    m_words(),
+    m_counts(),
+    m_atoms(),
+    m_changed_blocks()
 {
 }
 
 template<IsStaticOrFluentOrDerivedTag P>
-AssignmentSet<P>::AssignmentSet(size_t num_objects, const PredicateList<P>& predicates) : m_num_objects(num_objects), m_per_predicate_assignment_set()
+AssignmentSet<P>::AssignmentSet(size_t num_objects, const PredicateList<P>& predicates) :
+    m_num_objects(num_objects),
+    m_per_predicate_offset(),
+    m_per_predicate_size(),
+    m_words(),
+    m_counts(),
+    m_atoms(),
+    m_changed_blocks()
 {
     /* Allocate */
     auto max_predicate_index = Index(0);
@@ -47,72 +64,165 @@ AssignmentSet<P>::AssignmentSet(size_t num_objects, const PredicateList<P>& pred
     {
         max_predicate_index = std::max(max_predicate_index, predicate->get_index());
     }
-    m_per_predicate_assignment_set.resize(max_predicate_index + 1);
+    m_per_predicate_offset.resize(max_predicate_index + 1, 0);
+    m_per_predicate_size.resize(max_predicate_index + 1, 0);
 
+    auto num_positions = size_t(0);
     for (const auto& predicate : predicates)
     {
-        auto& assignment_set = m_per_predicate_assignment_set.at(predicate->get_index());
-        assignment_set.resize(num_assignments(predicate->get_arity(), m_num_objects));
+        m_per_predicate_offset.at(predicate->get_index()) = num_positions;
+        m_per_predicate_size.at(predicate->get_index()) = num_assignments(predicate->get_arity(), m_num_objects);
+        num_positions += m_per_predicate_size.at(predicate->get_index());
     }
+    m_words.resize((num_positions + 63) / 64);
+    m_counts.resize(num_positions);
 
     /* Initialize */
     reset();
 }
 
 template<IsStaticOrFluentOrDerivedTag P>
-void AssignmentSet<P>::reset()
+template<typename F>
+void AssignmentSet<P>::for_each_position(GroundAtom<P> ground_atom, F&& callback) const
 {
-    for (auto& assignment_set : m_per_predicate_assignment_set)
+    const auto& arity = ground_atom->get_arity();
+    const auto& arguments = ground_atom->get_objects();
+    const auto offset = m_per_predicate_offset.at(ground_atom->get_predicate()->get_index());
+
+    for (size_t first_index = 0; first_index < arity; ++first_index)
     {
-        std::fill(assignment_set.begin(), assignment_set.end(), false);
+        const auto& first_object = arguments[first_index];
+        callback(offset + get_assignment_rank(VertexAssignment(first_index, first_object->get_index()), arity, m_num_objects));
+
+        for (size_t second_index = first_index + 1; second_index < arity; ++second_index)
+        {
+            const auto& second_object = arguments[second_index];
+            callback(offset
+                     + get_assignment_rank(EdgeAssignment(first_index, first_object->get_index(), second_index, second_object->get_index()),
+                                           arity,
+                                           m_num_objects));
+        }
+    }
+}
+
+template<IsStaticOrFluentOrDerivedTag P>
+void AssignmentSet<P>::insert_position(size_t position)
+{
+    if (m_counts[position]++ == 0)
+    {
+        m_words[position / 64] |= (uint64_t(1) << (position % 64));
     }
 }
 
+template<IsStaticOrFluentOrDerivedTag P>
+void AssignmentSet<P>::erase_position(size_t position)
+{
+    assert(m_counts[position] > 0);
+
+    if (--m_counts[position] == 0)
+    {
+        m_words[position / 64] &= ~(uint64_t(1) << (position % 64));
+    }
+}
+
+template<IsStaticOrFluentOrDerivedTag P>
+void AssignmentSet<P>::reset()
+{
+    std::fill(m_words.begin(), m_words.end(), uint64_t(0));
+    std::fill(m_counts.begin(), m_counts.end(), uint32_t(0));
+    m_atoms.unset_all();
+}
+
 template<IsStaticOrFluentOrDerivedTag P>
 void AssignmentSet<P>::insert_ground_atoms(const GroundAtomList<P>& ground_atoms)
 {
     for (const auto& ground_atom : ground_atoms)
     {
-        const auto& arity = ground_atom->get_arity();
-        const auto& predicate = ground_atom->get_predicate();
-        const auto& arguments = ground_atom->get_objects();
-        auto& assignment_set = m_per_predicate_assignment_set.at(predicate->get_index());
+        insert_ground_atom(ground_atom);
+    }
+}
 
-        for (size_t first_index = 0; first_index < arity; ++first_index)
-        {
-            const auto& first_object = arguments[first_index];
-            assignment_set[get_assignment_rank(VertexAssignment(first_index, first_object->get_index()), arity, m_num_objects)] = true;
+template<IsStaticOrFluentOrDerivedTag P>
+void AssignmentSet<P>::insert_ground_atom(GroundAtom<P> ground_atom)
+{
+    if (m_atoms.get(ground_atom->get_index()))
+    {
+        return;
+    }
+    m_atoms.set(ground_atom->get_index());
 
-            for (size_t second_index = first_index + 1; second_index < arity; ++second_index)
-            {
-                const auto& second_object = arguments[second_index];
-                assignment_set[get_assignment_rank(EdgeAssignment(first_index, first_object->get_index(), second_index, second_object->get_index()),
-                                                   arity,
-                                                   m_num_objects)] = true;
-            }
-        }
+    for_each_position(ground_atom, [this](size_t position) { insert_position(position); });
+}
+
+template<IsStaticOrFluentOrDerivedTag P>
+void AssignmentSet<P>::erase_ground_atoms(const GroundAtomList<P>& ground_atoms)
+{
+    for (const auto& ground_atom : ground_atoms)
+    {
+        erase_ground_atom(ground_atom);
     }
 }
 
 template<IsStaticOrFluentOrDerivedTag P>
-void AssignmentSet<P>::insert_ground_atom(GroundAtom<P> ground_atom)
+void AssignmentSet<P>::erase_ground_atom(GroundAtom<P> ground_atom)
 {
-    const auto& arity = ground_atom->get_arity();
-    const auto& predicate = ground_atom->get_predicate();
-    const auto& arguments = ground_atom->get_objects();
-    auto& assignment_set = m_per_predicate_assignment_set.at(predicate->get_index());
+    if (!m_atoms.get(ground_atom->get_index()))
+    {
+        return;
+    }
+    m_atoms.unset(ground_atom->get_index());
 
-    for (size_t first_index = 0; first_index < arity; ++first_index)
+    for_each_position(ground_atom, [this](size_t position) { erase_position(position); });
+}
+
+template<IsStaticOrFluentOrDerivedTag P>
+void AssignmentSet<P>::update_ground_atoms(const FlatBitset& atom_indices, const Repositories& repositories)
+{
+    const auto& blocks = atom_indices.blocks();
+    const auto& current_blocks = m_atoms.blocks();
+    const auto num_blocks = std::max(blocks.size(), current_blocks.size());
+    const auto get_block = [](const auto& bitset_blocks, size_t i) { return (i < bitset_blocks.size()) ? bitset_blocks[i] : uint64_t(0); };
+
+    /* Rebuild if the difference is larger than the target. */
+
+    auto num_changes = size_t(0);
+    for (size_t i = 0; i < num_blocks; ++i)
     {
-        const auto& first_object = arguments[first_index];
-        assignment_set[get_assignment_rank(VertexAssignment(first_index, first_object->get_index()), arity, m_num_objects)] = true;
+        num_changes += std::popcount(get_block(blocks, i) ^ get_block(current_blocks, i));
+    }
 
-        for (size_t second_index = first_index + 1; second_index < arity; ++second_index)
+    if (num_changes > atom_indices.count())
+    {
+        reset();
+        for (const auto atom_index : atom_indices)
         {
-            const auto& second_object = arguments[second_index];
-            assignment_set[get_assignment_rank(EdgeAssignment(first_index, first_object->get_index(), second_index, second_object->get_index()),
-                                               arity,
-                                               m_num_objects)] = true;
+            insert_ground_atom(repositories.get_ground_atom<P>(atom_index));
+        }
+        return;
+    }
+
+    /* Apply the difference. Copy the blocks of the current atoms first because erasing and inserting modifies them. */
+
+    m_changed_blocks.clear();
+    for (size_t i = 0; i < num_blocks; ++i)
+    {
+        const auto block = get_block(blocks, i);
+        const auto current_block = get_block(current_blocks, i);
+        if (block != current_block)
+        {
+            m_changed_blocks.emplace_back(i, current_block & ~block, block & ~current_block);
+        }
+    }
+
+    for (const auto& [i, erased, inserted] : m_changed_blocks)
+    {
+        for (auto bits = erased; bits; bits &= bits - 1)
+        {
+            erase_ground_atom(repositories.get_ground_atom<P>(i * 64 + std::countr_zero(bits)));
+        }
+        for (auto bits = inserted; bits; bits &= bits - 1)
+        {
+            insert_ground_atom(repositories.get_ground_atom<P>(i * 64 + std::countr_zero(bits)));
         }
     }
 }
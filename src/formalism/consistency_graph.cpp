@@ -240,7 +240,6 @@ template<IsStaticOrFluentOrDerivedTag P>
 static bool consistent_literals_helper(const LiteralList<P>& literals, const AssignmentSet<P>& assignment_set, const Vertex& element)
 {
     const auto num_objects = assignment_set.get_num_objects();
-    const auto& per_predicate_assignment_set = assignment_set.get_per_predicate_assignment_set();
 
     for (const auto& literal : literals)
     {
@@ -258,8 +257,8 @@ static bool consistent_literals_helper(const LiteralList<P>& literals, const Ass
             continue;  ///< Can only handly unary negated literals due to overapproximation
         }
 
-        assert(literal->get_atom()->get_predicate()->get_index() < per_predicate_assignment_set.size());
-        const auto& predicate_assignment_set = per_predicate_assignment_set[literal->get_atom()->get_predicate()->get_index()];
+        assert(literal->get_atom()->get_predicate()->get_index() < assignment_set.get_num_predicates());
+        const auto predicate_assignment_set = assignment_set.get_predicate_assignment_set(literal->get_atom()->get_predicate()->get_index());
         const auto& terms = literal->get_atom()->get_terms();
 
         for (const auto& assignment : VertexAssignmentRange(terms, element))
@@ -290,7 +289,6 @@ template<IsStaticOrFluentOrDerivedTag P>
 static bool consistent_literals_helper(const LiteralList<P>& literals, const AssignmentSet<P>& assignment_set, const Edge& element)
 {
     const auto num_objects = assignment_set.get_num_objects();
-    const auto& per_predicate_assignment_set = assignment_set.get_per_predicate_assignment_set();
 
     for (const auto& literal : literals)
     {
@@ -308,8 +306,8 @@ static bool consistent_literals_helper(const LiteralList<P>& literals, const Ass
             continue;  ///< Can only handly binary negated literals due to overapproximation
         }
 
-        assert(literal->get_atom()->get_predicate()->get_index() < per_predicate_assignment_set.size());
-        const auto& predicate_assignment_set = per_predicate_assignment_set[literal->get_atom()->get_predicate()->get_index()];
+        assert(literal->get_atom()->get_predicate()->get_index() < assignment_set.get_num_predicates());
+        const auto predicate_assignment_set = assignment_set.get_predicate_assignment_set(literal->get_atom()->get_predicate()->get_index());
         const auto& terms = literal->get_atom()->get_terms();
 
         /* Iterate edges. */
@@ -22,6 +22,7 @@
 #include "mimir/common/printers.hpp"
 #include "mimir/common/types_cista.hpp"
 #include "mimir/formalism/ground_function_expressions.hpp"
+#include "mimir/formalism/ground_numeric_constraint.hpp"
 #include "mimir/formalism/problem.hpp"
 
 #include <ostream>
@@ -38,8 +39,14 @@ GroundConjunctiveConditionImpl::GroundConjunctiveConditionImpl(
     GroundNumericConstraintList numeric_constraints) :
     m_index(index),
     m_preconditions(preconditions),
-    m_numeric_constraints(std::move(numeric_constraints))
+    m_numeric_constraints(std::move(numeric_constraints)),
+    m_numeric_constraint_bytecode()
 {
+    for (const auto& numeric_constraint : m_numeric_constraints)
+    {
+        m_numeric_constraint_bytecode.append(numeric_constraint->get_bytecode());
+    }
+
     assert((get_compressed_precondition<PositiveTag, StaticTag>()->is_compressed()));
     assert((get_compressed_precondition<PositiveTag, FluentTag>()->is_compressed()));
     assert((get_compressed_precondition<PositiveTag, DerivedTag>()->is_compressed()));
@@ -78,6 +85,8 @@ template const FlatIndexList* GroundConjunctiveConditionImpl::get_compressed_pre
 
 const GroundNumericConstraintList& GroundConjunctiveConditionImpl::get_numeric_constraints() const { return m_numeric_constraints; }
 
+const NumericBytecode& GroundConjunctiveConditionImpl::get_numeric_constraint_bytecode() const { return m_numeric_constraint_bytecode; }
+
 }
 
 namespace mimir
@@ -40,8 +40,10 @@ GroundNumericEffectImpl<F>::GroundNumericEffectImpl(Index index,
     m_index(index),
     m_assign_operator(assign_operator),
     m_function(function),
-    m_function_expression(function_expression)
+    m_function_expression(function_expression),
+    m_bytecode()
 {
+    m_bytecode.append(function_expression);
 }
 
 template<IsFluentOrAuxiliaryTag F>
@@ -68,6 +70,12 @@ GroundFunctionExpression GroundNumericEffectImpl<F>::get_function_expression() c
     return m_function_expression;
 }
 
+template<IsFluentOrAuxiliaryTag F>
+const NumericBytecode& GroundNumericEffectImpl<F>::get_bytecode() const
+{
+    return m_bytecode;
+}
+
 template class GroundNumericEffectImpl<FluentTag>;
 template class GroundNumericEffectImpl<AuxiliaryTag>;
 
@@ -125,7 +133,7 @@ template<IsFluentOrAuxiliaryTag F>
 std::pair<loki::AssignOperatorEnum, ContinuousCost>
 evaluate(GroundNumericEffect<F> effect, const FlatDoubleList& static_numeric_variables, const FlatDoubleList& fluent_numeric_variables)
 {
-    return { effect->get_assign_operator(), evaluate(effect->get_function_expression(), static_numeric_variables, fluent_numeric_variables) };
+    return { effect->get_assign_operator(), effect->get_bytecode().evaluate(static_numeric_variables, fluent_numeric_variables) };
 }
 
 template std::pair<loki::AssignOperatorEnum, ContinuousCost>
@@ -32,8 +32,10 @@ GroundNumericConstraintImpl::GroundNumericConstraintImpl(Index index,
     m_index(index),
     m_binary_comparator(binary_comparator),
     m_left_function_expression(left_function_expression),
-    m_right_function_expression(right_function_expression)
+    m_right_function_expression(right_function_expression),
+    m_bytecode()
 {
+    m_bytecode.append(binary_comparator, left_function_expression, right_function_expression);
 }
 
 Index GroundNumericConstraintImpl::get_index() const { return m_index; }
@@ -44,46 +46,15 @@ GroundFunctionExpression GroundNumericConstraintImpl::get_left_function_expressi
 
 GroundFunctionExpression GroundNumericConstraintImpl::get_right_function_expression() const { return m_right_function_expression; }
 
+const NumericBytecode& GroundNumericConstraintImpl::get_bytecode() const { return m_bytecode; }
+
 /**
  * Utils
  */
 
 bool evaluate(GroundNumericConstraint constraint, const FlatDoubleList& static_numeric_variables, const FlatDoubleList& fluent_numeric_variables)
 {
-    const auto left_value = evaluate(constraint->get_left_function_expression(), static_numeric_variables, fluent_numeric_variables);
-    const auto right_value = evaluate(constraint->get_right_function_expression(), static_numeric_variables, fluent_numeric_variables);
-
-    /* Constraint is not satisfied for NaN values. */
-    if (left_value == UNDEFINED_CONTINUOUS_COST || right_value == UNDEFINED_CONTINUOUS_COST)
-        return false;
-
-    switch (constraint->get_binary_comparator())
-    {
-        case loki::BinaryComparatorEnum::EQUAL:
-        {
-            return left_value == right_value;
-        }
-        case loki::BinaryComparatorEnum::GREATER:
-        {
-            return left_value > right_value;
-        }
-        case loki::BinaryComparatorEnum::GREATER_EQUAL:
-        {
-            return left_value >= right_value;
-        }
-        case loki::BinaryComparatorEnum::LESS:
-        {
-            return left_value < right_value;
-        }
-        case loki::BinaryComparatorEnum::LESS_EQUAL:
-        {
-            return left_value <= right_value;
-        }
-        default:
-        {
-            throw std::logic_error("evaluate(effect, fluent_numeric_variables, auxiliary_numeric_variables): Unexpected loki::BinaryComparatorEnum.");
-        }
-    }
+    return constraint->get_bytecode().holds(static_numeric_variables, fluent_numeric_variables);
 }
 
 /**
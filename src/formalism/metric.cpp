@@ -29,8 +29,10 @@ namespace mimir::formalism
 OptimizationMetricImpl::OptimizationMetricImpl(Index index, loki::OptimizationMetricEnum optimization_metric, GroundFunctionExpression function_expression) :
     m_index(index),
     m_optimization_metric(optimization_metric),
-    m_function_expression(std::move(function_expression))
+    m_function_expression(std::move(function_expression)),
+    m_bytecode()
 {
+    m_bytecode.append(m_function_expression);
 }
 
 Index OptimizationMetricImpl::get_index() const { return m_index; }
@@ -39,6 +41,13 @@ loki::OptimizationMetricEnum OptimizationMetricImpl::get_optimization_metric() c
 
 GroundFunctionExpression OptimizationMetricImpl::get_function_expression() const { return m_function_expression; }
 
+const NumericBytecode& OptimizationMetricImpl::get_bytecode() const { return m_bytecode; }
+
+ContinuousCost evaluate(OptimizationMetric metric, const FlatDoubleList& static_numeric_variables, const FlatDoubleList& fluent_numeric_variables)
+{
+    return metric->get_bytecode().evaluate(static_numeric_variables, fluent_numeric_variables);
+}
+
 std::ostream& operator<<(std::ostream& out, const OptimizationMetricImpl& element)
 {
     write(element, StringFormatter(), out);
@@ -0,0 +1,415 @@
+/*
+ * Copyright (C) 2023 Dominik Drexler and Simon Stahlberg
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#include "mimir/formalism/numeric_bytecode.hpp"
+
+#include "mimir/common/concepts.hpp"
+#include "mimir/formalism/ground_function.hpp"
+#include "mimir/formalism/ground_function_expressions.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <stdexcept>
+
+namespace mimir::formalism
+{
+
+/**
+ * Compilation
+ */
+
+static void
+compile(GroundFunctionExpression fexpr, std::vector<NumericInstruction>& ref_instructions, size_t& ref_stack_size, size_t& ref_max_stack_size);
+
+static void push(NumericInstruction instruction, std::vector<NumericInstruction>& ref_instructions, size_t& ref_stack_size, size_t& ref_max_stack_size)
+{
+    ref_instructions.push_back(instruction);
+    ref_max_stack_size = std::max(ref_max_stack_size, ++ref_stack_size);
+}
+
+static void pop(NumericOpcode opcode, std::vector<NumericInstruction>& ref_instructions, size_t& ref_stack_size)
+{
+    assert(ref_stack_size >= 2);
+    ref_instructions.push_back(NumericInstruction { opcode, 0, 0. });
+    --ref_stack_size;
+}
+
+static NumericOpcode get_opcode(loki::BinaryOperatorEnum binary_operator)
+{
+    switch (binary_operator)
+    {
+        case loki::BinaryOperatorEnum::PLUS:
+        {
+            return NumericOpcode::ADD;
+        }
+        case loki::BinaryOperatorEnum::MINUS:
+        {
+            return NumericOpcode::SUB;
+        }
+        case loki::BinaryOperatorEnum::MUL:
+        {
+            return NumericOpcode::MUL;
+        }
+        case loki::BinaryOperatorEnum::DIV:
+        {
+            return NumericOpcode::DIV;
+        }
+        default:
+        {
+            throw std::logic_error("get_opcode(binary_operator): Unexpected loki::BinaryOperatorEnum.");
+        }
+    }
+}
+
+static NumericOpcode get_opcode(loki::MultiOperatorEnum multi_operator)
+{
+    switch (multi_operator)
+    {
+        case loki::MultiOperatorEnum::PLUS:
+        {
+            return NumericOpcode::ADD;
+        }
+        case loki::MultiOperatorEnum::MUL:
+        {
+            return NumericOpcode::MUL;
+        }
+        default:
+        {
+            throw std::logic_error("get_opcode(multi_operator): Unexpected loki::MultiOperatorEnum.");
+        }
+    }
+}
+
+static NumericOpcode get_opcode(loki::BinaryComparatorEnum binary_comparator)
+{
+    switch (binary_comparator)
+    {
+        case loki::BinaryComparatorEnum::EQUAL:
+        {
+            return NumericOpcode::EQUAL;
+        }
+        case loki::BinaryComparatorEnum::GREATER:
+        {
+            return NumericOpcode::GREATER;
+        }
+        case loki::BinaryComparatorEnum::GREATER_EQUAL:
+        {
+            return NumericOpcode::GREATER_EQUAL;
+        }
+        case loki::BinaryComparatorEnum::LESS:
+        {
+            return NumericOpcode::LESS;
+        }
+        case loki::BinaryComparatorEnum::LESS_EQUAL:
+        {
+            return NumericOpcode::LESS_EQUAL;
+        }
+        default:
+        {
+            throw std::logic_error("get_opcode(binary_comparator): Unexpected loki::BinaryComparatorEnum.");
+        }
+    }
+}
+
+static void
+compile(GroundFunctionExpression fexpr, std::vector<NumericInstruction>& ref_instructions, size_t& ref_stack_size, size_t& ref_max_stack_size)
+{
+    std::visit(
+        [&](auto&& arg)
+        {
+            using T = std::decay_t<decltype(arg)>;
+            if constexpr (std::is_same_v<T, GroundFunctionExpressionNumber>)
+            {
+                push(NumericInstruction { NumericOpcode::PUSH_NUMBER, 0, arg->get_number() }, ref_instructions, ref_stack_size, ref_max_stack_size);
+            }
+            else if constexpr (std::is_same_v<T, GroundFunctionExpressionBinaryOperator>)
+            {
+                compile(arg->get_left_function_expression(), ref_instructions, ref_stack_size, ref_max_stack_size);
+                compile(arg->get_right_function_expression(), ref_instructions, ref_stack_size, ref_max_stack_size);
+                pop(get_opcode(arg->get_binary_operator()), ref_instructions, ref_stack_size);
+            }
+            else if constexpr (std::is_same_v<T, GroundFunctionExpressionMultiOperator>)
+            {
+                // Left fold, as in the recursive evaluation.
+                const auto opcode = get_opcode(arg->get_multi_operator());
+                const auto& fexprs = arg->get_function_expressions();
+                compile(fexprs.front(), ref_instructions, ref_stack_size, ref_max_stack_size);
+                for (auto it = std::next(fexprs.begin()); it != fexprs.end(); ++it)
+                {
+                    compile(*it, ref_instructions, ref_stack_size, ref_max_stack_size);
+                    pop(opcode, ref_instructions, ref_stack_size);
+                }
+            }
+            else if constexpr (std::is_same_v<T, GroundFunctionExpressionMinus>)
+            {
+                compile(arg->get_function_expression(), ref_instructions, ref_stack_size, ref_max_stack_size);
+                ref_instructions.push_back(NumericInstruction { NumericOpcode::NEG, 0, 0. });
+            }
+            else if constexpr (std::is_same_v<T, GroundFunctionExpressionFunction<StaticTag>>)
+            {
+                push(NumericInstruction { NumericOpcode::PUSH_STATIC_FUNCTION, arg->get_function()->get_index(), 0. },
+                     ref_instructions,
+                     ref_stack_size,
+                     ref_max_stack_size);
+            }
+            else if constexpr (std::is_same_v<T, GroundFunctionExpressionFunction<FluentTag>>)
+            {
+                push(NumericInstruction { NumericOpcode::PUSH_FLUENT_FUNCTION, arg->get_function()->get_index(), 0. },
+                     ref_instructions,
+                     ref_stack_size,
+                     ref_max_stack_size);
+            }
+            else if constexpr (std::is_same_v<T, GroundFunctionExpressionFunction<AuxiliaryTag>>)
+            {
+                push(NumericInstruction { NumericOpcode::PUSH_AUXILIARY_FUNCTION, arg->get_function()->get_index(), 0. },
+                     ref_instructions,
+                     ref_stack_size,
+                     ref_max_stack_size);
+            }
+            else
+            {
+                static_assert(dependent_false<T>::value, "compile(fexpr, ...): Missing implementation for GroundFunctionExpression type.");
+            }
+        },
+        fexpr->get_variant());
+}
+
+/**
+ * Interpretation
+ */
+
+static constexpr size_t MAX_INLINE_STACK_SIZE = 32;
+
+static inline bool is_undefined(ContinuousCost left_value, ContinuousCost right_value)
+{
+    return left_value == UNDEFINED_CONTINUOUS_COST || right_value == UNDEFINED_CONTINUOUS_COST;
+}
+
+/// @brief Execute the instructions and call `on_return` with the value of each program.
+/// @return false iff `on_return` returned false, which stops the execution.
+template<typename Callback>
+static bool execute(const std::vector<NumericInstruction>& instructions,
+                    ContinuousCost* stack,
+                    const FlatDoubleList& static_numeric_variables,
+                    const FlatDoubleList& fluent_numeric_variables,
+                    Callback&& on_return)
+{
+    auto top = stack;  ///< One past the topmost value.
+
+    for (const auto& instruction : instructions)
+    {
+        switch (instruction.opcode)
+        {
+            case NumericOpcode::PUSH_NUMBER:
+            {
+                *top++ = instruction.number;
+                break;
+            }
+            case NumericOpcode::PUSH_STATIC_FUNCTION:
+            {
+                *top++ = (instruction.index < static_numeric_variables.size()) ? static_numeric_variables[instruction.index] : UNDEFINED_CONTINUOUS_COST;
+                break;
+            }
+            case NumericOpcode::PUSH_FLUENT_FUNCTION:
+            {
+                *top++ = (instruction.index < fluent_numeric_variables.size()) ? fluent_numeric_variables[instruction.index] : UNDEFINED_CONTINUOUS_COST;
+                break;
+            }
+            case NumericOpcode::PUSH_AUXILIARY_FUNCTION:
+            {
+                throw std::logic_error("evaluate(fexpr, fluent_numeric_variables): Unexpected GroundFunctionExpressionFunction<AuxiliaryTag>. Did you define a "
+                                       "(composite) metric consisting of a single nullary function without defining its value in the initial state?");
+            }
+            case NumericOpcode::ADD:
+            {
+                --top;
+                top[-1] = is_undefined(top[-1], top[0]) ? UNDEFINED_CONTINUOUS_COST : top[-1] + top[0];
+                break;
+            }
+            case NumericOpcode::SUB:
+            {
+                --top;
+                top[-1] = is_undefined(top[-1], top[0]) ? UNDEFINED_CONTINUOUS_COST : top[-1] - top[0];
+                break;
+            }
+            case NumericOpcode::MUL:
+            {
+                --top;
+                top[-1] = is_undefined(top[-1], top[0]) ? UNDEFINED_CONTINUOUS_COST : top[-1] * top[0];
+                break;
+            }
+            case NumericOpcode::DIV:
+            {
+                --top;
+                top[-1] = (is_undefined(top[-1], top[0]) || top[0] == 0.) ? UNDEFINED_CONTINUOUS_COST : top[-1] / top[0];
+                break;
+            }
+            case NumericOpcode::NEG:
+            {
+                top[-1] = (top[-1] == UNDEFINED_CONTINUOUS_COST) ? UNDEFINED_CONTINUOUS_COST : -top[-1];
+                break;
+            }
+            case NumericOpcode::EQUAL:
+            {
+                --top;
+                top[-1] = (!is_undefined(top[-1], top[0]) && top[-1] == top[0]) ? 1. : 0.;
+                break;
+            }
+            case NumericOpcode::GREATER:
+            {
+                --top;
+                top[-1] = (!is_undefined(top[-1], top[0]) && top[-1] > top[0]) ? 1. : 0.;
+                break;
+            }
+            case NumericOpcode::GREATER_EQUAL:
+            {
+                --top;
+                top[-1] = (!is_undefined(top[-1], top[0]) && top[-1] >= top[0]) ? 1. : 0.;
+                break;
+            }
+            case NumericOpcode::LESS:
+            {
+                --top;
+                top[-1] = (!is_undefined(top[-1], top[0]) && top[-1] < top[0]) ? 1. : 0.;
+                break;
+            }
+            case NumericOpcode::LESS_EQUAL:
+            {
+                --top;
+                top[-1] = (!is_undefined(top[-1], top[0]) && top[-1] <= top[0]) ? 1. : 0.;
+                break;
+            }
+            case NumericOpcode::RETURN:
+            {
+                assert(top == stack + 1);
+                top = stack;
+                if (!on_return(stack[0]))
+                {
+                    return false;
+                }
+                break;
+            }
+            default:
+            {
+                throw std::logic_error("execute(instructions, ...): Unexpected NumericOpcode.");
+            }
+        }
+    }
+    assert(top == stack);
+
+    return true;
+}
+
+/// @brief Execute the bytecode on a stack on the call stack if it is small enough, and on a thread local stack otherwise.
+template<typename Callback>
+static bool execute(const NumericBytecode& bytecode,
+                    const FlatDoubleList& static_numeric_variables,
+                    const FlatDoubleList& fluent_numeric_variables,
+                    Callback&& on_return)
+{
+    if (bytecode.get_max_stack_size() <= MAX_INLINE_STACK_SIZE)
+    {
+        std::array<ContinuousCost, MAX_INLINE_STACK_SIZE> stack;  ///< Uninitialized on purpose, every value is pushed before it is read.
+        return execute(bytecode.get_instructions(), stack.data(), static_numeric_variables, fluent_numeric_variables, on_return);
+    }
+
+    static thread_local auto s_stack = std::vector<ContinuousCost> {};
+    s_stack.resize(std::max(s_stack.size(), bytecode.get_max_stack_size()));
+    return execute(bytecode.get_instructions(), s_stack.data(), static_numeric_variables, fluent_numeric_variables, on_return);
+}
+
+/**
+ * NumericBytecode
+ */
+
+NumericBytecode::NumericBytecode() : m_instructions(), m_num_programs(0), m_max_stack_size(0) {}
+
+void NumericBytecode::append(GroundFunctionExpression function_expression)
+{
+    auto stack_size = size_t(0);
+    compile(function_expression, m_instructions, stack_size, m_max_stack_size);
+    assert(stack_size == 1);
+    m_instructions.push_back(NumericInstruction { NumericOpcode::RETURN, 0, 0. });
+    ++m_num_programs;
+}
+
+void NumericBytecode::append(loki::BinaryComparatorEnum binary_comparator,
+                             GroundFunctionExpression left_function_expression,
+                             GroundFunctionExpression right_function_expression)
+{
+    auto stack_size = size_t(0);
+    const auto opcode = get_opcode(binary_comparator);
+    compile(left_function_expression, m_instructions, stack_size, m_max_stack_size);
+    compile(right_function_expression, m_instructions, stack_size, m_max_stack_size);
+    pop(opcode, m_instructions, stack_size);
+    assert(stack_size == 1);
+    m_instructions.push_back(NumericInstruction { NumericOpcode::RETURN, 0, 0. });
+    ++m_num_programs;
+}
+
+void NumericBytecode::append(const NumericBytecode& other)
+{
+    m_instructions.insert(m_instructions.end(), other.m_instructions.begin(), other.m_instructions.end());
+    m_num_programs += other.m_num_programs;
+    m_max_stack_size = std::max(m_max_stack_size, other.m_max_stack_size);
+}
+
+ContinuousCost NumericBytecode::evaluate(const FlatDoubleList& static_numeric_variables, const FlatDoubleList& fluent_numeric_variables) const
+{
+    assert(m_num_programs == 1);
+
+    auto value = UNDEFINED_CONTINUOUS_COST;
+    execute(*this,
+            static_numeric_variables,
+            fluent_numeric_variables,
+            [&](ContinuousCost program_value)
+            {
+                value = program_value;
+                return true;
+            });
+    return value;
+}
+
+void NumericBytecode::evaluate(const FlatDoubleList& static_numeric_variables,
+                               const FlatDoubleList& fluent_numeric_variables,
+                               std::vector<ContinuousCost>& out_values) const
+{
+    out_values.clear();
+    execute(*this,
+            static_numeric_variables,
+            fluent_numeric_variables,
+            [&](ContinuousCost program_value)
+            {
+                out_values.push_back(program_value);
+                return true;
+            });
+}
+
+bool NumericBytecode::holds(const FlatDoubleList& static_numeric_variables, const FlatDoubleList& fluent_numeric_variables) const
+{
+    return execute(*this, static_numeric_variables, fluent_numeric_variables, [](ContinuousCost program_value) { return program_value != 0.; });
+}
+
+const std::vector<NumericInstruction>& NumericBytecode::get_instructions() const { return m_instructions; }
+
+size_t NumericBytecode::get_num_programs() const { return m_num_programs; }
+
+size_t NumericBytecode::get_max_stack_size() const { return m_max_stack_size; }
+
+}
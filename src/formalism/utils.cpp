@@ -17,7 +17,15 @@
 
 #include "mimir/formalism/utils.hpp"
 
+#include "mimir/formalism/atom.hpp"
+#include "mimir/formalism/ground_atom.hpp"
 #include "mimir/formalism/ground_literal.hpp"
+#include "mimir/formalism/literal.hpp"
+#include "mimir/formalism/object.hpp"
+#include "mimir/formalism/term.hpp"
+#include "mimir/formalism/variable.hpp"
+
+#include <algorithm>
 
 namespace mimir::formalism
 {
@@ -78,4 +86,38 @@ GroundAtomList<P> filter_ground_atoms(const GroundLiteralList<P>& literals, bool
 template GroundAtomList<StaticTag> filter_ground_atoms(const GroundLiteralList<StaticTag>& literals, bool polarity);
 template GroundAtomList<FluentTag> filter_ground_atoms(const GroundLiteralList<FluentTag>& literals, bool polarity);
 template GroundAtomList<DerivedTag> filter_ground_atoms(const GroundLiteralList<DerivedTag>& literals, bool polarity);
+template<IsFluentOrDerivedTag P>
+bool unify(Literal<P> literal, GroundAtom<P> ground_atom, IndexList& ref_partial_binding)
+{
+    std::fill(ref_partial_binding.begin(), ref_partial_binding.end(), MAX_INDEX);
+
+    const auto& terms = literal->get_atom()->get_terms();
+    const auto& objects = ground_atom->get_objects();
+    assert(terms.size() == objects.size());
+
+    for (size_t i = 0; i < terms.size(); ++i)
+    {
+        const auto object_index = objects[i]->get_index();
+
+        if (const auto variable = std::get_if<Variable>(&terms[i]->get_variant()))
+        {
+            auto& bound_object_index = ref_partial_binding[(*variable)->get_parameter_index()];
+            if (bound_object_index != MAX_INDEX && bound_object_index != object_index)
+            {
+                return false;
+            }
+            bound_object_index = object_index;
+        }
+        else if (std::get<Object>(terms[i]->get_variant())->get_index() != object_index)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+template bool unify(Literal<FluentTag> literal, GroundAtom<FluentTag> ground_atom, IndexList& ref_partial_binding);
+template bool unify(Literal<DerivedTag> literal, GroundAtom<DerivedTag> ground_atom, IndexList& ref_partial_binding);
+
 }
\ No newline at end of file
@@ -151,7 +151,7 @@ void SparseGraphImpl::canonize()
         return;
     m_is_canonical = true;
 
-    static DEFAULTOPTIONS_SPARSEGRAPH(options);
+    DEFAULTOPTIONS_SPARSEGRAPH(options);
     options.defaultptn = FALSE;
     options.getcanon = TRUE;
     options.digraph = FALSE;
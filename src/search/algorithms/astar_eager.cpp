@@ -17,6 +17,7 @@
 
 #include "mimir/search/algorithms/astar_eager.hpp"
 
+#include "external_memory/search.hpp"
 #include "mimir/common/segmented_vector.hpp"
 #include "mimir/common/timers.hpp"
 #include "mimir/formalism/ground_function_expressions.hpp"
@@ -29,11 +30,12 @@
 #include "mimir/search/axiom_evaluators/interface.hpp"
 #include "mimir/search/heuristics/interface.hpp"
 #include "mimir/search/openlists/interface.hpp"
-#include "mimir/search/openlists/priority_queue.hpp"
+#include "mimir/search/openlists/bucket_queue.hpp"
 #include "mimir/search/plan.hpp"
 #include "mimir/search/search_context.hpp"
 #include "mimir/search/search_node.hpp"
 #include "mimir/search/search_space.hpp"
+#include "mimir/search/state_cache.hpp"
 #include "mimir/search/state_repository.hpp"
 
 using namespace mimir::formalism;
@@ -75,19 +77,34 @@ static SearchNode& get_or_create_search_node(size_t state_index, SearchNodeVecto
 struct QueueEntry
 {
     using KeyType = std::pair<ContinuousCost, SearchNodeStatus>;
-    using ItemType = PackedState;
+    using ItemType = IndexedPackedState;
+    using SecondaryKeyType = SearchNodeStatus;
 
     ContinuousCost f_value;
     PackedState packed_state;
+    Index state_index;
     SearchNodeStatus status;
 
     KeyType get_key() const { return std::make_pair(f_value, status); }
-    ItemType get_item() const { return packed_state; }
+    ContinuousCost get_primary_key() const { return f_value; }
+    SecondaryKeyType get_secondary_key() const { return status; }
+    ItemType get_item() const { return ItemType { state_index, packed_state }; }
 };
 
 static_assert(sizeof(QueueEntry) == 24);
 
-using Queue = PriorityQueue<QueueEntry>;
+using Queue = BucketQueue<QueueEntry>;
+
+/// @brief `RelaxedSuccessor` is a successor state whose g-value was relaxed during the expansion,
+/// which is inserted into the queue after the heuristic values of the new successor states have been computed.
+struct RelaxedSuccessor
+{
+    State state;
+    GroundAction action;
+    ContinuousCost action_cost;
+    ContinuousCost g_value;
+    SearchNodeStatus status;
+};
 
 /**
  * AStar
@@ -97,6 +114,11 @@ SearchResult find_solution(const SearchContext& context, const Heuristic& heuris
 {
     assert(heuristic);
 
+    if (options.external_memory)
+    {
+        return external_memory::find_solution_astar(context, heuristic, options);
+    }
+
     auto& problem = *context->get_problem();
     auto& applicable_action_generator = *context->get_applicable_action_generator();
     auto& state_repository = *context->get_state_repository();
@@ -183,13 +205,20 @@ SearchResult find_solution(const SearchContext& context, const Heuristic& heuris
 
     auto applicable_actions = GroundActionList {};
     auto f_value = start_f_value;
-    openlist.insert(QueueEntry { start_f_value, start_state.get_packed_state(), start_search_node.status });
+    auto state_cache = UnpackedStateCache(options.unpacked_state_cache_size);
+    openlist.insert(QueueEntry { start_f_value, start_state.get_packed_state(), start_state.get_index(), start_search_node.status });
 
     event_handler->on_finish_f_layer(f_value);
 
     auto stopwatch = StopWatch(options.max_time_in_ms);
     stopwatch.start();
 
+    /* Memory for reuse */
+    auto new_successor_states = StateList {};
+    auto new_successor_is_goal_states = std::vector<bool> {};
+    auto new_successor_h_values = ContinuousCostList {};
+    auto relaxed_successors = std::vector<RelaxedSuccessor> {};
+
     while (!openlist.empty())
     {
         if (stopwatch.has_finished())
@@ -198,10 +227,10 @@ SearchResult find_solution(const SearchContext& context, const Heuristic& heuris
             return result;
         }
 
-        const auto state = state_repository.get_state(*openlist.top());
+        const auto indexed_packed_state = openlist.top();
         openlist.pop();
 
-        auto& search_node = get_or_create_search_node(state.get_index(), search_nodes);
+        auto& search_node = get_or_create_search_node(indexed_packed_state.index, search_nodes);
 
         /* Avoid unnecessary extra work by testing whether shortest distance was proven. */
 
@@ -210,6 +239,10 @@ SearchResult find_solution(const SearchContext& context, const Heuristic& heuris
             continue;
         }
 
+        /* Unpack the state only after the test, since closed states are skipped. */
+
+        const auto state = state_cache.extract_or_unpack(indexed_packed_state, state_repository, *event_handler);
+
         /* Report search progress. */
 
         const auto search_node_f_value = search_node.g_value + search_node.h_value;
@@ -256,6 +289,10 @@ SearchResult find_solution(const SearchContext& context, const Heuristic& heuris
 
         search_node.status = SearchNodeStatus::CLOSED;
 
+        new_successor_states.clear();
+        new_successor_is_goal_states.clear();
+        relaxed_successors.clear();
+
         for (const auto& action : applicable_action_generator.create_applicable_action_generator(state))
         {
             const auto [successor_state, successor_state_metric_value] = state_repository.get_or_create_successor_state(state, action, search_node.g_value);
@@ -296,20 +333,14 @@ SearchResult find_solution(const SearchContext& context, const Heuristic& heuris
                 successor_search_node.g_value = successor_state_metric_value;
                 if (is_new_successor_state)
                 {
-                    // Compute heuristic if state is new.
+                    // Defer the heuristic computation to evaluate all new successor states in a single batch.
                     const auto successor_is_goal_state = goal_strategy->test_dynamic_goal(successor_state);
                     if (successor_is_goal_state)
                     {
                         successor_search_node.status = SearchNodeStatus::GOAL;
                     }
-                    const auto successor_h_value = heuristic->compute_heuristic(successor_state, successor_is_goal_state);
-                    successor_search_node.h_value = successor_h_value;
-
-                    if (successor_h_value == INFINITY_CONTINUOUS_COST)
-                    {
-                        successor_search_node.status = SearchNodeStatus::DEAD_END;
-                        continue;
-                    }
+                    new_successor_states.push_back(successor_state);
+                    new_successor_is_goal_states.push_back(successor_is_goal_state);
                 }
 
                 if (successor_search_node.status == SearchNodeStatus::DEAD_END)
@@ -317,16 +348,44 @@ SearchResult find_solution(const SearchContext& context, const Heuristic& heuris
                     continue;
                 }
 
-                event_handler->on_generate_state_relaxed(state, action, action_cost, successor_state);
-
-                const auto successor_f_value = successor_search_node.g_value + successor_search_node.h_value;
-                openlist.insert(QueueEntry { successor_f_value, successor_state.get_packed_state(), successor_search_node.status });
+                relaxed_successors.push_back(
+                    RelaxedSuccessor { successor_state, action, action_cost, successor_search_node.g_value, successor_search_node.status });
             }
             else
             {
                 event_handler->on_generate_state_not_relaxed(state, action, action_cost, successor_state);
             }
         }
+
+        /* Compute heuristic since states are new. */
+
+        heuristic->compute_heuristics(new_successor_states, new_successor_is_goal_states, new_successor_h_values);
+
+        for (size_t i = 0; i < new_successor_states.size(); ++i)
+        {
+            auto& successor_search_node = search_nodes[new_successor_states[i].get_index()];
+            successor_search_node.h_value = new_successor_h_values[i];
+
+            if (new_successor_h_values[i] == INFINITY_CONTINUOUS_COST)
+            {
+                successor_search_node.status = SearchNodeStatus::DEAD_END;
+            }
+        }
+
+        for (const auto& successor : relaxed_successors)
+        {
+            const auto& successor_search_node = search_nodes[successor.state.get_index()];
+            if (successor_search_node.status == SearchNodeStatus::DEAD_END)
+            {
+                continue;
+            }
+
+            event_handler->on_generate_state_relaxed(state, successor.action, successor.action_cost, successor.state);
+
+            const auto successor_f_value = successor.g_value + successor_search_node.h_value;
+            openlist.insert(QueueEntry { successor_f_value, successor.state.get_packed_state(), successor.state.get_index(), successor.status });
+            state_cache.insert(successor.state);
+        }
     }
 
     event_handler->on_end_search(state_repository.get_reached_fluent_ground_atoms_bitset().count(),
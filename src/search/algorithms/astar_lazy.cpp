@@ -31,13 +31,16 @@
 #include "mimir/search/heuristics/interface.hpp"
 #include "mimir/search/openlists/alternating.hpp"
 #include "mimir/search/openlists/interface.hpp"
-#include "mimir/search/openlists/priority_queue.hpp"
+#include "mimir/search/openlists/bucket_queue.hpp"
 #include "mimir/search/plan.hpp"
 #include "mimir/search/search_context.hpp"
 #include "mimir/search/search_node.hpp"
 #include "mimir/search/search_space.hpp"
+#include "mimir/search/state_cache.hpp"
 #include "mimir/search/state_repository.hpp"
 
+#include <variant>
+
 using namespace mimir::formalism;
 
 namespace mimir::search::astar_lazy
@@ -77,18 +80,22 @@ static SearchNode& get_or_create_search_node(size_t state_index, SearchNodeVecto
 struct QueueEntry
 {
     using KeyType = ContinuousCost;
-    using ItemType = PackedState;
+    using ItemType = IndexedPackedState;
+    using SecondaryKeyType = std::monostate;
 
     KeyType f_value;
-    ItemType packed_state;
+    PackedState packed_state;
+    Index state_index;
 
     KeyType get_key() const { return f_value; }
-    ItemType get_item() const { return packed_state; }
+    ContinuousCost get_primary_key() const { return f_value; }
+    SecondaryKeyType get_secondary_key() const { return std::monostate {}; }
+    ItemType get_item() const { return ItemType { state_index, packed_state }; }
 };
 
-static_assert(sizeof(QueueEntry) == 16);
+static_assert(sizeof(QueueEntry) == 24);
 
-using Queue = PriorityQueue<QueueEntry>;
+using Queue = BucketQueue<QueueEntry>;
 
 /**
  * AStar
@@ -187,7 +194,8 @@ SearchResult find_solution(const SearchContext& context, const Heuristic& heuris
 
     auto applicable_actions = GroundActionList {};
     auto f_value = start_f_value;
-    preferred_openlist.insert(QueueEntry { start_f_value, start_state.get_packed_state() });
+    auto state_cache = UnpackedStateCache(options.unpacked_state_cache_size);
+    preferred_openlist.insert(QueueEntry { start_f_value, start_state.get_packed_state(), start_state.get_index() });
 
     event_handler->on_finish_f_layer(f_value);
 
@@ -202,10 +210,10 @@ SearchResult find_solution(const SearchContext& context, const Heuristic& heuris
             return result;
         }
 
-        const auto state = state_repository.get_state(*openlist.top());
+        const auto indexed_packed_state = openlist.top();
         openlist.pop();
 
-        auto& search_node = get_or_create_search_node(state.get_index(), search_nodes);
+        auto& search_node = get_or_create_search_node(indexed_packed_state.index, search_nodes);
 
         /* Avoid unnecessary extra work by testing whether shortest distance was proven. */
 
@@ -214,6 +222,10 @@ SearchResult find_solution(const SearchContext& context, const Heuristic& heuris
             continue;
         }
 
+        /* Unpack the state only after the test, since closed states are skipped. */
+
+        const auto state = state_cache.extract_or_unpack(indexed_packed_state, state_repository, *event_handler);
+
         const auto state_h_value = heuristic->compute_heuristic(state, search_node.status == SearchNodeStatus::GOAL);
         search_node.h_value = state_h_value;
         if (state_h_value == INFINITY_CONTINUOUS_COST)
@@ -329,12 +341,13 @@ SearchResult find_solution(const SearchContext& context, const Heuristic& heuris
 
                 if (is_preferred)
                 {
-                    preferred_openlist.insert(QueueEntry { successor_f_value, successor_state.get_packed_state() });
+                    preferred_openlist.insert(QueueEntry { successor_f_value, successor_state.get_packed_state(), successor_state.get_index() });
                 }
                 else
                 {
-                    standard_openlist.insert(QueueEntry { successor_f_value, successor_state.get_packed_state() });
+                    standard_openlist.insert(QueueEntry { successor_f_value, successor_state.get_packed_state(), successor_state.get_index() });
                 }
+                state_cache.insert(successor_state);
             }
             else
             {
@@ -17,6 +17,7 @@
 
 #include "mimir/search/algorithms/brfs.hpp"
 
+#include "external_memory/search.hpp"
 #include "mimir/common/segmented_vector.hpp"
 #include "mimir/common/timers.hpp"
 #include "mimir/formalism/problem.hpp"
@@ -69,6 +70,11 @@ static SearchNode& get_or_create_search_node(size_t state_index, SearchNodeVecto
 
 SearchResult find_solution(const SearchContext& context, const Options& options)
 {
+    if (options.external_memory)
+    {
+        return external_memory::find_solution_brfs(context, options);
+    }
+
     const auto& problem = *context->get_problem();
     auto& applicable_action_generator = *context->get_applicable_action_generator();
     auto& state_repository = *context->get_state_repository();
@@ -0,0 +1,329 @@
+/*
+ * Copyright (C) 2023 Dominik Drexler and Simon Stahlberg
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "record_file.hpp"
+
+#include <cassert>
+#include <cstring>
+#include <memory>
+#include <queue>
+#include <stdexcept>
+
+namespace mimir::search::external_memory
+{
+
+int compare_keys(std::span<const std::byte> lhs, std::span<const std::byte> rhs)
+{
+    if (lhs.size() != rhs.size())
+    {
+        return (lhs.size() < rhs.size()) ? -1 : 1;
+    }
+    return (lhs.empty()) ? 0 : std::memcmp(lhs.data(), rhs.data(), lhs.size());
+}
+
+/**
+ * RecordWriter
+ */
+
+RecordWriter::RecordWriter(fs::path path, size_t buffer_size) :
+    m_path(std::move(path)),
+    m_file(std::fopen(m_path.c_str(), "wb")),
+    m_buffer(buffer_size),
+    m_offset(0),
+    m_num_records(0)
+{
+    if (!m_file)
+    {
+        throw std::runtime_error("RecordWriter::RecordWriter(...): failed to open " + m_path.string() + " for writing.");
+    }
+    std::setvbuf(m_file, m_buffer.data(), _IOFBF, m_buffer.size());
+}
+
+RecordWriter::~RecordWriter()
+{
+    if (m_file)
+    {
+        std::fclose(m_file);
+    }
+}
+
+uint64_t RecordWriter::write(uint32_t parent_bucket, uint64_t parent_offset, std::span<const std::byte> key)
+{
+    const auto header = RecordHeader { static_cast<uint32_t>(key.size()), parent_bucket, parent_offset };
+    if (std::fwrite(&header, sizeof(RecordHeader), 1, m_file) != 1 || (!key.empty() && std::fwrite(key.data(), key.size(), 1, m_file) != 1))
+    {
+        throw std::runtime_error("RecordWriter::write(...): failed to write to " + m_path.string() + ".");
+    }
+
+    const auto offset = m_offset;
+    m_offset += sizeof(RecordHeader) + key.size();
+    ++m_num_records;
+
+    return offset;
+}
+
+void RecordWriter::close()
+{
+    if (m_file)
+    {
+        const auto status = std::fclose(m_file);
+        m_file = nullptr;
+        if (status != 0)
+        {
+            throw std::runtime_error("RecordWriter::close(): failed to close " + m_path.string() + ".");
+        }
+    }
+}
+
+uint64_t RecordWriter::get_num_records() const { return m_num_records; }
+
+/**
+ * RecordReader
+ */
+
+RecordReader::RecordReader(fs::path path, size_t buffer_size) :
+    m_path(std::move(path)),
+    m_file(std::fopen(m_path.c_str(), "rb")),
+    m_buffer(buffer_size),
+    m_offset(0)
+{
+    if (!m_file)
+    {
+        throw std::runtime_error("RecordReader::RecordReader(...): failed to open " + m_path.string() + " for reading.");
+    }
+    std::setvbuf(m_file, m_buffer.data(), _IOFBF, m_buffer.size());
+}
+
+RecordReader::~RecordReader()
+{
+    if (m_file)
+    {
+        std::fclose(m_file);
+    }
+}
+
+bool RecordReader::next(Record& out_record, uint64_t& out_offset)
+{
+    if (std::fread(&out_record.header, sizeof(RecordHeader), 1, m_file) != 1)
+    {
+        if (std::ferror(m_file))
+        {
+            throw std::runtime_error("RecordReader::next(...): failed to read from " + m_path.string() + ".");
+        }
+        return false;
+    }
+    out_record.key.resize(out_record.header.key_size);
+    if (!out_record.key.empty() && std::fread(out_record.key.data(), out_record.key.size(), 1, m_file) != 1)
+    {
+        throw std::runtime_error("RecordReader::next(...): truncated record in " + m_path.string() + ".");
+    }
+
+    out_offset = m_offset;
+    m_offset += sizeof(RecordHeader) + out_record.key.size();
+
+    return true;
+}
+
+Record read_record(const fs::path& path, uint64_t offset)
+{
+    auto file = std::unique_ptr<std::FILE, decltype(&std::fclose)>(std::fopen(path.c_str(), "rb"), &std::fclose);
+    if (!file || std::fseek(file.get(), static_cast<long>(offset), SEEK_SET) != 0)
+    {
+        throw std::runtime_error("read_record(...): failed to seek to offset " + std::to_string(offset) + " in " + path.string() + ".");
+    }
+
+    auto record = Record {};
+    if (std::fread(&record.header, sizeof(RecordHeader), 1, file.get()) != 1)
+    {
+        throw std::runtime_error("read_record(...): failed to read record in " + path.string() + ".");
+    }
+    record.key.resize(record.header.key_size);
+    if (!record.key.empty() && std::fread(record.key.data(), record.key.size(), 1, file.get()) != 1)
+    {
+        throw std::runtime_error("read_record(...): truncated record in " + path.string() + ".");
+    }
+
+    return record;
+}
+
+/**
+ * RecordBuffer
+ */
+
+std::span<const std::byte> RecordBuffer::get_key(const Entry& entry) const { return { m_data.data() + entry.offset, entry.key_size }; }
+
+void RecordBuffer::push(uint32_t bucket, uint32_t parent_bucket, uint64_t parent_offset, std::span<const std::byte> key)
+{
+    m_entries.push_back(Entry { bucket, static_cast<uint32_t>(key.size()), m_data.size(), parent_bucket, parent_offset });
+    m_data.insert(m_data.end(), key.begin(), key.end());
+}
+
+void RecordBuffer::clear()
+{
+    m_data.clear();
+    m_entries.clear();
+}
+
+bool RecordBuffer::empty() const { return m_entries.empty(); }
+
+size_t RecordBuffer::get_memory_usage() const { return m_data.size() + m_entries.size() * sizeof(Entry); }
+
+/**
+ * Merging
+ */
+
+namespace
+{
+/// @brief A sorted input of a k-way merge.
+struct MergeInput
+{
+    std::unique_ptr<RecordReader> reader;
+    Record record;
+    uint64_t offset;
+    size_t rank;  ///< Position in the list of inputs, to keep the first among equal records.
+
+    bool advance() { return reader->next(record, offset); }
+};
+
+struct MergeInputComparator
+{
+    bool operator()(const MergeInput* lhs, const MergeInput* rhs) const
+    {
+        const auto cmp = compare_keys(lhs->record.key, rhs->record.key);
+        return (cmp != 0) ? (cmp > 0) : (lhs->rank > rhs->rank);
+    }
+};
+
+/// @brief Merge the sorted `runs` and call `callback` on each record whose key differs from the previous one.
+template<typename F>
+void merge_unique(const std::vector<fs::path>& runs, size_t buffer_size, F&& callback)
+{
+    auto inputs = std::vector<MergeInput>(runs.size());
+    auto queue = std::priority_queue<MergeInput*, std::vector<MergeInput*>, MergeInputComparator> {};
+    for (size_t i = 0; i < runs.size(); ++i)
+    {
+        inputs[i].reader = std::make_unique<RecordReader>(runs[i], buffer_size);
+        inputs[i].rank = i;
+        if (inputs[i].advance())
+        {
+            queue.push(&inputs[i]);
+        }
+    }
+
+    auto last_key = std::vector<std::byte> {};
+    auto has_last_key = false;
+    while (!queue.empty())
+    {
+        auto input = queue.top();
+        queue.pop();
+
+        if (!has_last_key || compare_keys(last_key, input->record.key) != 0)
+        {
+            callback(input->record);
+            last_key = input->record.key;
+            has_last_key = true;
+        }
+
+        if (input->advance())
+        {
+            queue.push(input);
+        }
+    }
+}
+}
+
+uint64_t merge_and_subtract(std::vector<fs::path> runs,
+                            const fs::path& closed,
+                            const fs::path& out_unique,
+                            const fs::path& out_closed,
+                            size_t max_fan_in,
+                            size_t buffer_size)
+{
+    assert(max_fan_in >= 2);
+
+    /* Reduce the number of runs with intermediate passes to respect the fan-in. */
+
+    auto num_passes = size_t(0);
+    while (runs.size() > max_fan_in)
+    {
+        auto merged_runs = std::vector<fs::path> {};
+        for (size_t first = 0; first < runs.size(); first += max_fan_in)
+        {
+            const auto last = std::min(first + max_fan_in, runs.size());
+            const auto group = std::vector<fs::path>(runs.begin() + first, runs.begin() + last);
+            auto merged_path = out_unique;
+            merged_path += ".pass" + std::to_string(num_passes) + "-" + std::to_string(merged_runs.size());
+
+            auto writer = RecordWriter(merged_path, buffer_size);
+            merge_unique(group, buffer_size, [&](const Record& record) { writer.write(record.header.parent_bucket, record.header.parent_offset, record.key); });
+            writer.close();
+
+            for (const auto& run : group)
+            {
+                fs::remove(run);
+            }
+            merged_runs.push_back(std::move(merged_path));
+        }
+        runs = std::move(merged_runs);
+        ++num_passes;
+    }
+
+    /* Merge the runs and subtract the closed states in a single pass over the closed file. */
+
+    auto unique_writer = RecordWriter(out_unique, buffer_size);
+    auto closed_writer = RecordWriter(out_closed, buffer_size);
+    auto closed_reader = std::unique_ptr<RecordReader>(fs::exists(closed) ? std::make_unique<RecordReader>(closed, buffer_size) : nullptr);
+    auto closed_record = Record {};
+    auto closed_offset = uint64_t(0);
+    auto has_closed_record = closed_reader && closed_reader->next(closed_record, closed_offset);
+
+    merge_unique(runs,
+                 buffer_size,
+                 [&](const Record& record)
+                 {
+                     auto cmp = -1;
+                     while (has_closed_record && (cmp = compare_keys(closed_record.key, record.key)) < 0)
+                     {
+                         closed_writer.write(closed_record.header.parent_bucket, closed_record.header.parent_offset, closed_record.key);
+                         has_closed_record = closed_reader->next(closed_record, closed_offset);
+                     }
+                     if (has_closed_record && cmp == 0)
+                     {
+                         return;  ///< Duplicate of a closed state.
+                     }
+                     unique_writer.write(record.header.parent_bucket, record.header.parent_offset, record.key);
+                     closed_writer.write(record.header.parent_bucket, record.header.parent_offset, record.key);
+                 });
+
+    while (has_closed_record)
+    {
+        closed_writer.write(closed_record.header.parent_bucket, closed_record.header.parent_offset, closed_record.key);
+        has_closed_record = closed_reader->next(closed_record, closed_offset);
+    }
+
+    unique_writer.close();
+    closed_writer.close();
+
+    for (const auto& run : runs)
+    {
+        fs::remove(run);
+    }
+
+    return unique_writer.get_num_records();
+}
+
+}
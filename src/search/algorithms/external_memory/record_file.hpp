@@ -0,0 +1,199 @@
+/*
+ * Copyright (C) 2023 Dominik Drexler and Simon Stahlberg
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef MIMIR_SRC_SEARCH_ALGORITHMS_EXTERNAL_MEMORY_RECORD_FILE_HPP_
+#define MIMIR_SRC_SEARCH_ALGORITHMS_EXTERNAL_MEMORY_RECORD_FILE_HPP_
+
+#include "mimir/common/filesystem.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <limits>
+#include <span>
+#include <vector>
+
+namespace mimir::search::external_memory
+{
+
+static constexpr uint32_t NO_BUCKET = std::numeric_limits<uint32_t>::max();
+
+/// @brief The fixed size header of a record, followed by `key_size` bytes that encode a state.
+struct RecordHeader
+{
+    uint32_t key_size;
+    uint32_t parent_bucket;   ///< The bucket of the parent state, or `NO_BUCKET` for the start state.
+    uint64_t parent_offset;   ///< The byte offset of the parent record in the file of the parent bucket.
+};
+
+static_assert(sizeof(RecordHeader) == 16);
+
+struct Record
+{
+    RecordHeader header;
+    std::vector<std::byte> key;
+};
+
+/// @brief Compare two keys by size and then bytewise. This is a total order, not the numeric order of the encoded state.
+extern int compare_keys(std::span<const std::byte> lhs, std::span<const std::byte> rhs);
+
+/// @brief `RecordWriter` appends records to a file through a large stream buffer.
+class RecordWriter
+{
+private:
+    fs::path m_path;
+    std::FILE* m_file;
+    std::vector<char> m_buffer;
+    uint64_t m_offset;
+    uint64_t m_num_records;
+
+public:
+    RecordWriter(fs::path path, size_t buffer_size);
+    ~RecordWriter();
+    RecordWriter(const RecordWriter& other) = delete;
+    RecordWriter& operator=(const RecordWriter& other) = delete;
+
+    /// @brief Append a record.
+    /// @return the byte offset of the record in the file.
+    uint64_t write(uint32_t parent_bucket, uint64_t parent_offset, std::span<const std::byte> key);
+
+    /// @brief Flush and close the file. Throws on I/O errors.
+    void close();
+
+    uint64_t get_num_records() const;
+};
+
+/// @brief `RecordReader` reads the records of a file sequentially through a large stream buffer.
+class RecordReader
+{
+private:
+    fs::path m_path;
+    std::FILE* m_file;
+    std::vector<char> m_buffer;
+    uint64_t m_offset;
+
+public:
+    RecordReader(fs::path path, size_t buffer_size);
+    ~RecordReader();
+    RecordReader(const RecordReader& other) = delete;
+    RecordReader& operator=(const RecordReader& other) = delete;
+
+    /// @brief Read the next record.
+    /// @param out_record is the record.
+    /// @param out_offset is the byte offset of the record in the file.
+    /// @return false if the end of the file is reached.
+    bool next(Record& out_record, uint64_t& out_offset);
+};
+
+/// @brief Read the single record that starts at the given byte `offset`.
+extern Record read_record(const fs::path& path, uint64_t offset);
+
+/// @brief `RecordBuffer` collects records for several buckets in memory until they are spilled to disk.
+class RecordBuffer
+{
+private:
+    struct Entry
+    {
+        uint32_t bucket;
+        uint32_t key_size;
+        uint64_t offset;  ///< Of the key in `m_data`.
+        uint32_t parent_bucket;
+        uint64_t parent_offset;
+    };
+
+    std::vector<std::byte> m_data;
+    std::vector<Entry> m_entries;
+
+    std::span<const std::byte> get_key(const Entry& entry) const;
+
+public:
+    void push(uint32_t bucket, uint32_t parent_bucket, uint64_t parent_offset, std::span<const std::byte> key);
+
+    /// @brief Sort the records by bucket and key, and write each bucket's records without duplicates into a new run file.
+    /// @param get_run_path returns the path of a new run file for a given bucket.
+    /// @param buffer_size is the stream buffer size.
+    /// @return the pairs of bucket and run file.
+    template<typename F>
+    std::vector<std::pair<uint32_t, fs::path>> spill(F&& get_run_path, size_t buffer_size);
+
+    void clear();
+
+    bool empty() const;
+
+    /// @brief Return the number of bytes occupied by the buffered records.
+    size_t get_memory_usage() const;
+};
+
+/// @brief Merge the sorted `runs` of a bucket into its file of unique states that are not contained in the `closed` file,
+/// and write the union of both into a new `out_closed` file.
+/// Among records with equal keys, the first one in the order of the runs is kept.
+/// If there are more than `max_fan_in` runs, then they are merged in several passes.
+/// @return the number of records in `out_unique`.
+extern uint64_t merge_and_subtract(std::vector<fs::path> runs,
+                                   const fs::path& closed,
+                                   const fs::path& out_unique,
+                                   const fs::path& out_closed,
+                                   size_t max_fan_in,
+                                   size_t buffer_size);
+
+/**
+ * Implementations
+ */
+
+template<typename F>
+std::vector<std::pair<uint32_t, fs::path>> RecordBuffer::spill(F&& get_run_path, size_t buffer_size)
+{
+    std::sort(m_entries.begin(),
+              m_entries.end(),
+              [this](const Entry& lhs, const Entry& rhs)
+              {
+                  if (lhs.bucket != rhs.bucket)
+                      return lhs.bucket < rhs.bucket;
+                  const auto cmp = compare_keys(get_key(lhs), get_key(rhs));
+                  // Stable with respect to insertion order among duplicates.
+                  return (cmp != 0) ? (cmp < 0) : (lhs.offset < rhs.offset);
+              });
+
+    auto runs = std::vector<std::pair<uint32_t, fs::path>> {};
+    auto it = m_entries.begin();
+    while (it != m_entries.end())
+    {
+        const auto bucket = it->bucket;
+        auto path = get_run_path(bucket);
+        auto writer = RecordWriter(path, buffer_size);
+        const Entry* last = nullptr;
+        for (; it != m_entries.end() && it->bucket == bucket; ++it)
+        {
+            if (!last || compare_keys(get_key(*last), get_key(*it)) != 0)
+            {
+                writer.write(it->parent_bucket, it->parent_offset, get_key(*it));
+            }
+            last = &*it;
+        }
+        writer.close();
+        runs.emplace_back(bucket, std::move(path));
+    }
+
+    clear();
+
+    return runs;
+}
+
+}
+
+#endif
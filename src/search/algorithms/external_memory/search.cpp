@@ -0,0 +1,513 @@
+/*
+ * Copyright (C) 2023 Dominik Drexler and Simon Stahlberg
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "search.hpp"
+
+#include "mimir/common/timers.hpp"
+#include "mimir/formalism/problem.hpp"
+#include "mimir/search/algorithms/astar_eager/event_handlers.hpp"
+#include "mimir/search/algorithms/brfs/event_handlers.hpp"
+#include "mimir/search/algorithms/strategies/goal_strategy.hpp"
+#include "mimir/search/algorithms/strategies/pruning_strategy.hpp"
+#include "mimir/search/applicable_action_generators/interface.hpp"
+#include "mimir/search/axiom_evaluators/interface.hpp"
+#include "mimir/search/heuristics/interface.hpp"
+#include "mimir/search/plan.hpp"
+#include "mimir/search/search_context.hpp"
+#include "mimir/search/state_repository.hpp"
+#include "record_file.hpp"
+
+#include <array>
+#include <cassert>
+#include <bit>
+#include <map>
+#include <random>
+#include <type_traits>
+
+using namespace mimir::formalism;
+
+namespace mimir::search::external_memory
+{
+
+namespace
+{
+
+/**
+ * State keys
+ */
+
+/// @brief The bytes of a packed state are a compact key because packed states are canonical across the repositories of a problem.
+using StateKey = std::array<std::byte, sizeof(PackedStateImpl)>;
+
+static_assert(std::is_trivially_copyable_v<PackedStateImpl>);
+
+StateKey to_key(const PackedStateImpl& state) { return std::bit_cast<StateKey>(state); }
+
+PackedStateImpl from_key(std::span<const std::byte> key)
+{
+    assert(key.size() == sizeof(PackedStateImpl));
+
+    auto bytes = StateKey {};
+    std::copy(key.begin(), key.end(), bytes.begin());
+    return std::bit_cast<PackedStateImpl>(bytes);
+}
+
+/**
+ * Working directory
+ */
+
+/// @brief `WorkingDirectory` creates a fresh directory for the files of a search and removes it on destruction.
+class WorkingDirectory
+{
+private:
+    fs::path m_path;
+
+public:
+    explicit WorkingDirectory(const fs::path& parent)
+    {
+        auto rng = std::random_device {};
+        do
+        {
+            m_path = parent / ("mimir-external-memory-" + std::to_string(rng()));
+        } while (!fs::create_directories(m_path));
+    }
+
+    ~WorkingDirectory()
+    {
+        auto error_code = std::error_code {};
+        fs::remove_all(m_path, error_code);
+    }
+
+    WorkingDirectory(const WorkingDirectory& other) = delete;
+    WorkingDirectory& operator=(const WorkingDirectory& other) = delete;
+
+    const fs::path& get_path() const { return m_path; }
+};
+
+/**
+ * Buckets
+ */
+
+struct BucketKey
+{
+    ContinuousCost f_value;
+    ContinuousCost g_value;
+
+    /// @brief Order by increasing f-value and then by decreasing g-value.
+    friend bool operator<(const BucketKey& lhs, const BucketKey& rhs)
+    {
+        return (lhs.f_value != rhs.f_value) ? (lhs.f_value < rhs.f_value) : (lhs.g_value > rhs.g_value);
+    }
+};
+
+/// @brief A `Bucket` holds the states with equal g- and h-value as sorted runs until it is expanded.
+/// Before its expansion, the runs are merged into a single file of unique states that is kept for the plan extraction.
+struct Bucket
+{
+    ContinuousCost g_value;
+    std::vector<fs::path> runs;
+    fs::path file;
+};
+
+/**
+ * Memory budget
+ */
+
+struct MemoryBudget
+{
+    size_t max_buffer_usage;        ///< Bytes of buffered records before they are spilled.
+    size_t io_buffer_size;          ///< Bytes of the stream buffer of each open file.
+    size_t max_fan_in;              ///< Number of files that are merged at once.
+    size_t max_num_scratch_states;  ///< Number of states unpacked in memory before the scratch repository is recycled.
+};
+
+MemoryBudget compute_memory_budget(size_t memory_limit_in_bytes)
+{
+    // Half of the budget is for buffered records, a quarter for the stream buffers of a merge, and a quarter for unpacked states.
+    static constexpr size_t estimated_bytes_per_state = 256;
+
+    const auto io_buffer_size = std::clamp(memory_limit_in_bytes / 64, size_t(1) << 16, size_t(1) << 22);
+    return MemoryBudget { memory_limit_in_bytes / 2,
+                          io_buffer_size,
+                          std::max(size_t(2), (memory_limit_in_bytes / 4) / io_buffer_size),
+                          std::max(size_t(1), (memory_limit_in_bytes / 4) / estimated_bytes_per_state) };
+}
+
+/**
+ * Plan extraction
+ */
+
+/// @brief Collect the packed states along the parent pointers on disk and replay them in the repository of the `context`.
+Plan extract_plan(const SearchContext& context, const std::vector<Bucket>& buckets, uint32_t bucket, uint64_t offset, ContinuousCost start_g_value)
+{
+    auto trajectory = std::vector<PackedStateImpl> {};
+    while (bucket != NO_BUCKET)
+    {
+        const auto record = read_record(buckets[bucket].file, offset);
+        trajectory.push_back(from_key(record.key));
+        bucket = record.header.parent_bucket;
+        offset = record.header.parent_offset;
+    }
+    std::reverse(trajectory.begin(), trajectory.end());
+
+    auto& state_repository = *context->get_state_repository();
+    auto& applicable_action_generator = *context->get_applicable_action_generator();
+
+    auto state = state_repository.import_state(trajectory.front());
+    auto state_metric_value = start_g_value;
+    auto states = StateList { state };
+    auto actions = GroundActionList {};
+
+    for (size_t i = 1; i < trajectory.size(); ++i)
+    {
+        // We have to take the (state,action) pair that yields lowest metric value.
+        auto lowest_action = GroundAction { nullptr };
+        auto lowest_state = std::optional<State> { std::nullopt };
+        auto lowest_metric_value = std::numeric_limits<ContinuousCost>::infinity();
+
+        for (const auto& action : applicable_action_generator.create_applicable_action_generator(state))
+        {
+            const auto [successor_state, successor_state_metric_value] = state_repository.get_or_create_successor_state(state, action, state_metric_value);
+
+            if (loki::EqualTo<PackedStateImpl> {}(*successor_state.get_packed_state(), trajectory[i]) && successor_state_metric_value < lowest_metric_value)
+            {
+                lowest_action = action;
+                lowest_state = successor_state;
+                lowest_metric_value = successor_state_metric_value;
+            }
+        }
+        assert(lowest_state && lowest_action);
+        actions.push_back(lowest_action);
+        states.push_back(lowest_state.value());
+        state = lowest_state.value();
+        state_metric_value = lowest_metric_value;
+    }
+
+    return Plan(context, std::move(states), std::move(actions), state_metric_value);
+}
+
+brfs::EventHandler get_event_handler(const brfs::Options& options, const Problem& problem)
+{
+    return (options.event_handler) ? options.event_handler : brfs::DefaultEventHandlerImpl::create(problem);
+}
+
+astar_eager::EventHandler get_event_handler(const astar_eager::Options& options, const Problem& problem)
+{
+    return (options.event_handler) ? options.event_handler : astar_eager::DefaultEventHandlerImpl::create(problem);
+}
+
+/**
+ * Search
+ */
+
+/// @brief Bucket-based search with delayed duplicate detection.
+/// BrFS uses the depth as g-value and no heuristic; AStar uses the metric value as g-value and the given heuristic.
+template<typename Options>
+SearchResult find_solution_impl(const SearchContext& context, const Heuristic& heuristic, const Options& options)
+{
+    static constexpr bool is_astar = std::is_same_v<Options, astar_eager::Options>;
+
+    assert(options.external_memory);
+    assert(!is_astar || heuristic);
+
+    auto& problem = *context->get_problem();
+    auto& applicable_action_generator = *context->get_applicable_action_generator();
+    auto& state_repository = *context->get_state_repository();
+
+    const auto [start_state, start_g_value] = (options.start_state) ?
+                                                  std::make_pair(options.start_state.value(), compute_state_metric_value(options.start_state.value())) :
+                                                  state_repository.get_or_create_initial_state();
+    const auto event_handler = get_event_handler(options, context->get_problem());
+    const auto goal_strategy = (options.goal_strategy) ? options.goal_strategy : ProblemGoalStrategyImpl::create(context->get_problem());
+
+    if (options.pruning_strategy && !std::dynamic_pointer_cast<NoPruningStrategyImpl>(options.pruning_strategy)
+        && !std::dynamic_pointer_cast<DuplicatePruningStrategyImpl>(options.pruning_strategy))
+    {
+        throw std::runtime_error("external_memory::find_solution(...): only duplicate pruning is supported in external memory mode.");
+    }
+
+    const auto stop_if_goal = [&]
+    {
+        if constexpr (is_astar)
+            return true;
+        else
+            return options.stop_if_goal;
+    }();
+
+    const auto& ground_action_repository = boost::hana::at_key(problem.get_repositories().get_hana_repositories(), boost::hana::type<GroundActionImpl> {});
+    const auto& ground_axiom_repository = boost::hana::at_key(problem.get_repositories().get_hana_repositories(), boost::hana::type<GroundAxiomImpl> {});
+
+    auto result = SearchResult();
+
+    /* Test static goal. */
+
+    if (!goal_strategy->test_static_goal())
+    {
+        event_handler->on_unsolvable();
+
+        result.status = SearchStatus::UNSOLVABLE;
+        return result;
+    }
+
+    if (start_g_value == UNDEFINED_CONTINUOUS_COST)
+    {
+        throw std::runtime_error("external_memory::find_solution(...): evaluating the metric on the start state yielded NaN.");
+    }
+
+    auto start_bucket_g_value = ContinuousCost(0);
+    auto start_h_value = ContinuousCost(0);
+    if constexpr (is_astar)
+    {
+        start_bucket_g_value = start_g_value;
+        start_h_value = heuristic->compute_heuristic(start_state, goal_strategy->test_dynamic_goal(start_state));
+        event_handler->on_start_search(start_state, start_g_value, start_g_value + start_h_value);
+
+        if (start_h_value == INFINITY_CONTINUOUS_COST)
+        {
+            event_handler->on_unsolvable();
+
+            result.status = SearchStatus::UNSOLVABLE;
+            return result;
+        }
+    }
+    else
+    {
+        event_handler->on_start_search(start_state);
+    }
+
+    /* Set up the files and the memory budget. */
+
+    const auto& external_memory = options.external_memory.value();
+    const auto budget = compute_memory_budget(external_memory.memory_limit_in_bytes);
+    const auto working_directory = WorkingDirectory(external_memory.directory);
+    const auto& path = working_directory.get_path();
+
+    auto buckets = std::vector<Bucket> {};
+    auto open_buckets = std::map<BucketKey, uint32_t> {};
+    auto buffer = RecordBuffer {};
+
+    const auto get_or_create_bucket = [&](ContinuousCost g_value, ContinuousCost h_value)
+    {
+        const auto emplaced = open_buckets.emplace(BucketKey { g_value + h_value, g_value }, static_cast<uint32_t>(buckets.size()));
+        if (emplaced.second)
+        {
+            buckets.push_back(Bucket { g_value, {}, {} });
+        }
+        return emplaced.first->second;
+    };
+
+    const auto spill = [&]
+    {
+        const auto get_run_path = [&](uint32_t bucket)
+        { return path / ("bucket-" + std::to_string(bucket) + ".run-" + std::to_string(buckets[bucket].runs.size())); };
+
+        for (auto& [bucket, run] : buffer.spill(get_run_path, budget.io_buffer_size))
+        {
+            buckets[bucket].runs.push_back(std::move(run));
+        }
+    };
+
+    /* States are unpacked in a scratch repository that is recycled to bound the memory of unpacked states. */
+
+    auto scratch_repository = StateRepositoryImpl::create(state_repository.get_axiom_evaluator());
+    auto reached_fluent_atoms = state_repository.get_reached_fluent_ground_atoms_bitset();
+    auto reached_derived_atoms = state_repository.get_reached_derived_ground_atoms_bitset();
+
+    const auto recycle_scratch_repository = [&]
+    {
+        reached_fluent_atoms |= scratch_repository->get_reached_fluent_ground_atoms_bitset();
+        reached_derived_atoms |= scratch_repository->get_reached_derived_ground_atoms_bitset();
+        scratch_repository = StateRepositoryImpl::create(state_repository.get_axiom_evaluator());
+    };
+
+    auto num_states = uint64_t(0);
+
+    const auto end_search = [&]
+    {
+        recycle_scratch_repository();
+        event_handler->on_end_search(reached_fluent_atoms.count(),
+                                     reached_derived_atoms.count(),
+                                     num_states,
+                                     num_states,
+                                     ground_action_repository.size(),
+                                     ground_axiom_repository.size());
+        applicable_action_generator.on_end_search();
+        state_repository.get_axiom_evaluator()->on_end_search();
+    };
+
+    buffer.push(get_or_create_bucket(start_bucket_g_value, start_h_value), NO_BUCKET, 0, to_key(*start_state.get_packed_state()));
+    spill();
+
+    auto layer_value = start_bucket_g_value + start_h_value;
+    if constexpr (is_astar)
+        event_handler->on_finish_f_layer(layer_value);
+    else
+        event_handler->on_finish_g_layer(DiscreteCost(layer_value));
+
+    auto closed_file = path / "closed-0";
+    auto num_closed_files = size_t(0);
+
+    auto stopwatch = StopWatch(options.max_time_in_ms);
+    stopwatch.start();
+
+    while (!open_buckets.empty())
+    {
+        const auto node = open_buckets.extract(open_buckets.begin());
+        const auto bucket = node.mapped();
+        const auto g_value = buckets[bucket].g_value;
+
+        /* Report search progress. */
+
+        const auto bucket_layer_value = (is_astar) ? node.key().f_value : g_value;
+        if (bucket_layer_value > layer_value)
+        {
+            applicable_action_generator.on_finish_search_layer();
+            state_repository.get_axiom_evaluator()->on_finish_search_layer();
+            if constexpr (is_astar)
+                event_handler->on_finish_f_layer(layer_value);
+            else
+                event_handler->on_finish_g_layer(DiscreteCost(layer_value));
+            layer_value = bucket_layer_value;
+        }
+
+        /* Remove the duplicates within the bucket and the states of previously expanded buckets. */
+
+        auto next_closed_file = path / ("closed-" + std::to_string(++num_closed_files));
+        buckets[bucket].file = path / ("bucket-" + std::to_string(bucket) + ".states");
+        num_states += merge_and_subtract(std::move(buckets[bucket].runs),
+                                         closed_file,
+                                         buckets[bucket].file,
+                                         next_closed_file,
+                                         budget.max_fan_in,
+                                         budget.io_buffer_size);
+        buckets[bucket].runs.clear();
+        fs::remove(closed_file);
+        closed_file = std::move(next_closed_file);
+
+        if (num_states >= options.max_num_states)
+        {
+            end_search();
+
+            result.status = SearchStatus::OUT_OF_STATES;
+            return result;
+        }
+
+        /* Expand the states of the bucket. */
+
+        auto reader = RecordReader(buckets[bucket].file, budget.io_buffer_size);
+        auto record = Record {};
+        auto offset = uint64_t(0);
+
+        while (reader.next(record, offset))
+        {
+            if (stopwatch.has_finished())
+            {
+                end_search();
+
+                result.status = SearchStatus::OUT_OF_TIME;
+                return result;
+            }
+
+            if (scratch_repository->get_state_count() >= budget.max_num_scratch_states)
+            {
+                recycle_scratch_repository();
+            }
+
+            const auto state = scratch_repository->import_state(from_key(record.key));
+
+            /* Test whether state achieves the dynamic goal. */
+
+            if (goal_strategy->test_dynamic_goal(state))
+            {
+                event_handler->on_expand_goal_state(state);
+
+                if (stop_if_goal)
+                {
+                    end_search();
+
+                    result.plan = extract_plan(context, buckets, bucket, offset, start_g_value);
+                    result.goal_state = result.plan->get_states().back();
+                    result.status = SearchStatus::SOLVED;
+
+                    event_handler->on_solved(result.plan.value());
+
+                    return result;
+                }
+            }
+
+            /* Expand the successors of the state. */
+
+            event_handler->on_expand_state(state);
+
+            // BrFS uses the depth as g-value, which is not the metric value of the state.
+            const auto state_metric_value = (is_astar) ? g_value : compute_state_metric_value(state);
+
+            for (const auto& action : applicable_action_generator.create_applicable_action_generator(state))
+            {
+                const auto [successor_state, successor_state_metric_value] =
+                    scratch_repository->get_or_create_successor_state(state, action, state_metric_value);
+                const auto action_cost = successor_state_metric_value - state_metric_value;
+
+                event_handler->on_generate_state(state, action, action_cost, successor_state);
+
+                auto successor_g_value = g_value + 1;
+                auto successor_h_value = ContinuousCost(0);
+                if constexpr (is_astar)
+                {
+                    if (successor_state_metric_value == UNDEFINED_CONTINUOUS_COST)
+                    {
+                        throw std::runtime_error("external_memory::find_solution(...): evaluating the metric on the successor state yielded NaN.");
+                    }
+
+                    successor_g_value = successor_state_metric_value;
+                    successor_h_value = heuristic->compute_heuristic(successor_state, goal_strategy->test_dynamic_goal(successor_state));
+
+                    if (successor_h_value == INFINITY_CONTINUOUS_COST)
+                    {
+                        continue;
+                    }
+                }
+
+                buffer.push(get_or_create_bucket(successor_g_value, successor_h_value), bucket, offset, to_key(*successor_state.get_packed_state()));
+
+                if (buffer.get_memory_usage() > budget.max_buffer_usage)
+                {
+                    spill();
+                }
+            }
+        }
+
+        spill();
+    }
+
+    end_search();
+    event_handler->on_exhausted();
+
+    result.status = SearchStatus::EXHAUSTED;
+    return result;
+}
+
+}
+
+SearchResult find_solution_brfs(const SearchContext& context, const brfs::Options& options) { return find_solution_impl(context, nullptr, options); }
+
+SearchResult find_solution_astar(const SearchContext& context, const Heuristic& heuristic, const astar_eager::Options& options)
+{
+    return find_solution_impl(context, heuristic, options);
+}
+
+}
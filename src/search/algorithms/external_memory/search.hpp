@@ -0,0 +1,35 @@
+/*
+ * Copyright (C) 2023 Dominik Drexler and Simon Stahlberg
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef MIMIR_SRC_SEARCH_ALGORITHMS_EXTERNAL_MEMORY_SEARCH_HPP_
+#define MIMIR_SRC_SEARCH_ALGORITHMS_EXTERNAL_MEMORY_SEARCH_HPP_
+
+#include "mimir/search/algorithms/astar_eager.hpp"
+#include "mimir/search/algorithms/brfs.hpp"
+
+namespace mimir::search::external_memory
+{
+
+/// @brief Run BrFS in external memory mode. Requires `options.external_memory`.
+extern SearchResult find_solution_brfs(const SearchContext& context, const brfs::Options& options);
+
+/// @brief Run AStar in external memory mode. Requires `options.external_memory`.
+extern SearchResult find_solution_astar(const SearchContext& context, const Heuristic& heuristic, const astar_eager::Options& options);
+
+}
+
+#endif
@@ -28,14 +28,19 @@
 #include "mimir/search/applicable_action_generators/interface.hpp"
 #include "mimir/search/axiom_evaluators/interface.hpp"
 #include "mimir/search/heuristics/interface.hpp"
+#include "mimir/search/openlists/alternating.hpp"
 #include "mimir/search/openlists/interface.hpp"
 #include "mimir/search/openlists/priority_queue.hpp"
 #include "mimir/search/plan.hpp"
 #include "mimir/search/search_context.hpp"
 #include "mimir/search/search_node.hpp"
 #include "mimir/search/search_space.hpp"
+#include "mimir/search/state_cache.hpp"
 #include "mimir/search/state_repository.hpp"
 
+#include <algorithm>
+#include <stdexcept>
+
 using namespace mimir::formalism;
 
 namespace mimir::search::gbfs_eager
@@ -75,29 +80,45 @@ static SearchNode& get_or_create_search_node(size_t state_index, SearchNodeVecto
 struct QueueEntry
 {
     using KeyType = std::tuple<ContinuousCost, ContinuousCost, Index, SearchNodeStatus>;
-    using ItemType = PackedState;
+    using ItemType = IndexedPackedState;
 
     ContinuousCost g_value;
     ContinuousCost h_value;
     PackedState packed_state;
+    Index state_index;
     Index step;
     SearchNodeStatus status;
 
     KeyType get_key() const { return std::make_tuple(h_value, g_value, step, status); }
-    ItemType get_item() const { return packed_state; }
+    ItemType get_item() const { return ItemType { state_index, packed_state }; }
 };
 
-static_assert(sizeof(QueueEntry) == 32);
+static_assert(sizeof(QueueEntry) == 40);
 
+/// @brief The g-value that breaks ties between equal h-values takes many distinct values,
+/// which makes the sub buckets of a `BucketQueue` expensive, so GBFS keeps the binary heap.
 using Queue = PriorityQueue<QueueEntry>;
 
+/// @brief `OpenList` alternates between a standard queue for each heuristic and, if preferred actions are used,
+/// a queue for each heuristic with the successor states that are reached by a preferred action.
+using OpenList = DynamicAlternatingOpenList<Queue>;
+
 /**
  * GBFS
  */
 
 SearchResult find_solution(const SearchContext& context, const Heuristic& heuristic, const Options& options)
 {
-    assert(heuristic);
+    return find_solution(context, HeuristicList { heuristic }, options);
+}
+
+SearchResult find_solution(const SearchContext& context, const HeuristicList& heuristics, const Options& options)
+{
+    if (heuristics.empty())
+    {
+        throw std::invalid_argument("find_solution(...): expected at least one heuristic.");
+    }
+    assert(std::all_of(heuristics.begin(), heuristics.end(), [](auto&& heuristic) { return heuristic != nullptr; }));
 
     auto& problem = *context->get_problem();
     auto& applicable_action_generator = *context->get_applicable_action_generator();
@@ -151,19 +172,31 @@ SearchResult find_solution(const SearchContext& context, const Heuristic& heuris
         return result;
     }
 
-    auto openlist = Queue();
+    const auto num_heuristics = heuristics.size();
+    const auto num_queues_per_heuristic = size_t(options.use_preferred_actions ? 2 : 1);
+    const auto get_standard_queue_index = [&](size_t heuristic_index) { return heuristic_index * num_queues_per_heuristic; };
+    const auto get_preferred_queue_index = [&](size_t heuristic_index) { return heuristic_index * num_queues_per_heuristic + 1; };
+    auto openlist = OpenList(num_heuristics * num_queues_per_heuristic);
 
     if (start_g_value == UNDEFINED_CONTINUOUS_COST)
     {
         throw std::runtime_error("find_solution(...): evaluating the metric on the start state yielded NaN.");
     }
-    const auto start_h_value = heuristic->compute_heuristic(start_state, goal_strategy->test_dynamic_goal(start_state));
-    auto best_h_value = start_h_value;
+    const auto start_is_goal_state = goal_strategy->test_dynamic_goal(start_state);
+    auto start_h_values = ContinuousCostList(num_heuristics);
+    for (size_t i = 0; i < num_heuristics; ++i)
+    {
+        start_h_values[i] = heuristics[i]->compute_heuristic(start_state, start_is_goal_state);
+    }
+    const auto start_h_value = start_h_values.front();
+    const auto start_is_dead_end =
+        std::any_of(start_h_values.begin(), start_h_values.end(), [](auto&& h_value) { return h_value == INFINITY_CONTINUOUS_COST; });
+    auto best_h_values = start_h_values;
 
     event_handler->on_start_search(start_state, start_g_value, start_h_value);
 
     auto& start_search_node = get_or_create_search_node(start_state.get_index(), search_nodes);
-    start_search_node.status = (start_h_value == INFINITY_CONTINUOUS_COST) ? SearchNodeStatus::DEAD_END : SearchNodeStatus::OPEN;
+    start_search_node.status = start_is_dead_end ? SearchNodeStatus::DEAD_END : SearchNodeStatus::OPEN;
     start_search_node.g_value = start_g_value;
     start_search_node.h_value = start_h_value;
 
@@ -186,11 +219,28 @@ SearchResult find_solution(const SearchContext& context, const Heuristic& heuris
     }
 
     auto applicable_actions = GroundActionList {};
-    openlist.insert(QueueEntry { start_g_value, start_h_value, start_state.get_packed_state(), step++, start_search_node.status });
+    auto state_cache = UnpackedStateCache(options.unpacked_state_cache_size);
+    const auto start_step = step++;
+    for (size_t i = 0; i < num_heuristics; ++i)
+    {
+        openlist.insert(
+            get_standard_queue_index(i),
+            QueueEntry { start_g_value, start_h_values[i], start_state.get_packed_state(), start_state.get_index(), start_step, start_search_node.status });
+    }
 
     auto stopwatch = StopWatch(options.max_time_in_ms);
     stopwatch.start();
 
+    /* Memory for reuse */
+    auto successor_states = StateList {};
+    auto successor_is_goal_states = std::vector<bool> {};
+    auto successor_actions = GroundActionList {};
+    auto successor_action_costs = ContinuousCostList {};
+    auto successor_are_preferred = std::vector<bool> {};
+    auto successor_h_values = std::vector<ContinuousCostList>(num_heuristics);
+    auto successor_preferred_actions = std::vector<GroundActionSet> {};
+    auto preferred_actions = GroundActionSet {};
+
     while (!openlist.empty())
     {
         if (stopwatch.has_finished())
@@ -199,10 +249,10 @@ SearchResult find_solution(const SearchContext& context, const Heuristic& heuris
             return result;
         }
 
-        const auto state = state_repository.get_state(*openlist.top());
+        const auto indexed_packed_state = openlist.top();
         openlist.pop();
 
-        auto& search_node = get_or_create_search_node(state.get_index(), search_nodes);
+        auto& search_node = get_or_create_search_node(indexed_packed_state.index, search_nodes);
 
         /* Close state. */
 
@@ -211,6 +261,23 @@ SearchResult find_solution(const SearchContext& context, const Heuristic& heuris
             continue;
         }
 
+        /* Unpack the state only after the test, since closed states are skipped. */
+
+        const auto state = state_cache.extract_or_unpack(indexed_packed_state, state_repository, *event_handler);
+
+        /* Collect the preferred actions by evaluating the state again, which is a cache hit if the heuristic is a `CachingHeuristicImpl`. */
+
+        preferred_actions.clear();
+        if (options.use_preferred_actions)
+        {
+            for (const auto& heuristic : heuristics)
+            {
+                heuristic->compute_heuristic(state, search_node.status == SearchNodeStatus::GOAL);
+                const auto& heuristic_preferred_actions = heuristic->get_preferred_actions().data;
+                preferred_actions.insert(heuristic_preferred_actions.begin(), heuristic_preferred_actions.end());
+            }
+        }
+
         /* Expand the successors of the state. */
 
         event_handler->on_expand_state(state);
@@ -219,6 +286,12 @@ SearchResult find_solution(const SearchContext& context, const Heuristic& heuris
 
         search_node.status = SearchNodeStatus::CLOSED;
 
+        successor_states.clear();
+        successor_is_goal_states.clear();
+        successor_actions.clear();
+        successor_action_costs.clear();
+        successor_are_preferred.clear();
+
         for (const auto& action : applicable_action_generator.create_applicable_action_generator(state))
         {
             const auto [successor_state, successor_state_metric_value] = state_repository.get_or_create_successor_state(state, action, search_node.g_value);
@@ -287,26 +360,85 @@ SearchResult find_solution(const SearchContext& context, const Heuristic& heuris
                 return result;
             }
 
-            /* Compute heuristic since state is new. */
+            /* Defer the heuristic evaluation to evaluate all new successor states in a single batch. */
+
+            successor_states.push_back(successor_state);
+            successor_is_goal_states.push_back(successor_is_goal_state);
+            successor_actions.push_back(action);
+            successor_action_costs.push_back(action_cost);
+            successor_are_preferred.push_back(preferred_actions.contains(action));
+        }
+
+        /* Compute heuristics since states are new, including the preferred actions to let a caching heuristic store them for the expansion. */
 
-            const auto successor_h_value = heuristic->compute_heuristic(successor_state, successor_is_goal_state);
-            successor_search_node.h_value = successor_h_value;
-            if (successor_h_value == INFINITY_CONTINUOUS_COST)
+        for (size_t i = 0; i < num_heuristics; ++i)
+        {
+            if (options.use_preferred_actions)
+            {
+                heuristics[i]->compute_heuristics_and_preferred_actions(successor_states,
+                                                                        successor_is_goal_states,
+                                                                        successor_h_values[i],
+                                                                        successor_preferred_actions);
+            }
+            else
+            {
+                heuristics[i]->compute_heuristics(successor_states, successor_is_goal_states, successor_h_values[i]);
+            }
+        }
+
+        for (size_t j = 0; j < successor_states.size(); ++j)
+        {
+            const auto& successor_state = successor_states[j];
+            auto& successor_search_node = search_nodes[successor_state.get_index()];
+            successor_search_node.h_value = successor_h_values.front()[j];
+            if (std::any_of(successor_h_values.begin(), successor_h_values.end(), [&](auto&& h_values) { return h_values[j] == INFINITY_CONTINUOUS_COST; }))
             {
                 successor_search_node.status = SearchNodeStatus::DEAD_END;
                 continue;
             }
 
-            if (successor_h_value < best_h_value)
+            auto is_progress = false;
+            for (size_t i = 0; i < num_heuristics; ++i)
             {
-                best_h_value = successor_h_value;
-                event_handler->on_new_best_h_value(best_h_value);
+                if (successor_h_values[i][j] < best_h_values[i])
+                {
+                    best_h_values[i] = successor_h_values[i][j];
+                    is_progress = true;
+                    if (i == 0)
+                    {
+                        event_handler->on_new_best_h_value(best_h_values[i]);
+                    }
+                }
             }
 
-            event_handler->on_generate_state(state, action, action_cost, successor_state);
+            /* Boost the preferred queues whenever a heuristic makes progress. */
 
-            openlist.insert(
-                QueueEntry { successor_state_metric_value, successor_h_value, successor_state.get_packed_state(), step++, successor_search_node.status });
+            if (is_progress && options.use_preferred_actions)
+            {
+                for (size_t i = 0; i < num_heuristics; ++i)
+                {
+                    openlist.boost(get_preferred_queue_index(i), options.preferred_actions_boost);
+                }
+            }
+
+            event_handler->on_generate_state(state, successor_actions[j], successor_action_costs[j], successor_state);
+
+            const auto successor_step = step++;
+            for (size_t i = 0; i < num_heuristics; ++i)
+            {
+                const auto entry = QueueEntry { successor_search_node.g_value,
+                                                successor_h_values[i][j],
+                                                successor_state.get_packed_state(),
+                                                successor_state.get_index(),
+                                                successor_step,
+                                                successor_search_node.status };
+                openlist.insert(get_standard_queue_index(i), entry);
+                if (successor_are_preferred[j])
+                {
+                    openlist.insert(get_preferred_queue_index(i), entry);
+                }
+            }
+            state_cache.insert(successor_state);
         }
     }
 
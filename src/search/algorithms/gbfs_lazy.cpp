@@ -32,13 +32,18 @@
 #include "mimir/search/heuristics/interface.hpp"
 #include "mimir/search/openlists/alternating.hpp"
 #include "mimir/search/openlists/interface.hpp"
+#include "mimir/search/openlists/bucket_queue.hpp"
 #include "mimir/search/openlists/priority_queue.hpp"
 #include "mimir/search/plan.hpp"
 #include "mimir/search/search_context.hpp"
 #include "mimir/search/search_node.hpp"
 #include "mimir/search/search_space.hpp"
+#include "mimir/search/state_cache.hpp"
 #include "mimir/search/state_repository.hpp"
 
+#include <algorithm>
+#include <variant>
+
 using namespace mimir::formalism;
 
 namespace mimir::search::gbfs_lazy
@@ -81,36 +86,43 @@ static SearchNode& get_or_create_search_node(size_t state_index, SearchNodeVecto
 struct GreedyQueueEntry
 {
     using KeyType = std::tuple<Index, SearchNodeStatus>;
-    using ItemType = PackedState;
+    using ItemType = IndexedPackedState;
+    using SecondaryKeyType = std::monostate;
 
     PackedState packed_state;
+    Index state_index;
     Index step;
     SearchNodeStatus status;
 
     KeyType get_key() const { return std::make_tuple(step, status); }
-    ItemType get_item() const { return packed_state; }
+    ContinuousCost get_primary_key() const { return 0; }  ///< The step order equals the insertion order.
+    SecondaryKeyType get_secondary_key() const { return std::monostate {}; }
+    ItemType get_item() const { return ItemType { state_index, packed_state }; }
 };
 
-static_assert(sizeof(GreedyQueueEntry) == 16);
+static_assert(sizeof(GreedyQueueEntry) == 24);
 
 struct ExhaustiveQueueEntry
 {
     using KeyType = std::tuple<ContinuousCost, ContinuousCost, Index, SearchNodeStatus>;
-    using ItemType = PackedState;
+    using ItemType = IndexedPackedState;
 
     ContinuousCost g_value;
     ContinuousCost h_value;
     PackedState packed_state;
+    Index state_index;
     Index step;
     SearchNodeStatus status;
 
     KeyType get_key() const { return std::make_tuple(h_value, g_value, step, status); }
-    ItemType get_item() const { return packed_state; }
+    ItemType get_item() const { return ItemType { state_index, packed_state }; }
 };
 
-static_assert(sizeof(ExhaustiveQueueEntry) == 32);
+static_assert(sizeof(ExhaustiveQueueEntry) == 40);
 
-using GreedyQueue = PriorityQueue<GreedyQueueEntry>;
+using GreedyQueue = BucketQueue<GreedyQueueEntry>;
+/// @brief The g-value that breaks ties between equal h-values takes many distinct values,
+/// which makes the sub buckets of a `BucketQueue` expensive, so the exhaustive queue keeps the binary heap.
 using ExhaustiveQueue = PriorityQueue<ExhaustiveQueueEntry>;
 
 /**
@@ -227,12 +239,21 @@ SearchResult find_solution(const SearchContext& context, const Heuristic& heuris
 
     const auto use_exploration_strategy = std::any_of(options.openlist_weights.begin(), options.openlist_weights.begin() + 4, [](double w) { return w > 0; });
     auto applicable_actions = GroundActionList {};
-    standard_openlist.insert(ExhaustiveQueueEntry { start_g_value, start_h_value, start_state.get_packed_state(), step++, start_search_node.status });
+    auto state_cache = UnpackedStateCache(options.unpacked_state_cache_size);
+    standard_openlist.insert(
+        ExhaustiveQueueEntry { start_g_value, start_h_value, start_state.get_packed_state(), start_state.get_index(), step++, start_search_node.status });
 
     auto stopwatch = StopWatch(options.max_time_in_ms);
     stopwatch.start();
 
-    while (!openlist.empty())
+    /* Memory for reuse */
+    auto batch_states = StateList {};
+    auto batch_are_goal_states = std::vector<bool> {};
+    auto batch_h_values = ContinuousCostList {};
+    auto batch_position = size_t(0);
+    const auto no_preferred_actions = PreferredActions {};
+
+    while (!openlist.empty() || batch_position < batch_states.size())
     {
         if (stopwatch.has_finished())
         {
@@ -240,19 +261,57 @@ SearchResult find_solution(const SearchContext& context, const Heuristic& heuris
             return result;
         }
 
-        const auto state = state_repository.get_state(*openlist.top());
-        openlist.pop();
+        /* Evaluate the next batch of open states. */
 
-        auto& search_node = get_or_create_search_node(state.get_index(), search_nodes);
+        if (batch_position == batch_states.size())
+        {
+            batch_states.clear();
+            batch_are_goal_states.clear();
+            batch_position = 0;
 
-        /* Close state. */
+            while (!openlist.empty() && batch_states.size() < std::max(options.batch_size, size_t(1)))
+            {
+                const auto indexed_packed_state = openlist.top();
+                openlist.pop();
 
-        if (search_node.status == SearchNodeStatus::CLOSED || search_node.status == SearchNodeStatus::DEAD_END)
-        {
-            continue;
+                const auto& open_search_node = get_or_create_search_node(indexed_packed_state.index, search_nodes);
+
+                /* Skip closed states and states that are already part of the batch before unpacking them. */
+
+                if (open_search_node.status == SearchNodeStatus::CLOSED || open_search_node.status == SearchNodeStatus::DEAD_END
+                    || std::any_of(batch_states.begin(),
+                                   batch_states.end(),
+                                   [&](const State& batch_state) { return batch_state.get_index() == indexed_packed_state.index; }))
+                {
+                    continue;
+                }
+
+                const auto open_state = state_cache.extract_or_unpack(indexed_packed_state, state_repository, *event_handler);
+                batch_states.push_back(open_state);
+                batch_are_goal_states.push_back(open_search_node.status == SearchNodeStatus::GOAL);
+            }
+
+            if (batch_states.empty())
+            {
+                continue;
+            }
+
+            if (batch_states.size() == 1)
+            {
+                // Evaluate single states individually to obtain the preferred actions.
+                batch_h_values.assign(1, heuristic->compute_heuristic(batch_states.front(), batch_are_goal_states.front()));
+            }
+            else
+            {
+                heuristic->compute_heuristics(batch_states, batch_are_goal_states, batch_h_values);
+            }
         }
 
-        const auto state_h_value = heuristic->compute_heuristic(state, search_node.status == SearchNodeStatus::GOAL);
+        const auto state = batch_states[batch_position];
+        const auto state_h_value = batch_h_values[batch_position];
+        ++batch_position;
+
+        auto& search_node = get_or_create_search_node(state.get_index(), search_nodes);
         search_node.h_value = state_h_value;
         if (state_h_value == INFINITY_CONTINUOUS_COST)
         {
@@ -266,7 +325,8 @@ SearchResult find_solution(const SearchContext& context, const Heuristic& heuris
             event_handler->on_new_best_h_value(best_h_value);
         }
 
-        const auto& preferred_actions = heuristic->get_preferred_actions();
+        // A batch evaluation does not compute preferred actions.
+        const auto& preferred_actions = (batch_states.size() == 1) ? heuristic->get_preferred_actions() : no_preferred_actions;
         // Ensure that preferred actions are applicable.
         assert(std::all_of(preferred_actions.data.begin(), preferred_actions.data.end(), [&](auto&& action) { return is_applicable(action, state); }));
 
@@ -371,18 +431,21 @@ SearchResult find_solution(const SearchContext& context, const Heuristic& heuris
             if (options.openlist_weights[0] > 0 && is_compatible && is_preferred && first_compatible)
             {
                 first_compatible = false;
-                compatible_greedy_and_preferred_openlist.insert(GreedyQueueEntry { successor_state.get_packed_state(), step++, successor_search_node.status });
+                compatible_greedy_and_preferred_openlist.insert(
+                    GreedyQueueEntry { successor_state.get_packed_state(), successor_state.get_index(), step++, successor_search_node.status });
             }
             else if (options.openlist_weights[1] > 0 && is_compatible && first_compatible)
             {
                 first_compatible = false;
-                compatible_greedy_openlist.insert(GreedyQueueEntry { successor_state.get_packed_state(), step++, successor_search_node.status });
+                compatible_greedy_openlist.insert(
+                    GreedyQueueEntry { successor_state.get_packed_state(), successor_state.get_index(), step++, successor_search_node.status });
             }
             else if (options.openlist_weights[2] > 0 && is_compatible && is_preferred)
             {
                 compatible_exhaustive_and_preferred_openlist.insert(ExhaustiveQueueEntry { successor_state_metric_value,
                                                                                            state_h_value,
                                                                                            successor_state.get_packed_state(),
+                                                                                           successor_state.get_index(),
                                                                                            step++,
                                                                                            successor_search_node.status });
             }
@@ -391,6 +454,7 @@ SearchResult find_solution(const SearchContext& context, const Heuristic& heuris
                 compatible_exhaustive_openlist.insert(ExhaustiveQueueEntry { successor_state_metric_value,
                                                                              state_h_value,
                                                                              successor_state.get_packed_state(),
+                                                                             successor_state.get_index(),
                                                                              step++,
                                                                              successor_search_node.status });
             }
@@ -399,6 +463,7 @@ SearchResult find_solution(const SearchContext& context, const Heuristic& heuris
                 preferred_openlist.insert(ExhaustiveQueueEntry { successor_state_metric_value,
                                                                  state_h_value,
                                                                  successor_state.get_packed_state(),
+                                                                 successor_state.get_index(),
                                                                  step++,
                                                                  successor_search_node.status });
             }
@@ -407,9 +472,11 @@ SearchResult find_solution(const SearchContext& context, const Heuristic& heuris
                 standard_openlist.insert(ExhaustiveQueueEntry { successor_state_metric_value,
                                                                 state_h_value,
                                                                 successor_state.get_packed_state(),
+                                                                successor_state.get_index(),
                                                                 step++,
                                                                 successor_search_node.status });
             }
+            state_cache.insert(successor_state);
         }
     }
 
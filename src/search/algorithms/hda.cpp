@@ -0,0 +1,764 @@
+/*
+ * Copyright (C) 2023 Dominik Drexler and Simon Stahlberg
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "mimir/search/algorithms/hda.hpp"
+
+#include "mimir/algorithms/BS_thread_pool.hpp"
+#include "mimir/common/segmented_vector.hpp"
+#include "mimir/common/timers.hpp"
+#include "mimir/formalism/problem.hpp"
+#include "mimir/search/algorithms/strategies/goal_strategy.hpp"
+#include "mimir/search/applicable_action_generators/interface.hpp"
+#include "mimir/search/heuristics/interface.hpp"
+#include "mimir/search/openlists/priority_queue.hpp"
+#include "mimir/search/plan.hpp"
+#include "mimir/search/search_context.hpp"
+#include "mimir/search/search_node.hpp"
+#include "mimir/search/state_repository.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+#include <optional>
+
+using namespace mimir::formalism;
+
+namespace mimir::search::hda
+{
+
+/**
+ * SearchNode
+ */
+
+static constexpr uint32_t NO_WORKER = std::numeric_limits<uint32_t>::max();
+
+struct SearchNode
+{
+    ContinuousCost g_value;
+    ContinuousCost h_value;
+    PackedState packed_state;
+    Index parent_state;
+    uint32_t parent_worker;
+    SearchNodeStatus status;
+};
+
+static_assert(sizeof(SearchNode) == 40);
+
+using SearchNodeVector = SegmentedVector<SearchNode>;
+
+static SearchNode& get_or_create_search_node(size_t state_index, SearchNodeVector& search_nodes)
+{
+    static constexpr auto default_node =
+        SearchNode { ContinuousCost(INFINITY_CONTINUOUS_COST), ContinuousCost(0), nullptr, MAX_INDEX, NO_WORKER, SearchNodeStatus::NEW };
+
+    while (state_index >= search_nodes.size())
+    {
+        search_nodes.push_back(default_node);
+    }
+    return search_nodes[state_index];
+}
+
+/**
+ * Messages
+ */
+
+/// @brief `Message` transfers a generated successor state to the worker that owns it.
+struct Message
+{
+    PackedStateImpl packed_state;
+    ContinuousCost g_value;
+    Index parent_state;
+    uint32_t parent_worker;
+};
+
+using MessageList = std::vector<Message>;
+
+static size_t get_owner(const PackedStateImpl& packed_state, size_t num_workers) { return loki::Hash<PackedStateImpl> {}(packed_state) % num_workers; }
+
+/**
+ * Queue entries
+ */
+
+struct AStarQueueEntry
+{
+    using KeyType = std::pair<ContinuousCost, SearchNodeStatus>;
+    using ItemType = PackedState;
+
+    ContinuousCost f_value;
+    PackedState packed_state;
+    SearchNodeStatus status;
+
+    KeyType get_key() const { return std::make_pair(f_value, status); }
+    ItemType get_item() const { return packed_state; }
+};
+
+static_assert(sizeof(AStarQueueEntry) == 24);
+
+struct GBFSQueueEntry
+{
+    using KeyType = std::tuple<ContinuousCost, ContinuousCost, Index, SearchNodeStatus>;
+    using ItemType = PackedState;
+
+    ContinuousCost g_value;
+    ContinuousCost h_value;
+    PackedState packed_state;
+    Index step;
+    SearchNodeStatus status;
+
+    KeyType get_key() const { return std::make_tuple(h_value, g_value, step, status); }
+    ItemType get_item() const { return packed_state; }
+};
+
+static_assert(sizeof(GBFSQueueEntry) == 32);
+
+/**
+ * TerminationDetector
+ */
+
+/// @brief `TerminationDetector` detects that all workers are idle and that no message is in flight.
+///
+/// A message is in flight from the moment before it is pushed into an inbox until the receiver inserted it into its open list.
+/// Workers only change from idle to active while holding the mutex, and a sender only pushes messages while being active.
+/// Hence, if all workers are idle and no message is in flight, then no worker can ever become active again.
+class TerminationDetector
+{
+private:
+    std::mutex m_mutex;
+    std::condition_variable m_cv;
+    size_t m_num_workers;
+    std::atomic_size_t m_num_idle;
+    std::atomic_int64_t m_num_in_flight;
+    std::atomic_bool m_done;
+
+public:
+    explicit TerminationDetector(size_t num_workers) : m_mutex(), m_cv(), m_num_workers(num_workers), m_num_idle(0), m_num_in_flight(0), m_done(false) {}
+
+    /// @brief Must be called before pushing a message into an inbox.
+    void on_send() { m_num_in_flight.fetch_add(1); }
+
+    /// @brief Must be called after pushing a message into an inbox to wake up idle workers.
+    void on_sent()
+    {
+        if (m_num_idle.load() > 0)
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_cv.notify_all();
+        }
+    }
+
+    /// @brief Must be called after the received messages were processed.
+    void on_processed(size_t num_messages) { m_num_in_flight.fetch_sub(num_messages); }
+
+    void stop()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_done.store(true);
+        }
+        m_cv.notify_all();
+    }
+
+    bool is_done() const { return m_done.load(); }
+
+    /// @brief Block the calling worker until it has work or the search terminated.
+    /// @param has_work is a predicate that tests whether the calling worker has work.
+    /// @return true if the worker has work, and false if the search terminated.
+    template<typename F>
+    bool wait_for_work(F&& has_work)
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+
+        // Important: register as idle before testing for work, see `on_sent`.
+        m_num_idle.fetch_add(1);
+
+        while (true)
+        {
+            if (m_done.load())
+            {
+                m_num_idle.fetch_sub(1);
+                return false;
+            }
+            if (has_work())
+            {
+                m_num_idle.fetch_sub(1);
+                return true;
+            }
+            if (m_num_idle.load() == m_num_workers && m_num_in_flight.load() == 0)
+            {
+                m_done.store(true);
+                m_num_idle.fetch_sub(1);
+                m_cv.notify_all();
+                return false;
+            }
+            m_cv.wait(lock);
+        }
+    }
+};
+
+/**
+ * Worker
+ */
+
+template<typename QueueEntry>
+struct Worker
+{
+    uint32_t index;
+    SearchContext context;
+    Heuristic heuristic;
+    GoalStrategy goal_strategy;
+
+    SearchNodeVector search_nodes;
+    PriorityQueue<QueueEntry> openlist;
+    Index step;
+
+    std::mutex inbox_mutex;
+    MessageList inbox;
+    MessageList inbox_buffer;  ///< Swapped with the inbox to process messages without holding the lock.
+
+    GroundActionList actions;                                  ///< Buffer for actions generated while holding the problem lock.
+    std::vector<std::pair<State, ContinuousCost>> successors;  ///< Buffer for successors.
+
+    Statistics statistics;
+
+    Worker(uint32_t index, SearchContext context, Heuristic heuristic) :
+        index(index),
+        context(context),
+        heuristic(std::move(heuristic)),
+        goal_strategy(ProblemGoalStrategyImpl::create(context->get_problem())),
+        search_nodes(),
+        openlist(),
+        step(0),
+        inbox_mutex(),
+        inbox(),
+        inbox_buffer(),
+        actions(),
+        successors(),
+        statistics()
+    {
+    }
+
+    bool has_messages()
+    {
+        std::lock_guard<std::mutex> lock(inbox_mutex);
+        return !inbox.empty();
+    }
+};
+
+/**
+ * HashDistributedSearch
+ */
+
+template<bool Optimal>
+class HashDistributedSearch
+{
+private:
+    using QueueEntry = std::conditional_t<Optimal, AStarQueueEntry, GBFSQueueEntry>;
+
+    const Options& m_options;
+    std::vector<std::unique_ptr<Worker<QueueEntry>>> m_workers;
+
+    std::mutex m_problem_mutex;  ///< Serializes calls that may ground new actions or atoms in the problem.
+    bool m_has_axioms;
+    TerminationDetector m_termination;
+    StopWatch m_stopwatch;
+    std::atomic<uint64_t> m_num_states;
+
+    std::mutex m_solution_mutex;
+    std::atomic<ContinuousCost> m_incumbent_cost;
+    uint32_t m_incumbent_worker;
+    Index m_incumbent_state;
+    std::atomic<SearchStatus> m_status;
+    std::exception_ptr m_exception;
+
+    void set_status(SearchStatus status)
+    {
+        auto expected = SearchStatus::IN_PROGRESS;
+        m_status.compare_exchange_strong(expected, status);
+    }
+
+    bool has_local_work(Worker<QueueEntry>& worker) const
+    {
+        if (worker.openlist.empty())
+            return false;
+
+        if constexpr (Optimal)
+        {
+            return worker.openlist.top_entry().f_value < m_incumbent_cost.load();
+        }
+        else
+        {
+            return true;
+        }
+    }
+
+    void push(Worker<QueueEntry>& worker, const SearchNode& node)
+    {
+        if constexpr (Optimal)
+        {
+            worker.openlist.insert(QueueEntry { node.g_value + node.h_value, node.packed_state, node.status });
+        }
+        else
+        {
+            worker.openlist.insert(QueueEntry { node.g_value, node.h_value, node.packed_state, worker.step++, node.status });
+        }
+    }
+
+    void on_solution(Worker<QueueEntry>& worker, Index state_index, ContinuousCost cost)
+    {
+        std::lock_guard<std::mutex> lock(m_solution_mutex);
+
+        if (cost < m_incumbent_cost.load())
+        {
+            m_incumbent_cost.store(cost);
+            m_incumbent_worker = worker.index;
+            m_incumbent_state = state_index;
+        }
+    }
+
+    /// @brief Open a state for which the owning worker has not created a search node yet.
+    void on_new_state(Worker<QueueEntry>& worker, const State& state, ContinuousCost g_value, uint32_t parent_worker, Index parent_state)
+    {
+        auto& node = get_or_create_search_node(state.get_index(), worker.search_nodes);
+
+        if (m_num_states.fetch_add(1) + 1 >= m_options.max_num_states)
+        {
+            set_status(SearchStatus::OUT_OF_STATES);
+            m_termination.stop();
+            return;
+        }
+
+        node.g_value = g_value;
+        node.packed_state = state.get_packed_state();
+        node.parent_worker = parent_worker;
+        node.parent_state = parent_state;
+
+        const auto is_goal_state = worker.goal_strategy->test_dynamic_goal(state);
+
+        if constexpr (!Optimal)
+        {
+            if (is_goal_state)
+            {
+                node.status = SearchNodeStatus::GOAL;
+                on_solution(worker, state.get_index(), g_value);
+                set_status(SearchStatus::SOLVED);
+                m_termination.stop();
+                return;
+            }
+        }
+
+        node.h_value = worker.heuristic->compute_heuristic(state, is_goal_state);
+
+        if (node.h_value == INFINITY_CONTINUOUS_COST)
+        {
+            node.status = SearchNodeStatus::DEAD_END;
+            return;
+        }
+
+        node.status = is_goal_state ? SearchNodeStatus::GOAL : SearchNodeStatus::OPEN;
+
+        if constexpr (Optimal)
+        {
+            if (node.g_value + node.h_value >= m_incumbent_cost.load())
+                return;
+        }
+
+        push(worker, node);
+    }
+
+    /// @brief Relax a state for which the owning worker already created a search node.
+    void on_known_state(Worker<QueueEntry>& worker, SearchNode& node, ContinuousCost g_value, uint32_t parent_worker, Index parent_state)
+    {
+        if constexpr (Optimal)
+        {
+            if (g_value >= node.g_value || node.status == SearchNodeStatus::DEAD_END)
+                return;
+
+            if (node.status == SearchNodeStatus::CLOSED)
+            {
+                ++worker.statistics.num_reopened;
+                node.status = SearchNodeStatus::OPEN;
+            }
+            node.g_value = g_value;
+            node.parent_worker = parent_worker;
+            node.parent_state = parent_state;
+
+            if (node.g_value + node.h_value >= m_incumbent_cost.load())
+                return;
+
+            push(worker, node);
+        }
+        // Greedy search never reopens states.
+    }
+
+    void process_inbox(Worker<QueueEntry>& worker)
+    {
+        {
+            std::lock_guard<std::mutex> lock(worker.inbox_mutex);
+            worker.inbox_buffer.clear();
+            std::swap(worker.inbox, worker.inbox_buffer);
+        }
+
+        auto& state_repository = *worker.context->get_state_repository();
+
+        for (const auto& message : worker.inbox_buffer)
+        {
+            ++worker.statistics.num_received;
+
+            // Avoid unpacking states that the worker already knows.
+            if (const auto entry = state_repository.get_states().find(message.packed_state))
+            {
+                auto& node = get_or_create_search_node(entry->second, worker.search_nodes);
+                if (node.status != SearchNodeStatus::NEW)
+                {
+                    on_known_state(worker, node, message.g_value, message.parent_worker, message.parent_state);
+                    continue;
+                }
+            }
+
+            const auto state = state_repository.import_state(message.packed_state);
+
+            on_new_state(worker, state, message.g_value, message.parent_worker, message.parent_state);
+        }
+
+        m_termination.on_processed(worker.inbox_buffer.size());
+    }
+
+    void send(Worker<QueueEntry>& worker, size_t owner, const PackedStateImpl& packed_state, ContinuousCost g_value, Index parent_state)
+    {
+        ++worker.statistics.num_sent;
+
+        auto& receiver = *m_workers[owner];
+
+        m_termination.on_send();
+        {
+            std::lock_guard<std::mutex> lock(receiver.inbox_mutex);
+            receiver.inbox.push_back(Message { packed_state, g_value, parent_state, worker.index });
+        }
+        m_termination.on_sent();
+    }
+
+    void expand(Worker<QueueEntry>& worker)
+    {
+        const auto packed_state = worker.openlist.top();
+        worker.openlist.pop();
+
+        auto& state_repository = *worker.context->get_state_repository();
+        auto& applicable_action_generator = *worker.context->get_applicable_action_generator();
+
+        const auto state_index = state_repository.get_state_index(*packed_state);
+        auto& node = get_or_create_search_node(state_index, worker.search_nodes);
+
+        if (node.status == SearchNodeStatus::CLOSED || node.status == SearchNodeStatus::DEAD_END)
+        {
+            return;
+        }
+
+        if constexpr (Optimal)
+        {
+            if (node.g_value + node.h_value >= m_incumbent_cost.load())
+            {
+                return;
+            }
+
+            if (node.status == SearchNodeStatus::GOAL)
+            {
+                on_solution(worker, state_index, node.g_value);
+                return;
+            }
+        }
+
+        node.status = SearchNodeStatus::CLOSED;
+        ++worker.statistics.num_expanded;
+
+        const auto g_value = node.g_value;
+
+        {
+            const auto state = state_repository.get_state(*packed_state);
+
+            auto lock = std::unique_lock<std::mutex>(m_problem_mutex);
+
+            worker.actions.clear();
+            for (const auto& action : applicable_action_generator.create_applicable_action_generator(state))
+            {
+                worker.actions.push_back(action);
+            }
+
+            if (!m_has_axioms)
+            {
+                lock.unlock();
+            }
+
+            worker.successors.clear();
+            for (const auto& action : worker.actions)
+            {
+                worker.successors.push_back(state_repository.get_or_create_successor_state(state, action, g_value));
+            }
+        }
+
+        for (const auto& [successor_state, successor_state_metric_value] : worker.successors)
+        {
+            ++worker.statistics.num_generated;
+
+            if (successor_state_metric_value == UNDEFINED_CONTINUOUS_COST)
+            {
+                throw std::runtime_error("hda::find_solution(...): evaluating the metric on the successor state yielded NaN.");
+            }
+
+            const auto owner = get_owner(*successor_state.get_packed_state(), m_workers.size());
+
+            if (owner != worker.index)
+            {
+                send(worker, owner, *successor_state.get_packed_state(), successor_state_metric_value, state_index);
+                continue;
+            }
+
+            auto& successor_node = get_or_create_search_node(successor_state.get_index(), worker.search_nodes);
+
+            if (successor_node.status == SearchNodeStatus::NEW)
+            {
+                on_new_state(worker, successor_state, successor_state_metric_value, worker.index, state_index);
+            }
+            else
+            {
+                on_known_state(worker, successor_node, successor_state_metric_value, worker.index, state_index);
+            }
+
+            if (m_termination.is_done())
+            {
+                break;
+            }
+        }
+        worker.successors.clear();
+    }
+
+    void run_worker(Worker<QueueEntry>& worker)
+    {
+        try
+        {
+            while (!m_termination.is_done())
+            {
+                if (m_stopwatch.has_finished())
+                {
+                    set_status(SearchStatus::OUT_OF_TIME);
+                    m_termination.stop();
+                    break;
+                }
+
+                process_inbox(worker);
+
+                if (!has_local_work(worker))
+                {
+                    if (!m_termination.wait_for_work([&] { return worker.has_messages() || has_local_work(worker); }))
+                    {
+                        break;
+                    }
+                    continue;
+                }
+
+                expand(worker);
+            }
+        }
+        catch (...)
+        {
+            {
+                std::lock_guard<std::mutex> lock(m_solution_mutex);
+                if (!m_exception)
+                {
+                    m_exception = std::current_exception();
+                }
+            }
+            set_status(SearchStatus::FAILED);
+            m_termination.stop();
+        }
+    }
+
+    Plan extract_plan(ContinuousCost start_g_value)
+    {
+        /* Collect the packed states along the distributed parent pointers. */
+
+        auto trajectory = std::vector<PackedState> {};
+        auto worker_index = m_incumbent_worker;
+        auto state_index = m_incumbent_state;
+
+        while (worker_index != NO_WORKER)
+        {
+            const auto& node = m_workers[worker_index]->search_nodes.at(state_index);
+            trajectory.push_back(node.packed_state);
+            worker_index = node.parent_worker;
+            state_index = node.parent_state;
+        }
+        std::reverse(trajectory.begin(), trajectory.end());
+
+        /* Replay the trajectory in the first search context. */
+
+        const auto& context = m_workers.front()->context;
+        auto& state_repository = *context->get_state_repository();
+        auto& applicable_action_generator = *context->get_applicable_action_generator();
+
+        auto state = state_repository.import_state(*trajectory.front());
+        auto state_metric_value = start_g_value;
+        auto states = StateList { state };
+        auto actions = GroundActionList {};
+
+        for (size_t i = 1; i < trajectory.size(); ++i)
+        {
+            // We have to take the (state,action) pair that yields lowest metric value.
+            auto lowest_action = GroundAction { nullptr };
+            auto lowest_state = std::optional<State> { std::nullopt };
+            auto lowest_metric_value = std::numeric_limits<ContinuousCost>::infinity();
+
+            for (const auto& action : applicable_action_generator.create_applicable_action_generator(state))
+            {
+                const auto [successor_state, successor_state_metric_value] =
+                    state_repository.get_or_create_successor_state(state, action, state_metric_value);
+
+                if (loki::EqualTo<PackedStateImpl> {}(*successor_state.get_packed_state(), *trajectory[i])
+                    && successor_state_metric_value < lowest_metric_value)
+                {
+                    lowest_action = action;
+                    lowest_state = successor_state;
+                    lowest_metric_value = successor_state_metric_value;
+                }
+            }
+            assert(lowest_state && lowest_action);
+            actions.push_back(lowest_action);
+            states.push_back(lowest_state.value());
+            state = lowest_state.value();
+            state_metric_value = lowest_metric_value;
+        }
+
+        return Plan(context, std::move(states), std::move(actions), state_metric_value);
+    }
+
+public:
+    HashDistributedSearch(const SearchContextList& contexts, const HeuristicList& heuristics, const Options& options) :
+        m_options(options),
+        m_workers(),
+        m_problem_mutex(),
+        m_has_axioms(!contexts.empty() && !contexts.front()->get_problem()->get_problem_and_domain_axioms().empty()),
+        m_termination(contexts.size()),
+        m_stopwatch(options.max_time_in_ms),
+        m_num_states(0),
+        m_solution_mutex(),
+        m_incumbent_cost(INFINITY_CONTINUOUS_COST),
+        m_incumbent_worker(NO_WORKER),
+        m_incumbent_state(MAX_INDEX),
+        m_status(SearchStatus::IN_PROGRESS),
+        m_exception(nullptr)
+    {
+        if (contexts.empty())
+        {
+            throw std::runtime_error("hda::find_solution(...): expected at least one search context.");
+        }
+        if (contexts.size() != heuristics.size())
+        {
+            throw std::runtime_error("hda::find_solution(...): expected one heuristic per search context.");
+        }
+        for (size_t i = 0; i < contexts.size(); ++i)
+        {
+            assert(heuristics[i]);
+            if (contexts[i]->get_problem() != contexts.front()->get_problem())
+            {
+                throw std::runtime_error("hda::find_solution(...): expected all search contexts to be defined over the same problem.");
+            }
+            contexts[i]->get_state_repository()->enable_concurrency();  ///< Workers share the tree tables of the problem.
+            m_workers.push_back(std::make_unique<Worker<QueueEntry>>(i, contexts[i], heuristics[i]));
+        }
+    }
+
+    SearchResult find_solution(StatisticsList* out_statistics)
+    {
+        auto result = SearchResult();
+
+        auto& main_worker = *m_workers.front();
+
+        /* Test static goal. */
+
+        if (!main_worker.goal_strategy->test_static_goal())
+        {
+            result.status = SearchStatus::UNSOLVABLE;
+            return result;
+        }
+
+        const auto [start_state, start_g_value] = main_worker.context->get_state_repository()->get_or_create_initial_state();
+
+        if (start_g_value == UNDEFINED_CONTINUOUS_COST)
+        {
+            throw std::runtime_error("hda::find_solution(...): evaluating the metric on the start state yielded NaN.");
+        }
+
+        /* Send the start state to its owner. */
+
+        const auto owner = get_owner(*start_state.get_packed_state(), m_workers.size());
+        m_termination.on_send();
+        m_workers[owner]->inbox.push_back(Message { *start_state.get_packed_state(), start_g_value, MAX_INDEX, NO_WORKER });
+
+        /* Run the workers. */
+
+        m_stopwatch.start();
+        {
+            auto pool = BS::thread_pool(m_workers.size());
+            pool.detach_sequence(size_t(0), m_workers.size(), [this](size_t i) { run_worker(*m_workers[i]); });
+            pool.wait();
+        }
+
+        if (out_statistics)
+        {
+            out_statistics->clear();
+            for (const auto& worker : m_workers)
+            {
+                out_statistics->push_back(worker->statistics);
+            }
+        }
+
+        if (m_exception)
+        {
+            std::rethrow_exception(m_exception);
+        }
+
+        /* Without a status, the workers terminated because they ran out of work. */
+
+        if (m_status.load() == SearchStatus::IN_PROGRESS)
+        {
+            set_status((m_incumbent_worker != NO_WORKER) ? SearchStatus::SOLVED : SearchStatus::EXHAUSTED);
+        }
+
+        result.status = m_status.load();
+
+        if (result.status == SearchStatus::SOLVED)
+        {
+            result.plan = extract_plan(start_g_value);
+            result.goal_state = result.plan->get_states().back();
+        }
+
+        return result;
+    }
+};
+
+SearchResult find_solution_astar(const SearchContextList& contexts, const HeuristicList& heuristics, const Options& options, StatisticsList* out_statistics)
+{
+    return HashDistributedSearch<true>(contexts, heuristics, options).find_solution(out_statistics);
+}
+
+SearchResult find_solution_gbfs(const SearchContextList& contexts, const HeuristicList& heuristics, const Options& options, StatisticsList* out_statistics)
+{
+    return HashDistributedSearch<false>(contexts, heuristics, options).find_solution(out_statistics);
+}
+
+}
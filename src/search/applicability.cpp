@@ -95,14 +95,7 @@ bool is_statically_applicable(GroundConjunctiveCondition conjunctive_condition)
 static bool
 is_applicable(GroundConjunctiveCondition conjunctive_condition, const FlatDoubleList& static_numeric_variables, const FlatDoubleList& fluent_numeric_variables)
 {
-    for (const auto& constraint : conjunctive_condition->get_numeric_constraints())
-    {
-        if (!evaluate(constraint, static_numeric_variables, fluent_numeric_variables))
-        {
-            return false;
-        }
-    }
-    return true;
+    return conjunctive_condition->get_numeric_constraint_bytecode().holds(static_numeric_variables, fluent_numeric_variables);
 }
 
 bool is_dynamically_applicable(GroundConjunctiveCondition conjunctive_condition, const UnpackedStateImpl& unpacked_state)
@@ -164,7 +157,7 @@ static bool is_applicable(GroundNumericEffect<FluentTag> effect,
         return false;
     }
 
-    return (evaluate(effect->get_function_expression(), static_numeric_variables, fluent_numeric_variables) != UNDEFINED_CONTINUOUS_COST);
+    return (effect->get_bytecode().evaluate(static_numeric_variables, fluent_numeric_variables) != UNDEFINED_CONTINUOUS_COST);
 }
 
 static bool is_applicable(GroundNumericEffect<AuxiliaryTag> effect,
@@ -180,7 +173,7 @@ static bool is_applicable(GroundNumericEffect<AuxiliaryTag> effect,
     recorded_change = effect->get_assign_operator();
 
     // For auxiliary total-cost, we assume it is well-defined in the initial state.
-    return (evaluate(effect->get_function_expression(), static_numeric_variables, fluent_numeric_variables) != UNDEFINED_CONTINUOUS_COST);
+    return (effect->get_bytecode().evaluate(static_numeric_variables, fluent_numeric_variables) != UNDEFINED_CONTINUOUS_COST);
 }
 
 /// @brief Return true iff the fluent numeric effects are applicable, i.e., all numeric effects are well-defined.
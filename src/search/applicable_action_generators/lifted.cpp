@@ -47,8 +47,6 @@ LiftedApplicableActionGeneratorImpl::LiftedApplicableActionGeneratorImpl(Problem
     m_problem(problem),
     m_event_handler(event_handler ? std::move(event_handler) : DefaultEventHandlerImpl::create()),
     m_action_grounding_data(),
-    m_fluent_atoms(),
-    m_derived_atoms(),
     m_fluent_functions(),
     m_fluent_assignment_set(m_problem->get_problem_and_domain_objects().size(), m_problem->get_domain()->get_predicates<FluentTag>()),
     m_derived_assignment_set(m_problem->get_problem_and_domain_objects().size(), m_problem->get_problem_and_domain_derived_predicates()),
@@ -79,13 +77,8 @@ mimir::generator<GroundAction> LiftedApplicableActionGeneratorImpl::create_appli
     const auto& problem = *m_problem;
     const auto& pddl_repositories = problem.get_repositories();
 
-    pddl_repositories.get_ground_atoms_from_indices(dense_fluent_atoms, m_fluent_atoms);
-    m_fluent_assignment_set.reset();
-    m_fluent_assignment_set.insert_ground_atoms(m_fluent_atoms);
-
-    pddl_repositories.get_ground_atoms_from_indices(dense_derived_atoms, m_derived_atoms);
-    m_derived_assignment_set.reset();
-    m_derived_assignment_set.insert_ground_atoms(m_derived_atoms);
+    m_fluent_assignment_set.update_ground_atoms(dense_fluent_atoms, pddl_repositories);
+    m_derived_assignment_set.update_ground_atoms(dense_derived_atoms, pddl_repositories);
 
     m_numeric_assignment_set.reset();
     pddl_repositories.get_ground_functions(dense_numeric_variables.size(), m_fluent_functions);
@@ -19,6 +19,10 @@
 
 #include "mimir/formalism/axiom.hpp"
 #include "mimir/formalism/domain.hpp"
+#include "mimir/formalism/ground_atom.hpp"
+#include "mimir/formalism/ground_axiom.hpp"
+#include "mimir/formalism/ground_conjunctive_condition.hpp"
+#include "mimir/formalism/ground_literal.hpp"
 #include "mimir/formalism/literal.hpp"
 #include "mimir/formalism/problem.hpp"
 #include "mimir/formalism/repositories.hpp"
@@ -27,6 +31,8 @@
 #include "mimir/search/axiom_evaluators/grounded/event_handlers/interface.hpp"
 #include "mimir/search/state_unpacked.hpp"
 
+#include <algorithm>
+
 using namespace mimir::formalism;
 
 namespace mimir::search
@@ -41,8 +47,43 @@ GroundedAxiomEvaluatorImpl::GroundedAxiomEvaluatorImpl(Problem problem,
                                                        EventHandler event_handler) :
     m_problem(std::move(problem)),
     m_match_tree_partitioning(std::move(match_tree_partitioning)),
-    m_event_handler(std::move(event_handler))
+    m_event_handler(std::move(event_handler)),
+    m_occurrences(),
+    m_has_numeric_constraints(false),
+    m_overdeleted_atoms(),
+    m_inserted_atoms(),
+    m_added_derived_atoms(),
+    m_deleted_derived_atoms()
 {
+    for (const auto& match_tree : m_match_tree_partitioning)
+    {
+        auto& occurrences = m_occurrences.emplace_back();
+
+        for (const auto& ground_axiom : match_tree->get_elements())
+        {
+            const auto conjunctive_condition = ground_axiom->get_conjunctive_condition();
+
+            for (const auto atom_index : conjunctive_condition->get_precondition<PositiveTag, FluentTag>())
+            {
+                occurrences.positive_fluent[atom_index].push_back(ground_axiom);
+            }
+            for (const auto atom_index : conjunctive_condition->get_precondition<NegativeTag, FluentTag>())
+            {
+                occurrences.negative_fluent[atom_index].push_back(ground_axiom);
+            }
+            for (const auto atom_index : conjunctive_condition->get_precondition<PositiveTag, DerivedTag>())
+            {
+                occurrences.positive_derived[atom_index].push_back(ground_axiom);
+            }
+            for (const auto atom_index : conjunctive_condition->get_precondition<NegativeTag, DerivedTag>())
+            {
+                occurrences.negative_derived[atom_index].push_back(ground_axiom);
+            }
+            occurrences.head[ground_axiom->get_literal()->get_atom()->get_index()].push_back(ground_axiom);
+
+            m_has_numeric_constraints |= !conjunctive_condition->get_numeric_constraints().empty();
+        }
+    }
 }
 
 GroundedAxiomEvaluator GroundedAxiomEvaluatorImpl::create(Problem problem, match_tree::MatchTreeList<GroundAxiomImpl>&& match_tree_partitioning)
@@ -100,6 +141,164 @@ void GroundedAxiomEvaluatorImpl::generate_and_apply_axioms(UnpackedStateImpl& un
     }
 }
 
+void GroundedAxiomEvaluatorImpl::overdelete_atoms(const AtomToGroundAxioms& atom_to_axioms,
+                                                  Index atom_index,
+                                                  const UnpackedStateImpl& parent_unpacked_state,
+                                                  UnpackedStateImpl& unpacked_state)
+{
+    auto& dense_derived_atoms = unpacked_state.get_atoms<DerivedTag>();
+
+    const auto it = atom_to_axioms.find(atom_index);
+    if (it == atom_to_axioms.end())
+    {
+        return;
+    }
+
+    for (const auto& grounded_axiom : it->second)
+    {
+        if (!is_applicable(grounded_axiom, parent_unpacked_state))
+        {
+            continue;
+        }
+
+        const auto grounded_atom_index = grounded_axiom->get_literal()->get_atom()->get_index();
+        assert(parent_unpacked_state.get_atoms<DerivedTag>().get(grounded_atom_index));
+
+        if (dense_derived_atoms.get(grounded_atom_index))
+        {
+            dense_derived_atoms.unset(grounded_atom_index);
+            m_overdeleted_atoms.push_back(grounded_atom_index);
+        }
+    }
+}
+
+void GroundedAxiomEvaluatorImpl::insert_atoms(const AtomToGroundAxioms& atom_to_axioms, Index atom_index, UnpackedStateImpl& unpacked_state)
+{
+    auto& dense_derived_atoms = unpacked_state.get_atoms<DerivedTag>();
+
+    const auto it = atom_to_axioms.find(atom_index);
+    if (it == atom_to_axioms.end())
+    {
+        return;
+    }
+
+    for (const auto& grounded_axiom : it->second)
+    {
+        const auto grounded_atom_index = grounded_axiom->get_literal()->get_atom()->get_index();
+
+        if (!dense_derived_atoms.get(grounded_atom_index) && is_applicable(grounded_axiom, unpacked_state))
+        {
+            dense_derived_atoms.set(grounded_atom_index);
+            m_inserted_atoms.push_back(grounded_atom_index);
+        }
+    }
+}
+
+void GroundedAxiomEvaluatorImpl::update_and_apply_axioms(const UnpackedStateImpl& parent_unpacked_state,
+                                                         const IndexList& added_fluent_atoms,
+                                                         const IndexList& deleted_fluent_atoms,
+                                                         UnpackedStateImpl& unpacked_state)
+{
+    const auto& parent_derived_atoms = parent_unpacked_state.get_atoms<DerivedTag>();
+    auto& dense_derived_atoms = unpacked_state.get_atoms<DerivedTag>();
+
+    // Changes of numeric variables cannot be attributed to atoms, so we evaluate all axioms from scratch.
+    const auto& parent_numeric_variables = parent_unpacked_state.get_numeric_variables();
+    const auto& numeric_variables = unpacked_state.get_numeric_variables();
+    if (m_has_numeric_constraints
+        && !std::equal(parent_numeric_variables.begin(), parent_numeric_variables.end(), numeric_variables.begin(), numeric_variables.end()))
+    {
+        dense_derived_atoms.unset_all();
+        generate_and_apply_axioms(unpacked_state);
+        return;
+    }
+
+    dense_derived_atoms = parent_derived_atoms;
+
+    m_added_derived_atoms.clear();
+    m_deleted_derived_atoms.clear();
+
+    for (const auto& occurrences : m_occurrences)
+    {
+        m_overdeleted_atoms.clear();
+        m_inserted_atoms.clear();
+
+        /* 1. Delete the atoms with a derivation in the parent state that depends on a deleted atom in a positive literal,
+              or on an added atom in a negative literal, and close the deleted atoms under the positive literals of the partition. */
+
+        for (const auto atom_index : deleted_fluent_atoms)
+        {
+            overdelete_atoms(occurrences.positive_fluent, atom_index, parent_unpacked_state, unpacked_state);
+        }
+        for (const auto atom_index : added_fluent_atoms)
+        {
+            overdelete_atoms(occurrences.negative_fluent, atom_index, parent_unpacked_state, unpacked_state);
+        }
+        for (const auto atom_index : m_deleted_derived_atoms)
+        {
+            overdelete_atoms(occurrences.positive_derived, atom_index, parent_unpacked_state, unpacked_state);
+        }
+        for (const auto atom_index : m_added_derived_atoms)
+        {
+            overdelete_atoms(occurrences.negative_derived, atom_index, parent_unpacked_state, unpacked_state);
+        }
+        for (size_t i = 0; i < m_overdeleted_atoms.size(); ++i)
+        {
+            overdelete_atoms(occurrences.positive_derived, m_overdeleted_atoms[i], parent_unpacked_state, unpacked_state);
+        }
+
+        /* 2. Rederive the deleted atoms that have a derivation from the remaining atoms. */
+
+        for (const auto atom_index : m_overdeleted_atoms)
+        {
+            insert_atoms(occurrences.head, atom_index, unpacked_state);
+        }
+
+        /* 3. Insert the atoms with a derivation that depends on an added atom in a positive literal, or on a deleted atom in a negative literal. */
+
+        for (const auto atom_index : added_fluent_atoms)
+        {
+            insert_atoms(occurrences.positive_fluent, atom_index, unpacked_state);
+        }
+        for (const auto atom_index : deleted_fluent_atoms)
+        {
+            insert_atoms(occurrences.negative_fluent, atom_index, unpacked_state);
+        }
+        for (const auto atom_index : m_added_derived_atoms)
+        {
+            insert_atoms(occurrences.positive_derived, atom_index, unpacked_state);
+        }
+        for (const auto atom_index : m_deleted_derived_atoms)
+        {
+            insert_atoms(occurrences.negative_derived, atom_index, unpacked_state);
+        }
+
+        /* 4. Propagate the inserted atoms through the positive literals of the partition. */
+
+        for (size_t i = 0; i < m_inserted_atoms.size(); ++i)
+        {
+            insert_atoms(occurrences.positive_derived, m_inserted_atoms[i], unpacked_state);
+        }
+
+        /* 5. Collect the changes for the higher partitions. */
+
+        for (const auto atom_index : m_inserted_atoms)
+        {
+            if (!parent_derived_atoms.get(atom_index))
+            {
+                m_added_derived_atoms.push_back(atom_index);
+            }
+        }
+        for (const auto atom_index : m_overdeleted_atoms)
+        {
+            if (!dense_derived_atoms.get(atom_index))
+            {
+                m_deleted_derived_atoms.push_back(atom_index);
+            }
+        }
+    }
+}
+
 void GroundedAxiomEvaluatorImpl::on_finish_search_layer() { m_event_handler->on_finish_search_layer(); }
 
 void GroundedAxiomEvaluatorImpl::on_end_search() { m_event_handler->on_end_search(); }
@@ -17,16 +17,28 @@
 
 #include "mimir/search/axiom_evaluators/lifted.hpp"
 
+#include "mimir/formalism/atom.hpp"
+#include "mimir/formalism/axiom.hpp"
 #include "mimir/formalism/conjunctive_condition.hpp"
 #include "mimir/formalism/domain.hpp"
+#include "mimir/formalism/ground_atom.hpp"
 #include "mimir/formalism/ground_axiom.hpp"
+#include "mimir/formalism/ground_literal.hpp"
+#include "mimir/formalism/literal.hpp"
+#include "mimir/formalism/object.hpp"
+#include "mimir/formalism/predicate.hpp"
 #include "mimir/formalism/problem.hpp"
 #include "mimir/formalism/repositories.hpp"
+#include "mimir/formalism/term.hpp"
+#include "mimir/formalism/utils.hpp"
+#include "mimir/formalism/variable.hpp"
 #include "mimir/search/applicability.hpp"
 #include "mimir/search/axiom_evaluators/lifted/event_handlers/default.hpp"
 #include "mimir/search/axiom_evaluators/lifted/event_handlers/interface.hpp"
 #include "mimir/search/state_unpacked.hpp"
 
+#include <algorithm>
+
 using namespace mimir::formalism;
 
 namespace mimir::search
@@ -35,16 +47,68 @@ namespace mimir::search
  * LiftedAxiomEvaluator
  */
 
+/// @brief Compute the derived predicates whose atoms only depend on static atoms as the greatest fixed point,
+/// i.e., the bodies of all their axioms have no fluent literals, no numeric constraints, and only derived literals over such predicates.
+static PredicateSet<DerivedTag> compute_static_derived_predicates(const ProblemImpl& problem)
+{
+    const auto& derived_predicates = problem.get_problem_and_domain_derived_predicates();
+    auto static_predicates = PredicateSet<DerivedTag>(derived_predicates.begin(), derived_predicates.end());
+
+    auto changed = true;
+    while (changed)
+    {
+        changed = false;
+        for (const auto& axiom : problem.get_problem_and_domain_axioms())
+        {
+            const auto head_predicate = axiom->get_literal()->get_atom()->get_predicate();
+            if (!static_predicates.count(head_predicate))
+            {
+                continue;
+            }
+
+            const auto& conjunctive_condition = axiom->get_conjunctive_condition();
+            const auto& derived_literals = conjunctive_condition->get_literals<DerivedTag>();
+            if (!conjunctive_condition->get_literals<FluentTag>().empty() || !conjunctive_condition->get_numeric_constraints().empty()
+                || std::any_of(derived_literals.begin(),
+                               derived_literals.end(),
+                               [&](auto&& literal) { return !static_predicates.count(literal->get_atom()->get_predicate()); }))
+            {
+                static_predicates.erase(head_predicate);
+                changed = true;
+            }
+        }
+    }
+
+    return static_predicates;
+}
+
 LiftedAxiomEvaluatorImpl::LiftedAxiomEvaluatorImpl(Problem problem, EventHandler event_handler) :
     m_problem(problem),
     m_event_handler(event_handler ? std::move(event_handler) : DefaultEventHandlerImpl::create()),
     m_condition_grounders(),
-    m_fluent_atoms(),
-    m_derived_atoms(),
+    m_triggers(),
+    m_is_static_axiom(),
+    m_has_static_atoms(false),
+    m_static_atoms(m_problem->get_problem_and_domain_axiom_partitioning().size()),
     m_fluent_functions(),
     m_fluent_assignment_set(m_problem->get_problem_and_domain_objects().size(), m_problem->get_domain()->get_predicates<FluentTag>()),
     m_derived_assignment_set(m_problem->get_problem_and_domain_objects().size(), m_problem->get_problem_and_domain_derived_predicates()),
-    m_numeric_assignment_set(m_problem->get_problem_and_domain_objects().size(), m_problem->get_domain()->get_function_skeletons<FluentTag>())
+    m_numeric_assignment_set(m_problem->get_problem_and_domain_objects().size(), m_problem->get_domain()->get_function_skeletons<FluentTag>()),
+    m_occurrences(),
+    m_body_fluent_predicates(),
+    m_has_numeric_constraints(false),
+    m_applicable_axioms(),
+    m_applicable_axiom_set(),
+    m_delta_atoms(),
+    m_partial_binding(),
+    m_parent_fluent_assignment_set(m_problem->get_problem_and_domain_objects().size(), m_problem->get_domain()->get_predicates<FluentTag>()),
+    m_parent_derived_assignment_set(m_problem->get_problem_and_domain_objects().size(), m_problem->get_problem_and_domain_derived_predicates()),
+    m_has_parent_assignment_sets(false),
+    m_added_fluent_atoms(),
+    m_deleted_fluent_atoms(),
+    m_added_derived_atoms(),
+    m_deleted_derived_atoms(),
+    m_overdeleted_atoms()
 {
     /* 3. Initialize condition grounders */
     const auto& axioms = m_problem->get_problem_and_domain_axioms();
@@ -54,6 +118,62 @@ LiftedAxiomEvaluatorImpl::LiftedAxiomEvaluatorImpl(Problem problem, EventHandler
         assert(axiom->get_index() == i);
         m_condition_grounders.emplace_back(AxiomSatisficingBindingGenerator(axiom, m_problem));
     }
+
+    /* 4. Initialize static axioms */
+    const auto static_predicates = compute_static_derived_predicates(*m_problem);
+    for (const auto& axiom : axioms)
+    {
+        m_is_static_axiom.push_back(static_predicates.count(axiom->get_literal()->get_atom()->get_predicate()));
+    }
+
+    /* 5. Initialize triggers: only positive body literals over head predicates of the same partition can be satisfied by new atoms. */
+    for (const auto& partition : m_problem->get_problem_and_domain_axiom_partitioning())
+    {
+        auto head_predicates = PredicateSet<DerivedTag> {};
+        for (const auto& axiom : partition.get_axioms())
+        {
+            head_predicates.insert(axiom->get_literal()->get_atom()->get_predicate());
+        }
+
+        auto& triggers = m_triggers.emplace_back();
+        for (const auto& axiom : partition.get_axioms())
+        {
+            for (const auto& literal : axiom->get_conjunctive_condition()->get_literals<DerivedTag>())
+            {
+                if (literal->get_polarity() && head_predicates.count(literal->get_atom()->get_predicate()))
+                {
+                    triggers[literal->get_atom()->get_predicate()].push_back(Trigger { axiom, literal });
+                }
+            }
+        }
+    }
+
+    /* 6. Initialize occurrences: static axioms do not depend on changed atoms. */
+    for (const auto& partition : m_problem->get_problem_and_domain_axiom_partitioning())
+    {
+        auto& occurrences = m_occurrences.emplace_back();
+        for (const auto& axiom : partition.get_axioms())
+        {
+            if (m_is_static_axiom[axiom->get_index()])
+            {
+                continue;
+            }
+
+            const auto& conjunctive_condition = axiom->get_conjunctive_condition();
+            for (const auto& literal : conjunctive_condition->get_literals<FluentTag>())
+            {
+                occurrences.fluent[literal->get_atom()->get_predicate()].push_back(Occurrence<FluentTag> { axiom, literal });
+                m_body_fluent_predicates.insert(literal->get_atom()->get_predicate());
+            }
+            for (const auto& literal : conjunctive_condition->get_literals<DerivedTag>())
+            {
+                occurrences.derived[literal->get_atom()->get_predicate()].push_back(Occurrence<DerivedTag> { axiom, literal });
+            }
+            occurrences.head[axiom->get_literal()->get_atom()->get_predicate()].push_back(axiom);
+
+            m_has_numeric_constraints |= !conjunctive_condition->get_numeric_constraints().empty();
+        }
+    }
 }
 
 LiftedAxiomEvaluator LiftedAxiomEvaluatorImpl::create(Problem problem, EventHandler event_handler)
@@ -62,6 +182,115 @@ LiftedAxiomEvaluator LiftedAxiomEvaluatorImpl::create(Problem problem, EventHand
         new LiftedAxiomEvaluatorImpl(std::move(problem), event_handler ? std::move(event_handler) : DefaultEventHandlerImpl::create()));
 }
 
+bool LiftedAxiomEvaluatorImpl::is_compiled_away(Axiom axiom) const { return m_has_static_atoms && m_is_static_axiom[axiom->get_index()]; }
+
+void LiftedAxiomEvaluatorImpl::collect_applicable_axiom(Axiom axiom, ObjectList binding)
+{
+    const auto& ground_axiom_repository = boost::hana::at_key(m_problem->get_repositories().get_hana_repositories(), boost::hana::type<GroundAxiomImpl> {});
+
+    const auto num_ground_axioms = ground_axiom_repository.size();
+
+    const auto ground_axiom = m_problem->ground(axiom, std::move(binding));
+
+    if (!m_applicable_axiom_set.insert(ground_axiom).second)
+    {
+        return;  ///< Several new atoms can satisfy the body of the same ground axiom.
+    }
+
+    m_event_handler->on_ground_axiom(ground_axiom);
+
+    (ground_axiom_repository.size() > num_ground_axioms) ? m_event_handler->on_ground_axiom_cache_miss(ground_axiom) :
+                                                           m_event_handler->on_ground_axiom_cache_hit(ground_axiom);
+
+    m_applicable_axioms.emplace_back(ground_axiom);
+}
+
+void LiftedAxiomEvaluatorImpl::apply_applicable_axioms(size_t partition_index, UnpackedStateImpl& unpacked_state)
+{
+    auto& dense_derived_atoms = unpacked_state.get_atoms<DerivedTag>();
+    const auto& pddl_repositories = m_problem->get_repositories();
+
+    for (const auto& grounded_axiom : m_applicable_axioms)
+    {
+        assert(grounded_axiom->get_literal()->get_polarity());
+        assert(is_applicable(grounded_axiom, unpacked_state));
+
+        const auto grounded_atom_index = grounded_axiom->get_literal()->get_atom()->get_index();
+
+        if (!dense_derived_atoms.get(grounded_atom_index))
+        {
+            // GENERATED NEW DERIVED ATOM!
+            const auto new_ground_atom = pddl_repositories.get_ground_atom<DerivedTag>(grounded_atom_index);
+
+            // Update the assignment set
+            m_derived_assignment_set.insert_ground_atom(new_ground_atom);
+            dense_derived_atoms.set(grounded_atom_index);
+
+            m_delta_atoms.push_back(new_ground_atom);
+
+            if (!m_has_static_atoms && m_is_static_axiom[grounded_axiom->get_axiom()->get_index()])
+            {
+                m_static_atoms[partition_index].push_back(new_ground_atom);
+            }
+        }
+    }
+
+    m_applicable_axioms.clear();
+    m_applicable_axiom_set.clear();
+}
+
+void LiftedAxiomEvaluatorImpl::apply_triggered_axioms(size_t partition_index, UnpackedStateImpl& unpacked_state)
+{
+    const auto& static_numeric_assignment_set = m_problem->get_static_initial_numeric_assignment_set();
+
+    // Optimization 2: Semi-naive evaluation, i.e., every binding that becomes applicable must satisfy a positive body literal with a new atom.
+    // Hence, we only enumerate the bindings of the axioms that bind such a literal to a new atom in the delta-restricted consistency graph.
+    // The delta of a round are the atoms appended to `m_delta_atoms` in the previous round.
+    auto delta_begin = size_t(0);
+    while (delta_begin < m_delta_atoms.size())
+    {
+        const auto delta_end = m_delta_atoms.size();
+        for (auto i = delta_begin; i < delta_end; ++i)
+        {
+            const auto ground_atom = m_delta_atoms[i];
+
+            const auto it = m_triggers[partition_index].find(ground_atom->get_predicate());
+            if (it == m_triggers[partition_index].end())
+            {
+                continue;
+            }
+
+            for (const auto& [axiom, literal] : it->second)
+            {
+                if (is_compiled_away(axiom) || !nullary_conditions_hold(axiom->get_conjunctive_condition(), unpacked_state))
+                {
+                    continue;
+                }
+
+                m_partial_binding.resize(axiom->get_conjunctive_condition()->get_arity());
+                if (!unify(literal, ground_atom, m_partial_binding))
+                {
+                    continue;
+                }
+
+                for (auto&& binding : m_condition_grounders.at(axiom->get_index())
+                                          .create_binding_generator(unpacked_state,
+                                                                    m_fluent_assignment_set,
+                                                                    m_derived_assignment_set,
+                                                                    static_numeric_assignment_set,
+                                                                    m_numeric_assignment_set,
+                                                                    m_partial_binding))
+                {
+                    collect_applicable_axiom(axiom, std::move(binding));
+                }
+            }
+        }
+
+        delta_begin = delta_end;
+        apply_applicable_axioms(partition_index, unpacked_state);
+    }
+}
+
 void LiftedAxiomEvaluatorImpl::generate_and_apply_axioms(UnpackedStateImpl& unpacked_state)
 {
     const auto& dense_fluent_atoms = unpacked_state.get_atoms<FluentTag>();
@@ -75,13 +304,8 @@ void LiftedAxiomEvaluatorImpl::generate_and_apply_axioms(UnpackedStateImpl& unpa
     const auto& problem = *m_problem;
     const auto& pddl_repositories = problem.get_repositories();
 
-    pddl_repositories.get_ground_atoms_from_indices(dense_fluent_atoms, m_fluent_atoms);
-    m_fluent_assignment_set.reset();
-    m_fluent_assignment_set.insert_ground_atoms(m_fluent_atoms);
-
-    pddl_repositories.get_ground_atoms_from_indices(dense_derived_atoms, m_derived_atoms);
-    m_derived_assignment_set.reset();
-    m_derived_assignment_set.insert_ground_atoms(m_derived_atoms);
+    m_fluent_assignment_set.update_ground_atoms(dense_fluent_atoms, pddl_repositories);
+    m_derived_assignment_set.update_ground_atoms(dense_derived_atoms, pddl_repositories);
 
     m_numeric_assignment_set.reset();
     pddl_repositories.get_ground_functions(dense_numeric_variables.size(), m_fluent_functions);
@@ -91,83 +315,319 @@ void LiftedAxiomEvaluatorImpl::generate_and_apply_axioms(UnpackedStateImpl& unpa
 
     /* 2. Fixed point computation */
 
-    const auto& ground_axiom_repository = boost::hana::at_key(problem.get_repositories().get_hana_repositories(), boost::hana::type<GroundAxiomImpl> {});
+    const auto& partitioning = problem.get_problem_and_domain_axiom_partitioning();
+
+    for (size_t partition_index = 0; partition_index < partitioning.size(); ++partition_index)
+    {
+        const auto& partition = partitioning[partition_index];
 
-    auto applicable_axioms = GroundAxiomList {};
+        m_delta_atoms.clear();
 
-    for (const auto& partition : problem.get_problem_and_domain_axiom_partitioning())
+        // Optimization 4: The atoms of static axioms are state-independent, so we insert the atoms from the first evaluation instead.
+        // They are new atoms that can trigger the other axioms of the partition.
+        if (m_has_static_atoms)
+        {
+            for (const auto& ground_atom : m_static_atoms[partition_index])
+            {
+                if (!dense_derived_atoms.get(ground_atom->get_index()))
+                {
+                    m_derived_assignment_set.insert_ground_atom(ground_atom);
+                    dense_derived_atoms.set(ground_atom->get_index());
+                    m_delta_atoms.push_back(ground_atom);
+                }
+            }
+        }
+
+        // Optimization 3: Only the axioms without derived body literals of the partition can be applicable initially.
+        for (const auto& axiom : partition.get_initially_relevant_axioms())
+        {
+            // We move this check here to avoid unnecessary creations of mimir::generator.
+            if (is_compiled_away(axiom) || !nullary_conditions_hold(axiom->get_conjunctive_condition(), unpacked_state))
+            {
+                continue;
+            }
+
+            for (auto&& binding : m_condition_grounders.at(axiom->get_index())
+                                      .create_binding_generator(unpacked_state,
+                                                                m_fluent_assignment_set,
+                                                                m_derived_assignment_set,
+                                                                static_numeric_assignment_set,
+                                                                m_numeric_assignment_set))
+            {
+                collect_applicable_axiom(axiom, std::move(binding));
+            }
+        }
+        apply_applicable_axioms(partition_index, unpacked_state);
+
+        apply_triggered_axioms(partition_index, unpacked_state);
+    }
+
+    m_has_static_atoms = true;
+
+    m_event_handler->on_end_generating_applicable_axioms();
+}
+
+template<IsFluentOrDerivedTag P>
+void LiftedAxiomEvaluatorImpl::overdelete_atoms(const OccurrenceMap<P>& occurrences,
+                                                GroundAtom<P> ground_atom,
+                                                bool polarity,
+                                                const UnpackedStateImpl& parent_unpacked_state,
+                                                UnpackedStateImpl& unpacked_state)
+{
+    const auto it = occurrences.find(ground_atom->get_predicate());
+    if (it == occurrences.end())
     {
-        bool reached_partition_fixed_point;
+        return;
+    }
 
-        // TODO: Optimization 4: Inductively compile away axioms with static bodies. (grounded in match tree?)
+    const auto& problem = *m_problem;
+    const auto& pddl_repositories = problem.get_repositories();
+    const auto& parent_derived_atoms = parent_unpacked_state.get_atoms<DerivedTag>();
+    auto& dense_derived_atoms = unpacked_state.get_atoms<DerivedTag>();
 
-        // Optimization 2: Track axioms that might trigger in next iteration.
-        // Optimization 3: Use precomputed set of axioms that might be applicable initially
-        auto relevant_axioms = partition.get_initially_relevant_axioms();
+    if (!m_has_parent_assignment_sets)
+    {
+        m_parent_fluent_assignment_set.update_ground_atoms(parent_unpacked_state.get_atoms<FluentTag>(), pddl_repositories);
+        m_parent_derived_assignment_set.update_ground_atoms(parent_derived_atoms, pddl_repositories);
+        m_has_parent_assignment_sets = true;
+    }
 
-        do
+    for (const auto& [axiom, literal] : it->second)
+    {
+        if (literal->get_polarity() != polarity || !nullary_conditions_hold(axiom->get_conjunctive_condition(), parent_unpacked_state))
         {
-            reached_partition_fixed_point = true;
+            continue;
+        }
 
-            /* Compute applicable axioms */
+        m_partial_binding.resize(axiom->get_conjunctive_condition()->get_arity());
+        if (!unify(literal, ground_atom, m_partial_binding))
+        {
+            continue;
+        }
+
+        for (auto&& binding : m_condition_grounders.at(axiom->get_index())
+                                  .create_binding_generator(parent_unpacked_state,
+                                                            m_parent_fluent_assignment_set,
+                                                            m_parent_derived_assignment_set,
+                                                            problem.get_static_initial_numeric_assignment_set(),
+                                                            m_numeric_assignment_set,
+                                                            m_partial_binding))
+        {
+            const auto head_atom = m_problem->ground(axiom->get_literal(), binding)->get_atom();
+            assert(parent_derived_atoms.get(head_atom->get_index()));
 
-            applicable_axioms.clear();
-            for (const auto& axiom : relevant_axioms)
+            if (dense_derived_atoms.get(head_atom->get_index()))
             {
-                // We move this check here to avoid unnecessary creations of mimir::generator.
-                if (!nullary_conditions_hold(axiom->get_conjunctive_condition(), unpacked_state))
-                {
-                    continue;
-                }
+                dense_derived_atoms.unset(head_atom->get_index());
+                m_overdeleted_atoms.push_back(head_atom);
+            }
+        }
+    }
+}
 
-                auto& condition_grounder = m_condition_grounders.at(axiom->get_index());
+template<IsFluentOrDerivedTag P>
+void LiftedAxiomEvaluatorImpl::collect_inserted_axioms(const OccurrenceMap<P>& occurrences,
+                                                       GroundAtom<P> ground_atom,
+                                                       bool polarity,
+                                                       UnpackedStateImpl& unpacked_state)
+{
+    const auto it = occurrences.find(ground_atom->get_predicate());
+    if (it == occurrences.end())
+    {
+        return;
+    }
 
-                for (auto&& binding : condition_grounder.create_binding_generator(unpacked_state,
-                                                                                  m_fluent_assignment_set,
-                                                                                  m_derived_assignment_set,
-                                                                                  static_numeric_assignment_set,
-                                                                                  m_numeric_assignment_set))
-                {
-                    const auto num_ground_axioms = ground_axiom_repository.size();
+    for (const auto& [axiom, literal] : it->second)
+    {
+        if (literal->get_polarity() != polarity || !nullary_conditions_hold(axiom->get_conjunctive_condition(), unpacked_state))
+        {
+            continue;
+        }
+
+        m_partial_binding.resize(axiom->get_conjunctive_condition()->get_arity());
+        if (!unify(literal, ground_atom, m_partial_binding))
+        {
+            continue;
+        }
+
+        for (auto&& binding : m_condition_grounders.at(axiom->get_index())
+                                  .create_binding_generator(unpacked_state,
+                                                            m_fluent_assignment_set,
+                                                            m_derived_assignment_set,
+                                                            m_problem->get_static_initial_numeric_assignment_set(),
+                                                            m_numeric_assignment_set,
+                                                            m_partial_binding))
+        {
+            collect_applicable_axiom(axiom, std::move(binding));
+        }
+    }
+}
+
+void LiftedAxiomEvaluatorImpl::collect_rederiving_axiom(const Occurrences& occurrences,
+                                                        GroundAtom<DerivedTag> ground_atom,
+                                                        UnpackedStateImpl& unpacked_state)
+{
+    const auto it = occurrences.head.find(ground_atom->get_predicate());
+    if (it == occurrences.head.end())
+    {
+        return;
+    }
+
+    for (const auto& axiom : it->second)
+    {
+        if (!nullary_conditions_hold(axiom->get_conjunctive_condition(), unpacked_state))
+        {
+            continue;
+        }
 
-                    const auto ground_axiom = m_problem->ground(axiom, std::move(binding));
+        m_partial_binding.resize(axiom->get_conjunctive_condition()->get_arity());
+        if (!unify(axiom->get_literal(), ground_atom, m_partial_binding))
+        {
+            continue;
+        }
+
+        for (auto&& binding : m_condition_grounders.at(axiom->get_index())
+                                  .create_binding_generator(unpacked_state,
+                                                            m_fluent_assignment_set,
+                                                            m_derived_assignment_set,
+                                                            m_problem->get_static_initial_numeric_assignment_set(),
+                                                            m_numeric_assignment_set,
+                                                            m_partial_binding))
+        {
+            collect_applicable_axiom(axiom, std::move(binding));
+            return;  ///< A single derivation suffices.
+        }
+    }
+}
 
-                    assert(is_applicable(ground_axiom, unpacked_state));
+void LiftedAxiomEvaluatorImpl::update_and_apply_axioms(const UnpackedStateImpl& parent_unpacked_state,
+                                                       const IndexList& added_fluent_atoms,
+                                                       const IndexList& deleted_fluent_atoms,
+                                                       UnpackedStateImpl& unpacked_state)
+{
+    const auto& problem = *m_problem;
+    const auto& pddl_repositories = problem.get_repositories();
+    const auto& parent_derived_atoms = parent_unpacked_state.get_atoms<DerivedTag>();
+    auto& dense_derived_atoms = unpacked_state.get_atoms<DerivedTag>();
+    auto& dense_numeric_variables = unpacked_state.get_numeric_variables();
 
-                    m_event_handler->on_ground_axiom(ground_axiom);
+    // Changes of numeric variables cannot be attributed to atoms, so we evaluate all axioms from scratch.
+    // The same holds for the first evaluation, which derives the atoms of the static axioms.
+    const auto& parent_numeric_variables = parent_unpacked_state.get_numeric_variables();
+    if (!m_has_static_atoms
+        || (m_has_numeric_constraints
+            && !std::equal(parent_numeric_variables.begin(), parent_numeric_variables.end(), dense_numeric_variables.begin(), dense_numeric_variables.end())))
+    {
+        dense_derived_atoms.unset_all();
+        generate_and_apply_axioms(unpacked_state);
+        return;
+    }
 
-                    (ground_axiom_repository.size() > num_ground_axioms) ? m_event_handler->on_ground_axiom_cache_miss(ground_axiom) :
-                                                                           m_event_handler->on_ground_axiom_cache_hit(ground_axiom);
+    dense_derived_atoms = parent_derived_atoms;
 
-                    applicable_axioms.emplace_back(ground_axiom);
-                }
-            }
+    /* 1. Skip the evaluation if no changed atom occurs in an axiom body. */
 
-            /* Apply applicable axioms */
+    pddl_repositories.get_ground_atoms_from_indices(added_fluent_atoms, m_added_fluent_atoms);
+    pddl_repositories.get_ground_atoms_from_indices(deleted_fluent_atoms, m_deleted_fluent_atoms);
 
-            relevant_axioms.clear();
+    const auto occurs_in_body = [&](auto&& ground_atom) { return m_body_fluent_predicates.count(ground_atom->get_predicate()); };
+    if (std::none_of(m_added_fluent_atoms.begin(), m_added_fluent_atoms.end(), occurs_in_body)
+        && std::none_of(m_deleted_fluent_atoms.begin(), m_deleted_fluent_atoms.end(), occurs_in_body))
+    {
+        return;
+    }
 
-            for (const auto& grounded_axiom : applicable_axioms)
-            {
-                assert(grounded_axiom->get_literal()->get_polarity());
+    /* 2. Initialize assignment sets */
 
-                const auto grounded_atom_index = grounded_axiom->get_literal()->get_atom()->get_index();
+    m_event_handler->on_start_generating_applicable_axioms();
 
-                if (!dense_derived_atoms.get(grounded_atom_index))
-                {
-                    // GENERATED NEW DERIVED ATOM!
-                    const auto new_ground_atom = pddl_repositories.get_ground_atom<DerivedTag>(grounded_atom_index);
-                    reached_partition_fixed_point = false;
+    // The derived assignment set keeps the deleted atoms, which only weakens the pruning of the consistency graphs.
+    m_fluent_assignment_set.update_ground_atoms(unpacked_state.get_atoms<FluentTag>(), pddl_repositories);
+    m_derived_assignment_set.update_ground_atoms(dense_derived_atoms, pddl_repositories);
+    m_has_parent_assignment_sets = false;
 
-                    // Update the assignment set
-                    m_derived_assignment_set.insert_ground_atom(new_ground_atom);
-                    dense_derived_atoms.set(grounded_atom_index);
+    m_numeric_assignment_set.reset();
+    pddl_repositories.get_ground_functions(dense_numeric_variables.size(), m_fluent_functions);
+    m_numeric_assignment_set.insert_ground_function_values(m_fluent_functions, dense_numeric_variables);
 
-                    // Retrieve relevant axioms
-                    partition.retrieve_axioms_with_same_body_predicate(new_ground_atom, relevant_axioms);
-                }
+    /* 3. Delete-rederive */
+
+    m_added_derived_atoms.clear();
+    m_deleted_derived_atoms.clear();
+
+    for (size_t partition_index = 0; partition_index < m_occurrences.size(); ++partition_index)
+    {
+        const auto& occurrences = m_occurrences[partition_index];
+
+        m_overdeleted_atoms.clear();
+        m_delta_atoms.clear();
+
+        // Delete the atoms with a derivation in the parent state that depends on a deleted atom in a positive literal,
+        // or on an added atom in a negative literal, and close the deleted atoms under the positive literals of the partition.
+        for (const auto& ground_atom : m_deleted_fluent_atoms)
+        {
+            overdelete_atoms(occurrences.fluent, ground_atom, true, parent_unpacked_state, unpacked_state);
+        }
+        for (const auto& ground_atom : m_added_fluent_atoms)
+        {
+            overdelete_atoms(occurrences.fluent, ground_atom, false, parent_unpacked_state, unpacked_state);
+        }
+        for (const auto& ground_atom : m_deleted_derived_atoms)
+        {
+            overdelete_atoms(occurrences.derived, ground_atom, true, parent_unpacked_state, unpacked_state);
+        }
+        for (const auto& ground_atom : m_added_derived_atoms)
+        {
+            overdelete_atoms(occurrences.derived, ground_atom, false, parent_unpacked_state, unpacked_state);
+        }
+        for (size_t i = 0; i < m_overdeleted_atoms.size(); ++i)
+        {
+            overdelete_atoms(occurrences.derived, m_overdeleted_atoms[i], true, parent_unpacked_state, unpacked_state);
+        }
+
+        // Rederive the deleted atoms that have a derivation from the remaining atoms.
+        for (const auto& ground_atom : m_overdeleted_atoms)
+        {
+            collect_rederiving_axiom(occurrences, ground_atom, unpacked_state);
+        }
+
+        // Insert the atoms with a derivation that depends on an added atom in a positive literal, or on a deleted atom in a negative literal.
+        for (const auto& ground_atom : m_added_fluent_atoms)
+        {
+            collect_inserted_axioms(occurrences.fluent, ground_atom, true, unpacked_state);
+        }
+        for (const auto& ground_atom : m_deleted_fluent_atoms)
+        {
+            collect_inserted_axioms(occurrences.fluent, ground_atom, false, unpacked_state);
+        }
+        for (const auto& ground_atom : m_added_derived_atoms)
+        {
+            collect_inserted_axioms(occurrences.derived, ground_atom, true, unpacked_state);
+        }
+        for (const auto& ground_atom : m_deleted_derived_atoms)
+        {
+            collect_inserted_axioms(occurrences.derived, ground_atom, false, unpacked_state);
+        }
+        apply_applicable_axioms(partition_index, unpacked_state);
+
+        // Propagate the rederived and inserted atoms through the positive literals of the partition.
+        apply_triggered_axioms(partition_index, unpacked_state);
+
+        // Collect the changes for the higher partitions.
+        for (const auto& ground_atom : m_delta_atoms)
+        {
+            if (!parent_derived_atoms.get(ground_atom->get_index()))
+            {
+                m_added_derived_atoms.push_back(ground_atom);
+            }
+        }
+        for (const auto& ground_atom : m_overdeleted_atoms)
+        {
+            if (!dense_derived_atoms.get(ground_atom->get_index()))
+            {
+                m_deleted_derived_atoms.push_back(ground_atom);
             }
-        } while (!reached_partition_fixed_point);
+        }
     }
 
     m_event_handler->on_end_generating_applicable_axioms();
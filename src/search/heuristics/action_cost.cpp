@@ -0,0 +1,68 @@
+/*
+ * Copyright (C) 2023 Dominik Drexler and Simon Stahlberg
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "mimir/search/heuristics/action_cost.hpp"
+
+#include "mimir/formalism/domain.hpp"
+#include "mimir/formalism/ground_action.hpp"
+#include "mimir/formalism/ground_conjunctive_condition.hpp"
+#include "mimir/formalism/ground_effects.hpp"
+#include "mimir/formalism/problem.hpp"
+
+#include <cmath>
+#include <stdexcept>
+
+using namespace mimir::formalism;
+
+namespace mimir::search
+{
+
+DiscreteCost compute_discrete_action_cost(GroundAction action, const ProblemImpl& problem)
+{
+    if (!problem.get_domain()->get_auxiliary_function_skeleton().has_value())
+    {
+        if (problem.get_optimization_metric().has_value())
+            throw std::runtime_error("compute_discrete_action_cost: Metrics over fluent functions are not supported.");
+
+        return 1;
+    }
+
+    auto cost = ContinuousCost(0);
+    for (const auto& cond_effect : action->get_conditional_effects())
+    {
+        const auto& auxiliary_numeric_effect = cond_effect->get_conjunctive_effect()->get_auxiliary_numeric_effect();
+        const auto conjunctive_condition = cond_effect->get_conjunctive_condition();
+
+        // The cost of a conditional effect is not necessarily paid, so ignoring it keeps the cost a lower bound.
+        if (!auxiliary_numeric_effect.has_value() || conjunctive_condition->get_num_preconditions<StaticTag, FluentTag, DerivedTag>() > 0
+            || !conjunctive_condition->get_numeric_constraints().empty())
+            continue;
+
+        const auto [assign_operator, value] = evaluate(auxiliary_numeric_effect.value(),
+                                                       problem.get_initial_function_to_value<StaticTag>(),
+                                                       problem.get_initial_function_to_value<FluentTag>());
+
+        if (assign_operator != loki::AssignOperatorEnum::INCREASE || value < 0 || value != std::floor(value))
+            throw std::runtime_error("compute_discrete_action_cost: Action costs must be non-negative integers.");
+
+        cost += value;
+    }
+
+    return static_cast<DiscreteCost>(cost);
+}
+
+}
@@ -25,9 +25,15 @@ using namespace rpg;
  * HMax
  */
 
-AddHeuristicImpl::AddHeuristicImpl(const DeleteRelaxedProblemExplorator& delete_relaxation) : RelaxedPlanningGraph<AddHeuristicImpl>(delete_relaxation) {}
+AddHeuristicImpl::AddHeuristicImpl(const DeleteRelaxedProblemExplorator& delete_relaxation, bool enable_incremental_evaluation) :
+    RelaxedPlanningGraph<AddHeuristicImpl>(delete_relaxation, enable_incremental_evaluation)
+{
+}
 
-AddHeuristic AddHeuristicImpl::create(const DeleteRelaxedProblemExplorator& delete_relaxation) { return std::make_shared<AddHeuristicImpl>(delete_relaxation); }
+AddHeuristic AddHeuristicImpl::create(const DeleteRelaxedProblemExplorator& delete_relaxation, bool enable_incremental_evaluation)
+{
+    return std::make_shared<AddHeuristicImpl>(delete_relaxation, enable_incremental_evaluation);
+}
 
 void AddHeuristicImpl::initialize_and_annotations_impl(const Action& action)
 {
@@ -53,7 +59,7 @@ void AddHeuristicImpl::initialize_or_annotations_and_queue_impl(const Propositio
 {
     auto& annotations = this->get_proposition_annotations()[proposition.get_index()];
     get_cost(annotations) = 0;
-    this->m_queue.insert(QueueEntry { 0, proposition.get_index() });
+    this->m_queue.insert(QueueEntry { 0, 0, proposition.get_index() });
 }
 
 void AddHeuristicImpl::update_and_annotation_impl(const Proposition& proposition, const Action& action)
@@ -82,7 +88,6 @@ void AddHeuristicImpl::update_or_annotation_impl(const Action& action, const Pro
     if (firing_cost < get_cost(proposition_annotations))
     {
         get_cost(proposition_annotations) = firing_cost;
-        this->m_queue.insert(QueueEntry { get_cost(proposition_annotations), proposition.get_index() });
     }
 }
 
@@ -96,7 +101,6 @@ void AddHeuristicImpl::update_or_annotation_impl(const Axiom& axiom, const Propo
     if (firing_cost < get_cost(proposition_annotations))
     {
         get_cost(proposition_annotations) = firing_cost;
-        this->m_queue.insert(QueueEntry { get_cost(proposition_annotations), proposition.get_index() });
     }
 }
 
@@ -0,0 +1,255 @@
+/*
+ * Copyright (C) 2023 Dominik Drexler and Simon Stahlberg
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#include "mimir/search/heuristics/caching.hpp"
+
+#include "mimir/search/state.hpp"
+
+#include <cassert>
+#include <iterator>
+#include <stdexcept>
+
+namespace mimir::search
+{
+
+CachingHeuristicImpl::CachingHeuristicImpl(Heuristic heuristic, const Options& options) :
+    m_heuristic(std::move(heuristic)),
+    m_options(options),
+    m_state_repository(),
+    m_entries(),
+    m_state_index_to_entry(),
+    m_num_preferred_actions(0),
+    m_statistics()
+{
+    if (!m_heuristic)
+    {
+        throw std::invalid_argument("CachingHeuristicImpl::CachingHeuristicImpl: Expected a heuristic.");
+    }
+}
+
+CachingHeuristic CachingHeuristicImpl::create(Heuristic heuristic, const Options& options)
+{
+    return std::make_shared<CachingHeuristicImpl>(std::move(heuristic), options);
+}
+
+void CachingHeuristicImpl::update_state_repository(const State& state)
+{
+    // State indices are only unique within a state repository.
+    const auto& state_repository = state.get_state_repository();
+    if (m_state_repository.lock() != state_repository)
+    {
+        if (!m_entries.empty())
+        {
+            ++m_statistics.num_invalidations;
+        }
+        clear();
+        m_state_repository = state_repository;
+    }
+}
+
+void CachingHeuristicImpl::insert_entry(Index state_index, bool is_goal_state, ContinuousCost value, const formalism::GroundActionSet* preferred_actions)
+{
+    if (m_options.max_num_entries == 0)
+    {
+        return;
+    }
+
+    if (preferred_actions && preferred_actions->size() > m_options.max_num_preferred_actions)
+    {
+        preferred_actions = nullptr;  ///< Too large to cache on its own.
+    }
+
+    const auto it = m_state_index_to_entry.find(state_index);
+    if (it != m_state_index_to_entry.end())
+    {
+        // The state was cached with the other goal flag or without preferred actions.
+        m_num_preferred_actions -= it->second->preferred_actions.size();
+        m_entries.splice(m_entries.begin(), m_entries, it->second);
+    }
+    else if (m_entries.size() >= m_options.max_num_entries)
+    {
+        // Reuse the least recently used entry.
+        ++m_statistics.num_evictions;
+        m_num_preferred_actions -= m_entries.back().preferred_actions.size();
+        m_state_index_to_entry.erase(m_entries.back().state_index);
+        m_entries.splice(m_entries.begin(), m_entries, std::prev(m_entries.end()));
+        m_state_index_to_entry.emplace(state_index, m_entries.begin());
+    }
+    else
+    {
+        m_entries.emplace_front();
+        m_state_index_to_entry.emplace(state_index, m_entries.begin());
+    }
+
+    auto& entry = m_entries.front();
+    entry.state_index = state_index;
+    entry.is_goal_state = is_goal_state;
+    entry.value = value;
+    entry.has_preferred_actions = (preferred_actions != nullptr);
+    if (preferred_actions)
+    {
+        entry.preferred_actions = *preferred_actions;
+    }
+    else
+    {
+        entry.preferred_actions = formalism::GroundActionSet {};  ///< Release the memory of the previous preferred actions.
+    }
+    m_num_preferred_actions += entry.preferred_actions.size();
+
+    // The most recently used entry fits on its own, so this never evicts it.
+    while (m_num_preferred_actions > m_options.max_num_preferred_actions)
+    {
+        ++m_statistics.num_evictions;
+        m_num_preferred_actions -= m_entries.back().preferred_actions.size();
+        m_state_index_to_entry.erase(m_entries.back().state_index);
+        m_entries.pop_back();
+    }
+}
+
+ContinuousCost CachingHeuristicImpl::compute_heuristic(const State& state, bool is_goal_state)
+{
+    update_state_repository(state);
+
+    const auto it = m_state_index_to_entry.find(state.get_index());
+    if (it != m_state_index_to_entry.end() && it->second->is_goal_state == is_goal_state && it->second->has_preferred_actions)
+    {
+        ++m_statistics.num_hits;
+        m_entries.splice(m_entries.begin(), m_entries, it->second);
+        m_preferred_actions.data = it->second->preferred_actions;
+
+        return it->second->value;
+    }
+
+    ++m_statistics.num_misses;
+    const auto value = m_heuristic->compute_heuristic(state, is_goal_state);
+    m_preferred_actions.data = m_heuristic->get_preferred_actions().data;
+
+    insert_entry(state.get_index(), is_goal_state, value, &m_preferred_actions.data);
+
+    return value;
+}
+
+void CachingHeuristicImpl::lookup_entries(const StateList& states,
+                                          const std::vector<bool>& are_goal_states,
+                                          ContinuousCostList& out_values,
+                                          std::vector<formalism::GroundActionSet>* out_preferred_actions)
+{
+    assert(states.size() == are_goal_states.size());
+
+    out_values.resize(states.size());
+    if (out_preferred_actions)
+    {
+        out_preferred_actions->resize(states.size());
+    }
+    m_miss_states.clear();
+    m_miss_are_goal_states.clear();
+    m_miss_positions.clear();
+
+    for (size_t i = 0; i < states.size(); ++i)
+    {
+        const auto& state = states[i];
+        update_state_repository(state);
+
+        const auto it = m_state_index_to_entry.find(state.get_index());
+        if (it != m_state_index_to_entry.end() && it->second->is_goal_state == are_goal_states[i]
+            && (!out_preferred_actions || it->second->has_preferred_actions))
+        {
+            ++m_statistics.num_hits;
+            m_entries.splice(m_entries.begin(), m_entries, it->second);
+            out_values[i] = it->second->value;
+            if (out_preferred_actions)
+            {
+                (*out_preferred_actions)[i] = it->second->preferred_actions;
+            }
+            continue;
+        }
+
+        ++m_statistics.num_misses;
+        m_miss_states.push_back(state);
+        m_miss_are_goal_states.push_back(are_goal_states[i]);
+        m_miss_positions.push_back(i);
+    }
+}
+
+void CachingHeuristicImpl::compute_heuristics(const StateList& states, const std::vector<bool>& are_goal_states, ContinuousCostList& out_values)
+{
+    lookup_entries(states, are_goal_states, out_values, nullptr);
+
+    if (m_miss_states.empty())
+    {
+        return;
+    }
+
+    m_heuristic->compute_heuristics(m_miss_states, m_miss_are_goal_states, m_miss_values);
+
+    for (size_t i = 0; i < m_miss_states.size(); ++i)
+    {
+        out_values[m_miss_positions[i]] = m_miss_values[i];
+
+        // The batch may mix states of several repositories, in which case only the entries of the last repository are kept.
+        if (m_state_repository.lock() == m_miss_states[i].get_state_repository())
+        {
+            insert_entry(m_miss_states[i].get_index(), m_miss_are_goal_states[i], m_miss_values[i], nullptr);
+        }
+    }
+}
+
+void CachingHeuristicImpl::compute_heuristics_and_preferred_actions(const StateList& states,
+                                                                    const std::vector<bool>& are_goal_states,
+                                                                    ContinuousCostList& out_values,
+                                                                    std::vector<formalism::GroundActionSet>& out_preferred_actions)
+{
+    lookup_entries(states, are_goal_states, out_values, &out_preferred_actions);
+
+    if (m_miss_states.empty())
+    {
+        return;
+    }
+
+    m_heuristic->compute_heuristics_and_preferred_actions(m_miss_states, m_miss_are_goal_states, m_miss_values, m_miss_preferred_actions);
+
+    for (size_t i = 0; i < m_miss_states.size(); ++i)
+    {
+        out_values[m_miss_positions[i]] = m_miss_values[i];
+        out_preferred_actions[m_miss_positions[i]] = m_miss_preferred_actions[i];
+
+        if (m_state_repository.lock() == m_miss_states[i].get_state_repository())
+        {
+            insert_entry(m_miss_states[i].get_index(), m_miss_are_goal_states[i], m_miss_values[i], &m_miss_preferred_actions[i]);
+        }
+    }
+}
+
+void CachingHeuristicImpl::clear()
+{
+    m_entries.clear();
+    m_state_index_to_entry.clear();
+    m_num_preferred_actions = 0;
+}
+
+const Heuristic& CachingHeuristicImpl::get_heuristic() const { return m_heuristic; }
+
+const CachingHeuristicImpl::Options& CachingHeuristicImpl::get_options() const { return m_options; }
+
+const CachingHeuristicImpl::Statistics& CachingHeuristicImpl::get_statistics() const { return m_statistics; }
+
+size_t CachingHeuristicImpl::get_num_entries() const { return m_entries.size(); }
+
+size_t CachingHeuristicImpl::get_num_preferred_actions() const { return m_num_preferred_actions; }
+
+}
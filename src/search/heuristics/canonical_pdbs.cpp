@@ -0,0 +1,74 @@
+/*
+ * Copyright (C) 2023 Dominik Drexler and Simon Stahlberg
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "mimir/search/heuristics/canonical_pdbs.hpp"
+
+#include "mimir/search/heuristics/pdb/pattern_database.hpp"
+#include "mimir/search/heuristics/pdb/task.hpp"
+#include "mimir/search/state.hpp"
+
+#include <algorithm>
+
+namespace mimir::search
+{
+
+static pdb::PatternDatabaseList create_pattern_databases(const pdb::TaskImpl& task,
+                                                         const DeleteRelaxedProblemExplorator& delete_relaxation,
+                                                         const CanonicalPDBsHeuristicImpl::Options& options)
+{
+    if (!options.patterns.has_value())
+        return pdb::compute_patterns_by_hill_climbing(task, delete_relaxation, options.hill_climbing_options, options.cache_directory);
+
+    auto pattern_databases = pdb::PatternDatabaseList {};
+    for (auto pattern : options.patterns.value())
+    {
+        std::sort(pattern.begin(), pattern.end());
+        pattern_databases.push_back(pdb::create_pattern_database(task, std::move(pattern), options.cache_directory));
+    }
+    return pattern_databases;
+}
+
+CanonicalPDBsHeuristicImpl::CanonicalPDBsHeuristicImpl(const DeleteRelaxedProblemExplorator& delete_relaxation, const Options& options) :
+    m_task(pdb::TaskImpl::create(delete_relaxation)),
+    m_pattern_collection(*m_task, create_pattern_databases(*m_task, delete_relaxation, options)),
+    m_values(),
+    m_distances()
+{
+}
+
+CanonicalPDBsHeuristic CanonicalPDBsHeuristicImpl::create(const DeleteRelaxedProblemExplorator& delete_relaxation, const Options& options)
+{
+    return std::make_shared<CanonicalPDBsHeuristicImpl>(delete_relaxation, options);
+}
+
+ContinuousCost CanonicalPDBsHeuristicImpl::compute_heuristic(const State& state, bool is_goal_state)
+{
+    if (m_task->is_unsolvable())
+        return INFINITY_CONTINUOUS_COST;
+
+    m_task->compute_values(state, m_values);
+    m_pattern_collection.compute_distances(m_values, m_distances);
+    const auto distance = m_pattern_collection.combine_distances(m_distances);
+
+    return (distance == MAX_DISCRETE_COST) ? INFINITY_CONTINUOUS_COST : distance;
+}
+
+const pdb::Task& CanonicalPDBsHeuristicImpl::get_task() const { return m_task; }
+
+const pdb::CanonicalPatternCollection& CanonicalPDBsHeuristicImpl::get_pattern_collection() const { return m_pattern_collection; }
+
+}
@@ -27,14 +27,18 @@ using namespace rpg;
  * HMax
  */
 
-FFHeuristicImpl::FFHeuristicImpl(const DeleteRelaxedProblemExplorator& delete_relaxation) : RelaxedPlanningGraph<FFHeuristicImpl>(delete_relaxation)
+FFHeuristicImpl::FFHeuristicImpl(const DeleteRelaxedProblemExplorator& delete_relaxation, bool enable_incremental_evaluation) :
+    RelaxedPlanningGraph<FFHeuristicImpl>(delete_relaxation, enable_incremental_evaluation)
 {
     get<Action>(get_ff_structures_annotations()).resize(get<Action>(this->get_structures()).size());
     get<Axiom>(get_ff_structures_annotations()).resize(get<Axiom>(this->get_structures()).size());
     get_ff_proposition_annotations().resize(this->get_propositions().size());
 }
 
-FFHeuristic FFHeuristicImpl::create(const DeleteRelaxedProblemExplorator& delete_relaxation) { return std::make_shared<FFHeuristicImpl>(delete_relaxation); }
+FFHeuristic FFHeuristicImpl::create(const DeleteRelaxedProblemExplorator& delete_relaxation, bool enable_incremental_evaluation)
+{
+    return std::make_shared<FFHeuristicImpl>(delete_relaxation, enable_incremental_evaluation);
+}
 
 void FFHeuristicImpl::initialize_and_annotations_impl(const Action& action)
 {
@@ -67,7 +71,7 @@ void FFHeuristicImpl::initialize_or_annotations_and_queue_impl(const Proposition
 {
     auto& annotations = this->get_proposition_annotations()[proposition.get_index()];
     get_cost(annotations) = 0;
-    this->m_queue.insert(QueueEntry { 0, proposition.get_index() });
+    this->m_queue.insert(QueueEntry { 0, 0, proposition.get_index() });
 }
 
 void FFHeuristicImpl::update_and_annotation_impl(const Proposition& proposition, const Action& action)
@@ -87,8 +91,12 @@ void FFHeuristicImpl::update_and_annotation_impl(const Proposition& proposition,
     auto& ff_proposition_annotations = get_ff_proposition_annotations()[proposition.get_index()];
     auto& ff_axiom_annotations = get<Axiom>(get_ff_structures_annotations())[axiom.get_index()];
 
-    get_cost(axiom_annotations) = get_cost(proposition_annotations);
-    get_achiever(ff_axiom_annotations) = get_achiever(ff_proposition_annotations);  // Forward the achiever action
+    // The incremental evaluation does not process the preconditions in the order of their costs.
+    if (get_cost(proposition_annotations) >= get_cost(axiom_annotations))
+    {
+        get_cost(axiom_annotations) = get_cost(proposition_annotations);
+        get_achiever(ff_axiom_annotations) = get_achiever(ff_proposition_annotations);  // Forward the achiever action
+    }
 }
 
 void FFHeuristicImpl::update_or_annotation_impl(const Action& action, const Proposition& proposition)
@@ -104,8 +112,6 @@ void FFHeuristicImpl::update_or_annotation_impl(const Action& action, const Prop
 
         auto& ff_proposition_annotations = get_ff_proposition_annotations()[proposition.get_index()];
         get_achiever(ff_proposition_annotations) = action.get_index();
-
-        this->m_queue.insert(QueueEntry { get_cost(proposition_annotations), proposition.get_index() });
     }
 }
 
@@ -121,8 +127,6 @@ void FFHeuristicImpl::update_or_annotation_impl(const Axiom& axiom, const Propos
         auto& ff_proposition_annotations = get_ff_proposition_annotations()[proposition.get_index()];
         auto& ff_axiom_annotations = get<Axiom>(get_ff_structures_annotations())[axiom.get_index()];
         get_achiever(ff_proposition_annotations) = get_achiever(ff_axiom_annotations);  // Forward the achiever action
-
-        this->m_queue.insert(QueueEntry { get_cost(proposition_annotations), proposition.get_index() });
     }
 }
 
@@ -204,6 +208,23 @@ DiscreteCost FFHeuristicImpl::extract_impl(const State& state)
     get_relaxed_plan().clear();
     this->m_preferred_actions.data.clear();
 
+    if (this->m_enable_incremental_evaluation)
+    {
+        // The achievers depend on the order in which the structures are processed, but the best supporters do not.
+        this->for_each_best_supporter_action(
+            [this, &state](const Action& action)
+            {
+                m_relaxed_plan.insert(action.get_unrelaxed_action());
+
+                if (is_applicable(action.get_unrelaxed_action(), state))
+                {
+                    this->m_preferred_actions.data.insert(action.get_unrelaxed_action());
+                }
+            });
+
+        return get_relaxed_plan().size();
+    }
+
     for (const auto proposition_index : this->get_goal_propositions())
     {
         extract_relaxed_plan_and_preferred_operators_recursively(state, this->get_propositions()[proposition_index]);
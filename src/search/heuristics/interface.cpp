@@ -0,0 +1,52 @@
+/*
+ * Copyright (C) 2023 Dominik Drexler and Simon Stahlberg
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "mimir/search/heuristics/interface.hpp"
+
+#include <cassert>
+
+namespace mimir::search
+{
+
+void IHeuristic::compute_heuristics(const StateList& states, const std::vector<bool>& are_goal_states, ContinuousCostList& out_values)
+{
+    assert(states.size() == are_goal_states.size());
+
+    out_values.resize(states.size());
+    for (size_t i = 0; i < states.size(); ++i)
+    {
+        out_values[i] = compute_heuristic(states[i], are_goal_states[i]);
+    }
+}
+
+void IHeuristic::compute_heuristics_and_preferred_actions(const StateList& states,
+                                                          const std::vector<bool>& are_goal_states,
+                                                          ContinuousCostList& out_values,
+                                                          std::vector<formalism::GroundActionSet>& out_preferred_actions)
+{
+    assert(states.size() == are_goal_states.size());
+
+    out_values.resize(states.size());
+    out_preferred_actions.resize(states.size());
+    for (size_t i = 0; i < states.size(); ++i)
+    {
+        out_values[i] = compute_heuristic(states[i], are_goal_states[i]);
+        out_preferred_actions[i] = get_preferred_actions().data;
+    }
+}
+
+}
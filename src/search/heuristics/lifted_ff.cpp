@@ -0,0 +1,145 @@
+/*
+ * Copyright (C) 2023 Dominik Drexler and Simon Stahlberg
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#include "mimir/search/heuristics/lifted_ff.hpp"
+
+#include "mimir/search/heuristics/lifted_rpg_base_impl.hpp"
+
+namespace mimir::search
+{
+using namespace rpg;
+
+/**
+ * Lifted FF
+ */
+
+LiftedFFHeuristicImpl::LiftedFFHeuristicImpl(formalism::Problem problem) :
+    LiftedRelaxedPlanningGraph<LiftedFFHeuristicImpl>(std::move(problem)),
+    m_marked_fluent_atoms(),
+    m_marked_derived_atoms(),
+    m_relaxed_plan()
+{
+}
+
+LiftedFFHeuristic LiftedFFHeuristicImpl::create(formalism::Problem problem) { return std::make_shared<LiftedFFHeuristicImpl>(std::move(problem)); }
+
+DiscreteCost LiftedFFHeuristicImpl::accumulate_action_cost_impl(DiscreteCost cost, DiscreteCost precondition_cost) const
+{
+    return std::max(cost, precondition_cost);
+}
+
+template<formalism::IsFluentOrDerivedTag P>
+void LiftedFFHeuristicImpl::extract_relaxed_plan_and_preferred_operators_recursively(const State& state,
+                                                                                      formalism::GroundConjunctiveCondition conjunctive_condition)
+{
+    for (const auto atom_index : conjunctive_condition->get_precondition<formalism::PositiveTag, P>())
+    {
+        extract_relaxed_plan_and_preferred_operators_recursively<P>(state, atom_index);
+    }
+}
+
+template<formalism::IsFluentOrDerivedTag P>
+void LiftedFFHeuristicImpl::extract_relaxed_plan_and_preferred_operators_recursively(const State& state, Index atom_index)
+{
+    auto& marked_atoms = std::is_same_v<P, formalism::FluentTag> ? m_marked_fluent_atoms : m_marked_derived_atoms;
+
+    if (marked_atoms.get(atom_index))
+        return;
+    marked_atoms.set(atom_index);
+
+    // Atoms with cost 0 are true in the state or derived from atoms that are true in the state.
+    if (this->get_cost<P>(atom_index) == 0)
+        return;
+
+    if constexpr (std::is_same_v<P, formalism::FluentTag>)
+    {
+        const auto& achiever = this->get_fluent_achiever(atom_index);
+        assert(achiever.action && achiever.conditional_effect);
+
+        extract_relaxed_plan_and_preferred_operators_recursively<formalism::FluentTag>(state, achiever.action->get_conjunctive_condition());
+        extract_relaxed_plan_and_preferred_operators_recursively<formalism::DerivedTag>(state, achiever.action->get_conjunctive_condition());
+        extract_relaxed_plan_and_preferred_operators_recursively<formalism::FluentTag>(state, achiever.conditional_effect->get_conjunctive_condition());
+        extract_relaxed_plan_and_preferred_operators_recursively<formalism::DerivedTag>(state, achiever.conditional_effect->get_conjunctive_condition());
+
+        if (m_relaxed_plan.insert(achiever.action).second)
+        {
+            insert_preferred_actions(state, achiever.action);
+        }
+    }
+    else
+    {
+        const auto axiom = this->get_derived_achiever(atom_index);
+        assert(axiom);
+
+        extract_relaxed_plan_and_preferred_operators_recursively<formalism::FluentTag>(state, axiom->get_conjunctive_condition());
+        extract_relaxed_plan_and_preferred_operators_recursively<formalism::DerivedTag>(state, axiom->get_conjunctive_condition());
+    }
+}
+
+void LiftedFFHeuristicImpl::insert_preferred_actions(const State& state, formalism::GroundAction delete_free_action)
+{
+    const auto conjunctive_condition = delete_free_action->get_conjunctive_condition();
+    if (this->accumulate_axiom_cost<formalism::DerivedTag>(conjunctive_condition,
+                                                          this->accumulate_axiom_cost<formalism::FluentTag>(conjunctive_condition, DiscreteCost(0)))
+        > 0)
+    {
+        return;  ///< The delete-free action is not applicable in the state.
+    }
+
+    auto binding = formalism::ObjectList {};
+    for (const auto& object : delete_free_action->get_objects())
+    {
+        binding.push_back(this->get_delete_free_object_to_unrelaxed_object().at(object));
+    }
+
+    for (const auto& action : this->get_delete_relax_translator().get_unrelaxed_actions(delete_free_action->get_action()))
+    {
+        const auto ground_action = this->get_problem()->ground(action, binding);
+
+        if (is_applicable(ground_action, state))
+        {
+            this->m_preferred_actions.data.insert(ground_action);
+        }
+    }
+}
+
+DiscreteCost LiftedFFHeuristicImpl::extract_impl(const State& state)
+{
+    // Ensure that this function is called only if the goal is satisfied in the relaxed exploration.
+    assert(this->m_num_unsat_goals == 0);
+
+    m_marked_fluent_atoms.unset_all();
+    m_marked_derived_atoms.unset_all();
+    m_relaxed_plan.clear();
+    this->m_preferred_actions.data.clear();
+
+    for (const auto atom_index : this->get_fluent_goal_atoms())
+    {
+        extract_relaxed_plan_and_preferred_operators_recursively<formalism::FluentTag>(state, atom_index);
+    }
+    for (const auto atom_index : this->get_derived_goal_atoms())
+    {
+        extract_relaxed_plan_and_preferred_operators_recursively<formalism::DerivedTag>(state, atom_index);
+    }
+
+    return m_relaxed_plan.size();
+}
+
+template class rpg::LiftedRelaxedPlanningGraph<LiftedFFHeuristicImpl>;
+
+}
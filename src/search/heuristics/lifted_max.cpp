@@ -0,0 +1,60 @@
+/*
+ * Copyright (C) 2023 Dominik Drexler and Simon Stahlberg
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#include "mimir/search/heuristics/lifted_max.hpp"
+
+#include "mimir/search/heuristics/lifted_rpg_base_impl.hpp"
+
+namespace mimir::search
+{
+using namespace rpg;
+
+/**
+ * Lifted HMax
+ */
+
+LiftedMaxHeuristicImpl::LiftedMaxHeuristicImpl(formalism::Problem problem) : LiftedRelaxedPlanningGraph<LiftedMaxHeuristicImpl>(std::move(problem)) {}
+
+LiftedMaxHeuristic LiftedMaxHeuristicImpl::create(formalism::Problem problem) { return std::make_shared<LiftedMaxHeuristicImpl>(std::move(problem)); }
+
+DiscreteCost LiftedMaxHeuristicImpl::accumulate_action_cost_impl(DiscreteCost cost, DiscreteCost precondition_cost) const
+{
+    return std::max(cost, precondition_cost);
+}
+
+DiscreteCost LiftedMaxHeuristicImpl::extract_impl(const State&)
+{
+    // Ensure that this function is called only if the goal is satisfied in the relaxed exploration.
+    assert(this->m_num_unsat_goals == 0);
+
+    auto total_cost = DiscreteCost(0);
+    for (const auto atom_index : this->get_fluent_goal_atoms())
+    {
+        total_cost = accumulate_action_cost_impl(total_cost, this->get_cost<formalism::FluentTag>(atom_index));
+    }
+    for (const auto atom_index : this->get_derived_goal_atoms())
+    {
+        total_cost = accumulate_action_cost_impl(total_cost, this->get_cost<formalism::DerivedTag>(atom_index));
+    }
+
+    return total_cost;
+}
+
+template class rpg::LiftedRelaxedPlanningGraph<LiftedMaxHeuristicImpl>;
+
+}
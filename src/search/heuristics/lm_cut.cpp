@@ -0,0 +1,475 @@
+/*
+ * Copyright (C) 2023 Dominik Drexler and Simon Stahlberg
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#include "mimir/search/heuristics/lm_cut.hpp"
+
+#include "mimir/formalism/ground_action.hpp"
+#include "mimir/formalism/ground_conjunctive_condition.hpp"
+#include "mimir/formalism/problem.hpp"
+#include "mimir/search/heuristics/action_cost.hpp"
+#include "mimir/search/heuristics/rpg/construction_helpers.hpp"
+#include "mimir/search/state.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <functional>
+#include <numeric>
+#include <unordered_map>
+
+using namespace mimir::formalism;
+
+namespace mimir::search
+{
+using namespace rpg;
+
+/**
+ * Construction helpers
+ */
+
+template<IsPolarity R, IsFluentOrDerivedTag P, IsStructure S>
+static void insert_precondition_propositions_helper(const S& structure, PropositionOffsets& offsets, IndexList& ref_propositions)
+{
+    const auto& proposition_offsets = get<R, P>(offsets);
+
+    for (const auto atom_index : structure.template get_preconditions<R, P>()->compressed_range())
+    {
+        ref_propositions.push_back(proposition_offsets[atom_index]);
+    }
+    if constexpr (std::is_same_v<S, Action>)
+    {
+        for (const auto atom_index : structure.template get_conditional_preconditions<R, P>()->compressed_range())
+        {
+            ref_propositions.push_back(proposition_offsets[atom_index]);
+        }
+    }
+}
+
+template<IsStructure S>
+static void insert_precondition_propositions(const S& structure, PropositionOffsets& offsets, IndexList& ref_propositions)
+{
+    insert_precondition_propositions_helper<PositiveTag, FluentTag>(structure, offsets, ref_propositions);
+    insert_precondition_propositions_helper<NegativeTag, FluentTag>(structure, offsets, ref_propositions);
+    insert_precondition_propositions_helper<PositiveTag, DerivedTag>(structure, offsets, ref_propositions);
+    insert_precondition_propositions_helper<NegativeTag, DerivedTag>(structure, offsets, ref_propositions);
+}
+
+/// @brief Invert the mapping from elements to their targets into the compressed sparse row format.
+static void invert_mapping(const IndexList& element_offsets,
+                           const IndexList& element_targets,
+                           size_t num_targets,
+                           IndexList& out_target_offsets,
+                           IndexList& out_target_elements)
+{
+    out_target_offsets.assign(num_targets + 1, 0);
+    for (const auto target : element_targets)
+    {
+        ++out_target_offsets[target + 1];
+    }
+    std::partial_sum(out_target_offsets.begin(), out_target_offsets.end(), out_target_offsets.begin());
+
+    auto positions = IndexList(out_target_offsets.begin(), out_target_offsets.end() - 1);
+    out_target_elements.resize(element_targets.size());
+    for (Index element = 0; element + 1 < element_offsets.size(); ++element)
+    {
+        for (auto i = element_offsets[element]; i < element_offsets[element + 1]; ++i)
+        {
+            out_target_elements[positions[element_targets[i]]++] = element;
+        }
+    }
+}
+
+/**
+ * LMCut
+ */
+
+LMCutHeuristicImpl::LMCutHeuristicImpl(const DeleteRelaxedProblemExplorator& delete_relaxation) :
+    m_operator_precondition_offsets(),
+    m_operator_preconditions(),
+    m_operator_effects(),
+    m_operator_cost_indices(),
+    m_precondition_of_offsets(),
+    m_precondition_of(),
+    m_achiever_offsets(),
+    m_achievers(),
+    m_offsets(),
+    m_goal_proposition(),
+    m_costs(),
+    m_cost_index_operator_offsets(),
+    m_cost_index_operators(),
+    m_remaining_costs(),
+    m_proposition_costs(),
+    m_proposition_statuses(),
+    m_num_unsatisfied_preconditions(),
+    m_supporters(),
+    m_supporter_costs(),
+    m_initial_propositions(),
+    m_stack(),
+    m_cut(),
+    m_reduced_cost_indices(),
+    m_queue()
+{
+    const auto& problem = *delete_relaxation.get_problem();
+
+    auto [actions, is_precondition_of_action, trivial_unary_actions] = instantiate_actions(delete_relaxation);
+    auto [axioms, is_precondition_of_axiom, trivial_unary_axioms] = instantiate_axioms(delete_relaxation);
+    auto [propositions, goal_propositions, proposition_offsets] = instantiate_propositions(problem,
+                                                                                           std::move(is_precondition_of_action),
+                                                                                           std::move(is_precondition_of_axiom),
+                                                                                           std::move(trivial_unary_actions),
+                                                                                           std::move(trivial_unary_axioms));
+    m_offsets = std::move(proposition_offsets);
+    m_goal_proposition = propositions.size();
+
+    /**
+     * Instantiate the costs, where all unary actions of a ground action share a cost index.
+     */
+
+    m_costs.push_back(0);
+    auto action_to_cost_index = std::unordered_map<GroundAction, Index> {};
+    for (const auto& action : actions)
+    {
+        if (action_to_cost_index.emplace(action.get_unrelaxed_action(), m_costs.size()).second)
+        {
+            m_costs.push_back(compute_discrete_action_cost(action.get_unrelaxed_action(), problem));
+        }
+    }
+
+    /**
+     * Instantiate the operators.
+     */
+
+    const auto add_operator = [this](IndexList& preconditions, Index effect, Index cost_index)
+    {
+        std::sort(preconditions.begin(), preconditions.end());
+        preconditions.erase(std::unique(preconditions.begin(), preconditions.end()), preconditions.end());
+        if (preconditions.empty())
+        {
+            preconditions.push_back(DUMMY_PROPOSITION_INDEX);
+        }
+
+        m_operator_precondition_offsets.push_back(m_operator_preconditions.size());
+        m_operator_preconditions.insert(m_operator_preconditions.end(), preconditions.begin(), preconditions.end());
+        m_operator_effects.push_back(effect);
+        m_operator_cost_indices.push_back(cost_index);
+    };
+
+    auto preconditions = IndexList {};
+    for (const auto& action : actions)
+    {
+        preconditions.clear();
+        insert_precondition_propositions(action, m_offsets, preconditions);
+        const auto effect = action.get_polarity() ? get<PositiveTag, FluentTag>(m_offsets)[action.get_effect()] :
+                                                    get<NegativeTag, FluentTag>(m_offsets)[action.get_effect()];
+        add_operator(preconditions, effect, action_to_cost_index.at(action.get_unrelaxed_action()));
+    }
+    for (const auto& axiom : axioms)
+    {
+        preconditions.clear();
+        insert_precondition_propositions(axiom, m_offsets, preconditions);
+        const auto effect = axiom.get_polarity() ? get<PositiveTag, DerivedTag>(m_offsets)[axiom.get_effect()] :
+                                                   get<NegativeTag, DerivedTag>(m_offsets)[axiom.get_effect()];
+        add_operator(preconditions, effect, FREE_COST_INDEX);
+    }
+    preconditions = goal_propositions;
+    add_operator(preconditions, m_goal_proposition, FREE_COST_INDEX);
+    m_operator_precondition_offsets.push_back(m_operator_preconditions.size());
+
+    /**
+     * Instantiate the inverse mappings.
+     */
+
+    const auto num_operators = m_operator_effects.size();
+    const auto num_propositions = m_goal_proposition + 1;
+
+    invert_mapping(m_operator_precondition_offsets, m_operator_preconditions, num_propositions, m_precondition_of_offsets, m_precondition_of);
+
+    auto effect_offsets = IndexList(num_operators + 1);
+    std::iota(effect_offsets.begin(), effect_offsets.end(), 0);
+    invert_mapping(effect_offsets, m_operator_effects, num_propositions, m_achiever_offsets, m_achievers);
+    invert_mapping(effect_offsets, m_operator_cost_indices, m_costs.size(), m_cost_index_operator_offsets, m_cost_index_operators);
+
+    /**
+     * Allocate the memory for reuse.
+     */
+
+    m_remaining_costs.resize(m_costs.size());
+    m_proposition_costs.resize(num_propositions);
+    m_proposition_statuses.resize(num_propositions);
+    m_num_unsatisfied_preconditions.resize(num_operators);
+    m_supporters.resize(num_operators);
+    m_supporter_costs.resize(num_operators);
+    m_initial_propositions.reserve(num_propositions);
+    m_stack.reserve(num_propositions);
+    m_cut.reserve(num_operators);
+    m_reduced_cost_indices.reserve(num_operators);
+    m_queue.reserve(num_propositions + num_operators);
+}
+
+LMCutHeuristic LMCutHeuristicImpl::create(const DeleteRelaxedProblemExplorator& delete_relaxation)
+{
+    return std::make_shared<LMCutHeuristicImpl>(delete_relaxation);
+}
+
+template<IsFluentOrDerivedTag P>
+void LMCutHeuristicImpl::initialize_propositions(const State& state)
+{
+    const auto& positive_offsets = get<PositiveTag, P>(m_offsets);
+    const auto& negative_offsets = get<NegativeTag, P>(m_offsets);
+    const auto& state_atoms = state.get_atoms<P>();
+
+    for (const auto atom_index : state_atoms)
+    {
+        m_initial_propositions.push_back(positive_offsets[atom_index]);
+    }
+
+    if constexpr (std::is_same_v<P, DerivedTag>)
+    {
+        // Derive all negative derived propositions immediately, i.e., not y <- T for all y, as in `rpg::RelaxedPlanningGraph`.
+        m_initial_propositions.insert(m_initial_propositions.end(), negative_offsets.begin(), negative_offsets.end());
+    }
+    else
+    {
+        auto it = state_atoms.begin();
+        const auto end = state_atoms.end();
+        for (Index atom_index = 0; atom_index < negative_offsets.size(); ++atom_index)
+        {
+            if (it != end && *it == atom_index)
+                ++it;
+            else
+                m_initial_propositions.push_back(negative_offsets[atom_index]);
+        }
+    }
+}
+
+void LMCutHeuristicImpl::enqueue(Index proposition_index, DiscreteCost cost)
+{
+    if (cost < m_proposition_costs[proposition_index])
+    {
+        m_proposition_costs[proposition_index] = cost;
+        m_queue.push_back(QueueEntry { cost, proposition_index });
+        std::push_heap(m_queue.begin(), m_queue.end(), std::greater<QueueEntry> {});
+    }
+}
+
+void LMCutHeuristicImpl::compute_h_max()
+{
+    std::fill(m_proposition_costs.begin(), m_proposition_costs.end(), MAX_DISCRETE_COST);
+    std::fill(m_supporters.begin(), m_supporters.end(), MAX_INDEX);
+    for (Index operator_index = 0; operator_index < m_operator_effects.size(); ++operator_index)
+    {
+        m_num_unsatisfied_preconditions[operator_index] = m_operator_precondition_offsets[operator_index + 1] - m_operator_precondition_offsets[operator_index];
+    }
+
+    m_queue.clear();
+    for (const auto proposition_index : m_initial_propositions)
+    {
+        enqueue(proposition_index, 0);
+    }
+
+    while (!m_queue.empty())
+    {
+        std::pop_heap(m_queue.begin(), m_queue.end(), std::greater<QueueEntry> {});
+        const auto [cost, proposition_index] = m_queue.back();
+        m_queue.pop_back();
+
+        if (cost > m_proposition_costs[proposition_index])
+            continue;
+
+        for (auto i = m_precondition_of_offsets[proposition_index]; i < m_precondition_of_offsets[proposition_index + 1]; ++i)
+        {
+            const auto operator_index = m_precondition_of[i];
+
+            // The precondition that is satisfied last has the maximal cost.
+            if (--m_num_unsatisfied_preconditions[operator_index] == 0)
+            {
+                m_supporters[operator_index] = proposition_index;
+                m_supporter_costs[operator_index] = cost;
+                enqueue(m_operator_effects[operator_index], cost + get_operator_cost(operator_index));
+            }
+        }
+    }
+}
+
+void LMCutHeuristicImpl::update_h_max()
+{
+    m_queue.clear();
+    for (const auto cost_index : m_reduced_cost_indices)
+    {
+        for (auto i = m_cost_index_operator_offsets[cost_index]; i < m_cost_index_operator_offsets[cost_index + 1]; ++i)
+        {
+            const auto operator_index = m_cost_index_operators[i];
+
+            if (m_supporters[operator_index] != MAX_INDEX)
+            {
+                enqueue(m_operator_effects[operator_index], m_supporter_costs[operator_index] + get_operator_cost(operator_index));
+            }
+        }
+    }
+
+    while (!m_queue.empty())
+    {
+        std::pop_heap(m_queue.begin(), m_queue.end(), std::greater<QueueEntry> {});
+        const auto [cost, proposition_index] = m_queue.back();
+        m_queue.pop_back();
+
+        if (cost > m_proposition_costs[proposition_index])
+            continue;
+
+        for (auto i = m_precondition_of_offsets[proposition_index]; i < m_precondition_of_offsets[proposition_index + 1]; ++i)
+        {
+            const auto operator_index = m_precondition_of[i];
+
+            if (m_supporters[operator_index] != proposition_index || m_supporter_costs[operator_index] <= cost)
+                continue;
+
+            // The supporter became cheaper, so another precondition might have become the one with maximal cost.
+            const auto old_supporter_cost = m_supporter_costs[operator_index];
+            for (auto j = m_operator_precondition_offsets[operator_index]; j < m_operator_precondition_offsets[operator_index + 1]; ++j)
+            {
+                const auto precondition = m_operator_preconditions[j];
+                if (m_proposition_costs[precondition] > m_proposition_costs[m_supporters[operator_index]])
+                {
+                    m_supporters[operator_index] = precondition;
+                }
+            }
+            m_supporter_costs[operator_index] = m_proposition_costs[m_supporters[operator_index]];
+
+            if (m_supporter_costs[operator_index] < old_supporter_cost)
+            {
+                enqueue(m_operator_effects[operator_index], m_supporter_costs[operator_index] + get_operator_cost(operator_index));
+            }
+        }
+    }
+}
+
+void LMCutHeuristicImpl::mark_goal_zone()
+{
+    std::fill(m_proposition_statuses.begin(), m_proposition_statuses.end(), PropositionStatus::DEFAULT);
+
+    m_stack.clear();
+    m_stack.push_back(m_goal_proposition);
+    while (!m_stack.empty())
+    {
+        const auto proposition_index = m_stack.back();
+        m_stack.pop_back();
+
+        if (m_proposition_statuses[proposition_index] == PropositionStatus::GOAL_ZONE)
+            continue;
+
+        m_proposition_statuses[proposition_index] = PropositionStatus::GOAL_ZONE;
+
+        for (auto i = m_achiever_offsets[proposition_index]; i < m_achiever_offsets[proposition_index + 1]; ++i)
+        {
+            const auto operator_index = m_achievers[i];
+
+            // Free achievers without supporter are unreachable, which happens only if the problem has free actions.
+            if (get_operator_cost(operator_index) == 0 && m_supporters[operator_index] != MAX_INDEX)
+            {
+                m_stack.push_back(m_supporters[operator_index]);
+            }
+        }
+    }
+}
+
+void LMCutHeuristicImpl::find_cut()
+{
+    m_cut.clear();
+    m_stack.clear();
+
+    // The initial propositions are never in the goal zone since their h_max cost is zero.
+    for (const auto proposition_index : m_initial_propositions)
+    {
+        m_proposition_statuses[proposition_index] = PropositionStatus::BEFORE_GOAL_ZONE;
+        m_stack.push_back(proposition_index);
+    }
+
+    while (!m_stack.empty())
+    {
+        const auto proposition_index = m_stack.back();
+        m_stack.pop_back();
+
+        for (auto i = m_precondition_of_offsets[proposition_index]; i < m_precondition_of_offsets[proposition_index + 1]; ++i)
+        {
+            const auto operator_index = m_precondition_of[i];
+
+            if (m_supporters[operator_index] != proposition_index)
+                continue;
+
+            const auto effect = m_operator_effects[operator_index];
+            if (m_proposition_statuses[effect] == PropositionStatus::GOAL_ZONE)
+            {
+                assert(get_operator_cost(operator_index) > 0);
+                m_cut.push_back(operator_index);
+            }
+            else if (m_proposition_statuses[effect] == PropositionStatus::DEFAULT)
+            {
+                m_proposition_statuses[effect] = PropositionStatus::BEFORE_GOAL_ZONE;
+                m_stack.push_back(effect);
+            }
+        }
+    }
+}
+
+ContinuousCost LMCutHeuristicImpl::compute_heuristic(const State& state, bool is_goal_state)
+{
+    if (is_goal_state)
+        return 0.;
+
+    m_initial_propositions.clear();
+    m_initial_propositions.push_back(DUMMY_PROPOSITION_INDEX);
+    initialize_propositions<FluentTag>(state);
+    initialize_propositions<DerivedTag>(state);
+
+    std::copy(m_costs.begin(), m_costs.end(), m_remaining_costs.begin());
+
+    compute_h_max();
+
+    if (m_proposition_costs[m_goal_proposition] == MAX_DISCRETE_COST)
+        return INFINITY_CONTINUOUS_COST;
+
+    auto total_cost = DiscreteCost(0);
+    while (m_proposition_costs[m_goal_proposition] > 0)
+    {
+        mark_goal_zone();
+        find_cut();
+        assert(!m_cut.empty());
+
+        auto cut_cost = MAX_DISCRETE_COST;
+        m_reduced_cost_indices.clear();
+        for (const auto operator_index : m_cut)
+        {
+            cut_cost = std::min(cut_cost, get_operator_cost(operator_index));
+            m_reduced_cost_indices.push_back(m_operator_cost_indices[operator_index]);
+        }
+        total_cost += cut_cost;
+
+        // Operators of the same ground action share the cost, which is reduced once.
+        std::sort(m_reduced_cost_indices.begin(), m_reduced_cost_indices.end());
+        m_reduced_cost_indices.erase(std::unique(m_reduced_cost_indices.begin(), m_reduced_cost_indices.end()), m_reduced_cost_indices.end());
+        for (const auto cost_index : m_reduced_cost_indices)
+        {
+            m_remaining_costs[cost_index] -= cut_cost;
+        }
+
+        update_h_max();
+    }
+
+    return total_cost;
+}
+
+}
@@ -25,9 +25,15 @@ using namespace rpg;
  * HMax
  */
 
-MaxHeuristicImpl::MaxHeuristicImpl(const DeleteRelaxedProblemExplorator& delete_relaxation) : RelaxedPlanningGraph<MaxHeuristicImpl>(delete_relaxation) {}
+MaxHeuristicImpl::MaxHeuristicImpl(const DeleteRelaxedProblemExplorator& delete_relaxation, bool enable_incremental_evaluation) :
+    RelaxedPlanningGraph<MaxHeuristicImpl>(delete_relaxation, enable_incremental_evaluation)
+{
+}
 
-MaxHeuristic MaxHeuristicImpl::create(const DeleteRelaxedProblemExplorator& delete_relaxation) { return std::make_shared<MaxHeuristicImpl>(delete_relaxation); }
+MaxHeuristic MaxHeuristicImpl::create(const DeleteRelaxedProblemExplorator& delete_relaxation, bool enable_incremental_evaluation)
+{
+    return std::make_shared<MaxHeuristicImpl>(delete_relaxation, enable_incremental_evaluation);
+}
 
 void MaxHeuristicImpl::initialize_and_annotations_impl(const Action& action)
 {
@@ -53,7 +59,7 @@ void MaxHeuristicImpl::initialize_or_annotations_and_queue_impl(const Propositio
 {
     auto& annotations = this->get_proposition_annotations()[proposition.get_index()];
     get_cost(annotations) = 0;
-    this->m_queue.insert(QueueEntry { 0, proposition.get_index() });
+    this->m_queue.insert(QueueEntry { 0, 0, proposition.get_index() });
 }
 
 void MaxHeuristicImpl::update_and_annotation_impl(const Proposition& proposition, const Action& action)
@@ -82,7 +88,6 @@ void MaxHeuristicImpl::update_or_annotation_impl(const Action& action, const Pro
     if (firing_cost < get_cost(proposition_annotations))
     {
         get_cost(proposition_annotations) = firing_cost;
-        this->m_queue.insert(QueueEntry { get_cost(proposition_annotations), proposition.get_index() });
     }
 }
 
@@ -94,7 +99,6 @@ void MaxHeuristicImpl::update_or_annotation_impl(const Axiom& axiom, const Propo
     if (get_cost(axiom_annotations) < get_cost(proposition_annotations))
     {
         get_cost(proposition_annotations) = get_cost(axiom_annotations);
-        this->m_queue.insert(QueueEntry { get_cost(proposition_annotations), proposition.get_index() });
     }
 }
 
@@ -0,0 +1,61 @@
+/*
+ * Copyright (C) 2023 Dominik Drexler and Simon Stahlberg
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "mimir/search/heuristics/pdb.hpp"
+
+#include "mimir/search/heuristics/pdb/pattern_database.hpp"
+#include "mimir/search/heuristics/pdb/pattern_generation.hpp"
+#include "mimir/search/heuristics/pdb/task.hpp"
+#include "mimir/search/state.hpp"
+
+#include <algorithm>
+
+namespace mimir::search
+{
+
+PDBHeuristicImpl::PDBHeuristicImpl(const DeleteRelaxedProblemExplorator& delete_relaxation, const Options& options) :
+    m_task(pdb::TaskImpl::create(delete_relaxation)),
+    m_pattern_database(),
+    m_values()
+{
+    auto pattern = options.pattern.has_value() ? options.pattern.value() : pdb::compute_greedy_pattern(*m_task, options.max_num_abstract_states);
+    std::sort(pattern.begin(), pattern.end());
+
+    m_pattern_database = pdb::create_pattern_database(*m_task, std::move(pattern), options.cache_directory);
+}
+
+PDBHeuristic PDBHeuristicImpl::create(const DeleteRelaxedProblemExplorator& delete_relaxation, const Options& options)
+{
+    return std::make_shared<PDBHeuristicImpl>(delete_relaxation, options);
+}
+
+ContinuousCost PDBHeuristicImpl::compute_heuristic(const State& state, bool is_goal_state)
+{
+    if (m_task->is_unsolvable())
+        return INFINITY_CONTINUOUS_COST;
+
+    m_task->compute_values(state, m_values);
+    const auto distance = m_pattern_database->get_distance(m_values);
+
+    return (distance == MAX_DISCRETE_COST) ? INFINITY_CONTINUOUS_COST : distance;
+}
+
+const pdb::Task& PDBHeuristicImpl::get_task() const { return m_task; }
+
+const pdb::PatternDatabase& PDBHeuristicImpl::get_pattern_database() const { return m_pattern_database; }
+
+}
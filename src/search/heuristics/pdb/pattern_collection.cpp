@@ -0,0 +1,199 @@
+/*
+ * Copyright (C) 2023 Dominik Drexler and Simon Stahlberg
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "mimir/search/heuristics/pdb/pattern_collection.hpp"
+
+#include "mimir/search/heuristics/pdb/pattern_database.hpp"
+#include "mimir/search/heuristics/pdb/task.hpp"
+
+#include <algorithm>
+#include <iterator>
+#include <numeric>
+
+namespace mimir::search::pdb
+{
+
+IndexList compute_affecting_operators(const TaskImpl& task, const Pattern& pattern)
+{
+    auto affecting_operators = IndexList {};
+    const auto& affected_variables = task.get_affected_variables();
+    for (Index op_index = 0; op_index < affected_variables.size(); ++op_index)
+    {
+        // Both lists are sorted.
+        auto it = pattern.begin();
+        for (const auto variable : affected_variables[op_index])
+        {
+            it = std::lower_bound(it, pattern.end(), variable);
+            if (it == pattern.end())
+                break;
+            if (*it == variable)
+            {
+                affecting_operators.push_back(op_index);
+                break;
+            }
+        }
+    }
+    return affecting_operators;
+}
+
+bool are_additive(const IndexList& lhs_affecting_operators, const IndexList& rhs_affecting_operators)
+{
+    auto lhs_it = lhs_affecting_operators.begin();
+    auto rhs_it = rhs_affecting_operators.begin();
+    while (lhs_it != lhs_affecting_operators.end() && rhs_it != rhs_affecting_operators.end())
+    {
+        if (*lhs_it < *rhs_it)
+            ++lhs_it;
+        else if (*rhs_it < *lhs_it)
+            ++rhs_it;
+        else
+            return false;
+    }
+    return true;
+}
+
+static void compute_maximal_cliques_recursively(const std::vector<std::vector<bool>>& adjacency_matrix,
+                                                IndexList& ref_clique,
+                                                IndexList candidates,
+                                                IndexList excluded,
+                                                std::vector<IndexList>& out_cliques)
+{
+    if (candidates.empty())
+    {
+        if (excluded.empty())
+        {
+            out_cliques.push_back(ref_clique);
+            std::sort(out_cliques.back().begin(), out_cliques.back().end());
+        }
+        return;
+    }
+
+    // Choose the pivot with most neighbors among the candidates, whose neighbors need not be branched on.
+    const auto count_neighbors = [&](Index vertex)
+    { return std::count_if(candidates.begin(), candidates.end(), [&](auto&& candidate) { return adjacency_matrix[vertex][candidate]; }); };
+    auto pivot = candidates.front();
+    auto max_num_neighbors = count_neighbors(pivot);
+    for (const auto& vertices : { candidates, excluded })
+    {
+        for (const auto vertex : vertices)
+        {
+            const auto num_neighbors = count_neighbors(vertex);
+            if (num_neighbors > max_num_neighbors)
+            {
+                pivot = vertex;
+                max_num_neighbors = num_neighbors;
+            }
+        }
+    }
+
+    auto branching_vertices = IndexList {};
+    std::copy_if(candidates.begin(), candidates.end(), std::back_inserter(branching_vertices), [&](auto&& vertex) { return !adjacency_matrix[pivot][vertex]; });
+
+    for (const auto vertex : branching_vertices)
+    {
+        const auto is_neighbor = [&](auto&& other) { return adjacency_matrix[vertex][other]; };
+        auto next_candidates = IndexList {};
+        auto next_excluded = IndexList {};
+        std::copy_if(candidates.begin(), candidates.end(), std::back_inserter(next_candidates), is_neighbor);
+        std::copy_if(excluded.begin(), excluded.end(), std::back_inserter(next_excluded), is_neighbor);
+
+        ref_clique.push_back(vertex);
+        compute_maximal_cliques_recursively(adjacency_matrix, ref_clique, std::move(next_candidates), std::move(next_excluded), out_cliques);
+        ref_clique.pop_back();
+
+        candidates.erase(std::find(candidates.begin(), candidates.end(), vertex));
+        excluded.push_back(vertex);
+    }
+}
+
+std::vector<IndexList> compute_maximal_cliques(const std::vector<std::vector<bool>>& adjacency_matrix)
+{
+    auto cliques = std::vector<IndexList> {};
+    auto clique = IndexList {};
+    auto candidates = IndexList(adjacency_matrix.size());
+    std::iota(candidates.begin(), candidates.end(), 0);
+    if (!candidates.empty())
+        compute_maximal_cliques_recursively(adjacency_matrix, clique, std::move(candidates), IndexList {}, cliques);
+    return cliques;
+}
+
+CanonicalPatternCollection::CanonicalPatternCollection(const TaskImpl& task, PatternDatabaseList pattern_databases) :
+    m_pattern_databases(std::move(pattern_databases)),
+    m_affecting_operators(),
+    m_maximal_additive_sets()
+{
+    for (const auto& pdb : m_pattern_databases)
+    {
+        m_affecting_operators.push_back(compute_affecting_operators(task, pdb->get_pattern()));
+    }
+
+    const auto num_pdbs = m_pattern_databases.size();
+    auto compatibility_graph = std::vector<std::vector<bool>>(num_pdbs, std::vector<bool>(num_pdbs, false));
+    for (size_t i = 0; i < num_pdbs; ++i)
+    {
+        for (size_t j = i + 1; j < num_pdbs; ++j)
+        {
+            compatibility_graph[i][j] = compatibility_graph[j][i] = are_additive(m_affecting_operators[i], m_affecting_operators[j]);
+        }
+    }
+    m_maximal_additive_sets = compute_maximal_cliques(compatibility_graph);
+}
+
+void CanonicalPatternCollection::compute_distances(const IndexList& values, std::vector<DiscreteCost>& out_distances) const
+{
+    out_distances.resize(m_pattern_databases.size());
+    for (size_t i = 0; i < m_pattern_databases.size(); ++i)
+    {
+        out_distances[i] = m_pattern_databases[i]->get_distance(values);
+    }
+}
+
+DiscreteCost CanonicalPatternCollection::combine_distances(const std::vector<DiscreteCost>& distances) const
+{
+    if (std::find(distances.begin(), distances.end(), MAX_DISCRETE_COST) != distances.end())
+        return MAX_DISCRETE_COST;
+
+    auto max_sum = DiscreteCost(0);
+    for (const auto& additive_set : m_maximal_additive_sets)
+    {
+        auto sum = DiscreteCost(0);
+        for (const auto i : additive_set)
+        {
+            sum += distances[i];
+        }
+        max_sum = std::max(max_sum, sum);
+    }
+    return max_sum;
+}
+
+const PatternDatabaseList& CanonicalPatternCollection::get_pattern_databases() const { return m_pattern_databases; }
+
+const std::vector<IndexList>& CanonicalPatternCollection::get_affecting_operators() const { return m_affecting_operators; }
+
+const std::vector<IndexList>& CanonicalPatternCollection::get_maximal_additive_sets() const { return m_maximal_additive_sets; }
+
+size_t CanonicalPatternCollection::get_num_abstract_states() const
+{
+    auto num_abstract_states = size_t(0);
+    for (const auto& pdb : m_pattern_databases)
+    {
+        num_abstract_states += pdb->get_num_abstract_states();
+    }
+    return num_abstract_states;
+}
+
+}
@@ -0,0 +1,582 @@
+/*
+ * Copyright (C) 2023 Dominik Drexler and Simon Stahlberg
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "mimir/search/heuristics/pdb/pattern_database.hpp"
+
+#include "cista/mmap.h"
+#include "mimir/search/heuristics/pdb/stable_hash.hpp"
+#include "mimir/search/heuristics/pdb/task.hpp"
+#include "mimir/search/openlists/priority_queue.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <iomanip>
+#include <limits>
+#include <numeric>
+#include <sstream>
+#include <stdexcept>
+
+namespace mimir::search::pdb
+{
+
+/**
+ * Abstract transition system
+ */
+
+namespace
+{
+/// @brief `AbstractFact` is the assignment of a value to the variable at a position of the pattern.
+struct AbstractFact
+{
+    Index position;
+    Index value;
+};
+
+using AbstractFactList = std::vector<AbstractFact>;
+
+struct AbstractEffect
+{
+    AbstractFactList positive_conditions;
+    AbstractFactList negative_conditions;
+    bool is_uncertain;  ///< True iff the effect may or may not fire when the represented condition holds.
+    AbstractFactList add_facts;
+    AbstractFactList delete_facts;
+};
+
+struct AbstractOperator
+{
+    DiscreteCost cost;
+    AbstractFactList positive_preconditions;
+    AbstractFactList negative_preconditions;
+    std::vector<AbstractEffect> effects;
+    IndexList affected_positions;
+};
+
+struct Edge
+{
+    Index source;
+    Index target;
+    DiscreteCost cost;
+};
+
+struct QueueEntry
+{
+    using KeyType = DiscreteCost;
+    using ItemType = Index;
+
+    KeyType distance;
+    ItemType state;
+
+    KeyType get_key() const { return distance; }
+    ItemType get_item() const { return state; }
+};
+
+bool holds(const AbstractFactList& positive_facts, const AbstractFactList& negative_facts, const IndexList& values)
+{
+    return std::all_of(positive_facts.begin(), positive_facts.end(), [&values](auto&& fact) { return values[fact.position] == fact.value; })
+           && std::none_of(negative_facts.begin(), negative_facts.end(), [&values](auto&& fact) { return values[fact.position] == fact.value; });
+}
+
+/// @brief `AbstractTransitionSystem` generates the abstract transitions of the projection onto a pattern.
+class AbstractTransitionSystem
+{
+public:
+    AbstractTransitionSystem(const TaskImpl& task, const Pattern& pattern) :
+        m_domain_sizes(),
+        m_multipliers(),
+        m_operators(),
+        m_bucket_offsets(),
+        m_buckets(),
+        m_positive_goals(),
+        m_negative_goals()
+    {
+        const auto& variables = task.get_variables();
+
+        auto variable_to_position = IndexList(variables.size(), MAX_INDEX);
+        auto multiplier = size_t(1);
+        for (Index position = 0; position < pattern.size(); ++position)
+        {
+            variable_to_position[pattern[position]] = position;
+            m_domain_sizes.push_back(variables[pattern[position]].get_domain_size());
+            m_multipliers.push_back(multiplier);
+            multiplier *= m_domain_sizes.back();
+        }
+
+        const auto project = [&variable_to_position](const FactList& facts, AbstractFactList& out_facts)
+        {
+            auto is_projected = true;
+            for (const auto& fact : facts)
+            {
+                if (variable_to_position[fact.variable] == MAX_INDEX)
+                    is_projected = false;
+                else
+                    out_facts.push_back(AbstractFact { variable_to_position[fact.variable], fact.value });
+            }
+            return is_projected;
+        };
+
+        for (Index op_index = 0; op_index < task.get_operators().size(); ++op_index)
+        {
+            const auto& op = task.get_operators()[op_index];
+            const auto& affected_variables = task.get_affected_variables()[op_index];
+            if (std::none_of(affected_variables.begin(),
+                             affected_variables.end(),
+                             [&variable_to_position](auto&& variable) { return variable_to_position[variable] != MAX_INDEX; }))
+                continue;
+
+            auto abstract_op = AbstractOperator { op.cost, AbstractFactList {}, AbstractFactList {}, std::vector<AbstractEffect> {}, IndexList {} };
+            project(op.positive_preconditions, abstract_op.positive_preconditions);
+            project(op.negative_preconditions, abstract_op.negative_preconditions);
+            for (const auto& effect : op.effects)
+            {
+                auto abstract_effect = AbstractEffect {};
+                project(effect.add_facts, abstract_effect.add_facts);
+                project(effect.delete_facts, abstract_effect.delete_facts);
+                if (abstract_effect.add_facts.empty() && abstract_effect.delete_facts.empty())
+                    continue;
+
+                const auto is_positive_projected = project(effect.positive_conditions, abstract_effect.positive_conditions);
+                const auto is_negative_projected = project(effect.negative_conditions, abstract_effect.negative_conditions);
+                abstract_effect.is_uncertain = effect.has_unknown_condition || !is_positive_projected || !is_negative_projected;
+
+                for (const auto& fact : abstract_effect.add_facts)
+                    abstract_op.affected_positions.push_back(fact.position);
+                for (const auto& fact : abstract_effect.delete_facts)
+                    abstract_op.affected_positions.push_back(fact.position);
+
+                abstract_op.effects.push_back(std::move(abstract_effect));
+            }
+            std::sort(abstract_op.affected_positions.begin(), abstract_op.affected_positions.end());
+            abstract_op.affected_positions.erase(std::unique(abstract_op.affected_positions.begin(), abstract_op.affected_positions.end()),
+                                                 abstract_op.affected_positions.end());
+
+            m_operators.push_back(std::move(abstract_op));
+        }
+
+        // Index the operators by their first positive precondition such that each state only tests operators whose first precondition holds.
+        m_bucket_offsets.push_back(0);
+        for (const auto domain_size : m_domain_sizes)
+        {
+            m_bucket_offsets.push_back(m_bucket_offsets.back() + domain_size);
+        }
+        m_buckets.resize(m_bucket_offsets.back() + 1);
+        for (Index op_index = 0; op_index < m_operators.size(); ++op_index)
+        {
+            const auto& preconditions = m_operators[op_index].positive_preconditions;
+            const auto bucket =
+                preconditions.empty() ? m_bucket_offsets.back() : m_bucket_offsets[preconditions.front().position] + preconditions.front().value;
+            m_buckets[bucket].push_back(op_index);
+        }
+
+        project(task.get_positive_goals(), m_positive_goals);
+        project(task.get_negative_goals(), m_negative_goals);
+    }
+
+    /// @brief Generate the abstract transitions into other states in the order of the states and write them into `out_edges`.
+    void generate_edges(size_t num_states, std::vector<Edge>& out_edges)
+    {
+        auto values = IndexList(m_domain_sizes.size(), 0);
+        for (size_t state = 0; state < num_states; ++state)
+        {
+            for (Index position = 0; position < values.size(); ++position)
+            {
+                for (const auto op_index : m_buckets[m_bucket_offsets[position] + values[position]])
+                {
+                    generate_edges(m_operators[op_index], values, state, out_edges);
+                }
+            }
+            for (const auto op_index : m_buckets.back())
+            {
+                generate_edges(m_operators[op_index], values, state, out_edges);
+            }
+
+            increment(values);
+        }
+    }
+
+    /// @brief Collect the abstract goal states.
+    void generate_goal_states(size_t num_states, IndexList& out_goal_states) const
+    {
+        auto values = IndexList(m_domain_sizes.size(), 0);
+        for (size_t state = 0; state < num_states; ++state)
+        {
+            if (holds(m_positive_goals, m_negative_goals, values))
+                out_goal_states.push_back(state);
+
+            increment(values);
+        }
+    }
+
+    const IndexList& get_multipliers() const { return m_multipliers; }
+
+private:
+    void increment(IndexList& ref_values) const
+    {
+        for (Index position = 0; position < ref_values.size(); ++position)
+        {
+            if (++ref_values[position] < m_domain_sizes[position])
+                return;
+            ref_values[position] = 0;
+        }
+    }
+
+    void generate_edges(const AbstractOperator& op, const IndexList& values, size_t state, std::vector<Edge>& out_edges)
+    {
+        if (!holds(op.positive_preconditions, op.negative_preconditions, values))
+            return;
+
+        // Collect the possible values of each affected variable in the successor, where deletes are applied before adds.
+        const auto num_affected = op.affected_positions.size();
+        m_certain_adds.assign(num_affected, MAX_INDEX);
+        m_uncertain_adds.assign(num_affected, MAX_INDEX);
+        m_certain_deletes.assign(num_affected, false);
+        m_uncertain_deletes.assign(num_affected, false);
+        const auto to_affected_index = [&op](Index position)
+        { return std::lower_bound(op.affected_positions.begin(), op.affected_positions.end(), position) - op.affected_positions.begin(); };
+
+        for (const auto& effect : op.effects)
+        {
+            if (!holds(effect.positive_conditions, effect.negative_conditions, values))
+                continue;
+
+            for (const auto& fact : effect.add_facts)
+            {
+                (effect.is_uncertain ? m_uncertain_adds : m_certain_adds)[to_affected_index(fact.position)] = fact.value;
+            }
+            for (const auto& fact : effect.delete_facts)
+            {
+                if (values[fact.position] == fact.value)
+                    (effect.is_uncertain ? m_uncertain_deletes : m_certain_deletes)[to_affected_index(fact.position)] = true;
+            }
+        }
+
+        m_options.clear();
+        m_option_offsets.assign(1, 0);
+        for (size_t i = 0; i < num_affected; ++i)
+        {
+            const auto position = op.affected_positions[i];
+            const auto none_value = m_domain_sizes[position] - 1;
+            if (m_certain_adds[i] != MAX_INDEX)
+            {
+                m_options.push_back(m_certain_adds[i]);
+            }
+            else
+            {
+                if (m_uncertain_adds[i] != MAX_INDEX)
+                    m_options.push_back(m_uncertain_adds[i]);
+                if (m_certain_deletes[i])
+                {
+                    m_options.push_back(none_value);
+                }
+                else
+                {
+                    m_options.push_back(values[position]);
+                    if (m_uncertain_deletes[i])
+                        m_options.push_back(none_value);
+                }
+            }
+            std::sort(m_options.begin() + m_option_offsets.back(), m_options.end());
+            m_options.erase(std::unique(m_options.begin() + m_option_offsets.back(), m_options.end()), m_options.end());
+            m_option_offsets.push_back(m_options.size());
+        }
+
+        // Enumerate the combinations of the possible values.
+        m_choices.assign(num_affected, 0);
+        while (true)
+        {
+            auto successor = state;
+            for (size_t i = 0; i < num_affected; ++i)
+            {
+                const auto position = op.affected_positions[i];
+                successor += m_multipliers[position] * m_options[m_option_offsets[i] + m_choices[i]];
+                successor -= m_multipliers[position] * values[position];
+            }
+            if (successor != state)
+                out_edges.push_back(Edge { static_cast<Index>(state), static_cast<Index>(successor), op.cost });
+
+            auto i = size_t(0);
+            for (; i < num_affected; ++i)
+            {
+                if (++m_choices[i] < m_option_offsets[i + 1] - m_option_offsets[i])
+                    break;
+                m_choices[i] = 0;
+            }
+            if (i == num_affected)
+                break;
+        }
+    }
+
+    IndexList m_domain_sizes;
+    IndexList m_multipliers;
+    std::vector<AbstractOperator> m_operators;
+    IndexList m_bucket_offsets;
+    std::vector<IndexList> m_buckets;  ///< The operators indexed by their first positive precondition, followed by those without positive preconditions.
+    AbstractFactList m_positive_goals;
+    AbstractFactList m_negative_goals;
+
+    /* Memory for reuse */
+    IndexList m_certain_adds;
+    IndexList m_uncertain_adds;
+    std::vector<bool> m_certain_deletes;
+    std::vector<bool> m_uncertain_deletes;
+    IndexList m_options;
+    IndexList m_option_offsets;
+    IndexList m_choices;
+};
+
+/**
+ * File format
+ */
+
+/// @brief `FileHeader` is followed by the pattern, the domain sizes of the pattern variables, and the words of the distances, all as 64-bit integers.
+struct FileHeader
+{
+    uint64_t magic;
+    uint64_t version;
+    uint64_t task_fingerprint;
+    uint64_t num_variables;
+    uint64_t bit_width;
+    uint64_t num_abstract_states;
+    uint64_t num_words;
+};
+
+constexpr uint64_t FILE_MAGIC = 0x42445052494d494dULL;  // "MIMIRPDB" in little endian
+constexpr uint64_t FILE_VERSION = 1;
+}
+
+/**
+ * PatternDatabase
+ */
+
+PatternDatabaseImpl::PatternDatabaseImpl(const TaskImpl& task, Pattern pattern) : m_pattern(std::move(pattern)), m_multipliers(), m_distances()
+{
+    if (!std::is_sorted(m_pattern.begin(), m_pattern.end()) || std::adjacent_find(m_pattern.begin(), m_pattern.end()) != m_pattern.end())
+        throw std::runtime_error("PatternDatabaseImpl::PatternDatabaseImpl: Pattern must be sorted and free of duplicates.");
+    if (!m_pattern.empty() && m_pattern.back() >= task.get_variables().size())
+        throw std::runtime_error("PatternDatabaseImpl::PatternDatabaseImpl: Pattern contains an unknown variable.");
+
+    const auto num_states = compute_num_abstract_states(task, m_pattern);
+    if (num_states >= MAX_INDEX)
+        throw std::runtime_error("PatternDatabaseImpl::PatternDatabaseImpl: Too many abstract states.");
+
+    auto transition_system = AbstractTransitionSystem(task, m_pattern);
+    m_multipliers = transition_system.get_multipliers();
+
+    /* Backward edges in compressed sparse row format. */
+    auto edges = std::vector<Edge> {};
+    transition_system.generate_edges(num_states, edges);
+
+    auto predecessor_offsets = IndexList(num_states + 1, 0);
+    for (const auto& edge : edges)
+    {
+        ++predecessor_offsets[edge.target + 1];
+    }
+    std::partial_sum(predecessor_offsets.begin(), predecessor_offsets.end(), predecessor_offsets.begin());
+    auto predecessors = std::vector<std::pair<Index, DiscreteCost>>(edges.size());
+    auto positions = IndexList(predecessor_offsets.begin(), predecessor_offsets.end() - 1);
+    for (const auto& edge : edges)
+    {
+        predecessors[positions[edge.target]++] = { edge.source, edge.cost };
+    }
+    edges = std::vector<Edge> {};
+
+    /* Backward Dijkstra from the abstract goal states. */
+    auto distances = std::vector<DiscreteCost>(num_states, MAX_DISCRETE_COST);
+    auto queue = PriorityQueue<QueueEntry> {};
+    auto goal_states = IndexList {};
+    transition_system.generate_goal_states(num_states, goal_states);
+    for (const auto state : goal_states)
+    {
+        distances[state] = 0;
+        queue.insert(QueueEntry { 0, state });
+    }
+    while (!queue.empty())
+    {
+        const auto [distance, state] = queue.top_entry();
+        queue.pop();
+        if (distance > distances[state])
+            continue;
+
+        for (auto i = predecessor_offsets[state]; i < predecessor_offsets[state + 1]; ++i)
+        {
+            const auto [predecessor, cost] = predecessors[i];
+            const auto predecessor_distance = distance + cost;
+            if (predecessor_distance < distances[predecessor])
+            {
+                distances[predecessor] = predecessor_distance;
+                queue.insert(QueueEntry { predecessor_distance, predecessor });
+            }
+        }
+    }
+
+    /* Bit packing, where the largest value of the bit width represents infinity. */
+    auto max_distance = DiscreteCost(0);
+    for (const auto distance : distances)
+    {
+        if (distance != MAX_DISCRETE_COST)
+            max_distance = std::max(max_distance, distance);
+    }
+    m_distances = BitPackedArray(num_states, std::bit_width(static_cast<uint64_t>(max_distance) + 1));
+    for (size_t state = 0; state < num_states; ++state)
+    {
+        m_distances.set(state, (distances[state] == MAX_DISCRETE_COST) ? m_distances.get_max_value() : static_cast<uint64_t>(distances[state]));
+    }
+}
+
+PatternDatabaseImpl::PatternDatabaseImpl(Pattern pattern, IndexList multipliers, BitPackedArray distances) :
+    m_pattern(std::move(pattern)),
+    m_multipliers(std::move(multipliers)),
+    m_distances(std::move(distances))
+{
+}
+
+PatternDatabase PatternDatabaseImpl::create(const TaskImpl& task, Pattern pattern)
+{
+    return std::make_shared<const PatternDatabaseImpl>(task, std::move(pattern));
+}
+
+PatternDatabase PatternDatabaseImpl::create(const TaskImpl& task, Pattern pattern, const fs::path& cache_directory)
+{
+    const auto file = get_cache_file(task, pattern, cache_directory);
+    if (auto pdb = load(task, pattern, file))
+        return pdb;
+
+    auto pdb = create(task, std::move(pattern));
+    fs::create_directories(cache_directory);
+    pdb->save(task, file);
+    return pdb;
+}
+
+PatternDatabase PatternDatabaseImpl::load(const TaskImpl& task, const Pattern& pattern, const fs::path& file)
+{
+    if (!fs::exists(file))
+        return nullptr;
+
+    auto mapping = std::shared_ptr<cista::mmap>(nullptr);
+    try
+    {
+        mapping = std::make_shared<cista::mmap>(file.c_str(), cista::mmap::protection::READ);
+    }
+    catch (const std::exception&)
+    {
+        return nullptr;
+    }
+
+    const auto read_word = [&mapping](size_t word)
+    {
+        auto value = uint64_t(0);
+        std::memcpy(&value, mapping->data() + word * sizeof(uint64_t), sizeof(uint64_t));
+        return value;
+    };
+
+    constexpr auto num_header_words = sizeof(FileHeader) / sizeof(uint64_t);
+    if (mapping->size() < sizeof(FileHeader))
+        return nullptr;
+    auto header = FileHeader {};
+    std::memcpy(&header, mapping->data(), sizeof(FileHeader));
+
+    const auto num_states = compute_num_abstract_states(task, pattern);
+    if (header.magic != FILE_MAGIC || header.version != FILE_VERSION || header.task_fingerprint != task.get_fingerprint()
+        || header.num_variables != pattern.size() || header.bit_width == 0 || header.bit_width > 64 || header.num_abstract_states != num_states
+        || header.num_words != BitPackedArray::compute_num_words(num_states, header.bit_width)
+        || mapping->size() != (num_header_words + 2 * pattern.size() + header.num_words) * sizeof(uint64_t))
+        return nullptr;
+
+    auto multipliers = IndexList {};
+    auto multiplier = size_t(1);
+    for (size_t i = 0; i < pattern.size(); ++i)
+    {
+        const auto domain_size = task.get_variables()[pattern[i]].get_domain_size();
+        if (read_word(num_header_words + i) != pattern[i] || read_word(num_header_words + pattern.size() + i) != domain_size)
+            return nullptr;
+
+        multipliers.push_back(multiplier);
+        multiplier *= domain_size;
+    }
+
+    // The mapping starts at a page boundary and all fields are 64-bit integers, so the words are aligned.
+    const auto words = reinterpret_cast<const uint64_t*>(mapping->data()) + num_header_words + 2 * pattern.size();
+    return std::make_shared<const PatternDatabaseImpl>(pattern,
+                                                       std::move(multipliers),
+                                                       BitPackedArray(num_states, header.bit_width, words, std::shared_ptr<const void>(std::move(mapping))));
+}
+
+void PatternDatabaseImpl::save(const TaskImpl& task, const fs::path& file) const
+{
+    const auto header = FileHeader { FILE_MAGIC,
+                                     FILE_VERSION,
+                                     task.get_fingerprint(),
+                                     m_pattern.size(),
+                                     m_distances.get_bit_width(),
+                                     m_distances.size(),
+                                     m_distances.get_words().size() };
+
+    // Concurrent runs never map a partially written file.
+    write_to_file_atomically(file,
+                             [&](std::ostream& out)
+                             {
+                                 const auto write_word = [&out](uint64_t value) { out.write(reinterpret_cast<const char*>(&value), sizeof(uint64_t)); };
+
+                                 out.write(reinterpret_cast<const char*>(&header), sizeof(FileHeader));
+                                 for (const auto variable : m_pattern)
+                                 {
+                                     write_word(variable);
+                                 }
+                                 for (const auto variable : m_pattern)
+                                 {
+                                     write_word(task.get_variables()[variable].get_domain_size());
+                                 }
+                                 const auto words = m_distances.get_words();
+                                 out.write(reinterpret_cast<const char*>(words.data()), words.size() * sizeof(uint64_t));
+                             });
+}
+
+fs::path PatternDatabaseImpl::get_cache_file(const TaskImpl& task, const Pattern& pattern, const fs::path& cache_directory)
+{
+    auto hasher = StableHasher {};
+    hasher.add(pattern.size());
+    for (const auto variable : pattern)
+    {
+        hasher.add(variable);
+    }
+
+    auto ss = std::stringstream {};
+    ss << "pdb-" << std::hex << std::setfill('0') << std::setw(16) << task.get_fingerprint() << "-" << std::setw(16) << hasher.get() << ".bin";
+    return cache_directory / ss.str();
+}
+
+size_t PatternDatabaseImpl::compute_num_abstract_states(const TaskImpl& task, const Pattern& pattern)
+{
+    auto num_states = size_t(1);
+    for (const auto variable : pattern)
+    {
+        const auto domain_size = task.get_variables()[variable].get_domain_size();
+        if (num_states > std::numeric_limits<size_t>::max() / domain_size)
+            return std::numeric_limits<size_t>::max();
+        num_states *= domain_size;
+    }
+    return num_states;
+}
+
+const Pattern& PatternDatabaseImpl::get_pattern() const { return m_pattern; }
+
+size_t PatternDatabaseImpl::get_num_abstract_states() const { return m_distances.size(); }
+
+const BitPackedArray& PatternDatabaseImpl::get_distances() const { return m_distances; }
+
+}
@@ -0,0 +1,329 @@
+/*
+ * Copyright (C) 2023 Dominik Drexler and Simon Stahlberg
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "mimir/search/heuristics/pdb/pattern_generation.hpp"
+
+#include "mimir/common/timers.hpp"
+#include "mimir/search/applicable_action_generators/interface.hpp"
+#include "mimir/search/delete_relaxed_problem_explorator.hpp"
+#include "mimir/search/heuristics/pdb/pattern_collection.hpp"
+#include "mimir/search/heuristics/pdb/pattern_database.hpp"
+#include "mimir/search/heuristics/pdb/task.hpp"
+#include "mimir/search/state.hpp"
+#include "mimir/search/state_repository.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <deque>
+#include <map>
+#include <random>
+#include <set>
+
+using namespace mimir::formalism;
+
+namespace mimir::search::pdb
+{
+
+static IndexList compute_goal_variables(const TaskImpl& task)
+{
+    auto goal_variables = IndexList {};
+    for (const auto& facts : { task.get_positive_goals(), task.get_negative_goals() })
+    {
+        for (const auto& fact : facts)
+        {
+            if (std::find(goal_variables.begin(), goal_variables.end(), fact.variable) == goal_variables.end())
+                goal_variables.push_back(fact.variable);
+        }
+    }
+    return goal_variables;
+}
+
+Pattern compute_greedy_pattern(const TaskImpl& task, size_t max_num_abstract_states)
+{
+    const auto predecessors = task.compute_causal_graph_predecessors();
+    const auto& variables = task.get_variables();
+
+    auto pattern = Pattern {};
+    auto is_visited = std::vector<bool>(variables.size(), false);
+    auto num_abstract_states = size_t(1);
+    auto queue = std::deque<Index> {};
+    for (const auto variable : compute_goal_variables(task))
+    {
+        is_visited[variable] = true;
+        queue.push_back(variable);
+    }
+    while (!queue.empty())
+    {
+        const auto variable = queue.front();
+        queue.pop_front();
+
+        const auto domain_size = variables[variable].get_domain_size();
+        if (num_abstract_states > max_num_abstract_states / domain_size)
+            continue;
+
+        num_abstract_states *= domain_size;
+        pattern.push_back(variable);
+        for (const auto predecessor : predecessors[variable])
+        {
+            if (!is_visited[predecessor])
+            {
+                is_visited[predecessor] = true;
+                queue.push_back(predecessor);
+            }
+        }
+    }
+    std::sort(pattern.begin(), pattern.end());
+    return pattern;
+}
+
+PatternDatabase create_pattern_database(const TaskImpl& task, Pattern pattern, const std::optional<fs::path>& cache_directory)
+{
+    return cache_directory.has_value() ? PatternDatabaseImpl::create(task, std::move(pattern), cache_directory.value()) :
+                                         PatternDatabaseImpl::create(task, std::move(pattern));
+}
+
+namespace
+{
+/// @brief `StateSampler` samples states with random walks from the initial state.
+class StateSampler
+{
+public:
+    StateSampler(const TaskImpl& task, const DeleteRelaxedProblemExplorator& delete_relaxation, uint32_t random_seed) :
+        m_task(task),
+        m_applicable_action_generator(delete_relaxation.create_grounded_applicable_action_generator()),
+        m_state_repository(StateRepositoryImpl::create(delete_relaxation.create_grounded_axiom_evaluator())),
+        m_rng(random_seed),
+        m_average_operator_cost(1.)
+    {
+        if (!task.get_operators().empty())
+        {
+            auto total_cost = 0.;
+            for (const auto& op : task.get_operators())
+            {
+                total_cost += op.cost;
+            }
+            m_average_operator_cost = std::max(1., total_cost / task.get_operators().size());
+        }
+    }
+
+    /// @brief Sample the variable values of states, where the random walks stop early at states without applicable actions or dead ends.
+    /// @return false iff the initial state is a dead end.
+    bool sample(const CanonicalPatternCollection& collection, size_t num_samples, std::vector<IndexList>& out_samples)
+    {
+        out_samples.clear();
+
+        const auto [initial_state, initial_metric_value] = m_state_repository->get_or_create_initial_state();
+        m_task.compute_values(initial_state, m_values);
+        collection.compute_distances(m_values, m_distances);
+        const auto initial_h = collection.combine_distances(m_distances);
+        if (initial_h == MAX_DISCRETE_COST)
+            return false;
+
+        // The length of a walk is binomially distributed with a mean of twice the estimated solution length.
+        const auto estimated_length = static_cast<int>(std::ceil(initial_h / m_average_operator_cost));
+        auto length_distribution = std::binomial_distribution<int>(4 * estimated_length, 0.5);
+
+        for (size_t i = 0; i < num_samples; ++i)
+        {
+            auto state = initial_state;
+            auto metric_value = initial_metric_value;
+            const auto length = length_distribution(m_rng);
+            for (int step = 0; step < length; ++step)
+            {
+                m_actions.clear();
+                for (const auto& action : m_applicable_action_generator->create_applicable_action_generator(state))
+                {
+                    m_actions.push_back(action);
+                }
+                if (m_actions.empty())
+                    break;
+
+                const auto action = m_actions[std::uniform_int_distribution<size_t>(0, m_actions.size() - 1)(m_rng)];
+                const auto [successor_state, successor_metric_value] = m_state_repository->get_or_create_successor_state(state, action, metric_value);
+
+                m_task.compute_values(successor_state, m_values);
+                collection.compute_distances(m_values, m_distances);
+                if (collection.combine_distances(m_distances) == MAX_DISCRETE_COST)
+                    break;
+
+                state = successor_state;
+                metric_value = successor_metric_value;
+            }
+
+            m_task.compute_values(state, m_values);
+            out_samples.push_back(m_values);
+        }
+        return true;
+    }
+
+private:
+    const TaskImpl& m_task;
+    ApplicableActionGenerator m_applicable_action_generator;
+    StateRepository m_state_repository;
+    std::mt19937 m_rng;
+    double m_average_operator_cost;
+
+    /* Memory for reuse */
+    GroundActionList m_actions;
+    IndexList m_values;
+    std::vector<DiscreteCost> m_distances;
+};
+}
+
+PatternDatabaseList compute_patterns_by_hill_climbing(const TaskImpl& task,
+                                                      const DeleteRelaxedProblemExplorator& delete_relaxation,
+                                                      const HillClimbingOptions& options,
+                                                      const std::optional<fs::path>& cache_directory)
+{
+    auto stop_watch = StopWatch(options.max_time_ms);
+    stop_watch.start();
+
+    const auto predecessors = task.compute_causal_graph_predecessors();
+
+    /* Initial collection */
+    auto pattern_databases = PatternDatabaseList {};
+    auto num_abstract_states = size_t(0);
+    for (const auto variable : compute_goal_variables(task))
+    {
+        const auto pattern = Pattern { variable };
+        const auto num_pattern_states = PatternDatabaseImpl::compute_num_abstract_states(task, pattern);
+        if (num_pattern_states > options.max_num_abstract_states_per_pattern || num_abstract_states + num_pattern_states > options.max_num_abstract_states)
+            continue;
+
+        pattern_databases.push_back(create_pattern_database(task, pattern, cache_directory));
+        num_abstract_states += num_pattern_states;
+    }
+
+    if (task.is_unsolvable())
+        return pattern_databases;
+
+    /* Candidates */
+    auto candidates = PatternList {};
+    auto generated_patterns = std::set<Pattern> {};
+    auto candidate_pattern_databases = std::map<Pattern, PatternDatabase> {};
+    const auto generate_candidates = [&](const Pattern& pattern)
+    {
+        for (const auto variable : pattern)
+        {
+            for (const auto predecessor : predecessors[variable])
+            {
+                if (std::binary_search(pattern.begin(), pattern.end(), predecessor))
+                    continue;
+
+                auto candidate = pattern;
+                candidate.insert(std::lower_bound(candidate.begin(), candidate.end(), predecessor), predecessor);
+                if (PatternDatabaseImpl::compute_num_abstract_states(task, candidate) > options.max_num_abstract_states_per_pattern)
+                    continue;
+                if (generated_patterns.insert(candidate).second)
+                    candidates.push_back(std::move(candidate));
+            }
+        }
+    };
+    for (const auto& pdb : pattern_databases)
+    {
+        generate_candidates(pdb->get_pattern());
+    }
+
+    /* Hill climbing */
+    auto sampler = StateSampler(task, delete_relaxation, options.random_seed);
+    auto samples = std::vector<IndexList> {};
+    auto sample_distances = std::vector<std::vector<DiscreteCost>>(options.num_samples);
+    auto sample_h_values = std::vector<DiscreteCost>(options.num_samples);
+    auto is_additive = std::vector<bool> {};
+
+    while (!stop_watch.has_finished() && !candidates.empty())
+    {
+        const auto collection = CanonicalPatternCollection(task, pattern_databases);
+        if (!sampler.sample(collection, options.num_samples, samples))
+            break;
+
+        for (size_t i = 0; i < samples.size(); ++i)
+        {
+            collection.compute_distances(samples[i], sample_distances[i]);
+            sample_h_values[i] = collection.combine_distances(sample_distances[i]);
+        }
+
+        auto best_candidate = candidates.size();
+        auto best_num_improvements = size_t(0);
+        for (size_t candidate_index = 0; candidate_index < candidates.size() && !stop_watch.has_finished(); ++candidate_index)
+        {
+            const auto& candidate = candidates[candidate_index];
+            if (num_abstract_states + PatternDatabaseImpl::compute_num_abstract_states(task, candidate) > options.max_num_abstract_states)
+                continue;
+
+            auto& candidate_pdb = candidate_pattern_databases[candidate];
+            if (!candidate_pdb)
+                candidate_pdb = create_pattern_database(task, candidate, cache_directory);
+
+            const auto affecting_operators = compute_affecting_operators(task, candidate);
+            is_additive.resize(pattern_databases.size());
+            for (size_t i = 0; i < pattern_databases.size(); ++i)
+            {
+                is_additive[i] = are_additive(affecting_operators, collection.get_affecting_operators()[i]);
+            }
+
+            // Each maximal additive set with the candidate is the candidate together with the members of an old maximal additive set that are additive with it.
+            auto num_improvements = size_t(0);
+            for (size_t i = 0; i < samples.size(); ++i)
+            {
+                if (sample_h_values[i] == MAX_DISCRETE_COST)
+                    continue;
+
+                const auto candidate_distance = candidate_pdb->get_distance(samples[i]);
+                if (candidate_distance == MAX_DISCRETE_COST)
+                {
+                    ++num_improvements;
+                    continue;
+                }
+
+                auto h_value = candidate_distance;
+                for (const auto& additive_set : collection.get_maximal_additive_sets())
+                {
+                    auto sum = candidate_distance;
+                    for (const auto j : additive_set)
+                    {
+                        if (is_additive[j])
+                            sum += sample_distances[i][j];
+                    }
+                    h_value = std::max(h_value, sum);
+                }
+                if (h_value > sample_h_values[i])
+                    ++num_improvements;
+            }
+
+            if (num_improvements > best_num_improvements)
+            {
+                best_candidate = candidate_index;
+                best_num_improvements = num_improvements;
+            }
+        }
+
+        if (best_candidate == candidates.size() || best_num_improvements < options.min_improvement)
+            break;
+
+        const auto best_pattern = candidates[best_candidate];
+        pattern_databases.push_back(candidate_pattern_databases.at(best_pattern));
+        num_abstract_states += pattern_databases.back()->get_num_abstract_states();
+        candidate_pattern_databases.erase(best_pattern);
+        candidates.erase(candidates.begin() + best_candidate);
+        generate_candidates(best_pattern);
+    }
+
+    return pattern_databases;
+}
+
+}
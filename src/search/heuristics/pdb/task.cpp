@@ -0,0 +1,643 @@
+/*
+ * Copyright (C) 2023 Dominik Drexler and Simon Stahlberg
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "mimir/search/heuristics/pdb/task.hpp"
+
+#include "mimir/formalism/ground_action.hpp"
+#include "mimir/formalism/ground_atom.hpp"
+#include "mimir/formalism/ground_conjunctive_condition.hpp"
+#include "mimir/formalism/ground_effects.hpp"
+#include "mimir/formalism/object.hpp"
+#include "mimir/formalism/predicate.hpp"
+#include "mimir/formalism/problem.hpp"
+#include "mimir/formalism/repositories.hpp"
+#include "mimir/search/applicability.hpp"
+#include "mimir/search/delete_relaxed_problem_explorator.hpp"
+#include "mimir/search/heuristics/action_cost.hpp"
+#include "mimir/search/heuristics/pdb/stable_hash.hpp"
+#include "mimir/search/state.hpp"
+
+#include <algorithm>
+#include <map>
+#include <queue>
+#include <set>
+#include <sstream>
+
+using namespace mimir::formalism;
+
+namespace mimir::search::pdb
+{
+
+/**
+ * Mutex groups
+ */
+
+/// @brief The maximum number of verification steps for the candidate grown from a single seed.
+static constexpr size_t MAX_NUM_REFINEMENT_STEPS = 64;
+
+namespace
+{
+struct MutexEffect
+{
+    IndexList conditions;
+    IndexList adds;
+    IndexList deletes;
+};
+
+struct MutexAction
+{
+    IndexList preconditions;
+    std::vector<MutexEffect> effects;
+    IndexList unconditional_deletes;  ///< Sorted.
+};
+
+struct Adder
+{
+    Index action;
+    Index effect;
+};
+
+class MutexGroupSynthesis
+{
+public:
+    MutexGroupSynthesis(const ProblemImpl& problem, const GroundActionList& actions, const IndexList& atoms) :
+        m_actions(),
+        m_adders(),
+        m_is_atom(),
+        m_is_initial(),
+        m_in_group()
+    {
+        const auto num_atoms = atoms.empty() ? size_t(0) : static_cast<size_t>(atoms.back()) + 1;
+        m_adders.resize(num_atoms);
+        m_is_atom.resize(num_atoms, false);
+        m_is_initial.resize(num_atoms, false);
+        m_in_group.resize(num_atoms, false);
+
+        for (const auto atom : atoms)
+        {
+            m_is_atom[atom] = true;
+        }
+        for (const auto& atom : problem.get_fluent_initial_atoms())
+        {
+            m_is_initial[atom->get_index()] = true;
+        }
+
+        const auto& static_atoms = problem.get_static_initial_positive_atoms_bitset();
+
+        for (const auto& action : actions)
+        {
+            auto mutex_action = MutexAction {};
+
+            const auto conjunctive_condition = action->get_conjunctive_condition();
+            auto is_reachable = true;
+            for (const auto atom : conjunctive_condition->get_precondition<PositiveTag, FluentTag>())
+            {
+                is_reachable &= is_atom(atom);
+                mutex_action.preconditions.push_back(atom);
+            }
+            if (!is_reachable)
+                continue;
+
+            for (const auto& cond_effect : action->get_conditional_effects())
+            {
+                const auto effect_condition = cond_effect->get_conjunctive_condition();
+                if (!is_statically_applicable(effect_condition, static_atoms))
+                    continue;
+
+                auto effect = MutexEffect {};
+                auto is_satisfiable = true;
+                for (const auto atom : effect_condition->get_precondition<PositiveTag, FluentTag>())
+                {
+                    is_satisfiable &= is_atom(atom);
+                    effect.conditions.push_back(atom);
+                }
+                if (!is_satisfiable)
+                    continue;
+
+                for (const auto atom : cond_effect->get_conjunctive_effect()->get_propositional_effects<PositiveTag>())
+                {
+                    effect.adds.push_back(atom);
+                }
+                for (const auto atom : cond_effect->get_conjunctive_effect()->get_propositional_effects<NegativeTag>())
+                {
+                    effect.deletes.push_back(atom);
+                }
+
+                if (effect_condition->get_num_preconditions<FluentTag, DerivedTag>() == 0 && effect_condition->get_numeric_constraints().empty())
+                {
+                    mutex_action.unconditional_deletes.insert(mutex_action.unconditional_deletes.end(), effect.deletes.begin(), effect.deletes.end());
+                }
+                mutex_action.effects.push_back(std::move(effect));
+            }
+            std::sort(mutex_action.unconditional_deletes.begin(), mutex_action.unconditional_deletes.end());
+
+            const auto action_index = static_cast<Index>(m_actions.size());
+            for (Index effect_index = 0; effect_index < mutex_action.effects.size(); ++effect_index)
+            {
+                for (const auto atom : mutex_action.effects[effect_index].adds)
+                {
+                    m_adders[atom].push_back(Adder { action_index, effect_index });
+                }
+            }
+            m_actions.push_back(std::move(mutex_action));
+        }
+    }
+
+    /// @brief Extend the group to an invariant by adding deleted preconditions of violating actions.
+    /// @return true iff an invariant was found, in which case it is written into `ref_group`.
+    bool refine(IndexList& ref_group)
+    {
+        for (const auto atom : ref_group)
+        {
+            m_in_group[atom] = true;
+        }
+        auto num_remaining_steps = MAX_NUM_REFINEMENT_STEPS;
+        const auto is_invariant = refine_recursively(ref_group, num_remaining_steps);
+        for (const auto atom : ref_group)
+        {
+            m_in_group[atom] = false;
+        }
+        return is_invariant;
+    }
+
+    bool is_atom(Index atom) const { return atom < m_is_atom.size() && m_is_atom[atom]; }
+
+private:
+    bool in_group(Index atom) const { return atom < m_in_group.size() && m_in_group[atom]; }
+
+    bool is_deleted(const MutexAction& action, const MutexEffect& effect, Index atom) const
+    {
+        return std::binary_search(action.unconditional_deletes.begin(), action.unconditional_deletes.end(), atom)
+               || std::find(effect.deletes.begin(), effect.deletes.end(), atom) != effect.deletes.end();
+    }
+
+    enum class Verdict
+    {
+        INVARIANT,
+        REJECTED,
+        VIOLATED,
+    };
+
+    /// @brief Verify the group and collect the candidates that repair the first violating action.
+    Verdict verify(const IndexList& group, IndexList& out_candidates) const
+    {
+        out_candidates.clear();
+
+        if (std::count_if(group.begin(), group.end(), [this](auto&& atom) { return m_is_initial[atom]; }) > 1)
+            return Verdict::REJECTED;
+
+        for (const auto added_atom : group)
+        {
+            for (const auto& adder : m_adders[added_atom])
+            {
+                const auto& action = m_actions[adder.action];
+                const auto& effect = action.effects[adder.effect];
+
+                for (const auto& other_effect : action.effects)
+                {
+                    for (const auto atom : other_effect.adds)
+                    {
+                        if (atom != added_atom && in_group(atom))
+                            return Verdict::REJECTED;
+                    }
+                }
+
+                auto is_balanced = false;
+                const auto test_required_atom = [&](Index atom)
+                {
+                    if (in_group(atom))
+                    {
+                        is_balanced |= (atom == added_atom || is_deleted(action, effect, atom));
+                    }
+                    else if (is_deleted(action, effect, atom))
+                    {
+                        out_candidates.push_back(atom);
+                    }
+                };
+                std::for_each(action.preconditions.begin(), action.preconditions.end(), test_required_atom);
+                std::for_each(effect.conditions.begin(), effect.conditions.end(), test_required_atom);
+
+                if (!is_balanced)
+                {
+                    std::sort(out_candidates.begin(), out_candidates.end());
+                    out_candidates.erase(std::unique(out_candidates.begin(), out_candidates.end()), out_candidates.end());
+                    return Verdict::VIOLATED;
+                }
+                out_candidates.clear();
+            }
+        }
+        return Verdict::INVARIANT;
+    }
+
+    bool refine_recursively(IndexList& ref_group, size_t& ref_num_remaining_steps)
+    {
+        if (ref_num_remaining_steps == 0)
+            return false;
+        --ref_num_remaining_steps;
+
+        auto candidates = IndexList {};
+        switch (verify(ref_group, candidates))
+        {
+            case Verdict::INVARIANT:
+                return true;
+            case Verdict::REJECTED:
+                return false;
+            case Verdict::VIOLATED:
+                break;
+        }
+
+        for (const auto candidate : candidates)
+        {
+            ref_group.push_back(candidate);
+            m_in_group[candidate] = true;
+            if (refine_recursively(ref_group, ref_num_remaining_steps))
+                return true;
+            m_in_group[candidate] = false;
+            ref_group.pop_back();
+        }
+        return false;
+    }
+
+    std::vector<MutexAction> m_actions;
+    std::vector<std::vector<Adder>> m_adders;
+    std::vector<bool> m_is_atom;
+    std::vector<bool> m_is_initial;
+    std::vector<bool> m_in_group;
+};
+}
+
+std::vector<IndexList> compute_mutex_groups(const ProblemImpl& problem, const GroundActionList& actions, const IndexList& atoms)
+{
+    auto synthesis = MutexGroupSynthesis(problem, actions, atoms);
+
+    // Seed the candidates with the atoms of a predicate that agree on all arguments except one.
+    auto seeds = std::map<std::pair<Index, IndexList>, IndexList> {};
+    for (const auto atom_index : atoms)
+    {
+        const auto atom = problem.get_repositories().get_ground_atom<FluentTag>(atom_index);
+        const auto& objects = atom->get_objects();
+        for (size_t counted_position = 0; counted_position < objects.size(); ++counted_position)
+        {
+            auto key = IndexList {};
+            key.push_back(counted_position);
+            for (size_t position = 0; position < objects.size(); ++position)
+            {
+                if (position != counted_position)
+                    key.push_back(objects[position]->get_index());
+            }
+            seeds[{ atom->get_predicate()->get_index(), std::move(key) }].push_back(atom_index);
+        }
+    }
+
+    auto groups = std::set<IndexList> {};
+    auto covered = std::vector<bool>(atoms.empty() ? 0 : atoms.back() + 1, false);
+    for (auto& [key, seed] : seeds)
+    {
+        // A seed within an invariant that was found already most likely grows into the same invariant.
+        if (std::all_of(seed.begin(), seed.end(), [&covered](auto&& atom) { return covered[atom]; }))
+            continue;
+
+        auto group = seed;
+        if (!synthesis.refine(group))
+            continue;
+
+        std::sort(group.begin(), group.end());
+        for (const auto atom : group)
+        {
+            if (atom < covered.size())
+                covered[atom] = true;
+        }
+        if (group.size() > 1)
+            groups.insert(std::move(group));
+    }
+
+    return std::vector<IndexList>(groups.begin(), groups.end());
+}
+
+/**
+ * Task
+ */
+
+/// @brief Select disjoint variables from the mutex groups, where groups with most uncovered atoms are preferred,
+/// and complete them with binary variables.
+static VariableList select_variables(const std::vector<IndexList>& groups, const IndexList& atoms)
+{
+    auto variables = VariableList {};
+    auto covered = std::vector<bool>(atoms.empty() ? 0 : atoms.back() + 1, false);
+    const auto count_uncovered = [&covered](const IndexList& group)
+    { return static_cast<size_t>(std::count_if(group.begin(), group.end(), [&covered](auto&& atom) { return !covered[atom]; })); };
+
+    // The number of uncovered atoms only decreases, so outdated entries are reinserted lazily.
+    auto queue = std::priority_queue<std::pair<size_t, Index>> {};
+    for (Index i = 0; i < groups.size(); ++i)
+    {
+        queue.emplace(groups[i].size(), i);
+    }
+    while (!queue.empty())
+    {
+        const auto [num_uncovered, group_index] = queue.top();
+        queue.pop();
+
+        const auto actual_num_uncovered = count_uncovered(groups[group_index]);
+        if (actual_num_uncovered < 2)
+            continue;
+        if (actual_num_uncovered < num_uncovered)
+        {
+            queue.emplace(actual_num_uncovered, group_index);
+            continue;
+        }
+
+        auto variable = Variable {};
+        for (const auto atom : groups[group_index])
+        {
+            if (!covered[atom])
+            {
+                variable.atoms.push_back(atom);
+                covered[atom] = true;
+            }
+        }
+        variables.push_back(std::move(variable));
+    }
+
+    for (const auto atom : atoms)
+    {
+        if (!covered[atom])
+            variables.push_back(Variable { IndexList { atom } });
+    }
+
+    return variables;
+}
+
+TaskImpl::TaskImpl(const DeleteRelaxedProblemExplorator& delete_relaxation) :
+    m_problem(delete_relaxation.get_problem()),
+    m_variables(),
+    m_operators(),
+    m_positive_goals(),
+    m_negative_goals(),
+    m_affected_variables(),
+    m_atom_to_variable(),
+    m_atom_to_value(),
+    m_is_unsolvable(false),
+    m_fingerprint(0)
+{
+    const auto& problem = *m_problem;
+    const auto& static_atoms = problem.get_static_initial_positive_atoms_bitset();
+    const auto actions = delete_relaxation.create_ground_actions();
+
+    /* Collect the fluent atoms that can be true. */
+    auto atoms = IndexList {};
+    for (const auto& atom : problem.get_fluent_initial_atoms())
+    {
+        atoms.push_back(atom->get_index());
+    }
+    for (const auto& action : actions)
+    {
+        for (const auto& cond_effect : action->get_conditional_effects())
+        {
+            if (!is_statically_applicable(cond_effect->get_conjunctive_condition(), static_atoms))
+                continue;
+
+            for (const auto atom : cond_effect->get_conjunctive_effect()->get_propositional_effects<PositiveTag>())
+            {
+                atoms.push_back(atom);
+            }
+        }
+    }
+    std::sort(atoms.begin(), atoms.end());
+    atoms.erase(std::unique(atoms.begin(), atoms.end()), atoms.end());
+
+    /* Variables */
+    m_variables = select_variables(compute_mutex_groups(problem, actions, atoms), atoms);
+
+    m_atom_to_variable.assign(atoms.empty() ? 0 : atoms.back() + 1, MAX_INDEX);
+    m_atom_to_value.assign(m_atom_to_variable.size(), MAX_INDEX);
+    for (Index variable = 0; variable < m_variables.size(); ++variable)
+    {
+        const auto& variable_atoms = m_variables[variable].atoms;
+        for (Index value = 0; value < variable_atoms.size(); ++value)
+        {
+            m_atom_to_variable[variable_atoms[value]] = variable;
+            m_atom_to_value[variable_atoms[value]] = value;
+        }
+    }
+
+    const auto is_atom = [this](Index atom) { return atom < m_atom_to_variable.size() && m_atom_to_variable[atom] != MAX_INDEX; };
+    const auto to_fact = [this](Index atom) { return Fact { m_atom_to_variable[atom], m_atom_to_value[atom] }; };
+
+    /// @brief Translate the fluent literals, where positive literals over atoms that are never true make the condition unsatisfiable.
+    /// @return false iff the condition is unsatisfiable.
+    const auto translate_condition = [&](GroundConjunctiveCondition conjunctive_condition, FactList& out_positive, FactList& out_negative)
+    {
+        for (const auto atom : conjunctive_condition->get_precondition<PositiveTag, FluentTag>())
+        {
+            if (!is_atom(atom))
+                return false;
+            out_positive.push_back(to_fact(atom));
+        }
+        for (const auto atom : conjunctive_condition->get_precondition<NegativeTag, FluentTag>())
+        {
+            if (is_atom(atom))
+                out_negative.push_back(to_fact(atom));
+        }
+        return true;
+    };
+
+    /* Operators */
+    for (const auto& action : actions)
+    {
+        auto op = Operator { action, compute_discrete_action_cost(action, problem), FactList {}, FactList {}, EffectList {} };
+        if (!translate_condition(action->get_conjunctive_condition(), op.positive_preconditions, op.negative_preconditions))
+            continue;
+
+        for (const auto& cond_effect : action->get_conditional_effects())
+        {
+            const auto effect_condition = cond_effect->get_conjunctive_condition();
+            if (!is_statically_applicable(effect_condition, static_atoms))
+                continue;
+
+            auto effect = Effect {};
+            if (!translate_condition(effect_condition, effect.positive_conditions, effect.negative_conditions))
+                continue;
+            effect.has_unknown_condition =
+                effect_condition->get_num_preconditions<DerivedTag>() > 0 || !effect_condition->get_numeric_constraints().empty();
+            for (const auto atom : cond_effect->get_conjunctive_effect()->get_propositional_effects<PositiveTag>())
+            {
+                effect.add_facts.push_back(to_fact(atom));
+            }
+            for (const auto atom : cond_effect->get_conjunctive_effect()->get_propositional_effects<NegativeTag>())
+            {
+                if (is_atom(atom))
+                    effect.delete_facts.push_back(to_fact(atom));
+            }
+
+            if (!effect.add_facts.empty() || !effect.delete_facts.empty())
+                op.effects.push_back(std::move(effect));
+        }
+
+        if (op.effects.empty())
+            continue;
+
+        auto affected_variables = IndexList {};
+        for (const auto& effect : op.effects)
+        {
+            for (const auto& fact : effect.add_facts)
+                affected_variables.push_back(fact.variable);
+            for (const auto& fact : effect.delete_facts)
+                affected_variables.push_back(fact.variable);
+        }
+        std::sort(affected_variables.begin(), affected_variables.end());
+        affected_variables.erase(std::unique(affected_variables.begin(), affected_variables.end()), affected_variables.end());
+
+        m_operators.push_back(std::move(op));
+        m_affected_variables.push_back(std::move(affected_variables));
+    }
+
+    /* Goals */
+    for (const auto atom : problem.get_goal_atoms_indices<PositiveTag, FluentTag>())
+    {
+        if (is_atom(atom))
+            m_positive_goals.push_back(to_fact(atom));
+        else
+            m_is_unsolvable = true;
+    }
+    for (const auto atom : problem.get_goal_atoms_indices<NegativeTag, FluentTag>())
+    {
+        if (is_atom(atom))
+            m_negative_goals.push_back(to_fact(atom));
+    }
+
+    /* Fingerprint */
+    auto hasher = StableHasher {};
+    const auto add_facts = [&hasher](const FactList& facts)
+    {
+        hasher.add(facts.size());
+        for (const auto& fact : facts)
+        {
+            hasher.add(fact.variable);
+            hasher.add(fact.value);
+        }
+    };
+    hasher.add(m_variables.size());
+    for (const auto& variable : m_variables)
+    {
+        hasher.add(variable.atoms.size());
+        for (const auto atom : variable.atoms)
+        {
+            auto ss = std::stringstream {};
+            ss << problem.get_repositories().get_ground_atom<FluentTag>(atom);
+            hasher.add(ss.str());
+        }
+    }
+    hasher.add(m_operators.size());
+    for (const auto& op : m_operators)
+    {
+        hasher.add(static_cast<uint64_t>(op.cost));
+        add_facts(op.positive_preconditions);
+        add_facts(op.negative_preconditions);
+        hasher.add(op.effects.size());
+        for (const auto& effect : op.effects)
+        {
+            add_facts(effect.positive_conditions);
+            add_facts(effect.negative_conditions);
+            hasher.add(effect.has_unknown_condition);
+            add_facts(effect.add_facts);
+            add_facts(effect.delete_facts);
+        }
+    }
+    add_facts(m_positive_goals);
+    add_facts(m_negative_goals);
+    hasher.add(m_is_unsolvable);
+    m_fingerprint = hasher.get();
+}
+
+Task TaskImpl::create(const DeleteRelaxedProblemExplorator& delete_relaxation) { return std::make_shared<const TaskImpl>(delete_relaxation); }
+
+void TaskImpl::compute_values(const State& state, IndexList& out_values) const
+{
+    out_values.resize(m_variables.size());
+    for (Index variable = 0; variable < m_variables.size(); ++variable)
+    {
+        out_values[variable] = m_variables[variable].get_none_value();
+    }
+    for (const auto atom : state.get_atoms<FluentTag>())
+    {
+        if (atom < m_atom_to_variable.size() && m_atom_to_variable[atom] != MAX_INDEX)
+            out_values[m_atom_to_variable[atom]] = m_atom_to_value[atom];
+    }
+}
+
+std::vector<IndexList> TaskImpl::compute_causal_graph_predecessors() const
+{
+    auto predecessors = std::vector<IndexList>(m_variables.size());
+    auto sources = IndexList {};
+    for (Index op_index = 0; op_index < m_operators.size(); ++op_index)
+    {
+        const auto& op = m_operators[op_index];
+        const auto& affected_variables = m_affected_variables[op_index];
+
+        sources = affected_variables;
+        const auto add_sources = [&sources](const FactList& facts)
+        {
+            for (const auto& fact : facts)
+                sources.push_back(fact.variable);
+        };
+        add_sources(op.positive_preconditions);
+        add_sources(op.negative_preconditions);
+        for (const auto& effect : op.effects)
+        {
+            add_sources(effect.positive_conditions);
+            add_sources(effect.negative_conditions);
+        }
+
+        for (const auto target : affected_variables)
+        {
+            for (const auto source : sources)
+            {
+                if (source != target)
+                    predecessors[target].push_back(source);
+            }
+        }
+    }
+    for (auto& variables : predecessors)
+    {
+        std::sort(variables.begin(), variables.end());
+        variables.erase(std::unique(variables.begin(), variables.end()), variables.end());
+    }
+    return predecessors;
+}
+
+const Problem& TaskImpl::get_problem() const { return m_problem; }
+
+const VariableList& TaskImpl::get_variables() const { return m_variables; }
+
+const OperatorList& TaskImpl::get_operators() const { return m_operators; }
+
+const FactList& TaskImpl::get_positive_goals() const { return m_positive_goals; }
+
+const FactList& TaskImpl::get_negative_goals() const { return m_negative_goals; }
+
+const std::vector<IndexList>& TaskImpl::get_affected_variables() const { return m_affected_variables; }
+
+const IndexList& TaskImpl::get_atom_to_variable() const { return m_atom_to_variable; }
+
+const IndexList& TaskImpl::get_atom_to_value() const { return m_atom_to_value; }
+
+bool TaskImpl::is_unsolvable() const { return m_is_unsolvable; }
+
+uint64_t TaskImpl::get_fingerprint() const { return m_fingerprint; }
+
+}
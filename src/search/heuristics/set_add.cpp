@@ -25,16 +25,17 @@ using namespace rpg;
  * HMax
  */
 
-SetAddHeuristicImpl::SetAddHeuristicImpl(const DeleteRelaxedProblemExplorator& delete_relaxation) : RelaxedPlanningGraph<SetAddHeuristicImpl>(delete_relaxation)
+SetAddHeuristicImpl::SetAddHeuristicImpl(const DeleteRelaxedProblemExplorator& delete_relaxation, bool enable_incremental_evaluation) :
+    RelaxedPlanningGraph<SetAddHeuristicImpl>(delete_relaxation, enable_incremental_evaluation)
 {
     get_setadd_structure_annotations<Action>().resize(get<Action>(this->get_structures()).size());
     get_setadd_structure_annotations<Axiom>().resize(get<Axiom>(this->get_structures()).size());
     get_setadd_proposition_annotations().resize(this->get_propositions().size());
 }
 
-SetAddHeuristic SetAddHeuristicImpl::create(const DeleteRelaxedProblemExplorator& delete_relaxation)
+SetAddHeuristic SetAddHeuristicImpl::create(const DeleteRelaxedProblemExplorator& delete_relaxation, bool enable_incremental_evaluation)
 {
-    return std::make_shared<SetAddHeuristicImpl>(delete_relaxation);
+    return std::make_shared<SetAddHeuristicImpl>(delete_relaxation, enable_incremental_evaluation);
 }
 
 void SetAddHeuristicImpl::initialize_and_annotations_impl(const Action& action)
@@ -67,7 +68,7 @@ void SetAddHeuristicImpl::initialize_or_annotations_and_queue_impl(const Proposi
 {
     auto& annotations = this->get_proposition_annotations()[proposition.get_index()];
     get_cost(annotations) = 0;
-    this->m_queue.insert(QueueEntry { 0, proposition.get_index() });
+    this->m_queue.insert(QueueEntry { 0, 0, proposition.get_index() });
 }
 
 void SetAddHeuristicImpl::update_and_annotation_impl(const Proposition& proposition, const Action& action)
@@ -88,7 +89,8 @@ void SetAddHeuristicImpl::update_and_annotation_impl(const Proposition& proposit
     auto& setadd_proposition_annotations = get_setadd_proposition_annotations()[proposition.get_index()];
     auto& setadd_axiom_annotations = get_setadd_structure_annotations<Axiom>()[axiom.get_index()];
 
-    get_cost(axiom_annotations) = get_cost(proposition_annotations);
+    // The incremental evaluation does not process the preconditions in the order of their costs.
+    get_cost(axiom_annotations) = std::max(get_cost(proposition_annotations), get_cost(axiom_annotations));
     get_achievers(setadd_axiom_annotations).insert(get_achievers(setadd_proposition_annotations).begin(), get_achievers(setadd_proposition_annotations).end());
 }
 
@@ -107,8 +109,6 @@ void SetAddHeuristicImpl::update_or_annotation_impl(const Action& action, const
         auto& setadd_action_annotations = get_setadd_structure_annotations<Action>()[action.get_index()];
         get_achievers(setadd_proposition_annotations) = get_achievers(setadd_action_annotations);
         get_achievers(setadd_proposition_annotations).insert(action.get_index());
-
-        this->m_queue.insert(QueueEntry { get_cost(proposition_annotations), proposition.get_index() });
     }
 }
 
@@ -124,8 +124,6 @@ void SetAddHeuristicImpl::update_or_annotation_impl(const Axiom& axiom, const Pr
         auto& setadd_proposition_annotations = get_setadd_proposition_annotations()[proposition.get_index()];
         auto& setadd_axiom_annotations = get_setadd_structure_annotations<Axiom>()[axiom.get_index()];
         get_achievers(setadd_proposition_annotations) = get_achievers(setadd_axiom_annotations);
-
-        this->m_queue.insert(QueueEntry { get_cost(proposition_annotations), proposition.get_index() });
     }
 }
 
@@ -136,6 +134,14 @@ DiscreteCost SetAddHeuristicImpl::extract_impl(const State&)
 
     get_total_goal_annotations().clear();
 
+    if (this->m_enable_incremental_evaluation)
+    {
+        // The achievers depend on the order in which the structures are processed, but the best supporters do not.
+        this->for_each_best_supporter_action([this](const Action& action) { get_total_goal_annotations().insert(action.get_index()); });
+
+        return get_total_goal_annotations().size();
+    }
+
     for (const auto proposition_index : this->get_goal_propositions())
     {
         const auto& annotations = get_setadd_proposition_annotations()[proposition_index];
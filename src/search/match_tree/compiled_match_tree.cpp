@@ -0,0 +1,287 @@
+/*
+ * Copyright (C) 2023 Dominik Drexler and Simon Stahlberg
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "mimir/search/match_tree/compiled_match_tree.hpp"
+
+#include "mimir/formalism/ground_action.hpp"
+#include "mimir/formalism/ground_atom.hpp"
+#include "mimir/formalism/ground_axiom.hpp"
+#include "mimir/formalism/ground_numeric_constraint.hpp"
+#include "mimir/formalism/problem.hpp"
+#include "mimir/search/applicability.hpp"
+#include "mimir/search/match_tree/nodes/atom.hpp"
+#include "mimir/search/match_tree/nodes/generator.hpp"
+#include "mimir/search/match_tree/nodes/interface.hpp"
+#include "mimir/search/match_tree/nodes/numeric_constraint.hpp"
+#include "mimir/search/state_unpacked.hpp"
+
+#include <algorithm>
+#include <iterator>
+#include <queue>
+
+using namespace mimir::formalism;
+
+namespace mimir::search::match_tree
+{
+
+/// @brief `CompileNodeVisitor` writes the visited node to its position and enqueues its children in breadth-first order.
+template<formalism::HasConjunctiveCondition E>
+class CompileNodeVisitor : public INodeVisitor<E>
+{
+private:
+    std::vector<CompiledNode>& m_nodes;
+    std::vector<const E*>& m_elements;
+    GroundNumericConstraintList& m_constraints;
+    std::queue<std::pair<const INode<E>*, Index>>& m_queue;
+    Index m_position;
+
+    Index enqueue(const Node<E>& child)
+    {
+        const auto position = static_cast<Index>(m_nodes.size());
+        m_nodes.push_back(CompiledNode { CompiledNodeKind::PERFECT_GENERATOR, 0, 0, MAX_INDEX, MAX_INDEX });
+        m_queue.emplace(child.get(), position);
+        return position;
+    }
+
+    template<IsFluentOrDerivedTag P>
+    void accept_atom(GroundAtom<P> atom, const Node<E>* true_child, const Node<E>* false_child, const Node<E>* dontcare_child)
+    {
+        auto node = CompiledNode { std::is_same_v<P, FluentTag> ? CompiledNodeKind::FLUENT_ATOM : CompiledNodeKind::DERIVED_ATOM,
+                                   atom->get_index(),
+                                   true_child ? enqueue(*true_child) : MAX_INDEX,
+                                   false_child ? enqueue(*false_child) : MAX_INDEX,
+                                   dontcare_child ? enqueue(*dontcare_child) : MAX_INDEX };
+        m_nodes[m_position] = node;
+    }
+
+    void accept_constraint(GroundNumericConstraint constraint, const Node<E>* true_child, const Node<E>* dontcare_child)
+    {
+        const auto selector = static_cast<Index>(m_constraints.size());
+        m_constraints.push_back(constraint);
+        auto node = CompiledNode { CompiledNodeKind::NUMERIC_CONSTRAINT,
+                                   selector,
+                                   true_child ? enqueue(*true_child) : MAX_INDEX,
+                                   MAX_INDEX,
+                                   dontcare_child ? enqueue(*dontcare_child) : MAX_INDEX };
+        m_nodes[m_position] = node;
+    }
+
+    void accept_generator(CompiledNodeKind kind, std::span<const E*> elements)
+    {
+        const auto first = static_cast<Index>(m_elements.size());
+        m_elements.insert(m_elements.end(), elements.begin(), elements.end());
+        m_nodes[m_position] = CompiledNode { kind, first, static_cast<Index>(m_elements.size()), MAX_INDEX, MAX_INDEX };
+    }
+
+public:
+    CompileNodeVisitor(std::vector<CompiledNode>& nodes,
+                       std::vector<const E*>& elements,
+                       GroundNumericConstraintList& constraints,
+                       std::queue<std::pair<const INode<E>*, Index>>& queue) :
+        m_nodes(nodes),
+        m_elements(elements),
+        m_constraints(constraints),
+        m_queue(queue),
+        m_position(0)
+    {
+    }
+
+    void set_position(Index position) { m_position = position; }
+
+    void accept(const AtomSelectorNode_TFX<E, FluentTag>& atom) override
+    {
+        accept_atom(atom.get_atom(), &atom.get_true_child(), &atom.get_false_child(), &atom.get_dontcare_child());
+    }
+    void accept(const AtomSelectorNode_TF<E, FluentTag>& atom) override
+    {
+        accept_atom(atom.get_atom(), &atom.get_true_child(), &atom.get_false_child(), nullptr);
+    }
+    void accept(const AtomSelectorNode_TX<E, FluentTag>& atom) override
+    {
+        accept_atom(atom.get_atom(), &atom.get_true_child(), nullptr, &atom.get_dontcare_child());
+    }
+    void accept(const AtomSelectorNode_FX<E, FluentTag>& atom) override
+    {
+        accept_atom(atom.get_atom(), nullptr, &atom.get_false_child(), &atom.get_dontcare_child());
+    }
+    void accept(const AtomSelectorNode_T<E, FluentTag>& atom) override { accept_atom(atom.get_atom(), &atom.get_true_child(), nullptr, nullptr); }
+    void accept(const AtomSelectorNode_F<E, FluentTag>& atom) override { accept_atom(atom.get_atom(), nullptr, &atom.get_false_child(), nullptr); }
+    void accept(const AtomSelectorNode_TFX<E, DerivedTag>& atom) override
+    {
+        accept_atom(atom.get_atom(), &atom.get_true_child(), &atom.get_false_child(), &atom.get_dontcare_child());
+    }
+    void accept(const AtomSelectorNode_TF<E, DerivedTag>& atom) override
+    {
+        accept_atom(atom.get_atom(), &atom.get_true_child(), &atom.get_false_child(), nullptr);
+    }
+    void accept(const AtomSelectorNode_TX<E, DerivedTag>& atom) override
+    {
+        accept_atom(atom.get_atom(), &atom.get_true_child(), nullptr, &atom.get_dontcare_child());
+    }
+    void accept(const AtomSelectorNode_FX<E, DerivedTag>& atom) override
+    {
+        accept_atom(atom.get_atom(), nullptr, &atom.get_false_child(), &atom.get_dontcare_child());
+    }
+    void accept(const AtomSelectorNode_T<E, DerivedTag>& atom) override { accept_atom(atom.get_atom(), &atom.get_true_child(), nullptr, nullptr); }
+    void accept(const AtomSelectorNode_F<E, DerivedTag>& atom) override { accept_atom(atom.get_atom(), nullptr, &atom.get_false_child(), nullptr); }
+    void accept(const NumericConstraintSelectorNode_T<E>& constraint) override
+    {
+        accept_constraint(constraint.get_constraint(), &constraint.get_true_child(), nullptr);
+    }
+    void accept(const NumericConstraintSelectorNode_TX<E>& constraint) override
+    {
+        accept_constraint(constraint.get_constraint(), &constraint.get_true_child(), &constraint.get_dontcare_child());
+    }
+    void accept(const ElementGeneratorNode_Perfect<E>& generator) override
+    {
+        accept_generator(CompiledNodeKind::PERFECT_GENERATOR, generator.get_elements());
+    }
+    void accept(const ElementGeneratorNode_Imperfect<E>& generator) override
+    {
+        accept_generator(CompiledNodeKind::IMPERFECT_GENERATOR, generator.get_elements());
+    }
+};
+
+template<formalism::HasConjunctiveCondition E>
+CompiledMatchTree<E>::CompiledMatchTree(const Node<E>& root) : m_nodes(), m_elements(), m_constraints(), m_evaluate_stack()
+{
+    auto queue = std::queue<std::pair<const INode<E>*, Index>> {};
+    auto visitor = CompileNodeVisitor<E>(m_nodes, m_elements, m_constraints, queue);
+
+    m_nodes.push_back(CompiledNode { CompiledNodeKind::PERFECT_GENERATOR, 0, 0, MAX_INDEX, MAX_INDEX });
+    queue.emplace(root.get(), 0);
+
+    while (!queue.empty())
+    {
+        const auto [node, position] = queue.front();
+        queue.pop();
+
+        visitor.set_position(position);
+        node->visit(visitor);
+    }
+}
+
+template<formalism::HasConjunctiveCondition E>
+void CompiledMatchTree<E>::generate_applicable_elements_iteratively(const UnpackedStateImpl& state, std::vector<const E*>& out_applicable_elements)
+{
+    m_evaluate_stack.clear();
+    out_applicable_elements.clear();
+
+    const auto& fluent_atoms = state.get_atoms<FluentTag>();
+    const auto& derived_atoms = state.get_atoms<DerivedTag>();
+    const auto& static_numeric_variables = state.get_problem().get_initial_function_to_value<StaticTag>();
+    const auto& fluent_numeric_variables = state.get_numeric_variables();
+
+    m_evaluate_stack.push_back(0);
+
+    while (!m_evaluate_stack.empty())
+    {
+        const auto& node = m_nodes[m_evaluate_stack.back()];
+
+        m_evaluate_stack.pop_back();
+
+        // The children are pushed in the same order as in the uncompiled nodes.
+        switch (node.kind)
+        {
+            case CompiledNodeKind::FLUENT_ATOM:
+            case CompiledNodeKind::DERIVED_ATOM:
+            {
+                if (node.dontcare_child != MAX_INDEX)
+                {
+                    m_evaluate_stack.push_back(node.dontcare_child);
+                }
+                const auto child = (node.kind == CompiledNodeKind::FLUENT_ATOM ? fluent_atoms.get(node.selector) : derived_atoms.get(node.selector)) ?
+                                       node.true_child :
+                                       node.false_child;
+                if (child != MAX_INDEX)
+                {
+                    m_evaluate_stack.push_back(child);
+                }
+                break;
+            }
+            case CompiledNodeKind::NUMERIC_CONSTRAINT:
+            {
+                if (node.dontcare_child != MAX_INDEX)
+                {
+                    m_evaluate_stack.push_back(node.dontcare_child);
+                }
+                if (evaluate(m_constraints[node.selector], static_numeric_variables, fluent_numeric_variables))
+                {
+                    m_evaluate_stack.push_back(node.true_child);
+                }
+                break;
+            }
+            case CompiledNodeKind::PERFECT_GENERATOR:
+            {
+                const auto first = m_elements.begin() + node.get_first_element();
+                const auto last = m_elements.begin() + node.get_last_element();
+
+                if constexpr (std::is_same_v<E, GroundActionImpl>)
+                {
+                    if (!fluent_numeric_variables.empty())
+                    {
+                        std::copy_if(first,
+                                     last,
+                                     std::back_inserter(out_applicable_elements),
+                                     [&](auto&& element) { return is_dynamically_applicable(element, state); });
+                        break;
+                    }
+                }
+                out_applicable_elements.insert(out_applicable_elements.end(), first, last);
+                break;
+            }
+            case CompiledNodeKind::IMPERFECT_GENERATOR:
+            {
+                const auto first = m_elements.begin() + node.get_first_element();
+                const auto last = m_elements.begin() + node.get_last_element();
+
+                std::copy_if(first,
+                             last,
+                             std::back_inserter(out_applicable_elements),
+                             [&](auto&& element) { return is_dynamically_applicable(element, state); });
+                break;
+            }
+            default:
+            {
+                throw std::logic_error("CompiledMatchTree::generate_applicable_elements_iteratively: Undefined CompiledNodeKind type.");
+            }
+        }
+    }
+}
+
+template<formalism::HasConjunctiveCondition E>
+const std::vector<CompiledNode>& CompiledMatchTree<E>::get_nodes() const
+{
+    return m_nodes;
+}
+
+template<formalism::HasConjunctiveCondition E>
+const std::vector<const E*>& CompiledMatchTree<E>::get_elements() const
+{
+    return m_elements;
+}
+
+template<formalism::HasConjunctiveCondition E>
+const GroundNumericConstraintList& CompiledMatchTree<E>::get_constraints() const
+{
+    return m_constraints;
+}
+
+template class CompiledMatchTree<GroundActionImpl>;
+template class CompiledMatchTree<GroundAxiomImpl>;
+
+}
@@ -39,6 +39,8 @@ template<formalism::HasConjunctiveCondition E>
 MatchTreeImpl<E>::MatchTreeImpl() : m_elements(), m_options(), m_root(create_root_generator_node(std::span<const E*>(m_elements.begin(), m_elements.end())))
 {
     m_statistics.generator_distribution.push_back(0);
+
+    compile();
 }
 
 template<formalism::HasConjunctiveCondition E>
@@ -76,11 +78,29 @@ MatchTreeImpl<E>::MatchTreeImpl(const Repositories& pddl_repositories, std::vect
         m_root = std::move(root_);
         m_statistics = std::move(statistics_);
     }
+
+    compile();
+}
+
+template<formalism::HasConjunctiveCondition E>
+void MatchTreeImpl<E>::compile()
+{
+    if (m_options.enable_compilation)
+    {
+        m_compiled_tree.emplace(m_root);
+        m_root = nullptr;
+    }
 }
 
 template<formalism::HasConjunctiveCondition E>
 void MatchTreeImpl<E>::generate_applicable_elements_iteratively(const UnpackedStateImpl& state, std::vector<const E*>& out_applicable_elements)
 {
+    if (m_compiled_tree)
+    {
+        m_compiled_tree->generate_applicable_elements_iteratively(state, out_applicable_elements);
+        return;
+    }
+
     m_evaluate_stack.clear();
     out_applicable_elements.clear();
 
@@ -96,12 +116,24 @@ void MatchTreeImpl<E>::generate_applicable_elements_iteratively(const UnpackedSt
     }
 }
 
+template<formalism::HasConjunctiveCondition E>
+const std::vector<const E*>& MatchTreeImpl<E>::get_elements() const
+{
+    return m_elements;
+}
+
 template<formalism::HasConjunctiveCondition E>
 const Statistics& MatchTreeImpl<E>::get_statistics() const
 {
     return m_statistics;
 }
 
+template<formalism::HasConjunctiveCondition E>
+const CompiledMatchTree<E>* MatchTreeImpl<E>::get_compiled_tree() const
+{
+    return m_compiled_tree ? &m_compiled_tree.value() : nullptr;
+}
+
 template<formalism::HasConjunctiveCondition E>
 std::unique_ptr<MatchTreeImpl<E>> MatchTreeImpl<E>::create(const Repositories& pddl_repositories, std::vector<const E*> elements, const Options& options)
 {
@@ -42,27 +42,38 @@ SearchContext SearchContextImpl::create(const fs::path& domain_filepath, const f
 
 SearchContext SearchContextImpl::create(Problem problem, const Options& options)
 {
+    auto context = SearchContext();
+
     switch (options.mode)
     {
         case SearchMode::GROUNDED:
         {
             auto delete_relaxed_explorator = DeleteRelaxedProblemExplorator(problem);
 
-            return create(problem,
-                          delete_relaxed_explorator.create_grounded_applicable_action_generator(),
-                          std::make_shared<StateRepositoryImpl>(delete_relaxed_explorator.create_grounded_axiom_evaluator()));
+            context = create(problem,
+                             delete_relaxed_explorator.create_grounded_applicable_action_generator(),
+                             std::make_shared<StateRepositoryImpl>(delete_relaxed_explorator.create_grounded_axiom_evaluator()));
+            break;
         }
         case SearchMode::LIFTED:
         {
-            return create(problem,
-                          std::make_shared<LiftedApplicableActionGeneratorImpl>(problem),
-                          std::make_shared<StateRepositoryImpl>(std::make_shared<LiftedAxiomEvaluatorImpl>(problem)));
+            context = create(problem,
+                             std::make_shared<LiftedApplicableActionGeneratorImpl>(problem),
+                             std::make_shared<StateRepositoryImpl>(std::make_shared<LiftedAxiomEvaluatorImpl>(problem)));
+            break;
         }
         default:
         {
             throw std::runtime_error("SearchContext::SearchContext: Unexpected search mode.");
         }
     }
+
+    if (options.concurrent)
+    {
+        context->get_state_repository()->enable_concurrency();
+    }
+
+    return context;
 }
 
 SearchContext SearchContextImpl::create(Problem problem, ApplicableActionGenerator applicable_action_generator, StateRepository state_repository)
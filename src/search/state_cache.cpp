@@ -0,0 +1,134 @@
+/*
+ * Copyright (C) 2023 Dominik Drexler and Simon Stahlberg
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "mimir/search/state_cache.hpp"
+
+#include "mimir/search/state_repository.hpp"
+
+#include <cassert>
+
+namespace mimir::search
+{
+
+UnpackedStateCache::UnpackedStateCache(size_t capacity) :
+    m_capacity(capacity),
+    m_slots(),
+    m_free_slots(),
+    m_slot_by_state(),
+    m_hand(0)
+{
+    m_slots.reserve(capacity);
+    m_slot_by_state.reserve(capacity);
+}
+
+size_t UnpackedStateCache::find_victim_slot()
+{
+    assert(m_slots.size() == m_capacity && m_free_slots.empty());
+
+    // Give each referenced slot a second chance. Terminates after at most one full round.
+    while (true)
+    {
+        auto& slot = m_slots[m_hand];
+        const auto pos = m_hand;
+
+        if (++m_hand == m_slots.size())
+        {
+            m_hand = 0;
+        }
+
+        if (!slot.referenced)
+        {
+            return pos;
+        }
+        slot.referenced = false;
+    }
+}
+
+void UnpackedStateCache::insert(const State& state)
+{
+    if (m_capacity == 0)
+    {
+        return;
+    }
+
+    if (const auto it = m_slot_by_state.find(state.get_index()); it != m_slot_by_state.end())
+    {
+        m_slots[it->second].referenced = true;
+        return;
+    }
+
+    auto pos = size_t(0);
+    if (!m_free_slots.empty())
+    {
+        pos = m_free_slots.back();
+        m_free_slots.pop_back();
+    }
+    else if (m_slots.size() < m_capacity)
+    {
+        pos = m_slots.size();
+        m_slots.push_back(Slot { std::nullopt, false });
+    }
+    else
+    {
+        pos = find_victim_slot();
+        m_slot_by_state.erase(m_slots[pos].state->get_index());
+    }
+
+    // Newly inserted states are not referenced so that states that are never extracted are evicted first.
+    m_slots[pos] = Slot { state, false };
+    m_slot_by_state.emplace(state.get_index(), pos);
+}
+
+std::optional<State> UnpackedStateCache::extract(Index index)
+{
+    const auto it = m_slot_by_state.find(index);
+    if (it == m_slot_by_state.end())
+    {
+        return std::nullopt;
+    }
+
+    const auto pos = it->second;
+    m_slot_by_state.erase(it);
+
+    auto& slot = m_slots[pos];
+    auto state = std::move(slot.state);
+    slot = Slot { std::nullopt, false };
+    m_free_slots.push_back(pos);
+
+    return state;
+}
+
+State UnpackedStateCache::unpack(const IndexedPackedState& state, StateRepositoryImpl& state_repository)
+{
+    return state_repository.get_state(state.index, state.packed_state);
+}
+
+bool UnpackedStateCache::contains(Index index) const { return m_slot_by_state.contains(index); }
+
+void UnpackedStateCache::clear()
+{
+    m_slots.clear();
+    m_free_slots.clear();
+    m_slot_by_state.clear();
+    m_hand = 0;
+}
+
+size_t UnpackedStateCache::size() const { return m_slot_by_state.size(); }
+
+size_t UnpackedStateCache::capacity() const { return m_capacity; }
+
+}
@@ -17,6 +17,9 @@
 
 #include "mimir/search/state_packed.hpp"
 
+#include <bit>
+#include <stdexcept>
+
 using namespace mimir::formalism;
 
 namespace mimir::search
@@ -70,6 +73,112 @@ bool PackedStateImpl::literals_hold(const GroundLiteralList<P>& literals, const
 template bool PackedStateImpl::literals_hold(const GroundLiteralList<FluentTag>& literals, const ProblemImpl& problem) const;
 template bool PackedStateImpl::literals_hold(const GroundLiteralList<DerivedTag>& literals, const ProblemImpl& problem) const;
 
+/**
+ * ConcurrentPackedStateImplMap
+ */
+
+static_assert(std::has_single_bit(ConcurrentPackedStateImplMap::NUM_SHARDS));
+
+ConcurrentPackedStateImplMap::ConcurrentPackedStateImplMap() : m_shards(), m_size(0), m_concurrent(false) {}
+
+size_t ConcurrentPackedStateImplMap::get_shard_index(const PackedStateImpl& state)
+{
+    // Fibonacci hashing to select the shard from the high bits, since the low bits are used within the shard.
+    return (loki::Hash<PackedStateImpl> {}(state) * 0x9E3779B97F4A7C15ULL) >> (64 - std::countr_zero(NUM_SHARDS));
+}
+
+void ConcurrentPackedStateImplMap::enable_concurrency()
+{
+    if (m_concurrent)
+    {
+        return;
+    }
+
+    // Node handles keep the entries at their addresses, which packed states stored elsewhere point to.
+    auto& first_map = m_shards.front().map;
+    for (auto it = first_map.begin(); it != first_map.end();)
+    {
+        const auto shard_index = get_shard_index(it->first);
+        if (shard_index == 0)
+        {
+            ++it;
+            continue;
+        }
+        m_shards[shard_index].map.insert(first_map.extract(it++));
+    }
+
+    m_concurrent = true;
+}
+
+bool ConcurrentPackedStateImplMap::is_concurrent() const { return m_concurrent; }
+
+const ConcurrentPackedStateImplMap::value_type* ConcurrentPackedStateImplMap::find(const PackedStateImpl& state) const
+{
+    if (!m_concurrent)
+    {
+        const auto& map = m_shards.front().map;
+        const auto it = map.find(state);
+        return (it != map.end()) ? &*it : nullptr;
+    }
+
+    const auto& shard = m_shards[get_shard_index(state)];
+
+    std::lock_guard<std::mutex> lock(shard.mutex);
+
+    const auto it = shard.map.find(state);
+    return (it != shard.map.end()) ? &*it : nullptr;
+}
+
+const ConcurrentPackedStateImplMap::value_type& ConcurrentPackedStateImplMap::at(const PackedStateImpl& state) const
+{
+    const auto entry = find(state);
+    if (!entry)
+    {
+        throw std::out_of_range("ConcurrentPackedStateImplMap::at(state): state does not exist.");
+    }
+    return *entry;
+}
+
+std::pair<const ConcurrentPackedStateImplMap::value_type*, bool> ConcurrentPackedStateImplMap::emplace(const PackedStateImpl& state)
+{
+    if (!m_concurrent)
+    {
+        const auto index = m_size.load(std::memory_order_relaxed);
+        const auto [it, inserted] = m_shards.front().map.emplace(state, index);
+        if (inserted)
+        {
+            m_size.store(index + 1, std::memory_order_relaxed);
+        }
+        return { &*it, inserted };
+    }
+
+    auto& shard = m_shards[get_shard_index(state)];
+
+    std::lock_guard<std::mutex> lock(shard.mutex);
+
+    auto it = shard.map.find(state);
+    if (it != shard.map.end())
+    {
+        return { &*it, false };
+    }
+
+    it = shard.map.emplace(state, m_size.fetch_add(1, std::memory_order_relaxed)).first;
+    return { &*it, true };
+}
+
+size_t ConcurrentPackedStateImplMap::size() const { return m_size.load(std::memory_order_relaxed); }
+
+size_t ConcurrentPackedStateImplMap::capacity() const
+{
+    size_t capacity = 0;
+    for (const auto& shard : m_shards)
+    {
+        auto lock = m_concurrent ? std::unique_lock<std::mutex>(shard.mutex) : std::unique_lock<std::mutex>();
+        capacity += shard.map.capacity();
+    }
+    return capacity;
+}
+
 }
 
 namespace loki
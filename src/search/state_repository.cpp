@@ -22,12 +22,14 @@
 #include "mimir/formalism/ground_action.hpp"
 #include "mimir/formalism/ground_atom.hpp"
 #include "mimir/formalism/ground_literal.hpp"
+#include "mimir/formalism/metric.hpp"
 #include "mimir/formalism/problem.hpp"
 #include "mimir/formalism/repositories.hpp"
 #include "mimir/search/applicability.hpp"
 #include "mimir/search/axiom_evaluators/interface.hpp"
 #include "mimir/search/search_context.hpp"
 
+#include <algorithm>
 #include <valla/indexed_hash_set.hpp>
 #include <valla/plain/swiss.hpp>
 
@@ -44,39 +46,95 @@ ContinuousCost compute_state_metric_value(const State& state)
     }
 
     return state.get_problem().get_optimization_metric().has_value() ?
-               evaluate(state.get_problem().get_optimization_metric().value()->get_function_expression(),
+               evaluate(state.get_problem().get_optimization_metric().value(),
                         state.get_problem().get_initial_function_to_value<StaticTag>(),
                         state.get_numeric_variables()) :
                0.;
 }
 
+static std::atomic<uint64_t> s_next_repository_id = 1;
+
 StateRepositoryImpl::StateRepositoryImpl(AxiomEvaluator axiom_evaluator) :
     m_axiom_evaluator(std::move(axiom_evaluator)),
+    m_axiom_evaluator_mutex(),
     m_states(),
     m_reached_fluent_atoms(),
     m_reached_derived_atoms(),
-    m_applied_positive_effect_atoms(),
-    m_applied_negative_effect_atoms(),
-    m_unpacked_state_pool()
+    m_reached_atoms_mutex(),
+    m_concurrent(false),
+    m_successor_buffers(),
+    m_unpacked_state_pool(),
+    m_id(s_next_repository_id.fetch_add(1)),
+    m_unpacked_state_pools_mutex(),
+    m_unpacked_state_pools()
 {
 }
 
 StateRepository StateRepositoryImpl::create(AxiomEvaluator axiom_evaluator) { return std::make_shared<StateRepositoryImpl>(axiom_evaluator); }
 
+void StateRepositoryImpl::enable_concurrency()
+{
+    m_axiom_evaluator->get_problem()->enable_concurrent_tree_tables();
+    m_states.enable_concurrency();
+    m_concurrent = true;
+}
+
 std::pair<State, ContinuousCost> StateRepositoryImpl::get_or_create_initial_state()
 {
     const auto problem = m_axiom_evaluator->get_problem();
     return get_or_create_state(problem->get_fluent_initial_atoms(), problem->get_initial_function_to_value<FluentTag>());
 }
 
-static void update_reached_fluent_atoms(const FlatBitset& state_fluent_atoms, FlatBitset& ref_reached_fluent_atoms)
+SharedObjectPool<UnpackedStateImpl>& StateRepositoryImpl::get_unpacked_state_pool()
 {
-    ref_reached_fluent_atoms |= state_fluent_atoms;
+    struct Cache
+    {
+        uint64_t repository_id = 0;
+        SharedObjectPool<UnpackedStateImpl>* pool = nullptr;
+    };
+
+    if (!m_concurrent)
+    {
+        return m_unpacked_state_pool;
+    }
+
+    // Fast path: the calling thread last used this repository.
+    static thread_local Cache s_cache;
+    if (s_cache.repository_id == m_id)
+    {
+        return *s_cache.pool;
+    }
+
+    std::lock_guard<std::mutex> lock(m_unpacked_state_pools_mutex);
+
+    auto& pool = m_unpacked_state_pools[std::this_thread::get_id()];
+    if (!pool)
+    {
+        pool = std::make_unique<SharedObjectPool<UnpackedStateImpl>>();
+    }
+    s_cache = Cache { m_id, pool.get() };
+
+    return *pool;
+}
+
+StateRepositoryImpl::SuccessorBuffers& StateRepositoryImpl::get_successor_buffers()
+{
+    static thread_local SuccessorBuffers s_buffers;
+
+    return m_concurrent ? s_buffers : m_successor_buffers;
+}
+
+std::unique_lock<std::mutex> StateRepositoryImpl::lock_if_concurrent(std::mutex& mutex)
+{
+    return m_concurrent ? std::unique_lock<std::mutex>(mutex) : std::unique_lock<std::mutex>();
 }
 
-static void update_reached_derived_atoms(const FlatBitset& state_derived_atoms, FlatBitset& ref_reached_derived_atoms)
+void StateRepositoryImpl::update_reached_atoms(const UnpackedStateImpl& unpacked_state)
 {
-    ref_reached_derived_atoms |= state_derived_atoms;
+    const auto lock = lock_if_concurrent(m_reached_atoms_mutex);
+
+    m_reached_fluent_atoms |= unpacked_state.get_atoms<FluentTag>();
+    m_reached_derived_atoms |= unpacked_state.get_atoms<DerivedTag>();
 }
 
 std::pair<State, ContinuousCost> StateRepositoryImpl::get_or_create_state(const GroundAtomList<FluentTag>& atoms,
@@ -87,7 +145,7 @@ std::pair<State, ContinuousCost> StateRepositoryImpl::get_or_create_state(const
     auto& double_leaf_table = problem.get_double_leaf_table();
 
     /* Dense state */
-    auto unpacked_state = m_unpacked_state_pool.get_or_allocate(problem);
+    auto unpacked_state = get_unpacked_state_pool().get_or_allocate(problem);
     auto& dense_fluent_atoms = unpacked_state->get_atoms<FluentTag>();
     dense_fluent_atoms.unset_all();
     auto& dense_derived_atoms = unpacked_state->get_atoms<DerivedTag>();
@@ -117,17 +175,14 @@ std::pair<State, ContinuousCost> StateRepositoryImpl::get_or_create_state(const
 
     state_fluent_atoms_slot = valla::plain::swiss::insert(dense_fluent_atoms, index_tree_table);
 
-    update_reached_fluent_atoms(dense_fluent_atoms, m_reached_fluent_atoms);
-
     // Test whether there exists an extended state for the given non extended state
-    auto it = m_states.find(PackedStateImpl(state_fluent_atoms_slot, state_derived_atoms_slot, state_numeric_variables));
-    if (it != m_states.end())
+    if (const auto entry = m_states.find(PackedStateImpl(state_fluent_atoms_slot, state_derived_atoms_slot, state_numeric_variables)))
     {
-        for (const auto index : it->first.get_atoms<DerivedTag>(problem))
+        for (const auto index : entry->first.get_atoms<DerivedTag>(problem))
         {
             dense_derived_atoms.set(index);
         }
-        auto state = State(it->second, &it->first, std::move(unpacked_state), shared_from_this());
+        auto state = State(entry->second, &entry->first, std::move(unpacked_state), shared_from_this());
         return { state, compute_state_metric_value(state) };
     }
 
@@ -136,17 +191,22 @@ std::pair<State, ContinuousCost> StateRepositoryImpl::get_or_create_state(const
         if (!m_axiom_evaluator->get_problem()->get_problem_and_domain_axioms().empty())
         {
             // Evaluate axioms
-            m_axiom_evaluator->generate_and_apply_axioms(*unpacked_state);
+            {
+                const auto lock = lock_if_concurrent(m_axiom_evaluator_mutex);
+                m_axiom_evaluator->generate_and_apply_axioms(*unpacked_state);
+            }
 
             state_derived_atoms_slot = valla::plain::swiss::insert(dense_derived_atoms, index_tree_table);
-
-            update_reached_derived_atoms(dense_derived_atoms, m_reached_derived_atoms);
         }
     }
 
     // Cache and return the extended state.
-    auto result = m_states.emplace(PackedStateImpl(state_fluent_atoms_slot, state_derived_atoms_slot, state_numeric_variables), m_states.size());
-    auto state = State(result.first->second, &result.first->first, std::move(unpacked_state), shared_from_this());
+    const auto [entry, inserted] = m_states.emplace(PackedStateImpl(state_fluent_atoms_slot, state_derived_atoms_slot, state_numeric_variables));
+    if (inserted)
+    {
+        update_reached_atoms(*unpacked_state);
+    }
+    auto state = State(entry->second, &entry->first, std::move(unpacked_state), shared_from_this());
 
     return { state, compute_state_metric_value(state) };
 }
@@ -195,7 +255,8 @@ static void apply_numeric_effect(const std::pair<loki::AssignOperatorEnum, Conti
 static void collect_applied_fluent_numeric_effects(const GroundNumericEffectList<FluentTag>& numeric_effects,
                                                    const FlatDoubleList& static_numeric_variables,
                                                    const FlatDoubleList& fluent_numeric_variables,
-                                                   FlatDoubleList& ref_numeric_variables)
+                                                   FlatDoubleList& ref_numeric_variables,
+                                                   IndexList& ref_changed_numeric_variables)
 {
     assert(&fluent_numeric_variables != &ref_numeric_variables);
 
@@ -209,6 +270,8 @@ static void collect_applied_fluent_numeric_effects(const GroundNumericEffectList
         const auto assign_operator_and_value = evaluate(numeric_effect, static_numeric_variables, fluent_numeric_variables);
 
         apply_numeric_effect(assign_operator_and_value, ref_numeric_variables[index]);
+
+        ref_changed_numeric_variables.push_back(index);
     }
 }
 
@@ -225,12 +288,11 @@ static void collect_applied_auxiliary_numeric_effects(const GroundNumericEffect<
 
 static void apply_action_effects(GroundAction action,
                                  const ProblemImpl& problem,
-                                 State state,
-                                 const UnpackedStateImpl& unpacked_state,
-                                 FlatBitset& ref_dense_fluent_atoms,
-                                 FlatBitset& ref_negative_applied_effects,
-                                 FlatBitset& ref_positive_applied_effects,
+                                 const State& state,
+                                 IndexList& ref_negative_applied_effects,
+                                 IndexList& ref_positive_applied_effects,
                                  FlatDoubleList& ref_fluent_numeric_variables,
+                                 IndexList& ref_changed_numeric_variables,
                                  ContinuousCost& ref_successor_state_metric_score)
 {
     const auto& const_fluent_numeric_variables = state.get_numeric_variables();
@@ -238,14 +300,22 @@ static void apply_action_effects(GroundAction action,
 
     for (const auto& conditional_effect : action->get_conditional_effects())
     {
-        if (is_applicable(conditional_effect, unpacked_state))
+        // Important: conditions are evaluated in the parent state, not in the partially updated successor.
+        if (is_applicable(conditional_effect, state.get_unpacked_state()))
         {
-            insert_into_bitset(conditional_effect->get_conjunctive_effect()->get_propositional_effects<NegativeTag>(), ref_negative_applied_effects);
-            insert_into_bitset(conditional_effect->get_conjunctive_effect()->get_propositional_effects<PositiveTag>(), ref_positive_applied_effects);
+            for (const auto atom_index : conditional_effect->get_conjunctive_effect()->get_propositional_effects<NegativeTag>())
+            {
+                ref_negative_applied_effects.push_back(atom_index);
+            }
+            for (const auto atom_index : conditional_effect->get_conjunctive_effect()->get_propositional_effects<PositiveTag>())
+            {
+                ref_positive_applied_effects.push_back(atom_index);
+            }
             collect_applied_fluent_numeric_effects(conditional_effect->get_conjunctive_effect()->get_fluent_numeric_effects(),
                                                    const_static_numeric_variables,
                                                    const_fluent_numeric_variables,
-                                                   ref_fluent_numeric_variables);
+                                                   ref_fluent_numeric_variables,
+                                                   ref_changed_numeric_variables);
             if (conditional_effect->get_conjunctive_effect()->get_auxiliary_numeric_effect().has_value())
             {
                 collect_applied_auxiliary_numeric_effects(conditional_effect->get_conjunctive_effect()->get_auxiliary_numeric_effect().value(),
@@ -256,20 +326,58 @@ static void apply_action_effects(GroundAction action,
         }
     }
 
-    // Update propositional state atoms.
-    ref_dense_fluent_atoms -= ref_negative_applied_effects;
-    ref_dense_fluent_atoms |= ref_positive_applied_effects;
-
     // Update metric in case of a fluent one.
     if (!problem.get_domain()->get_auxiliary_function_skeleton().has_value())
     {
         ref_successor_state_metric_score =
             problem.get_optimization_metric().has_value() ?
-                evaluate(problem.get_optimization_metric().value()->get_function_expression(), const_static_numeric_variables, ref_fluent_numeric_variables) :
+                evaluate(problem.get_optimization_metric().value(), const_static_numeric_variables, ref_fluent_numeric_variables) :
                 ref_successor_state_metric_score + 1;
     }
 }
 
+/// @brief `UnchangedNumericPositions` tests whether the positions [first, last) contain no changed numeric variable.
+struct UnchangedNumericPositions
+{
+    const IndexList& changed_numeric_variables;
+
+    bool operator()(Index first, Index last) const
+    {
+        const auto it = std::lower_bound(changed_numeric_variables.begin(), changed_numeric_variables.end(), first);
+        return it == changed_numeric_variables.end() || *it >= last;
+    }
+};
+
+/// @brief Collect the sorted fluent atoms that the applied effects add to and delete from the parent, where add effects win over delete effects.
+/// This takes time linear in the number of effects, independent of the size of the state.
+static void collect_fluent_atom_changes(const FlatBitset& parent_fluent_atoms,
+                                        IndexList& ref_negative_applied_effects,
+                                        IndexList& ref_positive_applied_effects,
+                                        IndexList& out_added_atoms,
+                                        IndexList& out_deleted_atoms)
+{
+    std::sort(ref_positive_applied_effects.begin(), ref_positive_applied_effects.end());
+    ref_positive_applied_effects.erase(std::unique(ref_positive_applied_effects.begin(), ref_positive_applied_effects.end()),
+                                       ref_positive_applied_effects.end());
+    std::sort(ref_negative_applied_effects.begin(), ref_negative_applied_effects.end());
+    ref_negative_applied_effects.erase(std::unique(ref_negative_applied_effects.begin(), ref_negative_applied_effects.end()),
+                                       ref_negative_applied_effects.end());
+
+    out_added_atoms.clear();
+    for (const auto index : ref_positive_applied_effects)
+    {
+        if (!parent_fluent_atoms.get(index))
+            out_added_atoms.push_back(index);
+    }
+
+    out_deleted_atoms.clear();
+    for (const auto index : ref_negative_applied_effects)
+    {
+        if (parent_fluent_atoms.get(index) && !std::binary_search(ref_positive_applied_effects.begin(), ref_positive_applied_effects.end(), index))
+            out_deleted_atoms.push_back(index);
+    }
+}
+
 std::pair<State, ContinuousCost> StateRepositoryImpl::get_or_create_successor_state(const State& state, GroundAction action, ContinuousCost state_metric_value)
 {
     auto& problem = *m_axiom_evaluator->get_problem();
@@ -277,16 +385,16 @@ std::pair<State, ContinuousCost> StateRepositoryImpl::get_or_create_successor_st
     auto& double_leaf_table = problem.get_double_leaf_table();
 
     /* Dense state*/
-    auto unpacked_state = m_unpacked_state_pool.get_or_allocate(problem);
+    auto unpacked_state = get_unpacked_state_pool().get_or_allocate(problem);
     auto& dense_fluent_atoms = unpacked_state->get_atoms<FluentTag>();
-    dense_fluent_atoms = state.get_unpacked_state().get_atoms<FluentTag>();
-    auto& dense_derived_atoms = unpacked_state->get_atoms<DerivedTag>();
-    dense_derived_atoms = state.get_unpacked_state().get_atoms<DerivedTag>();
+    auto& dense_derived_atoms = unpacked_state->get_atoms<DerivedTag>();  ///< Not copied: always overwritten below.
     auto& dense_fluent_numeric_variables = unpacked_state->get_numeric_variables();
     dense_fluent_numeric_variables = state.get_unpacked_state().get_numeric_variables();
     /* Temporaries */
-    m_applied_negative_effect_atoms.unset_all();
-    m_applied_positive_effect_atoms.unset_all();
+    auto& buffers = get_successor_buffers();
+    buffers.applied_negative_effect_atoms.clear();
+    buffers.applied_positive_effect_atoms.clear();
+    buffers.changed_numeric_variables.clear();
     /* Sparse state */
     auto state_fluent_atoms_slot = valla::Slot<Index>();
     auto state_derived_atoms_slot = valla::Slot<Index>();
@@ -299,33 +407,64 @@ std::pair<State, ContinuousCost> StateRepositoryImpl::get_or_create_successor_st
     apply_action_effects(action,
                          problem,
                          state,
-                         *unpacked_state,
-                         dense_fluent_atoms,
-                         m_applied_negative_effect_atoms,
-                         m_applied_positive_effect_atoms,
+                         buffers.applied_negative_effect_atoms,
+                         buffers.applied_positive_effect_atoms,
                          dense_fluent_numeric_variables,
+                         buffers.changed_numeric_variables,
                          successor_state_metric_value);
 
-    state_fluent_atoms_slot = valla::plain::swiss::insert(dense_fluent_atoms, index_tree_table);
+    const auto& parent_fluent_atoms = state.get_unpacked_state().get_atoms<FluentTag>();
 
-    update_reached_fluent_atoms(dense_fluent_atoms, m_reached_fluent_atoms);
+    collect_fluent_atom_changes(parent_fluent_atoms,
+                                buffers.applied_negative_effect_atoms,
+                                buffers.applied_positive_effect_atoms,
+                                buffers.added_fluent_atoms,
+                                buffers.deleted_fluent_atoms);
 
-    state_numeric_variables = valla::plain::swiss::insert(dense_fluent_numeric_variables, index_tree_table, double_leaf_table);
+    // The successor owns a dense copy of its atoms, which only differs from the parent in the changed atoms.
+    dense_fluent_atoms = parent_fluent_atoms;
+    for (const auto index : buffers.deleted_fluent_atoms)
+    {
+        dense_fluent_atoms.unset(index);
+    }
+    for (const auto index : buffers.added_fluent_atoms)
+    {
+        dense_fluent_atoms.set(index);
+    }
+
+    /* Only insert the tree nodes on paths to changed positions and reuse all other subtrees of the parent. */
+
+    const auto& parent_state = *state.get_packed_state();
+
+    state_fluent_atoms_slot = valla::plain::swiss::insert_with_delta(parent_state.get_atoms<FluentTag>(),
+                                                                     buffers.added_fluent_atoms,
+                                                                     buffers.deleted_fluent_atoms,
+                                                                     index_tree_table,
+                                                                     buffers.delta_workspace);
+
+    assert(state_fluent_atoms_slot == valla::plain::swiss::insert(dense_fluent_atoms, index_tree_table));
+
+    std::sort(buffers.changed_numeric_variables.begin(), buffers.changed_numeric_variables.end());
+
+    state_numeric_variables = valla::plain::swiss::insert_with_parent(dense_fluent_numeric_variables,
+                                                                      parent_state.get_numeric_variables(),
+                                                                      index_tree_table,
+                                                                      double_leaf_table,
+                                                                      UnchangedNumericPositions { buffers.changed_numeric_variables });
 
     assert(std::equal(dense_fluent_numeric_variables.begin(),
                       dense_fluent_numeric_variables.end(),
                       valla::plain::swiss::begin(state_numeric_variables, index_tree_table, double_leaf_table)));
 
     // Check if non-extended state exists in cache
-    auto it = m_states.find(PackedStateImpl(state_fluent_atoms_slot, state_derived_atoms_slot, state_numeric_variables));
-    if (it != m_states.end())
+    if (const auto entry = m_states.find(PackedStateImpl(state_fluent_atoms_slot, state_derived_atoms_slot, state_numeric_variables)))
     {
         dense_derived_atoms.unset_all();  ///< Important: now we must clear the buffer before inserting the derived atoms of the successor state.
-        for (const auto index : it->first.get_atoms<DerivedTag>(problem))
+        for (const auto index : entry->first.get_atoms<DerivedTag>(problem))
         {
             dense_derived_atoms.set(index);
         }
-        auto state = State(it->second, &it->first, std::move(unpacked_state), shared_from_this());
+        auto state = State(entry->second, &entry->first, std::move(unpacked_state), shared_from_this());
         return { state, successor_state_metric_value };
     }
 
@@ -333,31 +472,35 @@ std::pair<State, ContinuousCost> StateRepositoryImpl::get_or_create_successor_st
     {
         if (!m_axiom_evaluator->get_problem()->get_problem_and_domain_axioms().empty())
         {
-            // Evaluate axioms
-            dense_derived_atoms.unset_all();  ///< Important: now we must clear the buffer before evaluating for the updated fluent atoms.
-            m_axiom_evaluator->generate_and_apply_axioms(*unpacked_state);
+            // Update the derived atoms of the parent for the changed fluent atoms.
+            {
+                const auto lock = lock_if_concurrent(m_axiom_evaluator_mutex);
+                m_axiom_evaluator->update_and_apply_axioms(state.get_unpacked_state(),
+                                                           buffers.added_fluent_atoms,
+                                                           buffers.deleted_fluent_atoms,
+                                                           *unpacked_state);
+            }
 
             state_derived_atoms_slot = valla::plain::swiss::insert(dense_derived_atoms, index_tree_table);
-
-            update_reached_fluent_atoms(dense_derived_atoms, m_reached_derived_atoms);
         }
     }
 
     // Cache and return the extended state.
-    auto result = m_states.emplace(PackedStateImpl(state_fluent_atoms_slot, state_derived_atoms_slot, state_numeric_variables), m_states.size());
-    auto successor_state = State(result.first->second, &result.first->first, std::move(unpacked_state), shared_from_this());
+    const auto [entry, inserted] = m_states.emplace(PackedStateImpl(state_fluent_atoms_slot, state_derived_atoms_slot, state_numeric_variables));
+    if (inserted)
+    {
+        update_reached_atoms(*unpacked_state);
+    }
+    auto successor_state = State(entry->second, &entry->first, std::move(unpacked_state), shared_from_this());
 
     return { successor_state, successor_state_metric_value };
 }
 
-State StateRepositoryImpl::get_state(const PackedStateImpl& state)
+static void unpack_state(const PackedStateImpl& state, const ProblemImpl& problem, UnpackedStateImpl& ref_unpacked_state)
 {
-    // Unpack the internal state into dense state
-    const auto& problem = *m_axiom_evaluator->get_problem();
-    auto unpacked_state = m_unpacked_state_pool.get_or_allocate(problem);
-    auto& dense_fluent_atoms = unpacked_state->get_atoms<FluentTag>();
-    auto& dense_derived_atoms = unpacked_state->get_atoms<DerivedTag>();
-    auto& dense_fluent_numeric_variables = unpacked_state->get_numeric_variables();
+    auto& dense_fluent_atoms = ref_unpacked_state.get_atoms<FluentTag>();
+    auto& dense_derived_atoms = ref_unpacked_state.get_atoms<DerivedTag>();
+    auto& dense_fluent_numeric_variables = ref_unpacked_state.get_numeric_variables();
 
     dense_fluent_atoms.unset_all();
     for (const auto index : state.get_atoms<FluentTag>(problem))
@@ -376,17 +519,58 @@ State StateRepositoryImpl::get_state(const PackedStateImpl& state)
     {
         dense_fluent_numeric_variables.push_back(value);
     }
+}
 
-    return State(m_states.at(state), &state, std::move(unpacked_state), shared_from_this());
+State StateRepositoryImpl::get_state(const PackedStateImpl& state)
+{
+    // Unpack the internal state into dense state
+    const auto& problem = *m_axiom_evaluator->get_problem();
+    auto unpacked_state = get_unpacked_state_pool().get_or_allocate(problem);
+
+    unpack_state(state, problem, *unpacked_state);
+
+    const auto& entry = m_states.at(state);
+
+    return State(entry.second, &entry.first, std::move(unpacked_state), shared_from_this());
+}
+
+State StateRepositoryImpl::get_state(Index index, PackedState state)
+{
+    assert(m_states.at(*state).second == index);
+
+    const auto& problem = *m_axiom_evaluator->get_problem();
+    auto unpacked_state = get_unpacked_state_pool().get_or_allocate(problem);
+
+    unpack_state(*state, problem, *unpacked_state);
+
+    return State(index, state, std::move(unpacked_state), shared_from_this());
+}
+
+State StateRepositoryImpl::import_state(const PackedStateImpl& state)
+{
+    const auto& problem = *m_axiom_evaluator->get_problem();
+    auto unpacked_state = get_unpacked_state_pool().get_or_allocate(problem);
+
+    unpack_state(state, problem, *unpacked_state);
+
+    const auto [entry, inserted] = m_states.emplace(state);
+    if (inserted)
+    {
+        update_reached_atoms(*unpacked_state);
+    }
+
+    return State(entry->second, &entry->first, std::move(unpacked_state), shared_from_this());
 }
 
-Index StateRepositoryImpl::get_state_index(const PackedStateImpl& state) { return m_states.at(state); }
+Index StateRepositoryImpl::get_state_index(const PackedStateImpl& state) { return m_states.at(state).second; }
 
 const Problem& StateRepositoryImpl::get_problem() const { return m_axiom_evaluator->get_problem(); }
 
+bool StateRepositoryImpl::is_concurrent() const { return m_concurrent; }
+
 size_t StateRepositoryImpl::get_state_count() const { return m_states.size(); }
 
-const PackedStateImplMap& StateRepositoryImpl::get_states() const { return m_states; }
+const ConcurrentPackedStateImplMap& StateRepositoryImpl::get_states() const { return m_states; }
 
 const FlatBitset& StateRepositoryImpl::get_reached_fluent_ground_atoms_bitset() const { return m_reached_fluent_atoms; }
 
@@ -0,0 +1,150 @@
+/*
+ * Copyright (C) 2023 Dominik Drexler and Simon Stahlberg
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "mimir/algorithms/kpkc.hpp"
+
+#include <algorithm>
+#include <gtest/gtest.h>
+#include <random>
+
+namespace mimir::tests
+{
+
+/// @brief Enumerate all k-cliques by testing every combination of one vertex per partition.
+static void enumerate_cliques_naively(const BitMatrix& adjacency_matrix,
+                                      const std::vector<std::vector<uint32_t>>& partitions,
+                                      std::vector<uint32_t>& partial_clique,
+                                      std::vector<std::vector<uint32_t>>& out_cliques)
+{
+    if (partial_clique.size() == partitions.size())
+    {
+        out_cliques.push_back(partial_clique);
+        std::sort(out_cliques.back().begin(), out_cliques.back().end());
+        return;
+    }
+
+    for (const auto vertex : partitions[partial_clique.size()])
+    {
+        if (std::all_of(partial_clique.begin(), partial_clique.end(), [&](uint32_t other) { return adjacency_matrix.test(vertex, other); }))
+        {
+            partial_clique.push_back(vertex);
+            enumerate_cliques_naively(adjacency_matrix, partitions, partial_clique, out_cliques);
+            partial_clique.pop_back();
+        }
+    }
+}
+
+TEST(MimirTests, AlgorithmsKPKCTriangleTest)
+{
+    // Two triangles {0,2,4} and {1,3,4} in a 3-partite graph with partitions {0,1}, {2,3}, {4}.
+    auto adjacency_matrix = BitMatrix(5);
+    for (const auto& [src, dst] : std::vector<std::pair<uint32_t, uint32_t>> { { 0, 2 }, { 0, 4 }, { 2, 4 }, { 1, 3 }, { 1, 4 }, { 3, 4 }, { 0, 3 } })
+    {
+        adjacency_matrix.set(src, dst);
+        adjacency_matrix.set(dst, src);
+    }
+    const auto partitions = std::vector<std::vector<uint32_t>> { { 0, 1 }, { 2, 3 }, { 4 } };
+
+    auto cliques = std::vector<std::vector<uint32_t>> {};
+    for (const auto& clique : create_k_clique_in_k_partite_graph_generator(adjacency_matrix, partitions))
+    {
+        cliques.push_back(clique);
+        std::sort(cliques.back().begin(), cliques.back().end());
+    }
+    std::sort(cliques.begin(), cliques.end());
+
+    EXPECT_EQ(cliques, (std::vector<std::vector<uint32_t>> { { 0, 2, 4 }, { 0, 3, 4 }, { 1, 3, 4 } }));
+
+    // Only the cliques that contain vertex 3.
+    auto candidates = std::vector<BitMatrix::Block>(adjacency_matrix.get_num_blocks_per_row(), 0);
+    candidates[0] = 0b11011;
+    cliques.clear();
+    for (const auto& clique : create_k_clique_in_k_partite_graph_generator(adjacency_matrix, partitions, candidates))
+    {
+        cliques.push_back(clique);
+        std::sort(cliques.back().begin(), cliques.back().end());
+    }
+    std::sort(cliques.begin(), cliques.end());
+
+    EXPECT_EQ(cliques, (std::vector<std::vector<uint32_t>> { { 0, 3, 4 }, { 1, 3, 4 } }));
+}
+
+TEST(MimirTests, AlgorithmsKPKCRandomTest)
+{
+    auto rng = std::mt19937(42);
+
+    for (int trial = 0; trial < 100; ++trial)
+    {
+        // Partitions of more than 64 vertices do not align with blocks.
+        const auto k = 2 + rng() % 3;
+        const auto max_partition_size = (trial % 4 == 0) ? ((k == 2) ? 150u : 40u) : 10u;
+        auto partitions = std::vector<std::vector<uint32_t>>(k);
+        auto num_vertices = uint32_t(0);
+        for (auto& partition : partitions)
+        {
+            for (auto i = rng() % (max_partition_size + 1); i > 0; --i)
+            {
+                partition.push_back(num_vertices++);
+            }
+        }
+
+        auto adjacency_matrix = BitMatrix(num_vertices);
+        const auto density = rng() % 100;
+        for (uint32_t p1 = 0; p1 < k; ++p1)
+        {
+            for (uint32_t p2 = p1 + 1; p2 < k; ++p2)
+            {
+                for (const auto src : partitions[p1])
+                {
+                    for (const auto dst : partitions[p2])
+                    {
+                        if (rng() % 100 < density)
+                        {
+                            adjacency_matrix.set(src, dst);
+                            adjacency_matrix.set(dst, src);
+                        }
+                    }
+                }
+            }
+        }
+
+        auto expected_cliques = std::vector<std::vector<uint32_t>> {};
+        auto partial_clique = std::vector<uint32_t> {};
+        enumerate_cliques_naively(adjacency_matrix, partitions, partial_clique, expected_cliques);
+        std::sort(expected_cliques.begin(), expected_cliques.end());
+
+        for (const auto kernel : { KPKCKernel::SCALAR, KPKCKernel::AVX2, KPKCKernel::AVX512 })
+        {
+            if (!is_supported(kernel))
+            {
+                continue;
+            }
+
+            auto cliques = std::vector<std::vector<uint32_t>> {};
+            for (const auto& clique : create_k_clique_in_k_partite_graph_generator(adjacency_matrix, partitions, kernel))
+            {
+                cliques.push_back(clique);
+                std::sort(cliques.back().begin(), cliques.back().end());
+            }
+            std::sort(cliques.begin(), cliques.end());
+
+            EXPECT_EQ(cliques, expected_cliques) << "trial " << trial << " with kernel " << static_cast<int>(kernel);
+        }
+    }
+}
+
+}
@@ -0,0 +1,187 @@
+/*
+ * Copyright (C) 2023 Dominik Drexler and Simon Stahlberg
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "mimir/datasets/archive.hpp"
+
+#include "mimir/datasets/generalized_state_space.hpp"
+#include "mimir/datasets/knowledge_base.hpp"
+#include "mimir/datasets/state_space.hpp"
+#include "mimir/datasets/tuple_graph.hpp"
+#include "mimir/formalism/action.hpp"
+#include "mimir/formalism/ground_action.hpp"
+#include "mimir/formalism/ground_atom.hpp"
+#include "mimir/formalism/object.hpp"
+#include "mimir/formalism/predicate.hpp"
+#include "mimir/formalism/problem.hpp"
+#include "mimir/formalism/repositories.hpp"
+#include "mimir/search/generalized_search_context.hpp"
+#include "mimir/search/search_context.hpp"
+
+#include <fstream>
+#include <gtest/gtest.h>
+#include <set>
+#include <string>
+
+using namespace mimir::datasets;
+using namespace mimir::formalism;
+
+namespace mimir::tests
+{
+
+static std::string get_ground_name(Index symbol, const ObjectList& objects)
+{
+    auto result = std::to_string(symbol);
+    for (const auto object : objects)
+    {
+        result += " " + std::to_string(object->get_index());
+    }
+    return result;
+}
+
+static std::string get_ground_name(const archive::GroundTable& table, Index position, const ProblemImpl& problem)
+{
+    const auto objects = archive::get_range(table.object_offsets, table.objects, position);
+    return get_ground_name(table.symbols[position], problem.get_repositories().get_objects_from_indices(objects));
+}
+
+TEST(MimirTests, DatasetsArchiveWriteAndOpenTest)
+{
+    const auto domain_file = fs::path(std::string(DATA_DIR) + "spanner/domain.pddl");
+    const auto problem1_file = fs::path(std::string(DATA_DIR) + "spanner/p-1-1-2-1.pddl");
+    const auto problem2_file = fs::path(std::string(DATA_DIR) + "spanner/p-1-1-2-1(2).pddl");
+
+    auto kb_options = knowledge_base::Options();
+    kb_options.generalized_state_space_options = generalized_state_space::Options();
+    kb_options.tuple_graph_options = tuple_graph::Options();
+    kb_options.tuple_graph_options->width = 1;
+    const auto kb = KnowledgeBaseImpl::create(search::GeneralizedSearchContextImpl::create(domain_file, std::vector<fs::path> { problem1_file, problem2_file }),
+                                              kb_options);
+
+    const auto archive_file = fs::temp_directory_path() / "mimir_datasets_archive_test.bin";
+    KnowledgeBaseArchiveImpl::write(*kb, archive_file);
+    const auto kb_archive = KnowledgeBaseArchiveImpl::open(archive_file);
+    EXPECT_NO_THROW(kb_archive->verify());
+    const auto& data = kb_archive->get_data();
+
+    EXPECT_EQ(data.domain_filepath.view(), domain_file.string());
+    ASSERT_EQ(kb_archive->get_num_state_spaces(), kb->get_state_spaces().size());
+
+    for (size_t i = 0; i < kb->get_state_spaces().size(); ++i)
+    {
+        const auto& state_space = kb->get_state_spaces()[i];
+        const auto& graph = state_space->get_graph();
+        const auto& archived_graph = kb_archive->get_state_space(i);
+        const auto& problem = *state_space->get_search_context()->get_problem();
+
+        EXPECT_EQ(archived_graph.initial_vertex, state_space->get_initial_vertex());
+        ASSERT_EQ(archived_graph.vertex_flags.size(), graph.get_num_vertices());
+        ASSERT_EQ(archived_graph.edge_sources.size(), graph.get_num_edges());
+
+        for (const auto& vertex : graph.get_vertices())
+        {
+            const auto v_idx = vertex.get_index();
+            EXPECT_EQ(archived_graph.unit_goal_distances[v_idx], graphs::get_unit_goal_distance(vertex));
+            EXPECT_EQ(archive::has_flag(archived_graph.vertex_flags[v_idx], archive::GOAL), graphs::is_goal(vertex));
+            EXPECT_EQ(archive::has_flag(archived_graph.vertex_flags[v_idx], archive::UNSOLVABLE), graphs::is_unsolvable(vertex));
+
+            // Archived atoms refer to the fluent atom table by position and must describe the same ground atoms.
+            const auto state = graphs::get_state(vertex);
+            const auto fluent_atoms = archive::get_range(archived_graph.fluent_atom_offsets, archived_graph.fluent_atoms, v_idx);
+            auto archived_atom_names = std::set<std::string> {};
+            for (const auto position : fluent_atoms)
+            {
+                archived_atom_names.insert(get_ground_name(archived_graph.fluent_atom_table, position, problem));
+            }
+            auto atom_names = std::set<std::string> {};
+            for (const auto atom_index : state.get_atoms<FluentTag>())
+            {
+                const auto atom = problem.get_repositories().get_ground_atom<FluentTag>(atom_index);
+                atom_names.insert(get_ground_name(atom->get_predicate()->get_index(), atom->get_objects()));
+            }
+            EXPECT_EQ(archived_atom_names, atom_names);
+        }
+
+        for (const auto& edge : graph.get_edges())
+        {
+            const auto action = graphs::get_action(edge);
+            EXPECT_EQ(archived_graph.edge_sources[edge.get_index()], edge.get_source());
+            EXPECT_EQ(archived_graph.edge_targets[edge.get_index()], edge.get_target());
+            EXPECT_EQ(get_ground_name(archived_graph.action_table, archived_graph.edge_actions[edge.get_index()], problem),
+                      get_ground_name(action->get_action()->get_index(), action->get_objects()));
+        }
+    }
+
+    ASSERT_TRUE(data.has_generalized_state_space);
+    EXPECT_EQ(data.class_graph.vertex_flags.size(), kb->get_generalized_state_space().value()->get_graph().get_num_vertices());
+    EXPECT_EQ(data.class_graph.edge_sources.size(), kb->get_generalized_state_space().value()->get_graph().get_num_edges());
+
+    ASSERT_TRUE(data.has_tuple_graphs);
+    ASSERT_EQ(data.tuple_graphs.size(), kb->get_tuple_graphs().value().size());
+    for (size_t i = 0; i < data.tuple_graphs.size(); ++i)
+    {
+        ASSERT_EQ(data.tuple_graphs[i].size(), kb->get_tuple_graphs().value()[i].size());
+        for (size_t j = 0; j < data.tuple_graphs[i].size(); ++j)
+        {
+            const auto& tuple_graph = kb->get_tuple_graphs().value()[i][j];
+            EXPECT_EQ(data.tuple_graphs[i][j].atom_tuple_offsets.size(), tuple_graph->get_graph().get_num_vertices() + 1);
+            EXPECT_EQ(data.tuple_graphs[i][j].edge_sources.size(), tuple_graph->get_graph().get_num_edges());
+        }
+    }
+
+    fs::remove(archive_file);
+}
+
+TEST(MimirTests, DatasetsArchiveInvalidFileTest)
+{
+    const auto archive_file = fs::temp_directory_path() / "mimir_datasets_archive_invalid_test.bin";
+    {
+        auto out = std::ofstream(archive_file, std::ios::binary | std::ios::trunc);
+        out << "This is not an archive of a knowledge base.";
+    }
+
+    EXPECT_THROW(KnowledgeBaseArchiveImpl::open(archive_file), std::runtime_error);
+
+    fs::remove(archive_file);
+}
+
+TEST(MimirTests, DatasetsArchiveCorruptedFileTest)
+{
+    const auto domain_file = fs::path(std::string(DATA_DIR) + "spanner/domain.pddl");
+    const auto problem_file = fs::path(std::string(DATA_DIR) + "spanner/p-1-1-2-1.pddl");
+    const auto kb = KnowledgeBaseImpl::create(search::GeneralizedSearchContextImpl::create(domain_file, std::vector<fs::path> { problem_file }),
+                                              knowledge_base::Options());
+
+    const auto archive_file = fs::temp_directory_path() / "mimir_datasets_archive_corrupted_test.bin";
+    KnowledgeBaseArchiveImpl::write(*kb, archive_file);
+
+    // Flip a byte in the data, which keeps the type hash intact but breaks the checksum.
+    {
+        auto file = std::fstream(archive_file, std::ios::binary | std::ios::in | std::ios::out);
+        file.seekg(-1, std::ios::end);
+        const auto byte = static_cast<char>(file.get());
+        file.seekp(-1, std::ios::end);
+        file.put(static_cast<char>(~byte));
+    }
+
+    // Opening only checks the header, and the verification detects the corruption.
+    const auto kb_archive = KnowledgeBaseArchiveImpl::open(archive_file);
+    EXPECT_THROW(kb_archive->verify(), std::runtime_error);
+
+    fs::remove(archive_file);
+}
+
+}
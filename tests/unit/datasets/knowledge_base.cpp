@@ -18,9 +18,11 @@
 #include "mimir/datasets/knowledge_base.hpp"
 
 #include "mimir/datasets/generalized_state_space.hpp"
+#include "mimir/datasets/state_space.hpp"
 #include "mimir/datasets/tuple_graph.hpp"
 #include "mimir/formalism/problem.hpp"
 #include "mimir/search/generalized_search_context.hpp"
+#include "mimir/search/search_context.hpp"
 
 #include <gtest/gtest.h>
 
@@ -338,4 +340,119 @@ TEST(MimirTests, DatasetsKnowledgeBaseConstructor2Test)
     }
 }
 
+TEST(MimirTests, DatasetsKnowledgeBaseParallelConstructorTest)
+{
+    /* Test that the state spaces constructed concurrently across problems and within breadth-first layers equal the sequentially constructed ones,
+       with and without symmetry reduction. */
+    const auto compare = [](const fs::path& domain_file, const std::vector<fs::path>& problem_files, bool symmetry_pruning)
+    {
+        auto sequential_options = state_space::Options();
+        sequential_options.symmetry_pruning = symmetry_pruning;
+        const auto sequential_state_spaces =
+            StateSpaceImpl::create(search::GeneralizedSearchContextImpl::create(domain_file, problem_files), sequential_options);
+
+        auto parallel_options = state_space::Options();
+        parallel_options.symmetry_pruning = symmetry_pruning;
+        parallel_options.num_threads = 4;
+        parallel_options.num_layer_threads = 4;
+        const auto parallel_state_spaces = StateSpaceImpl::create(search::GeneralizedSearchContextImpl::create(domain_file, problem_files), parallel_options);
+
+        ASSERT_EQ(sequential_state_spaces.size(), parallel_state_spaces.size());
+        for (size_t i = 0; i < sequential_state_spaces.size(); ++i)
+        {
+            const auto& sequential_state_space = sequential_state_spaces[i].first;
+            const auto& parallel_state_space = parallel_state_spaces[i].first;
+
+            EXPECT_EQ(sequential_state_space->get_search_context()->get_problem()->get_filepath(),
+                      parallel_state_space->get_search_context()->get_problem()->get_filepath());
+            EXPECT_EQ(sequential_state_space->get_graph().get_num_vertices(), parallel_state_space->get_graph().get_num_vertices());
+            EXPECT_EQ(sequential_state_space->get_graph().get_num_edges(), parallel_state_space->get_graph().get_num_edges());
+            EXPECT_EQ(sequential_state_space->get_goal_vertices(), parallel_state_space->get_goal_vertices());
+            EXPECT_EQ(sequential_state_space->get_unsolvable_vertices(), parallel_state_space->get_unsolvable_vertices());
+            if (symmetry_pruning)
+            {
+                EXPECT_EQ(sequential_state_spaces[i].second->cert_to_v_idx.size(), parallel_state_spaces[i].second->cert_to_v_idx.size());
+                EXPECT_EQ(sequential_state_spaces[i].second->state_to_cert.size(), parallel_state_spaces[i].second->state_to_cert.size());
+            }
+        }
+    };
+
+    const auto gripper_directory = std::string(DATA_DIR) + "gripper/";
+    const auto spanner_directory = std::string(DATA_DIR) + "spanner/";
+    for (const auto symmetry_pruning : { false, true })
+    {
+        compare(fs::path(gripper_directory + "domain.pddl"),
+                std::vector<fs::path> { fs::path(gripper_directory + "p-1-0.pddl"),
+                                        fs::path(gripper_directory + "p-2-0.pddl"),
+                                        fs::path(gripper_directory + "test_problem.pddl"),
+                                        fs::path(gripper_directory + "test_problem2.pddl") },
+                symmetry_pruning);
+
+        compare(fs::path(spanner_directory + "domain.pddl"),
+                std::vector<fs::path> { fs::path(spanner_directory + "p-1-1-2-1.pddl"),
+                                        fs::path(spanner_directory + "p-1-1-2-1(2).pddl"),
+                                        fs::path(spanner_directory + "p-1-1-3-1.pddl") },
+                symmetry_pruning);
+    }
+
+    // Reachability has axioms, which serializes the successor construction.
+    compare(fs::path(std::string(DATA_DIR) + "reachability/domain.pddl"),
+            std::vector<fs::path> { fs::path(std::string(DATA_DIR) + "reachability/test_problem.pddl") },
+            false);
+}
+
+TEST(MimirTests, DatasetsTupleGraphParallelTest)
+{
+    /* Test that the tuple graphs created concurrently with reused workspaces equal the sequentially created ones,
+       with and without symmetry reduction. */
+    const auto compare = [](const fs::path& domain_file, const fs::path& problem_file, bool symmetry_pruning, size_t width)
+    {
+        auto state_space_options = state_space::Options();
+        state_space_options.symmetry_pruning = symmetry_pruning;
+        auto result = StateSpaceImpl::create(search::SearchContextImpl::create(domain_file, problem_file), state_space_options);
+        ASSERT_TRUE(result.has_value());
+        auto& [state_space, certificate_maps] = result.value();
+
+        const auto sequential_tuple_graphs = TupleGraphImpl::create(state_space, certificate_maps, tuple_graph::Options(width, true, 1));
+        const auto parallel_tuple_graphs = TupleGraphImpl::create(state_space, certificate_maps, tuple_graph::Options(width, true, 4));
+
+        ASSERT_EQ(sequential_tuple_graphs.size(), state_space->get_graph().get_num_vertices());
+        ASSERT_EQ(sequential_tuple_graphs.size(), parallel_tuple_graphs.size());
+        for (size_t i = 0; i < sequential_tuple_graphs.size(); ++i)
+        {
+            const auto& sequential_tuple_graph = *sequential_tuple_graphs[i];
+            const auto& parallel_tuple_graph = *parallel_tuple_graphs[i];
+
+            EXPECT_EQ(sequential_tuple_graph.get_graph().get_num_vertices(), parallel_tuple_graph.get_graph().get_num_vertices());
+            EXPECT_EQ(sequential_tuple_graph.get_graph().get_num_edges(), parallel_tuple_graph.get_graph().get_num_edges());
+            EXPECT_EQ(sequential_tuple_graph.get_tuple_vertex_indices_grouped_by_distance().size(),
+                      parallel_tuple_graph.get_tuple_vertex_indices_grouped_by_distance().size());
+            EXPECT_EQ(sequential_tuple_graph.get_estimated_memory_usage_in_bytes(), parallel_tuple_graph.get_estimated_memory_usage_in_bytes());
+            EXPECT_GT(sequential_tuple_graph.get_estimated_memory_usage_in_bytes(), size_t(0));
+
+            for (const auto& vertex : sequential_tuple_graph.get_graph().get_vertices())
+            {
+                const auto& parallel_vertex = parallel_tuple_graph.get_graph().get_vertex(vertex.get_index());
+                EXPECT_EQ(graphs::get_atom_tuple(vertex), graphs::get_atom_tuple(parallel_vertex));
+                EXPECT_EQ(graphs::get_problem_vertices(vertex), graphs::get_problem_vertices(parallel_vertex));
+            }
+        }
+    };
+
+    for (const auto symmetry_pruning : { false, true })
+    {
+        for (const auto width : { size_t(0), size_t(1), size_t(2) })
+        {
+            compare(fs::path(std::string(DATA_DIR) + "gripper/domain.pddl"),
+                    fs::path(std::string(DATA_DIR) + "gripper/p-2-0.pddl"),
+                    symmetry_pruning,
+                    width);
+            compare(fs::path(std::string(DATA_DIR) + "spanner/domain.pddl"),
+                    fs::path(std::string(DATA_DIR) + "spanner/p-1-1-3-1.pddl"),
+                    symmetry_pruning,
+                    width);
+        }
+    }
+}
+
 }
@@ -20,11 +20,20 @@
 #include "mimir/common/equal_to.hpp"
 #include "mimir/common/hash.hpp"
 #include "mimir/datasets/state_space.hpp"
+#include "mimir/formalism/ground_atom.hpp"
+#include "mimir/formalism/ground_literal.hpp"
+#include "mimir/formalism/object.hpp"
 #include "mimir/formalism/problem.hpp"
+#include "mimir/formalism/repositories.hpp"
 #include "mimir/graphs/algorithms/nauty.hpp"
 #include "mimir/search/search_context.hpp"
+#include "mimir/search/state.hpp"
+#include "utils/random_walk.hpp"
 
+#include <algorithm>
 #include <gtest/gtest.h>
+#include <map>
+#include <optional>
 #include <unordered_set>
 
 using namespace mimir::datasets;
@@ -34,6 +43,95 @@ using namespace mimir::graphs;
 namespace mimir::tests
 {
 
+/// @brief Create the object graph of a state as `create_object_graph` did before it delegated to `ObjectGraphBuilder`,
+/// except for the isolated copy of each object vertex, which does not change the certificate classes.
+static StaticVertexColoredGraph create_reference_object_graph(const search::State& state, const ProblemImpl& problem)
+{
+    const auto& repositories = problem.get_repositories();
+    const auto& static_atoms = problem.get_static_initial_atoms();
+    const auto fluent_atoms = repositories.get_ground_atoms_from_indices<FluentTag>(state.get_atoms<FluentTag>());
+    const auto derived_atoms = repositories.get_ground_atoms_from_indices<DerivedTag>(state.get_atoms<DerivedTag>());
+
+    /* Objects, colored by their unary atoms and unary goal literals. */
+
+    auto object_to_predicates = std::map<Index, PredicateVariantList> {};
+    auto object_to_literals = std::map<Index, std::vector<std::pair<PredicateVariant, bool>>> {};
+    const auto add_objects = [&](auto&& atom, std::optional<bool> polarity)
+    {
+        for (const auto& object : atom->get_objects())
+        {
+            object_to_predicates[object->get_index()];
+            object_to_literals[object->get_index()];
+        }
+        if (atom->get_arity() == 1)
+        {
+            const auto object_index = atom->get_objects().front()->get_index();
+            if (polarity)
+                object_to_literals[object_index].emplace_back(atom->get_predicate(), polarity.value());
+            else
+                object_to_predicates[object_index].push_back(atom->get_predicate());
+        }
+    };
+    for (const auto& atom : static_atoms)
+        add_objects(atom, std::nullopt);
+    for (const auto& atom : fluent_atoms)
+        add_objects(atom, std::nullopt);
+    for (const auto& atom : derived_atoms)
+        add_objects(atom, std::nullopt);
+    boost::hana::for_each(problem.get_hana_goal_condition(),
+                          [&](auto&& pair)
+                          {
+                              for (const auto& literal : boost::hana::second(pair))
+                                  add_objects(literal->get_atom(), literal->get_polarity());
+                          });
+
+    auto graph = StaticVertexColoredGraph();
+    auto object_to_vertex = std::map<Index, VertexIndex> {};
+    for (auto& [object_index, predicates] : object_to_predicates)
+    {
+        auto& literals = object_to_literals.at(object_index);
+        std::sort(predicates.begin(), predicates.end());
+        std::sort(literals.begin(), literals.end());
+        object_to_vertex.emplace(object_index, graph.add_vertex(Color(VariadicColor(predicates, literals))));
+    }
+
+    /* Atoms and goal literals of arity other than one, whose vertices are chained along the positions of the objects. */
+
+    const auto add_atom = [&](auto&& atom, std::optional<bool> polarity)
+    {
+        const auto& objects = atom->get_objects();
+        if (objects.empty())
+        {
+            graph.add_vertex(polarity ? Color(VariadicColor(atom->get_predicate(), polarity.value())) : Color(VariadicColor(atom->get_predicate())));
+        }
+        else if (objects.size() > 1)
+        {
+            for (size_t pos = 0; pos < objects.size(); ++pos)
+            {
+                const auto vertex = graph.add_vertex(polarity ? Color(VariadicColor(atom->get_predicate(), pos, polarity.value())) :
+                                                                Color(VariadicColor(atom->get_predicate(), pos)));
+                graph.add_undirected_edge(vertex, object_to_vertex.at(objects[pos]->get_index()));
+                if (pos > 0)
+                    graph.add_undirected_edge(vertex - 1, vertex);
+            }
+        }
+    };
+    for (const auto& atom : static_atoms)
+        add_atom(atom, std::nullopt);
+    for (const auto& atom : fluent_atoms)
+        add_atom(atom, std::nullopt);
+    for (const auto& atom : derived_atoms)
+        add_atom(atom, std::nullopt);
+    boost::hana::for_each(problem.get_hana_goal_condition(),
+                          [&](auto&& pair)
+                          {
+                              for (const auto& literal : boost::hana::second(pair))
+                                  add_atom(literal->get_atom(), literal->get_polarity());
+                          });
+
+    return graph;
+}
+
 TEST(MimirTests, DataSetsObjectGraphSparseTest)
 {
     const auto domain_file = fs::path(std::string(DATA_DIR) + "gripper/domain.pddl");
@@ -54,4 +152,96 @@ TEST(MimirTests, DataSetsObjectGraphSparseTest)
     EXPECT_EQ(certificates.size(), 12);
 }
 
+TEST(MimirTests, DataSetsObjectGraphBuilderTest)
+{
+    const auto domain_file = fs::path(std::string(DATA_DIR) + "gripper/domain.pddl");
+    const auto problem_file = fs::path(std::string(DATA_DIR) + "gripper/p-2-0.pddl");
+
+    auto options = state_space::Options();
+    options.symmetry_pruning = false;
+    const auto context = search::SearchContextImpl::create(domain_file, problem_file);
+    const auto state_space_result = StateSpaceImpl::create(context, options);
+    const auto& graph = state_space_result->first->get_graph();
+
+    auto builder = ObjectGraphBuilder(*context->get_problem());
+    auto states = search::StateList {};
+    auto flat_graphs = std::vector<FlatObjectGraph>(graph.get_num_vertices());
+    auto certificates = UnorderedSet<nauty::SparseGraph> {};
+    auto object_graph = StaticVertexColoredGraph();
+
+    for (const auto& vertex : graph.get_vertices())
+    {
+        const auto& state = get_state(vertex);
+        states.push_back(state);
+        builder.create(state, flat_graphs[vertex.get_index()]);
+        builder.translate(flat_graphs[vertex.get_index()], object_graph);
+
+        // The reference graph is created independently of the builder, so equal certificates mean isomorphic graphs.
+        const auto certificate = nauty::SparseGraph(object_graph).canonize();
+        const auto reference_certificate = nauty::SparseGraph(create_reference_object_graph(state, *context->get_problem())).canonize();
+        EXPECT_TRUE(loki::EqualTo<nauty::SparseGraph>()(certificate, reference_certificate));
+        certificates.insert(certificate);
+    }
+
+    EXPECT_EQ(certificates.size(), 12);
+
+    /* The batch concatenates the graphs. */
+
+    auto batch = ObjectGraphBatch();
+    builder.create(states, batch);
+
+    EXPECT_EQ(batch.get_num_graphs(), states.size());
+    for (size_t i = 0; i < states.size(); ++i)
+    {
+        const auto& flat_graph = flat_graphs[i];
+        EXPECT_EQ(batch.vertex_offsets[i + 1] - batch.vertex_offsets[i], flat_graph.get_num_vertices());
+        EXPECT_EQ(batch.edge_offsets[i + 1] - batch.edge_offsets[i], flat_graph.get_num_edges());
+        EXPECT_TRUE(std::equal(flat_graph.vertex_colors.begin(), flat_graph.vertex_colors.end(), batch.vertex_colors.begin() + batch.vertex_offsets[i]));
+    }
+}
+
+
+TEST(MimirTests, DataSetsObjectGraphBuilderFromParentTest)
+{
+    const auto context = search::SearchContextImpl::create(fs::path(std::string(DATA_DIR) + "gripper/domain.pddl"),
+                                                           fs::path(std::string(DATA_DIR) + "gripper/test_problem2.pddl"));
+
+    auto builder = ObjectGraphBuilder(*context->get_problem());
+    auto parent_graph = FlatObjectGraph();
+    auto derived_graph = FlatObjectGraph();
+    auto graph = FlatObjectGraph();
+    auto object_graph = StaticVertexColoredGraph();
+
+    // Each graph is derived from the previous derived graph, where restarts of the walk jump to the initial state.
+    const auto walk = collect_random_walk(*context->get_applicable_action_generator(), *context->get_state_repository(), 200, 50);
+    builder.create(walk.front().first, parent_graph);
+    for (size_t i = 1; i < walk.size(); ++i)
+    {
+        const auto& parent_state = walk[i - 1].first;
+        const auto& state = walk[i].first;
+        builder.create(state, parent_state, parent_graph, derived_graph);
+        builder.create(state, graph);
+
+        // The object vertices are identical, and the other vertices are permuted.
+        EXPECT_EQ(derived_graph.objects, graph.objects);
+        EXPECT_EQ(derived_graph.object_num_atoms, graph.object_num_atoms);
+        EXPECT_EQ(derived_graph.get_num_vertices(), graph.get_num_vertices());
+        EXPECT_EQ(derived_graph.get_num_edges(), graph.get_num_edges());
+        EXPECT_TRUE(std::equal(graph.vertex_colors.begin(), graph.vertex_colors.begin() + graph.objects.size(), derived_graph.vertex_colors.begin()));
+        auto derived_colors = derived_graph.vertex_colors;
+        auto colors = graph.vertex_colors;
+        std::sort(derived_colors.begin(), derived_colors.end());
+        std::sort(colors.begin(), colors.end());
+        EXPECT_EQ(derived_colors, colors);
+
+        builder.translate(derived_graph, object_graph);
+        const auto derived_certificate = nauty::SparseGraph(object_graph).canonize();
+        builder.translate(graph, object_graph);
+        const auto certificate = nauty::SparseGraph(object_graph).canonize();
+        EXPECT_TRUE(loki::EqualTo<nauty::SparseGraph>()(derived_certificate, certificate));
+
+        std::swap(parent_graph, derived_graph);
+    }
+}
+
 }
@@ -0,0 +1,95 @@
+/*
+ * Copyright (C) 2023 Dominik Drexler and Simon Stahlberg
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "mimir/formalism/assignment_set.hpp"
+
+#include "mimir/formalism/domain.hpp"
+#include "mimir/formalism/problem.hpp"
+#include "mimir/formalism/repositories.hpp"
+#include "mimir/search/applicable_action_generators/interface.hpp"
+#include "mimir/search/search_context.hpp"
+#include "mimir/search/state_repository.hpp"
+#include "utils/random_walk.hpp"
+
+#include <gtest/gtest.h>
+
+using namespace mimir::search;
+using namespace mimir::formalism;
+
+namespace mimir::tests
+{
+
+static void expect_equal_assignment_sets(const AssignmentSet<FluentTag>& lhs, const AssignmentSet<FluentTag>& rhs, const PredicateList<FluentTag>& predicates)
+{
+    for (const auto& predicate : predicates)
+    {
+        const auto lhs_predicate_assignment_set = lhs.get_predicate_assignment_set(predicate->get_index());
+        const auto rhs_predicate_assignment_set = rhs.get_predicate_assignment_set(predicate->get_index());
+        ASSERT_EQ(lhs_predicate_assignment_set.size(), rhs_predicate_assignment_set.size());
+
+        for (size_t rank = 0; rank < lhs_predicate_assignment_set.size(); ++rank)
+        {
+            EXPECT_EQ(lhs_predicate_assignment_set[rank], rhs_predicate_assignment_set[rank]);
+        }
+    }
+}
+
+TEST(MimirTests, FormalismAssignmentSetInsertEraseTest)
+{
+    const auto problem =
+        ProblemImpl::create(fs::path(std::string(DATA_DIR) + "gripper/domain.pddl"), fs::path(std::string(DATA_DIR) + "gripper/test_problem.pddl"));
+    const auto& predicates = problem->get_domain()->get_predicates<FluentTag>();
+    const auto num_objects = problem->get_problem_and_domain_objects().size();
+    const auto context = SearchContextImpl::create(problem, SearchContextImpl::Options(SearchContextImpl::SearchMode::GROUNDED));
+    const auto initial_state = context->get_state_repository()->get_or_create_initial_state().first;
+    const auto initial_atoms = problem->get_repositories().get_ground_atoms_from_indices<FluentTag>(initial_state.get_atoms<FluentTag>());
+
+    auto empty_assignment_set = AssignmentSet<FluentTag>(num_objects, predicates);
+    auto assignment_set = AssignmentSet<FluentTag>(num_objects, predicates);
+
+    // Inserting twice and erasing once keeps the atoms because inserting is idempotent.
+    assignment_set.insert_ground_atoms(initial_atoms);
+    assignment_set.insert_ground_atoms(initial_atoms);
+    assignment_set.erase_ground_atoms(initial_atoms);
+    expect_equal_assignment_sets(assignment_set, empty_assignment_set, predicates);
+    EXPECT_EQ(assignment_set.get_atoms().count(), 0);
+}
+
+TEST(MimirTests, FormalismAssignmentSetUpdateTest)
+{
+    const auto problem =
+        ProblemImpl::create(fs::path(std::string(DATA_DIR) + "gripper/domain.pddl"), fs::path(std::string(DATA_DIR) + "gripper/test_problem.pddl"));
+    const auto& predicates = problem->get_domain()->get_predicates<FluentTag>();
+    const auto num_objects = problem->get_problem_and_domain_objects().size();
+    const auto context = SearchContextImpl::create(problem, SearchContextImpl::Options(SearchContextImpl::SearchMode::GROUNDED));
+
+    auto incremental_assignment_set = AssignmentSet<FluentTag>(num_objects, predicates);
+
+    // Follow a random walk, which yields small differences, and jump back to the initial state, which yields larger ones.
+    for (const auto& [state, state_metric_value] : collect_random_walk(*context->get_applicable_action_generator(), *context->get_state_repository(), 100, 20))
+    {
+        incremental_assignment_set.update_ground_atoms(state.get_atoms<FluentTag>(), problem->get_repositories());
+
+        auto rebuilt_assignment_set = AssignmentSet<FluentTag>(num_objects, predicates);
+        rebuilt_assignment_set.insert_ground_atoms(problem->get_repositories().get_ground_atoms_from_indices<FluentTag>(state.get_atoms<FluentTag>()));
+        expect_equal_assignment_sets(incremental_assignment_set, rebuilt_assignment_set, predicates);
+        EXPECT_EQ(std::vector<size_t>(incremental_assignment_set.get_atoms().begin(), incremental_assignment_set.get_atoms().end()),
+                  std::vector<size_t>(state.get_atoms<FluentTag>().begin(), state.get_atoms<FluentTag>().end()));
+    }
+}
+
+}
@@ -0,0 +1,234 @@
+/*
+ * Copyright (C) 2023 Dominik Drexler and Simon Stahlberg
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#include "mimir/formalism/numeric_bytecode.hpp"
+
+#include "mimir/formalism/ground_action.hpp"
+#include "mimir/formalism/ground_conjunctive_condition.hpp"
+#include "mimir/formalism/ground_effects.hpp"
+#include "mimir/formalism/ground_function_expressions.hpp"
+#include "mimir/formalism/ground_numeric_constraint.hpp"
+#include "mimir/formalism/metric.hpp"
+#include "mimir/formalism/problem.hpp"
+#include "mimir/formalism/repositories.hpp"
+#include "mimir/search/applicable_action_generators.hpp"
+#include "mimir/search/search_context.hpp"
+#include "mimir/search/state_repository.hpp"
+#include "utils/random_walk.hpp"
+
+#include <algorithm>
+#include <gtest/gtest.h>
+#include <unordered_set>
+
+using namespace mimir::search;
+using namespace mimir::formalism;
+
+namespace mimir::tests
+{
+
+TEST(MimirTests, FormalismNumericBytecodeTest)
+{
+    auto repositories = Repositories();
+
+    const auto number = [&](double value)
+    { return repositories.get_or_create_ground_function_expression(repositories.get_or_create_ground_function_expression_number(value)); };
+    const auto binary = [&](loki::BinaryOperatorEnum binary_operator, GroundFunctionExpression lhs, GroundFunctionExpression rhs)
+    {
+        return repositories.get_or_create_ground_function_expression(
+            repositories.get_or_create_ground_function_expression_binary_operator(binary_operator, lhs, rhs));
+    };
+    const auto multi = [&](loki::MultiOperatorEnum multi_operator, GroundFunctionExpressionList fexprs)
+    {
+        return repositories.get_or_create_ground_function_expression(
+            repositories.get_or_create_ground_function_expression_multi_operator(multi_operator, std::move(fexprs)));
+    };
+    const auto minus = [&](GroundFunctionExpression fexpr)
+    { return repositories.get_or_create_ground_function_expression(repositories.get_or_create_ground_function_expression_minus(fexpr)); };
+
+    const auto static_function = repositories.get_or_create_ground_function_expression(repositories.get_or_create_ground_function_expression_function(
+        repositories.get_or_create_ground_function(repositories.get_or_create_function_skeleton<StaticTag>("capacity", VariableList {}), ObjectList {})));
+    const auto fluent_function = repositories.get_or_create_ground_function_expression(repositories.get_or_create_ground_function_expression_function(
+        repositories.get_or_create_ground_function(repositories.get_or_create_function_skeleton<FluentTag>("fuel", VariableList {}), ObjectList {})));
+
+    const auto static_numeric_variables = FlatDoubleList { 10. };
+    const auto fluent_numeric_variables = FlatDoubleList { 4. };
+    const auto undefined_fluent_numeric_variables = FlatDoubleList { UNDEFINED_CONTINUOUS_COST };
+    const auto empty_numeric_variables = FlatDoubleList {};
+
+    const auto compile = [](GroundFunctionExpression fexpr)
+    {
+        auto bytecode = NumericBytecode();
+        bytecode.append(fexpr);
+        return bytecode;
+    };
+
+    // capacity - (fuel * 2) / (1 + fuel + fuel) = 10 - 8 / 9
+    const auto fexpr = binary(loki::BinaryOperatorEnum::MINUS,
+                              static_function,
+                              binary(loki::BinaryOperatorEnum::DIV,
+                                     binary(loki::BinaryOperatorEnum::MUL, fluent_function, number(2.)),
+                                     multi(loki::MultiOperatorEnum::PLUS, { number(1.), fluent_function, fluent_function })));
+    const auto bytecode = compile(fexpr);
+    EXPECT_EQ(bytecode.get_num_programs(), 1);
+    EXPECT_EQ(bytecode.evaluate(static_numeric_variables, fluent_numeric_variables), 10. - 8. / 9.);
+    EXPECT_EQ(bytecode.evaluate(static_numeric_variables, fluent_numeric_variables), evaluate(fexpr, static_numeric_variables, fluent_numeric_variables));
+
+    // Undefined values propagate through all operators.
+    EXPECT_EQ(bytecode.evaluate(static_numeric_variables, undefined_fluent_numeric_variables), UNDEFINED_CONTINUOUS_COST);
+    EXPECT_EQ(compile(minus(fluent_function)).evaluate(static_numeric_variables, undefined_fluent_numeric_variables), UNDEFINED_CONTINUOUS_COST);
+    EXPECT_EQ(compile(minus(fluent_function)).evaluate(static_numeric_variables, fluent_numeric_variables), -4.);
+
+    // Functions without values are undefined.
+    EXPECT_EQ(bytecode.evaluate(empty_numeric_variables, fluent_numeric_variables), UNDEFINED_CONTINUOUS_COST);
+    EXPECT_EQ(bytecode.evaluate(static_numeric_variables, empty_numeric_variables), UNDEFINED_CONTINUOUS_COST);
+
+    // Division by zero is undefined.
+    EXPECT_EQ(compile(binary(loki::BinaryOperatorEnum::DIV, number(1.), number(0.))).evaluate(static_numeric_variables, fluent_numeric_variables),
+              UNDEFINED_CONTINUOUS_COST);
+
+    // Numeric constraints with an undefined side do not hold.
+    const auto fuel_at_most_capacity =
+        repositories.get_or_create_ground_numeric_constraint(loki::BinaryComparatorEnum::LESS_EQUAL, fluent_function, static_function);
+    const auto fuel_greater_capacity =
+        repositories.get_or_create_ground_numeric_constraint(loki::BinaryComparatorEnum::GREATER, fluent_function, static_function);
+    EXPECT_TRUE(evaluate(fuel_at_most_capacity, static_numeric_variables, fluent_numeric_variables));
+    EXPECT_FALSE(evaluate(fuel_greater_capacity, static_numeric_variables, fluent_numeric_variables));
+    EXPECT_FALSE(evaluate(fuel_at_most_capacity, static_numeric_variables, undefined_fluent_numeric_variables));
+    EXPECT_FALSE(evaluate(fuel_greater_capacity, static_numeric_variables, undefined_fluent_numeric_variables));
+
+    // The batch evaluates all numeric constraints against the same numeric variables.
+    auto batch = NumericBytecode();
+    batch.append(fuel_at_most_capacity->get_bytecode());
+    batch.append(fuel_greater_capacity->get_bytecode());
+    batch.append(fexpr);
+    auto values = std::vector<ContinuousCost> {};
+    batch.evaluate(static_numeric_variables, fluent_numeric_variables, values);
+    EXPECT_EQ(values, (std::vector<ContinuousCost> { 1., 0., 10. - 8. / 9. }));
+    EXPECT_FALSE(batch.holds(static_numeric_variables, fluent_numeric_variables));
+    EXPECT_EQ(batch.get_max_stack_size(), 4);
+
+    // The metric evaluates its function expression.
+    const auto metric = repositories.get_or_create_optimization_metric(loki::OptimizationMetricEnum::MINIMIZE, fexpr);
+    EXPECT_EQ(evaluate(metric, static_numeric_variables, fluent_numeric_variables), 10. - 8. / 9.);
+}
+
+/// @brief Compare the bytecode of the numeric constraints and effects of the actions seen so far
+/// with the recursive evaluation of their function expressions in the states along a random walk.
+/// @return the number of evaluated numeric constraints that hold and that do not hold.
+static std::pair<size_t, size_t> test_numeric_bytecode(const fs::path& domain_file, const fs::path& problem_file, size_t num_steps)
+{
+    const auto problem = ProblemImpl::create(domain_file, problem_file);
+    const auto search_context = SearchContextImpl::create(problem, SearchContextImpl::Options(SearchContextImpl::SearchMode::LIFTED));
+    auto& applicable_action_generator = *search_context->get_applicable_action_generator();
+    const auto& static_numeric_variables = problem->get_initial_function_to_value<StaticTag>();
+
+    auto seen_actions = std::unordered_set<GroundAction> {};
+    auto values = std::vector<ContinuousCost> {};
+    auto num_holding_constraints = size_t(0);
+    auto num_violated_constraints = size_t(0);
+
+    const auto walk = collect_random_walk(applicable_action_generator, *search_context->get_state_repository(), num_steps, 50);
+    for (size_t step = 0; step < walk.size(); ++step)
+    {
+        const auto& state = walk[step].first;
+        for (const auto& action : applicable_action_generator.create_applicable_action_generator(state))
+        {
+            seen_actions.insert(action);
+        }
+
+        const auto& fluent_numeric_variables = state.get_numeric_variables();
+        for (const auto& action : seen_actions)
+        {
+            const auto conjunctive_condition = action->get_conjunctive_condition();
+            conjunctive_condition->get_numeric_constraint_bytecode().evaluate(static_numeric_variables, fluent_numeric_variables, values);
+            EXPECT_EQ(values.size(), conjunctive_condition->get_numeric_constraints().size());
+
+            for (size_t i = 0; i < std::min(values.size(), conjunctive_condition->get_numeric_constraints().size()); ++i)
+            {
+                const auto constraint = conjunctive_condition->get_numeric_constraints()[i];
+                const auto left_value = evaluate(constraint->get_left_function_expression(), static_numeric_variables, fluent_numeric_variables);
+                const auto right_value = evaluate(constraint->get_right_function_expression(), static_numeric_variables, fluent_numeric_variables);
+                const auto is_defined = (left_value != UNDEFINED_CONTINUOUS_COST && right_value != UNDEFINED_CONTINUOUS_COST);
+
+                auto holds = false;
+                switch (constraint->get_binary_comparator())
+                {
+                    case loki::BinaryComparatorEnum::EQUAL:
+                    {
+                        holds = is_defined && left_value == right_value;
+                        break;
+                    }
+                    case loki::BinaryComparatorEnum::GREATER:
+                    {
+                        holds = is_defined && left_value > right_value;
+                        break;
+                    }
+                    case loki::BinaryComparatorEnum::GREATER_EQUAL:
+                    {
+                        holds = is_defined && left_value >= right_value;
+                        break;
+                    }
+                    case loki::BinaryComparatorEnum::LESS:
+                    {
+                        holds = is_defined && left_value < right_value;
+                        break;
+                    }
+                    case loki::BinaryComparatorEnum::LESS_EQUAL:
+                    {
+                        holds = is_defined && left_value <= right_value;
+                        break;
+                    }
+                    default:
+                    {
+                        ADD_FAILURE() << "Unexpected loki::BinaryComparatorEnum.";
+                    }
+                }
+                EXPECT_EQ(values[i], holds ? 1. : 0.) << "at step " << step;
+                EXPECT_EQ(evaluate(constraint, static_numeric_variables, fluent_numeric_variables), holds) << "at step " << step;
+                ++(holds ? num_holding_constraints : num_violated_constraints);
+            }
+
+            for (const auto& effect : action->get_conjunctive_effect()->get_fluent_numeric_effects())
+            {
+                EXPECT_EQ(effect->get_bytecode().evaluate(static_numeric_variables, fluent_numeric_variables),
+                          evaluate(effect->get_function_expression(), static_numeric_variables, fluent_numeric_variables))
+                    << "at step " << step;
+            }
+        }
+    }
+
+    return { num_holding_constraints, num_violated_constraints };
+}
+
+TEST(MimirTests, FormalismNumericBytecodeFoCountersTest)
+{
+    const auto [num_holding_constraints, num_violated_constraints] = test_numeric_bytecode(fs::path(std::string(DATA_DIR) + "fo-counters/domain.pddl"),
+                                                                                           fs::path(std::string(DATA_DIR) + "fo-counters/test_problem.pddl"),
+                                                                                           200);
+
+    // Actions seen in other states exercise both outcomes.
+    EXPECT_GT(num_holding_constraints, 0);
+    EXPECT_GT(num_violated_constraints, 0);
+}
+
+TEST(MimirTests, FormalismNumericBytecodeRefuelTest)
+{
+    test_numeric_bytecode(fs::path(std::string(DATA_DIR) + "refuel/domain.pddl"), fs::path(std::string(DATA_DIR) + "refuel/test_problem.pddl"), 200);
+}
+
+}
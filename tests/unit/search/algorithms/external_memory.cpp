@@ -0,0 +1,150 @@
+/*
+ * Copyright (C) 2023 Dominik Drexler and Simon Stahlberg
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "mimir/search/algorithms/external_memory.hpp"
+
+#include "mimir/formalism/repositories.hpp"
+#include "mimir/search/algorithms/astar_eager.hpp"
+#include "mimir/search/algorithms/brfs.hpp"
+#include "mimir/search/heuristics.hpp"
+#include "mimir/search/plan.hpp"
+#include "mimir/search/search_context.hpp"
+
+#include <gtest/gtest.h>
+
+using namespace mimir::search;
+using namespace mimir::formalism;
+
+namespace mimir::tests
+{
+
+/// @brief Instantiate BrFS and blind AStar in external memory mode with a tiny memory limit that forces spilling to disk.
+class ExternalMemoryPlanner
+{
+private:
+    Problem m_problem;
+    SearchContext m_search_context;
+    ExternalMemoryOptions m_external_memory_options;
+
+public:
+    ExternalMemoryPlanner(const fs::path& domain_file, const fs::path& problem_file, SearchContextImpl::SearchMode mode) :
+        m_problem(ProblemImpl::create(domain_file, problem_file)),
+        m_search_context(SearchContextImpl::create(m_problem, SearchContextImpl::Options(mode))),
+        m_external_memory_options()
+    {
+        m_external_memory_options.memory_limit_in_bytes = 4096;
+    }
+
+    SearchResult find_solution_brfs()
+    {
+        auto options = brfs::Options();
+        options.external_memory = m_external_memory_options;
+
+        return brfs::find_solution(m_search_context, options);
+    }
+
+    SearchResult find_solution_astar()
+    {
+        auto options = astar_eager::Options();
+        options.external_memory = m_external_memory_options;
+
+        return astar_eager::find_solution(m_search_context, BlindHeuristicImpl::create(m_problem), options);
+    }
+
+    const fs::path& get_directory() const { return m_external_memory_options.directory; }
+};
+
+static size_t count_working_directories(const fs::path& directory)
+{
+    auto count = size_t(0);
+    for (const auto& entry : fs::directory_iterator(directory))
+    {
+        count += (entry.path().filename().string().starts_with("mimir-external-memory-"));
+    }
+    return count;
+}
+
+/**
+ * Gripper
+ */
+
+TEST(MimirTests, SearchAlgorithmsExternalMemoryBrFSGroundedGripperTest)
+{
+    auto planner = ExternalMemoryPlanner(fs::path(std::string(DATA_DIR) + "gripper/domain.pddl"),
+                                         fs::path(std::string(DATA_DIR) + "gripper/test_problem.pddl"),
+                                         SearchContextImpl::SearchMode::GROUNDED);
+    const auto num_working_directories = count_working_directories(planner.get_directory());
+    auto result = planner.find_solution_brfs();
+
+    EXPECT_EQ(result.status, SearchStatus::SOLVED);
+    EXPECT_EQ(result.plan.value().get_actions().size(), 3);
+    EXPECT_EQ(count_working_directories(planner.get_directory()), num_working_directories);
+}
+
+TEST(MimirTests, SearchAlgorithmsExternalMemoryAStarLiftedBlindGripperTest)
+{
+    auto planner = ExternalMemoryPlanner(fs::path(std::string(DATA_DIR) + "gripper/domain.pddl"),
+                                         fs::path(std::string(DATA_DIR) + "gripper/test_problem.pddl"),
+                                         SearchContextImpl::SearchMode::LIFTED);
+    auto result = planner.find_solution_astar();
+
+    EXPECT_EQ(result.status, SearchStatus::SOLVED);
+    EXPECT_EQ(result.plan.value().get_actions().size(), 3);
+}
+
+/**
+ * Barman
+ */
+
+TEST(MimirTests, SearchAlgorithmsExternalMemoryBrFSGroundedBarmanTest)
+{
+    auto planner = ExternalMemoryPlanner(fs::path(std::string(DATA_DIR) + "barman/domain.pddl"),
+                                         fs::path(std::string(DATA_DIR) + "barman/test_problem.pddl"),
+                                         SearchContextImpl::SearchMode::GROUNDED);
+    auto result = planner.find_solution_brfs();
+
+    EXPECT_EQ(result.status, SearchStatus::SOLVED);
+    EXPECT_EQ(result.plan.value().get_actions().size(), 11);
+}
+
+TEST(MimirTests, SearchAlgorithmsExternalMemoryAStarGroundedBlindBarmanTest)
+{
+    auto planner = ExternalMemoryPlanner(fs::path(std::string(DATA_DIR) + "barman/domain.pddl"),
+                                         fs::path(std::string(DATA_DIR) + "barman/test_problem.pddl"),
+                                         SearchContextImpl::SearchMode::GROUNDED);
+    auto result = planner.find_solution_astar();
+
+    EXPECT_EQ(result.status, SearchStatus::SOLVED);
+    EXPECT_EQ(result.plan.value().get_actions().size(), 11);
+}
+
+/**
+ * Fo-Counters
+ */
+
+TEST(MimirTests, SearchAlgorithmsExternalMemoryAStarGroundedBlindFoCountersTest)
+{
+    auto planner = ExternalMemoryPlanner(fs::path(std::string(DATA_DIR) + "fo-counters/domain.pddl"),
+                                         fs::path(std::string(DATA_DIR) + "fo-counters/test_problem.pddl"),
+                                         SearchContextImpl::SearchMode::GROUNDED);
+    auto result = planner.find_solution_astar();
+
+    EXPECT_EQ(result.status, SearchStatus::SOLVED);
+    EXPECT_EQ(result.plan.value().get_actions().size(), 5);
+}
+
+}
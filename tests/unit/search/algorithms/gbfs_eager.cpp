@@ -0,0 +1,90 @@
+/*
+ * Copyright (C) 2023 Dominik Drexler and Simon Stahlberg
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "mimir/search/algorithms/gbfs_eager.hpp"
+
+#include "mimir/formalism/problem.hpp"
+#include "mimir/search/algorithms.hpp"
+#include "mimir/search/delete_relaxed_problem_explorator.hpp"
+#include "mimir/search/heuristics.hpp"
+#include "mimir/search/plan.hpp"
+#include "mimir/search/search_context.hpp"
+
+#include <gtest/gtest.h>
+
+using namespace mimir::search;
+using namespace mimir::formalism;
+
+namespace mimir::tests
+{
+
+static std::pair<SearchResult, gbfs_eager::Statistics>
+find_solution_gbfs_eager(const std::string& domain_name, const std::string& problem_name, bool use_preferred_actions, bool use_second_heuristic)
+{
+    const auto search_context = SearchContextImpl::create(fs::path(std::string(DATA_DIR) + domain_name + "/domain.pddl"),
+                                                          fs::path(std::string(DATA_DIR) + domain_name + "/" + problem_name + ".pddl"));
+    auto delete_relaxed_problem_explorator = DeleteRelaxedProblemExplorator(search_context->get_problem());
+
+    auto heuristics = HeuristicList { CachingHeuristicImpl::create(FFHeuristicImpl::create(delete_relaxed_problem_explorator)) };
+    if (use_second_heuristic)
+    {
+        heuristics.push_back(AddHeuristicImpl::create(delete_relaxed_problem_explorator));
+    }
+
+    const auto event_handler = gbfs_eager::DefaultEventHandlerImpl::create(search_context->get_problem());
+    auto options = gbfs_eager::Options();
+    options.event_handler = event_handler;
+    options.use_preferred_actions = use_preferred_actions;
+
+    auto result = gbfs_eager::find_solution(search_context, heuristics, options);
+    return { std::move(result), event_handler->get_statistics() };
+}
+
+TEST(MimirTests, SearchAlgorithmsGBFSEagerGripperTest)
+{
+    const auto [result, statistics] = find_solution_gbfs_eager("gripper", "test_problem", false, false);
+    EXPECT_EQ(result.status, SearchStatus::SOLVED);
+    EXPECT_EQ(result.plan.value().get_actions().size(), 3);
+}
+
+TEST(MimirTests, SearchAlgorithmsGBFSEagerPreferredActionsTest)
+{
+    for (const auto& [domain_name, problem_name] : std::vector<std::pair<std::string, std::string>> { { "gripper", "p-2-0" },
+                                                                                                       { "blocks_4", "test_problem" },
+                                                                                                       { "logistics", "test_problem" } })
+    {
+        const auto [result, statistics] = find_solution_gbfs_eager(domain_name, problem_name, true, false);
+        EXPECT_EQ(result.status, SearchStatus::SOLVED);
+        EXPECT_GT(statistics.get_num_expanded(), 0);
+    }
+}
+
+TEST(MimirTests, SearchAlgorithmsGBFSEagerMultipleHeuristicsTest)
+{
+    for (const auto use_preferred_actions : { false, true })
+    {
+        const auto [result, statistics] = find_solution_gbfs_eager("gripper", "p-2-0", use_preferred_actions, true);
+        EXPECT_EQ(result.status, SearchStatus::SOLVED);
+        EXPECT_GT(statistics.get_num_expanded(), 0);
+    }
+
+    const auto search_context = SearchContextImpl::create(fs::path(std::string(DATA_DIR) + "gripper/domain.pddl"),
+                                                          fs::path(std::string(DATA_DIR) + "gripper/test_problem.pddl"));
+    EXPECT_THROW(gbfs_eager::find_solution(search_context, HeuristicList {}), std::invalid_argument);
+}
+
+}
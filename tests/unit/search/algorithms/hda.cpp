@@ -0,0 +1,142 @@
+/*
+ * Copyright (C) 2023 Dominik Drexler and Simon Stahlberg
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "mimir/search/algorithms/hda.hpp"
+
+#include "mimir/formalism/repositories.hpp"
+#include "mimir/search/heuristics.hpp"
+#include "mimir/search/plan.hpp"
+#include "mimir/search/search_context.hpp"
+
+#include <gtest/gtest.h>
+
+using namespace mimir::search;
+using namespace mimir::formalism;
+
+namespace mimir::tests
+{
+
+/// @brief Instantiate a hash distributed search with one blind heuristic per worker.
+class HDAPlanner
+{
+private:
+    Problem m_problem;
+    SearchContextList m_search_contexts;
+    HeuristicList m_heuristics;
+    hda::StatisticsList m_statistics;
+
+public:
+    HDAPlanner(const fs::path& domain_file, const fs::path& problem_file, SearchContextImpl::SearchMode mode, size_t num_workers) :
+        m_problem(ProblemImpl::create(domain_file, problem_file)),
+        m_search_contexts(),
+        m_heuristics(),
+        m_statistics()
+    {
+        for (size_t i = 0; i < num_workers; ++i)
+        {
+            m_search_contexts.push_back(SearchContextImpl::create(m_problem, SearchContextImpl::Options(mode)));
+            m_heuristics.push_back(BlindHeuristicImpl::create(m_problem));
+        }
+    }
+
+    SearchResult find_solution_astar() { return hda::find_solution_astar(m_search_contexts, m_heuristics, hda::Options(), &m_statistics); }
+
+    SearchResult find_solution_gbfs() { return hda::find_solution_gbfs(m_search_contexts, m_heuristics, hda::Options(), &m_statistics); }
+
+    const hda::StatisticsList& get_algorithm_statistics() const { return m_statistics; }
+};
+
+/**
+ * Gripper
+ */
+
+TEST(MimirTests, SearchAlgorithmsHDAStarGroundedBlindGripperTest)
+{
+    for (const auto num_workers : { size_t(1), size_t(4) })
+    {
+        auto hda = HDAPlanner(fs::path(std::string(DATA_DIR) + "gripper/domain.pddl"),
+                              fs::path(std::string(DATA_DIR) + "gripper/test_problem.pddl"),
+                              SearchContextImpl::SearchMode::GROUNDED,
+                              num_workers);
+        auto result = hda.find_solution_astar();
+
+        EXPECT_EQ(result.status, SearchStatus::SOLVED);
+        EXPECT_EQ(result.plan.value().get_actions().size(), 3);
+        EXPECT_EQ(hda.get_algorithm_statistics().size(), num_workers);
+    }
+}
+
+TEST(MimirTests, SearchAlgorithmsHDAStarLiftedBlindGripperTest)
+{
+    for (const auto num_workers : { size_t(1), size_t(4) })
+    {
+        auto hda = HDAPlanner(fs::path(std::string(DATA_DIR) + "gripper/domain.pddl"),
+                              fs::path(std::string(DATA_DIR) + "gripper/test_problem.pddl"),
+                              SearchContextImpl::SearchMode::LIFTED,
+                              num_workers);
+        auto result = hda.find_solution_astar();
+
+        EXPECT_EQ(result.status, SearchStatus::SOLVED);
+        EXPECT_EQ(result.plan.value().get_actions().size(), 3);
+    }
+}
+
+TEST(MimirTests, SearchAlgorithmsHDGBFSGroundedBlindGripperTest)
+{
+    auto hda = HDAPlanner(fs::path(std::string(DATA_DIR) + "gripper/domain.pddl"),
+                          fs::path(std::string(DATA_DIR) + "gripper/test_problem.pddl"),
+                          SearchContextImpl::SearchMode::GROUNDED,
+                          4);
+    auto result = hda.find_solution_gbfs();
+
+    EXPECT_EQ(result.status, SearchStatus::SOLVED);
+    EXPECT_TRUE(result.goal_state.has_value());
+}
+
+/**
+ * Barman
+ */
+
+TEST(MimirTests, SearchAlgorithmsHDAStarGroundedBlindBarmanTest)
+{
+    auto hda = HDAPlanner(fs::path(std::string(DATA_DIR) + "barman/domain.pddl"),
+                          fs::path(std::string(DATA_DIR) + "barman/test_problem.pddl"),
+                          SearchContextImpl::SearchMode::GROUNDED,
+                          4);
+    auto result = hda.find_solution_astar();
+
+    EXPECT_EQ(result.status, SearchStatus::SOLVED);
+    EXPECT_EQ(result.plan.value().get_actions().size(), 11);
+}
+
+/**
+ * Fo-Counters
+ */
+
+TEST(MimirTests, SearchAlgorithmsHDAStarGroundedBlindFoCountersTest)
+{
+    auto hda = HDAPlanner(fs::path(std::string(DATA_DIR) + "fo-counters/domain.pddl"),
+                          fs::path(std::string(DATA_DIR) + "fo-counters/test_problem.pddl"),
+                          SearchContextImpl::SearchMode::GROUNDED,
+                          4);
+    auto result = hda.find_solution_astar();
+
+    EXPECT_EQ(result.status, SearchStatus::SOLVED);
+    EXPECT_EQ(result.plan.value().get_actions().size(), 5);
+}
+
+}
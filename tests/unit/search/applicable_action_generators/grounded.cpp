@@ -21,9 +21,11 @@
 #include "mimir/search/applicable_action_generators.hpp"
 #include "mimir/search/axiom_evaluators.hpp"
 #include "mimir/search/delete_relaxed_problem_explorator.hpp"
+#include "mimir/search/match_tree/match_tree.hpp"
 #include "mimir/search/plan.hpp"
 #include "mimir/search/search_context.hpp"
 #include "mimir/search/state_repository.hpp"
+#include "utils/random_walk.hpp"
 
 #include <gtest/gtest.h>
 
@@ -66,4 +68,55 @@ TEST(MimirTests, SearchApplicableActionGeneratorsGroundedTest)
     EXPECT_EQ(brfs_statistics.get_num_expanded_until_g_value().back(), 41);
 }
 
+/// @brief Test that the compiled match trees generate the same sequence of elements as the uncompiled ones along a random walk.
+static void test_compiled_match_tree(const std::string& name)
+{
+    const auto problem = ProblemImpl::create(fs::path(std::string(DATA_DIR) + name + "/domain.pddl"),
+                                             fs::path(std::string(DATA_DIR) + name + "/test_problem.pddl"));
+    const auto search_context = SearchContextImpl::create(problem, SearchContextImpl::Options(SearchContextImpl::SearchMode::GROUNDED));
+
+    auto delete_free_problem_explorator = DeleteRelaxedProblemExplorator(problem);
+    const auto ground_actions = delete_free_problem_explorator.create_ground_actions();
+    const auto ground_axioms = delete_free_problem_explorator.create_ground_axioms();
+
+    auto compiled_options = match_tree::Options();
+    compiled_options.enable_compilation = true;
+    auto uncompiled_options = match_tree::Options();
+    uncompiled_options.enable_compilation = false;
+
+    const auto compiled_action_match_tree = match_tree::MatchTreeImpl<GroundActionImpl>::create(problem->get_repositories(), ground_actions, compiled_options);
+    const auto uncompiled_action_match_tree =
+        match_tree::MatchTreeImpl<GroundActionImpl>::create(problem->get_repositories(), ground_actions, uncompiled_options);
+    const auto compiled_axiom_match_tree = match_tree::MatchTreeImpl<GroundAxiomImpl>::create(problem->get_repositories(), ground_axioms, compiled_options);
+    const auto uncompiled_axiom_match_tree =
+        match_tree::MatchTreeImpl<GroundAxiomImpl>::create(problem->get_repositories(), ground_axioms, uncompiled_options);
+
+    ASSERT_NE(compiled_action_match_tree->get_compiled_tree(), nullptr);
+    ASSERT_EQ(uncompiled_action_match_tree->get_compiled_tree(), nullptr);
+
+    auto compiled_actions = GroundActionList {};
+    auto uncompiled_actions = GroundActionList {};
+    auto compiled_axioms = GroundAxiomList {};
+    auto uncompiled_axioms = GroundAxiomList {};
+
+    for (const auto& [state, state_metric_value] :
+         collect_random_walk(*search_context->get_applicable_action_generator(), *search_context->get_state_repository(), 100))
+    {
+        compiled_action_match_tree->generate_applicable_elements_iteratively(state.get_unpacked_state(), compiled_actions);
+        uncompiled_action_match_tree->generate_applicable_elements_iteratively(state.get_unpacked_state(), uncompiled_actions);
+        EXPECT_EQ(compiled_actions, uncompiled_actions);
+
+        compiled_axiom_match_tree->generate_applicable_elements_iteratively(state.get_unpacked_state(), compiled_axioms);
+        uncompiled_axiom_match_tree->generate_applicable_elements_iteratively(state.get_unpacked_state(), uncompiled_axioms);
+        EXPECT_EQ(compiled_axioms, uncompiled_axioms);
+    }
+}
+
+TEST(MimirTests, SearchApplicableActionGeneratorsGroundedCompiledMatchTreeTest)
+{
+    test_compiled_match_tree("miconic-fulladl");
+    test_compiled_match_tree("fo-counters");
+    test_compiled_match_tree("barman");
+}
+
 }
@@ -23,7 +23,9 @@
 #include "mimir/search/plan.hpp"
 #include "mimir/search/search_context.hpp"
 #include "mimir/search/state_repository.hpp"
+#include "utils/random_walk.hpp"
 
+#include <algorithm>
 #include <gtest/gtest.h>
 
 using namespace mimir::search;
@@ -57,7 +59,8 @@ TEST(MimirTests, SearchApplicableActionGeneratorsLiftedTest)
     EXPECT_EQ(applicable_action_generator_statistics.get_num_ground_action_cache_misses_per_search_layer().back(), 10);
 
     const auto& axiom_evaluator_statistics = axiom_evaluator_event_handler->get_statistics();
-    EXPECT_EQ(axiom_evaluator_statistics.get_num_ground_axiom_cache_hits_per_search_layer().back(), 472);
+    // The initial state generates all applicable ground axioms, while the successor states only generate the inserted and rederived ones.
+    EXPECT_EQ(axiom_evaluator_statistics.get_num_ground_axiom_cache_hits_per_search_layer().back(), 52);
     EXPECT_EQ(axiom_evaluator_statistics.get_num_ground_axiom_cache_misses_per_search_layer().back(), 15);
 
     const auto& brfs_statistics = brfs_event_handler->get_statistics();
@@ -65,4 +68,41 @@ TEST(MimirTests, SearchApplicableActionGeneratorsLiftedTest)
     EXPECT_EQ(brfs_statistics.get_num_expanded_until_g_value().back(), 41);
 }
 
+TEST(MimirTests, SearchApplicableActionGeneratorsLiftedIncrementalConsistencyGraphTest)
+{
+    for (const auto& name : { "barman", "logistics", "miconic-fulladl", "schedule" })
+    {
+        const auto domain_file = fs::path(std::string(DATA_DIR) + name + "/domain.pddl");
+        const auto problem_file = fs::path(std::string(DATA_DIR) + name + "/test_problem.pddl");
+        const auto problem = ProblemImpl::create(domain_file, problem_file);
+
+        const auto lifted_search_context = SearchContextImpl::create(problem, SearchContextImpl::Options(SearchContextImpl::SearchMode::LIFTED));
+        const auto grounded_search_context = SearchContextImpl::create(problem, SearchContextImpl::Options(SearchContextImpl::SearchMode::GROUNDED));
+        auto& state_repository = *lifted_search_context->get_state_repository();
+        auto& lifted_applicable_action_generator = *lifted_search_context->get_applicable_action_generator();
+        auto& grounded_applicable_action_generator = *grounded_search_context->get_applicable_action_generator();
+
+        // The lifted generator reuses the consistency graphs of the previous state, which must yield the same actions as the grounded generator.
+        const auto walk = collect_random_walk(lifted_applicable_action_generator, state_repository, 200, 50);
+        for (size_t step = 0; step < walk.size(); ++step)
+        {
+            const auto& state = walk[step].first;
+
+            auto lifted_actions = GroundActionList {};
+            for (const auto& action : lifted_applicable_action_generator.create_applicable_action_generator(state))
+            {
+                lifted_actions.push_back(action);
+            }
+            auto grounded_actions = GroundActionList {};
+            for (const auto& action : grounded_applicable_action_generator.create_applicable_action_generator(state))
+            {
+                grounded_actions.push_back(action);
+            }
+            std::sort(lifted_actions.begin(), lifted_actions.end());
+            std::sort(grounded_actions.begin(), grounded_actions.end());
+            EXPECT_EQ(lifted_actions, grounded_actions) << name << " at step " << step;
+        }
+    }
+}
+
 }
@@ -0,0 +1,101 @@
+/*
+ * Copyright (C) 2023 Dominik Drexler and Simon Stahlberg
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "mimir/formalism/problem.hpp"
+#include "mimir/search/applicable_action_generators.hpp"
+#include "mimir/search/axiom_evaluators.hpp"
+#include "mimir/search/search_context.hpp"
+#include "mimir/search/state_repository.hpp"
+#include "mimir/search/state_unpacked.hpp"
+#include "utils/random_walk.hpp"
+
+#include <gtest/gtest.h>
+
+using namespace mimir::search;
+using namespace mimir::formalism;
+
+namespace mimir::tests
+{
+
+/// @brief Compare the derived atoms that the state repository updates incrementally with the derived atoms evaluated from scratch
+/// in the states along random walks.
+static void test_incremental_axiom_evaluation(const fs::path& domain_file, const fs::path& problem_file, SearchContextImpl::SearchMode mode, size_t num_steps)
+{
+    const auto problem = ProblemImpl::create(domain_file, problem_file);
+
+    const auto search_context = SearchContextImpl::create(problem, SearchContextImpl::Options(mode));
+    auto& state_repository = *search_context->get_state_repository();
+    auto& axiom_evaluator = *state_repository.get_axiom_evaluator();
+
+    const auto collect_atoms = [](const FlatBitset& atoms)
+    {
+        auto indices = IndexList {};
+        for (const auto index : atoms)
+        {
+            indices.push_back(index);
+        }
+        return indices;
+    };
+
+    const auto walk = collect_random_walk(*search_context->get_applicable_action_generator(), state_repository, num_steps, 50);
+    for (size_t step = 0; step < walk.size(); ++step)
+    {
+        const auto& state = walk[step].first;
+
+        auto unpacked_state = UnpackedStateImpl(*problem);
+        unpacked_state.get_atoms<FluentTag>() = state.get_atoms<FluentTag>();
+        unpacked_state.get_numeric_variables() = state.get_numeric_variables();
+        axiom_evaluator.generate_and_apply_axioms(unpacked_state);
+        EXPECT_EQ(collect_atoms(state.get_atoms<DerivedTag>()), collect_atoms(unpacked_state.get_atoms<DerivedTag>())) << "at step " << step;
+    }
+}
+
+TEST(MimirTests, SearchAxiomEvaluatorsIncrementalMiconicFullAdlTest)
+{
+    for (const auto mode : { SearchContextImpl::SearchMode::LIFTED, SearchContextImpl::SearchMode::GROUNDED })
+    {
+        test_incremental_axiom_evaluation(fs::path(std::string(DATA_DIR) + "miconic-fulladl/domain.pddl"),
+                                          fs::path(std::string(DATA_DIR) + "miconic-fulladl/test_problem.pddl"),
+                                          mode,
+                                          200);
+    }
+}
+
+TEST(MimirTests, SearchAxiomEvaluatorsIncrementalPhilosophersTest)
+{
+    for (const auto mode : { SearchContextImpl::SearchMode::LIFTED, SearchContextImpl::SearchMode::GROUNDED })
+    {
+        test_incremental_axiom_evaluation(fs::path(std::string(DATA_DIR) + "philosophers/domain.pddl"),
+                                          fs::path(std::string(DATA_DIR) + "philosophers/test_problem.pddl"),
+                                          mode,
+                                          200);
+    }
+}
+
+TEST(MimirTests, SearchAxiomEvaluatorsIncrementalReachabilityTest)
+{
+    // Deleted edges delete and rederive atoms of the recursive axioms, which in turn insert atoms of the negating axioms.
+    for (const auto mode : { SearchContextImpl::SearchMode::LIFTED, SearchContextImpl::SearchMode::GROUNDED })
+    {
+        test_incremental_axiom_evaluation(fs::path(std::string(DATA_DIR) + "reachability/domain.pddl"),
+                                          fs::path(std::string(DATA_DIR) + "reachability/test_problem.pddl"),
+                                          mode,
+                                          400);
+    }
+}
+
+}
@@ -0,0 +1,112 @@
+/*
+ * Copyright (C) 2023 Dominik Drexler and Simon Stahlberg
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "mimir/formalism/problem.hpp"
+#include "mimir/search/algorithms.hpp"
+#include "mimir/search/applicable_action_generators.hpp"
+#include "mimir/search/axiom_evaluators.hpp"
+#include "mimir/search/plan.hpp"
+#include "mimir/search/search_context.hpp"
+#include "mimir/search/state_repository.hpp"
+
+#include <gtest/gtest.h>
+#include <random>
+
+using namespace mimir::search;
+using namespace mimir::formalism;
+
+namespace mimir::tests
+{
+
+/// @brief Compare the derived atoms of the lifted and the grounded axiom evaluator in the states along random walks.
+static void test_lifted_axiom_evaluator_derives_grounded_atoms(const fs::path& domain_file, const fs::path& problem_file, size_t num_steps)
+{
+    const auto problem = ProblemImpl::create(domain_file, problem_file);
+
+    const auto lifted_search_context = SearchContextImpl::create(problem, SearchContextImpl::Options(SearchContextImpl::SearchMode::LIFTED));
+    const auto grounded_search_context = SearchContextImpl::create(problem, SearchContextImpl::Options(SearchContextImpl::SearchMode::GROUNDED));
+    auto& lifted_state_repository = *lifted_search_context->get_state_repository();
+    auto& grounded_state_repository = *grounded_search_context->get_state_repository();
+    auto& applicable_action_generator = *lifted_search_context->get_applicable_action_generator();
+
+    const auto collect_atoms = [](const FlatBitset& atoms)
+    {
+        auto indices = IndexList {};
+        for (const auto index : atoms)
+        {
+            indices.push_back(index);
+        }
+        return indices;
+    };
+
+    auto rng = std::mt19937(42);
+    auto [lifted_state, lifted_state_metric_value] = lifted_state_repository.get_or_create_initial_state();
+    auto [grounded_state, grounded_state_metric_value] = grounded_state_repository.get_or_create_initial_state();
+    for (size_t step = 0; step < num_steps; ++step)
+    {
+        EXPECT_EQ(collect_atoms(lifted_state.get_atoms<FluentTag>()), collect_atoms(grounded_state.get_atoms<FluentTag>()));
+        EXPECT_EQ(collect_atoms(lifted_state.get_atoms<DerivedTag>()), collect_atoms(grounded_state.get_atoms<DerivedTag>())) << "at step " << step;
+
+        auto actions = GroundActionList {};
+        for (const auto& action : applicable_action_generator.create_applicable_action_generator(lifted_state))
+        {
+            actions.push_back(action);
+        }
+        if (actions.empty() || step % 50 == 49)
+        {
+            std::tie(lifted_state, lifted_state_metric_value) = lifted_state_repository.get_or_create_initial_state();
+            std::tie(grounded_state, grounded_state_metric_value) = grounded_state_repository.get_or_create_initial_state();
+            continue;
+        }
+
+        const auto action = actions[rng() % actions.size()];
+        std::tie(lifted_state, lifted_state_metric_value) =
+            lifted_state_repository.get_or_create_successor_state(lifted_state, action, lifted_state_metric_value);
+        std::tie(grounded_state, grounded_state_metric_value) =
+            grounded_state_repository.get_or_create_successor_state(grounded_state, action, grounded_state_metric_value);
+    }
+}
+
+TEST(MimirTests, SearchAxiomEvaluatorsLiftedMiconicFullAdlTest)
+{
+    test_lifted_axiom_evaluator_derives_grounded_atoms(fs::path(std::string(DATA_DIR) + "miconic-fulladl/domain.pddl"),
+                                                       fs::path(std::string(DATA_DIR) + "miconic-fulladl/test_problem.pddl"),
+                                                       200);
+}
+
+TEST(MimirTests, SearchAxiomEvaluatorsLiftedPhilosophersTest)
+{
+    test_lifted_axiom_evaluator_derives_grounded_atoms(fs::path(std::string(DATA_DIR) + "philosophers/domain.pddl"),
+                                                       fs::path(std::string(DATA_DIR) + "philosophers/test_problem.pddl"),
+                                                       200);
+}
+
+TEST(MimirTests, SearchAxiomEvaluatorsLiftedReachabilityTest)
+{
+    // Recursive axioms, axioms with static bodies, and negated derived literals
+    test_lifted_axiom_evaluator_derives_grounded_atoms(fs::path(std::string(DATA_DIR) + "reachability/domain.pddl"),
+                                                       fs::path(std::string(DATA_DIR) + "reachability/test_problem.pddl"),
+                                                       200);
+
+    const auto problem = ProblemImpl::create(fs::path(std::string(DATA_DIR) + "reachability/domain.pddl"),
+                                             fs::path(std::string(DATA_DIR) + "reachability/test_problem.pddl"));
+    const auto search_context = SearchContextImpl::create(problem, SearchContextImpl::Options(SearchContextImpl::SearchMode::LIFTED));
+    const auto result = brfs::find_solution(search_context);
+    ASSERT_EQ(result.status, SearchStatus::SOLVED);
+}
+
+}
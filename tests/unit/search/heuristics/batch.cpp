@@ -0,0 +1,195 @@
+/*
+ * Copyright (C) 2023 Dominik Drexler and Simon Stahlberg
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "mimir/search/heuristics/interface.hpp"
+
+#include "mimir/formalism/problem.hpp"
+#include "mimir/search/algorithms/astar_eager.hpp"
+#include "mimir/search/algorithms/gbfs_eager.hpp"
+#include "mimir/search/algorithms/gbfs_lazy.hpp"
+#include "mimir/search/applicable_action_generators.hpp"
+#include "mimir/search/delete_relaxed_problem_explorator.hpp"
+#include "mimir/search/heuristics.hpp"
+#include "mimir/search/plan.hpp"
+#include "mimir/search/search_context.hpp"
+#include "mimir/search/state_repository.hpp"
+
+#include <algorithm>
+#include <gtest/gtest.h>
+
+using namespace mimir::search;
+using namespace mimir::formalism;
+
+namespace mimir::tests
+{
+
+/// @brief `BatchRecordingHeuristic` records the sizes of the batches and forwards them to the decorated heuristic.
+class BatchRecordingHeuristic : public IHeuristic
+{
+public:
+    explicit BatchRecordingHeuristic(Heuristic heuristic) : m_heuristic(std::move(heuristic)), m_num_single_evaluations(0), m_batch_sizes() {}
+
+    ContinuousCost compute_heuristic(const State& state, bool is_goal_state) override
+    {
+        ++m_num_single_evaluations;
+        const auto value = m_heuristic->compute_heuristic(state, is_goal_state);
+        m_preferred_actions = m_heuristic->get_preferred_actions();
+        return value;
+    }
+
+    void compute_heuristics(const StateList& states, const std::vector<bool>& are_goal_states, ContinuousCostList& out_values) override
+    {
+        m_batch_sizes.push_back(states.size());
+        m_heuristic->compute_heuristics(states, are_goal_states, out_values);
+    }
+
+    void compute_heuristics_and_preferred_actions(const StateList& states,
+                                                  const std::vector<bool>& are_goal_states,
+                                                  ContinuousCostList& out_values,
+                                                  std::vector<GroundActionSet>& out_preferred_actions) override
+    {
+        m_batch_sizes.push_back(states.size());
+        m_heuristic->compute_heuristics_and_preferred_actions(states, are_goal_states, out_values, out_preferred_actions);
+    }
+
+    size_t get_num_single_evaluations() const { return m_num_single_evaluations; }
+    const std::vector<size_t>& get_batch_sizes() const { return m_batch_sizes; }
+
+private:
+    Heuristic m_heuristic;
+    size_t m_num_single_evaluations;
+    std::vector<size_t> m_batch_sizes;
+};
+
+static SearchContext create_gripper_search_context()
+{
+    return SearchContextImpl::create(fs::path(std::string(DATA_DIR) + "gripper/domain.pddl"),
+                                     fs::path(std::string(DATA_DIR) + "gripper/test_problem.pddl"));
+}
+
+TEST(MimirTests, SearchHeuristicsBatchDefaultTest)
+{
+    const auto search_context = create_gripper_search_context();
+    auto& state_repository = *search_context->get_state_repository();
+    auto& applicable_action_generator = *search_context->get_applicable_action_generator();
+    auto delete_relaxed_problem_explorator = DeleteRelaxedProblemExplorator(search_context->get_problem());
+    const auto ff_heuristic = FFHeuristicImpl::create(delete_relaxed_problem_explorator);
+
+    const auto [initial_state, initial_state_metric_value] = state_repository.get_or_create_initial_state();
+    auto states = StateList { initial_state };
+    for (const auto& action : applicable_action_generator.create_applicable_action_generator(initial_state))
+    {
+        states.push_back(state_repository.get_or_create_successor_state(initial_state, action, initial_state_metric_value).first);
+    }
+    const auto are_goal_states = std::vector<bool>(states.size(), false);
+
+    // The default batch evaluation yields the values of the single evaluations.
+    auto values = ContinuousCostList {};
+    ff_heuristic->compute_heuristics(states, are_goal_states, values);
+    ASSERT_EQ(values.size(), states.size());
+    for (size_t i = 0; i < states.size(); ++i)
+    {
+        EXPECT_EQ(values[i], ff_heuristic->compute_heuristic(states[i], are_goal_states[i]));
+    }
+
+    // The cache forwards the missing states in a single batch.
+    const auto recording_heuristic = std::make_shared<BatchRecordingHeuristic>(ff_heuristic);
+    const auto caching_heuristic = CachingHeuristicImpl::create(recording_heuristic);
+    caching_heuristic->compute_heuristic(initial_state, false);
+    caching_heuristic->compute_heuristics(states, are_goal_states, values);
+    EXPECT_EQ(recording_heuristic->get_batch_sizes(), std::vector<size_t> { states.size() - 1 });
+    caching_heuristic->compute_heuristics(states, are_goal_states, values);
+    EXPECT_EQ(recording_heuristic->get_batch_sizes().size(), 1);
+    for (size_t i = 0; i < states.size(); ++i)
+    {
+        EXPECT_EQ(values[i], ff_heuristic->compute_heuristic(states[i], are_goal_states[i]));
+    }
+
+    // Entries of a batch have no preferred actions and are recomputed by a single evaluation.
+    caching_heuristic->compute_heuristic(states.back(), false);
+    EXPECT_EQ(recording_heuristic->get_num_single_evaluations(), 2);
+    EXPECT_EQ(caching_heuristic->get_statistics().num_misses, states.size() + 1);
+
+    // Entries of a batch with preferred actions are hits of a single evaluation.
+    auto preferred_actions = std::vector<GroundActionSet> {};
+    const auto other_caching_heuristic = CachingHeuristicImpl::create(recording_heuristic);
+    other_caching_heuristic->compute_heuristics_and_preferred_actions(states, are_goal_states, values, preferred_actions);
+    ASSERT_EQ(preferred_actions.size(), states.size());
+    for (size_t i = 0; i < states.size(); ++i)
+    {
+        EXPECT_EQ(values[i], ff_heuristic->compute_heuristic(states[i], are_goal_states[i]));
+        EXPECT_EQ(preferred_actions[i], ff_heuristic->get_preferred_actions().data);
+    }
+    other_caching_heuristic->compute_heuristic(states.back(), false);
+    EXPECT_EQ(other_caching_heuristic->get_preferred_actions().data, preferred_actions.back());
+    EXPECT_EQ(recording_heuristic->get_num_single_evaluations(), 2);
+    EXPECT_EQ(other_caching_heuristic->get_statistics().num_hits, 1);
+}
+
+TEST(MimirTests, SearchHeuristicsBatchGBFSEagerTest)
+{
+    const auto search_context = create_gripper_search_context();
+    auto delete_relaxed_problem_explorator = DeleteRelaxedProblemExplorator(search_context->get_problem());
+    const auto recording_heuristic = std::make_shared<BatchRecordingHeuristic>(FFHeuristicImpl::create(delete_relaxed_problem_explorator));
+
+    const auto result = gbfs_eager::find_solution(search_context, recording_heuristic);
+    EXPECT_EQ(result.status, SearchStatus::SOLVED);
+
+    // The successor states of each expansion are evaluated in a single batch.
+    EXPECT_EQ(recording_heuristic->get_num_single_evaluations(), 1);
+    EXPECT_FALSE(recording_heuristic->get_batch_sizes().empty());
+    EXPECT_GT(std::ranges::max(recording_heuristic->get_batch_sizes()), 1);
+
+    // Batching does not change the search.
+    const auto other_search_context = create_gripper_search_context();
+    auto other_delete_relaxed_problem_explorator = DeleteRelaxedProblemExplorator(other_search_context->get_problem());
+    const auto other_result = gbfs_eager::find_solution(other_search_context, FFHeuristicImpl::create(other_delete_relaxed_problem_explorator));
+    EXPECT_EQ(result.plan.value().get_actions().size(), other_result.plan.value().get_actions().size());
+}
+
+TEST(MimirTests, SearchHeuristicsBatchAStarEagerTest)
+{
+    const auto search_context = create_gripper_search_context();
+    const auto recording_heuristic = std::make_shared<BatchRecordingHeuristic>(BlindHeuristicImpl::create(search_context->get_problem()));
+
+    const auto result = astar_eager::find_solution(search_context, recording_heuristic);
+    EXPECT_EQ(result.status, SearchStatus::SOLVED);
+    EXPECT_EQ(result.plan.value().get_actions().size(), 3);
+
+    EXPECT_EQ(recording_heuristic->get_num_single_evaluations(), 1);
+    EXPECT_GT(std::ranges::max(recording_heuristic->get_batch_sizes()), 1);
+}
+
+TEST(MimirTests, SearchHeuristicsBatchGBFSLazyTest)
+{
+    const auto search_context = create_gripper_search_context();
+    auto delete_relaxed_problem_explorator = DeleteRelaxedProblemExplorator(search_context->get_problem());
+    const auto recording_heuristic = std::make_shared<BatchRecordingHeuristic>(FFHeuristicImpl::create(delete_relaxed_problem_explorator));
+
+    auto options = gbfs_lazy::Options();
+    options.batch_size = 4;
+    const auto result = gbfs_lazy::find_solution(search_context, recording_heuristic, options);
+    EXPECT_EQ(result.status, SearchStatus::SOLVED);
+
+    // The open states are evaluated in batches of at most the batch size.
+    const auto& batch_sizes = recording_heuristic->get_batch_sizes();
+    EXPECT_FALSE(batch_sizes.empty());
+    EXPECT_GT(std::ranges::max(batch_sizes), 1);
+    EXPECT_LE(std::ranges::max(batch_sizes), options.batch_size);
+}
+
+}
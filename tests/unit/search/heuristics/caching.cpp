@@ -0,0 +1,243 @@
+/*
+ * Copyright (C) 2023 Dominik Drexler and Simon Stahlberg
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#include "mimir/search/heuristics/caching.hpp"
+
+#include "mimir/formalism/problem.hpp"
+#include "mimir/search/algorithms/gbfs_eager.hpp"
+#include "mimir/search/algorithms/gbfs_lazy.hpp"
+#include "mimir/search/algorithms/strategies/goal_strategy.hpp"
+#include "mimir/search/applicable_action_generators.hpp"
+#include "mimir/search/axiom_evaluators.hpp"
+#include "mimir/search/delete_relaxed_problem_explorator.hpp"
+#include "mimir/search/heuristics.hpp"
+#include "mimir/search/plan.hpp"
+#include "mimir/search/search_context.hpp"
+#include "mimir/search/state_repository.hpp"
+#include "utils/random_walk.hpp"
+
+#include <gtest/gtest.h>
+#include <unordered_set>
+
+using namespace mimir::search;
+using namespace mimir::formalism;
+
+namespace mimir::tests
+{
+
+/// @brief `CountingHeuristic` counts the evaluations of the decorated heuristic.
+class CountingHeuristic : public IHeuristic
+{
+public:
+    explicit CountingHeuristic(Heuristic heuristic) : m_heuristic(std::move(heuristic)), m_num_evaluations(0), m_evaluated_states() {}
+
+    ContinuousCost compute_heuristic(const State& state, bool is_goal_state) override
+    {
+        ++m_num_evaluations;
+        m_evaluated_states.insert(state.get_index());
+        const auto value = m_heuristic->compute_heuristic(state, is_goal_state);
+        m_preferred_actions = m_heuristic->get_preferred_actions();
+        return value;
+    }
+
+    size_t get_num_evaluations() const { return m_num_evaluations; }
+    size_t get_num_evaluated_states() const { return m_evaluated_states.size(); }
+
+private:
+    Heuristic m_heuristic;
+    size_t m_num_evaluations;
+    std::unordered_set<Index> m_evaluated_states;
+};
+
+TEST(MimirTests, SearchHeuristicsCachingRandomWalkTest)
+{
+    const auto problem = ProblemImpl::create(fs::path(std::string(DATA_DIR) + "gripper/domain.pddl"),
+                                             fs::path(std::string(DATA_DIR) + "gripper/test_problem.pddl"));
+    auto delete_relaxed_problem_explorator = DeleteRelaxedProblemExplorator(problem);
+    auto applicable_action_generator = delete_relaxed_problem_explorator.create_grounded_applicable_action_generator(
+        match_tree::Options(),
+        GroundedApplicableActionGeneratorImpl::DefaultEventHandlerImpl::create(false));
+    auto axiom_evaluator = delete_relaxed_problem_explorator.create_grounded_axiom_evaluator(match_tree::Options(),
+                                                                                           GroundedAxiomEvaluatorImpl::DefaultEventHandlerImpl::create(false));
+    auto state_repository = StateRepositoryImpl::create(axiom_evaluator);
+    const auto goal_strategy = ProblemGoalStrategyImpl::create(problem);
+
+    const auto ff_heuristic = FFHeuristicImpl::create(delete_relaxed_problem_explorator);
+    const auto counting_heuristic = std::make_shared<CountingHeuristic>(FFHeuristicImpl::create(delete_relaxed_problem_explorator));
+    const auto caching_heuristic = CachingHeuristicImpl::create(counting_heuristic);
+
+    auto visited_states = std::unordered_set<Index> {};
+    const size_t num_steps = 200;
+    for (const auto& [state, state_metric_value] : collect_random_walk(*applicable_action_generator, *state_repository, num_steps))
+    {
+        visited_states.insert(state.get_index());
+
+        // The cached value and preferred actions are the ones of the decorated heuristic.
+        const auto is_goal_state = goal_strategy->test_dynamic_goal(state);
+        EXPECT_EQ(caching_heuristic->compute_heuristic(state, is_goal_state), ff_heuristic->compute_heuristic(state, is_goal_state));
+        EXPECT_EQ(caching_heuristic->get_preferred_actions().data, ff_heuristic->get_preferred_actions().data);
+    }
+
+    // The decorated heuristic is evaluated once per state.
+    const auto& statistics = caching_heuristic->get_statistics();
+    EXPECT_EQ(counting_heuristic->get_num_evaluations(), visited_states.size());
+    EXPECT_EQ(statistics.num_misses, visited_states.size());
+    EXPECT_EQ(statistics.num_hits + statistics.num_misses, num_steps);
+    EXPECT_EQ(statistics.num_evictions, 0);
+    EXPECT_EQ(caching_heuristic->get_num_entries(), visited_states.size());
+}
+
+TEST(MimirTests, SearchHeuristicsCachingEvictionTest)
+{
+    const auto search_context = SearchContextImpl::create(fs::path(std::string(DATA_DIR) + "gripper/domain.pddl"),
+                                                          fs::path(std::string(DATA_DIR) + "gripper/test_problem.pddl"));
+    const auto& problem = search_context->get_problem();
+    auto& state_repository = *search_context->get_state_repository();
+    auto& applicable_action_generator = *search_context->get_applicable_action_generator();
+
+    const auto counting_heuristic = std::make_shared<CountingHeuristic>(BlindHeuristicImpl::create(problem));
+    auto options = CachingHeuristicImpl::Options();
+    options.max_num_entries = 2;
+    const auto caching_heuristic = CachingHeuristicImpl::create(counting_heuristic, options);
+
+    const auto [initial_state, initial_state_metric_value] = state_repository.get_or_create_initial_state();
+    auto successor_states = StateList {};
+    for (const auto& action : applicable_action_generator.create_applicable_action_generator(initial_state))
+    {
+        successor_states.push_back(state_repository.get_or_create_successor_state(initial_state, action, initial_state_metric_value).first);
+    }
+    ASSERT_GE(successor_states.size(), 2);
+    const auto& first_state = successor_states[0];
+    const auto& second_state = successor_states[1];
+
+    caching_heuristic->compute_heuristic(initial_state, false);
+    caching_heuristic->compute_heuristic(first_state, false);
+    caching_heuristic->compute_heuristic(initial_state, false);  ///< Hit, the first state is now least recently used.
+    caching_heuristic->compute_heuristic(second_state, false);   ///< Evicts the first state.
+    EXPECT_EQ(counting_heuristic->get_num_evaluations(), 3);
+    EXPECT_EQ(caching_heuristic->get_num_entries(), 2);
+
+    caching_heuristic->compute_heuristic(initial_state, false);  ///< Hit.
+    caching_heuristic->compute_heuristic(first_state, false);    ///< Miss, evicts the second state.
+    EXPECT_EQ(counting_heuristic->get_num_evaluations(), 4);
+
+    // A value cached with another goal flag is recomputed.
+    caching_heuristic->compute_heuristic(first_state, true);
+    EXPECT_EQ(counting_heuristic->get_num_evaluations(), 5);
+
+    const auto& statistics = caching_heuristic->get_statistics();
+    EXPECT_EQ(statistics.num_hits, 2);
+    EXPECT_EQ(statistics.num_misses, 5);
+    EXPECT_EQ(statistics.num_evictions, 2);
+    EXPECT_EQ(statistics.num_invalidations, 0);
+
+    // State indices of another state repository do not hit.
+    const auto other_search_context = SearchContextImpl::create(problem);
+    const auto other_initial_state = other_search_context->get_state_repository()->get_or_create_initial_state().first;
+    caching_heuristic->compute_heuristic(other_initial_state, false);
+    EXPECT_EQ(counting_heuristic->get_num_evaluations(), 6);
+    EXPECT_EQ(statistics.num_invalidations, 1);
+    EXPECT_EQ(caching_heuristic->get_num_entries(), 1);
+}
+
+TEST(MimirTests, SearchHeuristicsCachingPreferredActionsLimitTest)
+{
+    const auto search_context = SearchContextImpl::create(fs::path(std::string(DATA_DIR) + "gripper/domain.pddl"),
+                                                          fs::path(std::string(DATA_DIR) + "gripper/test_problem.pddl"));
+    auto& state_repository = *search_context->get_state_repository();
+    auto& applicable_action_generator = *search_context->get_applicable_action_generator();
+    auto delete_relaxed_problem_explorator = DeleteRelaxedProblemExplorator(search_context->get_problem());
+    const auto ff_heuristic = FFHeuristicImpl::create(delete_relaxed_problem_explorator);
+
+    const auto [initial_state, initial_state_metric_value] = state_repository.get_or_create_initial_state();
+    ff_heuristic->compute_heuristic(initial_state, false);
+    const auto num_initial_preferred_actions = ff_heuristic->get_preferred_actions().data.size();
+    ASSERT_GT(num_initial_preferred_actions, 1);
+
+    {
+        // The limit admits the preferred actions of the initial state but not of all states on the walk.
+        const auto counting_heuristic = std::make_shared<CountingHeuristic>(FFHeuristicImpl::create(delete_relaxed_problem_explorator));
+        auto options = CachingHeuristicImpl::Options();
+        options.max_num_preferred_actions = num_initial_preferred_actions;
+        const auto caching_heuristic = CachingHeuristicImpl::create(counting_heuristic, options);
+
+        for (const auto& [state, state_metric_value] : collect_random_walk(applicable_action_generator, state_repository, 50))
+        {
+            EXPECT_EQ(caching_heuristic->compute_heuristic(state, false), ff_heuristic->compute_heuristic(state, false));
+            EXPECT_EQ(caching_heuristic->get_preferred_actions().data, ff_heuristic->get_preferred_actions().data);
+            EXPECT_LE(caching_heuristic->get_num_preferred_actions(), options.max_num_preferred_actions);
+        }
+        EXPECT_GT(caching_heuristic->get_statistics().num_evictions, 0);
+    }
+
+    {
+        // The preferred actions of the initial state exceed the limit on their own, so they are recomputed.
+        const auto counting_heuristic = std::make_shared<CountingHeuristic>(FFHeuristicImpl::create(delete_relaxed_problem_explorator));
+        auto options = CachingHeuristicImpl::Options();
+        options.max_num_preferred_actions = num_initial_preferred_actions - 1;
+        const auto caching_heuristic = CachingHeuristicImpl::create(counting_heuristic, options);
+
+        caching_heuristic->compute_heuristic(initial_state, false);
+        caching_heuristic->compute_heuristic(initial_state, false);
+        EXPECT_EQ(counting_heuristic->get_num_evaluations(), 2);
+        EXPECT_EQ(caching_heuristic->get_preferred_actions().data.size(), num_initial_preferred_actions);
+        EXPECT_EQ(caching_heuristic->get_num_entries(), 1);
+        EXPECT_EQ(caching_heuristic->get_num_preferred_actions(), 0);
+    }
+}
+
+TEST(MimirTests, SearchHeuristicsCachingRepeatedSearchTest)
+{
+    const auto search_context = SearchContextImpl::create(fs::path(std::string(DATA_DIR) + "gripper/domain.pddl"),
+                                                          fs::path(std::string(DATA_DIR) + "gripper/test_problem.pddl"));
+    auto delete_relaxed_problem_explorator = DeleteRelaxedProblemExplorator(search_context->get_problem());
+    const auto counting_heuristic = std::make_shared<CountingHeuristic>(FFHeuristicImpl::create(delete_relaxed_problem_explorator));
+    const auto caching_heuristic = CachingHeuristicImpl::create(counting_heuristic);
+
+    const auto first_result = gbfs_lazy::find_solution(search_context, caching_heuristic);
+    const auto num_evaluations = counting_heuristic->get_num_evaluations();
+    EXPECT_EQ(first_result.status, SearchStatus::SOLVED);
+
+    // Searching again on the same search context evaluates no state again.
+    const auto second_result = gbfs_lazy::find_solution(search_context, caching_heuristic);
+    EXPECT_EQ(second_result.status, SearchStatus::SOLVED);
+    EXPECT_EQ(second_result.plan.value().get_actions().size(), first_result.plan.value().get_actions().size());
+    EXPECT_EQ(counting_heuristic->get_num_evaluations(), num_evaluations);
+    EXPECT_GT(caching_heuristic->get_statistics().num_hits, 0);
+}
+
+TEST(MimirTests, SearchHeuristicsCachingGBFSEagerPreferredActionsTest)
+{
+    const auto search_context = SearchContextImpl::create(fs::path(std::string(DATA_DIR) + "gripper/domain.pddl"),
+                                                          fs::path(std::string(DATA_DIR) + "gripper/test_problem.pddl"));
+    auto delete_relaxed_problem_explorator = DeleteRelaxedProblemExplorator(search_context->get_problem());
+    const auto counting_heuristic = std::make_shared<CountingHeuristic>(FFHeuristicImpl::create(delete_relaxed_problem_explorator));
+    const auto caching_heuristic = CachingHeuristicImpl::create(counting_heuristic);
+
+    auto options = gbfs_eager::Options();
+    options.use_preferred_actions = true;
+    const auto result = gbfs_eager::find_solution(search_context, caching_heuristic, options);
+    EXPECT_EQ(result.status, SearchStatus::SOLVED);
+
+    // The preferred actions of an expanded state are cached when it is generated, so no state is evaluated twice.
+    EXPECT_GT(counting_heuristic->get_num_evaluations(), 1);
+    EXPECT_EQ(counting_heuristic->get_num_evaluations(), counting_heuristic->get_num_evaluated_states());
+    EXPECT_GT(caching_heuristic->get_statistics().num_hits, 0);
+}
+
+}
@@ -0,0 +1,106 @@
+/*
+ * Copyright (C) 2023 Dominik Drexler and Simon Stahlberg
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#include "mimir/formalism/problem.hpp"
+#include "mimir/search/algorithms/strategies/goal_strategy.hpp"
+#include "mimir/search/applicability.hpp"
+#include "mimir/search/applicable_action_generators.hpp"
+#include "mimir/search/axiom_evaluators.hpp"
+#include "mimir/search/delete_relaxed_problem_explorator.hpp"
+#include "mimir/search/heuristics.hpp"
+#include "mimir/search/search_context.hpp"
+#include "mimir/search/state_repository.hpp"
+#include "utils/random_walk.hpp"
+
+#include <gtest/gtest.h>
+
+using namespace mimir::search;
+using namespace mimir::formalism;
+
+namespace mimir::tests
+{
+
+/// @brief Compare the lifted heuristics against the grounded ones along a random walk.
+/// The domains must not have negative preconditions because the lifted heuristics ignore them.
+static void test_lifted_heuristics(const fs::path& domain_file, const fs::path& problem_file, size_t num_steps)
+{
+    const auto problem = ProblemImpl::create(domain_file, problem_file);
+    auto delete_relaxed_problem_explorator = DeleteRelaxedProblemExplorator(problem);
+    auto applicable_action_generator = delete_relaxed_problem_explorator.create_grounded_applicable_action_generator(
+        match_tree::Options(),
+        GroundedApplicableActionGeneratorImpl::DefaultEventHandlerImpl::create(false));
+    auto axiom_evaluator = delete_relaxed_problem_explorator.create_grounded_axiom_evaluator(match_tree::Options(),
+                                                                                           GroundedAxiomEvaluatorImpl::DefaultEventHandlerImpl::create(false));
+    auto state_repository = StateRepositoryImpl::create(axiom_evaluator);
+
+    const auto max_heuristic = MaxHeuristicImpl::create(delete_relaxed_problem_explorator);
+    const auto add_heuristic = AddHeuristicImpl::create(delete_relaxed_problem_explorator);
+    const auto lifted_max_heuristic = LiftedMaxHeuristicImpl::create(problem);
+    const auto lifted_add_heuristic = LiftedAddHeuristicImpl::create(problem);
+    const auto lifted_ff_heuristic = LiftedFFHeuristicImpl::create(problem);
+
+    const auto goal_strategy = ProblemGoalStrategyImpl::create(problem);
+
+    for (const auto& [state, state_metric_value] : collect_random_walk(*applicable_action_generator, *state_repository, num_steps))
+    {
+        const auto is_goal_state = goal_strategy->test_dynamic_goal(state);
+
+        const auto h_max = max_heuristic->compute_heuristic(state, is_goal_state);
+        const auto h_add = add_heuristic->compute_heuristic(state, is_goal_state);
+        const auto lifted_h_max = lifted_max_heuristic->compute_heuristic(state, is_goal_state);
+        const auto lifted_h_add = lifted_add_heuristic->compute_heuristic(state, is_goal_state);
+        const auto lifted_h_ff = lifted_ff_heuristic->compute_heuristic(state, is_goal_state);
+
+        EXPECT_EQ(lifted_h_max, h_max);
+        EXPECT_EQ(lifted_h_add, h_add);
+        EXPECT_GE(lifted_h_ff, lifted_h_max);
+        EXPECT_EQ(lifted_h_ff == INFINITY_CONTINUOUS_COST, lifted_h_max == INFINITY_CONTINUOUS_COST);
+
+        // Preferred actions are applicable in the state.
+        for (const auto& action : lifted_ff_heuristic->get_preferred_actions().data)
+        {
+            EXPECT_TRUE(is_applicable(action, state));
+        }
+        if (!is_goal_state && lifted_h_ff != INFINITY_CONTINUOUS_COST)
+        {
+            EXPECT_FALSE(lifted_ff_heuristic->get_preferred_actions().data.empty());
+        }
+    }
+}
+
+TEST(MimirTests, SearchHeuristicsLiftedGripperTest)
+{
+    test_lifted_heuristics(fs::path(std::string(DATA_DIR) + "gripper/domain.pddl"), fs::path(std::string(DATA_DIR) + "gripper/test_problem.pddl"), 100);
+}
+
+TEST(MimirTests, SearchHeuristicsLiftedLogisticsTest)
+{
+    test_lifted_heuristics(fs::path(std::string(DATA_DIR) + "logistics/domain.pddl"), fs::path(std::string(DATA_DIR) + "logistics/test_problem.pddl"), 100);
+}
+
+TEST(MimirTests, SearchHeuristicsLiftedMiconicTest)
+{
+    test_lifted_heuristics(fs::path(std::string(DATA_DIR) + "miconic/domain.pddl"), fs::path(std::string(DATA_DIR) + "miconic/test_problem.pddl"), 100);
+}
+
+TEST(MimirTests, SearchHeuristicsLiftedSatelliteTest)
+{
+    test_lifted_heuristics(fs::path(std::string(DATA_DIR) + "satellite/domain.pddl"), fs::path(std::string(DATA_DIR) + "satellite/test_problem.pddl"), 100);
+}
+
+}
@@ -0,0 +1,143 @@
+/*
+ * Copyright (C) 2023 Dominik Drexler and Simon Stahlberg
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#include "mimir/formalism/problem.hpp"
+#include "mimir/search/algorithms/astar_eager.hpp"
+#include "mimir/search/algorithms/strategies/goal_strategy.hpp"
+#include "mimir/search/applicable_action_generators.hpp"
+#include "mimir/search/axiom_evaluators.hpp"
+#include "mimir/search/delete_relaxed_problem_explorator.hpp"
+#include "mimir/search/heuristics.hpp"
+#include "mimir/search/plan.hpp"
+#include "mimir/search/search_context.hpp"
+#include "mimir/search/state_repository.hpp"
+#include "utils/random_walk.hpp"
+
+#include <gtest/gtest.h>
+
+using namespace mimir::search;
+using namespace mimir::formalism;
+
+namespace mimir::tests
+{
+
+/// @brief Compare LM-cut against h_max on all successors of the states along a random walk.
+/// The domain must have unit costs because h_max ignores action costs.
+static void test_lm_cut_dominates_h_max(const fs::path& domain_file, const fs::path& problem_file, size_t num_steps)
+{
+    const auto problem = ProblemImpl::create(domain_file, problem_file);
+    auto delete_relaxed_problem_explorator = DeleteRelaxedProblemExplorator(problem);
+    auto applicable_action_generator = delete_relaxed_problem_explorator.create_grounded_applicable_action_generator(
+        match_tree::Options(),
+        GroundedApplicableActionGeneratorImpl::DefaultEventHandlerImpl::create(false));
+    auto axiom_evaluator = delete_relaxed_problem_explorator.create_grounded_axiom_evaluator(match_tree::Options(),
+                                                                                           GroundedAxiomEvaluatorImpl::DefaultEventHandlerImpl::create(false));
+    auto state_repository = StateRepositoryImpl::create(axiom_evaluator);
+    const auto goal_strategy = ProblemGoalStrategyImpl::create(problem);
+
+    const auto max_heuristic = MaxHeuristicImpl::create(delete_relaxed_problem_explorator);
+    const auto lm_cut_heuristic = LMCutHeuristicImpl::create(delete_relaxed_problem_explorator);
+
+    for (const auto& [state, state_metric_value] : collect_random_walk(*applicable_action_generator, *state_repository, num_steps))
+    {
+        auto actions = GroundActionList {};
+        for (const auto& action : applicable_action_generator->create_applicable_action_generator(state))
+        {
+            actions.push_back(action);
+        }
+
+        for (const auto& action : actions)
+        {
+            const auto successor_state = state_repository->get_or_create_successor_state(state, action, state_metric_value).first;
+            const auto is_goal_state = goal_strategy->test_dynamic_goal(successor_state);
+
+            const auto h_max = max_heuristic->compute_heuristic(successor_state, is_goal_state);
+            const auto h_lm_cut = lm_cut_heuristic->compute_heuristic(successor_state, is_goal_state);
+
+            EXPECT_EQ(h_max == INFINITY_CONTINUOUS_COST, h_lm_cut == INFINITY_CONTINUOUS_COST);
+            EXPECT_LE(h_max, h_lm_cut);
+        }
+    }
+}
+
+/// @brief Compare the cost of the plans found by A* with LM-cut and with the blind heuristic, which must both be optimal.
+static void test_lm_cut_astar_optimal(const fs::path& domain_file, const fs::path& problem_file)
+{
+    const auto problem = ProblemImpl::create(domain_file, problem_file);
+    auto delete_relaxed_problem_explorator = DeleteRelaxedProblemExplorator(problem);
+    auto applicable_action_generator = delete_relaxed_problem_explorator.create_grounded_applicable_action_generator(
+        match_tree::Options(),
+        GroundedApplicableActionGeneratorImpl::DefaultEventHandlerImpl::create(false));
+    auto axiom_evaluator = delete_relaxed_problem_explorator.create_grounded_axiom_evaluator(match_tree::Options(),
+                                                                                           GroundedAxiomEvaluatorImpl::DefaultEventHandlerImpl::create(false));
+    auto state_repository = StateRepositoryImpl::create(axiom_evaluator);
+    const auto search_context = SearchContextImpl::create(problem, applicable_action_generator, state_repository);
+
+    const auto lm_cut_result = astar_eager::find_solution(search_context, LMCutHeuristicImpl::create(delete_relaxed_problem_explorator));
+    const auto blind_result = astar_eager::find_solution(search_context, BlindHeuristicImpl::create(problem));
+
+    ASSERT_EQ(lm_cut_result.status, SearchStatus::SOLVED);
+    ASSERT_EQ(blind_result.status, SearchStatus::SOLVED);
+    EXPECT_EQ(lm_cut_result.plan.value().get_cost(), blind_result.plan.value().get_cost());
+}
+
+TEST(MimirTests, SearchHeuristicsLMCutGripperTest)
+{
+    test_lm_cut_dominates_h_max(fs::path(std::string(DATA_DIR) + "gripper/domain.pddl"), fs::path(std::string(DATA_DIR) + "gripper/test_problem.pddl"), 20);
+    test_lm_cut_astar_optimal(fs::path(std::string(DATA_DIR) + "gripper/domain.pddl"), fs::path(std::string(DATA_DIR) + "gripper/test_problem.pddl"));
+}
+
+TEST(MimirTests, SearchHeuristicsLMCutBlocks4Test)
+{
+    test_lm_cut_dominates_h_max(fs::path(std::string(DATA_DIR) + "blocks_4/domain.pddl"), fs::path(std::string(DATA_DIR) + "blocks_4/test_problem.pddl"), 20);
+    test_lm_cut_astar_optimal(fs::path(std::string(DATA_DIR) + "blocks_4/domain.pddl"), fs::path(std::string(DATA_DIR) + "blocks_4/test_problem.pddl"));
+}
+
+TEST(MimirTests, SearchHeuristicsLMCutMiconicFullAdlTest)
+{
+    // Conditional effects
+    test_lm_cut_dominates_h_max(fs::path(std::string(DATA_DIR) + "miconic-fulladl/domain.pddl"),
+                                fs::path(std::string(DATA_DIR) + "miconic-fulladl/test_problem.pddl"),
+                                20);
+    test_lm_cut_astar_optimal(fs::path(std::string(DATA_DIR) + "miconic-fulladl/domain.pddl"),
+                              fs::path(std::string(DATA_DIR) + "miconic-fulladl/test_problem.pddl"));
+}
+
+TEST(MimirTests, SearchHeuristicsLMCutPhilosophersTest)
+{
+    // Axioms
+    test_lm_cut_dominates_h_max(fs::path(std::string(DATA_DIR) + "philosophers/domain.pddl"),
+                                fs::path(std::string(DATA_DIR) + "philosophers/test_problem.pddl"),
+                                20);
+    test_lm_cut_astar_optimal(fs::path(std::string(DATA_DIR) + "philosophers/domain.pddl"),
+                              fs::path(std::string(DATA_DIR) + "philosophers/test_problem.pddl"));
+}
+
+TEST(MimirTests, SearchHeuristicsLMCutTransportTest)
+{
+    // Action costs
+    test_lm_cut_astar_optimal(fs::path(std::string(DATA_DIR) + "transport/domain.pddl"), fs::path(std::string(DATA_DIR) + "transport/test_problem.pddl"));
+}
+
+TEST(MimirTests, SearchHeuristicsLMCutBarmanTest)
+{
+    // Action costs
+    test_lm_cut_astar_optimal(fs::path(std::string(DATA_DIR) + "barman/domain.pddl"), fs::path(std::string(DATA_DIR) + "barman/test_problem.pddl"));
+}
+
+}
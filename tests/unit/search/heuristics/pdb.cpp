@@ -0,0 +1,167 @@
+/*
+ * Copyright (C) 2023 Dominik Drexler and Simon Stahlberg
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "mimir/formalism/problem.hpp"
+#include "mimir/search/algorithms/astar_eager.hpp"
+#include "mimir/search/algorithms/strategies/goal_strategy.hpp"
+#include "mimir/search/applicable_action_generators.hpp"
+#include "mimir/search/axiom_evaluators.hpp"
+#include "mimir/search/delete_relaxed_problem_explorator.hpp"
+#include "mimir/search/heuristics.hpp"
+#include "mimir/search/heuristics/pdb/pattern_database.hpp"
+#include "mimir/search/heuristics/pdb/task.hpp"
+#include "mimir/search/plan.hpp"
+#include "mimir/search/search_context.hpp"
+#include "mimir/search/state_repository.hpp"
+#include "utils/random_walk.hpp"
+
+#include <gtest/gtest.h>
+#include <numeric>
+
+using namespace mimir::search;
+using namespace mimir::formalism;
+
+namespace mimir::tests
+{
+
+/// @brief Test along a random walk that the variables are mutex groups and that the pattern database with all variables, if small enough,
+/// never overestimates the perfect heuristic value.
+static void test_pdb_admissible(const fs::path& domain_file, const fs::path& problem_file, size_t num_steps)
+{
+    const auto problem = ProblemImpl::create(domain_file, problem_file);
+    auto delete_relaxed_problem_explorator = DeleteRelaxedProblemExplorator(problem);
+    auto applicable_action_generator = delete_relaxed_problem_explorator.create_grounded_applicable_action_generator(
+        match_tree::Options(),
+        GroundedApplicableActionGeneratorImpl::DefaultEventHandlerImpl::create(false));
+    auto axiom_evaluator = delete_relaxed_problem_explorator.create_grounded_axiom_evaluator(match_tree::Options(),
+                                                                                           GroundedAxiomEvaluatorImpl::DefaultEventHandlerImpl::create(false));
+    auto state_repository = StateRepositoryImpl::create(axiom_evaluator);
+    const auto search_context = SearchContextImpl::create(problem, applicable_action_generator, state_repository);
+    const auto goal_strategy = ProblemGoalStrategyImpl::create(problem);
+
+    const auto perfect_heuristic = PerfectHeuristicImpl::create(search_context);
+    const auto pdb_heuristic = PDBHeuristicImpl::create(delete_relaxed_problem_explorator);
+    const auto ipdb_heuristic = CanonicalPDBsHeuristicImpl::create(delete_relaxed_problem_explorator);
+    const auto& task = *pdb_heuristic->get_task();
+
+    for (const auto& [state, state_metric_value] : collect_random_walk(*applicable_action_generator, *state_repository, num_steps))
+    {
+        auto num_true_atoms = std::vector<size_t>(task.get_variables().size(), 0);
+        for (const auto atom : state.get_atoms<FluentTag>())
+        {
+            if (atom < task.get_atom_to_variable().size() && task.get_atom_to_variable()[atom] != MAX_INDEX)
+                ++num_true_atoms[task.get_atom_to_variable()[atom]];
+        }
+        for (const auto num : num_true_atoms)
+        {
+            EXPECT_LE(num, 1);
+        }
+
+        const auto is_goal_state = goal_strategy->test_dynamic_goal(state);
+        const auto h_perfect = perfect_heuristic->compute_heuristic(state, is_goal_state);
+        const auto h_pdb = pdb_heuristic->compute_heuristic(state, is_goal_state);
+        const auto h_ipdb = ipdb_heuristic->compute_heuristic(state, is_goal_state);
+        EXPECT_LE(h_pdb, h_perfect);
+        EXPECT_LE(h_ipdb, h_perfect);
+    }
+}
+
+/// @brief Compare the cost of the plans found by A* with the canonical heuristic and with the blind heuristic, which must both be optimal.
+static void test_canonical_pdbs_astar_optimal(const fs::path& domain_file, const fs::path& problem_file)
+{
+    const auto problem = ProblemImpl::create(domain_file, problem_file);
+    auto delete_relaxed_problem_explorator = DeleteRelaxedProblemExplorator(problem);
+    auto applicable_action_generator = delete_relaxed_problem_explorator.create_grounded_applicable_action_generator(
+        match_tree::Options(),
+        GroundedApplicableActionGeneratorImpl::DefaultEventHandlerImpl::create(false));
+    auto axiom_evaluator = delete_relaxed_problem_explorator.create_grounded_axiom_evaluator(match_tree::Options(),
+                                                                                           GroundedAxiomEvaluatorImpl::DefaultEventHandlerImpl::create(false));
+    auto state_repository = StateRepositoryImpl::create(axiom_evaluator);
+    const auto search_context = SearchContextImpl::create(problem, applicable_action_generator, state_repository);
+
+    auto options = CanonicalPDBsHeuristicImpl::Options();
+    options.hill_climbing_options.max_time_ms = 10'000;
+    const auto ipdb_result = astar_eager::find_solution(search_context, CanonicalPDBsHeuristicImpl::create(delete_relaxed_problem_explorator, options));
+    const auto blind_result = astar_eager::find_solution(search_context, BlindHeuristicImpl::create(problem));
+
+    ASSERT_EQ(ipdb_result.status, SearchStatus::SOLVED);
+    ASSERT_EQ(blind_result.status, SearchStatus::SOLVED);
+    EXPECT_EQ(ipdb_result.plan.value().get_cost(), blind_result.plan.value().get_cost());
+}
+
+TEST(MimirTests, SearchHeuristicsPDBGripperTest)
+{
+    test_pdb_admissible(fs::path(std::string(DATA_DIR) + "gripper/domain.pddl"), fs::path(std::string(DATA_DIR) + "gripper/test_problem.pddl"), 20);
+    test_canonical_pdbs_astar_optimal(fs::path(std::string(DATA_DIR) + "gripper/domain.pddl"), fs::path(std::string(DATA_DIR) + "gripper/test_problem.pddl"));
+}
+
+TEST(MimirTests, SearchHeuristicsPDBBlocks4Test)
+{
+    test_pdb_admissible(fs::path(std::string(DATA_DIR) + "blocks_4/domain.pddl"), fs::path(std::string(DATA_DIR) + "blocks_4/test_problem.pddl"), 20);
+    test_canonical_pdbs_astar_optimal(fs::path(std::string(DATA_DIR) + "blocks_4/domain.pddl"), fs::path(std::string(DATA_DIR) + "blocks_4/test_problem.pddl"));
+}
+
+TEST(MimirTests, SearchHeuristicsPDBMiconicFullAdlTest)
+{
+    // Conditional effects
+    test_pdb_admissible(fs::path(std::string(DATA_DIR) + "miconic-fulladl/domain.pddl"),
+                        fs::path(std::string(DATA_DIR) + "miconic-fulladl/test_problem.pddl"),
+                        20);
+    test_canonical_pdbs_astar_optimal(fs::path(std::string(DATA_DIR) + "miconic-fulladl/domain.pddl"),
+                                      fs::path(std::string(DATA_DIR) + "miconic-fulladl/test_problem.pddl"));
+}
+
+TEST(MimirTests, SearchHeuristicsPDBTransportTest)
+{
+    // Action costs
+    test_canonical_pdbs_astar_optimal(fs::path(std::string(DATA_DIR) + "transport/domain.pddl"),
+                                      fs::path(std::string(DATA_DIR) + "transport/test_problem.pddl"));
+}
+
+TEST(MimirTests, SearchHeuristicsPDBCacheTest)
+{
+    const auto problem = ProblemImpl::create(fs::path(std::string(DATA_DIR) + "gripper/domain.pddl"),
+                                             fs::path(std::string(DATA_DIR) + "gripper/test_problem.pddl"));
+    auto delete_relaxed_problem_explorator = DeleteRelaxedProblemExplorator(problem);
+    const auto task = pdb::TaskImpl::create(delete_relaxed_problem_explorator);
+
+    auto pattern = pdb::Pattern(task->get_variables().size());
+    std::iota(pattern.begin(), pattern.end(), 0);
+
+    const auto cache_directory = fs::temp_directory_path() / "mimir_pdb_cache_test";
+    fs::remove_all(cache_directory);
+
+    const auto cache_file = pdb::PatternDatabaseImpl::get_cache_file(*task, pattern, cache_directory);
+    const auto created_pdb = pdb::PatternDatabaseImpl::create(*task, pattern, cache_directory);
+    EXPECT_TRUE(fs::exists(cache_file));
+
+    const auto loaded_pdb = pdb::PatternDatabaseImpl::load(*task, pattern, cache_file);
+    ASSERT_NE(loaded_pdb, nullptr);
+    ASSERT_EQ(loaded_pdb->get_num_abstract_states(), created_pdb->get_num_abstract_states());
+    for (size_t i = 0; i < created_pdb->get_num_abstract_states(); ++i)
+    {
+        EXPECT_EQ(loaded_pdb->get_distances().get(i), created_pdb->get_distances().get(i));
+    }
+
+    // The file must not be loaded for a different pattern.
+    pattern.pop_back();
+    EXPECT_EQ(pdb::PatternDatabaseImpl::load(*task, pattern, cache_file), nullptr);
+
+    fs::remove_all(cache_directory);
+}
+
+}
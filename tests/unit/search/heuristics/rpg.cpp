@@ -0,0 +1,130 @@
+/*
+ * Copyright (C) 2023 Dominik Drexler and Simon Stahlberg
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#include "mimir/formalism/problem.hpp"
+#include "mimir/search/algorithms/strategies/goal_strategy.hpp"
+#include "mimir/search/applicability.hpp"
+#include "mimir/search/applicable_action_generators.hpp"
+#include "mimir/search/axiom_evaluators.hpp"
+#include "mimir/search/delete_relaxed_problem_explorator.hpp"
+#include "mimir/search/heuristics.hpp"
+#include "mimir/search/state_repository.hpp"
+#include "utils/random_walk.hpp"
+
+#include <gtest/gtest.h>
+
+using namespace mimir::search;
+using namespace mimir::formalism;
+
+namespace mimir::tests
+{
+
+/// @brief Compare the incremental evaluation against the full evaluation on all successors of the states along a random walk,
+/// which mimics the order of evaluations in eager search.
+/// The heuristics that extract relaxed plans are compared against a fresh heuristic, whose first evaluation is a full evaluation,
+/// because the incremental evaluation breaks ties among best supporters differently than a full evaluation with incremental evaluation disabled.
+static void test_incremental_heuristics(const fs::path& domain_file, const fs::path& problem_file, size_t num_steps)
+{
+    const auto problem = ProblemImpl::create(domain_file, problem_file);
+    auto delete_relaxed_problem_explorator = DeleteRelaxedProblemExplorator(problem);
+    auto applicable_action_generator = delete_relaxed_problem_explorator.create_grounded_applicable_action_generator(
+        match_tree::Options(),
+        GroundedApplicableActionGeneratorImpl::DefaultEventHandlerImpl::create(false));
+    auto axiom_evaluator = delete_relaxed_problem_explorator.create_grounded_axiom_evaluator(match_tree::Options(),
+                                                                                           GroundedAxiomEvaluatorImpl::DefaultEventHandlerImpl::create(false));
+    auto state_repository = StateRepositoryImpl::create(axiom_evaluator);
+    const auto goal_strategy = ProblemGoalStrategyImpl::create(problem);
+
+    const auto max_heuristic = MaxHeuristicImpl::create(delete_relaxed_problem_explorator);
+    const auto add_heuristic = AddHeuristicImpl::create(delete_relaxed_problem_explorator);
+    const auto incremental_max_heuristic = MaxHeuristicImpl::create(delete_relaxed_problem_explorator, true);
+    const auto incremental_add_heuristic = AddHeuristicImpl::create(delete_relaxed_problem_explorator, true);
+    const auto incremental_setadd_heuristic = SetAddHeuristicImpl::create(delete_relaxed_problem_explorator, true);
+    const auto incremental_ff_heuristic = FFHeuristicImpl::create(delete_relaxed_problem_explorator, true);
+
+    for (const auto& [state, state_metric_value] : collect_random_walk(*applicable_action_generator, *state_repository, num_steps))
+    {
+        auto actions = GroundActionList {};
+        for (const auto& action : applicable_action_generator->create_applicable_action_generator(state))
+        {
+            actions.push_back(action);
+        }
+
+        for (const auto& action : actions)
+        {
+            const auto successor_state = state_repository->get_or_create_successor_state(state, action, state_metric_value).first;
+            const auto is_goal_state = goal_strategy->test_dynamic_goal(successor_state);
+
+            const auto h_max = max_heuristic->compute_heuristic(successor_state, is_goal_state);
+            const auto h_add = add_heuristic->compute_heuristic(successor_state, is_goal_state);
+            const auto incremental_h_setadd = incremental_setadd_heuristic->compute_heuristic(successor_state, is_goal_state);
+            const auto incremental_h_ff = incremental_ff_heuristic->compute_heuristic(successor_state, is_goal_state);
+
+            EXPECT_EQ(incremental_max_heuristic->compute_heuristic(successor_state, is_goal_state), h_max);
+            EXPECT_EQ(incremental_add_heuristic->compute_heuristic(successor_state, is_goal_state), h_add);
+
+            const auto setadd_heuristic = SetAddHeuristicImpl::create(delete_relaxed_problem_explorator, true);
+            const auto ff_heuristic = FFHeuristicImpl::create(delete_relaxed_problem_explorator, true);
+
+            EXPECT_EQ(incremental_h_setadd, setadd_heuristic->compute_heuristic(successor_state, is_goal_state));
+            EXPECT_EQ(incremental_h_ff, ff_heuristic->compute_heuristic(successor_state, is_goal_state));
+
+            // The preferred actions are only computed if the relaxed plan is extracted.
+            if (is_goal_state || incremental_h_ff == INFINITY_CONTINUOUS_COST)
+                continue;
+
+            EXPECT_EQ(incremental_ff_heuristic->get_preferred_actions().data, ff_heuristic->get_preferred_actions().data);
+
+            for (const auto& preferred_action : incremental_ff_heuristic->get_preferred_actions().data)
+            {
+                EXPECT_TRUE(is_applicable(preferred_action, successor_state));
+            }
+        }
+    }
+
+    EXPECT_GT(incremental_max_heuristic->get_statistics().num_incremental_evaluations, 0);
+    EXPECT_GT(incremental_add_heuristic->get_statistics().num_incremental_evaluations, 0);
+    EXPECT_GT(incremental_setadd_heuristic->get_statistics().num_incremental_evaluations, 0);
+    EXPECT_GT(incremental_ff_heuristic->get_statistics().num_incremental_evaluations, 0);
+}
+
+TEST(MimirTests, SearchHeuristicsRPGIncrementalGripperTest)
+{
+    test_incremental_heuristics(fs::path(std::string(DATA_DIR) + "gripper/domain.pddl"), fs::path(std::string(DATA_DIR) + "gripper/test_problem.pddl"), 50);
+}
+
+TEST(MimirTests, SearchHeuristicsRPGIncrementalBlocks4Test)
+{
+    test_incremental_heuristics(fs::path(std::string(DATA_DIR) + "blocks_4/domain.pddl"), fs::path(std::string(DATA_DIR) + "blocks_4/test_problem.pddl"), 50);
+}
+
+TEST(MimirTests, SearchHeuristicsRPGIncrementalMiconicFullAdlTest)
+{
+    test_incremental_heuristics(fs::path(std::string(DATA_DIR) + "miconic-fulladl/domain.pddl"),
+                                fs::path(std::string(DATA_DIR) + "miconic-fulladl/test_problem.pddl"),
+                                50);
+}
+
+TEST(MimirTests, SearchHeuristicsRPGIncrementalPhilosophersTest)
+{
+    test_incremental_heuristics(fs::path(std::string(DATA_DIR) + "philosophers/domain.pddl"),
+                                fs::path(std::string(DATA_DIR) + "philosophers/test_problem.pddl"),
+                                50);
+}
+
+}
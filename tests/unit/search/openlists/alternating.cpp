@@ -132,4 +132,60 @@ TEST(MimirTests, SearchOpenListsAlternatingTest)
     EXPECT_TRUE(alternating_queue.empty());
 }
 
+TEST(MimirTests, SearchOpenListsDynamicAlternatingTest)
+{
+    struct QueueEntry
+    {
+        using KeyType = int;
+        using ItemType = int;
+
+        int k;
+        int v;
+
+        KeyType get_key() const { return k; }
+        ItemType get_item() const { return v; }
+    };
+
+    using Queue = PriorityQueue<QueueEntry>;
+
+    auto alternating_queue = DynamicAlternatingOpenList<Queue>(3);
+    EXPECT_EQ(alternating_queue.get_num_queues(), 3);
+    EXPECT_TRUE(alternating_queue.empty());
+
+    alternating_queue.insert(0, QueueEntry { 1, 0 });
+    alternating_queue.insert(0, QueueEntry { 2, 1 });
+    alternating_queue.insert(0, QueueEntry { 3, 2 });
+    alternating_queue.insert(1, QueueEntry { 1, 3 });
+    alternating_queue.insert(1, QueueEntry { 2, 4 });
+    alternating_queue.insert(2, QueueEntry { 1, 5 });
+    alternating_queue.insert(2, QueueEntry { 2, 6 });
+    alternating_queue.insert(2, QueueEntry { 3, 7 });
+    EXPECT_EQ(alternating_queue.size(), 8);
+
+    const auto pop = [&]()
+    {
+        const auto element = alternating_queue.top();
+        alternating_queue.pop();
+        return element;
+    };
+
+    // The queues take turns.
+    EXPECT_EQ(pop(), 0);
+    EXPECT_EQ(pop(), 3);
+    EXPECT_EQ(pop(), 5);
+
+    // The boosted queue takes the next turns.
+    alternating_queue.boost(2, 2);
+    EXPECT_EQ(pop(), 6);
+    EXPECT_EQ(pop(), 7);
+
+    // Empty queues are skipped.
+    EXPECT_EQ(pop(), 1);
+    EXPECT_EQ(pop(), 4);
+    EXPECT_EQ(pop(), 2);
+    EXPECT_TRUE(alternating_queue.empty());
+
+    EXPECT_THROW(DynamicAlternatingOpenList<Queue>(0), std::invalid_argument);
+}
+
 }
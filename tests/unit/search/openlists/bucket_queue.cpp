@@ -0,0 +1,126 @@
+/*
+ * Copyright (C) 2023 Dominik Drexler and Simon Stahlberg
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "mimir/search/openlists.hpp"
+
+#include <gtest/gtest.h>
+#include <random>
+#include <tuple>
+
+using namespace mimir::search;
+
+namespace mimir::tests
+{
+
+struct BucketQueueEntry
+{
+    using KeyType = std::tuple<double, int, int>;
+    using ItemType = int;
+    using SecondaryKeyType = int;
+
+    double k1;
+    int k2;
+    int step;
+
+    KeyType get_key() const { return std::make_tuple(k1, k2, step); }
+    ItemType get_item() const { return step; }
+    double get_primary_key() const { return k1; }
+    SecondaryKeyType get_secondary_key() const { return k2; }
+};
+
+TEST(MimirTests, SearchOpenListsBucketQueueTest)
+{
+    auto bucket_queue = BucketQueue<BucketQueueEntry>();
+    bucket_queue.insert(BucketQueueEntry { 2, 0, 0 });
+    bucket_queue.insert(BucketQueueEntry { 1, 1, 1 });
+    bucket_queue.insert(BucketQueueEntry { 1, 0, 2 });
+    bucket_queue.insert(BucketQueueEntry { 1, 0, 3 });
+    EXPECT_EQ(bucket_queue.size(), 4);
+
+    auto elements = std::vector<int> {};
+    while (!bucket_queue.empty())
+    {
+        elements.push_back(bucket_queue.top());
+        bucket_queue.pop();
+    }
+    EXPECT_EQ(elements, (std::vector<int> { 2, 3, 1, 0 }));
+    EXPECT_FALSE(bucket_queue.uses_heap());
+}
+
+TEST(MimirTests, SearchOpenListsBucketQueueLIFOTest)
+{
+    auto bucket_queue = BucketQueue<BucketQueueEntry, BucketTieBreaking::LIFO>();
+    bucket_queue.insert(BucketQueueEntry { 1, 0, 0 });
+    bucket_queue.insert(BucketQueueEntry { 1, 0, 1 });
+    bucket_queue.insert(BucketQueueEntry { 0, 0, 2 });
+
+    auto elements = std::vector<int> {};
+    while (!bucket_queue.empty())
+    {
+        elements.push_back(bucket_queue.top());
+        bucket_queue.pop();
+    }
+    EXPECT_EQ(elements, (std::vector<int> { 2, 1, 0 }));
+}
+
+TEST(MimirTests, SearchOpenListsBucketQueueMatchesPriorityQueueTest)
+{
+    auto rng = std::mt19937(42);
+    auto bucket_queue = BucketQueue<BucketQueueEntry>();
+    auto priority_queue = PriorityQueue<BucketQueueEntry>();
+
+    // Interleave insertions and pops with integral keys, then fall back to the heap with a non-integral key.
+    auto step = 0;
+    for (int phase = 0; phase < 2; ++phase)
+    {
+        for (int i = 0; i < 10000; ++i)
+        {
+            if (!priority_queue.empty() && rng() % 3 == 0)
+            {
+                EXPECT_EQ(bucket_queue.top(), priority_queue.top());
+                bucket_queue.pop();
+                priority_queue.pop();
+            }
+            else
+            {
+                const auto entry = BucketQueueEntry { static_cast<double>(rng() % 50), static_cast<int>(rng() % 3), step++ };
+                bucket_queue.insert(entry);
+                priority_queue.insert(entry);
+            }
+            EXPECT_EQ(bucket_queue.size(), priority_queue.size());
+        }
+        EXPECT_EQ(bucket_queue.uses_heap(), phase == 1);
+
+        const auto entry = BucketQueueEntry { 0.5, 0, step++ };
+        bucket_queue.insert(entry);
+        priority_queue.insert(entry);
+        EXPECT_TRUE(bucket_queue.uses_heap());
+    }
+
+    while (!priority_queue.empty())
+    {
+        EXPECT_EQ(bucket_queue.top(), priority_queue.top());
+        bucket_queue.pop();
+        priority_queue.pop();
+    }
+    EXPECT_TRUE(bucket_queue.empty());
+
+    bucket_queue.clear();
+    EXPECT_FALSE(bucket_queue.uses_heap());
+}
+
+}
@@ -0,0 +1,105 @@
+/*
+ * Copyright (C) 2023 Dominik Drexler and Simon Stahlberg
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "mimir/search/state_cache.hpp"
+
+#include "mimir/formalism/problem.hpp"
+#include "mimir/search/applicable_action_generators.hpp"
+#include "mimir/search/axiom_evaluators.hpp"
+#include "mimir/search/search_context.hpp"
+#include "mimir/search/state_repository.hpp"
+
+#include <algorithm>
+#include <gtest/gtest.h>
+
+using namespace mimir::search;
+using namespace mimir::formalism;
+
+namespace mimir::tests
+{
+
+/// @brief `LookupCounter` counts the hits and misses that the cache reports.
+struct LookupCounter
+{
+    size_t num_hits = 0;
+    size_t num_misses = 0;
+
+    void on_lookup_unpacked_state(bool hit) { ++(hit ? num_hits : num_misses); }
+};
+
+TEST(MimirTests, SearchUnpackedStateCacheTest)
+{
+    const auto domain_file = fs::path(std::string(DATA_DIR) + "gripper/domain.pddl");
+    const auto problem_file = fs::path(std::string(DATA_DIR) + "gripper/p-2-0.pddl");
+
+    auto search_context =
+        SearchContextImpl::create(ProblemImpl::create(domain_file, problem_file), SearchContextImpl::Options(SearchContextImpl::SearchMode::GROUNDED));
+
+    auto& applicable_action_generator = *search_context->get_applicable_action_generator();
+    auto& state_repository = *search_context->get_state_repository();
+    const auto [initial_state, initial_state_metric_value] = state_repository.get_or_create_initial_state();
+
+    auto successor_states = StateList {};
+    for (const auto& action : applicable_action_generator.create_applicable_action_generator(initial_state))
+    {
+        const auto [successor_state, successor_state_metric_value] =
+            state_repository.get_or_create_successor_state(initial_state, action, initial_state_metric_value);
+        if (successor_state != initial_state
+            && std::none_of(successor_states.begin(), successor_states.end(), [&](auto&& state) { return state == successor_state; }))
+        {
+            successor_states.push_back(successor_state);
+        }
+    }
+    ASSERT_GE(successor_states.size(), 2);
+
+    auto cache = UnpackedStateCache(2);
+    auto lookup_counter = LookupCounter();
+
+    // The third insertion evicts the oldest unreferenced state.
+    cache.insert(initial_state);
+    cache.insert(successor_states[0]);
+    cache.insert(successor_states[1]);
+    EXPECT_EQ(cache.size(), 2);
+    EXPECT_FALSE(cache.contains(initial_state.get_index()));
+    EXPECT_TRUE(cache.contains(successor_states[0].get_index()));
+    EXPECT_TRUE(cache.contains(successor_states[1].get_index()));
+
+    // A hit returns the cached unpacked state and frees its slot.
+    const auto cached_state = cache.extract_or_unpack(IndexedPackedState { successor_states[0].get_index(), successor_states[0].get_packed_state() },
+                                                      state_repository,
+                                                      lookup_counter);
+    EXPECT_EQ(cached_state, successor_states[0]);
+    EXPECT_EQ(&cached_state.get_unpacked_state(), &successor_states[0].get_unpacked_state());
+    EXPECT_EQ(cache.size(), 1);
+
+    // A miss unpacks the state.
+    const auto unpacked_state =
+        cache.extract_or_unpack(IndexedPackedState { initial_state.get_index(), initial_state.get_packed_state() }, state_repository, lookup_counter);
+    EXPECT_EQ(unpacked_state, initial_state);
+    EXPECT_EQ(unpacked_state.get_atoms<FluentTag>(), initial_state.get_atoms<FluentTag>());
+    EXPECT_EQ(unpacked_state.get_numeric_variables(), initial_state.get_numeric_variables());
+
+    EXPECT_EQ(lookup_counter.num_hits, 1);
+    EXPECT_EQ(lookup_counter.num_misses, 1);
+
+    // A disabled cache stores nothing.
+    auto disabled_cache = UnpackedStateCache(0);
+    disabled_cache.insert(initial_state);
+    EXPECT_EQ(disabled_cache.size(), 0);
+}
+
+}
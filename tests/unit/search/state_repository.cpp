@@ -24,6 +24,7 @@
 #include "mimir/search/search_context.hpp"
 
 #include <gtest/gtest.h>
+#include <thread>
 
 using namespace mimir::search;
 using namespace mimir::formalism;
@@ -53,4 +54,100 @@ TEST(MimirTests, SearchStateRepositoryImplTest)
     }
 }
 
+TEST(MimirTests, SearchStateRepositoryImplConcurrentTest)
+{
+    const auto domain_file = fs::path(std::string(DATA_DIR) + "gripper/domain.pddl");
+    const auto problem_file = fs::path(std::string(DATA_DIR) + "gripper/p-2-0.pddl");
+
+    auto search_context =
+        SearchContextImpl::create(ProblemImpl::create(domain_file, problem_file), SearchContextImpl::Options(SearchContextImpl::SearchMode::GROUNDED));
+
+    auto& applicable_action_generator = *search_context->get_applicable_action_generator();
+    auto& state_repository = *search_context->get_state_repository();
+
+    // Generate the actions of the first two layers sequentially.
+    auto packed_states = std::vector<PackedStateImpl> {};
+    auto actions = std::vector<GroundActionList> {};
+    {
+        auto [initial_state, initial_state_metric_value] = state_repository.get_or_create_initial_state();
+        packed_states.push_back(*initial_state.get_packed_state());
+        actions.emplace_back();
+        for (const auto& action : applicable_action_generator.create_applicable_action_generator(initial_state))
+        {
+            actions.back().push_back(action);
+        }
+        for (const auto& action : actions.front())
+        {
+            const auto [successor_state, successor_state_metric_value] =
+                state_repository.get_or_create_successor_state(initial_state, action, initial_state_metric_value);
+            packed_states.push_back(*successor_state.get_packed_state());
+        }
+        for (size_t i = 1; i < packed_states.size(); ++i)
+        {
+            const auto state = state_repository.get_state(packed_states[i]);
+            actions.emplace_back();
+            for (const auto& action : applicable_action_generator.create_applicable_action_generator(state))
+            {
+                actions.back().push_back(action);
+            }
+        }
+    }
+    const auto num_states_before = state_repository.get_state_count();
+
+    // Switching to concurrent mode must keep the states that were created sequentially.
+    auto indices_before = IndexList {};
+    for (const auto& packed_state : packed_states)
+    {
+        indices_before.push_back(state_repository.get_state_index(packed_state));
+    }
+    EXPECT_FALSE(state_repository.is_concurrent());
+    state_repository.enable_concurrency();
+    EXPECT_TRUE(state_repository.is_concurrent());
+    EXPECT_EQ(state_repository.get_state_count(), num_states_before);
+    for (size_t i = 0; i < packed_states.size(); ++i)
+    {
+        EXPECT_EQ(state_repository.get_state_index(packed_states[i]), indices_before[i]);
+    }
+
+    // Generate the successors of all states concurrently: every thread must observe identical state indices.
+    const size_t num_threads = 8;
+    auto indices = std::vector<std::vector<Index>>(num_threads);
+    auto threads = std::vector<std::thread> {};
+    for (size_t t = 0; t < num_threads; ++t)
+    {
+        threads.emplace_back(
+            [&, t]
+            {
+                for (size_t i = 0; i < packed_states.size(); ++i)
+                {
+                    const auto state = state_repository.get_state(packed_states[i]);
+                    for (const auto& action : actions[i])
+                    {
+                        indices[t].push_back(state_repository.get_or_create_successor_state(state, action, 0.).first.get_index());
+                    }
+                }
+            });
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+
+    for (size_t t = 1; t < num_threads; ++t)
+    {
+        EXPECT_EQ(indices[t], indices.front());
+    }
+
+    // Indices must remain dense.
+    EXPECT_GT(state_repository.get_state_count(), num_states_before);
+    auto seen = std::vector<bool>(state_repository.get_state_count(), false);
+    for (const auto& [packed_state, index] : state_repository.get_states().range())
+    {
+        ASSERT_LT(index, seen.size());
+        EXPECT_FALSE(seen[index]);
+        seen[index] = true;
+    }
+    EXPECT_TRUE(std::all_of(seen.begin(), seen.end(), [](bool value) { return value; }));
+}
+
 }
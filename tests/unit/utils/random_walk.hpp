@@ -0,0 +1,68 @@
+/*
+ * Copyright (C) 2023 Dominik Drexler and Simon Stahlberg
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef MIMIR_TESTS_UNIT_UTILS_RANDOM_WALK_HPP_
+#define MIMIR_TESTS_UNIT_UTILS_RANDOM_WALK_HPP_
+
+#include "mimir/common/types.hpp"
+#include "mimir/search/applicable_action_generators/interface.hpp"
+#include "mimir/search/state.hpp"
+#include "mimir/search/state_repository.hpp"
+
+#include <random>
+#include <utility>
+#include <vector>
+
+namespace mimir::tests
+{
+
+/// @brief Collect the states and their metric values along a random walk from the initial state,
+/// which applies an applicable action chosen with a fixed seed in each step.
+/// The walk jumps back to the initial state in dead ends and, if `restart_period` is positive, after every `restart_period` steps.
+/// @param num_states the number of states to collect, including repetitions.
+inline std::vector<std::pair<search::State, ContinuousCost>> collect_random_walk(search::IApplicableActionGenerator& applicable_action_generator,
+                                                                                 search::StateRepositoryImpl& state_repository,
+                                                                                 size_t num_states,
+                                                                                 size_t restart_period = 0)
+{
+    auto walk = std::vector<std::pair<search::State, ContinuousCost>> {};
+    auto actions = formalism::GroundActionList {};
+    auto rng = std::mt19937(42);
+    auto [state, state_metric_value] = state_repository.get_or_create_initial_state();
+    for (size_t step = 0; step < num_states; ++step)
+    {
+        walk.emplace_back(state, state_metric_value);
+
+        actions.clear();
+        for (const auto& action : applicable_action_generator.create_applicable_action_generator(state))
+        {
+            actions.push_back(action);
+        }
+        if (actions.empty() || (restart_period > 0 && step % restart_period == restart_period - 1))
+        {
+            std::tie(state, state_metric_value) = state_repository.get_or_create_initial_state();
+            continue;
+        }
+        std::tie(state, state_metric_value) = state_repository.get_or_create_successor_state(state, actions[rng() % actions.size()], state_metric_value);
+    }
+
+    return walk;
+}
+
+}
+
+#endif
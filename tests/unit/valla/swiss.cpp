@@ -0,0 +1,179 @@
+/*
+ * Copyright (C) 2025 Dominik Drexler
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "valla/plain/swiss.hpp"
+
+#include <algorithm>
+#include <gtest/gtest.h>
+#include <random>
+#include <vector>
+
+namespace mimir::tests
+{
+
+using Index = uint32_t;
+using IndexList = std::vector<Index>;
+using Table = valla::IndexedHashSet<valla::Slot<Index>, Index>;
+
+/// @brief Insert the successor of `state` under the `added` and `deleted` values with `insert_with_delta` and `insert_with_parent`,
+/// and check that both return the slot of inserting the successor from scratch.
+static void expect_successor_slot(const IndexList& state,
+                                  const IndexList& added,
+                                  const IndexList& deleted,
+                                  Table& table,
+                                  valla::plain::swiss::DeltaWorkspace<Index>& workspace)
+{
+    const auto parent_root = valla::plain::swiss::insert(state, table);
+
+    auto successor = IndexList {};
+    std::set_difference(state.begin(), state.end(), deleted.begin(), deleted.end(), std::back_inserter(successor));
+    auto merged = IndexList {};
+    std::merge(successor.begin(), successor.end(), added.begin(), added.end(), std::back_inserter(merged));
+    successor = std::move(merged);
+
+    const auto expected_root = valla::plain::swiss::insert(successor, table);
+
+    EXPECT_EQ(valla::plain::swiss::insert_with_delta(parent_root, added, deleted, table, workspace), expected_root);
+
+    // Exact test for unchanged positions.
+    const auto is_unchanged = [&](Index first, Index last)
+    { return state.size() == successor.size() && std::equal(state.begin() + first, state.begin() + last, successor.begin() + first); };
+    EXPECT_EQ(valla::plain::swiss::insert_with_parent(successor, parent_root, table, is_unchanged), expected_root);
+
+    // Most conservative test for unchanged positions.
+    const auto is_never_unchanged = [](Index, Index) { return false; };
+    EXPECT_EQ(valla::plain::swiss::insert_with_parent(successor, parent_root, table, is_never_unchanged), expected_root);
+
+    auto read = IndexList {};
+    valla::plain::swiss::read_state(expected_root, table, read);
+    EXPECT_EQ(read, successor);
+}
+
+/// @brief Sample `num_values` distinct sorted values from [0, universe_size) that satisfy `pred`.
+template<typename Pred>
+static IndexList sample_values(size_t num_values, Index universe_size, Pred pred, std::mt19937& rng)
+{
+    auto candidates = IndexList {};
+    for (Index value = 0; value < universe_size; ++value)
+        if (pred(value))
+            candidates.push_back(value);
+
+    auto values = IndexList {};
+    std::sample(candidates.begin(), candidates.end(), std::back_inserter(values), num_values, rng);
+
+    return values;
+}
+
+TEST(MimirTests, VallaSwissInsertWithDeltaEmptyTest)
+{
+    auto table = Table();
+    auto workspace = valla::plain::swiss::DeltaWorkspace<Index>();
+
+    // Empty delta of the empty state.
+    expect_successor_slot(IndexList {}, IndexList {}, IndexList {}, table, workspace);
+
+    // Empty deltas for all sizes up to several tree heights.
+    auto state = IndexList {};
+    for (Index value = 0; value < 70; ++value)
+    {
+        state.push_back(3 * value);
+        const auto root = valla::plain::swiss::insert(state, table);
+        EXPECT_EQ(valla::plain::swiss::insert_with_delta(root, IndexList {}, IndexList {}, table, workspace), root);
+        expect_successor_slot(state, IndexList {}, IndexList {}, table, workspace);
+    }
+}
+
+TEST(MimirTests, VallaSwissInsertWithDeltaDeleteAllTest)
+{
+    auto table = Table();
+    auto workspace = valla::plain::swiss::DeltaWorkspace<Index>();
+
+    auto state = IndexList {};
+    for (Index value = 0; value < 70; ++value)
+    {
+        state.push_back(2 * value + 1);
+        const auto root = valla::plain::swiss::insert(state, table);
+
+        // Delete all values.
+        EXPECT_EQ(valla::plain::swiss::insert_with_delta(root, IndexList {}, state, table, workspace), valla::get_empty_slot<Index>());
+        expect_successor_slot(state, IndexList {}, state, table, workspace);
+
+        // Delete all values but add a new one.
+        expect_successor_slot(state, IndexList { 0 }, state, table, workspace);
+    }
+}
+
+TEST(MimirTests, VallaSwissInsertWithDeltaGrowTest)
+{
+    auto table = Table();
+    auto workspace = valla::plain::swiss::DeltaWorkspace<Index>();
+
+    // Grow one value at a time from the empty state, crossing every tree height up to 7, in front of, between, and behind the existing values.
+    for (const auto offset : { Index(0), Index(1), Index(1000) })
+    {
+        auto state = IndexList {};
+        for (Index value = 0; value < 100; ++value)
+        {
+            const auto added = IndexList { offset == 1 ? Index(2 * value + 1) : Index(offset + 2 * (value + 1)) };
+            expect_successor_slot(state, added, IndexList {}, table, workspace);
+            state.insert(std::upper_bound(state.begin(), state.end(), added.front()), added.front());
+        }
+    }
+
+    // Double the size in a single delta.
+    auto rng = std::mt19937(42);
+    auto state = IndexList {};
+    for (Index size = 1; size <= 128; size *= 2)
+    {
+        const auto added = sample_values(size - state.size(), 1000, [&](Index value) { return !std::binary_search(state.begin(), state.end(), value); }, rng);
+        expect_successor_slot(state, added, IndexList {}, table, workspace);
+        auto merged = IndexList {};
+        std::merge(state.begin(), state.end(), added.begin(), added.end(), std::back_inserter(merged));
+        state = std::move(merged);
+    }
+}
+
+TEST(MimirTests, VallaSwissInsertWithDeltaRandomTest)
+{
+    auto table = Table();
+    auto workspace = valla::plain::swiss::DeltaWorkspace<Index>();
+    auto rng = std::mt19937(42);
+
+    const auto universe_size = Index(200);
+
+    auto state = IndexList {};
+    for (size_t step = 0; step < 2000; ++step)
+    {
+        const auto contains = [&](Index value) { return std::binary_search(state.begin(), state.end(), value); };
+
+        // Bias towards deltas of equal size, which reuse the shape of the parent tree.
+        const auto num_deleted = std::uniform_int_distribution<size_t>(0, std::min<size_t>(state.size(), 4))(rng);
+        const auto num_added = (step % 2 == 0) ? num_deleted : std::uniform_int_distribution<size_t>(0, 4)(rng);
+
+        const auto deleted = sample_values(num_deleted, universe_size, contains, rng);
+        const auto added = sample_values(num_added, universe_size, [&](Index value) { return !contains(value); }, rng);
+
+        expect_successor_slot(state, added, deleted, table, workspace);
+
+        auto successor = IndexList {};
+        std::set_difference(state.begin(), state.end(), deleted.begin(), deleted.end(), std::back_inserter(successor));
+        state.clear();
+        std::merge(successor.begin(), successor.end(), added.begin(), added.end(), std::back_inserter(state));
+    }
+}
+
+}